@@ -0,0 +1,240 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+/** \file
+ *
+ *  Benchmarks for the Audio device class driver.
+ */
+
+#include "Benchmarks.h"
+
+#include <LUFA/Drivers/USB/Class/Audio.h>
+
+/** Endpoint number of the isochronous audio streaming endpoint used by the Audio benchmarks. */
+#define AUDIO_STREAM_EPNUM      1
+
+/** Size in bytes of the isochronous audio streaming endpoint, and of each audio packet. */
+#define AUDIO_PACKET_SIZE       ENDPOINT_MAX_SIZE(AUDIO_STREAM_EPNUM)
+
+/** Size in bytes of one sample of each channel of the benchmark's 16-bit stereo audio stream. */
+#define AUDIO_FRAME_SIZE        4
+
+/** Number of audio packets transferred in each Audio benchmark. */
+#define AUDIO_PACKETS           256
+
+/** Size in bytes of the sample FIFOs used by the sample FIFO benchmarks. */
+#define AUDIO_FIFO_SIZE         1024
+
+/** Outgoing and incoming sample FIFOs for the sample FIFO benchmarks. */
+static uint8_t Bench_Audio_FIFOOUT[AUDIO_FIFO_SIZE];
+static uint8_t Bench_Audio_FIFOIN[AUDIO_FIFO_SIZE];
+
+/** LUFA Audio Class driver interface configuration and state information for the per-sample outgoing Audio benchmarks. */
+static USB_ClassInfo_Audio_Device_t Bench_AudioOUT_Interface =
+	{
+		.Config =
+			{
+				.StreamingInterfaceNumber = 1,
+
+				.DataOUTEndpointNumber    = AUDIO_STREAM_EPNUM,
+				.DataOUTEndpointSize      = AUDIO_PACKET_SIZE,
+			},
+	};
+
+/** LUFA Audio Class driver interface configuration and state information for the per-sample incoming Audio benchmarks. */
+static USB_ClassInfo_Audio_Device_t Bench_AudioIN_Interface =
+	{
+		.Config =
+			{
+				.StreamingInterfaceNumber = 1,
+
+				.DataINEndpointNumber     = AUDIO_STREAM_EPNUM,
+				.DataINEndpointSize       = AUDIO_PACKET_SIZE,
+			},
+	};
+
+/** LUFA Audio Class driver interface configuration and state information for the outgoing sample FIFO benchmarks. */
+static USB_ClassInfo_Audio_Device_t Bench_AudioFIFOOUT_Interface =
+	{
+		.Config =
+			{
+				.StreamingInterfaceNumber = 1,
+
+				.DataOUTEndpointNumber    = AUDIO_STREAM_EPNUM,
+				.DataOUTEndpointSize      = AUDIO_PACKET_SIZE,
+
+				.SampleFIFOOUT            = Bench_Audio_FIFOOUT,
+				.SampleFIFOOUTSize        = sizeof(Bench_Audio_FIFOOUT),
+				.SampleFrameSize          = AUDIO_FRAME_SIZE,
+
+				.FeedbackEndpointNumber   = BENCH_NOTIFICATION_EPNUM,
+				.SampleRate               = 48000,
+			},
+	};
+
+/** LUFA Audio Class driver interface configuration and state information for the incoming sample FIFO benchmarks. */
+static USB_ClassInfo_Audio_Device_t Bench_AudioFIFOIN_Interface =
+	{
+		.Config =
+			{
+				.StreamingInterfaceNumber = 1,
+
+				.DataINEndpointNumber     = AUDIO_STREAM_EPNUM,
+				.DataINEndpointSize       = AUDIO_PACKET_SIZE,
+
+				.SampleFIFOIN             = Bench_Audio_FIFOIN,
+				.SampleFIFOINSize         = sizeof(Bench_Audio_FIFOIN),
+				.SampleFrameSize          = AUDIO_FRAME_SIZE,
+			},
+	};
+
+/** Interface used by the current benchmark's configuration routine. */
+static USB_ClassInfo_Audio_Device_t* Bench_Audio_CurrentInterface;
+
+/** Configures the current Audio interface, and enables its streaming endpoints as the host would when starting
+ *  a stream.
+ */
+static void Bench_AudioDevice_Configure(void)
+{
+	Audio_Device_ConfigureEndpoints(Bench_Audio_CurrentInterface);
+	Bench_Audio_CurrentInterface->State.InterfaceEnabled = true;
+
+	USB_Sim_Host_SetEndpointMode(AUDIO_STREAM_EPNUM, USB_SIM_ENDPOINT_Discard);
+	USB_Sim_Host_SetEndpointMode(BENCH_NOTIFICATION_EPNUM, USB_SIM_ENDPOINT_Discard);
+}
+
+/** Connects the device with the given Audio interface configured. */
+static void Bench_AudioDevice_Connect(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	Bench_Audio_CurrentInterface = AudioInterfaceInfo;
+	Benchmark_ConnectDevice(Bench_AudioDevice_Configure);
+}
+
+void Bench_AudioDevice(void)
+{
+	static uint8_t HostPacket[AUDIO_PACKET_SIZE];
+	volatile int16_t Sample;
+
+	/* Per-sample endpoint access, as performed from the main loop once per sample timer period */
+	Bench_AudioDevice_Connect(&Bench_AudioOUT_Interface);
+
+	Benchmark_Begin("audio_device_sample_out");
+
+	for (uint16_t Packet = 0; Packet < AUDIO_PACKETS; Packet++)
+	{
+		USB_Sim_Host_Write(AUDIO_STREAM_EPNUM, HostPacket, sizeof(HostPacket));
+
+		for (uint16_t Frame = 0; Frame < (AUDIO_PACKET_SIZE / AUDIO_FRAME_SIZE); Frame++)
+		{
+			while (!(Audio_Device_IsSampleReceived(&Bench_AudioOUT_Interface)));
+
+			Sample = Audio_Device_ReadSample16(&Bench_AudioOUT_Interface);
+			Sample = Audio_Device_ReadSample16(&Bench_AudioOUT_Interface);
+		}
+	}
+
+	Benchmark_End(AUDIO_PACKETS, AUDIO_PACKET_SIZE);
+
+	Bench_AudioDevice_Connect(&Bench_AudioIN_Interface);
+
+	Benchmark_Begin("audio_device_sample_in");
+
+	for (uint16_t Packet = 0; Packet < AUDIO_PACKETS; Packet++)
+	{
+		for (uint16_t Frame = 0; Frame < (AUDIO_PACKET_SIZE / AUDIO_FRAME_SIZE); Frame++)
+		{
+			while (!(Audio_Device_IsReadyForNextSample(&Bench_AudioIN_Interface)));
+
+			Audio_Device_WriteSample16(&Bench_AudioIN_Interface, Frame);
+			Audio_Device_WriteSample16(&Bench_AudioIN_Interface, Frame);
+		}
+	}
+
+	Benchmark_End(AUDIO_PACKETS, AUDIO_PACKET_SIZE);
+
+	/* Sample FIFO, with whole packets moved by the driver and samples read as from the sample timer interrupt */
+	Bench_AudioDevice_Connect(&Bench_AudioFIFOOUT_Interface);
+
+	/* Fill the FIFO to half full so that playback starts before measuring */
+	while (!(Bench_AudioFIFOOUT_Interface.State.OUTFIFOStreaming))
+	{
+		USB_Sim_Host_Write(AUDIO_STREAM_EPNUM, HostPacket, sizeof(HostPacket));
+
+		uint16_t PrevHead = Bench_AudioFIFOOUT_Interface.State.OUTFIFOHead;
+
+		while (Bench_AudioFIFOOUT_Interface.State.OUTFIFOHead == PrevHead)
+		  Audio_Device_USBTask(&Bench_AudioFIFOOUT_Interface);
+	}
+
+	Benchmark_Begin("audio_device_fifo_out");
+
+	for (uint16_t Packet = 0; Packet < AUDIO_PACKETS; Packet++)
+	{
+		USB_Sim_Host_Write(AUDIO_STREAM_EPNUM, HostPacket, sizeof(HostPacket));
+
+		uint16_t PrevHead = Bench_AudioFIFOOUT_Interface.State.OUTFIFOHead;
+
+		while (Bench_AudioFIFOOUT_Interface.State.OUTFIFOHead == PrevHead)
+		  Audio_Device_USBTask(&Bench_AudioFIFOOUT_Interface);
+
+		for (uint16_t Frame = 0; Frame < (AUDIO_PACKET_SIZE / AUDIO_FRAME_SIZE); Frame++)
+		{
+			if (Audio_Device_IsFIFOSampleReceived(&Bench_AudioFIFOOUT_Interface))
+			{
+				Sample = Audio_Device_ReadFIFOSample16(&Bench_AudioFIFOOUT_Interface);
+				Sample = Audio_Device_ReadFIFOSample16(&Bench_AudioFIFOOUT_Interface);
+			}
+		}
+	}
+
+	Benchmark_End(AUDIO_PACKETS, AUDIO_PACKET_SIZE);
+
+	Bench_AudioDevice_Connect(&Bench_AudioFIFOIN_Interface);
+
+	Benchmark_Begin("audio_device_fifo_in");
+
+	for (uint16_t Packet = 0; Packet < AUDIO_PACKETS; Packet++)
+	{
+		for (uint16_t Frame = 0; Frame < (AUDIO_PACKET_SIZE / AUDIO_FRAME_SIZE); Frame++)
+		{
+			if (Audio_Device_IsFIFOReadyForNextSample(&Bench_AudioFIFOIN_Interface))
+			{
+				Audio_Device_WriteFIFOSample16(&Bench_AudioFIFOIN_Interface, Frame);
+				Audio_Device_WriteFIFOSample16(&Bench_AudioFIFOIN_Interface, Frame);
+			}
+		}
+
+		while (Bench_AudioFIFOIN_Interface.State.INFIFOTail != Bench_AudioFIFOIN_Interface.State.INFIFOHead)
+		  Audio_Device_USBTask(&Bench_AudioFIFOIN_Interface);
+	}
+
+	Benchmark_End(AUDIO_PACKETS, AUDIO_PACKET_SIZE);
+
+	(void)Sample;
+}
@@ -0,0 +1,230 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Benchmarks for the CDC device class driver.
+ */
+
+#include "Benchmarks.h"
+
+#include <LUFA/Drivers/USB/Class/CDC.h>
+
+/** Number of bytes sent or received in each CDC benchmark. */
+#define CDC_BYTES               4096
+
+/** Size in bytes of the transmit and receive ring buffers used by the buffered CDC benchmarks. */
+#define CDC_RING_BUFFER_SIZE    256
+
+/** Size in bytes of each block sent or received by the block level CDC benchmarks. */
+#define CDC_BLOCK_SIZE          100
+
+/** Transmit and receive ring buffers for the buffered CDC benchmarks. */
+static uint8_t Bench_CDC_TXBuffer[CDC_RING_BUFFER_SIZE];
+static uint8_t Bench_CDC_RXBuffer[CDC_RING_BUFFER_SIZE];
+
+/** LUFA CDC Class driver interface configuration and state information for the CDC benchmarks. */
+static USB_ClassInfo_CDC_Device_t Bench_CDC_Interface =
+	{
+		.Config =
+			{
+				.ControlInterfaceNumber         = 0,
+
+				.DataINEndpointNumber           = BENCH_IN_EPNUM,
+				.DataINEndpointSize             = BENCH_BULK_EPSIZE,
+				.DataINEndpointDoubleBank       = false,
+
+				.DataOUTEndpointNumber          = BENCH_OUT_EPNUM,
+				.DataOUTEndpointSize            = BENCH_BULK_EPSIZE,
+				.DataOUTEndpointDoubleBank      = false,
+
+				.NotificationEndpointNumber     = BENCH_NOTIFICATION_EPNUM,
+				.NotificationEndpointSize       = BENCH_NOTIFICATION_EPSIZE,
+				.NotificationEndpointDoubleBank = false,
+			},
+	};
+
+/** LUFA CDC Class driver interface configuration and state information for the buffered CDC benchmarks. */
+static USB_ClassInfo_CDC_Device_t Bench_CDC_Buffered_Interface =
+	{
+		.Config =
+			{
+				.ControlInterfaceNumber         = 0,
+
+				.DataINEndpointNumber           = BENCH_IN_EPNUM,
+				.DataINEndpointSize             = BENCH_BULK_EPSIZE,
+				.DataINEndpointDoubleBank       = false,
+
+				.DataOUTEndpointNumber          = BENCH_OUT_EPNUM,
+				.DataOUTEndpointSize            = BENCH_BULK_EPSIZE,
+				.DataOUTEndpointDoubleBank      = false,
+
+				.NotificationEndpointNumber     = BENCH_NOTIFICATION_EPNUM,
+				.NotificationEndpointSize       = BENCH_NOTIFICATION_EPSIZE,
+				.NotificationEndpointDoubleBank = false,
+
+				.TXBuffer                       = Bench_CDC_TXBuffer,
+				.TXBufferSize                   = sizeof(Bench_CDC_TXBuffer),
+				.RXBuffer                       = Bench_CDC_RXBuffer,
+				.RXBufferSize                   = sizeof(Bench_CDC_RXBuffer),
+			},
+	};
+
+/** Configures the CDC interface, and sets a line encoding as the host would when opening the virtual serial port. */
+static void Bench_CDCDevice_Configure(void)
+{
+	CDC_Device_ConfigureEndpoints(&Bench_CDC_Interface);
+	Bench_CDC_Interface.State.LineEncoding.BaudRateBPS = 115200;
+
+	USB_Sim_Host_SetEndpointMode(BENCH_IN_EPNUM, USB_SIM_ENDPOINT_Discard);
+}
+
+/** Configures the buffered CDC interface, and sets a line encoding as the host would when opening the virtual serial port. */
+static void Bench_CDCDevice_Buffered_Configure(void)
+{
+	CDC_Device_ConfigureEndpoints(&Bench_CDC_Buffered_Interface);
+	Bench_CDC_Buffered_Interface.State.LineEncoding.BaudRateBPS = 115200;
+
+	USB_Sim_Host_SetEndpointMode(BENCH_IN_EPNUM, USB_SIM_ENDPOINT_Discard);
+}
+
+void Bench_CDCDevice(void)
+{
+	static uint8_t HostData[CDC_BYTES];
+
+	Benchmark_ConnectDevice(Bench_CDCDevice_Configure);
+
+	Benchmark_Begin("cdc_device_sendbyte");
+
+	for (uint16_t ByteIndex = 0; ByteIndex < CDC_BYTES; ByteIndex++)
+	  CDC_Device_SendByte(&Bench_CDC_Interface, ByteIndex);
+
+	CDC_Device_Flush(&Bench_CDC_Interface);
+
+	Benchmark_End(CDC_BYTES, 1);
+
+	USB_Sim_Host_Write(BENCH_OUT_EPNUM, HostData, sizeof(HostData));
+
+	Benchmark_Begin("cdc_device_receivebyte");
+
+	uint16_t BytesRead = 0;
+
+	while (BytesRead < CDC_BYTES)
+	{
+		uint16_t BytesInBank = CDC_Device_BytesReceived(&Bench_CDC_Interface);
+
+		while (BytesInBank--)
+		{
+			CDC_Device_ReceiveByte(&Bench_CDC_Interface);
+			BytesRead++;
+		}
+
+		CDC_Device_USBTask(&Bench_CDC_Interface);
+	}
+
+	Benchmark_End(CDC_BYTES, 1);
+
+	Benchmark_Begin("cdc_device_senddata");
+
+	for (uint16_t BlockIndex = 0; BlockIndex < (CDC_BYTES / CDC_BLOCK_SIZE); BlockIndex++)
+	  CDC_Device_SendData(&Bench_CDC_Interface, HostData, CDC_BLOCK_SIZE);
+
+	CDC_Device_Flush(&Bench_CDC_Interface);
+
+	Benchmark_End((CDC_BYTES / CDC_BLOCK_SIZE), CDC_BLOCK_SIZE);
+
+	Benchmark_ConnectDevice(Bench_CDCDevice_Buffered_Configure);
+
+	Benchmark_Begin("cdc_device_buffered_sendbyte");
+
+	for (uint16_t ByteIndex = 0; ByteIndex < CDC_BYTES; ByteIndex++)
+	{
+		CDC_Device_SendByte(&Bench_CDC_Buffered_Interface, ByteIndex);
+
+		if (!(ByteIndex % CDC_BLOCK_SIZE))
+		  CDC_Device_USBTask(&Bench_CDC_Buffered_Interface);
+	}
+
+	CDC_Device_Flush(&Bench_CDC_Buffered_Interface);
+
+	Benchmark_End(CDC_BYTES, 1);
+
+	Benchmark_Begin("cdc_device_buffered_senddata");
+
+	for (uint16_t BlockIndex = 0; BlockIndex < (CDC_BYTES / CDC_BLOCK_SIZE); BlockIndex++)
+	{
+		CDC_Device_SendData(&Bench_CDC_Buffered_Interface, HostData, CDC_BLOCK_SIZE);
+		CDC_Device_USBTask(&Bench_CDC_Buffered_Interface);
+	}
+
+	CDC_Device_Flush(&Bench_CDC_Buffered_Interface);
+
+	Benchmark_End((CDC_BYTES / CDC_BLOCK_SIZE), CDC_BLOCK_SIZE);
+
+	USB_Sim_Host_Write(BENCH_OUT_EPNUM, HostData, sizeof(HostData));
+
+	Benchmark_Begin("cdc_device_buffered_receivebyte");
+
+	BytesRead = 0;
+
+	while (BytesRead < CDC_BYTES)
+	{
+		CDC_Device_USBTask(&Bench_CDC_Buffered_Interface);
+
+		uint16_t BytesInBuffer = CDC_Device_BytesReceived(&Bench_CDC_Buffered_Interface);
+
+		while (BytesInBuffer--)
+		{
+			CDC_Device_ReceiveByte(&Bench_CDC_Buffered_Interface);
+			BytesRead++;
+		}
+	}
+
+	Benchmark_End(CDC_BYTES, 1);
+
+	USB_Sim_Host_Write(BENCH_OUT_EPNUM, HostData, sizeof(HostData));
+
+	Benchmark_Begin("cdc_device_buffered_receivedata");
+
+	uint8_t  Block[CDC_BLOCK_SIZE];
+	uint16_t BlocksRead = 0;
+
+	BytesRead = 0;
+
+	while (BytesRead < CDC_BYTES)
+	{
+		CDC_Device_USBTask(&Bench_CDC_Buffered_Interface);
+
+		BytesRead += CDC_Device_ReceiveData(&Bench_CDC_Buffered_Interface, Block, sizeof(Block));
+		BlocksRead++;
+	}
+
+	Benchmark_End(BlocksRead, 0);
+}
@@ -0,0 +1,102 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Benchmarks for the low level endpoint stream functions.
+ */
+
+#include "Benchmarks.h"
+
+/** Number of bytes transferred in each large stream operation. */
+#define STREAM_LENGTH           4096
+
+/** Number of large stream operations performed in each direction. */
+#define STREAM_OPERATIONS       16
+
+/** Number of bytes transferred in each small stream operation. */
+#define SMALL_STREAM_LENGTH     8
+
+/** Number of small stream operations performed. */
+#define SMALL_STREAM_OPERATIONS 512
+
+static uint8_t StreamData[STREAM_LENGTH];
+
+/** Configures the bulk endpoints used by the stream benchmarks. */
+static void Bench_EndpointStream_Configure(void)
+{
+	Endpoint_ConfigureEndpoint(BENCH_IN_EPNUM, EP_TYPE_BULK, ENDPOINT_DIR_IN, BENCH_BULK_EPSIZE, ENDPOINT_BANK_DOUBLE);
+	Endpoint_ConfigureEndpoint(BENCH_OUT_EPNUM, EP_TYPE_BULK, ENDPOINT_DIR_OUT, BENCH_BULK_EPSIZE, ENDPOINT_BANK_DOUBLE);
+
+	USB_Sim_Host_SetEndpointMode(BENCH_IN_EPNUM, USB_SIM_ENDPOINT_Discard);
+}
+
+void Bench_EndpointStream(void)
+{
+	Benchmark_ConnectDevice(Bench_EndpointStream_Configure);
+
+	for (uint16_t i = 0; i < sizeof(StreamData); i++)
+	  StreamData[i] = i;
+
+	Benchmark_Begin("endpoint_write_stream_le");
+
+	for (uint8_t Operation = 0; Operation < STREAM_OPERATIONS; Operation++)
+	{
+		Endpoint_SelectEndpoint(BENCH_IN_EPNUM);
+		Endpoint_Write_Stream_LE(StreamData, STREAM_LENGTH, NO_STREAM_CALLBACK);
+		Endpoint_ClearIN();
+	}
+
+	Benchmark_End(STREAM_OPERATIONS, STREAM_LENGTH);
+
+	Benchmark_Begin("endpoint_write_stream_le_small");
+
+	for (uint16_t Operation = 0; Operation < SMALL_STREAM_OPERATIONS; Operation++)
+	{
+		Endpoint_SelectEndpoint(BENCH_IN_EPNUM);
+		Endpoint_Write_Stream_LE(StreamData, SMALL_STREAM_LENGTH, NO_STREAM_CALLBACK);
+		Endpoint_ClearIN();
+	}
+
+	Benchmark_End(SMALL_STREAM_OPERATIONS, SMALL_STREAM_LENGTH);
+
+	Benchmark_Begin("endpoint_read_stream_le");
+
+	for (uint8_t Operation = 0; Operation < STREAM_OPERATIONS; Operation++)
+	{
+		USB_Sim_Host_Write(BENCH_OUT_EPNUM, StreamData, STREAM_LENGTH);
+
+		Endpoint_SelectEndpoint(BENCH_OUT_EPNUM);
+		Endpoint_Read_Stream_LE(StreamData, STREAM_LENGTH, NO_STREAM_CALLBACK);
+		Endpoint_ClearOUT();
+	}
+
+	Benchmark_End(STREAM_OPERATIONS, STREAM_LENGTH);
+}
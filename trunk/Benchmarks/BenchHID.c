@@ -0,0 +1,202 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Benchmarks for the HID device class driver.
+ */
+
+#include "Benchmarks.h"
+
+#include <LUFA/Drivers/USB/Class/HID.h>
+
+/** Number of HID reports generated in each benchmark. */
+#define HID_REPORTS             1024
+
+/** Size of the benchmark's mouse style HID input report, in bytes. */
+#define HID_REPORT_SIZE         3
+
+/** Number of input report IDs sent from the HID interface in the report slot benchmarks. */
+#define HID_REPORT_SLOTS        2
+
+/** Buffer to hold the previously generated HID report, for comparison purposes inside the HID class driver. */
+static uint8_t PrevHIDReportBuffer[HID_REPORT_SIZE];
+
+/** Buffers holding the current contents of each input report in the report slot benchmarks. */
+static uint8_t SlotHIDReportBuffers[HID_REPORT_SLOTS][HID_REPORT_SIZE];
+
+/** Input report slots of the HID interface in the report slot benchmarks, one per report ID. */
+static USB_HID_Device_ReportSlot_t HIDReportSlots[HID_REPORT_SLOTS] =
+	{
+		{.ReportID = 1, .ReportSize = HID_REPORT_SIZE, .ReportData = SlotHIDReportBuffers[0]},
+		{.ReportID = 2, .ReportSize = HID_REPORT_SIZE, .ReportData = SlotHIDReportBuffers[1]},
+	};
+
+/** LUFA HID Class driver interface configuration and state information for the HID benchmarks. */
+static USB_ClassInfo_HID_Device_t Bench_HID_Interface =
+	{
+		.Config =
+			{
+				.InterfaceNumber            = 0,
+
+				.ReportINEndpointNumber     = BENCH_IN_EPNUM,
+				.ReportINEndpointSize       = BENCH_NOTIFICATION_EPSIZE,
+				.ReportINEndpointDoubleBank = false,
+
+				.PrevReportINBuffer         = PrevHIDReportBuffer,
+				.PrevReportINBufferSize     = sizeof(PrevHIDReportBuffer),
+			},
+	};
+
+/** LUFA HID Class driver interface configuration and state information for the HID report slot benchmarks. */
+static USB_ClassInfo_HID_Device_t Bench_HIDSlots_Interface =
+	{
+		.Config =
+			{
+				.InterfaceNumber            = 0,
+
+				.ReportINEndpointNumber     = BENCH_IN_EPNUM,
+				.ReportINEndpointSize       = BENCH_NOTIFICATION_EPSIZE,
+				.ReportINEndpointDoubleBank = false,
+
+				.PrevReportINBuffer         = NULL,
+				.PrevReportINBufferSize     = HID_REPORT_SIZE,
+
+				.ReportINSlots              = HIDReportSlots,
+				.TotalReportINSlots         = HID_REPORT_SLOTS,
+			},
+	};
+
+/** Number of reports created by \ref CALLBACK_HID_Device_CreateHIDReport() since the last benchmark started. */
+static uint16_t ReportsCreated;
+
+/** Indicates if each created report should differ from the previous report, forcing it to be sent to the host. */
+static bool ReportsChange;
+
+/** Configures the HID interface. */
+static void Bench_HIDDevice_Configure(void)
+{
+	HID_Device_ConfigureEndpoints(&Bench_HID_Interface);
+
+	USB_Sim_Host_SetEndpointMode(BENCH_IN_EPNUM, USB_SIM_ENDPOINT_Discard);
+}
+
+/** Configures the HID interface used in the report slot benchmarks. */
+static void Bench_HIDDevice_ConfigureSlots(void)
+{
+	HID_Device_ConfigureEndpoints(&Bench_HIDSlots_Interface);
+
+	USB_Sim_Host_SetEndpointMode(BENCH_IN_EPNUM, USB_SIM_ENDPOINT_Discard);
+}
+
+void Bench_HIDDevice(void)
+{
+	Benchmark_ConnectDevice(Bench_HIDDevice_Configure);
+
+	ReportsChange  = true;
+	ReportsCreated = 0;
+
+	Benchmark_Begin("hid_device_usbtask_report_sent");
+
+	while (ReportsCreated < HID_REPORTS)
+	  HID_Device_USBTask(&Bench_HID_Interface);
+
+	Benchmark_End(HID_REPORTS, HID_REPORT_SIZE);
+
+	ReportsChange  = false;
+	ReportsCreated = 0;
+
+	/* Send the first unchanged report to clear the idle period before measuring */
+	while (!(ReportsCreated))
+	  HID_Device_USBTask(&Bench_HID_Interface);
+
+	ReportsCreated = 0;
+
+	Benchmark_Begin("hid_device_usbtask_report_unchanged");
+
+	while (ReportsCreated < HID_REPORTS)
+	  HID_Device_USBTask(&Bench_HID_Interface);
+
+	Benchmark_End(HID_REPORTS, 0);
+
+	Benchmark_ConnectDevice(Bench_HIDDevice_ConfigureSlots);
+
+	/* Send each slot's initial report to clear the idle periods before measuring */
+	for (uint8_t Poll = 0; Poll < (HID_REPORT_SLOTS * 4); Poll++)
+	{
+		HID_Device_USBTask(&Bench_HIDSlots_Interface);
+		USB_Sim_Sync();
+	}
+
+	Benchmark_Begin("hid_device_slots_report_sent");
+
+	for (uint16_t Report = 0; Report < HID_REPORTS; Report++)
+	{
+		uint8_t ReportID = ((Report % HID_REPORT_SLOTS) + 1);
+
+		SlotHIDReportBuffers[ReportID - 1][1] = (uint8_t)Report;
+		HID_Device_MarkReportChanged(&Bench_HIDSlots_Interface, ReportID);
+
+		while (HIDReportSlots[ReportID - 1].Changed)
+		  HID_Device_USBTask(&Bench_HIDSlots_Interface);
+	}
+
+	Benchmark_End(HID_REPORTS, HID_REPORT_SIZE);
+
+	Benchmark_Begin("hid_device_slots_report_unchanged");
+
+	for (uint16_t Poll = 0; Poll < HID_REPORTS; Poll++)
+	  HID_Device_USBTask(&Bench_HIDSlots_Interface);
+
+	Benchmark_End(HID_REPORTS, 0);
+}
+
+/** HID class driver callback function for the creation of HID reports to the host. */
+bool CALLBACK_HID_Device_CreateHIDReport(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo, uint8_t* const ReportID,
+                                         const uint8_t ReportType, void* ReportData, uint16_t* ReportSize)
+{
+	uint8_t* Report = (uint8_t*)ReportData;
+
+	Report[0] = 0;
+	Report[1] = (ReportsChange) ? (uint8_t)ReportsCreated : 0;
+	Report[2] = 0;
+
+	*ReportSize = HID_REPORT_SIZE;
+	ReportsCreated++;
+
+	return false;
+}
+
+/** HID class driver callback function for the processing of HID reports from the host. */
+void CALLBACK_HID_Device_ProcessHIDReport(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo, const uint8_t ReportID,
+                                          const void* ReportData, const uint16_t ReportSize)
+{
+
+}
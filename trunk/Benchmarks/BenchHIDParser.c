@@ -0,0 +1,227 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Benchmarks for the host mode HID report parser. These routines perform no USB controller accesses, thus their
+ *  cost is tracked by the number of library basic blocks executed. The per-item and compiled plan extraction
+ *  benchmarks extract the same items of the same mouse report, so that their costs may be compared directly.
+ */
+
+#include "Benchmarks.h"
+
+#if defined(USB_CAN_BE_HOST)
+
+#include <LUFA/Drivers/USB/Class/Host/HIDParser.h>
+
+/** Number of times the report descriptor is parsed. */
+#define HID_PARSE_OPERATIONS    1024
+
+/** Number of input reports whose items are extracted. */
+#define HID_EXTRACT_OPERATIONS  16384
+
+/** HID report descriptor of a combined keyboard (report ID 1) and mouse with scroll wheel (report ID 2). */
+static const uint8_t ReportDescriptor[] =
+{
+	0x05, 0x01,          /* Usage Page (Generic Desktop)             */
+	0x09, 0x06,          /* Usage (Keyboard)                         */
+	0xA1, 0x01,          /* Collection (Application)                 */
+	0x85, 0x01,          /*   Report ID (1)                          */
+	0x75, 0x01,          /*   Report Size (1)                        */
+	0x95, 0x08,          /*   Report Count (8)                       */
+	0x05, 0x07,          /*   Usage Page (Key Codes)                 */
+	0x19, 0xE0,          /*   Usage Minimum (Keyboard LeftControl)   */
+	0x29, 0xE7,          /*   Usage Maximum (Keyboard Right GUI)     */
+	0x15, 0x00,          /*   Logical Minimum (0)                    */
+	0x25, 0x01,          /*   Logical Maximum (1)                    */
+	0x81, 0x02,          /*   Input (Data, Variable, Absolute)       */
+	0x95, 0x01,          /*   Report Count (1)                       */
+	0x75, 0x08,          /*   Report Size (8)                        */
+	0x81, 0x03,          /*   Input (Const, Variable, Absolute)      */
+	0x95, 0x05,          /*   Report Count (5)                       */
+	0x75, 0x01,          /*   Report Size (1)                        */
+	0x05, 0x08,          /*   Usage Page (LEDs)                      */
+	0x19, 0x01,          /*   Usage Minimum (Num Lock)               */
+	0x29, 0x05,          /*   Usage Maximum (Kana)                   */
+	0x91, 0x02,          /*   Output (Data, Variable, Absolute)      */
+	0x95, 0x01,          /*   Report Count (1)                       */
+	0x75, 0x03,          /*   Report Size (3)                        */
+	0x91, 0x03,          /*   Output (Const, Variable, Absolute)     */
+	0x95, 0x06,          /*   Report Count (6)                       */
+	0x75, 0x08,          /*   Report Size (8)                        */
+	0x15, 0x00,          /*   Logical Minimum (0)                    */
+	0x25, 0x65,          /*   Logical Maximum (101)                  */
+	0x05, 0x07,          /*   Usage Page (Keyboard)                  */
+	0x19, 0x00,          /*   Usage Minimum (Reserved (no event))    */
+	0x29, 0x65,          /*   Usage Maximum (Keyboard Application)   */
+	0x81, 0x00,          /*   Input (Data, Array, Absolute)          */
+	0xC0,                /* End Collection                           */
+
+	0x05, 0x01,          /* Usage Page (Generic Desktop)             */
+	0x09, 0x02,          /* Usage (Mouse)                            */
+	0xA1, 0x01,          /* Collection (Application)                 */
+	0x85, 0x02,          /*   Report ID (2)                          */
+	0x09, 0x01,          /*   Usage (Pointer)                        */
+	0xA1, 0x00,          /*   Collection (Physical)                  */
+	0x95, 0x03,          /*     Report Count (3)                     */
+	0x75, 0x01,          /*     Report Size (1)                      */
+	0x05, 0x09,          /*     Usage Page (Button)                  */
+	0x19, 0x01,          /*     Usage Minimum (Button 1)             */
+	0x29, 0x03,          /*     Usage Maximum (Button 3)             */
+	0x15, 0x00,          /*     Logical Minimum (0)                  */
+	0x25, 0x01,          /*     Logical Maximum (1)                  */
+	0x81, 0x02,          /*     Input (Data, Variable, Absolute)     */
+	0x95, 0x01,          /*     Report Count (1)                     */
+	0x75, 0x05,          /*     Report Size (5)                      */
+	0x81, 0x01,          /*     Input (Constant)                     */
+	0x75, 0x08,          /*     Report Size (8)                      */
+	0x95, 0x03,          /*     Report Count (3)                     */
+	0x05, 0x01,          /*     Usage Page (Generic Desktop Control) */
+	0x09, 0x30,          /*     Usage X                              */
+	0x09, 0x31,          /*     Usage Y                              */
+	0x09, 0x38,          /*     Usage Wheel                          */
+	0x15, 0x81,          /*     Logical Minimum (-127)               */
+	0x25, 0x7F,          /*     Logical Maximum (127)                */
+	0x81, 0x06,          /*     Input (Data, Variable, Relative)     */
+	0xC0,                /*   End Collection                         */
+	0xC0                 /* End Collection                           */
+};
+
+/** Processed HID report descriptor, filled out by the HID parser. */
+static HID_ReportInfo_t HIDReportInfo;
+
+/** Processed HID report descriptor, filled out by the HID parser in compact storage mode. */
+static HID_CompactReportInfo_t HIDCompactReportInfo;
+
+/** Arena holding the report items, collections and attributes of the compact processed HID report descriptor. */
+static uint8_t HIDCompactArena[512];
+
+/** Compiled report plan of the mouse input report. */
+static HID_ReportPlan_t MouseReportPlan;
+
+void Bench_HIDParser(void)
+{
+	bool ParseFailed = false;
+
+	Benchmark_Begin("hid_parser_process_report");
+
+	for (uint16_t Operation = 0; Operation < HID_PARSE_OPERATIONS; Operation++)
+	{
+		if (USB_ProcessHIDReport(ReportDescriptor, sizeof(ReportDescriptor), &HIDReportInfo) != HID_PARSE_Successful)
+		  ParseFailed = true;
+	}
+
+	Benchmark_End(HID_PARSE_OPERATIONS, sizeof(ReportDescriptor));
+
+	/* Measure the descriptor first as an application would, to check that the arena is large enough */
+	if ((USB_ProcessHIDReportCompact(ReportDescriptor, sizeof(ReportDescriptor), &HIDCompactReportInfo,
+	                                 NULL, 0) != HID_PARSE_Successful) ||
+	    (HIDCompactReportInfo.RequiredArenaSize > sizeof(HIDCompactArena)))
+	{
+		ParseFailed = true;
+	}
+
+	Benchmark_Begin("hid_parser_process_report_compact");
+
+	for (uint16_t Operation = 0; Operation < HID_PARSE_OPERATIONS; Operation++)
+	{
+		if (USB_ProcessHIDReportCompact(ReportDescriptor, sizeof(ReportDescriptor), &HIDCompactReportInfo,
+		                                HIDCompactArena, sizeof(HIDCompactArena)) != HID_PARSE_Successful)
+		{
+			ParseFailed = true;
+		}
+	}
+
+	Benchmark_End(HID_PARSE_OPERATIONS, sizeof(ReportDescriptor));
+
+	if (ParseFailed)
+	  fprintf(stderr, "HID report descriptor could not be parsed.\n");
+
+	fprintf(stderr, "HID parser storage: %u bytes in compact mode (%u byte arena), %u bytes in standard mode.\n",
+	        (unsigned)(sizeof(HIDCompactReportInfo) + HIDCompactReportInfo.RequiredArenaSize),
+	        HIDCompactReportInfo.RequiredArenaSize, (unsigned)sizeof(HIDReportInfo));
+
+	uint8_t  MouseReport[] = {0x02, 0x05, 0x10, 0xF0, 0x01};
+	uint32_t MouseValues[HID_MAX_PLAN_STEPS];
+
+	if (!(USB_CompileHIDReportPlan(&HIDReportInfo, 0x02, REPORT_ITEM_TYPE_In, &MouseReportPlan)))
+	  fprintf(stderr, "HID report plan could not be compiled.\n");
+
+	USB_UnpackHIDReport(&MouseReportPlan, MouseReport, MouseValues);
+
+	for (uint8_t StepIndex = 0; StepIndex < MouseReportPlan.TotalSteps; StepIndex++)
+	{
+		HID_ReportItem_t* ReportItem = &HIDReportInfo.ReportItems[MouseReportPlan.Steps[StepIndex].ItemIndex];
+		uint32_t          ValueMask  = (0xFFFFFFFF >> (32 - ReportItem->Attributes.BitSize));
+
+		USB_GetHIDReportItemInfo(MouseReport, ReportItem);
+
+		if ((MouseValues[StepIndex] & ValueMask) != ReportItem->Value)
+		  fprintf(stderr, "HID report plan extracted a different value than USB_GetHIDReportItemInfo().\n");
+	}
+
+	Benchmark_Begin("hid_parser_get_report_item_info");
+
+	for (uint16_t Operation = 0; Operation < HID_EXTRACT_OPERATIONS; Operation++)
+	{
+		MouseReport[2] = Operation;
+
+		for (uint8_t StepIndex = 0; StepIndex < MouseReportPlan.TotalSteps; StepIndex++)
+		  USB_GetHIDReportItemInfo(MouseReport, &HIDReportInfo.ReportItems[MouseReportPlan.Steps[StepIndex].ItemIndex]);
+	}
+
+	Benchmark_End(HID_EXTRACT_OPERATIONS, sizeof(MouseReport));
+
+	Benchmark_Begin("hid_parser_unpack_report");
+
+	for (uint16_t Operation = 0; Operation < HID_EXTRACT_OPERATIONS; Operation++)
+	{
+		MouseReport[2] = Operation;
+
+		USB_UnpackHIDReport(&MouseReportPlan, MouseReport, MouseValues);
+	}
+
+	Benchmark_End(HID_EXTRACT_OPERATIONS, sizeof(MouseReport));
+}
+
+/** Callback for the HID report parser, keeping only the input items of each report. */
+bool CALLBACK_HIDParser_FilterHIDReportItem(HID_ReportItem_t* CurrentItem)
+{
+	return (CurrentItem->ItemType == REPORT_ITEM_TYPE_In);
+}
+
+#else
+
+void Bench_HIDParser(void)
+{
+	fprintf(stderr, "HID parser benchmarks skipped, host mode is not available on the selected MCU.\n");
+}
+
+#endif
@@ -0,0 +1,216 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Benchmarks for the binding of the host mode class drivers to an attached device's configuration descriptor.
+ */
+
+#include "Benchmarks.h"
+
+#if defined(USB_CAN_BE_HOST)
+
+#include <LUFA/Drivers/USB/Class/CDC.h>
+#include <LUFA/Drivers/USB/Class/HID.h>
+#include <LUFA/Drivers/USB/Class/MassStorage.h>
+#include <LUFA/Drivers/USB/Class/MIDI.h>
+
+/** Number of times the class drivers are bound to the configuration descriptor. */
+#define HOST_CONFIG_OPERATIONS  1024
+
+/** Configuration descriptor of a composite CDC, Mass Storage and HID device. */
+static uint8_t ConfigDescriptor[] =
+{
+	0x09, 0x02, 0x76, 0x00, 0x04, 0x01, 0x00, 0xC0, 0x32, /* Configuration, 4 interfaces               */
+
+	0x08, 0x0B, 0x00, 0x02, 0x02, 0x02, 0x01, 0x00,       /* Interface Association (CDC)                */
+	0x09, 0x04, 0x00, 0x00, 0x01, 0x02, 0x02, 0x01, 0x00, /* Interface 0, CDC Control                   */
+	0x05, 0x24, 0x00, 0x10, 0x01,                         /*   CDC Header                               */
+	0x04, 0x24, 0x02, 0x06,                               /*   CDC ACM                                  */
+	0x05, 0x24, 0x06, 0x00, 0x01,                         /*   CDC Union                                */
+	0x07, 0x05, 0x82, 0x03, 0x08, 0x00, 0xFF,             /*   Endpoint 2 IN, Interrupt                 */
+	0x09, 0x04, 0x01, 0x00, 0x02, 0x0A, 0x00, 0x00, 0x00, /* Interface 1, CDC Data                      */
+	0x07, 0x05, 0x04, 0x02, 0x10, 0x00, 0x00,             /*   Endpoint 4 OUT, Bulk                     */
+	0x07, 0x05, 0x83, 0x02, 0x10, 0x00, 0x00,             /*   Endpoint 3 IN, Bulk                      */
+
+	0x09, 0x04, 0x02, 0x00, 0x02, 0x08, 0x06, 0x50, 0x00, /* Interface 2, Mass Storage                  */
+	0x07, 0x05, 0x85, 0x02, 0x40, 0x00, 0x00,             /*   Endpoint 5 IN, Bulk                      */
+	0x07, 0x05, 0x06, 0x02, 0x40, 0x00, 0x00,             /*   Endpoint 6 OUT, Bulk                     */
+
+	0x09, 0x04, 0x03, 0x00, 0x01, 0x03, 0x01, 0x01, 0x00, /* Interface 3, HID Keyboard                  */
+	0x09, 0x21, 0x11, 0x01, 0x00, 0x01, 0x22, 0x3F, 0x00, /*   HID                                      */
+	0x07, 0x05, 0x81, 0x03, 0x08, 0x00, 0x0A,             /*   Endpoint 1 IN, Interrupt                 */
+};
+
+/** Configuration descriptor of an audio device with a MIDI interface, placed after more audio streaming interface
+ *  alternate settings than a configuration descriptor index holds at once.
+ */
+static uint8_t AudioMIDIConfigDescriptor[] =
+{
+	0x09, 0x02, 0xA2, 0x00, 0x03, 0x01, 0x00, 0xC0, 0x32, /* Configuration, 3 interfaces               */
+
+	0x09, 0x04, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, /* Interface 0, Audio Control                */
+
+	0x09, 0x04, 0x01, 0x00, 0x00, 0x01, 0x02, 0x00, 0x00, /* Interface 1 Alt 0, Audio Streaming        */
+	0x09, 0x04, 0x01, 0x01, 0x01, 0x01, 0x02, 0x00, 0x00, /* Interface 1 Alt 1, Audio Streaming        */
+	0x07, 0x05, 0x01, 0x01, 0x20, 0x00, 0x01,             /*   Endpoint 1 OUT, Isochronous              */
+	0x09, 0x04, 0x01, 0x02, 0x01, 0x01, 0x02, 0x00, 0x00, /* Interface 1 Alt 2, Audio Streaming        */
+	0x07, 0x05, 0x01, 0x01, 0x40, 0x00, 0x01,             /*   Endpoint 1 OUT, Isochronous              */
+	0x09, 0x04, 0x01, 0x03, 0x01, 0x01, 0x02, 0x00, 0x00, /* Interface 1 Alt 3, Audio Streaming        */
+	0x07, 0x05, 0x01, 0x01, 0x60, 0x00, 0x01,             /*   Endpoint 1 OUT, Isochronous              */
+	0x09, 0x04, 0x01, 0x04, 0x01, 0x01, 0x02, 0x00, 0x00, /* Interface 1 Alt 4, Audio Streaming        */
+	0x07, 0x05, 0x01, 0x01, 0x80, 0x00, 0x01,             /*   Endpoint 1 OUT, Isochronous              */
+	0x09, 0x04, 0x01, 0x05, 0x01, 0x01, 0x02, 0x00, 0x00, /* Interface 1 Alt 5, Audio Streaming        */
+	0x07, 0x05, 0x01, 0x01, 0xA0, 0x00, 0x01,             /*   Endpoint 1 OUT, Isochronous              */
+	0x09, 0x04, 0x01, 0x06, 0x01, 0x01, 0x02, 0x00, 0x00, /* Interface 1 Alt 6, Audio Streaming        */
+	0x07, 0x05, 0x01, 0x01, 0xC0, 0x00, 0x01,             /*   Endpoint 1 OUT, Isochronous              */
+	0x09, 0x04, 0x01, 0x07, 0x01, 0x01, 0x02, 0x00, 0x00, /* Interface 1 Alt 7, Audio Streaming        */
+	0x07, 0x05, 0x01, 0x01, 0xE0, 0x00, 0x01,             /*   Endpoint 1 OUT, Isochronous              */
+
+	0x09, 0x04, 0x02, 0x00, 0x02, 0x01, 0x03, 0x00, 0x00, /* Interface 2, MIDI Streaming               */
+	0x07, 0x05, 0x87, 0x02, 0x40, 0x00, 0x00,             /*   Endpoint 7 IN, Bulk                      */
+	0x07, 0x05, 0x08, 0x02, 0x40, 0x00, 0x00,             /*   Endpoint 8 OUT, Bulk                     */
+};
+
+/** CDC class driver interface configuration and state information. */
+static USB_ClassInfo_CDC_Host_t VirtualSerial_CDC_Interface =
+	{
+		.Config =
+			{
+				.DataINPipeNumber       = 1,
+				.DataOUTPipeNumber      = 2,
+				.NotificationPipeNumber = 3,
+			},
+	};
+
+/** Mass Storage class driver interface configuration and state information. */
+static USB_ClassInfo_MS_Host_t FlashDisk_MS_Interface =
+	{
+		.Config =
+			{
+				.DataINPipeNumber       = 4,
+				.DataOUTPipeNumber      = 5,
+			},
+	};
+
+/** HID class driver interface configuration and state information. */
+static USB_ClassInfo_HID_Host_t Keyboard_HID_Interface =
+	{
+		.Config =
+			{
+				.DataINPipeNumber       = 6,
+				.DataOUTPipeNumber      = 7,
+				.HIDInterfaceProtocol   = HID_BOOT_KEYBOARD_PROTOCOL,
+			},
+	};
+
+/** MIDI class driver interface configuration and state information. */
+static USB_ClassInfo_MIDI_Host_t Keyboard_MIDI_Interface =
+	{
+		.Config =
+			{
+				.DataINPipeNumber       = 1,
+				.DataOUTPipeNumber      = 2,
+			},
+	};
+
+/** Index of the composite device's configuration descriptor, shared between the class drivers. */
+static USB_ConfigIndex_t ConfigIndex;
+
+void Bench_HostConfig(void)
+{
+	bool BindFailed = false;
+
+	Benchmark_Begin("host_configure_pipes_composite");
+
+	for (uint16_t Operation = 0; Operation < HOST_CONFIG_OPERATIONS; Operation++)
+	{
+		Pipe_ClearPipes();
+
+		if (CDC_Host_ConfigurePipes(&VirtualSerial_CDC_Interface, sizeof(ConfigDescriptor), ConfigDescriptor) != CDC_ENUMERROR_NoError)
+		  BindFailed = true;
+
+		if (MS_Host_ConfigurePipes(&FlashDisk_MS_Interface, sizeof(ConfigDescriptor), ConfigDescriptor) != MS_ENUMERROR_NoError)
+		  BindFailed = true;
+
+		if (HID_Host_ConfigurePipes(&Keyboard_HID_Interface, sizeof(ConfigDescriptor), ConfigDescriptor) != HID_ENUMERROR_NoError)
+		  BindFailed = true;
+	}
+
+	Benchmark_End(HOST_CONFIG_OPERATIONS, sizeof(ConfigDescriptor));
+
+	Benchmark_Begin("host_configure_pipes_indexed");
+
+	for (uint16_t Operation = 0; Operation < HOST_CONFIG_OPERATIONS; Operation++)
+	{
+		Pipe_ClearPipes();
+
+		if (USB_IndexConfigDescriptor(&ConfigIndex, sizeof(ConfigDescriptor), ConfigDescriptor) != INDEX_CONFIG_Successful)
+		  BindFailed = true;
+
+		if (CDC_Host_ConfigurePipesIndexed(&VirtualSerial_CDC_Interface, &ConfigIndex) != CDC_ENUMERROR_NoError)
+		  BindFailed = true;
+
+		if (MS_Host_ConfigurePipesIndexed(&FlashDisk_MS_Interface, &ConfigIndex) != MS_ENUMERROR_NoError)
+		  BindFailed = true;
+
+		if (HID_Host_ConfigurePipesIndexed(&Keyboard_HID_Interface, &ConfigIndex) != HID_ENUMERROR_NoError)
+		  BindFailed = true;
+	}
+
+	Benchmark_End(HOST_CONFIG_OPERATIONS, sizeof(ConfigDescriptor));
+
+	Benchmark_Begin("host_configure_pipes_windowed");
+
+	for (uint16_t Operation = 0; Operation < HOST_CONFIG_OPERATIONS; Operation++)
+	{
+		Pipe_ClearPipes();
+
+		if (MIDI_Host_ConfigurePipes(&Keyboard_MIDI_Interface, sizeof(AudioMIDIConfigDescriptor),
+		                             AudioMIDIConfigDescriptor) != MIDI_ENUMERROR_NoError)
+		{
+			BindFailed = true;
+		}
+	}
+
+	Benchmark_End(HOST_CONFIG_OPERATIONS, sizeof(AudioMIDIConfigDescriptor));
+
+	if (BindFailed)
+	  fprintf(stderr, "Host class drivers could not be bound to the configuration descriptor.\n");
+}
+
+#else
+
+void Bench_HostConfig(void)
+{
+	fprintf(stderr, "Host configuration benchmarks skipped, host mode is not available on the selected MCU.\n");
+}
+
+#endif
@@ -0,0 +1,217 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Benchmarks for the MIDI device class driver and System Exclusive message segmenter and assembler.
+ */
+
+#include "Benchmarks.h"
+
+#include <LUFA/Drivers/USB/Class/MIDI.h>
+
+/** Number of MIDI event packets sent or received in each MIDI benchmark. */
+#define MIDI_EVENTS             1024
+
+/** Number of event packets generated by the System Exclusive segmenter in each call of the System Exclusive benchmarks. */
+#define MIDI_SYSEX_BATCH_EVENTS 16
+
+/** Length in bytes of the System Exclusive message sent or received in the System Exclusive benchmarks, including the start
+ *  and end bytes, chosen so that the message exactly fills \ref MIDI_EVENTS event packets.
+ */
+#define MIDI_SYSEX_LENGTH       (MIDI_EVENTS * 3)
+
+/** Size in bytes of the System Exclusive assembler buffer used by the System Exclusive benchmarks. */
+#define MIDI_SYSEX_BUFFER_SIZE  128
+
+/** LUFA MIDI Class driver interface configuration and state information for the MIDI benchmarks. */
+static USB_ClassInfo_MIDI_Device_t Bench_MIDI_Interface =
+	{
+		.Config =
+			{
+				.StreamingInterfaceNumber  = 1,
+
+				.DataINEndpointNumber      = BENCH_IN_EPNUM,
+				.DataINEndpointSize        = BENCH_BULK_EPSIZE,
+				.DataINEndpointDoubleBank  = false,
+
+				.DataOUTEndpointNumber     = BENCH_OUT_EPNUM,
+				.DataOUTEndpointSize       = BENCH_BULK_EPSIZE,
+				.DataOUTEndpointDoubleBank = false,
+			},
+	};
+
+/** Configures the MIDI interface. */
+static void Bench_MIDIDevice_Configure(void)
+{
+	MIDI_Device_ConfigureEndpoints(&Bench_MIDI_Interface);
+
+	USB_Sim_Host_SetEndpointMode(BENCH_IN_EPNUM, USB_SIM_ENDPOINT_Discard);
+}
+
+void Bench_MIDIDevice(void)
+{
+	static MIDI_EventPacket_t Events[MIDI_EVENTS];
+	static uint8_t            SysExMessage[MIDI_SYSEX_LENGTH];
+	static uint8_t            SysExBuffer[MIDI_SYSEX_BUFFER_SIZE];
+	uint16_t                  EventsTransferred;
+
+	for (uint16_t EventIndex = 0; EventIndex < MIDI_EVENTS; EventIndex++)
+	{
+		Events[EventIndex] = (MIDI_EventPacket_t)
+			{
+				.Command     = (MIDI_COMMAND_NOTE_ON >> 4),
+				.CableNumber = 0,
+				.Data1       = (MIDI_COMMAND_NOTE_ON | MIDI_CHANNEL(1)),
+				.Data2       = (EventIndex & 0x7F),
+				.Data3       = MIDI_STANDARD_VELOCITY,
+			};
+	}
+
+	SysExMessage[0] = MIDI_COMMAND_SYSEX_START;
+
+	for (uint16_t ByteIndex = 1; ByteIndex < (MIDI_SYSEX_LENGTH - 1); ByteIndex++)
+	  SysExMessage[ByteIndex] = (ByteIndex & 0x7F);
+
+	SysExMessage[MIDI_SYSEX_LENGTH - 1] = MIDI_COMMAND_SYSEX_END;
+
+	Benchmark_ConnectDevice(Bench_MIDIDevice_Configure);
+
+	Benchmark_Begin("midi_device_send_single");
+
+	for (uint16_t EventIndex = 0; EventIndex < MIDI_EVENTS; EventIndex++)
+	  MIDI_Device_SendEventPacket(&Bench_MIDI_Interface, &Events[EventIndex]);
+
+	MIDI_Device_Flush(&Bench_MIDI_Interface);
+
+	Benchmark_End(MIDI_EVENTS, sizeof(MIDI_EventPacket_t));
+
+	Benchmark_Begin("midi_device_send_batch");
+
+	EventsTransferred = 0;
+
+	while (EventsTransferred < MIDI_EVENTS)
+	{
+		EventsTransferred += MIDI_Device_SendEventPackets(&Bench_MIDI_Interface, &Events[EventsTransferred],
+		                                                  (MIDI_EVENTS - EventsTransferred));
+	}
+
+	MIDI_Device_Flush(&Bench_MIDI_Interface);
+
+	Benchmark_End(MIDI_EVENTS, sizeof(MIDI_EventPacket_t));
+
+	USB_Sim_Host_Write(BENCH_OUT_EPNUM, Events, sizeof(Events));
+
+	Benchmark_Begin("midi_device_receive_single");
+
+	EventsTransferred = 0;
+
+	while (EventsTransferred < MIDI_EVENTS)
+	{
+		if (MIDI_Device_ReceiveEventPacket(&Bench_MIDI_Interface, &Events[EventsTransferred]))
+		  EventsTransferred++;
+	}
+
+	Benchmark_End(MIDI_EVENTS, sizeof(MIDI_EventPacket_t));
+
+	USB_Sim_Host_Write(BENCH_OUT_EPNUM, Events, sizeof(Events));
+
+	Benchmark_Begin("midi_device_receive_batch");
+
+	EventsTransferred = 0;
+
+	while (EventsTransferred < MIDI_EVENTS)
+	{
+		EventsTransferred += MIDI_Device_ReceiveEventPackets(&Bench_MIDI_Interface, &Events[EventsTransferred],
+		                                                     (MIDI_EVENTS - EventsTransferred));
+	}
+
+	Benchmark_End(MIDI_EVENTS, sizeof(MIDI_EventPacket_t));
+
+	/* System Exclusive dump, segmented into small batches of event packets as they are sent */
+	Benchmark_Begin("midi_device_sysex_out");
+
+	MIDI_SysExSegmenter_t Segmenter = {.CableNumber = 0};
+	uint16_t              BytesSent = 0;
+
+	while (BytesSent < MIDI_SYSEX_LENGTH)
+	{
+		MIDI_EventPacket_t SysExEvents[MIDI_SYSEX_BATCH_EVENTS];
+		uint16_t           BytesProcessed;
+		uint16_t           TotalEvents = MIDI_SegmentSysEx(&Segmenter, &SysExMessage[BytesSent], (MIDI_SYSEX_LENGTH - BytesSent),
+		                                                   SysExEvents, MIDI_SYSEX_BATCH_EVENTS, &BytesProcessed);
+
+		BytesSent += BytesProcessed;
+		EventsTransferred = 0;
+
+		while (EventsTransferred < TotalEvents)
+		{
+			EventsTransferred += MIDI_Device_SendEventPackets(&Bench_MIDI_Interface, &SysExEvents[EventsTransferred],
+			                                                  (TotalEvents - EventsTransferred));
+		}
+	}
+
+	MIDI_Device_Flush(&Bench_MIDI_Interface);
+
+	Benchmark_End(MIDI_EVENTS, 3);
+
+	/* System Exclusive dump received into a buffer smaller than the message, as when writing a firmware image to flash */
+	Segmenter = (MIDI_SysExSegmenter_t){.CableNumber = 0};
+	MIDI_SegmentSysEx(&Segmenter, SysExMessage, MIDI_SYSEX_LENGTH, Events, MIDI_EVENTS, &BytesSent);
+	USB_Sim_Host_Write(BENCH_OUT_EPNUM, Events, sizeof(Events));
+
+	Benchmark_Begin("midi_device_sysex_in");
+
+	MIDI_SysExAssembler_t Assembler = {.Buffer = SysExBuffer, .BufferSize = sizeof(SysExBuffer)};
+	uint16_t              BytesReceived = 0;
+
+	while (!(Assembler.MessageComplete))
+	{
+		MIDI_EventPacket_t SysExEvents[MIDI_SYSEX_BATCH_EVENTS];
+		uint16_t           TotalEvents = MIDI_Device_ReceiveEventPackets(&Bench_MIDI_Interface, SysExEvents, MIDI_SYSEX_BATCH_EVENTS);
+		uint16_t           EventIndex  = 0;
+
+		while (EventIndex < TotalEvents)
+		{
+			EventIndex += MIDI_AssembleSysEx(&Assembler, &SysExEvents[EventIndex], (TotalEvents - EventIndex));
+
+			if (Assembler.MessageComplete || (Assembler.Length > (Assembler.BufferSize - 3)))
+			{
+				BytesReceived   += Assembler.Length;
+				Assembler.Length = 0;
+			}
+		}
+	}
+
+	Benchmark_End(MIDI_EVENTS, 3);
+
+	if (BytesReceived != MIDI_SYSEX_LENGTH)
+	  fprintf(stderr, "MIDI System Exclusive benchmark received %u of %u bytes.\n", BytesReceived, MIDI_SYSEX_LENGTH);
+}
@@ -0,0 +1,147 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Benchmarks for the Mass Storage device class driver. A minimal RAM backed SCSI READ (10) command handler is used
+ *  in place of a real storage medium, so that only the overhead of the class driver and block streaming is measured.
+ */
+
+#include "Benchmarks.h"
+
+#include <LUFA/Drivers/USB/Class/MassStorage.h>
+
+/** Size of each simulated storage block, in bytes. */
+#define MS_BLOCK_SIZE           512
+
+/** Number of READ (10) commands issued in each benchmark. */
+#define MS_COMMANDS             16
+
+/** LUFA Mass Storage Class driver interface configuration and state information for the Mass Storage benchmarks. */
+static USB_ClassInfo_MS_Device_t Bench_MS_Interface =
+	{
+		.Config =
+			{
+				.InterfaceNumber           = 0,
+
+				.DataINEndpointNumber      = BENCH_IN_EPNUM,
+				.DataINEndpointSize        = BENCH_BULK_EPSIZE,
+				.DataINEndpointDoubleBank  = false,
+
+				.DataOUTEndpointNumber     = BENCH_OUT_EPNUM,
+				.DataOUTEndpointSize       = BENCH_BULK_EPSIZE,
+				.DataOUTEndpointDoubleBank = false,
+
+				.TotalLUNs                 = 1,
+			},
+	};
+
+/** Contents of every block of the simulated storage medium. */
+static uint8_t BlockData[MS_BLOCK_SIZE];
+
+/** Configures the Mass Storage interface. */
+static void Bench_MassStorageDevice_Configure(void)
+{
+	MS_Device_ConfigureEndpoints(&Bench_MS_Interface);
+
+	USB_Sim_Host_SetEndpointMode(BENCH_IN_EPNUM, USB_SIM_ENDPOINT_Discard);
+}
+
+/** Issues a SCSI READ (10) command for the given number of blocks from the simulated host, and runs the Mass
+ *  Storage class driver until the command has been processed.
+ *
+ *  \param[in] TotalBlocks  Number of blocks to read
+ */
+static void Bench_MassStorageDevice_Read10(const uint16_t TotalBlocks)
+{
+	MS_CommandBlockWrapper_t CommandBlock =
+		{
+			.Signature          = MS_CBW_SIGNATURE,
+			.Tag                = 0x1234,
+			.DataTransferLength = ((uint32_t)TotalBlocks * MS_BLOCK_SIZE),
+			.Flags              = MS_COMMAND_DIR_DATA_IN,
+			.LUN                = 0,
+			.SCSICommandLength  = 10,
+			.SCSICommandData    = {SCSI_CMD_READ_10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			                       (TotalBlocks >> 8), (TotalBlocks & 0xFF), 0x00},
+		};
+
+	USB_Sim_Host_Write(BENCH_OUT_EPNUM, &CommandBlock, sizeof(CommandBlock));
+
+	/* Process the command once the command block has been received by the device */
+	while (!(Bench_MS_Interface.State.CommandStatus.Tag))
+	  MS_Device_USBTask(&Bench_MS_Interface);
+
+	Bench_MS_Interface.State.CommandStatus.Tag = 0;
+}
+
+void Bench_MassStorageDevice(void)
+{
+	Benchmark_ConnectDevice(Bench_MassStorageDevice_Configure);
+
+	Benchmark_Begin("ms_device_read10_1_block");
+
+	for (uint8_t Command = 0; Command < MS_COMMANDS; Command++)
+	  Bench_MassStorageDevice_Read10(1);
+
+	Benchmark_End(MS_COMMANDS, MS_BLOCK_SIZE);
+
+	Benchmark_Begin("ms_device_read10_8_blocks");
+
+	for (uint8_t Command = 0; Command < MS_COMMANDS; Command++)
+	  Bench_MassStorageDevice_Read10(8);
+
+	Benchmark_End(MS_COMMANDS, (8 * MS_BLOCK_SIZE));
+}
+
+/** Mass Storage class driver callback for the processing of received SCSI commands. Only the READ (10) command is
+ *  supported, returning the contents of \ref BlockData for each requested block.
+ */
+bool CALLBACK_MS_Device_SCSICommandReceived(USB_ClassInfo_MS_Device_t* const MSInterfaceInfo)
+{
+	if (MSInterfaceInfo->State.CommandBlock.SCSICommandData[0] != SCSI_CMD_READ_10)
+	  return false;
+
+	uint16_t TotalBlocks = ((MSInterfaceInfo->State.CommandBlock.SCSICommandData[7] << 8) |
+	                         MSInterfaceInfo->State.CommandBlock.SCSICommandData[8]);
+
+	while (TotalBlocks--)
+	{
+		if (Endpoint_Write_Stream_LE(BlockData, MS_BLOCK_SIZE, NO_STREAM_CALLBACK))
+		  return false;
+
+		MSInterfaceInfo->State.CommandBlock.DataTransferLength -= MS_BLOCK_SIZE;
+	}
+
+	if (!(Endpoint_IsReadWriteAllowed()))
+	  Endpoint_ClearIN();
+
+	return true;
+}
@@ -0,0 +1,216 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Benchmarks for the RNDIS device class driver.
+ */
+
+#include "Benchmarks.h"
+
+#include <LUFA/Drivers/USB/Class/RNDIS.h>
+
+/** Number of Ethernet frames transferred in each direction. */
+#define RNDIS_FRAMES            32
+
+/** Size of each transferred Ethernet frame, in bytes. */
+#define RNDIS_FRAME_SIZE        ETHERNET_FRAME_SIZE_MAX
+
+/** Number of RNDIS packets combined into each bulk transfer, and frame slots queued in each direction, in the
+ *  batched transfer benchmarks.
+ */
+#define RNDIS_BATCH_SIZE        2
+
+/** Additional frame slots used by the batched transfer benchmarks, in each direction. */
+static Ethernet_Frame_Info_t Bench_RNDIS_ExtraFramesIN[RNDIS_BATCH_SIZE - 1];
+static Ethernet_Frame_Info_t Bench_RNDIS_ExtraFramesOUT[RNDIS_BATCH_SIZE - 1];
+
+/** LUFA RNDIS Class driver interface configuration and state information for the RNDIS benchmarks. */
+static USB_ClassInfo_RNDIS_Device_t Bench_RNDIS_Interface =
+	{
+		.Config =
+			{
+				.ControlInterfaceNumber         = 0,
+
+				.DataINEndpointNumber           = BENCH_IN_EPNUM,
+				.DataINEndpointSize             = BENCH_BULK_EPSIZE,
+				.DataINEndpointDoubleBank       = false,
+
+				.DataOUTEndpointNumber          = BENCH_OUT_EPNUM,
+				.DataOUTEndpointSize            = BENCH_BULK_EPSIZE,
+				.DataOUTEndpointDoubleBank      = false,
+
+				.NotificationEndpointNumber     = BENCH_NOTIFICATION_EPNUM,
+				.NotificationEndpointSize       = BENCH_NOTIFICATION_EPSIZE,
+				.NotificationEndpointDoubleBank = false,
+
+				.AdapterVendorDescription       = "LUFA Benchmark",
+				.AdapterMACAddress              = {{0x02, 0x00, 0x02, 0x00, 0x02, 0x00}},
+			},
+	};
+
+/** LUFA RNDIS Class driver interface configuration and state information for the batched RNDIS benchmarks. */
+static USB_ClassInfo_RNDIS_Device_t Bench_RNDIS_BatchInterface =
+	{
+		.Config =
+			{
+				.ControlInterfaceNumber         = 0,
+
+				.DataINEndpointNumber           = BENCH_IN_EPNUM,
+				.DataINEndpointSize             = BENCH_BULK_EPSIZE,
+				.DataINEndpointDoubleBank       = false,
+
+				.DataOUTEndpointNumber          = BENCH_OUT_EPNUM,
+				.DataOUTEndpointSize            = BENCH_BULK_EPSIZE,
+				.DataOUTEndpointDoubleBank      = false,
+
+				.NotificationEndpointNumber     = BENCH_NOTIFICATION_EPNUM,
+				.NotificationEndpointSize       = BENCH_NOTIFICATION_EPSIZE,
+				.NotificationEndpointDoubleBank = false,
+
+				.AdapterVendorDescription       = "LUFA Benchmark",
+				.AdapterMACAddress              = {{0x02, 0x00, 0x02, 0x00, 0x02, 0x00}},
+
+				.ExtraFramesIN                  = Bench_RNDIS_ExtraFramesIN,
+				.TotalExtraFramesIN             = (RNDIS_BATCH_SIZE - 1),
+				.ExtraFramesOUT                 = Bench_RNDIS_ExtraFramesOUT,
+				.TotalExtraFramesOUT            = (RNDIS_BATCH_SIZE - 1),
+				.MaxPacketsPerTransfer          = RNDIS_BATCH_SIZE,
+			},
+	};
+
+/** Configures the RNDIS interface, and places it into the data initialized state as the host would after
+ *  sending the RNDIS initialization and packet filter messages.
+ */
+static void Bench_RNDISDevice_Configure(void)
+{
+	RNDIS_Device_ConfigureEndpoints(&Bench_RNDIS_Interface);
+	Bench_RNDIS_Interface.State.CurrRNDISState = RNDIS_Data_Initialized;
+
+	USB_Sim_Host_SetEndpointMode(BENCH_IN_EPNUM, USB_SIM_ENDPOINT_Discard);
+}
+
+/** Configures the batched RNDIS interface, and places it into the data initialized state as the host would after
+ *  sending the RNDIS initialization and packet filter messages, with a host maximum transfer size large enough to
+ *  hold a full batch of packets.
+ */
+static void Bench_RNDISDevice_ConfigureBatch(void)
+{
+	RNDIS_Device_ConfigureEndpoints(&Bench_RNDIS_BatchInterface);
+	Bench_RNDIS_BatchInterface.State.CurrRNDISState      = RNDIS_Data_Initialized;
+	Bench_RNDIS_BatchInterface.State.HostMaxTransferSize = (RNDIS_BATCH_SIZE * (sizeof(RNDIS_Packet_Message_t) + RNDIS_FRAME_SIZE));
+
+	USB_Sim_Host_SetEndpointMode(BENCH_IN_EPNUM, USB_SIM_ENDPOINT_Discard);
+}
+
+void Bench_RNDISDevice(void)
+{
+	static uint8_t HostPacket[sizeof(RNDIS_Packet_Message_t) + RNDIS_FRAME_SIZE];
+
+	RNDIS_Packet_Message_t* PacketHeader = (RNDIS_Packet_Message_t*)HostPacket;
+
+	PacketHeader->MessageType   = REMOTE_NDIS_PACKET_MSG;
+	PacketHeader->MessageLength = sizeof(HostPacket);
+	PacketHeader->DataOffset    = (sizeof(RNDIS_Packet_Message_t) - sizeof(RNDIS_Message_Header_t));
+	PacketHeader->DataLength    = RNDIS_FRAME_SIZE;
+
+	Benchmark_ConnectDevice(Bench_RNDISDevice_Configure);
+
+	Benchmark_Begin("rndis_device_usbtask_frame_out");
+
+	for (uint8_t Frame = 0; Frame < RNDIS_FRAMES; Frame++)
+	{
+		USB_Sim_Host_Write(BENCH_OUT_EPNUM, HostPacket, sizeof(HostPacket));
+
+		while (!(Bench_RNDIS_Interface.State.FrameIN.FrameInBuffer))
+		  RNDIS_Device_USBTask(&Bench_RNDIS_Interface);
+
+		Bench_RNDIS_Interface.State.FrameIN.FrameInBuffer = false;
+	}
+
+	Benchmark_End(RNDIS_FRAMES, RNDIS_FRAME_SIZE);
+
+	Benchmark_Begin("rndis_device_usbtask_frame_in");
+
+	for (uint8_t Frame = 0; Frame < RNDIS_FRAMES; Frame++)
+	{
+		Bench_RNDIS_Interface.State.FrameOUT.FrameLength   = RNDIS_FRAME_SIZE;
+		Bench_RNDIS_Interface.State.FrameOUT.FrameInBuffer = true;
+
+		while (Bench_RNDIS_Interface.State.FrameOUT.FrameInBuffer)
+		  RNDIS_Device_USBTask(&Bench_RNDIS_Interface);
+	}
+
+	Benchmark_End(RNDIS_FRAMES, RNDIS_FRAME_SIZE);
+
+	static uint8_t HostTransfer[RNDIS_BATCH_SIZE * sizeof(HostPacket)];
+
+	for (uint8_t Packet = 0; Packet < RNDIS_BATCH_SIZE; Packet++)
+	  memcpy(&HostTransfer[Packet * sizeof(HostPacket)], HostPacket, sizeof(HostPacket));
+
+	Benchmark_ConnectDevice(Bench_RNDISDevice_ConfigureBatch);
+
+	Benchmark_Begin("rndis_device_usbtask_batch_frame_out");
+
+	for (uint8_t Frame = 0; Frame < RNDIS_FRAMES; Frame += RNDIS_BATCH_SIZE)
+	{
+		USB_Sim_Host_Write(BENCH_OUT_EPNUM, HostTransfer, sizeof(HostTransfer));
+
+		for (uint8_t Packet = 0; Packet < RNDIS_BATCH_SIZE; Packet++)
+		{
+			Ethernet_Frame_Info_t* FrameIN;
+
+			while ((FrameIN = RNDIS_Device_GetReceivedFrame(&Bench_RNDIS_BatchInterface)) == NULL)
+			  RNDIS_Device_USBTask(&Bench_RNDIS_BatchInterface);
+
+			FrameIN->FrameInBuffer = false;
+		}
+	}
+
+	Benchmark_End(RNDIS_FRAMES, RNDIS_FRAME_SIZE);
+
+	Benchmark_Begin("rndis_device_usbtask_batch_frame_in");
+
+	for (uint8_t Frame = 0; Frame < RNDIS_FRAMES; Frame += RNDIS_BATCH_SIZE)
+	{
+		Ethernet_Frame_Info_t* FrameOUT;
+
+		while ((FrameOUT = RNDIS_Device_GetFrameToSend(&Bench_RNDIS_BatchInterface)) != NULL)
+		{
+			FrameOUT->FrameLength   = RNDIS_FRAME_SIZE;
+			FrameOUT->FrameInBuffer = true;
+		}
+
+		while (Bench_RNDIS_BatchInterface.State.FrameOUTCount)
+		  RNDIS_Device_USBTask(&Bench_RNDIS_BatchInterface);
+	}
+
+	Benchmark_End(RNDIS_FRAMES, RNDIS_FRAME_SIZE);
+}
@@ -0,0 +1,362 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Main source file for the LUFA benchmark suite. This file contains the benchmark harness, which runs each class
+ *  driver benchmark against the simulated USB controller and writes the gathered results out as JSON, optionally
+ *  comparing them against a previous set of results.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Benchmarks.h"
+
+/** Maximum number of results which may be gathered in a single run of the suite. */
+#define MAX_RESULTS             64
+
+/** Type define for a single benchmark result. */
+typedef struct
+{
+	char     Name[40]; /**< Name of the benchmark. */
+	uint32_t Operations; /**< Number of operations performed. */
+	uint32_t BytesPerOperation; /**< Number of payload bytes transferred in each operation, or zero if not applicable. */
+	double   RegisterAccessesPerOperation; /**< Average number of USB controller register accesses per operation. */
+	double   DataAccessesPerOperation; /**< Average number of endpoint or pipe data register accesses per operation. */
+	double   BlocksPerOperation; /**< Average number of library basic blocks executed per operation. */
+	uint32_t Frames; /**< Number of simulated USB frames elapsed during the benchmark. */
+	double   HostNSPerOperation; /**< Average host CPU time per operation, in nanoseconds. */
+} Benchmark_Result_t;
+
+/** List of all benchmark routines in the suite, run in order. */
+static const Benchmark_Routine_t Benchmarks[] =
+	{
+		Bench_EndpointStream,
+		Bench_CDCDevice,
+		Bench_MassStorageDevice,
+		Bench_HIDDevice,
+		Bench_RNDISDevice,
+		Bench_AudioDevice,
+		Bench_MIDIDevice,
+		Bench_HIDParser,
+		Bench_HostConfig,
+	};
+
+static Benchmark_Result_t Results[MAX_RESULTS];
+static uint8_t            TotalResults;
+static struct timespec    StartTime;
+
+/** Number of library basic blocks executed since the current benchmark measurement was started. */
+static uint32_t           BlockCount;
+
+/** Coverage instrumentation hook, called by the compiler generated code on entry to each basic block of the
+ *  library sources, which the makefile compiles with the -fsanitize-coverage=trace-pc option. Counting these
+ *  gives a measure of each hot path's CPU cost which, unlike the host CPU time, is exactly repeatable between
+ *  runs and so may be used for regression checks.
+ */
+void __sanitizer_cov_trace_pc(void)
+{
+	BlockCount++;
+}
+
+/** Resets the simulated USB controller, attaches the simulated host and resets the bus, and then places the device
+ *  into the configured state without a full enumeration, calling the given routine to configure the class driver
+ *  under test.
+ *
+ *  \param[in] ConfigureRoutine  Routine to configure the device's endpoints and class driver state
+ */
+void Benchmark_ConnectDevice(Benchmark_ConfigureRoutine_t ConfigureRoutine)
+{
+	USB_Sim_Reset();
+
+	#if defined(USB_CAN_BE_BOTH)
+	USB_Init(USB_MODE_DEVICE);
+	#else
+	USB_Init();
+	#endif
+
+	USB_Sim_Host_Attach();
+	USB_Sim_AdvanceFrames(10);
+	USB_Sim_Host_ResetBus();
+	USB_Sim_AdvanceFrames(2);
+
+	USB_ConfigurationNumber = 1;
+	USB_DeviceState         = DEVICE_STATE_Configured;
+
+	ConfigureRoutine();
+	USB_Sim_Sync();
+}
+
+/** Starts a new benchmark measurement, clearing the simulated controller's statistics.
+ *
+ *  \param[in] Name  Name of the benchmark, as written to the results file
+ */
+void Benchmark_Begin(const char* const Name)
+{
+	if (TotalResults == MAX_RESULTS)
+	{
+		fprintf(stderr, "Too many benchmark results, increase MAX_RESULTS.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	strncpy(Results[TotalResults].Name, Name, sizeof(Results[TotalResults].Name) - 1);
+
+	USB_Sim_Sync();
+	USB_Sim_ClearStatistics();
+	BlockCount = 0;
+	clock_gettime(CLOCK_MONOTONIC, &StartTime);
+}
+
+/** Completes the current benchmark measurement, storing the gathered statistics as a new result.
+ *
+ *  \param[in] Operations         Number of operations performed since \ref Benchmark_Begin() was called
+ *  \param[in] BytesPerOperation  Number of payload bytes transferred per operation, or zero if not applicable
+ */
+void Benchmark_End(const uint32_t Operations, const uint32_t BytesPerOperation)
+{
+	struct timespec EndTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &EndTime);
+	USB_Sim_Sync();
+
+	uint32_t Blocks = BlockCount;
+
+	Benchmark_Result_t* Result = &Results[TotalResults++];
+	double ElapsedNS = (((double)(EndTime.tv_sec - StartTime.tv_sec) * 1e9) + (EndTime.tv_nsec - StartTime.tv_nsec));
+
+	Result->Operations                   = Operations;
+	Result->BytesPerOperation            = BytesPerOperation;
+	Result->RegisterAccessesPerOperation = ((double)USB_Sim_Statistics.RegisterAccesses / Operations);
+	Result->DataAccessesPerOperation     = ((double)USB_Sim_Statistics.DataAccesses / Operations);
+	Result->BlocksPerOperation           = ((double)Blocks / Operations);
+	Result->Frames                       = USB_Sim_Statistics.Frames;
+	Result->HostNSPerOperation           = (ElapsedNS / Operations);
+
+	fprintf(stderr, "%-36s %10.3f reg/op %10.3f data/op %10.3f blocks/op %8u frames\n", Result->Name,
+	        Result->RegisterAccessesPerOperation, Result->DataAccessesPerOperation, Result->BlocksPerOperation,
+	        Result->Frames);
+}
+
+/** Writes all gathered results to the given file as a JSON document, with one benchmark result per line so
+ *  that differences between runs are easily seen with a line based diff.
+ *
+ *  \param[in] OutputFile  File to write the results to
+ *  \param[in] Commit      Revision identifier of the benchmarked source tree, or NULL if unknown
+ */
+static void Benchmark_WriteResults(FILE* const OutputFile, const char* const Commit)
+{
+	fprintf(OutputFile, "{\n");
+	fprintf(OutputFile, "\t\"commit\": \"%s\",\n", (Commit != NULL) ? Commit : "");
+	fprintf(OutputFile, "\t\"mcu\": \"%s\",\n", BENCH_MCU);
+	fprintf(OutputFile, "\t\"options\": \"%s\",\n", BENCH_OPTIONS);
+	fprintf(OutputFile, "\t\"benchmarks\": [\n");
+
+	for (uint8_t ResultIndex = 0; ResultIndex < TotalResults; ResultIndex++)
+	{
+		Benchmark_Result_t* Result = &Results[ResultIndex];
+
+		fprintf(OutputFile, "\t\t{\"name\": \"%s\", \"operations\": %u, \"bytes_per_operation\": %u, "
+		                    "\"register_accesses_per_operation\": %.3f, \"data_accesses_per_operation\": %.3f, "
+		                    "\"blocks_per_operation\": %.3f, \"frames\": %u, \"host_ns_per_operation\": %.1f}%s\n",
+		        Result->Name, Result->Operations, Result->BytesPerOperation, Result->RegisterAccessesPerOperation,
+		        Result->DataAccessesPerOperation, Result->BlocksPerOperation, Result->Frames, Result->HostNSPerOperation,
+		        ((ResultIndex + 1) < TotalResults) ? "," : "");
+	}
+
+	fprintf(OutputFile, "\t]\n");
+	fprintf(OutputFile, "}\n");
+}
+
+/** Computes the percentage change of a per-operation cost from its baseline value. A cost which was zero in the
+ *  baseline but is no longer zero is reported as an unbounded increase, so that it always exceeds the threshold.
+ *
+ *  \param[in] Baseline  Baseline cost per operation
+ *  \param[in] Current   Current cost per operation
+ *
+ *  \return Change in the cost, as a percentage of the baseline cost
+ */
+static double Benchmark_PercentChange(const double Baseline, const double Current)
+{
+	if (Baseline > 0)
+	  return (((Current - Baseline) * 100.0) / Baseline);
+
+	return (Current > 0) ? INFINITY : 0;
+}
+
+/** Compares the gathered results against a previous results file written by \ref Benchmark_WriteResults(),
+ *  reporting the change in register accesses and library basic blocks per operation of each benchmark. Host
+ *  timings are not compared, as they vary between machines and runs. A benchmark which records neither register
+ *  accesses nor basic blocks measures nothing, and so is reported as a failure rather than silently passing, as
+ *  is a benchmark missing from the baseline.
+ *
+ *  \param[in] BaselineFileName  Name of the previous results file
+ *  \param[in] Threshold         Allowable increase in register accesses or basic blocks per operation, as a percentage
+ *
+ *  \return Boolean true if no benchmark regressed by more than the threshold, false otherwise
+ */
+static bool Benchmark_CompareResults(const char* const BaselineFileName, const double Threshold)
+{
+	FILE* BaselineFile = fopen(BaselineFileName, "r");
+	bool  Passed       = true;
+	bool  Compared[MAX_RESULTS];
+	char  Line[512];
+
+	if (BaselineFile == NULL)
+	{
+		perror(BaselineFileName);
+		return false;
+	}
+
+	memset(Compared, false, sizeof(Compared));
+
+	while (fgets(Line, sizeof(Line), BaselineFile) != NULL)
+	{
+		char*  NameStart   = strstr(Line, "\"name\": \"");
+		char*  AccessStart = strstr(Line, "\"register_accesses_per_operation\": ");
+		char*  BlocksStart = strstr(Line, "\"blocks_per_operation\": ");
+		char   Name[40];
+		double BaselineAccesses;
+		double BaselineBlocks;
+
+		if ((NameStart == NULL) || (AccessStart == NULL) || (BlocksStart == NULL))
+		  continue;
+
+		if ((sscanf(NameStart, "\"name\": \"%39[^\"]\"", Name) != 1) ||
+		    (sscanf(AccessStart, "\"register_accesses_per_operation\": %lf", &BaselineAccesses) != 1) ||
+		    (sscanf(BlocksStart, "\"blocks_per_operation\": %lf", &BaselineBlocks) != 1))
+		{
+			continue;
+		}
+
+		for (uint8_t ResultIndex = 0; ResultIndex < TotalResults; ResultIndex++)
+		{
+			Benchmark_Result_t* Result = &Results[ResultIndex];
+
+			if (strcmp(Result->Name, Name) != 0)
+			  continue;
+
+			Compared[ResultIndex] = true;
+
+			double AccessChange = Benchmark_PercentChange(BaselineAccesses, Result->RegisterAccessesPerOperation);
+			double BlocksChange = Benchmark_PercentChange(BaselineBlocks, Result->BlocksPerOperation);
+			bool   Unmeasured   = !(Result->RegisterAccessesPerOperation > 0) && !(Result->BlocksPerOperation > 0);
+			bool   Regressed    = ((AccessChange > Threshold) || (BlocksChange > Threshold));
+
+			printf("%-36s %10.3f -> %10.3f reg/op (%+7.2f%%) %10.3f -> %10.3f blocks/op (%+7.2f%%)%s\n", Name,
+			       BaselineAccesses, Result->RegisterAccessesPerOperation, AccessChange,
+			       BaselineBlocks, Result->BlocksPerOperation, BlocksChange,
+			       Unmeasured ? "  NOT MEASURED" : (Regressed ? "  REGRESSION" : ""));
+
+			if (Regressed || Unmeasured)
+			  Passed = false;
+		}
+	}
+
+	fclose(BaselineFile);
+
+	for (uint8_t ResultIndex = 0; ResultIndex < TotalResults; ResultIndex++)
+	{
+		if (Compared[ResultIndex])
+		  continue;
+
+		printf("%-36s not present in the baseline  NO BASELINE\n", Results[ResultIndex].Name);
+		Passed = false;
+	}
+
+	return Passed;
+}
+
+int main(int argc, char* argv[])
+{
+	const char* OutputFileName   = NULL;
+	const char* BaselineFileName = NULL;
+	const char* Commit           = NULL;
+	double      Threshold        = 5.0;
+	int         Option;
+
+	while ((Option = getopt(argc, argv, "o:b:c:t:")) != -1)
+	{
+		switch (Option)
+		{
+			case 'o':
+				OutputFileName = optarg;
+				break;
+			case 'b':
+				BaselineFileName = optarg;
+				break;
+			case 'c':
+				Commit = optarg;
+				break;
+			case 't':
+				Threshold = strtod(optarg, NULL);
+				break;
+			default:
+				fprintf(stderr, "Usage: %s [-o Results.json] [-b Baseline.json] [-t ThresholdPercent] [-c Commit]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	for (uint8_t BenchmarkIndex = 0; BenchmarkIndex < (sizeof(Benchmarks) / sizeof(Benchmarks[0])); BenchmarkIndex++)
+	  Benchmarks[BenchmarkIndex]();
+
+	if (OutputFileName != NULL)
+	{
+		FILE* OutputFile = fopen(OutputFileName, "w");
+
+		if (OutputFile == NULL)
+		{
+			perror(OutputFileName);
+			return EXIT_FAILURE;
+		}
+
+		Benchmark_WriteResults(OutputFile, Commit);
+		fclose(OutputFile);
+	}
+	else if (BaselineFileName == NULL)
+	{
+		Benchmark_WriteResults(stdout, Commit);
+	}
+
+	if (BaselineFileName != NULL)
+	  return Benchmark_CompareResults(BaselineFileName, Threshold) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	return EXIT_SUCCESS;
+}
+
+/** Descriptor callback for the library. The benchmarks place the device directly into the configured state rather
+ *  than performing a full enumeration, thus no descriptors are required.
+ */
+uint16_t CALLBACK_USB_GetDescriptor(const uint16_t wValue, const uint8_t wIndex, void** const DescriptorAddress)
+{
+	return NO_DESCRIPTOR;
+}
@@ -0,0 +1,90 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for Benchmarks.c.
+ */
+
+#ifndef _BENCHMARKS_H_
+#define _BENCHMARKS_H_
+
+	/* Includes: */
+		#include <stdio.h>
+		#include <stdint.h>
+		#include <stdbool.h>
+		#include <string.h>
+
+		#include <LUFA/Drivers/USB/USB.h>
+		#include <LUFA/Drivers/USB/LowLevel/Simulator/USBSimulator.h>
+
+	/* Macros: */
+		/** Endpoint number of the bulk IN endpoint used by the device mode benchmarks. */
+		#define BENCH_IN_EPNUM               1
+
+		/** Endpoint number of the bulk OUT endpoint used by the device mode benchmarks. */
+		#define BENCH_OUT_EPNUM              2
+
+		/** Endpoint number of the interrupt IN endpoint used by the device mode benchmarks. */
+		#define BENCH_NOTIFICATION_EPNUM     3
+
+		/** Size in bytes of the bulk endpoints used by the device mode benchmarks. */
+		#define BENCH_BULK_EPSIZE            64
+
+		/** Size in bytes of the interrupt endpoint used by the device mode benchmarks. */
+		#define BENCH_NOTIFICATION_EPSIZE    8
+
+	/* Type Defines: */
+		/** Type define for a benchmark routine. Each routine reports one or more results via
+		 *  \ref Benchmark_Begin() and \ref Benchmark_End().
+		 */
+		typedef void (*Benchmark_Routine_t)(void);
+
+		/** Type define for a device configuration routine, called by \ref Benchmark_ConnectDevice() once the
+		 *  simulated host has reset the bus, to configure the device's endpoints and class driver state.
+		 */
+		typedef void (*Benchmark_ConfigureRoutine_t)(void);
+
+	/* Function Prototypes: */
+		void Benchmark_ConnectDevice(Benchmark_ConfigureRoutine_t ConfigureRoutine);
+		void Benchmark_Begin(const char* const Name);
+		void Benchmark_End(const uint32_t Operations, const uint32_t BytesPerOperation);
+
+		void Bench_EndpointStream(void);
+		void Bench_CDCDevice(void);
+		void Bench_MassStorageDevice(void);
+		void Bench_HIDDevice(void);
+		void Bench_RNDISDevice(void);
+		void Bench_AudioDevice(void);
+		void Bench_MIDIDevice(void);
+		void Bench_HIDParser(void);
+		void Bench_HostConfig(void);
+
+#endif
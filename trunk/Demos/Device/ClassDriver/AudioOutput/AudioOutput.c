@@ -36,6 +36,9 @@
 
 #include "AudioOutput.h"
 
+/** Sample FIFO, holding received audio samples until they are output by the sample timer interrupt. */
+static uint8_t SampleFIFO[AUDIO_SAMPLE_FIFO_SIZE];
+
 /** LUFA Audio Class driver interface configuration and state information. This structure is
  *  passed to all Audio Class driver functions, so that multiple instances of the same class
  *  within a device can be differentiated from one another.
@@ -48,6 +51,13 @@ USB_ClassInfo_Audio_Device_t Speaker_Audio_Interface =
 
 				.DataOUTEndpointNumber    = AUDIO_STREAM_EPNUM,
 				.DataOUTEndpointSize      = AUDIO_STREAM_EPSIZE,
+
+				.SampleFIFOOUT            = SampleFIFO,
+				.SampleFIFOOUTSize        = sizeof(SampleFIFO),
+				.SampleFrameSize          = 4,
+
+				.FeedbackEndpointNumber   = AUDIO_FEEDBACK_EPNUM,
+				.SampleRate               = AUDIO_SAMPLE_FREQUENCY,
 			},
 	};
 
@@ -62,8 +72,6 @@ int main(void)
 	
 	for (;;)
 	{
-		ProcessNextSample();
-
 		Audio_Device_USBTask(&Speaker_Audio_Interface);
 		USB_USBTask();
 	}
@@ -84,20 +92,17 @@ void SetupHardware(void)
 	USB_Init();
 }
 
-/** Processes the next audio sample by reading the last ADC conversion and writing it to the audio
- *  interface, each time the sample reload timer period elapses to give a constant sample rate.
+/** ISR to output the next audio sample from the sample FIFO each time the sample reload timer period elapses, giving a
+ *  constant sample rate regardless of the time taken by the main program loop.
  */
-void ProcessNextSample(void)
+ISR(TIMER0_COMPA_vect, ISR_BLOCK)
 {
-	/* Check if the sample reload timer period has elapsed, and that the USB bus is ready for a new sample */
-	if ((TIFR0 & (1 << OCF0A)) && Audio_Device_IsSampleReceived(&Speaker_Audio_Interface))
+	/* Check that the sample FIFO holds the next sample of each channel */
+	if (Audio_Device_IsFIFOSampleReceived(&Speaker_Audio_Interface))
 	{
-		/* Clear the sample reload timer */
-		TIFR0 |= (1 << OCF0A);
-
 		/* Retrieve the signed 16-bit left and right audio samples, convert to 8-bit */
-		int8_t  LeftSample_8Bit   = (Audio_Device_ReadSample16(&Speaker_Audio_Interface) >> 8);
-		int8_t  RightSample_8Bit  = (Audio_Device_ReadSample16(&Speaker_Audio_Interface) >> 8);
+		int8_t  LeftSample_8Bit   = (Audio_Device_ReadFIFOSample16(&Speaker_Audio_Interface) >> 8);
+		int8_t  RightSample_8Bit  = (Audio_Device_ReadFIFOSample16(&Speaker_Audio_Interface) >> 8);
 
 		/* Mix the two channels together to produce a mono, 8-bit sample */
 		int8_t  MixedSample_8Bit  = (((int16_t)LeftSample_8Bit + (int16_t)RightSample_8Bit) >> 1);
@@ -139,6 +144,7 @@ void EVENT_USB_Device_Connect(void)
 	OCR0A   = (F_CPU / 8 / AUDIO_SAMPLE_FREQUENCY) - 1;
 	TCCR0A  = (1 << WGM01);  // CTC mode
 	TCCR0B  = (1 << CS01);   // Fcpu/8 speed
+	TIMSK0  = (1 << OCIE0A); // Sample output interrupt
 
 #if defined(AUDIO_OUT_MONO)
 	/* Set speaker as output */
@@ -166,6 +172,7 @@ void EVENT_USB_Device_Disconnect(void)
 
 	/* Stop the sample reload timer */
 	TCCR0B = 0;
+	TIMSK0 = 0;
 
 #if (defined(AUDIO_OUT_MONO) || defined(AUDIO_OUT_STEREO))
 	/* Stop the PWM generation timer */
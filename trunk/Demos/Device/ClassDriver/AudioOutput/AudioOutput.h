@@ -40,6 +40,7 @@
 		#include <avr/io.h>
 		#include <avr/wdt.h>
 		#include <avr/power.h>
+		#include <avr/interrupt.h>
 		#include <stdlib.h>
 
 		#include "Descriptors.h"
@@ -61,10 +62,14 @@
 
 		/** LED mask for the library LED driver, to indicate that an error has occurred in the USB interface. */
 		#define LEDMASK_USB_ERROR        (LEDS_LED1 | LEDS_LED3)
+
+		/** Size in bytes of the sample FIFO holding received audio samples until they are output by the sample timer
+		 *  interrupt. This must be a power of two, and large enough to absorb delays in the main program loop.
+		 */
+		#define AUDIO_SAMPLE_FIFO_SIZE   (AUDIO_STREAM_EPSIZE * 4)
 		
 	/* Function Prototypes: */
 		void SetupHardware(void);
-		void ProcessNextSample(void);
 		
 		void EVENT_USB_Device_Connect(void);
 		void EVENT_USB_Device_Disconnect(void);
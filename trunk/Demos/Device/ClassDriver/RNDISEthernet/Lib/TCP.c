@@ -73,13 +73,6 @@ void TCP_TCPTask(USB_ClassInfo_RNDIS_Device_t* RNDISInterfaceInfo)
 		}
 	}
 	
-	/* Get pointer to the output frame info struct for convenience */
-	Ethernet_Frame_Info_t* FrameOUT = (Ethernet_Frame_Info_t*)&RNDISInterfaceInfo->State.FrameOUT;
-	
-	/* Bail out early if there is already a frame waiting to be sent in the Ethernet OUT buffer */
-	if (FrameOUT->FrameInBuffer)
-	  return;
-	
 	/* Send response packets from each application as the TCP packet buffers are filled by the applications */
 	for (uint8_t CSTableEntry = 0; CSTableEntry < MAX_TCP_CONNECTIONS; CSTableEntry++)
 	{
@@ -87,6 +80,12 @@ void TCP_TCPTask(USB_ClassInfo_RNDIS_Device_t* RNDISInterfaceInfo)
 		if ((ConnectionStateTable[CSTableEntry].Info.Buffer.Direction == TCP_PACKETDIR_OUT) &&
 		    (ConnectionStateTable[CSTableEntry].Info.Buffer.Ready))
 		{
+			/* Get a free output frame, bailing out early if all the Ethernet OUT frames are already waiting to be sent */
+			Ethernet_Frame_Info_t* FrameOUT = RNDIS_Device_GetFrameToSend(RNDISInterfaceInfo);
+
+			if (FrameOUT == NULL)
+			  return;
+
 			Ethernet_Frame_Header_t* FrameOUTHeader = (Ethernet_Frame_Header_t*)&FrameOUT->FrameData;
 			IP_Header_t*             IPHeaderOUT    = (IP_Header_t*)&FrameOUT->FrameData[sizeof(Ethernet_Frame_Header_t)];
 			TCP_Header_t*            TCPHeaderOUT   = (TCP_Header_t*)&FrameOUT->FrameData[sizeof(Ethernet_Frame_Header_t) +
@@ -150,8 +149,6 @@ void TCP_TCPTask(USB_ClassInfo_RNDIS_Device_t* RNDISInterfaceInfo)
 			FrameOUT->FrameInBuffer         = true;
 			
 			ConnectionStateTable[CSTableEntry].Info.Buffer.Ready = false;
-			
-			break;
 		}
 	}
 }
@@ -36,6 +36,11 @@
 
 #include "RNDISEthernet.h"
 
+/** Additional Ethernet frame buffer used by the RNDIS Class driver, so that a new response frame may be generated while
+ *  the previous frame is waiting to be sent to the host.
+ */
+Ethernet_Frame_Info_t Ethernet_ExtraFramesOUT[1];
+
 /** LUFA RNDIS Class driver interface configuration and state information. This structure is
  *  passed to all RNDIS Class driver functions, so that multiple instances of the same class
  *  within a device can be differentiated from one another.
@@ -60,6 +65,10 @@ USB_ClassInfo_RNDIS_Device_t Ethernet_RNDIS_Interface =
 				
 				.AdapterVendorDescription       = "LUFA RNDIS Demo Adapter",
 				.AdapterMACAddress              = {ADAPTER_MAC_ADDRESS},
+
+				.ExtraFramesOUT                 = Ethernet_ExtraFramesOUT,
+				.TotalExtraFramesOUT            = (sizeof(Ethernet_ExtraFramesOUT) / sizeof(Ethernet_ExtraFramesOUT[0])),
+				.MaxPacketsPerTransfer          = 2,
 			},
 	};
 
@@ -79,10 +88,14 @@ int main(void)
 
 	for (;;)
 	{
-		if (Ethernet_RNDIS_Interface.State.FrameIN.FrameInBuffer)
+		Ethernet_Frame_Info_t* FrameIN  = RNDIS_Device_GetReceivedFrame(&Ethernet_RNDIS_Interface);
+		Ethernet_Frame_Info_t* FrameOUT = RNDIS_Device_GetFrameToSend(&Ethernet_RNDIS_Interface);
+
+		/* Process the next received frame once there is a free output frame to hold any response */
+		if ((FrameIN != NULL) && (FrameOUT != NULL))
 		{
 			LEDs_SetAllLEDs(LEDMASK_USB_BUSY);
-			Ethernet_ProcessPacket(&Ethernet_RNDIS_Interface.State.FrameIN, &Ethernet_RNDIS_Interface.State.FrameOUT);
+			Ethernet_ProcessPacket(FrameIN, FrameOUT);
 			LEDs_SetAllLEDs(LEDMASK_USB_READY);
 		}
 
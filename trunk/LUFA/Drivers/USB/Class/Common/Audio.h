@@ -350,7 +350,9 @@
 		{
 			USB_Descriptor_Endpoint_t Endpoint; /**< Standard endpoint descriptor describing the audio endpoint */
 
-			uint8_t                   Refresh; /**< Always set to zero */
+			uint8_t                   Refresh; /**< Always set to zero for data endpoints; for feedback endpoints, the interval between
+			                                    *   feedback updates as a power of two number of frames
+			                                    */
 			uint8_t                   SyncEndpointNumber; /**< Endpoint address to send synchronization information to, if needed (zero otherwise) */
 		} USB_Audio_StreamEndpoint_Std_t;
 					
@@ -0,0 +1,154 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \ingroup Group_USBClassHub
+ *  @defgroup Group_USBClassHubCommon  Common Class Definitions
+ *
+ *  \section Module Description
+ *  Constants, Types and Enum definitions that are common to both Device and Host modes for the USB
+ *  Hub Class.
+ *
+ *  @{
+ */
+
+#ifndef _HUB_CLASS_COMMON_H_
+#define _HUB_CLASS_COMMON_H_
+
+	/* Includes: */
+		#include "../../USB.h"
+
+		#include <string.h>
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_HUB_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/Class/Hub.h instead.
+		#endif
+
+	/* Macros: */
+		/** Descriptor type value for a hub class descriptor. */
+		#define DTYPE_Hub                        0x29
+
+		/** Hub class feature selector for the port power feature of a hub port. */
+		#define HUB_FEATURE_PORT_POWER           8
+
+		/** Hub class feature selector for the port reset feature of a hub port. */
+		#define HUB_FEATURE_PORT_RESET           4
+
+		/** Hub class feature selector for the port enable feature of a hub port. */
+		#define HUB_FEATURE_PORT_ENABLE          1
+
+		/** Hub class feature selector for the port connection change flag of a hub port. */
+		#define HUB_FEATURE_C_PORT_CONNECTION    16
+
+		/** Hub class feature selector for the port enable change flag of a hub port. */
+		#define HUB_FEATURE_C_PORT_ENABLE        17
+
+		/** Hub class feature selector for the port suspend change flag of a hub port. */
+		#define HUB_FEATURE_C_PORT_SUSPEND       18
+
+		/** Hub class feature selector for the port over-current change flag of a hub port. */
+		#define HUB_FEATURE_C_PORT_OVER_CURRENT  19
+
+		/** Hub class feature selector for the port reset change flag of a hub port. */
+		#define HUB_FEATURE_C_PORT_RESET         20
+
+		/** Port status mask for a hub port, indicating that a device is connected to the port. */
+		#define HUB_PORTSTATUS_CONNECTION        (1 << 0)
+
+		/** Port status mask for a hub port, indicating that the port is enabled. */
+		#define HUB_PORTSTATUS_ENABLE            (1 << 1)
+
+		/** Port status mask for a hub port, indicating that the port is suspended. */
+		#define HUB_PORTSTATUS_SUSPEND           (1 << 2)
+
+		/** Port status mask for a hub port, indicating that an over-current condition exists on the port. */
+		#define HUB_PORTSTATUS_OVER_CURRENT      (1 << 3)
+
+		/** Port status mask for a hub port, indicating that the port is being reset. */
+		#define HUB_PORTSTATUS_RESET             (1 << 4)
+
+		/** Port status mask for a hub port, indicating that the port is powered. */
+		#define HUB_PORTSTATUS_POWER             (1 << 8)
+
+		/** Port status mask for a hub port, indicating that the attached device is a Low Speed device. */
+		#define HUB_PORTSTATUS_LOW_SPEED         (1 << 9)
+
+		/** Port change mask for a hub port, indicating that the port's connection status has changed. */
+		#define HUB_PORTCHANGE_CONNECTION        (1 << 0)
+
+		/** Port change mask for a hub port, indicating that the port has been disabled due to an error. */
+		#define HUB_PORTCHANGE_ENABLE            (1 << 1)
+
+		/** Port change mask for a hub port, indicating that the port has completed resuming from suspend. */
+		#define HUB_PORTCHANGE_SUSPEND           (1 << 2)
+
+		/** Port change mask for a hub port, indicating that the port's over-current status has changed. */
+		#define HUB_PORTCHANGE_OVER_CURRENT      (1 << 3)
+
+		/** Port change mask for a hub port, indicating that the port has completed a reset. */
+		#define HUB_PORTCHANGE_RESET             (1 << 4)
+
+	/* Type Defines: */
+		/** Type define for the fixed length portion of a hub class descriptor, which is followed by the variable length
+		 *  DeviceRemovable and PortPwrCtrlMask port bitmaps. For details of the structure contents, refer to the USB 2.0
+		 *  specification.
+		 */
+		typedef struct
+		{
+			USB_Descriptor_Header_t Header; /**< Descriptor header, including type (\ref DTYPE_Hub) and size */
+
+			uint8_t  TotalPorts; /**< Number of downstream ports of the hub */
+			uint16_t Characteristics; /**< Hub characteristics mask, indicating the hub's power switching and
+			                           *   over-current protection modes
+			                           */
+			uint8_t  PowerOnToPowerGood; /**< Time from a port being powered until its power is good, in units of 2ms */
+			uint8_t  HubControlCurrent; /**< Maximum current drawn by the hub controller, in mA */
+		} USB_Hub_Descriptor_Hub_t;
+
+		/** Type define for the status of a hub port, as returned by the hub in response to a GetStatus request. */
+		typedef struct
+		{
+			uint16_t Status; /**< Current status of the port, a mask of HUB_PORTSTATUS_* masks */
+			uint16_t Change; /**< Changes in the status of the port, a mask of HUB_PORTCHANGE_* masks */
+		} USB_Hub_PortStatus_t;
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
@@ -0,0 +1,198 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "../../HighLevel/USBMode.h"
+
+#define  __INCLUDE_FROM_MIDI_DRIVER
+#include "MIDI.h"
+
+uint16_t MIDI_SegmentSysEx(MIDI_SysExSegmenter_t* const Segmenter, const uint8_t* Data, const uint16_t Length,
+                           MIDI_EventPacket_t* const Events, const uint16_t MaxEvents, uint16_t* const BytesProcessed)
+{
+	MIDI_EventPacket_t* CurrentEvent   = Events;
+	MIDI_EventPacket_t* EventsEnd      = &Events[MaxEvents];
+	const uint8_t*      DataEnd        = &Data[Length];
+	const uint8_t*      DataStart      = Data;
+	uint8_t             CableNumber    = Segmenter->CableNumber;
+	bool                InMessage      = Segmenter->InMessage;
+	uint8_t             BufferedBytes  = Segmenter->BufferedBytes;
+	uint8_t             Buffer[3];
+
+	Buffer[0] = Segmenter->Buffer[0];
+	Buffer[1] = Segmenter->Buffer[1];
+
+	while ((Data != DataEnd) && (CurrentEvent != EventsEnd))
+	{
+		/* Fast path for runs of message data bytes, which are packed three to an event packet without buffering */
+		if (InMessage && !(BufferedBytes))
+		{
+			while (((DataEnd - Data) >= 3) && (CurrentEvent != EventsEnd) && !((Data[0] | Data[1] | Data[2]) & 0x80))
+			{
+				*(CurrentEvent++) = (MIDI_EventPacket_t)
+					{
+						.Command     = MIDI_CIN_SYSEX_START,
+						.CableNumber = CableNumber,
+						.Data1       = Data[0],
+						.Data2       = Data[1],
+						.Data3       = Data[2],
+					};
+
+				Data += 3;
+			}
+
+			if ((Data == DataEnd) || (CurrentEvent == EventsEnd))
+			  break;
+		}
+
+		uint8_t DataByte = *(Data++);
+
+		if (DataByte >= MIDI_COMMAND_REALTIME_FIRST)
+		{
+			*(CurrentEvent++) = (MIDI_EventPacket_t)
+				{
+					.Command     = MIDI_CIN_SINGLE_BYTE,
+					.CableNumber = CableNumber,
+					.Data1       = DataByte,
+				};
+
+			continue;
+		}
+
+		if (DataByte == MIDI_COMMAND_SYSEX_START)
+		{
+			InMessage     = true;
+			BufferedBytes = 0;
+		}
+		else if (!(InMessage))
+		{
+			continue;
+		}
+
+		Buffer[BufferedBytes++] = DataByte;
+
+		if ((DataByte == MIDI_COMMAND_SYSEX_END) || (BufferedBytes == 3))
+		{
+			*(CurrentEvent++) = (MIDI_EventPacket_t)
+				{
+					.Command     = (DataByte == MIDI_COMMAND_SYSEX_END) ? (MIDI_CIN_SYSEX_START + BufferedBytes) : MIDI_CIN_SYSEX_START,
+					.CableNumber = CableNumber,
+					.Data1       = Buffer[0],
+					.Data2       = (BufferedBytes > 1) ? Buffer[1] : 0,
+					.Data3       = (BufferedBytes > 2) ? Buffer[2] : 0,
+				};
+
+			if (DataByte == MIDI_COMMAND_SYSEX_END)
+			  InMessage = false;
+
+			BufferedBytes = 0;
+		}
+	}
+
+	Segmenter->InMessage     = InMessage;
+	Segmenter->BufferedBytes = BufferedBytes;
+	Segmenter->Buffer[0]     = Buffer[0];
+	Segmenter->Buffer[1]     = Buffer[1];
+
+	*BytesProcessed = (Data - DataStart);
+	return (CurrentEvent - Events);
+}
+
+uint16_t MIDI_AssembleSysEx(MIDI_SysExAssembler_t* const Assembler, const MIDI_EventPacket_t* Events,
+                            const uint16_t TotalEvents)
+{
+	const MIDI_EventPacket_t* EventsStart = Events;
+	const MIDI_EventPacket_t* EventsEnd   = &Events[TotalEvents];
+	uint8_t*                  BufferPos;
+	uint8_t*                  BufferEnd   = &Assembler->Buffer[Assembler->BufferSize];
+
+	if (Assembler->MessageComplete)
+	{
+		Assembler->MessageComplete = false;
+		Assembler->Length          = 0;
+	}
+
+	BufferPos = &Assembler->Buffer[Assembler->Length];
+
+	while (Events != EventsEnd)
+	{
+		uint8_t CodeIndex = Events->Command;
+
+		if ((CodeIndex < MIDI_CIN_SYSEX_START) || (CodeIndex > MIDI_CIN_SYSEX_END_3BYTE) ||
+		    ((CodeIndex == MIDI_CIN_SYSEX_END_1BYTE) && (Events->Data1 != MIDI_COMMAND_SYSEX_END)))
+		{
+			break;
+		}
+
+		if (Events->Data1 == MIDI_COMMAND_SYSEX_START)
+		{
+			if (Assembler->InMessage && (Events->CableNumber != Assembler->CableNumber))
+			  break;
+
+			Assembler->InMessage   = true;
+			Assembler->CableNumber = Events->CableNumber;
+			BufferPos              = Assembler->Buffer;
+		}
+		else if (!(Assembler->InMessage))
+		{
+			Events++;
+			continue;
+		}
+		else if (Events->CableNumber != Assembler->CableNumber)
+		{
+			break;
+		}
+
+		uint8_t EventBytes = (CodeIndex == MIDI_CIN_SYSEX_START) ? 3 : (CodeIndex - MIDI_CIN_SYSEX_START);
+
+		if ((BufferEnd - BufferPos) < EventBytes)
+		  break;
+
+		*(BufferPos++) = Events->Data1;
+
+		if (EventBytes > 1)
+		  *(BufferPos++) = Events->Data2;
+
+		if (EventBytes > 2)
+		  *(BufferPos++) = Events->Data3;
+
+		Events++;
+
+		if (CodeIndex != MIDI_CIN_SYSEX_START)
+		{
+			Assembler->InMessage       = false;
+			Assembler->MessageComplete = true;
+			break;
+		}
+	}
+
+	Assembler->Length = (BufferPos - Assembler->Buffer);
+	return (Events - EventsStart);
+}
@@ -81,6 +81,34 @@
 
 		/** Standard key press velocity value used for all note events */
 		#define MIDI_STANDARD_VELOCITY      64
+
+		/** MIDI command for the start of a System Exclusive message */
+		#define MIDI_COMMAND_SYSEX_START    0xF0
+
+		/** MIDI command for the end of a System Exclusive message */
+		#define MIDI_COMMAND_SYSEX_END      0xF7
+
+		/** Lowest MIDI command value of the single byte System Real Time messages, which may be sent at any time, including
+		 *  within a System Exclusive message.
+		 */
+		#define MIDI_COMMAND_REALTIME_FIRST 0xF8
+
+		/** USB MIDI event packet Code Index Number for a System Exclusive message start or continuation, holding three bytes
+		 *  of the message.
+		 */
+		#define MIDI_CIN_SYSEX_START        0x04
+
+		/** USB MIDI event packet Code Index Number for a System Exclusive message end holding the final byte of the message. */
+		#define MIDI_CIN_SYSEX_END_1BYTE    0x05
+
+		/** USB MIDI event packet Code Index Number for a System Exclusive message end holding the final two bytes of the message. */
+		#define MIDI_CIN_SYSEX_END_2BYTE    0x06
+
+		/** USB MIDI event packet Code Index Number for a System Exclusive message end holding the final three bytes of the message. */
+		#define MIDI_CIN_SYSEX_END_3BYTE    0x07
+
+		/** USB MIDI event packet Code Index Number for a single byte message, such as a System Real Time message. */
+		#define MIDI_CIN_SINGLE_BYTE        0x0F
 		
 		/** Convenience macro. MIDI channels are numbered from 1-10 (natural numbers) however the logical channel
 		 *  addresses are zero-indexed. This converts a natural MIDI channel number into the logical channel address.
@@ -159,6 +187,80 @@
 			uint8_t Data3; /**< Third byte of data in the MIDI event */		
 		} MIDI_EventPacket_t;
 
+		/** Type define for the state of a System Exclusive message segmenter, which splits raw MIDI System Exclusive
+		 *  message bytes into USB MIDI event packets via \ref MIDI_SegmentSysEx(). The structure should be cleared to zero
+		 *  and its CableNumber element set before first use.
+		 */
+		typedef struct
+		{
+			uint8_t CableNumber; /**< Virtual cable number the generated event packets are sent on */
+
+			bool    InMessage; /**< Indicates if a message has been started but not yet ended, for internal use only */
+			uint8_t BufferedBytes; /**< Number of bytes of the next event packet held from the previous call, for internal use only */
+			uint8_t Buffer[2]; /**< Bytes of the next event packet held from the previous call, for internal use only */
+		} MIDI_SysExSegmenter_t;
+
+		/** Type define for the state of a System Exclusive message assembler, which joins received USB MIDI event packets
+		 *  back into raw MIDI System Exclusive message bytes via \ref MIDI_AssembleSysEx(). The structure should be cleared
+		 *  to zero and its Buffer and BufferSize elements set before first use.
+		 */
+		typedef struct
+		{
+			uint8_t* Buffer; /**< Buffer the assembled message bytes are stored into */
+			uint16_t BufferSize; /**< Size in bytes of the Buffer, which must be at least three bytes */
+
+			uint16_t Length; /**< Number of bytes of the current message stored in the Buffer */
+			uint8_t  CableNumber; /**< Virtual cable number of the current message */
+			bool     InMessage; /**< Indicates if a message has been started but not yet ended */
+			bool     MessageComplete; /**< Indicates that the Buffer holds the end of the current message, including the
+			                           *   terminating \ref MIDI_COMMAND_SYSEX_END byte
+			                           */
+		} MIDI_SysExAssembler_t;
+
+	/* Function Prototypes: */
+		/** Splits a stream of raw MIDI System Exclusive message bytes into USB MIDI event packets, ready to be sent via the
+		 *  MIDI class driver's batched send functions. Each message must begin with \ref MIDI_COMMAND_SYSEX_START and end with
+		 *  \ref MIDI_COMMAND_SYSEX_END; bytes outside a message are discarded, and System Real Time bytes within a message are
+		 *  sent in their own single byte event packets. Messages may be split across any number of calls, with up to two
+		 *  trailing bytes of a message held in the segmenter state until the next call.
+		 *
+		 *  Processing stops once either all the given bytes have been processed, or the event packet buffer is full.
+		 *
+		 *  \param[in,out] Segmenter  Pointer to the segmenter state
+		 *  \param[in] Data  Pointer to the raw MIDI bytes to segment
+		 *  \param[in] Length  Number of bytes in the Data buffer
+		 *  \param[out] Events  Pointer to a buffer where the generated event packets are to be stored
+		 *  \param[in] MaxEvents  Maximum number of event packets to store into the Events buffer
+		 *  \param[out] BytesProcessed  Pointer to where the number of bytes of Data processed is to be stored
+		 *
+		 *  \return Number of event packets stored into the Events buffer
+		 */
+		uint16_t MIDI_SegmentSysEx(MIDI_SysExSegmenter_t* const Segmenter, const uint8_t* Data, const uint16_t Length,
+		                           MIDI_EventPacket_t* const Events, const uint16_t MaxEvents,
+		                           uint16_t* const BytesProcessed) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(6);
+
+		/** Joins System Exclusive event packets received via the MIDI class driver's batched receive functions back into
+		 *  raw MIDI message bytes, stored into the assembler's Buffer. Processing stops, returning the number of event packets
+		 *  consumed, as soon as either:
+		 *    - An event packet ending the current message is consumed, in which case the assembler's MessageComplete element
+		 *      is set. The message is discarded from the Buffer on the next call.
+		 *    - The next event packet's bytes do not fit in the remaining Buffer space. The application should process the
+		 *      partial message in the Buffer and then reset the assembler's Length element to zero to continue, allowing
+		 *      messages larger than the Buffer (such as firmware dumps) to be received in pieces.
+		 *    - The next event packet is not part of a System Exclusive message, or is on a different virtual cable to the
+		 *      current message. This event packet is left for the application to process or pass to another assembler.
+		 *
+		 *  Continuation event packets received outside a message are consumed and discarded.
+		 *
+		 *  \param[in,out] Assembler  Pointer to the assembler state
+		 *  \param[in] Events  Pointer to a buffer of received event packets
+		 *  \param[in] TotalEvents  Number of event packets in the Events buffer
+		 *
+		 *  \return Number of event packets consumed from the Events buffer
+		 */
+		uint16_t MIDI_AssembleSysEx(MIDI_SysExAssembler_t* const Assembler, const MIDI_EventPacket_t* Events,
+		                            const uint16_t TotalEvents) ATTR_NON_NULL_PTR_ARG(1);
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
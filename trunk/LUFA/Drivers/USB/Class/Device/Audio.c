@@ -32,6 +32,7 @@
 #include "../../HighLevel/USBMode.h"
 #if defined(USB_CAN_BE_DEVICE)
 
+#define  __INCLUDE_FROM_AUDIO_CLASS_DEVICE_C
 #define  __INCLUDE_FROM_AUDIO_DRIVER
 #include "Audio.h"
 
@@ -51,6 +52,7 @@ void Audio_Device_ProcessControlRequest(USB_ClassInfo_Audio_Device_t* const Audi
 				Endpoint_ClearSETUP();
 				
 				AudioInterfaceInfo->State.InterfaceEnabled = ((USB_ControlRequest.wValue & 0xFF) != 0);
+				Audio_Device_ResetFIFOs(AudioInterfaceInfo);
 				  
 				Endpoint_ClearStatusStage();
 			}
@@ -82,10 +84,35 @@ bool Audio_Device_ConfigureEndpoints(USB_ClassInfo_Audio_Device_t* AudioInterfac
 			return false;
 		}
 	}
+
+	if (AudioInterfaceInfo->Config.FeedbackEndpointNumber)
+	{
+		if (!(Endpoint_ConfigureEndpoint(AudioInterfaceInfo->Config.FeedbackEndpointNumber, EP_TYPE_ISOCHRONOUS,
+										 ENDPOINT_DIR_IN, AUDIO_DEVICE_FEEDBACK_EPSIZE,
+										 ENDPOINT_BANK_SINGLE)))
+		{
+			return false;
+		}
+	}
 	
 	return true;
 }
 
+void Audio_Device_USBTask(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(AudioInterfaceInfo->State.InterfaceEnabled))
+	  return;
+
+	if (AudioInterfaceInfo->Config.SampleFIFOOUT != NULL)
+	  Audio_Device_ReceiveFIFOPacket(AudioInterfaceInfo);
+
+	if (AudioInterfaceInfo->Config.SampleFIFOIN != NULL)
+	  Audio_Device_SendFIFOPacket(AudioInterfaceInfo);
+
+	if (AudioInterfaceInfo->Config.FeedbackEndpointNumber)
+	  Audio_Device_SendFeedback(AudioInterfaceInfo);
+}
+
 bool Audio_Device_IsSampleReceived(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
 {
 	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(AudioInterfaceInfo->State.InterfaceEnabled))
@@ -104,4 +131,153 @@ bool Audio_Device_IsReadyForNextSample(USB_ClassInfo_Audio_Device_t* const Audio
 	return Endpoint_IsINReady();
 }
 
+static void Audio_Device_ResetFIFOs(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	uint8_t CurrentGlobalInt = SREG;
+	cli();
+
+	AudioInterfaceInfo->State.OUTFIFOHead      = 0;
+	AudioInterfaceInfo->State.OUTFIFOTail      = 0;
+	AudioInterfaceInfo->State.OUTFIFOStreaming = false;
+	AudioInterfaceInfo->State.INFIFOHead       = 0;
+	AudioInterfaceInfo->State.INFIFOTail       = 0;
+
+	SREG = CurrentGlobalInt;
+}
+
+static void Audio_Device_ReceiveFIFOPacket(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	Endpoint_SelectEndpoint(AudioInterfaceInfo->Config.DataOUTEndpointNumber);
+
+	if (!(Endpoint_IsOUTReceived()))
+	  return;
+
+	uint8_t* FIFO          = (uint8_t*)AudioInterfaceInfo->Config.SampleFIFOOUT;
+	uint16_t FIFOSize      = AudioInterfaceInfo->Config.SampleFIFOOUTSize;
+	uint16_t Head          = AudioInterfaceInfo->State.OUTFIFOHead;
+	uint16_t BytesInPacket = Endpoint_BytesInEndpoint();
+	uint16_t Tail;
+
+	uint8_t CurrentGlobalInt = SREG;
+	cli();
+	Tail = AudioInterfaceInfo->State.OUTFIFOTail;
+
+	/* Isochronous data cannot be retried, so a packet which will not fit is dropped rather than left in the bank */
+	if (BytesInPacket > (uint16_t)(FIFOSize - (uint16_t)(Head - Tail)))
+	{
+		AudioInterfaceInfo->State.FIFOOverruns++;
+		SREG = CurrentGlobalInt;
+
+		Endpoint_ClearOUT();
+		return;
+	}
+
+	SREG = CurrentGlobalInt;
+
+	/* Packet length is already known, so the bank is copied without the per-byte bank checks of the stream functions */
+	uint8_t* FIFOPos = &FIFO[Head & (FIFOSize - 1)];
+	uint8_t* FIFOEnd = &FIFO[FIFOSize];
+
+	Head += BytesInPacket;
+
+	while (BytesInPacket--)
+	{
+		*(FIFOPos++) = Endpoint_Read_Byte();
+
+		if (FIFOPos == FIFOEnd)
+		  FIFOPos = FIFO;
+	}
+
+	Endpoint_ClearOUT();
+
+	CurrentGlobalInt = SREG;
+	cli();
+
+	AudioInterfaceInfo->State.OUTFIFOHead = Head;
+
+	if ((uint16_t)(Head - AudioInterfaceInfo->State.OUTFIFOTail) >= (FIFOSize >> 1))
+	  AudioInterfaceInfo->State.OUTFIFOStreaming = true;
+
+	SREG = CurrentGlobalInt;
+}
+
+static void Audio_Device_SendFIFOPacket(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	Endpoint_SelectEndpoint(AudioInterfaceInfo->Config.DataINEndpointNumber);
+
+	if (!(Endpoint_IsINReady()))
+	  return;
+
+	uint8_t* FIFO     = (uint8_t*)AudioInterfaceInfo->Config.SampleFIFOIN;
+	uint16_t FIFOSize = AudioInterfaceInfo->Config.SampleFIFOINSize;
+	uint16_t Tail     = AudioInterfaceInfo->State.INFIFOTail;
+	uint16_t BytesToSend;
+
+	uint8_t CurrentGlobalInt = SREG;
+	cli();
+	BytesToSend = (AudioInterfaceInfo->State.INFIFOHead - Tail);
+	SREG = CurrentGlobalInt;
+
+	if (BytesToSend > AudioInterfaceInfo->Config.DataINEndpointSize)
+	  BytesToSend = AudioInterfaceInfo->Config.DataINEndpointSize;
+
+	/* Only complete samples of every channel are sent, so that each packet starts on a sample boundary */
+	BytesToSend -= (BytesToSend % AudioInterfaceInfo->Config.SampleFrameSize);
+
+	if (!(BytesToSend))
+	  return;
+
+	uint8_t* FIFOPos = &FIFO[Tail & (FIFOSize - 1)];
+	uint8_t* FIFOEnd = &FIFO[FIFOSize];
+
+	Tail += BytesToSend;
+
+	while (BytesToSend--)
+	{
+		Endpoint_Write_Byte(*(FIFOPos++));
+
+		if (FIFOPos == FIFOEnd)
+		  FIFOPos = FIFO;
+	}
+
+	Endpoint_ClearIN();
+
+	CurrentGlobalInt = SREG;
+	cli();
+	AudioInterfaceInfo->State.INFIFOTail = Tail;
+	SREG = CurrentGlobalInt;
+}
+
+static void Audio_Device_SendFeedback(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	Endpoint_SelectEndpoint(AudioInterfaceInfo->Config.FeedbackEndpointNumber);
+
+	if (!(Endpoint_IsINReady()))
+	  return;
+
+	uint8_t  SampleFrameSize = AudioInterfaceInfo->Config.SampleFrameSize;
+	uint16_t BytesQueued;
+
+	uint8_t CurrentGlobalInt = SREG;
+	cli();
+	BytesQueued = (AudioInterfaceInfo->State.OUTFIFOHead - AudioInterfaceInfo->State.OUTFIFOTail);
+	SREG = CurrentGlobalInt;
+
+	/* Request more samples per frame while the FIFO is below half full, and fewer while it is above */
+	int16_t FrameError = ((int16_t)((AudioInterfaceInfo->Config.SampleFIFOOUTSize >> 1) - BytesQueued) / (int16_t)SampleFrameSize);
+
+	if (FrameError > AUDIO_FEEDBACK_MAX_FRAME_ERROR)
+	  FrameError = AUDIO_FEEDBACK_MAX_FRAME_ERROR;
+	else if (FrameError < -AUDIO_FEEDBACK_MAX_FRAME_ERROR)
+	  FrameError = -AUDIO_FEEDBACK_MAX_FRAME_ERROR;
+
+	/* Feedback value is the number of samples per 1ms frame, in 10.14 fixed point format */
+	uint32_t Feedback = (((AudioInterfaceInfo->Config.SampleRate << 14) / 1000) +
+	                     ((int32_t)FrameError << AUDIO_FEEDBACK_ERROR_SHIFT));
+
+	Endpoint_Write_Byte(Feedback);
+	Endpoint_Write_Word_LE(Feedback >> 8);
+	Endpoint_ClearIN();
+}
+
 #endif
\ No newline at end of file
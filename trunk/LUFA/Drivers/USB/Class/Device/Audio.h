@@ -38,6 +38,25 @@
  *  \section Module Description
  *  Device Mode USB Class driver framework interface, for the Audio USB Class driver.
  *
+ *  \section Sec_AudioDeviceFIFO Sample FIFOs
+ *  By default the application transfers each audio sample directly to or from the streaming endpoints, via the
+ *  \ref Audio_Device_IsSampleReceived() and \ref Audio_Device_IsReadyForNextSample() functions and the sample read and
+ *  write functions which follow them. As the endpoint must then be serviced from the main program loop once per sample
+ *  period, any delay in the main loop results in lost samples.
+ *
+ *  Alternatively, the application may supply a RAM sample FIFO for each streaming direction via the \c SampleFIFOOUT
+ *  and \c SampleFIFOIN configuration elements. \ref Audio_Device_USBTask() then moves whole endpoint packets between
+ *  the streaming endpoints and the FIFOs, and the application transfers samples to and from the FIFOs from its sample
+ *  timer interrupt via the \ref Audio_Device_IsFIFOSampleReceived() and \ref Audio_Device_IsFIFOReadyForNextSample()
+ *  functions and the FIFO sample read and write functions which follow them. These FIFO functions never access the
+ *  USB controller, and take a fixed number of cycles per sample. Playback from the OUT FIFO starts once the FIFO is
+ *  half full, so that short main loop delays are absorbed without audible glitches.
+ *
+ *  When the OUT FIFO is used, the device may additionally declare an asynchronous isochronous feedback endpoint
+ *  for the OUT streaming endpoint via the \c FeedbackEndpointNumber configuration element. The driver then reports
+ *  the number of samples the host should send per frame, adjusted from the nominal \c SampleRate according to the
+ *  fill level of the OUT FIFO so that the FIFO is held at half full, locking the host's sample clock to the device's.
+ *
  *  @{
  */
 
@@ -61,6 +80,12 @@
 		#endif
 
 	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Size in bytes of the full speed feedback endpoint packets sent by the driver on the optional feedback
+			 *  endpoint (see \ref Sec_AudioDeviceFIFO), which hold the number of samples per frame in 10.14 fixed point format.
+			 */
+			#define AUDIO_DEVICE_FEEDBACK_EPSIZE    3
+
 		/* Type Defines: */		
 			/** Class state structure. An instance of this structure should be made for each Audio interface
 			 *  within the user application, and passed to each of the Audio class driver functions as the
@@ -87,6 +112,25 @@
 					uint16_t DataOUTEndpointSize; /**< Size in bytes of the outgoing Audio Streaming data endpoint, if available
 												   *   (zero if unused)
 												   */			
+
+					void*    SampleFIFOOUT; /**< Pointer to a buffer used as the sample FIFO of the outgoing Audio Streaming data,
+					                         *   or NULL if samples are to be read directly from the endpoint (see \ref Sec_AudioDeviceFIFO)
+					                         */
+					uint16_t SampleFIFOOUTSize; /**< Size in bytes of the outgoing sample FIFO, which must be a power of two and at least
+					                             *   twice the size of the outgoing Audio Streaming data endpoint
+					                             */
+					void*    SampleFIFOIN; /**< Pointer to a buffer used as the sample FIFO of the incoming Audio Streaming data,
+					                        *   or NULL if samples are to be written directly to the endpoint (see \ref Sec_AudioDeviceFIFO)
+					                        */
+					uint16_t SampleFIFOINSize; /**< Size in bytes of the incoming sample FIFO, which must be a power of two */
+					uint8_t  SampleFrameSize; /**< Size in bytes of one sample of every channel in the audio stream (e.g. 4 for 16-bit
+					                           *   stereo), if a sample FIFO is used
+					                           */
+
+					uint8_t  FeedbackEndpointNumber; /**< Endpoint number of the asynchronous feedback endpoint of the outgoing Audio
+					                                  *   Streaming data, if available (zero if unused). This requires \c SampleFIFOOUT.
+					                                  */
+					uint32_t SampleRate; /**< Nominal sample rate of the audio stream in Hz, used to calculate the feedback value */
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */
@@ -95,6 +139,17 @@
 					bool     InterfaceEnabled; /**< Set and cleared by the class driver to indicate if the host has enabled the streaming endpoints
 												*   of the Audio Streaming interface.
 												*/
+
+					volatile uint16_t OUTFIFOHead; /**< Free running count of bytes written into the outgoing sample FIFO by the driver */
+					volatile uint16_t OUTFIFOTail; /**< Free running count of bytes read from the outgoing sample FIFO by the application */
+					volatile bool     OUTFIFOStreaming; /**< Indicates if samples are being read from the outgoing sample FIFO; set by the
+					                                     *   driver once the FIFO is half full, and cleared when it runs empty
+					                                     */
+					volatile uint16_t INFIFOHead; /**< Free running count of bytes written into the incoming sample FIFO by the application */
+					volatile uint16_t INFIFOTail; /**< Free running count of bytes read from the incoming sample FIFO by the driver */
+
+					uint16_t FIFOUnderruns; /**< Number of times the application found the outgoing sample FIFO empty during playback */
+					uint16_t FIFOOverruns; /**< Number of outgoing packets discarded, and incoming samples refused, due to a full FIFO */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */				
@@ -142,17 +197,16 @@
 			 */
 			bool Audio_Device_IsReadyForNextSample(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo);
 
-		/* Inline Functions: */
 			/** General management task for a given Audio class interface, required for the correct operation of the interface. This should
-			 *  be called frequently in the main program loop, before the master USB management task \ref USB_USBTask().
+			 *  be called frequently in the main program loop, before the master USB management task \ref USB_USBTask(). When sample FIFOs
+			 *  are in use, this moves each received packet into the outgoing sample FIFO, sends the samples waiting in the incoming
+			 *  sample FIFO and updates the feedback endpoint (see \ref Sec_AudioDeviceFIFO).
 			 *
 			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state
 			 */
-			static inline void Audio_Device_USBTask(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo);
-			static inline void Audio_Device_USBTask(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
-			{
-				(void)AudioInterfaceInfo;
-			}
+			void Audio_Device_USBTask(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+		/* Inline Functions: */
 
 			/** Reads the next 8-bit audio sample from the current audio interface.
 			 *
@@ -283,6 +337,210 @@
 				  Endpoint_ClearIN();
 			}
 
+			/** Determines if the outgoing sample FIFO of the given audio interface holds a complete sample of every channel ready
+			 *  to be read (see \ref Sec_AudioDeviceFIFO). This does not access the USB controller, and is intended to be called
+			 *  from the application's sample timer interrupt. If the FIFO has run empty during playback, playback is halted until
+			 *  \ref Audio_Device_USBTask() has refilled the FIFO to half full, and the interface's \c FIFOUnderruns count is incremented.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state
+			 *
+			 *  \return Boolean true if a sample of each channel may be read from the FIFO, false otherwise
+			 */
+			static inline bool Audio_Device_IsFIFOSampleReceived(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_ALWAYS_INLINE;
+			static inline bool Audio_Device_IsFIFOSampleReceived(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				if (!(AudioInterfaceInfo->State.OUTFIFOStreaming))
+				  return false;
+
+				if ((uint16_t)(AudioInterfaceInfo->State.OUTFIFOHead - AudioInterfaceInfo->State.OUTFIFOTail) <
+				    AudioInterfaceInfo->Config.SampleFrameSize)
+				{
+					AudioInterfaceInfo->State.OUTFIFOStreaming = false;
+					AudioInterfaceInfo->State.FIFOUnderruns++;
+					return false;
+				}
+
+				return true;
+			}
+
+			/** Determines if the incoming sample FIFO of the given audio interface has room for a sample of every channel
+			 *  (see \ref Sec_AudioDeviceFIFO). This does not access the USB controller, and is intended to be called from the
+			 *  application's sample timer interrupt. If the FIFO is full, the interface's \c FIFOOverruns count is incremented.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state
+			 *
+			 *  \return Boolean true if a sample of each channel may be written to the FIFO, false otherwise
+			 */
+			static inline bool Audio_Device_IsFIFOReadyForNextSample(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_ALWAYS_INLINE;
+			static inline bool Audio_Device_IsFIFOReadyForNextSample(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				if ((USB_DeviceState != DEVICE_STATE_Configured) || !(AudioInterfaceInfo->State.InterfaceEnabled))
+				  return false;
+
+				if ((uint16_t)(AudioInterfaceInfo->Config.SampleFIFOINSize -
+				               (uint16_t)(AudioInterfaceInfo->State.INFIFOHead - AudioInterfaceInfo->State.INFIFOTail)) <
+				    AudioInterfaceInfo->Config.SampleFrameSize)
+				{
+					AudioInterfaceInfo->State.FIFOOverruns++;
+					return false;
+				}
+
+				return true;
+			}
+
+			/** Reads the next 8-bit audio sample from the outgoing sample FIFO of the given audio interface.
+			 *
+			 *  \note This should be preceded by a call to the \ref Audio_Device_IsFIFOSampleReceived() function, once for each
+			 *        complete sample of every channel, to ensure that the FIFO holds the sample.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state
+			 *
+			 *  \return  Signed 8-bit audio sample from the FIFO
+			 */
+			static inline int8_t Audio_Device_ReadFIFOSample8(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_ALWAYS_INLINE;
+			static inline int8_t Audio_Device_ReadFIFOSample8(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				uint8_t* FIFO = (uint8_t*)AudioInterfaceInfo->Config.SampleFIFOOUT;
+				uint16_t Mask = (AudioInterfaceInfo->Config.SampleFIFOOUTSize - 1);
+				uint16_t Tail = AudioInterfaceInfo->State.OUTFIFOTail;
+
+				int8_t Sample = FIFO[Tail & Mask];
+
+				AudioInterfaceInfo->State.OUTFIFOTail = (Tail + 1);
+				return Sample;
+			}
+
+			/** Reads the next 16-bit audio sample from the outgoing sample FIFO of the given audio interface.
+			 *
+			 *  \note This should be preceded by a call to the \ref Audio_Device_IsFIFOSampleReceived() function, once for each
+			 *        complete sample of every channel, to ensure that the FIFO holds the sample.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state
+			 *
+			 *  \return  Signed 16-bit audio sample from the FIFO
+			 */
+			static inline int16_t Audio_Device_ReadFIFOSample16(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_ALWAYS_INLINE;
+			static inline int16_t Audio_Device_ReadFIFOSample16(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				uint8_t* FIFO = (uint8_t*)AudioInterfaceInfo->Config.SampleFIFOOUT;
+				uint16_t Mask = (AudioInterfaceInfo->Config.SampleFIFOOUTSize - 1);
+				uint16_t Tail = AudioInterfaceInfo->State.OUTFIFOTail;
+
+				int16_t Sample = (FIFO[Tail & Mask] | (FIFO[(Tail + 1) & Mask] << 8));
+
+				AudioInterfaceInfo->State.OUTFIFOTail = (Tail + 2);
+				return Sample;
+			}
+
+			/** Reads the next 24-bit audio sample from the outgoing sample FIFO of the given audio interface. The sample's bytes
+			 *  are ordered in the same manner as \ref Audio_Device_ReadSample24().
+			 *
+			 *  \note This should be preceded by a call to the \ref Audio_Device_IsFIFOSampleReceived() function, once for each
+			 *        complete sample of every channel, to ensure that the FIFO holds the sample.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state
+			 *
+			 *  \return  Signed 24-bit audio sample from the FIFO
+			 */
+			static inline int32_t Audio_Device_ReadFIFOSample24(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_ALWAYS_INLINE;
+			static inline int32_t Audio_Device_ReadFIFOSample24(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				uint8_t* FIFO = (uint8_t*)AudioInterfaceInfo->Config.SampleFIFOOUT;
+				uint16_t Mask = (AudioInterfaceInfo->Config.SampleFIFOOUTSize - 1);
+				uint16_t Tail = AudioInterfaceInfo->State.OUTFIFOTail;
+
+				int32_t Sample = (((uint32_t)FIFO[Tail & Mask] << 16) | FIFO[(Tail + 1) & Mask] |
+				                  ((uint16_t)FIFO[(Tail + 2) & Mask] << 8));
+
+				AudioInterfaceInfo->State.OUTFIFOTail = (Tail + 3);
+				return Sample;
+			}
+
+			/** Writes the next 8-bit audio sample to the incoming sample FIFO of the given audio interface.
+			 *
+			 *  \note This should be preceded by a call to the \ref Audio_Device_IsFIFOReadyForNextSample() function, once for
+			 *        each complete sample of every channel, to ensure that the FIFO has room for the sample.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state
+			 *  \param[in] Sample  Signed 8-bit audio sample
+			 */
+			static inline void Audio_Device_WriteFIFOSample8(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                 const int8_t Sample) ATTR_ALWAYS_INLINE;
+			static inline void Audio_Device_WriteFIFOSample8(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                 const int8_t Sample)
+			{
+				uint8_t* FIFO = (uint8_t*)AudioInterfaceInfo->Config.SampleFIFOIN;
+				uint16_t Mask = (AudioInterfaceInfo->Config.SampleFIFOINSize - 1);
+				uint16_t Head = AudioInterfaceInfo->State.INFIFOHead;
+
+				FIFO[Head & Mask] = Sample;
+
+				AudioInterfaceInfo->State.INFIFOHead = (Head + 1);
+			}
+
+			/** Writes the next 16-bit audio sample to the incoming sample FIFO of the given audio interface.
+			 *
+			 *  \note This should be preceded by a call to the \ref Audio_Device_IsFIFOReadyForNextSample() function, once for
+			 *        each complete sample of every channel, to ensure that the FIFO has room for the sample.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state
+			 *  \param[in] Sample  Signed 16-bit audio sample
+			 */
+			static inline void Audio_Device_WriteFIFOSample16(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                  const int16_t Sample) ATTR_ALWAYS_INLINE;
+			static inline void Audio_Device_WriteFIFOSample16(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                  const int16_t Sample)
+			{
+				uint8_t* FIFO = (uint8_t*)AudioInterfaceInfo->Config.SampleFIFOIN;
+				uint16_t Mask = (AudioInterfaceInfo->Config.SampleFIFOINSize - 1);
+				uint16_t Head = AudioInterfaceInfo->State.INFIFOHead;
+
+				FIFO[Head & Mask]       = (uint8_t)Sample;
+				FIFO[(Head + 1) & Mask] = (uint8_t)(Sample >> 8);
+
+				AudioInterfaceInfo->State.INFIFOHead = (Head + 2);
+			}
+
+			/** Writes the next 24-bit audio sample to the incoming sample FIFO of the given audio interface. The sample's bytes
+			 *  are ordered in the same manner as \ref Audio_Device_WriteSample24().
+			 *
+			 *  \note This should be preceded by a call to the \ref Audio_Device_IsFIFOReadyForNextSample() function, once for
+			 *        each complete sample of every channel, to ensure that the FIFO has room for the sample.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state
+			 *  \param[in] Sample  Signed 24-bit audio sample
+			 */
+			static inline void Audio_Device_WriteFIFOSample24(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                  const int32_t Sample) ATTR_ALWAYS_INLINE;
+			static inline void Audio_Device_WriteFIFOSample24(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                                  const int32_t Sample)
+			{
+				uint8_t* FIFO = (uint8_t*)AudioInterfaceInfo->Config.SampleFIFOIN;
+				uint16_t Mask = (AudioInterfaceInfo->Config.SampleFIFOINSize - 1);
+				uint16_t Head = AudioInterfaceInfo->State.INFIFOHead;
+
+				FIFO[Head & Mask]       = (uint8_t)(Sample >> 16);
+				FIFO[(Head + 1) & Mask] = (uint8_t)Sample;
+				FIFO[(Head + 2) & Mask] = (uint8_t)(Sample >> 8);
+
+				AudioInterfaceInfo->State.INFIFOHead = (Head + 3);
+			}
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define AUDIO_FEEDBACK_ERROR_SHIFT      8
+			#define AUDIO_FEEDBACK_MAX_FRAME_ERROR  64
+
+		/* Function Prototypes: */
+		#if defined(__INCLUDE_FROM_AUDIO_CLASS_DEVICE_C)
+			static void Audio_Device_ResetFIFOs(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+			static void Audio_Device_ReceiveFIFOPacket(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+			static void Audio_Device_SendFIFOPacket(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+			static void Audio_Device_SendFeedback(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+		#endif
+	#endif
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
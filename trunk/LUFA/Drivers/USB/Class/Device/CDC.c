@@ -120,21 +120,82 @@ void CDC_Device_USBTask(USB_ClassInfo_CDC_Device_t* CDCInterfaceInfo)
 	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
 	  return;
 
-	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataOUTEndpointNumber);
+	if (CDCInterfaceInfo->Config.RXBuffer != NULL)
+	{
+		CDC_Device_FillRXBuffer(CDCInterfaceInfo);
+	}
+	else
+	{
+		Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataOUTEndpointNumber);
 
-	if (Endpoint_IsOUTReceived() && !(Endpoint_BytesInEndpoint()))
-	  Endpoint_ClearOUT();
-	  
-	CDC_Device_Flush(CDCInterfaceInfo);
+		if (Endpoint_IsOUTReceived() && !(Endpoint_BytesInEndpoint()))
+		  Endpoint_ClearOUT();
+	}
+
+	if (CDCInterfaceInfo->Config.TXBuffer != NULL)
+	  CDC_Device_DrainTXBuffer(CDCInterfaceInfo);
+	else
+	  Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpointNumber);
+
+	if (!(CDCInterfaceInfo->State.TXBufferCount))
+	  Endpoint_FlushCoalesced(&CDCInterfaceInfo->State.TXCoalesceState, CDCInterfaceInfo->Config.TXCoalesceFrames);
 }
 
 uint8_t CDC_Device_SendString(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo, char* const Data, const uint16_t Length)
+{
+	return CDC_Device_SendData(CDCInterfaceInfo, Data, Length);
+}
+
+uint8_t CDC_Device_SendData(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo, const void* const Buffer, uint16_t Length)
 {
 	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
 	  return ENDPOINT_RWSTREAM_DeviceDisconnected;
-	
+
+	const uint8_t* DataStream = (const uint8_t*)Buffer;
+
+	if (CDCInterfaceInfo->Config.TXBuffer != NULL)
+	{
+		uint16_t BufferSize = CDCInterfaceInfo->Config.TXBufferSize;
+		uint8_t  ErrorCode;
+
+		while (Length)
+		{
+			uint16_t BufferCount = CDCInterfaceInfo->State.TXBufferCount;
+
+			if (BufferCount == BufferSize)
+			{
+				if ((ErrorCode = CDC_Device_WaitForTXBuffer(CDCInterfaceInfo, (Length >= BufferSize) ? 0 : (BufferSize - Length))))
+				  return ErrorCode;
+
+				if (!(CDCInterfaceInfo->State.TXBufferCount) && (Length >= BufferSize))
+				  break;
+
+				continue;
+			}
+
+			uint16_t BufferEnd = (CDCInterfaceInfo->State.TXBufferStart + BufferCount);
+
+			if (BufferEnd >= BufferSize)
+			  BufferEnd -= BufferSize;
+
+			uint16_t BytesToCopy = (BufferSize - ((BufferEnd < CDCInterfaceInfo->State.TXBufferStart) ? BufferCount : BufferEnd));
+
+			if (BytesToCopy > Length)
+			  BytesToCopy = Length;
+
+			memcpy(&CDCInterfaceInfo->Config.TXBuffer[BufferEnd], DataStream, BytesToCopy);
+
+			CDCInterfaceInfo->State.TXBufferCount += BytesToCopy;
+			DataStream += BytesToCopy;
+			Length     -= BytesToCopy;
+		}
+
+		if (!(Length))
+		  return ENDPOINT_RWSTREAM_NoError;
+	}
+
 	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpointNumber);
-	return Endpoint_Write_Stream_LE(Data, Length, NO_STREAM_CALLBACK);
+	return Endpoint_Write_Stream_LE(DataStream, Length, NO_STREAM_CALLBACK);
 }
 
 uint8_t CDC_Device_SendByte(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo, const uint8_t Data)
@@ -142,6 +203,31 @@ uint8_t CDC_Device_SendByte(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo,
 	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
 	  return ENDPOINT_RWSTREAM_DeviceDisconnected;
 
+	if (CDCInterfaceInfo->Config.TXBuffer != NULL)
+	{
+		uint16_t BufferCount = CDCInterfaceInfo->State.TXBufferCount;
+
+		if (BufferCount == CDCInterfaceInfo->Config.TXBufferSize)
+		{
+			uint8_t ErrorCode;
+
+			if ((ErrorCode = CDC_Device_WaitForTXBuffer(CDCInterfaceInfo, (BufferCount - 1))) != ENDPOINT_READYWAIT_NoError)
+			  return ErrorCode;
+
+			BufferCount = CDCInterfaceInfo->State.TXBufferCount;
+		}
+
+		uint16_t BufferEnd = (CDCInterfaceInfo->State.TXBufferStart + BufferCount);
+
+		if (BufferEnd >= CDCInterfaceInfo->Config.TXBufferSize)
+		  BufferEnd -= CDCInterfaceInfo->Config.TXBufferSize;
+
+		CDCInterfaceInfo->Config.TXBuffer[BufferEnd] = Data;
+		CDCInterfaceInfo->State.TXBufferCount        = (BufferCount + 1);
+
+		return ENDPOINT_READYWAIT_NoError;
+	}
+
 	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpointNumber);
 
 	if (!(Endpoint_IsReadWriteAllowed()))
@@ -165,10 +251,32 @@ uint8_t CDC_Device_Flush(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
 
 	uint8_t ErrorCode;
 
+	if (CDCInterfaceInfo->Config.TXBuffer != NULL)
+	{
+		if ((ErrorCode = CDC_Device_WaitForTXBuffer(CDCInterfaceInfo, 0)) != ENDPOINT_READYWAIT_NoError)
+		  return ErrorCode;
+	}
+
 	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpointNumber);
 
+	bool ZLPPending = CDCInterfaceInfo->State.TXCoalesceState.ZLPPending;
+
+	CDCInterfaceInfo->State.TXCoalesceState.StartFrame = 0;
+	CDCInterfaceInfo->State.TXCoalesceState.Waiting    = false;
+	CDCInterfaceInfo->State.TXCoalesceState.ZLPPending = false;
+
 	if (!(Endpoint_BytesInEndpoint()))
-	  return ENDPOINT_READYWAIT_NoError;
+	{
+		if (ZLPPending)
+		{
+			if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
+			  return ErrorCode;
+
+			Endpoint_ClearIN();
+		}
+
+		return ENDPOINT_READYWAIT_NoError;
+	}
 	
 	bool BankFull = !(Endpoint_IsReadWriteAllowed());
 	
@@ -190,6 +298,14 @@ uint16_t CDC_Device_BytesReceived(USB_ClassInfo_CDC_Device_t* const CDCInterface
 	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
 	  return 0;
 
+	if (CDCInterfaceInfo->Config.RXBuffer != NULL)
+	{
+		if (!(CDCInterfaceInfo->State.RXBufferCount))
+		  CDC_Device_FillRXBuffer(CDCInterfaceInfo);
+
+		return CDCInterfaceInfo->State.RXBufferCount;
+	}
+
 	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataOUTEndpointNumber);
 
 	if (Endpoint_IsOUTReceived())
@@ -210,6 +326,26 @@ uint8_t CDC_Device_ReceiveByte(USB_ClassInfo_CDC_Device_t* CDCInterfaceInfo)
 	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
 	  return 0;
 
+	if (CDCInterfaceInfo->Config.RXBuffer != NULL)
+	{
+		uint8_t DataByte;
+
+		if (!(CDCInterfaceInfo->State.RXBufferCount))
+		  CDC_Device_FillRXBuffer(CDCInterfaceInfo);
+
+		if (!(CDCInterfaceInfo->State.RXBufferCount))
+		  return 0;
+
+		DataByte = CDCInterfaceInfo->Config.RXBuffer[CDCInterfaceInfo->State.RXBufferStart];
+
+		if (++CDCInterfaceInfo->State.RXBufferStart == CDCInterfaceInfo->Config.RXBufferSize)
+		  CDCInterfaceInfo->State.RXBufferStart = 0;
+
+		CDCInterfaceInfo->State.RXBufferCount--;
+
+		return DataByte;
+	}
+
 	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataOUTEndpointNumber);
 	
 	uint8_t DataByte = Endpoint_Read_Byte();
@@ -220,6 +356,48 @@ uint8_t CDC_Device_ReceiveByte(USB_ClassInfo_CDC_Device_t* CDCInterfaceInfo)
 	return DataByte;
 }
 
+uint16_t CDC_Device_ReceiveData(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo, void* const Buffer, const uint16_t MaxLength)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
+	  return 0;
+
+	uint8_t* DataStream = (uint8_t*)Buffer;
+	uint16_t BytesRead  = 0;
+
+	if (CDCInterfaceInfo->Config.RXBuffer != NULL)
+	{
+		while (CDCInterfaceInfo->State.RXBufferCount && (BytesRead < MaxLength))
+		{
+			uint16_t BufferStart = CDCInterfaceInfo->State.RXBufferStart;
+			uint16_t BytesToCopy = (CDCInterfaceInfo->Config.RXBufferSize - BufferStart);
+
+			if (BytesToCopy > CDCInterfaceInfo->State.RXBufferCount)
+			  BytesToCopy = CDCInterfaceInfo->State.RXBufferCount;
+
+			if (BytesToCopy > (MaxLength - BytesRead))
+			  BytesToCopy = (MaxLength - BytesRead);
+
+			memcpy(&DataStream[BytesRead], &CDCInterfaceInfo->Config.RXBuffer[BufferStart], BytesToCopy);
+
+			BufferStart += BytesToCopy;
+
+			if (BufferStart == CDCInterfaceInfo->Config.RXBufferSize)
+			  BufferStart = 0;
+
+			CDCInterfaceInfo->State.RXBufferStart  = BufferStart;
+			CDCInterfaceInfo->State.RXBufferCount -= BytesToCopy;
+			BytesRead += BytesToCopy;
+		}
+
+		if (CDCInterfaceInfo->State.RXBufferCount)
+		  return BytesRead;
+	}
+
+	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataOUTEndpointNumber);
+
+	return (BytesRead + CDC_Device_ReadEndpoint(&DataStream[BytesRead], (MaxLength - BytesRead)));
+}
+
 void CDC_Device_SendControlLineStateChange(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
 {
 	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
@@ -236,10 +414,18 @@ void CDC_Device_SendControlLineStateChange(USB_ClassInfo_CDC_Device_t* const CDC
 			.wLength       = sizeof(CDCInterfaceInfo->State.ControlLineStates.DeviceToHost),
 		};
 
-	Endpoint_Write_Stream_LE(&Notification, sizeof(USB_Request_Header_t), NO_STREAM_CALLBACK);
-	Endpoint_Write_Stream_LE(&CDCInterfaceInfo->State.ControlLineStates.DeviceToHost,
-	                         sizeof(CDCInterfaceInfo->State.ControlLineStates.DeviceToHost),
-	                         NO_STREAM_CALLBACK);
+	USB_StreamSegment_t NotificationSegments[] =
+		{
+			{.Buffer      = &Notification,
+			 .Length      = sizeof(USB_Request_Header_t),
+			 .MemorySpace = STREAMSEGMENT_RAM},
+			{.Buffer      = &CDCInterfaceInfo->State.ControlLineStates.DeviceToHost,
+			 .Length      = sizeof(CDCInterfaceInfo->State.ControlLineStates.DeviceToHost),
+			 .MemorySpace = STREAMSEGMENT_RAM},
+		};
+
+	Endpoint_Write_StreamV(NotificationSegments, (sizeof(NotificationSegments) / sizeof(NotificationSegments[0])),
+	                       NO_STREAM_CALLBACK);
 	Endpoint_ClearIN();
 }
 
@@ -255,6 +441,121 @@ void CDC_Device_CreateBlockingStream(USB_ClassInfo_CDC_Device_t* CDCInterfaceInf
 	fdev_set_udata(Stream, CDCInterfaceInfo);
 }
 
+static uint16_t CDC_Device_ReadEndpoint(uint8_t* Buffer, const uint16_t MaxLength)
+{
+	uint16_t BytesRead = 0;
+
+	while ((BytesRead < MaxLength) && Endpoint_IsOUTReceived())
+	{
+		uint16_t BytesInBank = Endpoint_BytesInEndpoint();
+		uint16_t BytesToRead = (MaxLength - BytesRead);
+
+		if (BytesToRead >= BytesInBank)
+		{
+			BytesToRead = BytesInBank;
+			BytesInBank = 0;
+		}
+
+		BytesRead += BytesToRead;
+
+		while (BytesToRead--)
+		  *(Buffer++) = Endpoint_Read_Byte();
+
+		if (!(BytesInBank))
+		  Endpoint_ClearOUT();
+	}
+
+	return BytesRead;
+}
+
+static void CDC_Device_FillRXBuffer(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
+{
+	uint16_t BufferSize = CDCInterfaceInfo->Config.RXBufferSize;
+
+	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataOUTEndpointNumber);
+
+	while (CDCInterfaceInfo->State.RXBufferCount != BufferSize)
+	{
+		uint16_t BufferEnd = (CDCInterfaceInfo->State.RXBufferStart + CDCInterfaceInfo->State.RXBufferCount);
+
+		if (BufferEnd >= BufferSize)
+		  BufferEnd -= BufferSize;
+
+		uint16_t BytesToRead = (BufferSize - ((BufferEnd < CDCInterfaceInfo->State.RXBufferStart) ?
+		                                      CDCInterfaceInfo->State.RXBufferCount : BufferEnd));
+
+		uint16_t BytesRead = CDC_Device_ReadEndpoint(&CDCInterfaceInfo->Config.RXBuffer[BufferEnd], BytesToRead);
+
+		if (!(BytesRead))
+		  break;
+
+		CDCInterfaceInfo->State.RXBufferCount += BytesRead;
+	}
+}
+
+static void CDC_Device_DrainTXBuffer(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
+{
+	Endpoint_SelectEndpoint(CDCInterfaceInfo->Config.DataINEndpointNumber);
+
+	uint16_t BankSize = Endpoint_GetBankSize();
+
+	while (CDCInterfaceInfo->State.TXBufferCount && Endpoint_IsReadWriteAllowed())
+	{
+		uint16_t BufferStart = CDCInterfaceInfo->State.TXBufferStart;
+		uint16_t BankFree    = (BankSize - Endpoint_BytesInEndpoint());
+		uint16_t BytesToSend = (CDCInterfaceInfo->Config.TXBufferSize - BufferStart);
+
+		if (BytesToSend > CDCInterfaceInfo->State.TXBufferCount)
+		  BytesToSend = CDCInterfaceInfo->State.TXBufferCount;
+
+		if (BytesToSend > BankFree)
+		  BytesToSend = BankFree;
+
+		CDCInterfaceInfo->State.TXBufferCount -= BytesToSend;
+		BankFree -= BytesToSend;
+
+		const uint8_t* DataStream = &CDCInterfaceInfo->Config.TXBuffer[BufferStart];
+
+		BufferStart += BytesToSend;
+
+		if (BufferStart == CDCInterfaceInfo->Config.TXBufferSize)
+		  BufferStart = 0;
+
+		CDCInterfaceInfo->State.TXBufferStart = BufferStart;
+
+		while (BytesToSend--)
+		  Endpoint_Write_Byte(*(DataStream++));
+
+		if (!(BankFree))
+		{
+			Endpoint_ClearIN();
+
+			CDCInterfaceInfo->State.TXCoalesceState.StartFrame = 0;
+			CDCInterfaceInfo->State.TXCoalesceState.Waiting    = false;
+			CDCInterfaceInfo->State.TXCoalesceState.ZLPPending = true;
+		}
+	}
+}
+
+static uint8_t CDC_Device_WaitForTXBuffer(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo, const uint16_t MaxQueued)
+{
+	for (;;)
+	{
+		if ((USB_DeviceState != DEVICE_STATE_Configured) || !(CDCInterfaceInfo->State.LineEncoding.BaudRateBPS))
+		  return ENDPOINT_RWSTREAM_DeviceDisconnected;
+
+		CDC_Device_DrainTXBuffer(CDCInterfaceInfo);
+
+		if (CDCInterfaceInfo->State.TXBufferCount <= MaxQueued)
+		  return ENDPOINT_READYWAIT_NoError;
+
+		uint8_t ErrorCode;
+
+		if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
+		  return ErrorCode;
+	}
+}
+
 static int CDC_Device_putchar(char c, FILE* Stream)
 {
 	return CDC_Device_SendByte((USB_ClassInfo_CDC_Device_t*)fdev_get_udata(Stream), c) ? _FDEV_ERR : 0;
@@ -55,6 +55,22 @@
  *        recommended that the virtual serial line DTR (Data Terminal Ready) be used where
  *        possible to determine if a host application is ready for data.
  *
+ *  \section Sec_CDCDeviceBuffered Buffered Operation
+ *  By default each byte sent or received through the CDC class driver is written to or read from the data endpoints
+ *  directly, which requires the device state to be checked and the endpoint to be selected each time. For applications
+ *  transferring large amounts of data through the virtual serial port, application supplied transmit and receive ring
+ *  buffers may be attached to each CDC interface via the TXBuffer and RXBuffer elements of the interface's configuration.
+ *  When a buffer is attached, the byte level functions operate on the ring buffer alone, while \ref CDC_Device_USBTask()
+ *  moves data between the ring buffers and the data endpoints a whole bank at a time without blocking. The block level
+ *  \ref CDC_Device_SendData() and \ref CDC_Device_ReceiveData() functions may be used in either mode.
+ *
+ *  \section Sec_CDCDeviceCoalescing Transmit Coalescing
+ *  Data queued for the host is sent from \ref CDC_Device_USBTask() as soon as possible by default, which results in many short
+ *  packets when the application writes small amounts of data on each pass of its main loop. Setting the TXCoalesceFrames
+ *  element of the interface's configuration to a non-zero value allows a partially filled IN endpoint bank to be held for up
+ *  to the given number of USB frames while it fills, trading up to that many milliseconds of latency for fewer packets and
+ *  higher throughput. Full banks are always sent immediately, followed by a Zero Length Packet if no further data is queued.
+ *
  *  @{
  */
  
@@ -101,6 +117,17 @@
 					uint8_t  NotificationEndpointNumber; /**< Endpoint number of the CDC interface's IN notification endpoint, if used */
 					uint16_t NotificationEndpointSize;  /**< Size in bytes of the CDC interface's IN notification endpoint, if used */
 					bool     NotificationEndpointDoubleBank; /** Indicates if the CDC interface's notification endpoint should use double banking */
+
+					uint8_t* TXBuffer; /**< Pointer to an optional transmit ring buffer, or NULL to write data directly to the IN endpoint */
+					uint16_t TXBufferSize; /**< Size in bytes of the transmit ring buffer, if used */
+					uint8_t* RXBuffer; /**< Pointer to an optional receive ring buffer, or NULL to read data directly from the OUT endpoint */
+					uint16_t RXBufferSize; /**< Size in bytes of the receive ring buffer, if used */
+
+					uint8_t  TXCoalesceFrames; /**< Maximum number of USB frames (milliseconds) that \ref CDC_Device_USBTask() holds a
+					                            *   partially filled IN endpoint bank before sending it to the host. Zero sends data
+					                            *   on every call for the lowest latency; larger values coalesce small writes into
+					                            *   fewer, larger packets for higher throughput.
+					                            */
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */
@@ -130,6 +157,13 @@
 					} LineEncoding;	/** Line encoding used in the virtual serial port, for the device's information. This is generally
 					                 *  only used if the virtual serial port data is to be reconstructed on a physical UART.
 					                 */		
+
+					uint16_t TXBufferStart; /**< Index of the oldest queued byte in the transmit ring buffer */
+					uint16_t TXBufferCount; /**< Number of bytes queued in the transmit ring buffer */
+					uint16_t RXBufferStart; /**< Index of the oldest received byte in the receive ring buffer */
+					uint16_t RXBufferCount; /**< Number of bytes waiting in the receive ring buffer */
+
+					Endpoint_CoalesceState_t TXCoalesceState; /**< Transmit coalescing state of the IN data endpoint */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -195,6 +229,25 @@
 			 */
 			uint8_t CDC_Device_SendString(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo, char* const Data, const uint16_t Length)
 			                              ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Sends a given block of data to the attached USB host, if connected. If the interface has a transmit ring buffer
+			 *  attached, the data is queued into the ring buffer, waiting for the host to accept previously queued data only when
+			 *  the ring buffer becomes full; blocks larger than the ring buffer are written directly to the endpoint once the ring
+			 *  buffer has been emptied. Otherwise, the data is written directly to the IN endpoint. As with \ref CDC_Device_SendByte(),
+			 *  the final partial packet is not sent until the endpoint bank becomes full, \ref CDC_Device_Flush() is called, or (in
+			 *  buffered mode) \ref CDC_Device_USBTask() finds no further data to send.
+			 *
+			 *  \note This function must only be called when the Device state machine is in the DEVICE_STATE_Configured state or
+			 *        the call will fail.
+			 *
+			 *  \param[in,out] CDCInterfaceInfo  Pointer to a structure containing a CDC Class configuration and state
+			 *  \param[in] Buffer  Pointer to the data to send to the host
+			 *  \param[in] Length  Size in bytes of the data to send to the host
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum
+			 */
+			uint8_t CDC_Device_SendData(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo, const void* const Buffer, uint16_t Length)
+			                            ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 			
 			/** Sends a given byte to the attached USB host, if connected. If a host is not connected when the function is called, the
 			 *  byte is discarded. Bytes will be queued for transmission to the host until either the endpoint bank becomes full, or the
@@ -204,6 +257,9 @@
 			 *  \note This function must only be called when the Device state machine is in the DEVICE_STATE_Configured state or
 			 *        the call will fail.
 			 *
+			 *  \note If the interface has a transmit ring buffer attached, the byte is stored into the ring buffer, and the endpoint
+			 *        is only accessed when the ring buffer is full.
+			 *
 			 *  \param[in,out] CDCInterfaceInfo  Pointer to a structure containing a CDC Class configuration and state
 			 *  \param[in] Data  Byte of data to send to the host
 			 *
@@ -234,6 +290,22 @@
 			 *  \return Next received byte from the host, or 0 if no data received
 			 */
 			uint8_t CDC_Device_ReceiveByte(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Reads up to the given number of bytes of data received from the host into the given buffer, without blocking. If
+			 *  the interface has a receive ring buffer attached, data waiting in the ring buffer is returned first, followed by
+			 *  any data waiting in the OUT endpoint. If a USB host is not connected, no data is read.
+			 *
+			 *  \note This function must only be called when the Device state machine is in the DEVICE_STATE_Configured state or
+			 *        the call will fail.
+			 *
+			 *  \param[in,out] CDCInterfaceInfo  Pointer to a structure containing a CDC Class configuration and state
+			 *  \param[out] Buffer  Pointer to a buffer where the received data is to be stored
+			 *  \param[in] MaxLength  Maximum number of bytes to read into the buffer
+			 *
+			 *  \return Number of bytes read into the buffer
+			 */
+			uint16_t CDC_Device_ReceiveData(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo, void* const Buffer,
+			                                const uint16_t MaxLength) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 			
 			/** Flushes any data waiting to be sent, ensuring that the send buffer is cleared.
 			 *
@@ -290,6 +362,11 @@
 				static int CDC_Device_putchar(char c, FILE* Stream);
 				static int CDC_Device_getchar(FILE* Stream);
 				static int CDC_Device_getchar_Blocking(FILE* Stream);
+
+				static uint16_t CDC_Device_ReadEndpoint(uint8_t* Buffer, const uint16_t MaxLength);
+				static void     CDC_Device_FillRXBuffer(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo);
+				static void     CDC_Device_DrainTXBuffer(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo);
+				static uint8_t  CDC_Device_WaitForTXBuffer(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo, const uint16_t MaxQueued);
 				
 				void CDC_Device_Event_Stub(void);
 				void EVENT_CDC_Device_LineEncodingChanged(USB_ClassInfo_CDC_Device_t* const CDCInterfaceInfo)
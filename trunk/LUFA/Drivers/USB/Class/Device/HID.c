@@ -32,6 +32,7 @@
 #include "../../HighLevel/USBMode.h"
 #if defined(USB_CAN_BE_DEVICE)
 
+#define  __INCLUDE_FROM_HID_CLASS_DEVICE_C
 #define  __INCLUDE_FROM_HID_DRIVER
 #include "HID.h"
 
@@ -48,12 +49,41 @@ void HID_Device_ProcessControlRequest(USB_ClassInfo_HID_Device_t* const HIDInter
 		case REQ_GetReport:
 			if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE))
 			{
-				Endpoint_ClearSETUP();	
-
 				uint16_t ReportINSize = 0;
 				uint8_t  ReportID     = (USB_ControlRequest.wValue & 0xFF);
 				uint8_t  ReportType   = (USB_ControlRequest.wValue >> 8) - 1;
 
+				USB_HID_Device_ReportSlot_t* ReportSlot = NULL;
+				
+				if (HIDInterfaceInfo->State.UsingReportProtocol && (ReportType == REPORT_ITEM_TYPE_In))
+				  ReportSlot = HID_Device_GetReportSlot(HIDInterfaceInfo, ReportID);
+
+				if (ReportSlot != NULL)
+				{
+					uint16_t ReportLength = ReportSlot->ReportSize;
+
+					Endpoint_ClearSETUP();
+
+					/* The report ID is sent ahead of the slot data, so it must be counted against the requested length */
+					if (ReportID && USB_ControlRequest.wLength)
+					{
+						Endpoint_Write_Byte(ReportID);
+						USB_ControlRequest.wLength--;
+					}
+
+					if (ReportLength > USB_ControlRequest.wLength)
+					  ReportLength = USB_ControlRequest.wLength;
+
+					Endpoint_Write_Control_Stream_LE(ReportSlot->ReportData, ReportLength);
+					Endpoint_ClearOUT();
+					break;
+				}
+
+				if (HIDInterfaceInfo->Config.PrevReportINBuffer == NULL)
+				  break;
+
+				Endpoint_ClearSETUP();	
+
 				memset(HIDInterfaceInfo->Config.PrevReportINBuffer, 0, HIDInterfaceInfo->Config.PrevReportINBufferSize);
 				
 				CALLBACK_HID_Device_CreateHIDReport(HIDInterfaceInfo, &ReportID, ReportType,
@@ -108,8 +138,20 @@ void HID_Device_ProcessControlRequest(USB_ClassInfo_HID_Device_t* const HIDInter
 			if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE))
 			{
 				Endpoint_ClearSETUP();
-					
-				HIDInterfaceInfo->State.IdleCount = ((USB_ControlRequest.wValue & 0xFF00) >> 6);
+
+				uint16_t IdleCount = ((USB_ControlRequest.wValue & 0xFF00) >> 6);
+				uint8_t  ReportID  = (USB_ControlRequest.wValue & 0xFF);
+
+				if (!(ReportID))
+				  HIDInterfaceInfo->State.IdleCount = IdleCount;
+
+				for (uint8_t SlotIndex = 0; SlotIndex < HIDInterfaceInfo->Config.TotalReportINSlots; SlotIndex++)
+				{
+					USB_HID_Device_ReportSlot_t* ReportSlot = &HIDInterfaceInfo->Config.ReportINSlots[SlotIndex];
+
+					if (!(ReportID) || (ReportSlot->ReportID == ReportID))
+					  ReportSlot->IdleCount = IdleCount;
+				}
 					
 				Endpoint_ClearStatusStage();
 			}
@@ -119,8 +161,14 @@ void HID_Device_ProcessControlRequest(USB_ClassInfo_HID_Device_t* const HIDInter
 			if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE))
 			{		
 				Endpoint_ClearSETUP();
+
+				USB_HID_Device_ReportSlot_t* ReportSlot = HID_Device_GetReportSlot(HIDInterfaceInfo,
+				                                                                   (USB_ControlRequest.wValue & 0xFF));
 				
-				Endpoint_Write_Byte(HIDInterfaceInfo->State.IdleCount >> 2);
+				if ((ReportSlot != NULL) && ReportSlot->ReportID)
+				  Endpoint_Write_Byte(ReportSlot->IdleCount >> 2);
+				else
+				  Endpoint_Write_Byte(HIDInterfaceInfo->State.IdleCount >> 2);
 				Endpoint_ClearIN();
 
 				Endpoint_ClearStatusStage();
@@ -136,6 +184,15 @@ bool HID_Device_ConfigureEndpoints(USB_ClassInfo_HID_Device_t* const HIDInterfac
 	HIDInterfaceInfo->State.UsingReportProtocol = true;
 	HIDInterfaceInfo->State.IdleCount = 500;
 
+	for (uint8_t SlotIndex = 0; SlotIndex < HIDInterfaceInfo->Config.TotalReportINSlots; SlotIndex++)
+	{
+		USB_HID_Device_ReportSlot_t* ReportSlot = &HIDInterfaceInfo->Config.ReportINSlots[SlotIndex];
+		
+		ReportSlot->Changed         = false;
+		ReportSlot->IdleCount       = 500;
+		ReportSlot->IdleMSRemaining = 0;
+	}
+
 	if (!(Endpoint_ConfigureEndpoint(HIDInterfaceInfo->Config.ReportINEndpointNumber, EP_TYPE_INTERRUPT,
 									 ENDPOINT_DIR_IN, HIDInterfaceInfo->Config.ReportINEndpointSize,
 									 HIDInterfaceInfo->Config.ReportINEndpointDoubleBank ? ENDPOINT_BANK_DOUBLE : ENDPOINT_BANK_SINGLE)))
@@ -152,6 +209,14 @@ void HID_Device_USBTask(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
 	  return;
 
 	Endpoint_SelectEndpoint(HIDInterfaceInfo->Config.ReportINEndpointNumber);
+
+	if ((HIDInterfaceInfo->Config.ReportINSlots != NULL) && HIDInterfaceInfo->State.UsingReportProtocol)
+	{
+		if (Endpoint_IsReadWriteAllowed())
+		  HID_Device_SendReportSlots(HIDInterfaceInfo);
+
+		return;
+	}
 	
 	if (Endpoint_IsReadWriteAllowed())
 	{
@@ -188,4 +253,62 @@ void HID_Device_USBTask(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
 	}
 }
 
+bool HID_Device_MarkReportChanged(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo, const uint8_t ReportID)
+{
+	USB_HID_Device_ReportSlot_t* ReportSlot = HID_Device_GetReportSlot(HIDInterfaceInfo, ReportID);
+	
+	if (ReportSlot == NULL)
+	  return false;
+
+	ReportSlot->Changed = true;
+	return true;
+}
+
+static USB_HID_Device_ReportSlot_t* HID_Device_GetReportSlot(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                                             const uint8_t ReportID)
+{
+	USB_HID_Device_ReportSlot_t* ReportSlot = HIDInterfaceInfo->Config.ReportINSlots;
+
+	for (uint8_t SlotsRemaining = HIDInterfaceInfo->Config.TotalReportINSlots; SlotsRemaining; SlotsRemaining--)
+	{
+		if (ReportSlot->ReportID == ReportID)
+		  return ReportSlot;
+		  
+		ReportSlot++;
+	}
+	
+	return NULL;
+}
+
+static void HID_Device_SendReportSlots(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
+{
+	uint8_t TotalSlots = HIDInterfaceInfo->Config.TotalReportINSlots;
+	uint8_t SlotIndex  = HIDInterfaceInfo->State.NextReportINSlot;
+
+	/* Check each slot in turn starting after the last sent report, so that a frequently changing report cannot
+	 * starve the interface's other reports */
+	for (uint8_t SlotsRemaining = TotalSlots; SlotsRemaining; SlotsRemaining--)
+	{
+		USB_HID_Device_ReportSlot_t* ReportSlot = &HIDInterfaceInfo->Config.ReportINSlots[SlotIndex];
+
+		if (++SlotIndex == TotalSlots)
+		  SlotIndex = 0;
+
+		if (!(ReportSlot->Changed) && !(ReportSlot->IdleCount && !(ReportSlot->IdleMSRemaining)))
+		  continue;
+
+		ReportSlot->Changed         = false;
+		ReportSlot->IdleMSRemaining = ReportSlot->IdleCount;
+
+		if (ReportSlot->ReportID)
+		  Endpoint_Write_Byte(ReportSlot->ReportID);
+
+		Endpoint_Write_Stream_LE(ReportSlot->ReportData, ReportSlot->ReportSize, NO_STREAM_CALLBACK);
+		Endpoint_ClearIN();
+
+		HIDInterfaceInfo->State.NextReportINSlot = SlotIndex;
+		return;
+	}
+}
+
 #endif
@@ -38,6 +38,24 @@
  *  \section Module Description
  *  Device Mode USB Class driver framework interface, for the HID USB Class driver.
  *
+ *  \section Sec_HIDDeviceReportSlots Report Slots
+ *  By default the driver asks the application for a complete input report via \ref CALLBACK_HID_Device_CreateHIDReport()
+ *  each time the IN endpoint is ready, and compares it against the previous report held in \c PrevReportINBuffer to
+ *  decide if it must be sent. As only one previous report is held, this comparison cannot track interfaces which
+ *  send several reports with different report IDs, and every report must be rebuilt on every pass of the main loop.
+ *
+ *  Alternatively, the application may supply an array of \ref USB_HID_Device_ReportSlot_t report slots via the
+ *  \c ReportINSlots configuration element, one per input report ID sent from the interface. Each slot points to an
+ *  application buffer holding the current contents of the report; the application updates this buffer in place and
+ *  calls \ref HID_Device_MarkReportChanged() when the report should be sent to the host. The driver then sends each
+ *  changed report straight from its slot buffer in turn, and re-sends each report when its own idle period (set by
+ *  the host per report ID) elapses. When report slots are in use the creation callback is only invoked for reports
+ *  requested by the host via the control endpoint which do not have a matching input report slot, and for all reports
+ *  while the host has selected the boot protocol, as boot reports differ in format from the slots' report protocol data.
+ *
+ *  Reports requested by the host via the control endpoint which are created by the callback are built in the
+ *  \c PrevReportINBuffer buffer; if this is NULL, such requests are not handled and are stalled by the library.
+ *
  *  @{
  */
  
@@ -62,6 +80,24 @@
 
 	/* Public Interface - May be used in end-application: */
 		/* Type Defines: */
+			/** Type define for a HID input report slot, used when the application maintains the interface's input reports
+			 *  itself rather than generating them on demand (see \ref Sec_HIDDeviceReportSlots). The \c ReportID,
+			 *  \c ReportSize and \c ReportData elements must be set by the application; all other elements are managed
+			 *  by the driver and are reset when the interface's endpoints are configured.
+			 */
+			typedef struct
+			{
+				uint8_t  ReportID; /**< Report ID of the input report held in the slot, or zero if the interface does not use report IDs */
+				uint8_t  ReportSize; /**< Size in bytes of the input report, not including the report ID prefix */
+				void*    ReportData; /**< Pointer to the application buffer holding the current contents of the input report */
+
+				bool     Changed; /**< Indicates if the report has been marked as changed via \ref HID_Device_MarkReportChanged() and is
+				                   *   waiting to be sent to the host
+				                   */
+				uint16_t IdleCount; /**< Report idle period, in milliseconds, set by the host for the slot's report ID */
+				uint16_t IdleMSRemaining; /**< Total number of milliseconds remaining before the slot's idle period elapses */
+			} USB_HID_Device_ReportSlot_t;
+
 			/** Class state structure. An instance of this structure should be made for each HID interface
 			 *  within the user application, and passed to each of the HID class driver functions as the
 			 *  HIDInterfaceInfo parameter. This stores each HID interface's configuration and state information.
@@ -97,6 +133,13 @@
 					                                  *  can be compared. If the user app is to determine when reports are to be sent
 					                                  *  exclusively (i.e. \ref PrevReportINBuffer is NULL) this value is ignored.
 					                                  */
+
+					USB_HID_Device_ReportSlot_t* ReportINSlots; /**< Pointer to an array of input report slots, one per input report ID
+					                                             *   sent from the interface, or NULL if reports are to be created on demand
+					                                             *   via \ref CALLBACK_HID_Device_CreateHIDReport() (see
+					                                             *   \ref Sec_HIDDeviceReportSlots)
+					                                             */
+					uint8_t  TotalReportINSlots; /**< Number of input report slots in the \c ReportINSlots array. */
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */										 
@@ -106,6 +149,7 @@
 					uint16_t IdleCount; /**< Report idle period, in milliseconds, set by the host */
 					uint16_t IdleMSRemaining; /**< Total number of milliseconds remaining before the idle period elapsed - this 
 											   *   should be decremented by the user application if non-zero each millisecond */	
+					uint8_t  NextReportINSlot; /**< Index of the input report slot to be checked first for a pending report */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -135,6 +179,21 @@
 			 *  \param[in,out] HIDInterfaceInfo  Pointer to a structure containing a HID Class configuration and state
 			 */
 			void HID_Device_USBTask(USB_ClassInfo_HID_Device_t* HIDInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Marks the input report with the given report ID as changed, so that it is sent to the host from its report slot
+			 *  once the interface's IN endpoint is ready. This should be called by the application each time it has updated the
+			 *  contents of a report slot's buffer, and is only valid when report slots are in use (see \ref Sec_HIDDeviceReportSlots).
+			 *
+			 *  \note The report slot's buffer should not be altered again until the report has been sent, as indicated by the
+			 *        slot's \c Changed flag being cleared by the driver, or the host may receive a partially updated report.
+			 *
+			 *  \param[in,out] HIDInterfaceInfo  Pointer to a structure containing a HID Class configuration and state
+			 *  \param[in] ReportID  Report ID of the changed input report, or zero if the interface does not use report IDs
+			 *
+			 *  \return Boolean true if a report slot with the given report ID exists, false otherwise
+			 */
+			bool HID_Device_MarkReportChanged(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo, const uint8_t ReportID)
+			                                  ATTR_NON_NULL_PTR_ARG(1);
 			
 			/** HID class driver callback for the user creation of a HID IN report. This callback may fire in response to either
 			 *  HID class control requests from the host, or by the normal HID endpoint polling procedure. Inside this callback the
@@ -173,7 +232,8 @@
 			/** Indicates that a millisecond of idle time has elapsed on the given HID interface, and the interface's idle count should be
 			 *  decremented. This should be called once per millisecond so that hardware key-repeats function correctly. It is recommended
 			 *  that this be called by the \ref EVENT_USB_Device_StartOfFrame() event, once SOF events have been enabled via
-			 *  \ref USB_Device_EnableSOFEvents();.
+			 *  \ref USB_Device_EnableSOFEvents();. When report slots are in use, the idle time remaining of each report slot is
+			 *  also decremented.
 			 *
 			 *  \param[in,out] HIDInterfaceInfo  Pointer to a structure containing a HID Class configuration and state
 			 */
@@ -182,7 +242,27 @@
 			{
 				if (HIDInterfaceInfo->State.IdleMSRemaining)
 				  HIDInterfaceInfo->State.IdleMSRemaining--;
+
+				USB_HID_Device_ReportSlot_t* ReportSlot = HIDInterfaceInfo->Config.ReportINSlots;
+
+				for (uint8_t SlotsRemaining = HIDInterfaceInfo->Config.TotalReportINSlots; SlotsRemaining; SlotsRemaining--)
+				{
+					if (ReportSlot->IdleMSRemaining)
+					  ReportSlot->IdleMSRemaining--;
+
+					ReportSlot++;
+				}
 			}
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Function Prototypes: */
+		#if defined(__INCLUDE_FROM_HID_CLASS_DEVICE_C)
+			static USB_HID_Device_ReportSlot_t* HID_Device_GetReportSlot(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+			                                                             const uint8_t ReportID) ATTR_NON_NULL_PTR_ARG(1);
+			static void HID_Device_SendReportSlots(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+		#endif
+	#endif
 			
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
@@ -72,22 +72,67 @@ uint8_t MIDI_Device_SendEventPacket(USB_ClassInfo_MIDI_Device_t* const MIDIInter
 	if (USB_DeviceState != DEVICE_STATE_Configured)
 	  return ENDPOINT_RWSTREAM_DeviceDisconnected;
 	
-	Endpoint_SelectEndpoint(MIDIInterfaceInfo->Config.DataINEndpointNumber);
-
-	if (Endpoint_IsReadWriteAllowed());
+	while (!(MIDI_Device_SendEventPackets(MIDIInterfaceInfo, Event, 1)))
 	{
 		uint8_t ErrorCode;
 
-		if ((ErrorCode = Endpoint_Write_Stream_LE(Event, sizeof(MIDI_EventPacket_t), NO_STREAM_CALLBACK)) != ENDPOINT_RWSTREAM_NoError)
+		if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
 		  return ErrorCode;
-
-		if (!(Endpoint_IsReadWriteAllowed()))
-		  Endpoint_ClearIN();
 	}
-	
+
 	return ENDPOINT_RWSTREAM_NoError;
 }
 
+uint16_t MIDI_Device_SendEventPackets(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo, const MIDI_EventPacket_t* const Events,
+                                      const uint16_t TotalEvents)
+{
+	if (USB_DeviceState != DEVICE_STATE_Configured)
+	  return 0;
+
+	const uint8_t* EventData  = (const uint8_t*)Events;
+	uint16_t       EventsSent = 0;
+
+	Endpoint_SelectEndpoint(MIDIInterfaceInfo->Config.DataINEndpointNumber);
+
+	while ((EventsSent < TotalEvents) && Endpoint_IsReadWriteAllowed())
+	{
+		uint16_t BankEvents  = ((MIDIInterfaceInfo->Config.DataINEndpointSize - Endpoint_BytesInEndpoint()) / sizeof(MIDI_EventPacket_t));
+		uint16_t BatchEvents = BankEvents;
+
+		/* An empty bank with no room for an event can never be filled, so stop rather than sending empty packets forever */
+		if (!(BankEvents) && !(Endpoint_BytesInEndpoint()))
+		  break;
+
+		if (BatchEvents > (TotalEvents - EventsSent))
+		  BatchEvents = (TotalEvents - EventsSent);
+
+		for (uint16_t BytesRemaining = (BatchEvents * sizeof(MIDI_EventPacket_t)); BytesRemaining; BytesRemaining--)
+		  Endpoint_Write_Byte(*(EventData++));
+
+		EventsSent += BatchEvents;
+
+		if (BatchEvents == BankEvents)
+		{
+			Endpoint_ClearIN();
+
+			MIDIInterfaceInfo->State.TXCoalesceState.StartFrame = 0;
+			MIDIInterfaceInfo->State.TXCoalesceState.Waiting    = false;
+			MIDIInterfaceInfo->State.TXCoalesceState.ZLPPending = true;
+		}
+	}
+
+	return EventsSent;
+}
+
+void MIDI_Device_USBTask(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(MIDIInterfaceInfo->Config.DataINEndpointNumber))
+	  return;
+
+	Endpoint_SelectEndpoint(MIDIInterfaceInfo->Config.DataINEndpointNumber);
+	Endpoint_FlushCoalesced(&MIDIInterfaceInfo->State.TXCoalesceState, MIDIInterfaceInfo->Config.TXCoalesceFrames);
+}
+
 uint8_t MIDI_Device_Flush(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo)
 {
 	if (USB_DeviceState != DEVICE_STATE_Configured)
@@ -97,6 +142,12 @@ uint8_t MIDI_Device_Flush(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo)
 
 	Endpoint_SelectEndpoint(MIDIInterfaceInfo->Config.DataINEndpointNumber);
 
+	bool ZLPPending = MIDIInterfaceInfo->State.TXCoalesceState.ZLPPending;
+
+	MIDIInterfaceInfo->State.TXCoalesceState.StartFrame = 0;
+	MIDIInterfaceInfo->State.TXCoalesceState.Waiting    = false;
+	MIDIInterfaceInfo->State.TXCoalesceState.ZLPPending = false;
+
 	if (Endpoint_BytesInEndpoint())
 	{
 		Endpoint_ClearIN();
@@ -104,6 +155,16 @@ uint8_t MIDI_Device_Flush(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo)
 		if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
 		  return ErrorCode;
 	}
+	else if (ZLPPending)
+	{
+		if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
+		  return ErrorCode;
+
+		Endpoint_ClearIN();
+
+		if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
+		  return ErrorCode;
+	}
 
 	return ENDPOINT_READYWAIT_NoError;
 }
@@ -113,17 +174,39 @@ bool MIDI_Device_ReceiveEventPacket(USB_ClassInfo_MIDI_Device_t* const MIDIInter
 	if (USB_DeviceState != DEVICE_STATE_Configured)
 	  return false;
 	
+	return (MIDI_Device_ReceiveEventPackets(MIDIInterfaceInfo, Event, 1) != 0);
+}
+
+uint16_t MIDI_Device_ReceiveEventPackets(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo, MIDI_EventPacket_t* const Events,
+                                         const uint16_t MaxEvents)
+{
+	if (USB_DeviceState != DEVICE_STATE_Configured)
+	  return 0;
+
+	uint8_t* EventData      = (uint8_t*)Events;
+	uint16_t EventsReceived = 0;
+
 	Endpoint_SelectEndpoint(MIDIInterfaceInfo->Config.DataOUTEndpointNumber);
 
-	if (!(Endpoint_IsReadWriteAllowed()))
-	  return false;
+	while ((EventsReceived < MaxEvents) && Endpoint_IsOUTReceived())
+	{
+		uint16_t BankEvents  = (Endpoint_BytesInEndpoint() / sizeof(MIDI_EventPacket_t));
+		uint16_t BatchEvents = BankEvents;
 
-	Endpoint_Read_Stream_LE(Event, sizeof(MIDI_EventPacket_t), NO_STREAM_CALLBACK);
-	
-	if (!(Endpoint_IsReadWriteAllowed()))
-	  Endpoint_ClearOUT();
-	
-	return true;
+		if (BatchEvents > (MaxEvents - EventsReceived))
+		  BatchEvents = (MaxEvents - EventsReceived);
+
+		for (uint16_t BytesRemaining = (BatchEvents * sizeof(MIDI_EventPacket_t)); BytesRemaining; BytesRemaining--)
+		  *(EventData++) = Endpoint_Read_Byte();
+
+		EventsReceived += BatchEvents;
+
+		/* Release the bank once all whole event packets have been read, discarding any trailing partial packet */
+		if (BatchEvents == BankEvents)
+		  Endpoint_ClearOUT();
+	}
+
+	return EventsReceived;
 }
 
 #endif
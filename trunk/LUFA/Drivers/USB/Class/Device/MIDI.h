@@ -34,6 +34,7 @@
  *  \section Sec_Dependencies Module Source Dependencies
  *  The following files must be built with any user project that uses this module:
  *    - LUFA/Drivers/USB/Class/Device/MIDI.c
+ *    - LUFA/Drivers/USB/Class/Common/MIDI.c
  *
  *  \section Module Description
  *  Device Mode USB Class driver framework interface, for the MIDI USB Class driver.
@@ -79,12 +80,18 @@
 					uint8_t  DataOUTEndpointNumber; /**< Endpoint number of the outgoing MIDI data, if available (zero if unused) */
 					uint16_t DataOUTEndpointSize; /**< Size in bytes of the outgoing MIDI data endpoint, if available (zero if unused) */
 					bool     DataOUTEndpointDoubleBank; /** Indicates if the MIDI interface's IN data endpoint should use double banking */
+
+					uint8_t  TXCoalesceFrames; /**< Maximum number of USB frames (milliseconds) that \ref MIDI_Device_USBTask() holds a
+					                            *   partially filled IN endpoint bank before sending it to the host. Zero sends queued
+					                            *   events on every call for the lowest latency; larger values coalesce events into
+					                            *   fewer, larger packets for higher throughput.
+					                            */
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */									 
 				struct
 				{
-					// No state information for this class yet
+					Endpoint_CoalesceState_t TXCoalesceState; /**< Transmit coalescing state of the IN data endpoint */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -108,8 +115,9 @@
 			 */		
 			void MIDI_Device_ProcessControlRequest(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 
-			/** Sends a MIDI event packet to the host. If no host is connected, the event packet is discarded. Events are queued into the
-			 *  endpoint bank until either the endpoint bank is full, or \ref MIDI_Device_Flush() is called. This allows for multiple
+			/** Sends a MIDI event packet to the host. If the endpoint banks are full, this waits until the host has read a bank so that
+			 *  the event can be queued, or until an error occurs; use \ref MIDI_Device_SendEventPackets() to avoid blocking. Events are queued into
+			 *  the endpoint bank until either the endpoint bank is full, or \ref MIDI_Device_Flush() is called. This allows for multiple
 			 *  MIDI events to be packed into a single endpoint packet, increasing data throughput.
 			 *
 			 *  \note This function must only be called when the Device state machine is in the DEVICE_STATE_Configured state or
@@ -123,6 +131,31 @@
 			uint8_t MIDI_Device_SendEventPacket(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
 			                                    MIDI_EventPacket_t* const Event) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
+			/** Sends an array of MIDI event packets to the host, filling each free endpoint bank with as many of the events as will
+			 *  fit in a single pass rather than one event at a time. Full banks are sent immediately, while a final partially filled
+			 *  bank is queued as with \ref MIDI_Device_SendEventPacket(). This function does not block; once the endpoint banks are
+			 *  full the remaining events are left unsent, and should be passed to a later call.
+			 *
+			 *  \note This function must only be called when the Device state machine is in the DEVICE_STATE_Configured state or
+			 *        no events will be sent.
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state
+			 *  \param[in] Events  Pointer to an array of populated MIDI_EventPacket_t structures containing the MIDI events to send
+			 *  \param[in] TotalEvents  Number of event packets in the Events array
+			 *
+			 *  \return Number of event packets sent or queued for sending
+			 */
+			uint16_t MIDI_Device_SendEventPackets(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo, const MIDI_EventPacket_t* const Events,
+			                                      const uint16_t TotalEvents) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** General management task for a given MIDI class interface, required for the correct operation of the interface. This should
+			 *  be called frequently in the main program loop, before the master USB management task \ref USB_USBTask(). Queued MIDI
+			 *  events are sent to the host from this task according to the interface's TXCoalesceFrames setting.
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state
+			 */
+			void MIDI_Device_USBTask(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
 
 			/** Flushes the MIDI send buffer, sending any queued MIDI events to the host. This should be called to override the
 			 *  \ref MIDI_Device_SendEventPacket() function's packing behaviour, to flush queued events.
@@ -147,17 +180,21 @@
 			bool MIDI_Device_ReceiveEventPacket(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
 			                                    MIDI_EventPacket_t* const Event) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
-		/* Inline Functions: */
-			/** General management task for a given MIDI class interface, required for the correct operation of the interface. This should
-			 *  be called frequently in the main program loop, before the master USB management task \ref USB_USBTask().
+			/** Receives up to the given number of MIDI event packets from the host, emptying each received endpoint bank into the
+			 *  given array in a single pass rather than one event at a time. This function does not block, returning only the events
+			 *  which have already been received.
+			 *
+			 *  \note This function must only be called when the Device state machine is in the DEVICE_STATE_Configured state or
+			 *        no events will be received.
 			 *
 			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state
+			 *  \param[out] Events  Pointer to an array of MIDI_EventPacket_t structures where the received MIDI events are to be placed
+			 *  \param[in] MaxEvents  Maximum number of event packets to store into the Events array
+			 *
+			 *  \return Number of event packets received
 			 */
-			static inline void MIDI_Device_USBTask(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo);
-			static inline void MIDI_Device_USBTask(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo)
-			{
-				(void)MIDIInterfaceInfo;
-			}		
+			uint16_t MIDI_Device_ReceiveEventPackets(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo, MIDI_EventPacket_t* const Events,
+			                                         const uint16_t MaxEvents) ATTR_NON_NULL_PTR_ARG(1);
 
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
@@ -51,7 +51,6 @@ static const uint32_t PROGMEM AdapterSupportedOIDList[]  =
 		OID_GEN_VENDOR_ID,
 		OID_GEN_VENDOR_DESCRIPTION,
 		OID_GEN_CURRENT_PACKET_FILTER,
-		OID_GEN_MAXIMUM_TOTAL_SIZE,
 		OID_GEN_MEDIA_CONNECT_STATUS,
 		OID_GEN_XMIT_OK,
 		OID_GEN_RCV_OK,
@@ -115,6 +114,7 @@ void RNDIS_Device_ProcessControlRequest(USB_ClassInfo_RNDIS_Device_t* const RNDI
 bool RNDIS_Device_ConfigureEndpoints(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
 {
 	memset(&RNDISInterfaceInfo->State, 0x00, sizeof(RNDISInterfaceInfo->State));
+	RNDIS_Device_ResetFrameQueues(RNDISInterfaceInfo);
 
 	if (!(Endpoint_ConfigureEndpoint(RNDISInterfaceInfo->Config.DataINEndpointNumber, EP_TYPE_BULK,
 							         ENDPOINT_DIR_IN, RNDISInterfaceInfo->Config.DataINEndpointSize,
@@ -168,49 +168,208 @@ void RNDIS_Device_USBTask(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo
 	}
 	
 	if ((RNDISInterfaceInfo->State.CurrRNDISState == RNDIS_Data_Initialized) && !(MessageHeader->MessageLength))
+	{
+		RNDIS_Device_UpdateFrameQueues(RNDISInterfaceInfo);
+
+		RNDIS_Device_ReceiveFrames(RNDISInterfaceInfo);
+		RNDIS_Device_SendFrames(RNDISInterfaceInfo);
+	}
+}
+
+Ethernet_Frame_Info_t* RNDIS_Device_GetReceivedFrame(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+{
+	RNDIS_Device_UpdateFrameQueues(RNDISInterfaceInfo);
+
+	if (!(RNDISInterfaceInfo->State.FrameINCount))
+	  return NULL;
+
+	return RNDIS_Device_GetFrameIN(RNDISInterfaceInfo, RNDISInterfaceInfo->State.FrameINTail);
+}
+
+Ethernet_Frame_Info_t* RNDIS_Device_GetFrameToSend(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+{
+	RNDIS_Device_UpdateFrameQueues(RNDISInterfaceInfo);
+
+	if (RNDISInterfaceInfo->State.FrameOUTCount == (RNDISInterfaceInfo->Config.TotalExtraFramesOUT + 1))
+	  return NULL;
+
+	return RNDIS_Device_GetFrameOUT(RNDISInterfaceInfo, RNDISInterfaceInfo->State.FrameOUTHead);
+}
+
+static Ethernet_Frame_Info_t* RNDIS_Device_GetFrameIN(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+                                                      const uint8_t Index)
+{
+	/* Slot zero is always the frame in the interface state, followed by any user supplied extra frame slots */
+	return (Index) ? &RNDISInterfaceInfo->Config.ExtraFramesIN[Index - 1] : &RNDISInterfaceInfo->State.FrameIN;
+}
+
+static Ethernet_Frame_Info_t* RNDIS_Device_GetFrameOUT(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+                                                       const uint8_t Index)
+{
+	/* Slot zero is always the frame in the interface state, followed by any user supplied extra frame slots */
+	return (Index) ? &RNDISInterfaceInfo->Config.ExtraFramesOUT[Index - 1] : &RNDISInterfaceInfo->State.FrameOUT;
+}
+
+static void RNDIS_Device_ResetFrameQueues(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+{
+	RNDISInterfaceInfo->State.FrameINHead   = 0;
+	RNDISInterfaceInfo->State.FrameINTail   = 0;
+	RNDISInterfaceInfo->State.FrameINCount  = 0;
+	RNDISInterfaceInfo->State.FrameOUTHead  = 0;
+	RNDISInterfaceInfo->State.FrameOUTTail  = 0;
+	RNDISInterfaceInfo->State.FrameOUTCount = 0;
+
+	/* The extra frame slots live outside the interface state, so stale frames in them must be discarded explicitly */
+	for (uint8_t Index = 0; Index <= RNDISInterfaceInfo->Config.TotalExtraFramesIN; Index++)
+	  RNDIS_Device_GetFrameIN(RNDISInterfaceInfo, Index)->FrameInBuffer = false;
+
+	for (uint8_t Index = 0; Index <= RNDISInterfaceInfo->Config.TotalExtraFramesOUT; Index++)
+	  RNDIS_Device_GetFrameOUT(RNDISInterfaceInfo, Index)->FrameInBuffer = false;
+}
+
+static void RNDIS_Device_UpdateFrameQueues(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+{
+	uint8_t TotalFramesIN  = (RNDISInterfaceInfo->Config.TotalExtraFramesIN  + 1);
+	uint8_t TotalFramesOUT = (RNDISInterfaceInfo->Config.TotalExtraFramesOUT + 1);
+
+	/* Release the oldest received frames once the user application has cleared their buffer flags */
+	while (RNDISInterfaceInfo->State.FrameINCount &&
+	       !(RNDIS_Device_GetFrameIN(RNDISInterfaceInfo, RNDISInterfaceInfo->State.FrameINTail)->FrameInBuffer))
+	{
+		if (++RNDISInterfaceInfo->State.FrameINTail == TotalFramesIN)
+		  RNDISInterfaceInfo->State.FrameINTail = 0;
+
+		RNDISInterfaceInfo->State.FrameINCount--;
+	}
+
+	/* Queue the free frames for sending once the user application has set their buffer flags */
+	while ((RNDISInterfaceInfo->State.FrameOUTCount < TotalFramesOUT) &&
+	       RNDIS_Device_GetFrameOUT(RNDISInterfaceInfo, RNDISInterfaceInfo->State.FrameOUTHead)->FrameInBuffer)
+	{
+		if (++RNDISInterfaceInfo->State.FrameOUTHead == TotalFramesOUT)
+		  RNDISInterfaceInfo->State.FrameOUTHead = 0;
+
+		RNDISInterfaceInfo->State.FrameOUTCount++;
+	}
+}
+
+static void RNDIS_Device_ReceiveFrames(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+{
+	uint8_t TotalFramesIN = (RNDISInterfaceInfo->Config.TotalExtraFramesIN + 1);
+
+	Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataOUTEndpointNumber);
+
+	while (Endpoint_IsOUTReceived() && (RNDISInterfaceInfo->State.FrameINCount < TotalFramesIN))
 	{
 		RNDIS_Packet_Message_t RNDISPacketHeader;
 
-		Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataOUTEndpointNumber);
+		/* Discard zero length and single byte packets, sent by the host to terminate transfers which are a multiple
+		   of the endpoint size - packets are aligned so that the start of a message cannot be split across packets */
+		if (Endpoint_BytesInEndpoint() < sizeof(RNDIS_Message_Header_t))
+		{
+			Endpoint_ClearOUT();
+			continue;
+		}
+
+		Endpoint_Read_Stream_LE(&RNDISPacketHeader, sizeof(RNDIS_Packet_Message_t), NO_STREAM_CALLBACK);
 
-		if (Endpoint_IsOUTReceived() && !(RNDISInterfaceInfo->State.FrameIN.FrameInBuffer))
+		if (RNDISPacketHeader.DataLength > ETHERNET_FRAME_SIZE_MAX)
 		{
-			Endpoint_Read_Stream_LE(&RNDISPacketHeader, sizeof(RNDIS_Packet_Message_t), NO_STREAM_CALLBACK);
+			Endpoint_StallTransaction();
+			return;
+		}
+
+		Ethernet_Frame_Info_t* FrameIN = RNDIS_Device_GetFrameIN(RNDISInterfaceInfo, RNDISInterfaceInfo->State.FrameINHead);
+
+		Endpoint_Read_Stream_LE(FrameIN->FrameData, RNDISPacketHeader.DataLength, NO_STREAM_CALLBACK);
+
+		if (RNDISInterfaceInfo->Config.MaxPacketsPerTransfer > 1)
+		{
+			uint32_t PacketLength  = (sizeof(RNDIS_Packet_Message_t) + RNDISPacketHeader.DataLength);
+			uint32_t PaddingLength = 0;
+
+			if (RNDISPacketHeader.MessageLength > PacketLength)
+			  PaddingLength = (RNDISPacketHeader.MessageLength - PacketLength);
 
-			if (RNDISPacketHeader.DataLength > ETHERNET_FRAME_SIZE_MAX)
+			/* Skip the alignment padding after the packet data, leaving any following packets in the endpoint bank */
+			if (PaddingLength > Endpoint_BytesInEndpoint())
 			{
-				Endpoint_StallTransaction();
-				return;
+				Endpoint_ClearOUT();
 			}
-			
-			Endpoint_Read_Stream_LE(RNDISInterfaceInfo->State.FrameIN.FrameData, RNDISPacketHeader.DataLength, NO_STREAM_CALLBACK);
-
-			Endpoint_ClearOUT();
-			
-			RNDISInterfaceInfo->State.FrameIN.FrameLength = RNDISPacketHeader.DataLength;
+			else
+			{
+				if (PaddingLength)
+				  Endpoint_Discard_Stream(PaddingLength, NO_STREAM_CALLBACK);
 
-			RNDISInterfaceInfo->State.FrameIN.FrameInBuffer = true;
+				if (!(Endpoint_BytesInEndpoint()))
+				  Endpoint_ClearOUT();
+			}
 		}
-		
-		Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataINEndpointNumber);
-		
-		if (Endpoint_IsINReady() && RNDISInterfaceInfo->State.FrameOUT.FrameInBuffer)
+		else
 		{
-			memset(&RNDISPacketHeader, 0, sizeof(RNDIS_Packet_Message_t));
+			Endpoint_ClearOUT();
+		}
 
-			RNDISPacketHeader.MessageType   = REMOTE_NDIS_PACKET_MSG;
-			RNDISPacketHeader.MessageLength = (sizeof(RNDIS_Packet_Message_t) + RNDISInterfaceInfo->State.FrameOUT.FrameLength);
-			RNDISPacketHeader.DataOffset    = (sizeof(RNDIS_Packet_Message_t) - sizeof(RNDIS_Message_Header_t));
-			RNDISPacketHeader.DataLength    = RNDISInterfaceInfo->State.FrameOUT.FrameLength;
+		FrameIN->FrameLength   = RNDISPacketHeader.DataLength;
+		FrameIN->FrameInBuffer = true;
 
-			Endpoint_Write_Stream_LE(&RNDISPacketHeader, sizeof(RNDIS_Packet_Message_t), NO_STREAM_CALLBACK);
-			Endpoint_Write_Stream_LE(RNDISInterfaceInfo->State.FrameOUT.FrameData, RNDISPacketHeader.DataLength, NO_STREAM_CALLBACK);
-			Endpoint_ClearIN();
-			
-			RNDISInterfaceInfo->State.FrameOUT.FrameInBuffer = false;
-		}
+		if (++RNDISInterfaceInfo->State.FrameINHead == TotalFramesIN)
+		  RNDISInterfaceInfo->State.FrameINHead = 0;
+
+		RNDISInterfaceInfo->State.FrameINCount++;
 	}
-}							
+}
+
+static void RNDIS_Device_SendFrames(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+{
+	uint8_t  TotalFramesOUT = (RNDISInterfaceInfo->Config.TotalExtraFramesOUT + 1);
+	uint8_t  PacketsRem     = RNDISInterfaceInfo->Config.MaxPacketsPerTransfer;
+	uint32_t BytesRem       = RNDISInterfaceInfo->State.HostMaxTransferSize;
+	bool     FirstPacket    = true;
+
+	Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataINEndpointNumber);
+
+	if (!(Endpoint_IsINReady()) || !(RNDISInterfaceInfo->State.FrameOUTCount))
+	  return;
+
+	do
+	{
+		Ethernet_Frame_Info_t* FrameOUT = RNDIS_Device_GetFrameOUT(RNDISInterfaceInfo, RNDISInterfaceInfo->State.FrameOUTTail);
+		RNDIS_Packet_Message_t RNDISPacketHeader;
+
+		memset(&RNDISPacketHeader, 0, sizeof(RNDIS_Packet_Message_t));
+
+		RNDISPacketHeader.MessageType   = REMOTE_NDIS_PACKET_MSG;
+		RNDISPacketHeader.MessageLength = (sizeof(RNDIS_Packet_Message_t) + FrameOUT->FrameLength);
+		RNDISPacketHeader.DataOffset    = (sizeof(RNDIS_Packet_Message_t) - sizeof(RNDIS_Message_Header_t));
+		RNDISPacketHeader.DataLength    = FrameOUT->FrameLength;
+
+		/* Only combine further packets into the transfer while they fit within the host's maximum transfer size */
+		if (!(FirstPacket) && (RNDISPacketHeader.MessageLength > BytesRem))
+		  break;
+
+		USB_StreamSegment_t PacketSegments[] =
+			{
+				{.Buffer = &RNDISPacketHeader, .Length = sizeof(RNDIS_Packet_Message_t), .MemorySpace = STREAMSEGMENT_RAM},
+				{.Buffer = FrameOUT->FrameData, .Length = RNDISPacketHeader.DataLength, .MemorySpace = STREAMSEGMENT_RAM},
+			};
+
+		Endpoint_Write_StreamV(PacketSegments, (sizeof(PacketSegments) / sizeof(PacketSegments[0])), NO_STREAM_CALLBACK);
+
+		BytesRem    = (RNDISPacketHeader.MessageLength < BytesRem) ? (BytesRem - RNDISPacketHeader.MessageLength) : 0;
+		FirstPacket = false;
+
+		FrameOUT->FrameInBuffer = false;
+
+		if (++RNDISInterfaceInfo->State.FrameOUTTail == TotalFramesOUT)
+		  RNDISInterfaceInfo->State.FrameOUTTail = 0;
+
+		RNDISInterfaceInfo->State.FrameOUTCount--;
+	}
+	while (RNDISInterfaceInfo->State.FrameOUTCount && (PacketsRem-- > 1));
+
+	Endpoint_ClearIN();
+}
 
 void RNDIS_Device_ProcessRNDISControlMessage(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
 {
@@ -228,6 +387,12 @@ void RNDIS_Device_ProcessRNDISControlMessage(USB_ClassInfo_RNDIS_Device_t* const
 			               (RNDIS_Initialize_Message_t*)&RNDISInterfaceInfo->State.RNDISMessageBuffer;
 			RNDIS_Initialize_Complete_t* INITIALIZE_Response =
 			               (RNDIS_Initialize_Complete_t*)&RNDISInterfaceInfo->State.RNDISMessageBuffer;
+			uint8_t                      PacketsPerTransfer  = RNDISInterfaceInfo->Config.MaxPacketsPerTransfer;
+
+			if (!(PacketsPerTransfer))
+			  PacketsPerTransfer = 1;
+
+			RNDISInterfaceInfo->State.HostMaxTransferSize = INITIALIZE_Message->MaxTransferSize;
 			
 			INITIALIZE_Response->MessageType           = REMOTE_NDIS_INITIALIZE_CMPLT;
 			INITIALIZE_Response->MessageLength         = sizeof(RNDIS_Initialize_Complete_t);
@@ -238,9 +403,16 @@ void RNDIS_Device_ProcessRNDISControlMessage(USB_ClassInfo_RNDIS_Device_t* const
 			INITIALIZE_Response->MinorVersion          = REMOTE_NDIS_VERSION_MINOR;			
 			INITIALIZE_Response->DeviceFlags           = REMOTE_NDIS_DF_CONNECTIONLESS;
 			INITIALIZE_Response->Medium                = REMOTE_NDIS_MEDIUM_802_3;
-			INITIALIZE_Response->MaxPacketsPerTransfer = 1;
-			INITIALIZE_Response->MaxTransferSize       = (sizeof(RNDIS_Packet_Message_t) + ETHERNET_FRAME_SIZE_MAX);
-			INITIALIZE_Response->PacketAlignmentFactor = 0;
+			INITIALIZE_Response->MaxPacketsPerTransfer = PacketsPerTransfer;
+			
+			/* Request 8-byte aligned packets when several may be combined, so that packet headers never straddle endpoint banks */
+			INITIALIZE_Response->PacketAlignmentFactor = ((PacketsPerTransfer > 1) ? 3 : 0);
+
+			/* Each combined packet may be followed by up to (2^PacketAlignmentFactor - 1) bytes of padding */
+			uint16_t MaxPacketSize = (sizeof(RNDIS_Packet_Message_t) + ETHERNET_FRAME_SIZE_MAX);
+			uint8_t  AlignmentMask = ((1 << INITIALIZE_Response->PacketAlignmentFactor) - 1);
+
+			INITIALIZE_Response->MaxTransferSize       = (PacketsPerTransfer * ((MaxPacketSize + AlignmentMask) & ~AlignmentMask));
 			INITIALIZE_Response->AFListOffset          = 0;
 			INITIALIZE_Response->AFListSize            = 0;
 			
@@ -315,6 +487,8 @@ void RNDIS_Device_ProcessRNDISControlMessage(USB_ClassInfo_RNDIS_Device_t* const
 			RESET_Response->Status          = REMOTE_NDIS_STATUS_SUCCESS;
 			RESET_Response->AddressingReset = 0;
 
+			RNDIS_Device_ResetFrameQueues(RNDISInterfaceInfo);
+
 			break;
 		case REMOTE_NDIS_KEEPALIVE_MSG:
 			RNDISInterfaceInfo->State.ResponseReady = true;
@@ -376,10 +550,17 @@ static bool RNDIS_Device_ProcessNDISQuery(USB_ClassInfo_RNDIS_Device_t* const RN
 			
 			return true;
 		case OID_GEN_MAXIMUM_FRAME_SIZE:
+			*ResponseSize = sizeof(uint32_t);
+			
+			/* Indicate the largest frame payload, excluding the 14 byte Ethernet header, which fits into a frame slot */
+			*((uint32_t*)ResponseData) = (ETHERNET_FRAME_SIZE_MAX - 14);
+			
+			return true;
 		case OID_GEN_TRANSMIT_BLOCK_SIZE:
 		case OID_GEN_RECEIVE_BLOCK_SIZE:
 			*ResponseSize = sizeof(uint32_t);
 			
+			/* Indicate that each queued frame occupies a single frame slot */
 			*((uint32_t*)ResponseData) = ETHERNET_FRAME_SIZE_MAX;
 			
 			return true;
@@ -439,8 +620,8 @@ static bool RNDIS_Device_ProcessNDISQuery(USB_ClassInfo_RNDIS_Device_t* const RN
 		case OID_GEN_MAXIMUM_TOTAL_SIZE:
 			*ResponseSize = sizeof(uint32_t);
 			
-			/* Indicate maximum overall buffer (Ethernet frame and RNDIS header) the adapter can handle */
-			*((uint32_t*)ResponseData) = (RNDIS_MESSAGE_BUFFER_SIZE + ETHERNET_FRAME_SIZE_MAX);
+			/* Indicate maximum overall frame size (Ethernet header and payload) the adapter can handle */
+			*((uint32_t*)ResponseData) = ETHERNET_FRAME_SIZE_MAX;
 		
 			return true;
 		default:
@@ -38,6 +38,22 @@
  *  \section Module Description
  *  Device Mode USB Class driver framework interface, for the RNDIS USB Class driver.
  *
+ *  \section Sec_RNDISDeviceFrameQueues Frame Queues
+ *  By default the driver holds a single received Ethernet frame (\c State.FrameIN) and a single frame to send
+ *  (\c State.FrameOUT), and the application exchanges frames with the driver by polling and setting each frame's
+ *  \c FrameInBuffer flag directly. In this mode no new frame is accepted from the host until the application has
+ *  processed the last one, limiting the interface to a single frame per pass of the main program loop.
+ *
+ *  To allow several frames to be buffered in each direction, the application may supply arrays of additional frame
+ *  slots via the \c ExtraFramesIN and \c ExtraFramesOUT configuration elements, which are used together with the
+ *  frames in the interface state as first-in, first-out frame queues. When extra frame slots are configured, frames
+ *  must be exchanged with the driver via \ref RNDIS_Device_GetReceivedFrame() and \ref RNDIS_Device_GetFrameToSend()
+ *  rather than through the state frames directly; the \c FrameInBuffer flag is still used to hand each frame back
+ *  to the driver once it has been processed or filled.
+ *
+ *  The \c MaxPacketsPerTransfer configuration element additionally allows several RNDIS data packets to be combined
+ *  into a single USB bulk transfer in each direction, reducing per-frame transfer overhead when the host supports it.
+ *
  *  @{
  */
 
@@ -86,6 +102,19 @@
 					
 					char*         AdapterVendorDescription; /**< String description of the adapter vendor */
 					MAC_Address_t AdapterMACAddress; /**< MAC address of the adapter */
+
+					Ethernet_Frame_Info_t* ExtraFramesIN; /**< Optional array of additional frame slots used to queue frames
+					                                       *   received from the host, or NULL to only use \c State.FrameIN
+					                                       */
+					uint8_t                TotalExtraFramesIN; /**< Number of frame slots in the \c ExtraFramesIN array */
+					Ethernet_Frame_Info_t* ExtraFramesOUT; /**< Optional array of additional frame slots used to queue frames
+					                                        *   to send to the host, or NULL to only use \c State.FrameOUT
+					                                        */
+					uint8_t                TotalExtraFramesOUT; /**< Number of frame slots in the \c ExtraFramesOUT array */
+					uint8_t                MaxPacketsPerTransfer; /**< Maximum number of RNDIS data packets which may be combined
+					                                               *   into a single bulk transfer in each direction, or zero for
+					                                               *   one packet per transfer
+					                                               */
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */
@@ -103,6 +132,13 @@
 					Ethernet_Frame_Info_t FrameOUT; /**< Structure holding the next Ethernet frame to send to the host, populated by the
 													 *   user application
 													 */
+					uint8_t  FrameINHead; /**< Index of the next received frame slot to be filled, used internally by the class driver */
+					uint8_t  FrameINTail; /**< Index of the oldest received frame slot, used internally by the class driver */
+					uint8_t  FrameINCount; /**< Number of received frames queued for the user application, used internally by the class driver */
+					uint8_t  FrameOUTHead; /**< Index of the next frame slot to be filled by the user, used internally by the class driver */
+					uint8_t  FrameOUTTail; /**< Index of the oldest frame slot waiting to be sent, used internally by the class driver */
+					uint8_t  FrameOUTCount; /**< Number of frames queued for sending to the host, used internally by the class driver */
+					uint32_t HostMaxTransferSize; /**< Maximum bulk transfer size accepted by the host, used internally by the class driver */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -132,11 +168,45 @@
 			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing a RNDIS Class configuration and state
 			 */
 			void RNDIS_Device_USBTask(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Retrieves the oldest Ethernet frame received from the host which has not yet been processed by the user
+			 *  application. Once the application has finished with the frame, it should clear the frame's \c FrameInBuffer
+			 *  flag to release the frame slot back to the driver; the same frame is returned by each call until this is done.
+			 *
+			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing a RNDIS Class configuration and state
+			 *
+			 *  \return Pointer to the oldest received frame, or NULL if no frames are waiting to be processed
+			 */
+			Ethernet_Frame_Info_t* RNDIS_Device_GetReceivedFrame(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+			                                                     ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Retrieves a free frame slot which the user application may fill with an Ethernet frame to send to the host.
+			 *  Once filled, the application should set the frame's \c FrameLength element and then set its \c FrameInBuffer
+			 *  flag to queue the frame for sending; the same free frame slot is returned by each call until this is done.
+			 *
+			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing a RNDIS Class configuration and state
+			 *
+			 *  \return Pointer to a free frame slot, or NULL if all frame slots are waiting to be sent
+			 */
+			Ethernet_Frame_Info_t* RNDIS_Device_GetFrameToSend(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+			                                                   ATTR_NON_NULL_PTR_ARG(1);
 		
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
 		/* Function Prototypes: */
 		#if defined(__INCLUDE_FROM_RNDIS_CLASS_DEVICE_C)
+			static Ethernet_Frame_Info_t* RNDIS_Device_GetFrameIN(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+			                                                      const uint8_t Index) ATTR_NON_NULL_PTR_ARG(1);
+			static Ethernet_Frame_Info_t* RNDIS_Device_GetFrameOUT(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+			                                                       const uint8_t Index) ATTR_NON_NULL_PTR_ARG(1);
+			static void RNDIS_Device_ResetFrameQueues(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+			                                          ATTR_NON_NULL_PTR_ARG(1);
+			static void RNDIS_Device_UpdateFrameQueues(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+			                                           ATTR_NON_NULL_PTR_ARG(1);
+			static void RNDIS_Device_ReceiveFrames(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+			                                       ATTR_NON_NULL_PTR_ARG(1);
+			static void RNDIS_Device_SendFrames(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+			                                    ATTR_NON_NULL_PTR_ARG(1);
 			static void RNDIS_Device_ProcessRNDISControlMessage(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
 			                                                    ATTR_NON_NULL_PTR_ARG(1);
 			static bool RNDIS_Device_ProcessNDISQuery(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo, 
@@ -39,163 +39,89 @@
 uint8_t CDC_Host_ConfigurePipes(USB_ClassInfo_CDC_Host_t* const CDCInterfaceInfo, uint16_t ConfigDescriptorSize,
                                 void* ConfigDescriptorData)
 {
-	uint8_t FoundEndpoints = 0;
+	USB_ConfigIndex_t ConfigIndex;
+	uint8_t           ErrorCode;
 
-	memset(&CDCInterfaceInfo->State, 0x00, sizeof(CDCInterfaceInfo->State));
-
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
-	  return CDC_ENUMERROR_InvalidConfigDescriptor;
-	
-	if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-	                              DComp_CDC_Host_NextCDCControlInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+	if (USB_IndexConfigDescriptor(&ConfigIndex, ConfigDescriptorSize, ConfigDescriptorData) == INDEX_CONFIG_InvalidConfigDescriptor)
 	{
-		return CDC_ENUMERROR_NoCDCInterfaceFound;
+		memset(&CDCInterfaceInfo->State, 0x00, sizeof(CDCInterfaceInfo->State));
+		return CDC_ENUMERROR_InvalidConfigDescriptor;
 	}
-	
-	CDCInterfaceInfo->State.ControlInterfaceNumber = DESCRIPTOR_CAST(ConfigDescriptorData, USB_Descriptor_Interface_t).InterfaceNumber;
 
-	while (FoundEndpoints != (CDC_FOUND_NOTIFICATION_IN | CDC_FOUND_DATAPIPE_IN | CDC_FOUND_DATAPIPE_OUT))
-	{
-		if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DComp_CDC_Host_NextCDCInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
-		{
-			if (FoundEndpoints & CDC_FOUND_NOTIFICATION_IN)
-			{
-				if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData, 
-				                              DComp_CDC_Host_NextCDCDataInterface) != DESCRIPTOR_SEARCH_COMP_Found)
-				{
-					return CDC_ENUMERROR_NoCDCInterfaceFound;
-				}
-			}
-			else
-			{
-				FoundEndpoints = 0;
-
-				Pipe_SelectPipe(CDCInterfaceInfo->Config.DataINPipeNumber);
-				Pipe_DisablePipe();
-				Pipe_SelectPipe(CDCInterfaceInfo->Config.DataOUTPipeNumber);
-				Pipe_DisablePipe();
-				Pipe_SelectPipe(CDCInterfaceInfo->Config.NotificationPipeNumber);
-				Pipe_DisablePipe();
-			
-				if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-				                              DComp_CDC_Host_NextCDCControlInterface) != DESCRIPTOR_SEARCH_COMP_Found)
-				{
-					return CDC_ENUMERROR_NoCDCInterfaceFound;
-				}
-			}
-
-			if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-			                              DComp_CDC_Host_NextCDCInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
-			{
-				return CDC_ENUMERROR_EndpointsNotFound;
-			}
-		}
-		
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
-
-		if ((EndpointData->Attributes & EP_TYPE_MASK) == EP_TYPE_INTERRUPT)
-		{
-			if (EndpointData->EndpointAddress & ENDPOINT_DESCRIPTOR_DIR_IN)
-			{
-				Pipe_ConfigurePipe(CDCInterfaceInfo->Config.NotificationPipeNumber, EP_TYPE_INTERRUPT, PIPE_TOKEN_IN,
-								   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-								   CDCInterfaceInfo->Config.NotificationPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-				CDCInterfaceInfo->State.NotificationPipeSize = EndpointData->EndpointSize;
-
-				Pipe_SetInterruptPeriod(EndpointData->PollingIntervalMS);
-				
-				FoundEndpoints |= CDC_FOUND_NOTIFICATION_IN;
-			}
-		}
-		else
-		{
-			if (EndpointData->EndpointAddress & ENDPOINT_DESCRIPTOR_DIR_IN)
-			{
-				Pipe_ConfigurePipe(CDCInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
-				                   EndpointData->EndpointAddress, EndpointData->EndpointSize, 
-				                   CDCInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-
-				CDCInterfaceInfo->State.DataINPipeSize = EndpointData->EndpointSize;
-
-				FoundEndpoints |= CDC_FOUND_DATAPIPE_IN;
-			}
-			else
-			{
-				Pipe_ConfigurePipe(CDCInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
-								   EndpointData->EndpointAddress, EndpointData->EndpointSize, 
-								   CDCInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-			
-				CDCInterfaceInfo->State.DataOUTPipeSize = EndpointData->EndpointSize;
-				
-				FoundEndpoints |= CDC_FOUND_DATAPIPE_OUT;
-			}
-		}
-	}
+	/* Descriptors with more interfaces or endpoints than the index holds are searched a window at a time */
+	while (((ErrorCode = CDC_Host_ConfigurePipesIndexed(CDCInterfaceInfo, &ConfigIndex)) != CDC_ENUMERROR_NoError) &&
+	       USB_IndexNextConfigWindow(&ConfigIndex, ConfigDescriptorSize, ConfigDescriptorData));
 
-	CDCInterfaceInfo->State.ControlLineStates.HostToDevice = (CDC_CONTROL_LINE_OUT_RTS | CDC_CONTROL_LINE_OUT_DTR);
-	CDCInterfaceInfo->State.ControlLineStates.DeviceToHost = (CDC_CONTROL_LINE_IN_DCD  | CDC_CONTROL_LINE_IN_DSR);
-	CDCInterfaceInfo->State.IsActive = true;
-	return CDC_ENUMERROR_NoError;
+	return ErrorCode;
 }
 
-static uint8_t DComp_CDC_Host_NextCDCControlInterface(void* const CurrentDescriptor)
+uint8_t CDC_Host_ConfigurePipesIndexed(USB_ClassInfo_CDC_Host_t* const CDCInterfaceInfo,
+                                       const USB_ConfigIndex_t* const ConfigIndex)
 {
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		USB_Descriptor_Interface_t* CurrentInterface = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                                USB_Descriptor_Interface_t);
-	
-		if ((CurrentInterface->Class    == CDC_CONTROL_CLASS)    &&
-		    (CurrentInterface->SubClass == CDC_CONTROL_SUBCLASS) &&
-			(CurrentInterface->Protocol == CDC_CONTROL_PROTOCOL))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
-	}
-	
-	return DESCRIPTOR_SEARCH_NotFound;
-}
+	USB_Descriptor_Endpoint_t* NotificationEndpoint;
+	USB_Descriptor_Endpoint_t* DataINEndpoint;
+	USB_Descriptor_Endpoint_t* DataOUTEndpoint;
+	uint8_t                    ControlInterface = 0;
+	uint8_t                    DataInterface;
 
-static uint8_t DComp_CDC_Host_NextCDCDataInterface(void* const CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		USB_Descriptor_Interface_t* CurrentInterface = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                                USB_Descriptor_Interface_t);
-	
-		if ((CurrentInterface->Class    == CDC_DATA_CLASS)    &&
-		    (CurrentInterface->SubClass == CDC_DATA_SUBCLASS) &&
-			(CurrentInterface->Protocol == CDC_DATA_PROTOCOL))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
-	}
-	
-	return DESCRIPTOR_SEARCH_NotFound;
-}
+	memset(&CDCInterfaceInfo->State, 0x00, sizeof(CDCInterfaceInfo->State));
 
-static uint8_t DComp_CDC_Host_NextCDCInterfaceEndpoint(void* const CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Endpoint)
+	for (;;)
 	{
-		USB_Descriptor_Endpoint_t* CurrentEndpoint = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                              USB_Descriptor_Endpoint_t);
-	
-		uint8_t EndpointType = (CurrentEndpoint->Attributes & EP_TYPE_MASK);
-	
-		if (((EndpointType == EP_TYPE_BULK) || (EndpointType == EP_TYPE_INTERRUPT)) &&
-		    !(Pipe_IsEndpointBound(CurrentEndpoint->EndpointAddress)))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
+		ControlInterface = USB_GetIndexedInterface(ConfigIndex, ControlInterface, CDC_CONTROL_CLASS, CDC_CONTROL_SUBCLASS,
+		                                           CDC_CONTROL_PROTOCOL, INDEX_MATCH_ALL);
+
+		if (ControlInterface == INDEX_NO_INTERFACE)
+		  return CDC_ENUMERROR_NoCDCInterfaceFound;
+		
+		NotificationEndpoint = USB_GetIndexedEndpoint(ConfigIndex, ControlInterface, EP_TYPE_INTERRUPT, ENDPOINT_DESCRIPTOR_DIR_IN);
+		
+		if (NotificationEndpoint != NULL)
+		  break;
+		
+		ControlInterface++;
 	}
-	else if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
+
+	/* Some devices place the bulk data endpoints on the control interface itself rather than a separate data interface */
+	DataInterface   = ControlInterface;
+	DataINEndpoint  = USB_GetIndexedEndpoint(ConfigIndex, ControlInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_IN);
+	DataOUTEndpoint = USB_GetIndexedEndpoint(ConfigIndex, ControlInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_OUT);
+
+	while ((DataINEndpoint == NULL) || (DataOUTEndpoint == NULL))
 	{
-		return DESCRIPTOR_SEARCH_Fail;
+		DataInterface = USB_GetIndexedInterface(ConfigIndex, (DataInterface + 1), CDC_DATA_CLASS, CDC_DATA_SUBCLASS,
+		                                        CDC_DATA_PROTOCOL, INDEX_MATCH_ALL);
+
+		if (DataInterface == INDEX_NO_INTERFACE)
+		  return CDC_ENUMERROR_NoCDCInterfaceFound;
+
+		DataINEndpoint  = USB_GetIndexedEndpoint(ConfigIndex, DataInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_IN);
+		DataOUTEndpoint = USB_GetIndexedEndpoint(ConfigIndex, DataInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_OUT);
 	}
 
-	return DESCRIPTOR_SEARCH_NotFound;
+	CDCInterfaceInfo->State.ControlInterfaceNumber = ConfigIndex->Interfaces[ControlInterface].InterfaceDescriptor->InterfaceNumber;
+
+	Pipe_ConfigurePipe(CDCInterfaceInfo->Config.NotificationPipeNumber, EP_TYPE_INTERRUPT, PIPE_TOKEN_IN,
+	                   NotificationEndpoint->EndpointAddress, NotificationEndpoint->EndpointSize,
+	                   CDCInterfaceInfo->Config.NotificationPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	CDCInterfaceInfo->State.NotificationPipeSize = NotificationEndpoint->EndpointSize;
+
+	Pipe_SetInterruptPeriod(NotificationEndpoint->PollingIntervalMS);
+
+	Pipe_ConfigurePipe(CDCInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
+	                   DataINEndpoint->EndpointAddress, DataINEndpoint->EndpointSize,
+	                   CDCInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	CDCInterfaceInfo->State.DataINPipeSize = DataINEndpoint->EndpointSize;
+
+	Pipe_ConfigurePipe(CDCInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
+	                   DataOUTEndpoint->EndpointAddress, DataOUTEndpoint->EndpointSize,
+	                   CDCInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	CDCInterfaceInfo->State.DataOUTPipeSize = DataOUTEndpoint->EndpointSize;
+
+	CDCInterfaceInfo->State.ControlLineStates.HostToDevice = (CDC_CONTROL_LINE_OUT_RTS | CDC_CONTROL_LINE_OUT_DTR);
+	CDCInterfaceInfo->State.ControlLineStates.DeviceToHost = (CDC_CONTROL_LINE_IN_DCD  | CDC_CONTROL_LINE_IN_DSR);
+	CDCInterfaceInfo->State.IsActive = true;
+	return CDC_ENUMERROR_NoError;
 }
 
 void CDC_Host_USBTask(USB_ClassInfo_CDC_Host_t* const CDCInterfaceInfo)
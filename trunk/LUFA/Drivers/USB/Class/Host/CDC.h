@@ -158,6 +158,23 @@
 			 */
 			uint8_t CDC_Host_ConfigurePipes(USB_ClassInfo_CDC_Host_t* const CDCInterfaceInfo, uint16_t ConfigDescriptorSize,
 			                                void* DeviceConfigDescriptor) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Host interface configuration routine, to configure a given CDC host interface instance using a Configuration
+			 *  Descriptor index built by \ref USB_IndexConfigDescriptor(). This behaves as \ref CDC_Host_ConfigurePipes(), but
+			 *  allows the attached device's Configuration Descriptor to be indexed once and then shared between all the class
+			 *  driver instances which are to bind to the device.
+			 *
+			 *  Only the interfaces within the index's current window are searched. If the index is truncated (see
+			 *  \ref USB_IndexNextConfigWindow()) and no matching interface is found, the caller may index the next window
+			 *  and call this function again.
+			 *
+			 *  \param[in,out] CDCInterfaceInfo  Pointer to a structure containing an CDC Class host configuration and state
+			 *  \param[in] ConfigIndex  Pointer to an index of the attached device's Configuration Descriptor
+			 *
+			 *  \return A value from the \ref CDCHost_EnumerationFailure_ErrorCodes_t enum
+			 */
+			uint8_t CDC_Host_ConfigurePipesIndexed(USB_ClassInfo_CDC_Host_t* const CDCInterfaceInfo,
+			                                       const USB_ConfigIndex_t* const ConfigIndex) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 			
 			/** Sets the line encoding for the attached device's virtual serial port. This should be called when the LineEncoding
 			 *  values of the interface have been changed to push the new settings to the USB device.
@@ -285,10 +302,6 @@
 			#define CDC_DATA_CLASS                  0x0A
 			#define CDC_DATA_SUBCLASS               0x00
 			#define CDC_DATA_PROTOCOL               0x00
-			
-			#define CDC_FOUND_DATAPIPE_IN           (1 << 0)
-			#define CDC_FOUND_DATAPIPE_OUT          (1 << 1)
-			#define CDC_FOUND_NOTIFICATION_IN       (1 << 2)
 
 		/* Function Prototypes: */
 			#if defined(__INCLUDE_FROM_CDC_CLASS_HOST_C)
@@ -299,9 +312,6 @@
 				void CDC_Host_Event_Stub(void);
 				void EVENT_CDC_Host_ControLineStateChanged(USB_ClassInfo_CDC_Host_t* const CDCInterfaceInfo)
 				                                           ATTR_WEAK ATTR_NON_NULL_PTR_ARG(1) ATTR_ALIAS(CDC_Host_Event_Stub);
-				static uint8_t DComp_CDC_Host_NextCDCControlInterface(void* const CurrentDescriptor) ATTR_NON_NULL_PTR_ARG(1);
-				static uint8_t DComp_CDC_Host_NextCDCDataInterface(void* const CurrentDescriptor) ATTR_NON_NULL_PTR_ARG(1);
-				static uint8_t DComp_CDC_Host_NextCDCInterfaceEndpoint(void* const CurrentDescriptor);
 			#endif	
 	#endif
 				
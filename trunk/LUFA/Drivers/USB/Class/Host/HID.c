@@ -39,117 +39,88 @@
 uint8_t HID_Host_ConfigurePipes(USB_ClassInfo_HID_Host_t* const HIDInterfaceInfo, uint16_t ConfigDescriptorSize,
                                 void* ConfigDescriptorData)
 {
-	uint8_t FoundEndpoints = 0;
+	USB_ConfigIndex_t ConfigIndex;
+	uint8_t           ErrorCode;
 
-	memset(&HIDInterfaceInfo->State, 0x00, sizeof(HIDInterfaceInfo->State));
-
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
-	  return HID_ENUMERROR_InvalidConfigDescriptor;
-	
-	USB_Descriptor_Interface_t* CurrentHIDInterface;
-	
-	do
+	if (USB_IndexConfigDescriptor(&ConfigIndex, ConfigDescriptorSize, ConfigDescriptorData) == INDEX_CONFIG_InvalidConfigDescriptor)
 	{
-		if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-									  DComp_HID_Host_NextHIDInterface) != DESCRIPTOR_SEARCH_COMP_Found)
-		{
-			return HID_ENUMERROR_NoHIDInterfaceFound;
-		}
-		
-		CurrentHIDInterface = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Interface_t);
-	} while (HIDInterfaceInfo->Config.HIDInterfaceProtocol &&
-	         (CurrentHIDInterface->Protocol != HIDInterfaceInfo->Config.HIDInterfaceProtocol));
+		memset(&HIDInterfaceInfo->State, 0x00, sizeof(HIDInterfaceInfo->State));
+		return HID_ENUMERROR_InvalidConfigDescriptor;
+	}
 
-	HIDInterfaceInfo->State.InterfaceNumber      = CurrentHIDInterface->InterfaceNumber;
-	HIDInterfaceInfo->State.SupportsBootProtocol = (CurrentHIDInterface->SubClass != HID_NON_BOOT_PROTOCOL);
+	/* Descriptors with more interfaces or endpoints than the index holds are searched a window at a time */
+	while (((ErrorCode = HID_Host_ConfigurePipesIndexed(HIDInterfaceInfo, &ConfigIndex)) != HID_ENUMERROR_NoError) &&
+	       USB_IndexNextConfigWindow(&ConfigIndex, ConfigDescriptorSize, ConfigDescriptorData));
 
-	if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData, DComp_NextHID) != DESCRIPTOR_SEARCH_COMP_Found)
-	{
-		return HID_ENUMERROR_NoHIDDescriptorFound;
-	}
+	return ErrorCode;
+}
 
-	HIDInterfaceInfo->State.HIDReportSize = DESCRIPTOR_CAST(ConfigDescriptorData, USB_HID_Descriptor_t).HIDReportLength;
+uint8_t HID_Host_ConfigurePipesIndexed(USB_ClassInfo_HID_Host_t* const HIDInterfaceInfo,
+                                       const USB_ConfigIndex_t* const ConfigIndex)
+{
+	USB_Descriptor_Endpoint_t* DataINEndpoint;
+	USB_Descriptor_Endpoint_t* DataOUTEndpoint;
+	USB_HID_Descriptor_t*      HIDDescriptor;
+	uint8_t                    HIDInterface = 0;
+	uint8_t                    ErrorCode = HID_ENUMERROR_NoHIDInterfaceFound;
 
-	while (FoundEndpoints != (HID_FOUND_DATAPIPE_IN | HID_FOUND_DATAPIPE_OUT))
+	memset(&HIDInterfaceInfo->State, 0x00, sizeof(HIDInterfaceInfo->State));
+
+	for (;;)
 	{
-		if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DComp_HID_Host_NextHIDInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
-		{
-			if (FoundEndpoints & HID_FOUND_DATAPIPE_IN)
-			  break;
-				
-			return HID_ENUMERROR_EndpointsNotFound;
-		}
-		
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
+		HIDInterface = USB_GetIndexedInterface(ConfigIndex, HIDInterface, HID_INTERFACE_CLASS, 0,
+		                                       HIDInterfaceInfo->Config.HIDInterfaceProtocol,
+		                                       (HIDInterfaceInfo->Config.HIDInterfaceProtocol ?
+		                                        (INDEX_MATCH_CLASS | INDEX_MATCH_PROTOCOL) : INDEX_MATCH_CLASS));
 
-		if (EndpointData->EndpointAddress & ENDPOINT_DESCRIPTOR_DIR_IN)
+		if (HIDInterface == INDEX_NO_INTERFACE)
+		  return ErrorCode;
+
+		HIDDescriptor = USB_GetIndexedDescriptor(ConfigIndex, HIDInterface, DTYPE_HID);
+
+		if (HIDDescriptor == NULL)
 		{
-			Pipe_ConfigurePipe(HIDInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_INTERRUPT, PIPE_TOKEN_IN,
-							   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-							   HIDInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-			HIDInterfaceInfo->State.DataINPipeSize = EndpointData->EndpointSize;
-			
-			FoundEndpoints |= HID_FOUND_DATAPIPE_IN;
+			ErrorCode = HID_ENUMERROR_NoHIDDescriptorFound;
 		}
 		else
 		{
-			Pipe_ConfigurePipe(HIDInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_INTERRUPT, PIPE_TOKEN_OUT,
-							   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-							   HIDInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-			HIDInterfaceInfo->State.DataOUTPipeSize = EndpointData->EndpointSize;
-			
-			HIDInterfaceInfo->State.DeviceUsesOUTPipe = true;
-			
-			FoundEndpoints |= HID_FOUND_DATAPIPE_OUT;		
+			DataINEndpoint = USB_GetIndexedEndpoint(ConfigIndex, HIDInterface, EP_TYPE_INTERRUPT, ENDPOINT_DESCRIPTOR_DIR_IN);
+
+			if (DataINEndpoint != NULL)
+			  break;
+
+			ErrorCode = HID_ENUMERROR_EndpointsNotFound;
 		}
+
+		HIDInterface++;
 	}
 
-	HIDInterfaceInfo->State.LargestReportSize = 8;
-	HIDInterfaceInfo->State.IsActive = true;
-	return HID_ENUMERROR_NoError;
-}
+	USB_Descriptor_Interface_t* HIDInterfaceData = ConfigIndex->Interfaces[HIDInterface].InterfaceDescriptor;
 
-static uint8_t DComp_HID_Host_NextHIDInterface(void* const CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		USB_Descriptor_Interface_t* CurrentInterface = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                                USB_Descriptor_Interface_t);
-	
-		if (CurrentInterface->Class == HID_INTERFACE_CLASS)
-		  return DESCRIPTOR_SEARCH_Found;
-	}
-	
-	return DESCRIPTOR_SEARCH_NotFound;
-}
+	HIDInterfaceInfo->State.InterfaceNumber      = HIDInterfaceData->InterfaceNumber;
+	HIDInterfaceInfo->State.SupportsBootProtocol = (HIDInterfaceData->SubClass != HID_NON_BOOT_PROTOCOL);
+	HIDInterfaceInfo->State.HIDReportSize        = HIDDescriptor->HIDReportLength;
 
-static uint8_t DComp_NextHID(void* const CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_HID)
-	  return DESCRIPTOR_SEARCH_Found;
-	else if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	  return DESCRIPTOR_SEARCH_Fail;
-	else
-	  return DESCRIPTOR_SEARCH_NotFound;	  
-}
+	Pipe_ConfigurePipe(HIDInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_INTERRUPT, PIPE_TOKEN_IN,
+	                   DataINEndpoint->EndpointAddress, DataINEndpoint->EndpointSize,
+	                   HIDInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	HIDInterfaceInfo->State.DataINPipeSize = DataINEndpoint->EndpointSize;
 
-static uint8_t DComp_HID_Host_NextHIDInterfaceEndpoint(void* const CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Endpoint)
-	{
-		USB_Descriptor_Endpoint_t* CurrentEndpoint = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                              USB_Descriptor_Endpoint_t);	
+	DataOUTEndpoint = USB_GetIndexedEndpoint(ConfigIndex, HIDInterface, EP_TYPE_INTERRUPT, ENDPOINT_DESCRIPTOR_DIR_OUT);
 
-		if (!(Pipe_IsEndpointBound(CurrentEndpoint->EndpointAddress)))
-		  return DESCRIPTOR_SEARCH_Found;
-	}
-	else if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
+	if (DataOUTEndpoint != NULL)
 	{
-		return DESCRIPTOR_SEARCH_Fail;
+		Pipe_ConfigurePipe(HIDInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_INTERRUPT, PIPE_TOKEN_OUT,
+		                   DataOUTEndpoint->EndpointAddress, DataOUTEndpoint->EndpointSize,
+		                   HIDInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+		HIDInterfaceInfo->State.DataOUTPipeSize = DataOUTEndpoint->EndpointSize;
+
+		HIDInterfaceInfo->State.DeviceUsesOUTPipe = true;
 	}
 
-	return DESCRIPTOR_SEARCH_NotFound;
+	HIDInterfaceInfo->State.LargestReportSize = 8;
+	HIDInterfaceInfo->State.IsActive = true;
+	return HID_ENUMERROR_NoError;
 }
 
 #if !defined(HID_HOST_BOOT_PROTOCOL_ONLY)
@@ -153,6 +153,23 @@
 			uint8_t HID_Host_ConfigurePipes(USB_ClassInfo_HID_Host_t* const HIDInterfaceInfo, uint16_t ConfigDescriptorSize,
 			                                void* DeviceConfigDescriptor) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
 
+			/** Host interface configuration routine, to configure a given HID host interface instance using a Configuration
+			 *  Descriptor index built by \ref USB_IndexConfigDescriptor(). This behaves as \ref HID_Host_ConfigurePipes(), but
+			 *  allows the attached device's Configuration Descriptor to be indexed once and then shared between all the class
+			 *  driver instances which are to bind to the device.
+			 *
+			 *  Only the interfaces within the index's current window are searched. If the index is truncated (see
+			 *  \ref USB_IndexNextConfigWindow()) and no matching interface is found, the caller may index the next window
+			 *  and call this function again.
+			 *
+			 *  \param[in,out] HIDInterfaceInfo  Pointer to a structure containing a HID Class host configuration and state
+			 *  \param[in] ConfigIndex  Pointer to an index of the attached device's Configuration Descriptor
+			 *
+			 *  \return A value from the \ref HIDHost_EnumerationFailure_ErrorCodes_t enum
+			 */
+			uint8_t HID_Host_ConfigurePipesIndexed(USB_ClassInfo_HID_Host_t* const HIDInterfaceInfo,
+			                                       const USB_ConfigIndex_t* const ConfigIndex) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
 
 			/** Receives a HID IN report from the attached HID device, when a report has been received on the HID IN Data pipe.
 			 *  
@@ -276,15 +293,6 @@
 		/* Macros: */
 			#define HID_INTERFACE_CLASS             0x03
 			
-			#define HID_FOUND_DATAPIPE_IN           (1 << 0)
-			#define HID_FOUND_DATAPIPE_OUT          (1 << 1)
-
-		/* Function Prototypes: */
-			#if defined(__INCLUDE_FROM_HID_CLASS_HOST_C)
-				static uint8_t DComp_HID_Host_NextHIDInterface(void* const CurrentDescriptor) ATTR_NON_NULL_PTR_ARG(1);
-				static uint8_t DComp_NextHID(void* const CurrentDescriptor) ATTR_NON_NULL_PTR_ARG(1);
-				static uint8_t DComp_HID_Host_NextHIDInterfaceEndpoint(void* const CurrentDescriptor) ATTR_NON_NULL_PTR_ARG(1);
-			#endif	
 	#endif	
 	
 	/* Disable C linkage for C++ Compilers: */
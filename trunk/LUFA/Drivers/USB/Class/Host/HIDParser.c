@@ -32,28 +32,108 @@
 #include "../../HighLevel/USBMode.h"
 #if defined(USB_CAN_BE_HOST)
 
+#define  __INCLUDE_FROM_HIDPARSER_C
 #include "HIDParser.h"
 
+/** Number of bytes used to store an attribute field of a compact report item, indexed by the field's 2-bit size code. */
+static const uint8_t HID_Parser_FieldSizes[4] = {0, 1, 2, 4};
+
 uint8_t USB_ProcessHIDReport(const uint8_t* ReportData, uint16_t ReportSize, HID_ReportInfo_t* const ParserData)
+{
+	HID_ParserContext_t Context;
+	uint8_t             ErrorCode;
+
+	memset(ParserData, 0x00, sizeof(HID_ReportInfo_t));
+	memset(&Context,   0x00, sizeof(HID_ParserContext_t));
+
+	Context.ParserData    = ParserData;
+	Context.ReportIDSizes = ParserData->ReportIDSizes;
+
+	ErrorCode = HID_Parser_ParseDescriptor(ReportData, ReportSize, &Context);
+
+	ParserData->TotalDeviceReports    = Context.TotalDeviceReports;
+	ParserData->LargestReportSizeBits = Context.LargestReportSizeBits;
+	ParserData->UsingReportIDs        = Context.UsingReportIDs;
+
+	return ErrorCode;
+}
+
+uint8_t USB_ProcessHIDReportCompact(const uint8_t* ReportData, uint16_t ReportSize, HID_CompactReportInfo_t* const ParserData,
+                                    void* Arena, const uint16_t ArenaSize)
+{
+	HID_ParserContext_t Context;
+	uint8_t             ErrorCode;
+
+	memset(ParserData, 0x00, sizeof(HID_CompactReportInfo_t));
+	memset(&Context,   0x00, sizeof(HID_ParserContext_t));
+
+	/* First pass measures the descriptor, so that the item, collection and attribute regions can be laid out */
+	Context.CompactParserData = ParserData;
+	Context.ReportIDSizes     = ParserData->ReportIDSizes;
+	Context.Measuring         = true;
+
+	if ((ErrorCode = HID_Parser_ParseDescriptor(ReportData, ReportSize, &Context)) != HID_PARSE_Successful)
+	  return ErrorCode;
+
+	uint32_t CollectionsOffset = ((uint32_t)Context.TotalReportItems * sizeof(HID_CompactReportItem_t));
+	uint32_t AttributesOffset  = (CollectionsOffset + ((uint32_t)Context.TotalCollections * sizeof(HID_CompactCollection_t)));
+	uint32_t RequiredArenaSize = (AttributesOffset + Context.AttributesSize);
+
+	if (RequiredArenaSize > 0xFFFF)
+	  return HID_PARSE_InsufficientArena;
+
+	ParserData->RequiredArenaSize = RequiredArenaSize;
+
+	if (Arena == NULL)
+	  return HID_PARSE_Successful;
+	else if (ArenaSize < RequiredArenaSize)
+	  return HID_PARSE_InsufficientArena;
+
+	/* Second pass stores the descriptor's contents into the arena */
+	memset(&Context, 0x00, sizeof(HID_ParserContext_t));
+
+	Context.CompactParserData = ParserData;
+	Context.ReportIDSizes     = ParserData->ReportIDSizes;
+	Context.Arena             = (uint8_t*)Arena;
+	Context.CollectionsOffset = CollectionsOffset;
+	Context.AttributesOffset  = AttributesOffset;
+
+	ParserData->Arena       = (uint8_t*)Arena;
+	ParserData->ReportItems = (HID_CompactReportItem_t*)Arena;
+	ParserData->Collections = (HID_CompactCollection_t*)&Context.Arena[CollectionsOffset];
+
+	ErrorCode = HID_Parser_ParseDescriptor(ReportData, ReportSize, &Context);
+
+	ParserData->TotalReportItems      = Context.TotalReportItems;
+	ParserData->TotalCollections      = Context.TotalCollections;
+	ParserData->TotalDeviceReports    = Context.TotalDeviceReports;
+	ParserData->LargestReportSizeBits = Context.LargestReportSizeBits;
+	ParserData->UsingReportIDs        = Context.UsingReportIDs;
+
+	return ErrorCode;
+}
+
+static uint8_t HID_Parser_ParseDescriptor(const uint8_t* ReportData, uint16_t ReportSize, HID_ParserContext_t* const Context)
 {
 	HID_StateTable_t      StateTable[HID_STATETABLE_STACK_DEPTH];
 	HID_StateTable_t*     CurrStateTable          = &StateTable[0];
 	HID_CollectionPath_t* CurrCollectionPath      = NULL;
-	HID_ReportSizeInfo_t* CurrReportIDInfo        = &ParserData->ReportIDSizes[0];			
+	HID_ReportSizeInfo_t* CurrReportIDInfo        = &Context->ReportIDSizes[0];			
 	uint16_t              UsageList[HID_USAGE_STACK_DEPTH];
 	uint8_t               UsageListSize           = 0;
 	HID_MinMax_t          UsageMinMax             = {0, 0};
+	uint8_t               ErrorCode;
 
-	memset(ParserData,       0x00, sizeof(HID_ReportInfo_t));
 	memset(CurrStateTable,   0x00, sizeof(HID_StateTable_t));
 	memset(CurrReportIDInfo, 0x00, sizeof(HID_ReportSizeInfo_t));
 
-	ParserData->TotalDeviceReports = 1;	
+	Context->TotalDeviceReports = 1;	
 
 	while (ReportSize)
 	{
-		uint8_t  HIDReportItem  = *ReportData;
-		uint32_t ReportItemData = 0;
+		uint8_t  HIDReportItem        = *ReportData;
+		uint32_t ReportItemData       = 0;
+		int32_t  ReportItemSignedData = 0;
 		
 		ReportData++;
 		ReportSize--;
@@ -61,19 +141,22 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData, uint16_t ReportSize, HID
 		switch (HIDReportItem & DATA_SIZE_MASK)
 		{
 			case DATA_SIZE_4:
-				ReportItemData  = *((uint32_t*)ReportData);
-				ReportSize     -= 4;
-				ReportData     += 4;
+				ReportItemData        = *((uint32_t*)ReportData);
+				ReportItemSignedData  = *((int32_t*)ReportData);
+				ReportSize           -= 4;
+				ReportData           += 4;
 				break;
 			case DATA_SIZE_2:
-				ReportItemData  = *((uint16_t*)ReportData);
-				ReportSize     -= 2;
-				ReportData     += 2;
+				ReportItemData        = *((uint16_t*)ReportData);
+				ReportItemSignedData  = *((int16_t*)ReportData);
+				ReportSize           -= 2;
+				ReportData           += 2;
 				break;
 			case DATA_SIZE_1:
-				ReportItemData  = *((uint8_t*)ReportData);
-				ReportSize     -= 1;
-				ReportData     += 1;
+				ReportItemData        = *((uint8_t*)ReportData);
+				ReportItemSignedData  = *((int8_t*)ReportData);
+				ReportSize           -= 1;
+				ReportData           += 1;
 				break;
 		}
 
@@ -85,7 +168,7 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData, uint16_t ReportSize, HID
 	
 				memcpy((CurrStateTable + 1),
 				       CurrStateTable,
-				       sizeof(HID_ReportItem_t));
+				       sizeof(HID_StateTable_t));
 
 				CurrStateTable++;
 				break;
@@ -99,16 +182,16 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData, uint16_t ReportSize, HID
 				CurrStateTable->Attributes.Usage.Page       = ReportItemData;
 				break;
 			case (TYPE_GLOBAL | TAG_GLOBAL_LOGICALMIN):
-				CurrStateTable->Attributes.Logical.Minimum  = ReportItemData;
+				CurrStateTable->Attributes.Logical.Minimum  = ReportItemSignedData;
 				break;
 			case (TYPE_GLOBAL | TAG_GLOBAL_LOGICALMAX):
-				CurrStateTable->Attributes.Logical.Maximum  = ReportItemData;
+				CurrStateTable->Attributes.Logical.Maximum  = ReportItemSignedData;
 				break;
 			case (TYPE_GLOBAL | TAG_GLOBAL_PHYSMIN):
-				CurrStateTable->Attributes.Physical.Minimum = ReportItemData;
+				CurrStateTable->Attributes.Physical.Minimum = ReportItemSignedData;
 				break;
 			case (TYPE_GLOBAL | TAG_GLOBAL_PHYSMAX):
-				CurrStateTable->Attributes.Physical.Maximum = ReportItemData;
+				CurrStateTable->Attributes.Physical.Maximum = ReportItemSignedData;
 				break;
 			case (TYPE_GLOBAL | TAG_GLOBAL_UNITEXP):
 				CurrStateTable->Attributes.Unit.Exponent    = ReportItemData;
@@ -125,30 +208,30 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData, uint16_t ReportSize, HID
 			case (TYPE_GLOBAL | TAG_GLOBAL_REPORTID):
 				CurrStateTable->ReportID                    = ReportItemData;
 
-				if (ParserData->UsingReportIDs)
+				if (Context->UsingReportIDs)
 				{
 					CurrReportIDInfo = NULL;
 
-					for (uint8_t i = 0; i < ParserData->TotalDeviceReports; i++)
+					for (uint8_t i = 0; i < Context->TotalDeviceReports; i++)
 					{
-						if (ParserData->ReportIDSizes[i].ReportID == CurrStateTable->ReportID)
+						if (Context->ReportIDSizes[i].ReportID == CurrStateTable->ReportID)
 						{
-							CurrReportIDInfo = &ParserData->ReportIDSizes[i];
+							CurrReportIDInfo = &Context->ReportIDSizes[i];
 							break;
 						}
 					}
 					
 					if (CurrReportIDInfo == NULL)
 					{
-						if (ParserData->TotalDeviceReports == HID_MAX_REPORT_IDS)
+						if (Context->TotalDeviceReports == HID_MAX_REPORT_IDS)
 						  return HID_PARSE_InsufficientReportIDItems;
 					
-						CurrReportIDInfo = &ParserData->ReportIDSizes[ParserData->TotalDeviceReports++];
+						CurrReportIDInfo = &Context->ReportIDSizes[Context->TotalDeviceReports++];
 						memset(CurrReportIDInfo, 0x00, sizeof(HID_ReportSizeInfo_t));
 					}
 				}
 
-				ParserData->UsingReportIDs = true;				
+				Context->UsingReportIDs = true;				
 
 				CurrReportIDInfo->ReportID = CurrStateTable->ReportID;
 				break;
@@ -165,29 +248,33 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData, uint16_t ReportSize, HID
 				UsageMinMax.Maximum = ReportItemData;
 				break;
 			case (TYPE_MAIN | TAG_MAIN_COLLECTION):
-				if (CurrCollectionPath == NULL)
+			{
+				HID_CollectionPath_t* ParentCollectionPath = CurrCollectionPath;
+
+				if (Context->CompactParserData != NULL)
 				{
-					CurrCollectionPath = &ParserData->CollectionPaths[0];
+					/* Compact collections are stored by index, only the current collection path is kept as pointers */
+					if ((Context->CollectionDepth == HID_MAX_COLLECTION_DEPTH) || (Context->TotalCollections == HID_NO_COLLECTION))
+					  return HID_PARSE_InsufficientCollectionPaths;
+
+					CurrCollectionPath = &Context->CollectionStack[Context->CollectionDepth];
+					Context->CollectionIndexes[Context->CollectionDepth++] = Context->TotalCollections;
 				}
 				else
 				{
-					HID_CollectionPath_t* ParentCollectionPath = CurrCollectionPath;
-			
-					CurrCollectionPath = &ParserData->CollectionPaths[1];
-
-					while (CurrCollectionPath->Parent != NULL)
-					{
-						if (CurrCollectionPath == &ParserData->CollectionPaths[HID_MAX_COLLECTIONS - 1])
-						  return HID_PARSE_InsufficientCollectionPaths;
-					
-						CurrCollectionPath++;
-					}
+					if (Context->TotalCollections == HID_MAX_COLLECTIONS)
+					  return HID_PARSE_InsufficientCollectionPaths;
 
-					CurrCollectionPath->Parent = ParentCollectionPath;
+					CurrCollectionPath = &Context->ParserData->CollectionPaths[Context->TotalCollections];
 				}
+
+				Context->TotalCollections++;
+				
+				CurrCollectionPath->Parent = ParentCollectionPath;
 				
 				CurrCollectionPath->Type = ReportItemData;
 				CurrCollectionPath->Usage.Page = CurrStateTable->Attributes.Usage.Page;
+				CurrCollectionPath->Usage.Usage = 0;
 				
 				if (UsageListSize)
 				{
@@ -202,13 +289,21 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData, uint16_t ReportSize, HID
 				{
 					CurrCollectionPath->Usage.Usage = UsageMinMax.Minimum++;
 				}
+
+				if (Context->CompactParserData != NULL)
+				  HID_Parser_StoreCompactCollection(Context, CurrCollectionPath);
 				
 				break;
+			}
 			case (TYPE_MAIN | TAG_MAIN_ENDCOLLECTION):
 				if (CurrCollectionPath == NULL)
 				  return HID_PARSE_UnexpectedEndCollection;
 		
 				CurrCollectionPath = CurrCollectionPath->Parent;
+				
+				if (Context->CompactParserData != NULL)
+				  Context->CollectionDepth--;
+
 				break;
 			case (TYPE_MAIN | TAG_MAIN_INPUT):
 			case (TYPE_MAIN | TAG_MAIN_OUTPUT):
@@ -252,18 +347,18 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData, uint16_t ReportSize, HID
 
 					CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType] += CurrStateTable->Attributes.BitSize;
 
-					if (ParserData->LargestReportSizeBits < NewReportItem.BitOffset)
-					  ParserData->LargestReportSizeBits = NewReportItem.BitOffset;
+					if (Context->LargestReportSizeBits < NewReportItem.BitOffset)
+					  Context->LargestReportSizeBits = NewReportItem.BitOffset;
 					
 					if (!(ReportItemData & IOF_CONSTANT) && CALLBACK_HIDParser_FilterHIDReportItem(&NewReportItem))
-					{					
-						if (ParserData->TotalReportItems == HID_MAX_REPORTITEMS)
-						  return HID_PARSE_InsufficientReportItems;
-					
-						memcpy(&ParserData->ReportItems[ParserData->TotalReportItems],
-						       &NewReportItem, sizeof(HID_ReportItem_t));
-					
-						ParserData->TotalReportItems++;
+					{
+						if (Context->CompactParserData != NULL)
+						  ErrorCode = HID_Parser_StoreCompactReportItem(Context, &NewReportItem);
+						else
+						  ErrorCode = HID_Parser_StoreReportItem(Context, &NewReportItem);
+						
+						if (ErrorCode != HID_PARSE_Successful)
+						  return ErrorCode;
 					}
 				}
 				
@@ -278,12 +373,185 @@ uint8_t USB_ProcessHIDReport(const uint8_t* ReportData, uint16_t ReportSize, HID
 		}
 	}
 	
-	if (!(ParserData->TotalReportItems))
+	if (!(Context->TotalReportItems))
 	  return HID_PARSE_NoUnfilteredReportItems;
 	
 	return HID_PARSE_Successful;
 }
 
+static uint8_t HID_Parser_StoreReportItem(HID_ParserContext_t* const Context, const HID_ReportItem_t* const NewReportItem)
+{
+	HID_ReportInfo_t* ParserData = Context->ParserData;
+
+	if (ParserData->TotalReportItems == HID_MAX_REPORTITEMS)
+	  return HID_PARSE_InsufficientReportItems;
+
+	memcpy(&ParserData->ReportItems[ParserData->TotalReportItems],
+	       NewReportItem, sizeof(HID_ReportItem_t));
+
+	ParserData->TotalReportItems++;
+	Context->TotalReportItems++;
+	
+	return HID_PARSE_Successful;
+}
+
+static uint8_t HID_Parser_StoreCompactReportItem(HID_ParserContext_t* const Context, const HID_ReportItem_t* const NewReportItem)
+{
+	if (Context->TotalReportItems == 0xFFFF)
+	  return HID_PARSE_InsufficientReportItems;
+
+	/* Consecutive items (such as those created from a single main item with a report count larger than one) very often
+	 * share identical attributes, in which case the previously stored attribute block is shared without re-encoding */
+	if (!(Context->LastAttributesSize) || !(HID_Parser_CompactAttributesMatch(&NewReportItem->Attributes, &Context->LastAttributes)))
+	{
+		uint8_t Attributes[HID_COMPACT_ATTRIBUTES_MAX_SIZE];
+		uint8_t AttributesSize = HID_Parser_EncodeAttributes(&NewReportItem->Attributes, Attributes);
+
+		if (((uint32_t)Context->AttributesSize + AttributesSize) > 0xFFFF)
+		  return HID_PARSE_InsufficientArena;
+
+		if (!(Context->Measuring))
+		  memcpy(&Context->Arena[Context->AttributesOffset + Context->AttributesSize], Attributes, AttributesSize);
+
+		Context->LastAttributes       = NewReportItem->Attributes;
+		Context->LastAttributesSize   = AttributesSize;
+		Context->LastAttributesOffset = Context->AttributesSize;
+		Context->AttributesSize      += AttributesSize;
+	}
+	
+	if (!(Context->Measuring))
+	{
+		HID_CompactReportItem_t* ReportItem = &Context->CompactParserData->ReportItems[Context->TotalReportItems];
+		
+		ReportItem->BitOffset        = NewReportItem->BitOffset;
+		ReportItem->ItemType         = NewReportItem->ItemType;
+		ReportItem->ItemFlags        = NewReportItem->ItemFlags;
+		ReportItem->ReportID         = NewReportItem->ReportID;
+		ReportItem->Usage            = NewReportItem->Attributes.Usage.Usage;
+		ReportItem->CollectionIndex  = (Context->CollectionDepth) ? Context->CollectionIndexes[Context->CollectionDepth - 1]
+		                                                          : HID_NO_COLLECTION;
+		ReportItem->AttributesOffset = (Context->AttributesOffset + Context->LastAttributesOffset);
+	}
+
+	Context->TotalReportItems++;
+	return HID_PARSE_Successful;
+}
+
+static void HID_Parser_StoreCompactCollection(HID_ParserContext_t* const Context, const HID_CollectionPath_t* const CollectionPath)
+{
+	if (Context->Measuring)
+	  return;
+
+	HID_CompactCollection_t* Collection = &Context->CompactParserData->Collections[Context->TotalCollections - 1];
+
+	Collection->Type        = CollectionPath->Type;
+	Collection->UsagePage   = CollectionPath->Usage.Page;
+	Collection->Usage       = CollectionPath->Usage.Usage;
+	Collection->ParentIndex = (Context->CollectionDepth > 1) ? Context->CollectionIndexes[Context->CollectionDepth - 2]
+	                                                         : HID_NO_COLLECTION;
+}
+
+static bool HID_Parser_CompactAttributesMatch(const HID_ReportItem_Attributes_t* const Attributes,
+                                              const HID_ReportItem_Attributes_t* const OtherAttributes)
+{
+	/* Only the attributes held in a compact attribute block are compared, as each item stores its own usage */
+	return ((Attributes->BitSize           == OtherAttributes->BitSize)           &&
+	        (Attributes->Usage.Page        == OtherAttributes->Usage.Page)        &&
+	        (Attributes->Unit.Type         == OtherAttributes->Unit.Type)         &&
+	        (Attributes->Unit.Exponent     == OtherAttributes->Unit.Exponent)     &&
+	        (Attributes->Logical.Minimum   == OtherAttributes->Logical.Minimum)   &&
+	        (Attributes->Logical.Maximum   == OtherAttributes->Logical.Maximum)   &&
+	        (Attributes->Physical.Minimum  == OtherAttributes->Physical.Minimum)  &&
+	        (Attributes->Physical.Maximum  == OtherAttributes->Physical.Maximum));
+}
+
+static uint8_t HID_Parser_EncodeAttributes(const HID_ReportItem_Attributes_t* const Attributes, uint8_t* const Buffer)
+{
+	uint32_t FieldValues[HID_COMPACT_ATTRIBUTES_FIELDS] = {Attributes->Logical.Minimum,  Attributes->Logical.Maximum,
+	                                                       Attributes->Physical.Minimum, Attributes->Physical.Maximum,
+	                                                       Attributes->Unit.Type};
+	uint8_t* FieldData  = &Buffer[HID_COMPACT_ATTRIBUTES_HEADER_SIZE];
+	uint16_t FieldSizes = 0;
+	
+	Buffer[0] = Attributes->BitSize;
+	Buffer[1] = (Attributes->Usage.Page & 0xFF);
+	Buffer[2] = (Attributes->Usage.Page >> 8);
+	Buffer[3] = Attributes->Unit.Exponent;
+
+	/* Each field is stored at the smallest of zero, one, two or four bytes that holds its value; negative range values
+	 * are flagged in the upper bits of the size word, so that they are sign extended again when retrieved */
+	for (uint8_t FieldIndex = 0; FieldIndex < HID_COMPACT_ATTRIBUTES_FIELDS; FieldIndex++)
+	{
+		uint32_t FieldValue = FieldValues[FieldIndex];
+		uint8_t  SizeCode;
+		
+		if ((FieldIndex < HID_COMPACT_ATTRIBUTES_SIGNED_FIELDS) && ((int32_t)FieldValue < 0))
+		{
+			FieldSizes |= (1 << (HID_COMPACT_ATTRIBUTES_SIGN_SHIFT + FieldIndex));
+
+			if (~FieldValue <= 0x7F)
+			  SizeCode = 1;
+			else if (~FieldValue <= 0x7FFF)
+			  SizeCode = 2;
+			else
+			  SizeCode = 3;
+		}
+		else if (!(FieldValue))
+		  SizeCode = 0;
+		else if (FieldValue <= 0xFF)
+		  SizeCode = 1;
+		else if (FieldValue <= 0xFFFF)
+		  SizeCode = 2;
+		else
+		  SizeCode = 3;
+
+		FieldSizes |= ((uint16_t)SizeCode << (FieldIndex * 2));
+
+		for (uint8_t FieldBytes = HID_Parser_FieldSizes[SizeCode]; FieldBytes > 0; FieldBytes--)
+		{
+			*(FieldData++) = FieldValue;
+			FieldValue >>= 8;
+		}
+	}
+	
+	Buffer[4] = (FieldSizes & 0xFF);
+	Buffer[5] = (FieldSizes >> 8);
+
+	return (FieldData - Buffer);
+}
+
+void USB_GetHIDCompactItemAttributes(const HID_CompactReportInfo_t* const ParserData, const HID_CompactReportItem_t* const ReportItem,
+                                     HID_ReportItem_Attributes_t* const Attributes)
+{
+	const uint8_t* Buffer     = &ParserData->Arena[ReportItem->AttributesOffset];
+	const uint8_t* FieldData  = &Buffer[HID_COMPACT_ATTRIBUTES_HEADER_SIZE];
+	uint16_t       FieldSizes = (Buffer[4] | ((uint16_t)Buffer[5] << 8));
+	uint32_t       FieldValues[HID_COMPACT_ATTRIBUTES_FIELDS];
+
+	for (uint8_t FieldIndex = 0; FieldIndex < HID_COMPACT_ATTRIBUTES_FIELDS; FieldIndex++)
+	{
+		uint8_t FieldBytes = HID_Parser_FieldSizes[(FieldSizes >> (FieldIndex * 2)) & 0x03];
+
+		FieldValues[FieldIndex] = 0;
+
+		for (uint8_t FieldByte = 0; FieldByte < FieldBytes; FieldByte++)
+		  FieldValues[FieldIndex] |= ((uint32_t)*(FieldData++) << (FieldByte * 8));
+
+		if ((FieldSizes & (1 << (HID_COMPACT_ATTRIBUTES_SIGN_SHIFT + FieldIndex))) && (FieldBytes < 4))
+		  FieldValues[FieldIndex] |= (0xFFFFFFFFUL << (FieldBytes * 8));
+	}
+
+	Attributes->BitSize          = Buffer[0];
+	Attributes->Usage.Page       = (Buffer[1] | ((uint16_t)Buffer[2] << 8));
+	Attributes->Usage.Usage      = ReportItem->Usage;
+	Attributes->Unit.Exponent    = Buffer[3];
+	Attributes->Logical.Minimum  = FieldValues[0];
+	Attributes->Logical.Maximum  = FieldValues[1];
+	Attributes->Physical.Minimum = FieldValues[2];
+	Attributes->Physical.Maximum = FieldValues[3];
+	Attributes->Unit.Type        = FieldValues[4];
+}
+
 bool USB_GetHIDReportItemInfo(const uint8_t* ReportData, HID_ReportItem_t* const ReportItem)
 {
 	uint16_t DataBitsRem  = ReportItem->Attributes.BitSize;
@@ -329,8 +597,8 @@ void USB_SetHIDReportItemInfo(uint8_t* ReportData, HID_ReportItem_t* const Repor
 
 	while (DataBitsRem--)
 	{
-		if (ReportItem->Value & (1 << (CurrentBit % 8)))
-		  ReportData[CurrentBit / 8] |= BitMask;
+		if (ReportItem->Value & BitMask)
+		  ReportData[CurrentBit / 8] |= (1 << (CurrentBit % 8));
 
 		CurrentBit++;
 		BitMask <<= 1;
@@ -350,4 +618,219 @@ uint16_t USB_GetHIDReportSize(HID_ReportInfo_t* const ParserData, const uint8_t
 	return 0;
 }
 
+uint8_t USB_CompileHIDReportPlan(const HID_ReportInfo_t* const ParserData, const uint8_t ReportID,
+                                 const uint8_t ReportType, HID_ReportPlan_t* const Plan)
+{
+	HID_Parser_BeginPlan(Plan, ParserData->ReportIDSizes, ParserData->TotalDeviceReports, ReportID, ReportType);
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		const HID_ReportItem_t* ReportItem = &ParserData->ReportItems[ItemIndex];
+
+		if ((ReportItem->ReportID != ReportID) || (ReportItem->ItemType != ReportType))
+		  continue;
+
+		if (!(HID_Parser_AddPlanStep(Plan, ReportItem->BitOffset, &ReportItem->Attributes, ItemIndex)))
+		  break;
+	}
+	
+	return Plan->TotalSteps;
+}
+
+uint8_t USB_CompileHIDCompactReportPlan(const HID_CompactReportInfo_t* const ParserData, const uint8_t ReportID,
+                                        const uint8_t ReportType, HID_ReportPlan_t* const Plan)
+{
+	HID_Parser_BeginPlan(Plan, ParserData->ReportIDSizes, ParserData->TotalDeviceReports, ReportID, ReportType);
+
+	for (uint16_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		const HID_CompactReportItem_t* ReportItem = &ParserData->ReportItems[ItemIndex];
+		HID_ReportItem_Attributes_t    Attributes;
+
+		if ((ReportItem->ReportID != ReportID) || (ReportItem->ItemType != ReportType))
+		  continue;
+
+		USB_GetHIDCompactItemAttributes(ParserData, ReportItem, &Attributes);
+
+		if (!(HID_Parser_AddPlanStep(Plan, ReportItem->BitOffset, &Attributes, ItemIndex)))
+		  break;
+	}
+	
+	return Plan->TotalSteps;
+}
+
+static void HID_Parser_BeginPlan(HID_ReportPlan_t* const Plan, const HID_ReportSizeInfo_t* const ReportIDSizes,
+                                 const uint8_t TotalDeviceReports, const uint8_t ReportID, const uint8_t ReportType)
+{
+	Plan->ReportID   = ReportID;
+	Plan->ReportType = ReportType;
+	Plan->ReportSize = 0;
+	Plan->TotalSteps = 0;
+
+	for (uint8_t i = 0; i < TotalDeviceReports; i++)
+	{
+		uint16_t ReportSizeBits = ReportIDSizes[i].ReportSizeBits[ReportType];
+
+		if (ReportIDSizes[i].ReportID == ReportID)
+		{
+			Plan->ReportSize = ((ReportSizeBits >> 3) + ((ReportSizeBits & 0x07) ? 1 : 0));
+			break;
+		}
+	}
+}
+
+static bool HID_Parser_AddPlanStep(HID_ReportPlan_t* const Plan, const uint16_t BitOffset,
+                                   const HID_ReportItem_Attributes_t* const Attributes, const uint16_t ItemIndex)
+{
+	if (!(Attributes->BitSize))
+	  return true;
+
+	if (Plan->TotalSteps == HID_MAX_PLAN_STEPS)
+	  return false;
+
+	HID_ReportPlanStep_t* Step = &Plan->Steps[Plan->TotalSteps++];
+
+	Step->ByteOffset = (BitOffset >> 3);
+	Step->Shift      = (BitOffset & 0x07);
+	Step->BitSize    = (Attributes->BitSize > 32) ? 32 : Attributes->BitSize;
+	Step->IsSigned   = ((int32_t)Attributes->Logical.Minimum < 0);
+	Step->ItemIndex  = ItemIndex;
+
+	if (!(Step->Shift) && (Step->BitSize == 8))
+	  Step->StepType = HID_PLAN_STEP_Byte;
+	else if (!(Step->Shift) && (Step->BitSize == 16))
+	  Step->StepType = HID_PLAN_STEP_Word;
+	else if ((Step->Shift + Step->BitSize) <= 8)
+	  Step->StepType = HID_PLAN_STEP_BitField;
+	else
+	  Step->StepType = HID_PLAN_STEP_Bits;
+	
+	return true;
+}
+
+bool USB_UnpackHIDReport(const HID_ReportPlan_t* const Plan, const uint8_t* ReportData, uint32_t* const Values)
+{
+	const HID_ReportPlanStep_t* Step = Plan->Steps;
+
+	if (Plan->ReportID)
+	{
+		if (Plan->ReportID != ReportData[0])
+		  return false;
+
+		ReportData++;
+	}
+
+	for (uint8_t StepIndex = 0; StepIndex < Plan->TotalSteps; StepIndex++)
+	{
+		const uint8_t* ItemData = &ReportData[Step->ByteOffset];
+		uint32_t       Value;
+
+		switch (Step->StepType)
+		{
+			case HID_PLAN_STEP_Byte:
+				Value = (Step->IsSigned) ? (uint32_t)(int8_t)ItemData[0] : ItemData[0];
+				break;
+			case HID_PLAN_STEP_Word:
+				Value = (ItemData[0] | ((uint16_t)ItemData[1] << 8));
+
+				if (Step->IsSigned)
+				  Value = (uint32_t)(int16_t)Value;
+
+				break;
+			case HID_PLAN_STEP_BitField:
+				Value = ((ItemData[0] >> Step->Shift) & (uint8_t)((1 << Step->BitSize) - 1));
+
+				if (Step->IsSigned && (Value & (1 << (Step->BitSize - 1))))
+				  Value |= ~((uint32_t)(1 << Step->BitSize) - 1);
+
+				break;
+			default:
+			{
+				uint8_t TotalBytes = ((Step->Shift + Step->BitSize + 7) >> 3);
+				
+				Value = 0;
+
+				for (uint8_t ByteIndex = ((TotalBytes > 4) ? 4 : TotalBytes); ByteIndex > 0; ByteIndex--)
+				  Value = ((Value << 8) | ItemData[ByteIndex - 1]);
+
+				Value >>= Step->Shift;
+
+				if (TotalBytes > 4)
+				  Value |= ((uint32_t)ItemData[4] << (32 - Step->Shift));
+
+				if (Step->BitSize < 32)
+				{
+					uint32_t ValueMask = ((1UL << Step->BitSize) - 1);
+				
+					Value &= ValueMask;
+					
+					if (Step->IsSigned && (Value & (1UL << (Step->BitSize - 1))))
+					  Value |= ~ValueMask;
+				}
+
+				break;
+			}
+		}
+		
+		Values[StepIndex] = Value;
+		Step++;
+	}
+
+	return true;
+}
+
+void USB_PackHIDReport(const HID_ReportPlan_t* const Plan, uint8_t* ReportData, const uint32_t* const Values)
+{
+	const HID_ReportPlanStep_t* Step = Plan->Steps;
+
+	if (Plan->ReportID)
+	{
+		ReportData[0] = Plan->ReportID;
+		ReportData++;
+	}
+
+	for (uint8_t StepIndex = 0; StepIndex < Plan->TotalSteps; StepIndex++)
+	{
+		uint8_t* ItemData = &ReportData[Step->ByteOffset];
+		uint32_t Value    = Values[StepIndex];
+
+		switch (Step->StepType)
+		{
+			case HID_PLAN_STEP_Byte:
+				ItemData[0] = Value;
+				break;
+			case HID_PLAN_STEP_Word:
+				ItemData[0] = Value;
+				ItemData[1] = (Value >> 8);
+				break;
+			default:
+			{
+				uint8_t BitsRemaining = Step->BitSize;
+				uint8_t Shift         = Step->Shift;
+
+				while (BitsRemaining)
+				{
+					uint8_t BitsInByte = (8 - Shift);
+
+					if (BitsInByte > BitsRemaining)
+					  BitsInByte = BitsRemaining;
+
+					uint8_t ByteMask = (uint8_t)(((1 << BitsInByte) - 1) << Shift);
+					
+					*ItemData = ((*ItemData & ~ByteMask) | (((uint8_t)Value << Shift) & ByteMask));
+					
+					Value         >>= BitsInByte;
+					BitsRemaining  -= BitsInByte;
+					Shift           = 0;
+					ItemData++;
+				}
+
+				break;
+			}
+		}
+
+		Step++;
+	}
+}
+
 #endif
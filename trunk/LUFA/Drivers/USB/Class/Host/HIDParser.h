@@ -51,6 +51,32 @@
  *  This library portion also allows for easy setting and retrieval of data from a HID report, including devices
  *  with multiple reports on the one HID interface.
  *
+ *  \section Sec_HIDReportPlans Report Plans
+ *  Retrieving each item of a report via \ref USB_GetHIDReportItemInfo() extracts the item's value one bit at a time,
+ *  which becomes costly when many items are read from reports received at a high polling rate. Instead, the items of
+ *  a single report ID and type may be compiled once into a \ref HID_ReportPlan_t via \ref USB_CompileHIDReportPlan()
+ *  after the report descriptor has been processed. The plan records for each item the byte offset, bit shift and size
+ *  of the item's data, selecting whole byte, whole word and single byte bit field fast paths where possible, so that
+ *  \ref USB_UnpackHIDReport() can then extract all of the plan's items from a received report into an array of values
+ *  in a single call. \ref USB_PackHIDReport() applies a plan in reverse, to build an OUT or FEATURE report from an array
+ *  of values.
+ *
+ *  \section Sec_HIDCompactStorage Compact Report Storage
+ *  The \ref HID_ReportInfo_t structure produced by \ref USB_ProcessHIDReport() holds fixed size arrays of full report items,
+ *  each carrying its own copy of all its 32-bit attribute values, sized at compile time by \ref HID_MAX_REPORTITEMS,
+ *  \ref HID_MAX_COLLECTIONS and \ref HID_MAX_REPORT_IDS. Descriptors with many items thus either fail to parse or consume
+ *  most of the available SRAM. As an alternative, \ref USB_ProcessHIDReportCompact() stores the processed descriptor into
+ *  a \ref HID_CompactReportInfo_t structure, placing the report items, collections and item attributes into an arena
+ *  buffer supplied by the application. Each item's attributes other than its usage are stored in a variable length block
+ *  holding each range value at the smallest width needed, which is shared between consecutive items with identical
+ *  attributes, and retrieved when needed via \ref USB_GetHIDCompactItemAttributes().
+ *
+ *  The arena size required for a given descriptor is exactly determined by first calling \ref USB_ProcessHIDReportCompact()
+ *  with a NULL arena, after which the application may allocate a buffer of the reported size and parse the descriptor
+ *  into it. As the descriptor is processed twice, \ref CALLBACK_HIDParser_FilterHIDReportItem() must give the same result
+ *  for each item on each pass. Compact storage thus trades parsing time for RAM, and is best suited to descriptors which
+ *  are parsed once at enumeration.
+ *
  *  @{
  */
 
@@ -128,6 +154,28 @@
 			#define HID_MAX_REPORT_IDS            10
 		#endif
 
+		#if !defined(HID_MAX_PLAN_STEPS) || defined(__DOXYGEN__)
+			/** Constant indicating the maximum number of report items that can be compiled into a single \ref HID_ReportPlan_t
+			 *  report plan. A large value allows for plans of reports with more items, but consumes more memory. By default this
+			 *  is set to \ref HID_MAX_REPORTITEMS, but this can be overridden by defining HID_MAX_PLAN_STEPS to another value in
+			 *  the user project makefile, passing the define to the compiler using the -D compiler switch.
+			 */
+			#define HID_MAX_PLAN_STEPS            HID_MAX_REPORTITEMS
+		#endif
+
+		#if !defined(HID_MAX_COLLECTION_DEPTH) || defined(__DOXYGEN__)
+			/** Constant indicating the maximum nesting depth of COLLECTION items that can be processed by
+			 *  \ref USB_ProcessHIDReportCompact(). Unlike \ref HID_MAX_COLLECTIONS this does not limit the total number of
+			 *  collections in the descriptor, which are stored in the arena. By default this is set to 5 levels, but this can
+			 *  be overridden by defining HID_MAX_COLLECTION_DEPTH to another value in the user project makefile, passing the
+			 *  define to the compiler using the -D compiler switch.
+			 */
+			#define HID_MAX_COLLECTION_DEPTH      5
+		#endif
+
+		/** Collection index of a compact report item or collection which is not contained within a parent collection. */
+		#define HID_NO_COLLECTION                 0xFF
+
 		/** Returns the value a given HID report item (once its value has been fetched via \ref USB_GetHIDReportItemInfo())
 		 *  left-aligned to the given data type. This allows for signed data to be interpreted correctly, by shifting the data
 		 *  leftwards until the data's sign bit is in the correct position.
@@ -153,6 +201,16 @@
 				HID_PARSE_UsageListOverflow           = 6, /**< More than \ref HID_USAGE_STACK_DEPTH usages listed in a row. */
 				HID_PARSE_InsufficientReportIDItems   = 7, /**< More than \ref HID_MAX_REPORT_IDS report IDs in the device. */
 				HID_PARSE_NoUnfilteredReportItems     = 8, /**< All report items from the device were filtered by the filtering callback routine. */
+				HID_PARSE_InsufficientArena           = 9, /**< The arena given to \ref USB_ProcessHIDReportCompact() is too small. */
+			};
+
+			/** Enum for the possible report item extraction methods of a \ref HID_ReportPlanStep_t report plan step. */
+			enum HID_ReportPlanStepTypes_t
+			{
+				HID_PLAN_STEP_BitField                = 0, /**< Item's data lies within a single byte of the report. */
+				HID_PLAN_STEP_Byte                    = 1, /**< Item's data is a whole, byte aligned byte of the report. */
+				HID_PLAN_STEP_Word                    = 2, /**< Item's data is a whole, byte aligned little endian word of the report. */
+				HID_PLAN_STEP_Bits                    = 3, /**< Item's data spans several bytes of the report at an arbitrary bit offset. */
 			};
 		
 		/* Type Defines: */		
@@ -194,8 +252,12 @@
 				
 				HID_Usage_t                  Usage;    /**< Usage of the report item. */
 				HID_Unit_t                   Unit;     /**< Unit type and exponent of the report item. */
-				HID_MinMax_t                 Logical;  /**< Logical minimum and maximum of the report item. */
-				HID_MinMax_t                 Physical; /**< Physical minimum and maximum of the report item. */
+				HID_MinMax_t                 Logical;  /**< Logical minimum and maximum of the report item, sign extended from the
+				                                        *   size of each value's item in the report descriptor.
+				                                        */
+				HID_MinMax_t                 Physical; /**< Physical minimum and maximum of the report item, sign extended from the
+				                                        *   size of each value's item in the report descriptor.
+				                                        */
 			} HID_ReportItem_Attributes_t;
 			
 			/** Type define for a report item (IN, OUT or FEATURE) attributes and other details. */
@@ -243,6 +305,75 @@
 				                                              *   element in its HID report descriptor.
 				                                              */
 			} HID_ReportInfo_t;
+
+			/** Type define for a COLLECTION object stored by \ref USB_ProcessHIDReportCompact(). */
+			typedef struct
+			{
+				uint8_t                      Type;        /**< Collection type (e.g. "Generic Desktop"). */
+				uint16_t                     UsagePage;   /**< Usage page of the collection. */
+				uint16_t                     Usage;       /**< Usage of the collection. */
+				uint8_t                      ParentIndex; /**< Index of the parent collection, or \ref HID_NO_COLLECTION if root collection. */
+			} HID_CompactCollection_t;
+
+			/** Type define for a report item (IN, OUT or FEATURE) stored by \ref USB_ProcessHIDReportCompact(). The item's
+			 *  remaining attributes are retrieved via \ref USB_GetHIDCompactItemAttributes().
+			 */
+			typedef struct
+			{
+				uint16_t                     BitOffset;        /**< Bit offset in the IN, OUT or FEATURE report of the item. */
+				uint8_t                      ItemType;         /**< Report item type, a value in HID_ReportItemTypes_t. */
+				uint16_t                     ItemFlags;        /**< Item data flags, such as constant/variable, etc. */
+				uint8_t                      ReportID;         /**< Report ID this item belongs to, or 0x00 if device has only one report */
+				uint16_t                     Usage;            /**< Usage of the report item, within the usage page held in its attributes. */
+				uint8_t                      CollectionIndex;  /**< Index of the item's collection, or \ref HID_NO_COLLECTION if none. */
+				uint16_t                     AttributesOffset; /**< Offset in the arena of the item's shared attribute block. */
+			} HID_CompactReportItem_t;
+
+			/** Type define for a complete processed HID report stored by \ref USB_ProcessHIDReportCompact(), with the report
+			 *  items, collections and item attributes held in an application supplied arena (see \ref Sec_HIDCompactStorage).
+			 */
+			typedef struct
+			{
+				uint8_t*                     Arena; /**< Arena holding the processed descriptor, or NULL if only measured. */
+				uint16_t                     RequiredArenaSize; /**< Size in bytes of the arena required to store the descriptor. */
+				uint16_t                     TotalReportItems; /**< Total number of report items stored in the ReportItems array. */
+				HID_CompactReportItem_t*     ReportItems; /**< Report items array in the arena, including all IN, OUT and FEATURE items. */
+				uint8_t                      TotalCollections; /**< Total number of collections stored in the Collections array. */
+				HID_CompactCollection_t*     Collections; /**< Collections array in the arena, referenced by index by the report items. */
+				uint8_t                      TotalDeviceReports; /**< Number of reports within the HID interface */
+				HID_ReportSizeInfo_t         ReportIDSizes[HID_MAX_REPORT_IDS]; /**< Report sizes for each report in the interface */
+				uint16_t                     LargestReportSizeBits; /**< Largest report that the attached device will generate, in bits */
+				bool                         UsingReportIDs; /**< Indicates if the device has at least one REPORT ID
+				                                              *   element in its HID report descriptor.
+				                                              */
+			} HID_CompactReportInfo_t;
+
+			/** Type define for a single step of a compiled report plan, which extracts or inserts one report item's value. */
+			typedef struct
+			{
+				uint16_t                     ByteOffset; /**< Offset in bytes of the item's first byte in the report, after any report ID prefix. */
+				uint8_t                      Shift;      /**< Bit position of the item's least significant bit within its first byte. */
+				uint8_t                      BitSize;    /**< Size in bits of the item's data, truncated to 32 bits. */
+				uint8_t                      StepType;   /**< Extraction method of the step, a value in the \ref HID_ReportPlanStepTypes_t enum. */
+				bool                         IsSigned;   /**< Indicates if the item's value is sign extended to 32 bits when extracted,
+				                                          *   as the item's logical minimum is negative.
+				                                          */
+				uint16_t                     ItemIndex;  /**< Index of the step's item in the \ref HID_ReportInfo_t or \ref HID_CompactReportInfo_t
+				                                          *   ReportItems array.
+				                                          */
+			} HID_ReportPlanStep_t;
+
+			/** Type define for a compiled report plan, holding the steps needed to extract or insert the values of all the
+			 *  processed report items of a single report ID and type (see \ref Sec_HIDReportPlans).
+			 */
+			typedef struct
+			{
+				uint8_t                      ReportID;   /**< Report ID of the plan's report, or 0x00 if the device has only one report. */
+				uint8_t                      ReportType; /**< Report type of the plan's report, a value in the \ref HID_ReportItemTypes_t enum. */
+				uint16_t                     ReportSize; /**< Size in bytes of the plan's report, not including any report ID prefix. */
+				uint8_t                      TotalSteps; /**< Total number of steps stored in the Steps array. */
+				HID_ReportPlanStep_t         Steps[HID_MAX_PLAN_STEPS]; /**< Steps of the plan, in report item order. */
+			} HID_ReportPlan_t;
 			
 		/* Function Prototypes: */
 			/** Function to process a given HID report returned from an attached device, and store it into a given
@@ -299,6 +430,95 @@
 			uint16_t USB_GetHIDReportSize(HID_ReportInfo_t* const ParserData, const uint8_t ReportID,
 			                              const uint8_t ReportType) ATTR_CONST ATTR_NON_NULL_PTR_ARG(1);
 
+			/** Compiles the processed report items of the given report ID and type into a report plan, so that their values
+			 *  can be extracted from or inserted into reports via \ref USB_UnpackHIDReport() and \ref USB_PackHIDReport().
+			 *  Only the items stored into the \ref HID_ReportInfo_t structure by \ref USB_ProcessHIDReport() (i.e. those
+			 *  not rejected by \ref CALLBACK_HIDParser_FilterHIDReportItem()) are included in the plan, in report item order.
+			 *
+			 *  Items are treated as signed if their logical minimum is greater than their logical maximum when both are
+			 *  interpreted as unsigned values, as is the case for items with a negative logical minimum.
+			 *
+			 *  \param[in] ParserData  Pointer to a \ref HID_ReportInfo_t instance containing the parser output
+			 *  \param[in] ReportID  Report ID of the report to compile, or 0x00 if the device has only one report
+			 *  \param[in] ReportType  Type of the report to compile, a value from the \ref HID_ReportItemTypes_t enum
+			 *  \param[out] Plan  Pointer to a \ref HID_ReportPlan_t instance where the compiled plan is to be stored
+			 *
+			 *  \return Number of report items compiled into the plan, or zero if the report contains no processed items
+			 */
+			uint8_t USB_CompileHIDReportPlan(const HID_ReportInfo_t* const ParserData, const uint8_t ReportID,
+			                                 const uint8_t ReportType, HID_ReportPlan_t* const Plan)
+			                                 ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(4);
+
+			/** Extracts the values of all the report items in the given report plan from a received report, storing each
+			 *  item's value into the given array in plan step order. Signed items are sign extended to 32 bits, so that the
+			 *  value may be cast directly to a signed type. Unlike \ref USB_GetHIDReportItemInfo(), the Value and PreviousValue
+			 *  elements of the \ref HID_ReportInfo_t report items are not altered.
+			 *
+			 *  \param[in] Plan  Pointer to a \ref HID_ReportPlan_t instance compiled by \ref USB_CompileHIDReportPlan()
+			 *  \param[in] ReportData  Buffer containing an IN or FEATURE report from an attached device
+			 *  \param[out] Values  Array of at least Plan->TotalSteps elements where the extracted values are to be stored
+			 *
+			 *  \return Boolean true if the report matched the plan's report ID and the values were extracted, false otherwise
+			 */
+			/** Function to process a given HID report returned from an attached device, and store it into a given
+			 *  \ref HID_CompactReportInfo_t structure and arena buffer (see \ref Sec_HIDCompactStorage). If a NULL arena
+			 *  is given, the descriptor is only measured, and the RequiredArenaSize element of the parser data is set to the
+			 *  exact number of bytes of arena needed to store it.
+			 *
+			 *  \param[in] ReportData  Buffer containing the device's HID report table
+			 *  \param[in] ReportSize  Size in bytes of the HID report table
+			 *  \param[out] ParserData  Pointer to a \ref HID_CompactReportInfo_t instance for the parser output
+			 *  \param[out] Arena  Buffer where the processed report items, collections and attributes are to be stored, or NULL
+			 *                     to measure the descriptor only
+			 *  \param[in] ArenaSize  Size in bytes of the given arena buffer
+			 *
+			 *  \return A value in the \ref HID_Parse_ErrorCodes_t enum
+			 */
+			uint8_t USB_ProcessHIDReportCompact(const uint8_t* ReportData, uint16_t ReportSize, HID_CompactReportInfo_t* const ParserData,
+			                                    void* Arena, const uint16_t ArenaSize) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Retrieves the full attributes of a report item stored by \ref USB_ProcessHIDReportCompact().
+			 *
+			 *  \param[in] ParserData  Pointer to a \ref HID_CompactReportInfo_t instance containing the parser output
+			 *  \param[in] ReportItem  Pointer to the report item of interest in the parser output's ReportItems array
+			 *  \param[out] Attributes  Pointer to a \ref HID_ReportItem_Attributes_t instance where the attributes are to be stored
+			 */
+			void USB_GetHIDCompactItemAttributes(const HID_CompactReportInfo_t* const ParserData, const HID_CompactReportItem_t* const ReportItem,
+			                                     HID_ReportItem_Attributes_t* const Attributes) ATTR_NON_NULL_PTR_ARG(1)
+			                                     ATTR_NON_NULL_PTR_ARG(2) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Compact report storage version of \ref USB_CompileHIDReportPlan(), which compiles the report items stored by
+			 *  \ref USB_ProcessHIDReportCompact() into a report plan.
+			 *
+			 *  \param[in] ParserData  Pointer to a \ref HID_CompactReportInfo_t instance containing the parser output
+			 *  \param[in] ReportID  Report ID of the report to compile, or 0x00 if the device has only one report
+			 *  \param[in] ReportType  Type of the report to compile, a value from the \ref HID_ReportItemTypes_t enum
+			 *  \param[out] Plan  Pointer to a \ref HID_ReportPlan_t instance where the compiled plan is to be stored
+			 *
+			 *  \return Number of report items compiled into the plan, or zero if the report contains no processed items
+			 */
+			uint8_t USB_CompileHIDCompactReportPlan(const HID_CompactReportInfo_t* const ParserData, const uint8_t ReportID,
+			                                        const uint8_t ReportType, HID_ReportPlan_t* const Plan)
+			                                        ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(4);
+
+			bool USB_UnpackHIDReport(const HID_ReportPlan_t* const Plan, const uint8_t* ReportData, uint32_t* const Values)
+			                         ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Inserts the values of all the report items in the given report plan from the given array, in plan step order,
+			 *  into the correct positions in a HID report buffer. Each item's bits in the buffer are replaced, while all other
+			 *  bits (such as constant padding) are left untouched, thus the buffer should be explicitly cleared before it is
+			 *  first packed. Values are truncated to the size of each item.
+			 *
+			 *  If the device has multiple HID reports, the first byte in the report is set to the plan's report ID.
+			 *
+			 *  \param[in] Plan  Pointer to a \ref HID_ReportPlan_t instance compiled by \ref USB_CompileHIDReportPlan()
+			 *  \param[out] ReportData  Buffer holding the OUT or FEATURE report data, at least Plan->ReportSize bytes
+			 *                          (plus one for the report ID prefix, if used) long
+			 *  \param[in] Values  Array of Plan->TotalSteps values to insert into the report
+			 */
+			void USB_PackHIDReport(const HID_ReportPlan_t* const Plan, uint8_t* ReportData, const uint32_t* const Values)
+			                       ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2) ATTR_NON_NULL_PTR_ARG(3);
+
 			/** Callback routine for the HID Report Parser. This callback <b>must</b> be implemented by the user code when
 			 *  the parser is used, to determine what report IN, OUT and FEATURE item's information is stored into the user
 			 *  HID_ReportInfo_t structure. This can be used to filter only those items the application will be using, so that
@@ -312,6 +532,13 @@
 
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define HID_COMPACT_ATTRIBUTES_FIELDS         5
+			#define HID_COMPACT_ATTRIBUTES_SIGNED_FIELDS  4
+			#define HID_COMPACT_ATTRIBUTES_SIGN_SHIFT     (HID_COMPACT_ATTRIBUTES_FIELDS * 2)
+			#define HID_COMPACT_ATTRIBUTES_HEADER_SIZE    6
+			#define HID_COMPACT_ATTRIBUTES_MAX_SIZE       (HID_COMPACT_ATTRIBUTES_HEADER_SIZE + (HID_COMPACT_ATTRIBUTES_FIELDS * 4))
+
 		/* Type Defines: */
 			typedef struct
 			{
@@ -319,6 +546,57 @@
 				 uint8_t                     ReportCount;
 				 uint8_t                     ReportID;
 			} HID_StateTable_t;
+
+			typedef struct
+			{
+				HID_ReportInfo_t*            ParserData;
+				HID_CompactReportInfo_t*     CompactParserData;
+				HID_ReportSizeInfo_t*        ReportIDSizes;
+				uint8_t                      TotalDeviceReports;
+				uint16_t                     LargestReportSizeBits;
+				bool                         UsingReportIDs;
+				uint16_t                     TotalReportItems;
+
+				bool                         Measuring;
+				uint8_t*                     Arena;
+				uint16_t                     CollectionsOffset;
+				uint16_t                     AttributesOffset;
+				uint8_t                      TotalCollections;
+				uint8_t                      CollectionDepth;
+				HID_CollectionPath_t         CollectionStack[HID_MAX_COLLECTION_DEPTH];
+				uint8_t                      CollectionIndexes[HID_MAX_COLLECTION_DEPTH];
+				uint16_t                     AttributesSize;
+				uint16_t                     LastAttributesOffset;
+				uint8_t                      LastAttributesSize;
+				HID_ReportItem_Attributes_t  LastAttributes;
+			} HID_ParserContext_t;
+
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_HIDPARSER_C)
+				static uint8_t HID_Parser_ParseDescriptor(const uint8_t* ReportData, uint16_t ReportSize,
+				                                          HID_ParserContext_t* const Context) ATTR_NON_NULL_PTR_ARG(1)
+				                                          ATTR_NON_NULL_PTR_ARG(3);
+				static uint8_t HID_Parser_StoreReportItem(HID_ParserContext_t* const Context,
+				                                          const HID_ReportItem_t* const NewReportItem) ATTR_NON_NULL_PTR_ARG(1)
+				                                          ATTR_NON_NULL_PTR_ARG(2);
+				static uint8_t HID_Parser_StoreCompactReportItem(HID_ParserContext_t* const Context,
+				                                                 const HID_ReportItem_t* const NewReportItem) ATTR_NON_NULL_PTR_ARG(1)
+				                                                 ATTR_NON_NULL_PTR_ARG(2);
+				static void HID_Parser_StoreCompactCollection(HID_ParserContext_t* const Context,
+				                                              const HID_CollectionPath_t* const CollectionPath)
+				                                              ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+				static bool HID_Parser_CompactAttributesMatch(const HID_ReportItem_Attributes_t* const Attributes,
+				                                              const HID_ReportItem_Attributes_t* const OtherAttributes)
+				                                              ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+				static uint8_t HID_Parser_EncodeAttributes(const HID_ReportItem_Attributes_t* const Attributes,
+				                                           uint8_t* const Buffer) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+				static void HID_Parser_BeginPlan(HID_ReportPlan_t* const Plan, const HID_ReportSizeInfo_t* const ReportIDSizes,
+				                                 const uint8_t TotalDeviceReports, const uint8_t ReportID,
+				                                 const uint8_t ReportType) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+				static bool HID_Parser_AddPlanStep(HID_ReportPlan_t* const Plan, const uint16_t BitOffset,
+				                                   const HID_ReportItem_Attributes_t* const Attributes,
+				                                   const uint16_t ItemIndex) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+			#endif
 	#endif
 			
 	/* Disable C linkage for C++ Compilers: */
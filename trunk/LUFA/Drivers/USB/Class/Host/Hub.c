@@ -0,0 +1,694 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "../../HighLevel/USBMode.h"
+#if defined(USB_CAN_BE_HOST)
+
+#define  __INCLUDE_FROM_HUB_CLASS_HOST_C
+#define  __INCLUDE_FROM_HUB_DRIVER
+#include "Hub.h"
+
+/** Map of the USB device addresses in use, with bit n of byte (n / 8) set for address n. Addresses 0 (the default
+ *  address) and \ref USB_HOST_DEVICEADDRESS (the device attached to the root port) are always reserved. This is shared
+ *  between all hubs, as all downstream devices share a single address space.
+ */
+static uint8_t HUB_Host_UsedAddresses[128 / 8];
+
+/** Service which each pipe is currently bound for, shared between all hubs, so that a pipe shared between several
+ *  services is only rebound when it passes to a different service.
+ */
+static HUB_Host_Service_t* HUB_Host_PipeOwners[PIPE_TOTAL_PIPES];
+
+uint8_t HUB_Host_ConfigurePipes(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, uint16_t ConfigDescriptorSize,
+                                void* DeviceConfigDescriptor)
+{
+	USB_ConfigIndex_t ConfigIndex;
+	uint8_t           ErrorCode;
+
+	if (USB_IndexConfigDescriptor(&ConfigIndex, ConfigDescriptorSize, DeviceConfigDescriptor) == INDEX_CONFIG_InvalidConfigDescriptor)
+	{
+		memset(&HUBInterfaceInfo->State, 0x00, sizeof(HUBInterfaceInfo->State));
+		return HUB_ENUMERROR_InvalidConfigDescriptor;
+	}
+
+	/* Descriptors with more interfaces or endpoints than the index holds are searched a window at a time */
+	while (((ErrorCode = HUB_Host_ConfigurePipesIndexed(HUBInterfaceInfo, &ConfigIndex)) != HUB_ENUMERROR_NoError) &&
+	       USB_IndexNextConfigWindow(&ConfigIndex, ConfigDescriptorSize, DeviceConfigDescriptor));
+
+	return ErrorCode;
+}
+
+uint8_t HUB_Host_ConfigurePipesIndexed(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo,
+                                       const USB_ConfigIndex_t* const ConfigIndex)
+{
+	USB_Descriptor_Endpoint_t* StatusEndpoint;
+	uint8_t                    HubInterface = 0;
+	uint8_t                    ErrorCode = HUB_ENUMERROR_NoHubInterfaceFound;
+
+	memset(&HUBInterfaceInfo->State, 0x00, sizeof(HUBInterfaceInfo->State));
+	memset(HUBInterfaceInfo->Config.Ports, 0x00, (HUBInterfaceInfo->Config.TotalPorts * sizeof(HUB_Host_Port_t)));
+	memset(HUBInterfaceInfo->Config.Services, 0x00, (HUBInterfaceInfo->Config.TotalServices * sizeof(HUB_Host_Service_t)));
+
+	for (;;)
+	{
+		HubInterface = USB_GetIndexedInterface(ConfigIndex, HubInterface, HUB_CLASS, HUB_SUBCLASS,
+		                                       0, (INDEX_MATCH_CLASS | INDEX_MATCH_SUBCLASS));
+
+		if (HubInterface == INDEX_NO_INTERFACE)
+		  return ErrorCode;
+
+		StatusEndpoint = USB_GetIndexedEndpoint(ConfigIndex, HubInterface, EP_TYPE_INTERRUPT, ENDPOINT_DESCRIPTOR_DIR_IN);
+
+		if (StatusEndpoint != NULL)
+		  break;
+
+		ErrorCode = HUB_ENUMERROR_EndpointsNotFound;
+		HubInterface++;
+	}
+
+	HUBInterfaceInfo->State.InterfaceNumber = ConfigIndex->Interfaces[HubInterface].InterfaceDescriptor->InterfaceNumber;
+
+	Pipe_ConfigurePipe(HUBInterfaceInfo->Config.StatusPipeNumber, EP_TYPE_INTERRUPT, PIPE_TOKEN_IN,
+	                   StatusEndpoint->EndpointAddress, StatusEndpoint->EndpointSize, PIPE_BANK_SINGLE);
+	Pipe_SetInterruptPeriod(1);
+
+	HUBInterfaceInfo->State.StatusPipeSize      = StatusEndpoint->EndpointSize;
+	HUBInterfaceInfo->State.StatusPollInterval  = StatusEndpoint->PollingIntervalMS;
+	HUBInterfaceInfo->State.LastStatusPollFrame = USB_Host_GetFrameNumber();
+	HUBInterfaceInfo->State.HubAddress          = USB_Host_GetDeviceAddress();
+	HUBInterfaceInfo->State.HubControlPipeSize  = USB_ControlPipeSize;
+
+	if (HUBInterfaceInfo->State.HubAddress == USB_HOST_DEVICEADDRESS)
+	{
+		memset(HUB_Host_UsedAddresses, 0x00, sizeof(HUB_Host_UsedAddresses));
+		memset(HUB_Host_PipeOwners, 0x00, sizeof(HUB_Host_PipeOwners));
+
+		HUB_Host_UsedAddresses[0] = ((1 << 0) | (1 << USB_HOST_DEVICEADDRESS));
+	}
+
+	HUBInterfaceInfo->State.IsActive = true;
+	return HUB_ENUMERROR_NoError;
+}
+
+uint8_t HUB_Host_PowerPorts(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo)
+{
+	USB_Hub_Descriptor_Hub_t HubDescriptor;
+	uint8_t                  ErrorCode;
+
+	if ((ErrorCode = HUB_Host_GetHubDescriptor(HUBInterfaceInfo, &HubDescriptor)) != HOST_SENDCONTROL_Successful)
+	  return ErrorCode;
+
+	uint8_t TotalPorts = HubDescriptor.TotalPorts;
+
+	if (TotalPorts > HUBInterfaceInfo->Config.TotalPorts)
+	  TotalPorts = HUBInterfaceInfo->Config.TotalPorts;
+
+	if (TotalPorts > HUB_HOST_MAX_PORTS)
+	  TotalPorts = HUB_HOST_MAX_PORTS;
+
+	HUBInterfaceInfo->State.TotalPorts = TotalPorts;
+
+	for (uint8_t PortNumber = 1; PortNumber <= TotalPorts; PortNumber++)
+	{
+		if ((ErrorCode = HUB_Host_SetPortFeature(HUBInterfaceInfo, PortNumber,
+		                                         HUB_FEATURE_PORT_POWER)) != HOST_SENDCONTROL_Successful)
+		{
+			return ErrorCode;
+		}
+	}
+
+	for (uint8_t PowerGoodDelay = HubDescriptor.PowerOnToPowerGood; PowerGoodDelay; PowerGoodDelay--)
+	{
+		if ((ErrorCode = USB_Host_WaitMS(2)) != HOST_WAITERROR_Successful)
+		  return ErrorCode;
+	}
+
+	/* Devices attached before the ports were powered are found via their connection status, so check each port once */
+	HUBInterfaceInfo->State.PortChanges = (uint16_t)(((1UL << (TotalPorts + 1)) - 1) & ~(1 << 0));
+
+	return HOST_SENDCONTROL_Successful;
+}
+
+uint8_t HUB_Host_GetHubDescriptor(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo,
+                                  USB_Hub_Descriptor_Hub_t* const HubDescriptor)
+{
+	return HUB_Host_SendHubRequest(HUBInterfaceInfo, REQ_GetDescriptor, (DTYPE_Hub << 8), 0,
+	                               HubDescriptor, sizeof(USB_Hub_Descriptor_Hub_t));
+}
+
+uint8_t HUB_Host_GetPortStatus(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+                               USB_Hub_PortStatus_t* const PortStatus)
+{
+	return HUB_Host_SendHubRequest(HUBInterfaceInfo, REQ_GetStatus, 0, PortNumber,
+	                               PortStatus, sizeof(USB_Hub_PortStatus_t));
+}
+
+uint8_t HUB_Host_SetPortFeature(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+                                const uint8_t Feature)
+{
+	return HUB_Host_SendHubRequest(HUBInterfaceInfo, REQ_SetFeature, Feature, PortNumber, NULL, 0);
+}
+
+uint8_t HUB_Host_ClearPortFeature(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+                                  const uint8_t Feature)
+{
+	return HUB_Host_SendHubRequest(HUBInterfaceInfo, REQ_ClearFeature, Feature, PortNumber, NULL, 0);
+}
+
+bool HUB_Host_SelectDevice(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber)
+{
+	uint8_t Address;
+	uint8_t ControlPipeSize;
+
+	if (PortNumber)
+	{
+		HUB_Host_Port_t* Port = &HUBInterfaceInfo->Config.Ports[PortNumber - 1];
+
+		if ((PortNumber > HUBInterfaceInfo->State.TotalPorts) || (Port->State != HUB_PORTSTATE_Addressed))
+		  return false;
+
+		Address         = Port->DeviceAddress;
+		ControlPipeSize = Port->ControlPipeSize;
+	}
+	else
+	{
+		Address         = HUBInterfaceInfo->State.HubAddress;
+		ControlPipeSize = HUBInterfaceInfo->State.HubControlPipeSize;
+	}
+
+	return HUB_Host_SelectAddress(Address, ControlPipeSize);
+}
+
+bool HUB_Host_AddService(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+                         const uint8_t Interval, const uint8_t PipeMask, HUB_Host_ServiceCallbackPtr_t Callback)
+{
+	HUB_Host_Service_t* Service = HUBInterfaceInfo->Config.Services;
+
+	if (PipeMask & (1 << HUBInterfaceInfo->Config.StatusPipeNumber))
+	  return false;
+
+	for (uint8_t ServiceIndex = 0; ServiceIndex < HUBInterfaceInfo->Config.TotalServices; ServiceIndex++, Service++)
+	{
+		if (Service->PortNumber)
+		  continue;
+
+		Service->PortNumber       = PortNumber;
+		Service->Interval         = Interval;
+		Service->PipeMask         = PipeMask;
+		Service->LastServiceFrame = USB_Host_GetFrameNumber();
+		Service->Callback         = Callback;
+
+		for (uint8_t PNum = (PIPE_CONTROLPIPE + 1); PNum < PIPE_TOTAL_PIPES; PNum++)
+		{
+			if (!(PipeMask & (1 << PNum)))
+			  continue;
+
+			Pipe_SelectPipe(PNum);
+			Service->PipeBindings[PNum] = Pipe_GetBinding();
+			HUB_Host_PipeOwners[PNum]   = Service;
+		}
+
+		Pipe_SelectPipe(PIPE_CONTROLPIPE);
+		return true;
+	}
+
+	return false;
+}
+
+void HUB_Host_USBTask(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo)
+{
+	if ((USB_HostState != HOST_STATE_Configured) || !(HUBInterfaceInfo->State.IsActive))
+	  return;
+
+	HUB_Host_ReadStatusChanges(HUBInterfaceInfo);
+
+	for (uint8_t PortNumber = 1; PortNumber <= HUBInterfaceInfo->State.TotalPorts; PortNumber++)
+	{
+		if (USB_HostState != HOST_STATE_Configured)
+		  return;
+
+		HUB_Host_ProcessPort(HUBInterfaceInfo, PortNumber);
+	}
+
+	HUB_Host_ServiceDevices(HUBInterfaceInfo);
+
+	if (USB_HostState == HOST_STATE_Configured)
+	  HUB_Host_StartStatusPoll(HUBInterfaceInfo);
+}
+
+static uint8_t HUB_Host_SendHubRequest(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t Request,
+                                       const uint16_t Feature, const uint8_t PortNumber, void* const Buffer,
+                                       const uint16_t Length)
+{
+	if (!(HUB_Host_SelectDevice(HUBInterfaceInfo, 0)))
+	  return HOST_SENDCONTROL_PipeError;
+
+	USB_ControlRequest = (USB_Request_Header_t)
+		{
+			.bmRequestType = ((Length ? REQDIR_DEVICETOHOST : REQDIR_HOSTTODEVICE) | REQTYPE_CLASS |
+			                  (PortNumber ? REQREC_OTHER : REQREC_DEVICE)),
+			.bRequest      = Request,
+			.wValue        = Feature,
+			.wIndex        = PortNumber,
+			.wLength       = Length,
+		};
+
+	return USB_Host_SendControlRequest(Buffer);
+}
+
+static bool HUB_Host_SelectAddress(const uint8_t Address, const uint8_t ControlPipeSize)
+{
+	for (uint8_t PNum = (PIPE_CONTROLPIPE + 1); PNum < PIPE_TOTAL_PIPES; PNum++)
+	{
+		Pipe_SelectPipe(PNum);
+		Pipe_Freeze();
+	}
+
+	Pipe_SelectPipe(PIPE_CONTROLPIPE);
+	USB_Host_SetDeviceAddress(Address);
+
+	/* Resizing reallocates every pipe, so it is only done when consecutive devices differ in control endpoint size */
+	if (ControlPipeSize != USB_ControlPipeSize)
+	  return Pipe_SetControlPipeSize(ControlPipeSize);
+
+	return true;
+}
+
+static uint8_t HUB_Host_AllocateAddress(void)
+{
+	for (uint8_t Address = 0; Address < 128; Address++)
+	{
+		uint8_t* AddressByte = &HUB_Host_UsedAddresses[Address / 8];
+
+		if (!(*AddressByte & (1 << (Address % 8))))
+		{
+			*AddressByte |= (1 << (Address % 8));
+			return Address;
+		}
+	}
+
+	return 0;
+}
+
+static void HUB_Host_StartStatusPoll(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo)
+{
+	uint16_t Elapsed = ((USB_Host_GetFrameNumber() - HUBInterfaceInfo->State.LastStatusPollFrame) & USB_HOST_FRAME_NUMBER_MASK);
+
+	Pipe_SelectPipe(HUBInterfaceInfo->Config.StatusPipeNumber);
+
+	/* A poll is left running until it is answered, unless selecting another device froze it first, in which case it is
+	 * restarted without waiting for the next polling interval */
+	if (!(Pipe_IsFrozen()) || !(HUBInterfaceInfo->State.StatusPollPending || HUBInterfaceInfo->State.EnumeratingPort ||
+	                            (Elapsed >= HUBInterfaceInfo->State.StatusPollInterval)))
+	{
+		Pipe_SelectPipe(PIPE_CONTROLPIPE);
+		return;
+	}
+
+	if (!(HUBInterfaceInfo->State.StatusPollPending))
+	  HUBInterfaceInfo->State.LastStatusPollFrame = USB_Host_GetFrameNumber();
+
+	HUBInterfaceInfo->State.StatusPollPending = true;
+
+	/* The status pipe is not the control pipe, so the hub need only be addressed and the control pipe is left as-is; no
+	 * other pipe can be running while the hub is still addressed, so the address is only rewritten if it has changed */
+	if (USB_Host_GetDeviceAddress() != HUBInterfaceInfo->State.HubAddress)
+	  HUB_Host_SelectAddress(HUBInterfaceInfo->State.HubAddress, USB_ControlPipeSize);
+
+	Pipe_SelectPipe(HUBInterfaceInfo->Config.StatusPipeNumber);
+	Pipe_ClearNAKReceived();
+	Pipe_Unfreeze();
+	Pipe_SelectPipe(PIPE_CONTROLPIPE);
+}
+
+static void HUB_Host_ReadStatusChanges(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo)
+{
+	uint16_t StatusChanges = 0;
+
+	Pipe_SelectPipe(HUBInterfaceInfo->Config.StatusPipeNumber);
+
+	/* The hub NAKs the status pipe until a change occurs, so the first answered token ends the poll; a poll which has
+	 * not yet been answered is left running for the next pass */
+	if (!(Pipe_IsINReceived() || Pipe_IsNAKReceived() || Pipe_IsStalled()))
+	{
+		Pipe_SelectPipe(PIPE_CONTROLPIPE);
+		return;
+	}
+
+	Pipe_Freeze();
+	Pipe_ClearNAKReceived();
+	HUBInterfaceInfo->State.StatusPollPending = false;
+
+	if (Pipe_IsStalled())
+	{
+		Pipe_ClearStall();
+		Pipe_ResetPipe(HUBInterfaceInfo->Config.StatusPipeNumber);
+
+		if (HUB_Host_SelectDevice(HUBInterfaceInfo, 0))
+		{
+			Pipe_SelectPipe(HUBInterfaceInfo->Config.StatusPipeNumber);
+			USB_Host_ClearPipeStall(Pipe_BoundEndpointNumber());
+		}
+
+		return;
+	}
+
+	if (!(Pipe_IsINReceived()))
+	{
+		Pipe_SelectPipe(PIPE_CONTROLPIPE);
+		return;
+	}
+
+	for (uint8_t ByteIndex = 0; Pipe_BytesInPipe(); ByteIndex++)
+	{
+		uint8_t ChangeByte = Pipe_Read_Byte();
+
+		if (ByteIndex < sizeof(StatusChanges))
+		  StatusChanges |= ((uint16_t)ChangeByte << (ByteIndex * 8));
+	}
+
+	Pipe_ClearIN();
+	Pipe_SelectPipe(PIPE_CONTROLPIPE);
+
+	if (StatusChanges & (1 << 0))
+	  HUB_Host_ClearHubChanges(HUBInterfaceInfo);
+
+	HUBInterfaceInfo->State.PortChanges |= (StatusChanges & ~(1 << 0));
+}
+
+static void HUB_Host_ClearHubChanges(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo)
+{
+	USB_Hub_PortStatus_t HubStatus;
+
+	if (HUB_Host_SendHubRequest(HUBInterfaceInfo, REQ_GetStatus, 0, 0, &HubStatus,
+	                            sizeof(HubStatus)) != HOST_SENDCONTROL_Successful)
+	{
+		return;
+	}
+
+	if (HubStatus.Change & (1 << HUB_FEATURE_C_HUB_LOCAL_POWER))
+	  HUB_Host_SendHubRequest(HUBInterfaceInfo, REQ_ClearFeature, HUB_FEATURE_C_HUB_LOCAL_POWER, 0, NULL, 0);
+
+	if (HubStatus.Change & (1 << HUB_FEATURE_C_HUB_OVER_CURRENT))
+	  HUB_Host_SendHubRequest(HUBInterfaceInfo, REQ_ClearFeature, HUB_FEATURE_C_HUB_OVER_CURRENT, 0, NULL, 0);
+}
+
+static void HUB_Host_ProcessPort(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber)
+{
+	HUB_Host_Port_t* Port = &HUBInterfaceInfo->Config.Ports[PortNumber - 1];
+
+	if (HUBInterfaceInfo->State.PortChanges & (1 << PortNumber))
+	{
+		USB_Hub_PortStatus_t PortStatus;
+
+		if (HUB_Host_GetPortStatus(HUBInterfaceInfo, PortNumber, &PortStatus) != HOST_SENDCONTROL_Successful)
+		  return;
+
+		HUBInterfaceInfo->State.PortChanges &= ~(1 << PortNumber);
+
+		for (uint8_t ChangeBit = 0; ChangeBit < 5; ChangeBit++)
+		{
+			if (PortStatus.Change & (1 << ChangeBit))
+			  HUB_Host_ClearPortFeature(HUBInterfaceInfo, PortNumber, (HUB_FEATURE_C_PORT_CONNECTION + ChangeBit));
+		}
+
+		if (!(PortStatus.Status & HUB_PORTSTATUS_CONNECTION))
+		{
+			HUB_Host_DetachPort(HUBInterfaceInfo, PortNumber);
+			return;
+		}
+
+		if ((PortStatus.Change & HUB_PORTCHANGE_CONNECTION) || (Port->State == HUB_PORTSTATE_Disconnected))
+		{
+			HUB_Host_DetachPort(HUBInterfaceInfo, PortNumber);
+			HUB_Host_SetPortState(Port, HUB_PORTSTATE_Debouncing);
+			return;
+		}
+
+		if ((Port->State == HUB_PORTSTATE_Resetting) && (PortStatus.Change & HUB_PORTCHANGE_RESET))
+		{
+			if (PortStatus.Status & HUB_PORTSTATUS_LOW_SPEED)
+			  HUB_Host_FailPort(HUBInterfaceInfo, PortNumber, HUB_PORTERROR_LowSpeedDevice);
+			else if (!(PortStatus.Status & HUB_PORTSTATUS_ENABLE))
+			  HUB_Host_FailPort(HUBInterfaceInfo, PortNumber, HUB_PORTERROR_ResetFailed);
+			else
+			  HUB_Host_SetPortState(Port, HUB_PORTSTATE_ResetRecovery);
+
+			return;
+		}
+	}
+
+	uint16_t Elapsed = ((USB_Host_GetFrameNumber() - Port->StateStartFrame) & USB_HOST_FRAME_NUMBER_MASK);
+
+	switch (Port->State)
+	{
+		case HUB_PORTSTATE_Debouncing:
+			if ((Elapsed < HUB_DEBOUNCE_FRAMES) || HUBInterfaceInfo->State.EnumeratingPort)
+			  break;
+
+			/* Retry on a later pass if the hub cannot be selected until the other pipes' pending data has drained */
+			if (!(HUB_Host_SelectDevice(HUBInterfaceInfo, 0)))
+			  break;
+
+			/* Only one device may use the default address at a time, so hold it until this device is addressed */
+			HUBInterfaceInfo->State.EnumeratingPort = PortNumber;
+
+			if (HUB_Host_SetPortFeature(HUBInterfaceInfo, PortNumber, HUB_FEATURE_PORT_RESET) != HOST_SENDCONTROL_Successful)
+			  HUB_Host_FailPort(HUBInterfaceInfo, PortNumber, HUB_PORTERROR_ControlError);
+			else
+			  HUB_Host_SetPortState(Port, HUB_PORTSTATE_Resetting);
+
+			break;
+		case HUB_PORTSTATE_Resetting:
+			if (Elapsed >= HUB_RESET_TIMEOUT_FRAMES)
+			  HUB_Host_FailPort(HUBInterfaceInfo, PortNumber, HUB_PORTERROR_ResetFailed);
+
+			break;
+		case HUB_PORTSTATE_ResetRecovery:
+			if (Elapsed >= HUB_RESET_RECOVERY_FRAMES)
+			  HUB_Host_AddressDevice(HUBInterfaceInfo, PortNumber);
+
+			break;
+	}
+}
+
+static void HUB_Host_AddressDevice(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber)
+{
+	HUB_Host_Port_t* Port = &HUBInterfaceInfo->Config.Ports[PortNumber - 1];
+	uint8_t          Address;
+	uint8_t          DataBuffer[8];
+
+	/* Retry on a later pass if the control pipe cannot be resized until the other pipes' pending data has drained */
+	if (!(HUB_Host_SelectAddress(0, PIPE_CONTROLPIPE_DEFAULT_SIZE)))
+	  return;
+
+	if (!(Address = HUB_Host_AllocateAddress()))
+	{
+		HUB_Host_FailPort(HUBInterfaceInfo, PortNumber, HUB_PORTERROR_NoFreeAddress);
+		return;
+	}
+
+	USB_ControlRequest = (USB_Request_Header_t)
+		{
+			.bmRequestType = (REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE),
+			.bRequest      = REQ_GetDescriptor,
+			.wValue        = (DTYPE_Device << 8),
+			.wIndex        = 0,
+			.wLength       = sizeof(DataBuffer),
+		};
+
+	Pipe_SelectPipe(PIPE_CONTROLPIPE);
+
+	bool RequestFailed = (USB_Host_SendControlRequest(DataBuffer) != HOST_SENDCONTROL_Successful);
+
+	if (!(RequestFailed))
+	{
+		USB_ControlRequest = (USB_Request_Header_t)
+			{
+				.bmRequestType = (REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_DEVICE),
+				.bRequest      = REQ_SetAddress,
+				.wValue        = Address,
+				.wIndex        = 0,
+				.wLength       = 0,
+			};
+
+		RequestFailed = (USB_Host_SendControlRequest(NULL) != HOST_SENDCONTROL_Successful);
+	}
+
+	if (RequestFailed || (USB_Host_WaitMS(HUB_SET_ADDRESS_RECOVERY_MS) != HOST_WAITERROR_Successful))
+	{
+		HUB_Host_UsedAddresses[Address / 8] &= ~(1 << (Address % 8));
+		HUB_Host_FailPort(HUBInterfaceInfo, PortNumber, HUB_PORTERROR_ControlError);
+		return;
+	}
+
+	HUB_Host_ReleaseDefaultAddress(HUBInterfaceInfo, PortNumber);
+
+	Port->DeviceAddress   = Address;
+	Port->ControlPipeSize = DataBuffer[offsetof(USB_Descriptor_Device_t, Endpoint0Size)];
+	HUB_Host_SetPortState(Port, HUB_PORTSTATE_Addressed);
+
+	if (HUB_Host_SelectDevice(HUBInterfaceInfo, PortNumber))
+	  EVENT_HUB_Host_DeviceAttached(HUBInterfaceInfo, PortNumber);
+}
+
+static void HUB_Host_SetPortState(HUB_Host_Port_t* const Port, const uint8_t State)
+{
+	Port->State           = State;
+	Port->StateStartFrame = USB_Host_GetFrameNumber();
+}
+
+static void HUB_Host_FailPort(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+                              const uint8_t ErrorCode)
+{
+	HUB_Host_ReleaseDefaultAddress(HUBInterfaceInfo, PortNumber);
+	HUB_Host_ClearPortFeature(HUBInterfaceInfo, PortNumber, HUB_FEATURE_PORT_ENABLE);
+	HUB_Host_SetPortState(&HUBInterfaceInfo->Config.Ports[PortNumber - 1], HUB_PORTSTATE_Failed);
+
+	EVENT_HUB_Host_DeviceEnumerationFailed(HUBInterfaceInfo, PortNumber, ErrorCode);
+}
+
+static void HUB_Host_DetachPort(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber)
+{
+	HUB_Host_Port_t*    Port    = &HUBInterfaceInfo->Config.Ports[PortNumber - 1];
+	HUB_Host_Service_t* Service = HUBInterfaceInfo->Config.Services;
+
+	HUB_Host_ReleaseDefaultAddress(HUBInterfaceInfo, PortNumber);
+
+	if (Port->State == HUB_PORTSTATE_Addressed)
+	{
+		EVENT_HUB_Host_DeviceDetached(HUBInterfaceInfo, PortNumber);
+
+		HUB_Host_UsedAddresses[Port->DeviceAddress / 8] &= ~(1 << (Port->DeviceAddress % 8));
+
+		for (uint8_t ServiceIndex = 0; ServiceIndex < HUBInterfaceInfo->Config.TotalServices; ServiceIndex++, Service++)
+		{
+			if (Service->PortNumber != PortNumber)
+			  continue;
+
+			for (uint8_t PNum = (PIPE_CONTROLPIPE + 1); PNum < PIPE_TOTAL_PIPES; PNum++)
+			{
+				if (HUB_Host_PipeOwners[PNum] == Service)
+				  HUB_Host_PipeOwners[PNum] = NULL;
+			}
+
+			Service->PortNumber = 0;
+		}
+	}
+
+	Port->DeviceAddress = 0;
+	HUB_Host_SetPortState(Port, HUB_PORTSTATE_Disconnected);
+}
+
+static void HUB_Host_ReleaseDefaultAddress(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber)
+{
+	if (HUBInterfaceInfo->State.EnumeratingPort == PortNumber)
+	  HUBInterfaceInfo->State.EnumeratingPort = 0;
+}
+
+static void HUB_Host_ServiceDevices(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo)
+{
+	uint8_t TotalServices = HUBInterfaceInfo->Config.TotalServices;
+	uint8_t ServiceIndex  = HUBInterfaceInfo->State.NextService;
+
+	if (!(TotalServices))
+	  return;
+
+	/* Start each pass one service later than the last, so that no service is always last to get the bus */
+	HUBInterfaceInfo->State.NextService = ((ServiceIndex + 1) % TotalServices);
+
+	for (uint8_t ServicesChecked = 0; ServicesChecked < TotalServices; ServicesChecked++)
+	{
+		HUB_Host_Service_t* Service = &HUBInterfaceInfo->Config.Services[ServiceIndex];
+		uint16_t            Elapsed = ((USB_Host_GetFrameNumber() - Service->LastServiceFrame) & USB_HOST_FRAME_NUMBER_MASK);
+
+		if (++ServiceIndex == TotalServices)
+		  ServiceIndex = 0;
+
+		if (!(Service->PortNumber) || (Elapsed < Service->Interval))
+		  continue;
+
+		if (!(HUB_Host_SelectDevice(HUBInterfaceInfo, Service->PortNumber)) || !(HUB_Host_BindServicePipes(Service)))
+		  continue;
+
+		Service->LastServiceFrame = USB_Host_GetFrameNumber();
+		Service->Callback(HUBInterfaceInfo, Service->PortNumber);
+
+		if (USB_HostState != HOST_STATE_Configured)
+		  return;
+	}
+}
+
+static bool HUB_Host_BindServicePipes(HUB_Host_Service_t* const Service)
+{
+	/* Rebinding empties the pipe's banks, so the service is deferred while any pipe it must take over still holds data
+	 * for its current owner; this is checked before any pipe is rebound, so that no rebinding is wasted */
+	for (uint8_t PNum = (PIPE_CONTROLPIPE + 1); PNum < PIPE_TOTAL_PIPES; PNum++)
+	{
+		if (!(Service->PipeMask & (1 << PNum)) || (HUB_Host_PipeOwners[PNum] == Service))
+		  continue;
+
+		Pipe_SelectPipe(PNum);
+
+		if (Pipe_HoldsData())
+		{
+			Pipe_SelectPipe(PIPE_CONTROLPIPE);
+			return false;
+		}
+	}
+
+	for (uint8_t PNum = (PIPE_CONTROLPIPE + 1); PNum < PIPE_TOTAL_PIPES; PNum++)
+	{
+		if (!(Service->PipeMask & (1 << PNum)) || (HUB_Host_PipeOwners[PNum] == Service))
+		  continue;
+
+		Pipe_SelectPipe(PNum);
+		Pipe_SetBinding(Service->PipeBindings[PNum]);
+
+		/* Rebinding resets the pipe's data toggle, so the endpoint's toggle must also be reset to match, at the cost of
+		 * a blocking control transfer per rebound pipe; if it cannot be, ownership is not taken so that the rebinding is
+		 * retried on the service's next run */
+		if (USB_Host_ClearPipeStall(Pipe_BoundEndpointNumber()) != HOST_SENDCONTROL_Successful)
+		  return false;
+
+		HUB_Host_PipeOwners[PNum] = Service;
+	}
+
+	Pipe_SelectPipe(PIPE_CONTROLPIPE);
+	return true;
+}
+
+void HUB_Host_Event_Stub(void)
+{
+
+}
+
+#endif
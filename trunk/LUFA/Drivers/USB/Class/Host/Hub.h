@@ -0,0 +1,438 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \ingroup Group_USBClassHub
+ *  @defgroup Group_USBClassHubHost Hub Class Host Mode Driver
+ *
+ *  \section Sec_Dependencies Module Source Dependencies
+ *  The following files must be built with any user project that uses this module:
+ *    - LUFA/Drivers/USB/Class/Host/Hub.c
+ *
+ *  \section Module Description
+ *  Host Mode USB Class driver framework interface, for the Hub USB Class driver.
+ *
+ *  \section Sec_HUBHostPorts Port Management
+ *  Once the hub has been enumerated as the attached device, bound via \ref HUB_Host_ConfigurePipes() and its ports
+ *  powered via \ref HUB_Host_PowerPorts(), \ref HUB_Host_USBTask() runs a state machine for each downstream port. Newly
+ *  connected devices are debounced, reset and assigned their own USB address one at a time (as only one device may
+ *  respond to the default address), after which the \ref EVENT_HUB_Host_DeviceAttached() event is fired with the new
+ *  device selected so that the application can read its descriptors, set its configuration and bind a class driver
+ *  to it. The \ref EVENT_HUB_Host_DeviceDetached() event is fired when the device is later removed.
+ *
+ *  \section Sec_HUBHostScheduling Device Scheduling
+ *  The USB AVR host controller communicates with a single device address at a time, thus the devices attached to the
+ *  hub must take turns on the bus. Each class driver instance bound to a downstream device is registered as a service
+ *  via \ref HUB_Host_AddService(), giving the pipes the class driver uses and a routine which calls the class driver's
+ *  functions. On each call to \ref HUB_Host_USBTask(), each service whose minimum interval has elapsed is run in round
+ *  robin order with its device selected; all other pipes are frozen while it runs, and must be left frozen when it
+ *  returns. Services may share a pipe provided that each configures the pipe with the same bank size and banking
+ *  mode; when a shared pipe passes to a different service it is rebound to that service's endpoint, and the endpoint's
+ *  data toggle is reset via a ClearFeature request. Each such switch thus adds a control transfer to the service run,
+ *  which blocks for at least two USB frames, so pipes should only be shared between services with long intervals. As
+ *  rebinding empties the pipe, a service run which would take over a pipe still holding data for its previous owner is
+ *  deferred until the previous owner has emptied it.
+ *
+ *  Selecting a device whose control endpoint size differs from the previously selected device's resizes the default
+ *  control pipe, which reallocates every pipe. This is refused while any other pipe holds data, in which case the
+ *  affected hub operation or service run is deferred to a later call to \ref HUB_Host_USBTask(). Grouping devices
+ *  with the same control endpoint size avoids resizing altogether.
+ *
+ *  \note Low Speed devices cannot be used via a hub, as the USB AVR host controller cannot issue the PRE packets they
+ *        require. Such devices are reported via \ref EVENT_HUB_Host_DeviceEnumerationFailed().
+ *
+ *  @{
+ */
+
+#ifndef __HUB_CLASS_HOST_H__
+#define __HUB_CLASS_HOST_H__
+
+	/* Includes: */
+		#include "../../USB.h"
+		#include "../Common/Hub.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_HUB_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/Class/Hub.h instead.
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Maximum number of downstream ports of a single hub which can be managed by the driver. Ports beyond this
+			 *  number, or beyond the number of entries in the Ports configuration element, are left unpowered.
+			 */
+			#define HUB_HOST_MAX_PORTS             15
+
+		/* Type Defines: */
+			/** Type define for the state of a single downstream port of a hub. An array of these structures should be
+			 *  made within the user application and referenced from the Ports configuration element of a
+			 *  \ref USB_ClassInfo_HUB_Host_t instance, with entry 0 corresponding to port 1 of the hub.
+			 */
+			typedef struct
+			{
+				uint8_t  State; /**< Current state of the port, a value from the \ref HUB_Host_PortStates_t enum */
+				uint8_t  DeviceAddress; /**< USB address assigned to the device attached to the port, or zero if none */
+				uint8_t  ControlPipeSize; /**< Size in bytes of the attached device's default control endpoint */
+				uint16_t StateStartFrame; /**< USB frame number at which the port entered its current state */
+			} HUB_Host_Port_t;
+
+			struct USB_ClassInfo_HUB_Host;
+
+			/** Type define for a device service routine, registered via \ref HUB_Host_AddService(). When called, the
+			 *  device attached to the given port is selected and the service's pipes are bound to the device's endpoints
+			 *  but frozen; the routine should perform the device's pending transfers via its class driver, and leave the
+			 *  pipes frozen on return.
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[in] PortNumber  Hub port of the device to service
+			 */
+			typedef void (*HUB_Host_ServiceCallbackPtr_t)(struct USB_ClassInfo_HUB_Host* const HUBInterfaceInfo,
+			                                              const uint8_t PortNumber);
+
+			/** Type define for a single device service slot. An array of these structures should be made within the user
+			 *  application and referenced from the Services configuration element of a \ref USB_ClassInfo_HUB_Host_t
+			 *  instance. Slots are filled by \ref HUB_Host_AddService() and should not be altered by the application.
+			 */
+			typedef struct
+			{
+				uint8_t  PortNumber; /**< Hub port of the serviced device, or zero if the slot is unused */
+				uint8_t  Interval; /**< Minimum number of USB frames between runs of the service */
+				uint8_t  PipeMask; /**< Mask of the pipes used by the service, with bit n set for pipe n */
+				uint8_t  PipeBindings[PIPE_TOTAL_PIPES]; /**< Binding of each used pipe, as retrieved via \ref Pipe_GetBinding() */
+				uint16_t LastServiceFrame; /**< USB frame number of the most recent run of the service */
+				HUB_Host_ServiceCallbackPtr_t Callback; /**< Routine to run the service */
+			} HUB_Host_Service_t;
+
+			/** Class state structure. An instance of this structure should be made within the user application,
+			 *  and passed to each of the Hub class driver functions as the HUBInterfaceInfo parameter. This
+			 *  stores each Hub interface's configuration and state information.
+			 */
+			typedef struct USB_ClassInfo_HUB_Host
+			{
+				const struct
+				{
+					uint8_t  StatusPipeNumber; /**< Pipe number of the Hub interface's status change IN pipe */
+
+					HUB_Host_Port_t* Ports; /**< Pointer to the array of downstream port states */
+					uint8_t  TotalPorts; /**< Number of entries in the array pointed to by the Ports element */
+
+					HUB_Host_Service_t* Services; /**< Pointer to the array of device service slots */
+					uint8_t  TotalServices; /**< Number of entries in the array pointed to by the Services element */
+				} Config; /**< Config data for the USB class interface within the device. All elements in this section
+				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
+				           */
+				struct
+				{
+					bool IsActive; /**< Indicates if the current interface instance is connected to an attached device, valid
+					                *   after \ref HUB_Host_ConfigurePipes() is called and the Host state machine is in the
+					                *   Configured state
+					                */
+					uint8_t  InterfaceNumber; /**< Interface index of the Hub interface within the attached device */
+
+					uint16_t StatusPipeSize; /**< Size in bytes of the Hub interface's status change IN pipe */
+					uint8_t  StatusPollInterval; /**< Number of USB frames between reads of the status change IN pipe */
+					uint16_t LastStatusPollFrame; /**< USB frame number of the most recent read of the status change IN pipe */
+					bool     StatusPollPending; /**< Indicates if a read of the status change IN pipe has been started but not
+					                             *   yet answered by the hub
+					                             */
+
+					uint8_t  HubAddress; /**< USB address of the hub */
+					uint8_t  HubControlPipeSize; /**< Size in bytes of the hub's default control endpoint */
+					uint8_t  TotalPorts; /**< Number of downstream ports managed by the driver, set by \ref HUB_Host_PowerPorts() */
+
+					uint16_t PortChanges; /**< Mask of ports with unprocessed status changes, with bit n set for port n */
+					uint8_t  EnumeratingPort; /**< Port whose device is currently using the default address, or zero if none */
+					uint8_t  NextService; /**< Index of the first service slot to be considered on the next pass */
+				} State; /**< State data for the USB class interface within the device. All elements in this section
+						  *   <b>may</b> be set to initial values, but may also be ignored to default to sane values when
+						  *   the interface is enumerated.
+						  */
+			} USB_ClassInfo_HUB_Host_t;
+
+		/* Enums: */
+			enum HUBHost_EnumerationFailure_ErrorCodes_t
+			{
+				HUB_ENUMERROR_NoError                    = 0, /**< Configuration Descriptor was processed successfully */
+				HUB_ENUMERROR_InvalidConfigDescriptor    = 1, /**< The device returned an invalid Configuration Descriptor */
+				HUB_ENUMERROR_NoHubInterfaceFound        = 2, /**< A compatible Hub interface was not found in the device's Configuration Descriptor */
+				HUB_ENUMERROR_EndpointsNotFound          = 3, /**< Compatible Hub endpoints were not found in the device's interfaces */
+			};
+
+			/** Enum for the possible states of a downstream hub port, stored in the State element of each
+			 *  \ref HUB_Host_Port_t port.
+			 */
+			enum HUB_Host_PortStates_t
+			{
+				HUB_PORTSTATE_Disconnected               = 0, /**< No device is connected to the port */
+				HUB_PORTSTATE_Debouncing                 = 1, /**< A device has been connected, and the connection is being
+				                                               *   debounced or the port is waiting to use the default address
+				                                               */
+				HUB_PORTSTATE_Resetting                  = 2, /**< The port is being reset */
+				HUB_PORTSTATE_ResetRecovery              = 3, /**< The port has been reset, and the device is recovering */
+				HUB_PORTSTATE_Addressed                  = 4, /**< The device has been assigned its USB address */
+				HUB_PORTSTATE_Failed                     = 5, /**< The device could not be enumerated, and the port has been
+				                                               *   disabled until the device is removed
+				                                               */
+			};
+
+			/** Enum for the possible error codes passed to the \ref EVENT_HUB_Host_DeviceEnumerationFailed() event. */
+			enum HUBHost_PortErrorCodes_t
+			{
+				HUB_PORTERROR_ResetFailed                = 0, /**< The port did not complete its reset, or was not enabled */
+				HUB_PORTERROR_LowSpeedDevice             = 1, /**< The device is a Low Speed device, which cannot be used via a hub */
+				HUB_PORTERROR_ControlError               = 2, /**< A control request to the device failed */
+				HUB_PORTERROR_NoFreeAddress              = 3, /**< All USB device addresses are in use */
+			};
+
+		/* Function Prototypes: */
+			/** Host interface configuration routine, to configure a given Hub host interface instance using the
+			 *  Configuration Descriptor read from an attached USB device. This function automatically updates the given Hub
+			 *  instance's state values and configures the pipes required to communicate with the interface if it is found within
+			 *  the device. This should be called once after the stack has enumerated the attached device, while the host state
+			 *  machine is in the Addressed state, or from \ref EVENT_HUB_Host_DeviceAttached() for a hub attached to another hub.
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[in] ConfigDescriptorSize  Length of the attached device's Configuration Descriptor
+			 *  \param[in] DeviceConfigDescriptor  Pointer to a buffer containing the attached device's Configuration Descriptor
+			 *
+			 *  \return A value from the \ref HUBHost_EnumerationFailure_ErrorCodes_t enum
+			 */
+			uint8_t HUB_Host_ConfigurePipes(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, uint16_t ConfigDescriptorSize,
+			                                void* DeviceConfigDescriptor) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Host interface configuration routine, to configure a given Hub host interface instance using a Configuration
+			 *  Descriptor index built by \ref USB_IndexConfigDescriptor(). This behaves as \ref HUB_Host_ConfigurePipes(), but
+			 *  allows the attached device's Configuration Descriptor to be indexed once and then shared between all the class
+			 *  driver instances which are to bind to the device.
+			 *
+			 *  Only the interfaces within the index's current window are searched. If the index is truncated (see
+			 *  \ref USB_IndexNextConfigWindow()) and no matching interface is found, the caller may index the next window
+			 *  and call this function again.
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[in] ConfigIndex  Pointer to an index of the attached device's Configuration Descriptor
+			 *
+			 *  \return A value from the \ref HUBHost_EnumerationFailure_ErrorCodes_t enum
+			 */
+			uint8_t HUB_Host_ConfigurePipesIndexed(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo,
+			                                       const USB_ConfigIndex_t* const ConfigIndex) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Reads the hub's class descriptor, and powers each of the downstream ports managed by the driver, waiting until
+			 *  the port power is good. This should be called once the hub's configuration has been set.
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *
+			 *  \return A value from the \ref USB_Host_SendControlErrorCodes_t enum
+			 */
+			uint8_t HUB_Host_PowerPorts(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Retrieves the fixed length portion of the hub's class descriptor.
+			 *
+			 *  \note This routine selects the hub, see \ref HUB_Host_SelectDevice().
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[out] HubDescriptor  Location where the retrieved hub descriptor should be stored
+			 *
+			 *  \return A value from the \ref USB_Host_SendControlErrorCodes_t enum
+			 */
+			uint8_t HUB_Host_GetHubDescriptor(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo,
+			                                  USB_Hub_Descriptor_Hub_t* const HubDescriptor) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Retrieves the status of a downstream port of the hub.
+			 *
+			 *  \note This routine selects the hub, see \ref HUB_Host_SelectDevice().
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[in] PortNumber  Number of the port, starting from 1
+			 *  \param[out] PortStatus  Location where the retrieved port status should be stored
+			 *
+			 *  \return A value from the \ref USB_Host_SendControlErrorCodes_t enum
+			 */
+			uint8_t HUB_Host_GetPortStatus(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+			                               USB_Hub_PortStatus_t* const PortStatus) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Sets a feature of a downstream port of the hub, such as \ref HUB_FEATURE_PORT_POWER.
+			 *
+			 *  \note This routine selects the hub, see \ref HUB_Host_SelectDevice().
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[in] PortNumber  Number of the port, starting from 1
+			 *  \param[in] Feature  Feature to set, a HUB_FEATURE_* value
+			 *
+			 *  \return A value from the \ref USB_Host_SendControlErrorCodes_t enum
+			 */
+			uint8_t HUB_Host_SetPortFeature(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+			                                const uint8_t Feature) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Clears a feature or change flag of a downstream port of the hub, such as \ref HUB_FEATURE_C_PORT_CONNECTION.
+			 *
+			 *  \note This routine selects the hub, see \ref HUB_Host_SelectDevice().
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[in] PortNumber  Number of the port, starting from 1
+			 *  \param[in] Feature  Feature to clear, a HUB_FEATURE_* value
+			 *
+			 *  \return A value from the \ref USB_Host_SendControlErrorCodes_t enum
+			 */
+			uint8_t HUB_Host_ClearPortFeature(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+			                                  const uint8_t Feature) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Selects the hub or one of the devices attached to its ports as the device that the pipes communicate with,
+			 *  freezing all pipes other than the default control pipe and resizing the control pipe to suit the selected
+			 *  device. The default control pipe is left selected, so that control requests such as
+			 *  \ref USB_Host_SetDeviceConfiguration() may then be issued to the device.
+			 *
+			 *  \see \ref Pipe_SetControlPipeSize() for the conditions under which the control pipe cannot be resized.
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[in] PortNumber  Number of the port whose device is to be selected, or zero to select the hub
+			 *
+			 *  \return Boolean true if the device was selected, false if the port has no addressed device or the control
+			 *          pipe could not be resized for it
+			 */
+			bool HUB_Host_SelectDevice(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber)
+			                           ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Registers a service for a device attached to the hub, to be run from \ref HUB_Host_USBTask() no more often
+			 *  than once per the given number of USB frames. This should be called with the device selected, immediately
+			 *  after the class driver servicing the device has configured its pipes, so that the pipes' bindings to the
+			 *  device's endpoints can be recorded. The service is removed automatically when the device is detached.
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[in] PortNumber  Hub port of the device to service
+			 *  \param[in] Interval  Minimum number of USB frames between runs of the service, such as the polling interval of
+			 *                       the device's interrupt endpoint, or zero to run the service on every pass
+			 *  \param[in] PipeMask  Mask of the pipes used by the service, with bit n set for pipe n
+			 *  \param[in] Callback  Routine to run the service
+			 *
+			 *  \return Boolean true if the service was registered, false if no service slot is free
+			 */
+			bool HUB_Host_AddService(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+			                         const uint8_t Interval, const uint8_t PipeMask,
+			                         HUB_Host_ServiceCallbackPtr_t Callback) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(5);
+
+			/** General management task for a given Hub host class interface, required for the correct operation of
+			 *  the interface. This collects the hub's answer to the previous read of its status change pipe, advances the
+			 *  state machine of each downstream port, runs each due device service in turn, and then starts the next read
+			 *  of the status change pipe once its polling interval has elapsed; the read is not waited for, and is left
+			 *  running until the next call. The device left selected on return is unspecified, so the application should
+			 *  call \ref HUB_Host_SelectDevice() before issuing its own requests to a device. This should be called
+			 *  frequently in the main program loop, before the master USB management task \ref USB_USBTask().
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 */
+			void HUB_Host_USBTask(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Event for a device attached to a downstream port of the hub having been assigned its USB address. The device
+			 *  is selected when the event fires, so that the application may read its descriptors, set its configuration,
+			 *  configure a class driver's pipes and register the class driver via \ref HUB_Host_AddService().
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[in] PortNumber  Hub port of the attached device
+			 */
+			void EVENT_HUB_Host_DeviceAttached(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber);
+
+			/** Event for a previously addressed device having been removed from a downstream port of the hub. The device's
+			 *  services are removed after the event returns.
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[in] PortNumber  Hub port of the removed device
+			 */
+			void EVENT_HUB_Host_DeviceDetached(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber);
+
+			/** Event for a device connected to a downstream port of the hub having failed to enumerate. The port is disabled
+			 *  until the device is removed.
+			 *
+			 *  \param[in,out] HUBInterfaceInfo  Pointer to a structure containing a Hub Class host configuration and state
+			 *  \param[in] PortNumber  Hub port of the device
+			 *  \param[in] ErrorCode  Reason for the failure, a value from the \ref HUBHost_PortErrorCodes_t enum
+			 */
+			void EVENT_HUB_Host_DeviceEnumerationFailed(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+			                                            const uint8_t ErrorCode);
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define HUB_CLASS                      0x09
+			#define HUB_SUBCLASS                   0x00
+
+			#define HUB_FEATURE_C_HUB_LOCAL_POWER  0
+			#define HUB_FEATURE_C_HUB_OVER_CURRENT 1
+
+			#define HUB_DEBOUNCE_FRAMES            100
+			#define HUB_RESET_TIMEOUT_FRAMES       500
+			#define HUB_RESET_RECOVERY_FRAMES      10
+			#define HUB_SET_ADDRESS_RECOVERY_MS    2
+
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_HUB_CLASS_HOST_C)
+				static uint8_t HUB_Host_SendHubRequest(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t Request,
+				                                       const uint16_t Feature, const uint8_t PortNumber, void* const Buffer,
+				                                       const uint16_t Length);
+				static bool    HUB_Host_SelectAddress(const uint8_t Address, const uint8_t ControlPipeSize);
+				static uint8_t HUB_Host_AllocateAddress(void);
+				static void    HUB_Host_StartStatusPoll(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo);
+				static void    HUB_Host_ReadStatusChanges(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo);
+				static void    HUB_Host_ClearHubChanges(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo);
+				static void    HUB_Host_ProcessPort(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber);
+				static void    HUB_Host_AddressDevice(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber);
+				static void    HUB_Host_SetPortState(HUB_Host_Port_t* const Port, const uint8_t State);
+				static void    HUB_Host_FailPort(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+				                                 const uint8_t ErrorCode);
+				static void    HUB_Host_DetachPort(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber);
+				static void    HUB_Host_ReleaseDefaultAddress(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo,
+				                                              const uint8_t PortNumber);
+				static void    HUB_Host_ServiceDevices(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo);
+				static bool    HUB_Host_BindServicePipes(HUB_Host_Service_t* const Service);
+
+				void HUB_Host_Event_Stub(void);
+				void EVENT_HUB_Host_DeviceAttached(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber)
+				                                   ATTR_WEAK ATTR_NON_NULL_PTR_ARG(1) ATTR_ALIAS(HUB_Host_Event_Stub);
+				void EVENT_HUB_Host_DeviceDetached(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber)
+				                                   ATTR_WEAK ATTR_NON_NULL_PTR_ARG(1) ATTR_ALIAS(HUB_Host_Event_Stub);
+				void EVENT_HUB_Host_DeviceEnumerationFailed(USB_ClassInfo_HUB_Host_t* const HUBInterfaceInfo, const uint8_t PortNumber,
+				                                            const uint8_t ErrorCode)
+				                                            ATTR_WEAK ATTR_NON_NULL_PTR_ARG(1) ATTR_ALIAS(HUB_Host_Event_Stub);
+			#endif
+
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
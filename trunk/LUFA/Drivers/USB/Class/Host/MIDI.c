@@ -39,89 +39,62 @@
 uint8_t MIDI_Host_ConfigurePipes(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo, uint16_t ConfigDescriptorSize,
                                  void* ConfigDescriptorData)
 {
-	uint8_t FoundEndpoints = 0;
+	USB_ConfigIndex_t ConfigIndex;
+	uint8_t           ErrorCode;
 
-	memset(&MIDIInterfaceInfo->State, 0x00, sizeof(MIDIInterfaceInfo->State));
-
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
-	  return MIDI_ENUMERROR_InvalidConfigDescriptor;
-	
-	if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-	                              DComp_MIDI_Host_NextMIDIStreamingInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+	if (USB_IndexConfigDescriptor(&ConfigIndex, ConfigDescriptorSize, ConfigDescriptorData) == INDEX_CONFIG_InvalidConfigDescriptor)
 	{
-		return MIDI_ENUMERROR_NoStreamingInterfaceFound;
+		memset(&MIDIInterfaceInfo->State, 0x00, sizeof(MIDIInterfaceInfo->State));
+		return MIDI_ENUMERROR_InvalidConfigDescriptor;
 	}
-	
-	while (FoundEndpoints != (MIDI_FOUND_DATAPIPE_IN | MIDI_FOUND_DATAPIPE_OUT))
-	{
-		if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DComp_MIDI_Host_NextMIDIStreamingDataEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
-		{
-			return MIDI_ENUMERROR_EndpointsNotFound;
-		}
-		
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
-
-		if (EndpointData->EndpointAddress & ENDPOINT_DESCRIPTOR_DIR_IN)
-		{
-			Pipe_ConfigurePipe(MIDIInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
-							   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-							   MIDIInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-			MIDIInterfaceInfo->State.DataINPipeSize = EndpointData->EndpointSize;
-			
-			FoundEndpoints |= MIDI_FOUND_DATAPIPE_IN;
-		}
-		else
-		{
-			Pipe_ConfigurePipe(MIDIInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
-							   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-							   MIDIInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-			MIDIInterfaceInfo->State.DataOUTPipeSize = EndpointData->EndpointSize;
-
-			FoundEndpoints |= MIDI_FOUND_DATAPIPE_OUT;
-		}
-	}
-	
-	MIDIInterfaceInfo->State.IsActive = true;
-	return MIDI_ENUMERROR_NoError;
-}
 
-static uint8_t DComp_MIDI_Host_NextMIDIStreamingInterface(void* const CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		USB_Descriptor_Interface_t* CurrentInterface = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                                USB_Descriptor_Interface_t);
-
-		if ((CurrentInterface->Class    == MIDI_STREAMING_CLASS)    &&
-		    (CurrentInterface->SubClass == MIDI_STREAMING_SUBCLASS) &&
-		    (CurrentInterface->Protocol == MIDI_STREAMING_PROTOCOL))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
-	}
-	
-	return DESCRIPTOR_SEARCH_NotFound;
+	/* Descriptors with more interfaces or endpoints than the index holds are searched a window at a time */
+	while (((ErrorCode = MIDI_Host_ConfigurePipesIndexed(MIDIInterfaceInfo, &ConfigIndex)) != MIDI_ENUMERROR_NoError) &&
+	       USB_IndexNextConfigWindow(&ConfigIndex, ConfigDescriptorSize, ConfigDescriptorData));
+
+	return ErrorCode;
 }
 
-static uint8_t DComp_MIDI_Host_NextMIDIStreamingDataEndpoint(void* const CurrentDescriptor)
+uint8_t MIDI_Host_ConfigurePipesIndexed(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
+                                        const USB_ConfigIndex_t* const ConfigIndex)
 {
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Endpoint)
-	{
-		USB_Descriptor_Endpoint_t* CurrentEndpoint = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                              USB_Descriptor_Endpoint_t);
-	
-		uint8_t EndpointType = (CurrentEndpoint->Attributes & EP_TYPE_MASK);
-	
-		if ((EndpointType == EP_TYPE_BULK) && !(Pipe_IsEndpointBound(CurrentEndpoint->EndpointAddress)))
-		  return DESCRIPTOR_SEARCH_Found;
-	}
-	else if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
+	USB_Descriptor_Endpoint_t* DataINEndpoint;
+	USB_Descriptor_Endpoint_t* DataOUTEndpoint;
+	uint8_t                    StreamingInterface = 0;
+	uint8_t                    ErrorCode = MIDI_ENUMERROR_NoStreamingInterfaceFound;
+
+	memset(&MIDIInterfaceInfo->State, 0x00, sizeof(MIDIInterfaceInfo->State));
+
+	for (;;)
 	{
-		return DESCRIPTOR_SEARCH_Fail;
+		StreamingInterface = USB_GetIndexedInterface(ConfigIndex, StreamingInterface, MIDI_STREAMING_CLASS,
+		                                             MIDI_STREAMING_SUBCLASS, MIDI_STREAMING_PROTOCOL, INDEX_MATCH_ALL);
+
+		if (StreamingInterface == INDEX_NO_INTERFACE)
+		  return ErrorCode;
+
+		DataINEndpoint  = USB_GetIndexedEndpoint(ConfigIndex, StreamingInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_IN);
+		DataOUTEndpoint = USB_GetIndexedEndpoint(ConfigIndex, StreamingInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_OUT);
+
+		if ((DataINEndpoint != NULL) && (DataOUTEndpoint != NULL))
+		  break;
+
+		ErrorCode = MIDI_ENUMERROR_EndpointsNotFound;
+		StreamingInterface++;
 	}
 
-	return DESCRIPTOR_SEARCH_NotFound;
+	Pipe_ConfigurePipe(MIDIInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
+	                   DataINEndpoint->EndpointAddress, DataINEndpoint->EndpointSize,
+	                   MIDIInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	MIDIInterfaceInfo->State.DataINPipeSize = DataINEndpoint->EndpointSize;
+
+	Pipe_ConfigurePipe(MIDIInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
+	                   DataOUTEndpoint->EndpointAddress, DataOUTEndpoint->EndpointSize,
+	                   MIDIInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	MIDIInterfaceInfo->State.DataOUTPipeSize = DataOUTEndpoint->EndpointSize;
+
+	MIDIInterfaceInfo->State.IsActive = true;
+	return MIDI_ENUMERROR_NoError;
 }
 
 uint8_t MIDI_Host_Flush(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo)
@@ -149,38 +122,87 @@ uint8_t MIDI_Host_SendEventPacket(USB_ClassInfo_MIDI_Host_t* const MIDIInterface
 	if ((USB_HostState != HOST_STATE_Configured) || !(MIDIInterfaceInfo->State.IsActive))
 	  return HOST_SENDCONTROL_DeviceDisconnected;
 	
-	Pipe_SelectPipe(MIDIInterfaceInfo->Config.DataOUTPipeNumber);
-
-	if (Pipe_IsReadWriteAllowed())
+	while (!(MIDI_Host_SendEventPackets(MIDIInterfaceInfo, Event, 1)))
 	{
 		uint8_t ErrorCode;
 
-		if ((ErrorCode = Pipe_Write_Stream_LE(Event, sizeof(MIDI_EventPacket_t), NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
+		if ((ErrorCode = Pipe_WaitUntilReady()) != PIPE_READYWAIT_NoError)
 		  return ErrorCode;
+	}
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint16_t MIDI_Host_SendEventPackets(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo, const MIDI_EventPacket_t* const Events,
+                                    const uint16_t TotalEvents)
+{
+	if ((USB_HostState != HOST_STATE_Configured) || !(MIDIInterfaceInfo->State.IsActive))
+	  return 0;
+
+	const uint8_t* EventData  = (const uint8_t*)Events;
+	uint16_t       EventsSent = 0;
+
+	Pipe_SelectPipe(MIDIInterfaceInfo->Config.DataOUTPipeNumber);
+
+	while ((EventsSent < TotalEvents) && Pipe_IsReadWriteAllowed())
+	{
+		uint16_t BankEvents  = ((MIDIInterfaceInfo->State.DataOUTPipeSize - Pipe_BytesInPipe()) / sizeof(MIDI_EventPacket_t));
+		uint16_t BatchEvents = BankEvents;
+
+		/* An empty bank with no room for an event can never be filled, so stop rather than sending empty packets forever */
+		if (!(BankEvents) && !(Pipe_BytesInPipe()))
+		  break;
+
+		if (BatchEvents > (TotalEvents - EventsSent))
+		  BatchEvents = (TotalEvents - EventsSent);
+
+		for (uint16_t BytesRemaining = (BatchEvents * sizeof(MIDI_EventPacket_t)); BytesRemaining; BytesRemaining--)
+		  Pipe_Write_Byte(*(EventData++));
+
+		EventsSent += BatchEvents;
 
-		if (!(Pipe_IsReadWriteAllowed()))
+		if (BatchEvents == BankEvents)
 		  Pipe_ClearOUT();
 	}
-	
-	return PIPE_RWSTREAM_NoError;
+
+	return EventsSent;
 }
 
 bool MIDI_Host_ReceiveEventPacket(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo, MIDI_EventPacket_t* const Event)
+{
+	return (MIDI_Host_ReceiveEventPackets(MIDIInterfaceInfo, Event, 1) != 0);
+}
+
+uint16_t MIDI_Host_ReceiveEventPackets(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo, MIDI_EventPacket_t* const Events,
+                                       const uint16_t MaxEvents)
 {
 	if ((USB_HostState != HOST_STATE_Configured) || !(MIDIInterfaceInfo->State.IsActive))
-	  return HOST_SENDCONTROL_DeviceDisconnected;
-	
+	  return 0;
+
+	uint8_t* EventData      = (uint8_t*)Events;
+	uint16_t EventsReceived = 0;
+
 	Pipe_SelectPipe(MIDIInterfaceInfo->Config.DataINPipeNumber);
 
-	if (!(Pipe_IsReadWriteAllowed()))
-	  return false;
+	while ((EventsReceived < MaxEvents) && Pipe_IsINReceived())
+	{
+		uint16_t BankEvents  = (Pipe_BytesInPipe() / sizeof(MIDI_EventPacket_t));
+		uint16_t BatchEvents = BankEvents;
 
-	Pipe_Read_Stream_LE(Event, sizeof(MIDI_EventPacket_t), NO_STREAM_CALLBACK);
+		if (BatchEvents > (MaxEvents - EventsReceived))
+		  BatchEvents = (MaxEvents - EventsReceived);
 
-	if (!(Pipe_IsReadWriteAllowed()))
-	  Pipe_ClearIN();
-	
-	return true;
+		for (uint16_t BytesRemaining = (BatchEvents * sizeof(MIDI_EventPacket_t)); BytesRemaining; BytesRemaining--)
+		  *(EventData++) = Pipe_Read_Byte();
+
+		EventsReceived += BatchEvents;
+
+		/* Release the bank once all whole event packets have been read, discarding any trailing partial packet */
+		if (BatchEvents == BankEvents)
+		  Pipe_ClearIN();
+	}
+
+	return EventsReceived;
 }
 
 #endif
@@ -34,6 +34,7 @@
  *  \section Sec_Dependencies Module Source Dependencies
  *  The following files must be built with any user project that uses this module:
  *    - LUFA/Drivers/USB/Class/Host/MIDI.c
+ *    - LUFA/Drivers/USB/Class/Common/MIDI.c
  *
  *  \section Module Description
  *  Host Mode USB Class driver framework interface, for the MIDI USB Class driver.
@@ -117,7 +118,25 @@
 			uint8_t MIDI_Host_ConfigurePipes(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo, uint16_t ConfigDescriptorSize,
 			                                 void* DeviceConfigDescriptor) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
 
-			/** Sends a MIDI event packet to the device. If no device is connected, the event packet is discarded.
+			/** Host interface configuration routine, to configure a given MIDI host interface instance using a Configuration
+			 *  Descriptor index built by \ref USB_IndexConfigDescriptor(). This behaves as \ref MIDI_Host_ConfigurePipes(), but
+			 *  allows the attached device's Configuration Descriptor to be indexed once and then shared between all the class
+			 *  driver instances which are to bind to the device.
+			 *
+			 *  Only the interfaces within the index's current window are searched. If the index is truncated (see
+			 *  \ref USB_IndexNextConfigWindow()) and no matching interface is found, the caller may index the next window
+			 *  and call this function again.
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing an MIDI Class host configuration and state
+			 *  \param[in] ConfigIndex  Pointer to an index of the attached device's Configuration Descriptor
+			 *
+			 *  \return A value from the \ref MIDIHost_EnumerationFailure_ErrorCodes_t enum
+			 */
+			uint8_t MIDI_Host_ConfigurePipesIndexed(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
+			                                        const USB_ConfigIndex_t* const ConfigIndex) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Sends a MIDI event packet to the device. If the pipe banks are full, this waits until the device has accepted a bank so
+			 *  that the event can be queued, or until an error occurs; use \ref MIDI_Host_SendEventPackets() to avoid blocking.
 			 *
 			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or the
 			 *        call will fail.
@@ -130,6 +149,23 @@
 			uint8_t MIDI_Host_SendEventPacket(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
 			                                  MIDI_EventPacket_t* const Event) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
+			/** Sends an array of MIDI event packets to the device, filling each free pipe bank with as many of the events as will
+			 *  fit in a single pass rather than one event at a time. Full banks are sent immediately, while a final partially filled
+			 *  bank is queued as with \ref MIDI_Host_SendEventPacket(). This function does not block; once the pipe banks are full
+			 *  the remaining events are left unsent, and should be passed to a later call.
+			 *
+			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or no
+			 *        events will be sent.
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state
+			 *  \param[in] Events  Pointer to an array of populated MIDI_EventPacket_t structures containing the MIDI events to send
+			 *  \param[in] TotalEvents  Number of event packets in the Events array
+			 *
+			 *  \return Number of event packets sent or queued for sending
+			 */
+			uint16_t MIDI_Host_SendEventPackets(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo, const MIDI_EventPacket_t* const Events,
+			                                    const uint16_t TotalEvents) ATTR_NON_NULL_PTR_ARG(1);
+
 			/** Flushes the MIDI send buffer, sending any queued MIDI events to the device. This should be called to override the
 			 *  \ref MIDI_Host_SendEventPacket() function's packing behaviour, to flush queued events. Events are queued into the
 			 *  pipe bank until either the pipe bank is full, or \ref MIDI_Host_Flush() is called. This allows for multiple MIDI
@@ -154,6 +190,22 @@
 			bool MIDI_Host_ReceiveEventPacket(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo,
 			                                  MIDI_EventPacket_t* const Event) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
+			/** Receives up to the given number of MIDI event packets from the device, emptying each received pipe bank into the
+			 *  given array in a single pass rather than one event at a time. This function does not block, returning only the events
+			 *  which have already been received.
+			 *
+			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or no
+			 *        events will be received.
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state
+			 *  \param[out] Events  Pointer to an array of MIDI_EventPacket_t structures where the received MIDI events are to be placed
+			 *  \param[in] MaxEvents  Maximum number of event packets to store into the Events array
+			 *
+			 *  \return Number of event packets received
+			 */
+			uint16_t MIDI_Host_ReceiveEventPackets(USB_ClassInfo_MIDI_Host_t* const MIDIInterfaceInfo, MIDI_EventPacket_t* const Events,
+			                                       const uint16_t MaxEvents) ATTR_NON_NULL_PTR_ARG(1);
+
 		/* Inline Functions: */
 			/** General management task for a given MIDI host class interface, required for the correct operation of the interface. This should
 			 *  be called frequently in the main program loop, before the master USB management task \ref USB_USBTask().
@@ -173,14 +225,6 @@
 			#define MIDI_STREAMING_SUBCLASS        0x03
 			#define MIDI_STREAMING_PROTOCOL        0x00
 			
-			#define MIDI_FOUND_DATAPIPE_IN           (1 << 0)
-			#define MIDI_FOUND_DATAPIPE_OUT          (1 << 1)
-
-		/* Function Prototypes: */
-			#if defined(__INCLUDE_FROM_MIDI_CLASS_HOST_C)
-				static uint8_t DComp_MIDI_Host_NextMIDIStreamingInterface(void* const CurrentDescriptor) ATTR_NON_NULL_PTR_ARG(1);
-				static uint8_t DComp_MIDI_Host_NextMIDIStreamingDataEndpoint(void* const CurrentDescriptor) ATTR_NON_NULL_PTR_ARG(1);
-			#endif	
 	#endif
 				
 	/* Disable C linkage for C++ Compilers: */
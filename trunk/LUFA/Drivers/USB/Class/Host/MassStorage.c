@@ -37,96 +37,66 @@
 #include "MassStorage.h"
 
 uint8_t MS_Host_ConfigurePipes(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo, uint16_t ConfigDescriptorSize,
-							   void* DeviceConfigDescriptor)
+                               void* DeviceConfigDescriptor)
 {
-	uint8_t FoundEndpoints = 0;
-	
-	memset(&MSInterfaceInfo->State, 0x00, sizeof(MSInterfaceInfo->State));
+	USB_ConfigIndex_t ConfigIndex;
+	uint8_t           ErrorCode;
 
-	if (DESCRIPTOR_TYPE(DeviceConfigDescriptor) != DTYPE_Configuration)
-	  return MS_ENUMERROR_InvalidConfigDescriptor;
-	
-	if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &DeviceConfigDescriptor,
-	                              DComp_NextMSInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+	if (USB_IndexConfigDescriptor(&ConfigIndex, ConfigDescriptorSize, DeviceConfigDescriptor) == INDEX_CONFIG_InvalidConfigDescriptor)
 	{
-		return MS_ENUMERROR_NoMSInterfaceFound;
+		memset(&MSInterfaceInfo->State, 0x00, sizeof(MSInterfaceInfo->State));
+		return MS_ENUMERROR_InvalidConfigDescriptor;
 	}
 
-	MSInterfaceInfo->State.InterfaceNumber = DESCRIPTOR_PCAST(DeviceConfigDescriptor, USB_Descriptor_Interface_t)->InterfaceNumber;
-	
-	while (FoundEndpoints != (MS_FOUND_DATAPIPE_IN | MS_FOUND_DATAPIPE_OUT))
-	{
-		if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &DeviceConfigDescriptor,
-		                              DComp_NextMSInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
-		{
-			return MS_ENUMERROR_EndpointsNotFound;
-		}
-		
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(DeviceConfigDescriptor, USB_Descriptor_Endpoint_t);
-
-		if (EndpointData->EndpointAddress & ENDPOINT_DESCRIPTOR_DIR_IN)
-		{
-			Pipe_ConfigurePipe(MSInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
-			                   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-			                   MSInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-			MSInterfaceInfo->State.DataINPipeSize = EndpointData->EndpointSize;
-
-			FoundEndpoints |= MS_FOUND_DATAPIPE_IN;
-		}
-		else
-		{
-			Pipe_ConfigurePipe(MSInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
-			                   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-			                   MSInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-			MSInterfaceInfo->State.DataOUTPipeSize = EndpointData->EndpointSize;
-
-			FoundEndpoints |= MS_FOUND_DATAPIPE_OUT;
-		}		
-	}
+	/* Descriptors with more interfaces or endpoints than the index holds are searched a window at a time */
+	while (((ErrorCode = MS_Host_ConfigurePipesIndexed(MSInterfaceInfo, &ConfigIndex)) != MS_ENUMERROR_NoError) &&
+	       USB_IndexNextConfigWindow(&ConfigIndex, ConfigDescriptorSize, DeviceConfigDescriptor));
 
-	MSInterfaceInfo->State.IsActive = true;
-	return MS_ENUMERROR_NoError;
+	return ErrorCode;
 }
 
-static uint8_t DComp_NextMSInterface(void* const CurrentDescriptor)
+uint8_t MS_Host_ConfigurePipesIndexed(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
+                                      const USB_ConfigIndex_t* const ConfigIndex)
 {
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		USB_Descriptor_Interface_t* CurrentInterface = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                                USB_Descriptor_Interface_t);
+	USB_Descriptor_Endpoint_t* DataINEndpoint;
+	USB_Descriptor_Endpoint_t* DataOUTEndpoint;
+	uint8_t                    MSInterface = 0;
+	uint8_t                    ErrorCode = MS_ENUMERROR_NoMSInterfaceFound;
 
-		if ((CurrentInterface->Class    == MASS_STORE_CLASS)    &&
-		    (CurrentInterface->SubClass == MASS_STORE_SUBCLASS) &&
-		    (CurrentInterface->Protocol == MASS_STORE_PROTOCOL))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
-	}
-	
-	return DESCRIPTOR_SEARCH_NotFound;
-}
+	memset(&MSInterfaceInfo->State, 0x00, sizeof(MSInterfaceInfo->State));
 
-static uint8_t DComp_NextMSInterfaceEndpoint(void* const CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Endpoint)
+	for (;;)
 	{
-		USB_Descriptor_Endpoint_t* CurrentEndpoint = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                              USB_Descriptor_Endpoint_t);
+		MSInterface = USB_GetIndexedInterface(ConfigIndex, MSInterface, MASS_STORE_CLASS, MASS_STORE_SUBCLASS,
+		                                      MASS_STORE_PROTOCOL, INDEX_MATCH_ALL);
 
-		uint8_t EndpointType = (CurrentEndpoint->Attributes & EP_TYPE_MASK);
+		if (MSInterface == INDEX_NO_INTERFACE)
+		  return ErrorCode;
 
-		if ((EndpointType == EP_TYPE_BULK) &&
-		    (!(Pipe_IsEndpointBound(CurrentEndpoint->EndpointAddress))))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
-	}
-	else if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		return DESCRIPTOR_SEARCH_Fail;
+		DataINEndpoint  = USB_GetIndexedEndpoint(ConfigIndex, MSInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_IN);
+		DataOUTEndpoint = USB_GetIndexedEndpoint(ConfigIndex, MSInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_OUT);
+
+		if ((DataINEndpoint != NULL) && (DataOUTEndpoint != NULL))
+		  break;
+
+		ErrorCode = MS_ENUMERROR_EndpointsNotFound;
+		MSInterface++;
 	}
 
-	return DESCRIPTOR_SEARCH_NotFound;
+	MSInterfaceInfo->State.InterfaceNumber = ConfigIndex->Interfaces[MSInterface].InterfaceDescriptor->InterfaceNumber;
+
+	Pipe_ConfigurePipe(MSInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
+	                   DataINEndpoint->EndpointAddress, DataINEndpoint->EndpointSize,
+	                   MSInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	MSInterfaceInfo->State.DataINPipeSize = DataINEndpoint->EndpointSize;
+
+	Pipe_ConfigurePipe(MSInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
+	                   DataOUTEndpoint->EndpointAddress, DataOUTEndpoint->EndpointSize,
+	                   MSInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	MSInterfaceInfo->State.DataOUTPipeSize = DataOUTEndpoint->EndpointSize;
+
+	MSInterfaceInfo->State.IsActive = true;
+	return MS_ENUMERROR_NoError;
 }
 
 static uint8_t MS_Host_SendCommand(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo, MS_CommandBlockWrapper_t* const SCSICommandBlock,
@@ -217,8 +187,9 @@ static uint8_t MS_Host_WaitForDataReceived(USB_ClassInfo_MS_Host_t* const MSInte
 static uint8_t MS_Host_SendReceiveData(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
                                        MS_CommandBlockWrapper_t* const SCSICommandBlock, void* BufferPtr)
 {
-	uint8_t  ErrorCode = PIPE_RWSTREAM_NoError;
-	uint16_t BytesRem  = SCSICommandBlock->DataTransferLength;
+	uint8_t  ErrorCode  = PIPE_RWSTREAM_NoError;
+	uint8_t* DataStream = (uint8_t*)BufferPtr;
+	uint32_t BytesRem   = SCSICommandBlock->DataTransferLength;
 
 	if (SCSICommandBlock->Flags & COMMAND_DIRECTION_DATA_IN)
 	{
@@ -231,8 +202,16 @@ static uint8_t MS_Host_SendReceiveData(USB_ClassInfo_MS_Host_t* const MSInterfac
 		Pipe_SelectPipe(MSInterfaceInfo->Config.DataINPipeNumber);
 		Pipe_Unfreeze();
 		
-		if ((ErrorCode = Pipe_Read_Stream_LE(BufferPtr, BytesRem, NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
-		  return ErrorCode;
+		while (BytesRem)
+		{
+			uint16_t ChunkSize = (BytesRem > MS_STREAM_CHUNK_SIZE) ? MS_STREAM_CHUNK_SIZE : BytesRem;
+
+			if ((ErrorCode = Pipe_Read_Stream_LE(DataStream, ChunkSize, NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
+			  return ErrorCode;
+			
+			DataStream += ChunkSize;
+			BytesRem   -= ChunkSize;
+		}
 
 		Pipe_ClearIN();
 	}
@@ -241,8 +220,16 @@ static uint8_t MS_Host_SendReceiveData(USB_ClassInfo_MS_Host_t* const MSInterfac
 		Pipe_SelectPipe(MSInterfaceInfo->Config.DataOUTPipeNumber);
 		Pipe_Unfreeze();
 
-		if ((ErrorCode = Pipe_Write_Stream_LE(BufferPtr, BytesRem, NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
-		  return ErrorCode;
+		while (BytesRem)
+		{
+			uint16_t ChunkSize = (BytesRem > MS_STREAM_CHUNK_SIZE) ? MS_STREAM_CHUNK_SIZE : BytesRem;
+
+			if ((ErrorCode = Pipe_Write_Stream_LE(DataStream, ChunkSize, NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
+			  return ErrorCode;
+			
+			DataStream += ChunkSize;
+			BytesRem   -= ChunkSize;
+		}
 
 		Pipe_ClearOUT();
 		
@@ -258,6 +245,72 @@ static uint8_t MS_Host_SendReceiveData(USB_ClassInfo_MS_Host_t* const MSInterfac
 	return ErrorCode;
 }
 
+static uint8_t MS_Host_SendReceiveBlocks(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
+                                         MS_CommandBlockWrapper_t* const SCSICommandBlock,
+                                         const uint32_t BlockAddress, const uint16_t Blocks,
+                                         const uint16_t BlockSize, MS_Host_BlockCallbackPtr_t Callback)
+{
+	uint8_t ErrorCode = PIPE_RWSTREAM_NoError;
+
+	if (SCSICommandBlock->Flags & COMMAND_DIRECTION_DATA_IN)
+	{
+		if ((ErrorCode = MS_Host_WaitForDataReceived(MSInterfaceInfo)) != PIPE_RWSTREAM_NoError)
+		{
+			Pipe_Freeze();
+			return ErrorCode;
+		}
+
+		Pipe_SelectPipe(MSInterfaceInfo->Config.DataINPipeNumber);
+		Pipe_Unfreeze();
+
+		for (uint16_t BlockIndex = 0; BlockIndex < Blocks; BlockIndex++)
+		{
+			if ((ErrorCode = Callback(MSInterfaceInfo, (BlockAddress + BlockIndex), BlockSize)) != PIPE_RWSTREAM_NoError)
+			{
+				Pipe_Freeze();
+				return ErrorCode;
+			}
+
+			Pipe_SelectPipe(MSInterfaceInfo->Config.DataINPipeNumber);
+
+			if (!(Pipe_BytesInPipe()))
+			  Pipe_ClearIN();
+		}
+	}
+	else
+	{
+		Pipe_SelectPipe(MSInterfaceInfo->Config.DataOUTPipeNumber);
+		Pipe_Unfreeze();
+
+		for (uint16_t BlockIndex = 0; BlockIndex < Blocks; BlockIndex++)
+		{
+			if ((ErrorCode = Callback(MSInterfaceInfo, (BlockAddress + BlockIndex), BlockSize)) != PIPE_RWSTREAM_NoError)
+			{
+				Pipe_Freeze();
+				return ErrorCode;
+			}
+
+			Pipe_SelectPipe(MSInterfaceInfo->Config.DataOUTPipeNumber);
+
+			if (!(Pipe_IsReadWriteAllowed()))
+			  Pipe_ClearOUT();
+		}
+
+		if (Pipe_BytesInPipe())
+		  Pipe_ClearOUT();
+
+		while (!(Pipe_IsOUTReady()))
+		{
+			if (USB_HostState == HOST_STATE_Unattached)
+			  return PIPE_RWSTREAM_DeviceDisconnected;
+		}
+	}
+
+	Pipe_Freeze();
+
+	return ErrorCode;
+}
+
 static uint8_t MS_Host_GetReturnedStatus(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
                                          MS_CommandStatusWrapper_t* const SCSICommandStatus)
 {
@@ -597,4 +650,441 @@ uint8_t MS_Host_WriteDeviceBlocks(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo
 	return PIPE_RWSTREAM_NoError;
 }
 
+uint8_t MS_Host_ReadDeviceBlocksStreamed(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo, const uint8_t LUNIndex,
+                                         const uint32_t BlockAddress, const uint16_t Blocks, const uint16_t BlockSize,
+                                         MS_Host_BlockCallbackPtr_t Callback)
+{
+	if ((USB_HostState != HOST_STATE_Configured) || !(MSInterfaceInfo->State.IsActive))
+	  return HOST_SENDCONTROL_DeviceDisconnected;
+
+	uint8_t ErrorCode;
+
+	MS_CommandBlockWrapper_t SCSICommandBlock = (MS_CommandBlockWrapper_t)
+		{
+			.Signature          = CBW_SIGNATURE,
+			.DataTransferLength = ((uint32_t)Blocks * BlockSize),
+			.Flags              = COMMAND_DIRECTION_DATA_IN,
+			.LUN                = LUNIndex,
+			.SCSICommandLength  = 10,
+			.SCSICommandData    =
+				{
+					SCSI_CMD_READ_10,
+					0x00,                   // Unused (control bits, all off)
+					(BlockAddress >> 24),   // MSB of Block Address
+					(BlockAddress >> 16),
+					(BlockAddress >> 8),
+					(BlockAddress & 0xFF),  // LSB of Block Address
+					0x00,                   // Unused (reserved)
+					(Blocks >> 8),          // MSB of Total Blocks to Read
+					(Blocks & 0xFF),        // LSB of Total Blocks to Read
+					0x00                    // Unused (control)
+				}
+		};
+
+	MS_CommandStatusWrapper_t SCSICommandStatus;
+
+	if ((ErrorCode = MS_Host_SendCommand(MSInterfaceInfo, &SCSICommandBlock, NULL)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	if ((ErrorCode = MS_Host_SendReceiveBlocks(MSInterfaceInfo, &SCSICommandBlock, BlockAddress, Blocks,
+	                                           BlockSize, Callback)) != PIPE_RWSTREAM_NoError)
+	{
+		return ErrorCode;
+	}
+
+	if ((ErrorCode = MS_Host_GetReturnedStatus(MSInterfaceInfo, &SCSICommandStatus)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint8_t MS_Host_WriteDeviceBlocksStreamed(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo, const uint8_t LUNIndex,
+                                          const uint32_t BlockAddress, const uint16_t Blocks, const uint16_t BlockSize,
+                                          MS_Host_BlockCallbackPtr_t Callback)
+{
+	if ((USB_HostState != HOST_STATE_Configured) || !(MSInterfaceInfo->State.IsActive))
+	  return HOST_SENDCONTROL_DeviceDisconnected;
+
+	uint8_t ErrorCode;
+
+	MS_CommandBlockWrapper_t SCSICommandBlock = (MS_CommandBlockWrapper_t)
+		{
+			.Signature          = CBW_SIGNATURE,
+			.DataTransferLength = ((uint32_t)Blocks * BlockSize),
+			.Flags              = COMMAND_DIRECTION_DATA_OUT,
+			.LUN                = LUNIndex,
+			.SCSICommandLength  = 10,
+			.SCSICommandData    =
+				{
+					SCSI_CMD_WRITE_10,
+					0x00,                   // Unused (control bits, all off)
+					(BlockAddress >> 24),   // MSB of Block Address
+					(BlockAddress >> 16),
+					(BlockAddress >> 8),
+					(BlockAddress & 0xFF),  // LSB of Block Address
+					0x00,                   // Unused (reserved)
+					(Blocks >> 8),          // MSB of Total Blocks to Write
+					(Blocks & 0xFF),        // LSB of Total Blocks to Write
+					0x00                    // Unused (control)
+				}
+		};
+
+	MS_CommandStatusWrapper_t SCSICommandStatus;
+
+	if ((ErrorCode = MS_Host_SendCommand(MSInterfaceInfo, &SCSICommandBlock, NULL)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	if ((ErrorCode = MS_Host_SendReceiveBlocks(MSInterfaceInfo, &SCSICommandBlock, BlockAddress, Blocks,
+	                                           BlockSize, Callback)) != PIPE_RWSTREAM_NoError)
+	{
+		return ErrorCode;
+	}
+
+	if ((ErrorCode = MS_Host_GetReturnedStatus(MSInterfaceInfo, &SCSICommandStatus)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+static MS_Host_Cache_t* MS_Host_Cache_Active;
+
+static uint8_t MS_Host_Cache_FindSlot(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress, const uint8_t FlagMask)
+{
+	for (uint8_t SlotIndex = 0; SlotIndex < Cache->Config.TotalSlots; SlotIndex++)
+	{
+		MS_Host_CacheSlot_t* Slot = &Cache->Config.Slots[SlotIndex];
+
+		if ((Slot->Flags & FlagMask) && (Slot->BlockAddress == BlockAddress))
+		  return SlotIndex;
+	}
+
+	return MS_CACHE_NO_SLOT;
+}
+
+static void MS_Host_Cache_TouchSlot(MS_Host_Cache_t* const Cache, const uint8_t SlotIndex)
+{
+	for (uint8_t CurrSlot = 0; CurrSlot < Cache->Config.TotalSlots; CurrSlot++)
+	{
+		MS_Host_CacheSlot_t* Slot = &Cache->Config.Slots[CurrSlot];
+
+		if (CurrSlot == SlotIndex)
+		  Slot->Age = 0;
+		else if (Slot->Age != 0xFF)
+		  Slot->Age++;
+	}
+}
+
+static uint8_t MS_Host_Cache_AllocateSlot(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress,
+                                          uint8_t* const SlotIndex)
+{
+	uint8_t Victim       = MS_CACHE_NO_SLOT;
+	bool    VictimPinned = true;
+	uint8_t ErrorCode;
+
+	for (uint8_t CurrSlot = 0; CurrSlot < Cache->Config.TotalSlots; CurrSlot++)
+	{
+		MS_Host_CacheSlot_t* Slot = &Cache->Config.Slots[CurrSlot];
+
+		if (Slot->Flags & MS_CACHE_SLOT_FILLING)
+		  continue;
+
+		if (!(Slot->Flags & MS_CACHE_SLOT_VALID))
+		{
+			Victim = CurrSlot;
+			break;
+		}
+
+		bool SlotPinned = ((Slot->BlockAddress >= Cache->State.PinnedStart) &&
+		                   (Slot->BlockAddress <  Cache->State.PinnedEnd));
+
+		if ((Victim == MS_CACHE_NO_SLOT) || (VictimPinned && !(SlotPinned)) ||
+		    ((VictimPinned == SlotPinned) && (Slot->Age > Cache->Config.Slots[Victim].Age)))
+		{
+			Victim       = CurrSlot;
+			VictimPinned = SlotPinned;
+		}
+	}
+
+	if (Victim == MS_CACHE_NO_SLOT)
+	  return MS_ERROR_LOGICAL_CMD_FAILED;
+
+	if ((Cache->Config.Slots[Victim].Flags & MS_CACHE_SLOT_DIRTY) &&
+	    ((ErrorCode = MS_Host_Cache_Flush(Cache)) != PIPE_RWSTREAM_NoError))
+	{
+		return ErrorCode;
+	}
+
+	Cache->Config.Slots[Victim].BlockAddress = BlockAddress;
+	Cache->Config.Slots[Victim].Flags        = 0;
+	MS_Host_Cache_TouchSlot(Cache, Victim);
+
+	*SlotIndex = Victim;
+	return PIPE_RWSTREAM_NoError;
+}
+
+static uint8_t MS_Host_Cache_FillSlot(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
+                                      const uint32_t BlockAddress, const uint16_t BlockSize)
+{
+	uint8_t SlotIndex = MS_Host_Cache_FindSlot(MS_Host_Cache_Active, BlockAddress, MS_CACHE_SLOT_FILLING);
+	uint8_t ErrorCode;
+
+	if (SlotIndex == MS_CACHE_NO_SLOT)
+	  return Pipe_Discard_Stream(BlockSize, NO_STREAM_CALLBACK);
+
+	MS_Host_CacheSlot_t* Slot = &MS_Host_Cache_Active->Config.Slots[SlotIndex];
+
+	if ((ErrorCode = Pipe_Read_Stream_LE(Slot->Data, BlockSize, NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	Slot->Flags |= MS_CACHE_SLOT_VALID;
+	return PIPE_RWSTREAM_NoError;
+}
+
+static uint8_t MS_Host_Cache_WriteBackSlot(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
+                                           const uint32_t BlockAddress, const uint16_t BlockSize)
+{
+	uint8_t SlotIndex = MS_Host_Cache_FindSlot(MS_Host_Cache_Active, BlockAddress, MS_CACHE_SLOT_DIRTY);
+	uint8_t ErrorCode;
+
+	if (SlotIndex == MS_CACHE_NO_SLOT)
+	  return PIPE_RWSTREAM_CallbackAborted;
+
+	MS_Host_CacheSlot_t* Slot = &MS_Host_Cache_Active->Config.Slots[SlotIndex];
+
+	if ((ErrorCode = Pipe_Write_Stream_LE(Slot->Data, BlockSize, NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	Slot->Flags &= ~MS_CACHE_SLOT_DIRTY;
+	return PIPE_RWSTREAM_NoError;
+}
+
+static uint8_t MS_Host_Cache_Fetch(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress,
+                                   const uint16_t RequestedBlocks)
+{
+	uint32_t FetchBlocks = RequestedBlocks;
+	uint8_t  ErrorCode   = PIPE_RWSTREAM_NoError;
+
+	if (BlockAddress == Cache->State.NextSequentialBlock)
+	  FetchBlocks += Cache->Config.ReadAheadBlocks;
+
+	if (FetchBlocks > Cache->Config.TotalSlots)
+	  FetchBlocks = Cache->Config.TotalSlots;
+
+	if (Cache->State.TotalBlocks && (BlockAddress < Cache->State.TotalBlocks) &&
+	    (FetchBlocks > (Cache->State.TotalBlocks - BlockAddress)))
+	{
+		FetchBlocks = (Cache->State.TotalBlocks - BlockAddress);
+	}
+
+	for (uint16_t BlockIndex = 1; BlockIndex < FetchBlocks; BlockIndex++)
+	{
+		if (MS_Host_Cache_FindSlot(Cache, (BlockAddress + BlockIndex), MS_CACHE_SLOT_VALID) != MS_CACHE_NO_SLOT)
+		{
+			FetchBlocks = BlockIndex;
+			break;
+		}
+	}
+
+	for (uint16_t BlockIndex = 0; BlockIndex < FetchBlocks; BlockIndex++)
+	{
+		uint8_t SlotIndex;
+
+		if ((ErrorCode = MS_Host_Cache_AllocateSlot(Cache, (BlockAddress + BlockIndex), &SlotIndex)) != PIPE_RWSTREAM_NoError)
+		  break;
+
+		Cache->Config.Slots[SlotIndex].Flags = MS_CACHE_SLOT_FILLING;
+	}
+
+	if (ErrorCode == PIPE_RWSTREAM_NoError)
+	{
+		MS_Host_Cache_Active = Cache;
+		Cache->State.ReadCommands++;
+
+		if (FetchBlocks > RequestedBlocks)
+		  Cache->State.PrefetchedBlocks += (FetchBlocks - RequestedBlocks);
+
+		ErrorCode = MS_Host_ReadDeviceBlocksStreamed(Cache->Config.MSInterfaceInfo, Cache->Config.LUNIndex, BlockAddress,
+		                                             FetchBlocks, MS_HOST_CACHE_BLOCK_SIZE, MS_Host_Cache_FillSlot);
+	}
+
+	for (uint8_t SlotIndex = 0; SlotIndex < Cache->Config.TotalSlots; SlotIndex++)
+	{
+		MS_Host_CacheSlot_t* Slot = &Cache->Config.Slots[SlotIndex];
+
+		if (Slot->Flags & MS_CACHE_SLOT_FILLING)
+		  Slot->Flags = ((ErrorCode == PIPE_RWSTREAM_NoError) ? (Slot->Flags & MS_CACHE_SLOT_VALID) : 0);
+	}
+
+	return ErrorCode;
+}
+
+static uint8_t MS_Host_Cache_GetSlot(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress,
+                                     const uint16_t RequestedBlocks, uint8_t* const SlotIndex)
+{
+	uint8_t ErrorCode;
+
+	if ((*SlotIndex = MS_Host_Cache_FindSlot(Cache, BlockAddress, MS_CACHE_SLOT_VALID)) != MS_CACHE_NO_SLOT)
+	{
+		Cache->State.Hits++;
+	}
+	else
+	{
+		Cache->State.Misses++;
+
+		if ((ErrorCode = MS_Host_Cache_Fetch(Cache, BlockAddress, RequestedBlocks)) != PIPE_RWSTREAM_NoError)
+		  return ErrorCode;
+
+		if ((*SlotIndex = MS_Host_Cache_FindSlot(Cache, BlockAddress, MS_CACHE_SLOT_VALID)) == MS_CACHE_NO_SLOT)
+		  return MS_ERROR_LOGICAL_CMD_FAILED;
+	}
+
+	MS_Host_Cache_TouchSlot(Cache, *SlotIndex);
+	Cache->State.NextSequentialBlock = (BlockAddress + 1);
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint8_t MS_Host_Cache_Init(MS_Host_Cache_t* const Cache)
+{
+	SCSI_Capacity_t Capacity;
+	uint8_t         ErrorCode;
+
+	MS_Host_Cache_Invalidate(Cache);
+	memset(&Cache->State, 0x00, sizeof(Cache->State));
+
+	if ((ErrorCode = MS_Host_ReadDeviceCapacity(Cache->Config.MSInterfaceInfo, Cache->Config.LUNIndex,
+	                                            &Capacity)) != PIPE_RWSTREAM_NoError)
+	{
+		return ErrorCode;
+	}
+
+	if (Capacity.BlockSize != MS_HOST_CACHE_BLOCK_SIZE)
+	  return MS_ERROR_LOGICAL_CMD_FAILED;
+
+	Cache->State.TotalBlocks = (Capacity.Blocks + 1);
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+void MS_Host_Cache_SetPinnedRegion(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress, const uint32_t Blocks)
+{
+	Cache->State.PinnedStart = BlockAddress;
+	Cache->State.PinnedEnd   = (BlockAddress + Blocks);
+}
+
+uint8_t MS_Host_Cache_GetBlock(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress, uint8_t** const BlockData)
+{
+	uint8_t SlotIndex;
+	uint8_t ErrorCode;
+
+	if ((ErrorCode = MS_Host_Cache_GetSlot(Cache, BlockAddress, 1, &SlotIndex)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	*BlockData = Cache->Config.Slots[SlotIndex].Data;
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint8_t MS_Host_Cache_ReadBlocks(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress, const uint16_t Blocks,
+                                 void* BlockBuffer)
+{
+	uint8_t* DataStream = (uint8_t*)BlockBuffer;
+	uint8_t  ErrorCode;
+
+	for (uint16_t BlockIndex = 0; BlockIndex < Blocks; BlockIndex++)
+	{
+		uint8_t SlotIndex;
+
+		if ((ErrorCode = MS_Host_Cache_GetSlot(Cache, (BlockAddress + BlockIndex), (Blocks - BlockIndex),
+		                                       &SlotIndex)) != PIPE_RWSTREAM_NoError)
+		{
+			return ErrorCode;
+		}
+
+		memcpy(DataStream, Cache->Config.Slots[SlotIndex].Data, MS_HOST_CACHE_BLOCK_SIZE);
+		DataStream += MS_HOST_CACHE_BLOCK_SIZE;
+	}
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint8_t MS_Host_Cache_WriteBlocks(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress, const uint16_t Blocks,
+                                  const void* BlockBuffer)
+{
+	const uint8_t* DataStream = (const uint8_t*)BlockBuffer;
+	uint8_t        ErrorCode;
+
+	for (uint16_t BlockIndex = 0; BlockIndex < Blocks; BlockIndex++)
+	{
+		uint32_t CurrentBlock = (BlockAddress + BlockIndex);
+		uint8_t  SlotIndex    = MS_Host_Cache_FindSlot(Cache, CurrentBlock, MS_CACHE_SLOT_VALID);
+
+		if ((SlotIndex == MS_CACHE_NO_SLOT) &&
+		    ((ErrorCode = MS_Host_Cache_AllocateSlot(Cache, CurrentBlock, &SlotIndex)) != PIPE_RWSTREAM_NoError))
+		{
+			return ErrorCode;
+		}
+
+		MS_Host_CacheSlot_t* Slot = &Cache->Config.Slots[SlotIndex];
+
+		memcpy(Slot->Data, DataStream, MS_HOST_CACHE_BLOCK_SIZE);
+		Slot->Flags = (MS_CACHE_SLOT_VALID | MS_CACHE_SLOT_DIRTY);
+		MS_Host_Cache_TouchSlot(Cache, SlotIndex);
+
+		DataStream += MS_HOST_CACHE_BLOCK_SIZE;
+	}
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint8_t MS_Host_Cache_Flush(MS_Host_Cache_t* const Cache)
+{
+	uint8_t ErrorCode;
+
+	for (;;)
+	{
+		uint8_t FirstSlot = MS_CACHE_NO_SLOT;
+
+		for (uint8_t SlotIndex = 0; SlotIndex < Cache->Config.TotalSlots; SlotIndex++)
+		{
+			MS_Host_CacheSlot_t* Slot = &Cache->Config.Slots[SlotIndex];
+
+			if ((Slot->Flags & MS_CACHE_SLOT_DIRTY) &&
+			    ((FirstSlot == MS_CACHE_NO_SLOT) || (Slot->BlockAddress < Cache->Config.Slots[FirstSlot].BlockAddress)))
+			{
+				FirstSlot = SlotIndex;
+			}
+		}
+
+		if (FirstSlot == MS_CACHE_NO_SLOT)
+		  break;
+
+		uint32_t RunStart  = Cache->Config.Slots[FirstSlot].BlockAddress;
+		uint16_t RunBlocks = 1;
+
+		while (MS_Host_Cache_FindSlot(Cache, (RunStart + RunBlocks), MS_CACHE_SLOT_DIRTY) != MS_CACHE_NO_SLOT)
+		  RunBlocks++;
+
+		MS_Host_Cache_Active = Cache;
+		Cache->State.WriteCommands++;
+
+		if ((ErrorCode = MS_Host_WriteDeviceBlocksStreamed(Cache->Config.MSInterfaceInfo, Cache->Config.LUNIndex, RunStart,
+		                                                   RunBlocks, MS_HOST_CACHE_BLOCK_SIZE,
+		                                                   MS_Host_Cache_WriteBackSlot)) != PIPE_RWSTREAM_NoError)
+		{
+			return ErrorCode;
+		}
+	}
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+void MS_Host_Cache_Invalidate(MS_Host_Cache_t* const Cache)
+{
+	for (uint8_t SlotIndex = 0; SlotIndex < Cache->Config.TotalSlots; SlotIndex++)
+	{
+		Cache->Config.Slots[SlotIndex].Flags = 0;
+		Cache->Config.Slots[SlotIndex].Age   = 0xFF;
+	}
+}
+
 #endif
@@ -38,6 +38,23 @@
  *  \section Module Description
  *  Host Mode USB Class driver framework interface, for the Mass Storage USB Class driver.
  *
+ *  \section Sec_MSHostCache Block Cache
+ *  An optional block cache may be placed between a filesystem driver and the attached device, so that repeatedly
+ *  accessed blocks (such as the FAT and directory sectors of a FAT filesystem) do not cost a complete SCSI command
+ *  each time they are read. The cache is created by the user application as a \ref MS_Host_Cache_t instance along
+ *  with an array of \ref MS_Host_CacheSlot_t block slots, and is accessed via the MS_Host_Cache_* functions:
+ *
+ *    - Slots are replaced in least recently used order, except that slots holding blocks within the pinned region set
+ *      via \ref MS_Host_Cache_SetPinnedRegion() are only replaced once no unpinned slots remain.
+ *    - Cache misses which continue on from the previous read prefetch further blocks in the same SCSI command,
+ *      up to the number configured in the cache's ReadAheadBlocks configuration element.
+ *    - Writes are held in the cache until their slots are replaced or \ref MS_Host_Cache_Flush() is called, at which
+ *      point runs of consecutive dirty blocks are written back with a single SCSI command each. A FatFs disk_ioctl()
+ *      implementation should call \ref MS_Host_Cache_Flush() in response to a CTRL_SYNC request.
+ *
+ *  Hit, miss and device command counters are kept in the cache's state so that the number of slots and amount of
+ *  read-ahead may be tuned for a given application.
+ *
  *  @{
  */
 
@@ -62,6 +79,20 @@
 		/* Macros: */
 			/** Error code for some Mass Storage Host functions, indicating a logical (and not hardware) error */
 			#define MS_ERROR_LOGICAL_CMD_FAILED              0x80
+
+			/** Size in bytes of each block held in a \ref MS_Host_CacheSlot_t block cache slot. Only media with this
+			 *  block size may be accessed via the block cache.
+			 */
+			#define MS_HOST_CACHE_BLOCK_SIZE                 512
+
+			/** Flag for \ref MS_Host_CacheSlot_t.Flags, indicating that the slot holds valid block data. */
+			#define MS_CACHE_SLOT_VALID                      (1 << 0)
+
+			/** Flag for \ref MS_Host_CacheSlot_t.Flags, indicating that the slot holds data not yet written to the device. */
+			#define MS_CACHE_SLOT_DIRTY                      (1 << 1)
+
+			/** Flag for \ref MS_Host_CacheSlot_t.Flags, indicating that the slot is awaiting data from the device. */
+			#define MS_CACHE_SLOT_FILLING                    (1 << 2)
 	
 		/* Type Defines: */
 			/** Class state structure. An instance of this structure should be made within the user application,
@@ -108,6 +139,72 @@
 				uint32_t BlockSize; /**< Number of bytes in each block in the addressed LUN */
 			} SCSI_Capacity_t;
 
+			/** Type define for a single block slot of a Mass Storage host block cache. An array of these structures
+			 *  should be made within the user application and referenced from the Slots configuration element of a
+			 *  \ref MS_Host_Cache_t instance.
+			 */
+			typedef struct
+			{
+				uint32_t BlockAddress; /**< Address of the block held in the slot */
+				uint8_t  Flags; /**< Mask of MS_CACHE_SLOT_* flags indicating the slot's current status */
+				uint8_t  Age; /**< Number of cache accesses since the slot was last used, saturating at 255 */
+				uint8_t  Data[MS_HOST_CACHE_BLOCK_SIZE]; /**< Cached block data */
+			} MS_Host_CacheSlot_t;
+
+			/** Block cache structure. An instance of this structure should be made within the user application, and
+			 *  passed to each of the MS_Host_Cache_* functions as the Cache parameter. This stores the cache's
+			 *  configuration and state information, including its hit and miss counters.
+			 */
+			typedef struct
+			{
+				const struct
+				{
+					USB_ClassInfo_MS_Host_t* MSInterfaceInfo; /**< Mass Storage interface of the cached device */
+					uint8_t  LUNIndex; /**< LUN index within the device of the cached medium */
+
+					MS_Host_CacheSlot_t* Slots; /**< Pointer to the array of slots used to hold cached blocks */
+					uint8_t  TotalSlots; /**< Number of slots in the array pointed to by the Slots element */
+
+					uint8_t  ReadAheadBlocks; /**< Maximum number of blocks beyond the requested block to prefetch when a
+					                           *   sequential read misses the cache, or zero to disable read-ahead
+					                           */
+				} Config; /**< Config data for the block cache. All elements in this section <b>must</b> be set or the
+				           *   cache will fail to operate correctly.
+				           */
+				struct
+				{
+					uint32_t TotalBlocks; /**< Number of blocks in the cached medium, read by \ref MS_Host_Cache_Init() */
+					uint32_t PinnedStart; /**< First block address of the pinned region */
+					uint32_t PinnedEnd; /**< Block address immediately following the pinned region */
+					uint32_t NextSequentialBlock; /**< Block address immediately following the last read block */
+
+					uint32_t Hits; /**< Number of block reads served from the cache */
+					uint32_t Misses; /**< Number of block reads which required a read from the device */
+					uint32_t PrefetchedBlocks; /**< Number of blocks read from the device ahead of being requested */
+					uint32_t ReadCommands; /**< Number of SCSI read commands issued to the device */
+					uint32_t WriteCommands; /**< Number of SCSI write commands issued to the device */
+				} State; /**< State data for the block cache. All elements in this section are reset by
+				          *   \ref MS_Host_Cache_Init().
+				          */
+			} MS_Host_Cache_t;
+
+			/** Type define for a block transfer callback routine, used by \ref MS_Host_ReadDeviceBlocksStreamed() and
+			 *  \ref MS_Host_WriteDeviceBlocksStreamed() to transfer each block of data directly to or from the Mass Storage
+			 *  interface's data pipes. When called, the appropriate IN or OUT data pipe is selected and unfrozen, and the
+			 *  callback must read or write exactly one block of data via the pipe stream functions (such as
+			 *  \ref Pipe_Read_Stream_LE(), \ref Pipe_Discard_Stream() or \ref Pipe_Write_Stream_LE()). The data pipe must
+			 *  remain selected on return.
+			 *
+			 *  \param[in,out] MSInterfaceInfo  Pointer to a structure containing a MS Class host configuration and state
+			 *  \param[in] BlockAddress  Address of the block to transfer within the device
+			 *  \param[in] BlockSize  Size in bytes of the block to transfer
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum, where any value other than
+			 *          \ref PIPE_RWSTREAM_NoError aborts the transfer
+			 */
+			typedef uint8_t (*MS_Host_BlockCallbackPtr_t)(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
+			                                              const uint32_t BlockAddress, const uint16_t BlockSize);
+
 		/* Enums: */
 			enum MSHost_EnumerationFailure_ErrorCodes_t
 			{
@@ -133,6 +230,23 @@
 			uint8_t MS_Host_ConfigurePipes(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo, uint16_t ConfigDescriptorSize,
 			                               void* DeviceConfigDescriptor) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
 
+			/** Host interface configuration routine, to configure a given Mass Storage host interface instance using a Configuration
+			 *  Descriptor index built by \ref USB_IndexConfigDescriptor(). This behaves as \ref MS_Host_ConfigurePipes(), but
+			 *  allows the attached device's Configuration Descriptor to be indexed once and then shared between all the class
+			 *  driver instances which are to bind to the device.
+			 *
+			 *  Only the interfaces within the index's current window are searched. If the index is truncated (see
+			 *  \ref USB_IndexNextConfigWindow()) and no matching interface is found, the caller may index the next window
+			 *  and call this function again.
+			 *
+			 *  \param[in,out] MSInterfaceInfo  Pointer to a structure containing an MS Class host configuration and state
+			 *  \param[in] ConfigIndex  Pointer to an index of the attached device's Configuration Descriptor
+			 *
+			 *  \return A value from the \ref MSHost_EnumerationFailure_ErrorCodes_t enum
+			 */
+			uint8_t MS_Host_ConfigurePipesIndexed(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
+			                                      const USB_ConfigIndex_t* const ConfigIndex) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
 			/** Sends a MASS STORAGE RESET control request to the attached device, resetting the Mass Storage Interface
 			 *  and readying it for the next Mass Storage command.
 			 *
@@ -266,6 +380,129 @@
 			                                  const uint32_t BlockAddress, const uint8_t Blocks, const uint16_t BlockSize,
 			                                  void* BlockBuffer) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(6);
 
+			/** Reads blocks of data from the attached Mass Storage device's medium using a single SCSI command, passing
+			 *  each block to the given callback routine as it arrives rather than storing the entire transfer into RAM.
+			 *  This allows large multi-block reads (such as a whole filesystem cluster) to be performed with the command
+			 *  and status overhead paid only once, and with no more RAM than the callback requires.
+			 *
+			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or the
+			 *        call will fail.
+			 *
+			 *  \note If the transfer is aborted part way through by the callback or a pipe error, the interface should be reset
+			 *        via \ref MS_Host_ResetMSInterface() before it is used again.
+			 *
+			 *  \param[in,out] MSInterfaceInfo  Pointer to a structure containing a MS Class host configuration and state
+			 *  \param[in] LUNIndex  LUN index within the device the command is being issued to
+			 *  \param[in] BlockAddress  Starting block address within the device to read from
+			 *  \param[in] Blocks  Total number of blocks to read
+			 *  \param[in] BlockSize  Size in bytes of each block within the device
+			 *  \param[in] Callback  Routine to read each block of data from the IN data pipe
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum or MS_ERROR_LOGICAL_CMD_FAILED if not ready
+			 */
+			uint8_t MS_Host_ReadDeviceBlocksStreamed(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo, const uint8_t LUNIndex,
+			                                         const uint32_t BlockAddress, const uint16_t Blocks, const uint16_t BlockSize,
+			                                         MS_Host_BlockCallbackPtr_t Callback) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(6);
+
+			/** Writes blocks of data to the attached Mass Storage device's medium using a single SCSI command, requesting
+			 *  each block from the given callback routine as the device is ready for it rather than sourcing the entire
+			 *  transfer from RAM.
+			 *
+			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or the
+			 *        call will fail.
+			 *
+			 *  \note If the transfer is aborted part way through by the callback or a pipe error, the interface should be reset
+			 *        via \ref MS_Host_ResetMSInterface() before it is used again.
+			 *
+			 *  \param[in,out] MSInterfaceInfo  Pointer to a structure containing a MS Class host configuration and state
+			 *  \param[in] LUNIndex  LUN index within the device the command is being issued to
+			 *  \param[in] BlockAddress  Starting block address within the device to write to
+			 *  \param[in] Blocks  Total number of blocks to write
+			 *  \param[in] BlockSize  Size in bytes of each block within the device
+			 *  \param[in] Callback  Routine to write each block of data to the OUT data pipe
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum or MS_ERROR_LOGICAL_CMD_FAILED if not ready
+			 */
+			uint8_t MS_Host_WriteDeviceBlocksStreamed(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo, const uint8_t LUNIndex,
+			                                          const uint32_t BlockAddress, const uint16_t Blocks, const uint16_t BlockSize,
+			                                          MS_Host_BlockCallbackPtr_t Callback) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(6);
+
+			/** Initializes a block cache, discarding any cached blocks and resetting its counters, and reads the capacity of
+			 *  the cached medium so that read-ahead is not performed past its end. This should be called each time the
+			 *  cached device is configured, once the Host state machine is in the HOST_STATE_Configured state.
+			 *
+			 *  \param[in,out] Cache  Pointer to a structure containing a block cache configuration and state
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum or MS_ERROR_LOGICAL_CMD_FAILED if not ready or
+			 *          the medium's block size is not \ref MS_HOST_CACHE_BLOCK_SIZE
+			 */
+			uint8_t MS_Host_Cache_Init(MS_Host_Cache_t* const Cache) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Sets the region of the medium whose blocks should be retained in the cache in preference to others, such as
+			 *  the FAT and root directory of a FAT filesystem.
+			 *
+			 *  \param[in,out] Cache  Pointer to a structure containing a block cache configuration and state
+			 *  \param[in] BlockAddress  First block address of the pinned region
+			 *  \param[in] Blocks  Number of blocks in the pinned region, or zero to remove the pinned region
+			 */
+			void MS_Host_Cache_SetPinnedRegion(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress,
+			                                   const uint32_t Blocks) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Retrieves a block from the cache, reading it (and any read-ahead blocks) from the device if it is not
+			 *  already cached. The returned pointer references the block's slot within the cache, and is only valid
+			 *  until the next call to a block cache function.
+			 *
+			 *  \param[in,out] Cache  Pointer to a structure containing a block cache configuration and state
+			 *  \param[in] BlockAddress  Address of the block to retrieve
+			 *  \param[out] BlockData  Pointer to a location where the address of the cached block data is to be stored
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum or MS_ERROR_LOGICAL_CMD_FAILED if not ready
+			 */
+			uint8_t MS_Host_Cache_GetBlock(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress,
+			                               uint8_t** const BlockData) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Reads blocks through the cache into the given buffer, reading any blocks which are not already cached from
+			 *  the device in as few SCSI commands as possible.
+			 *
+			 *  \param[in,out] Cache  Pointer to a structure containing a block cache configuration and state
+			 *  \param[in] BlockAddress  Starting block address to read from
+			 *  \param[in] Blocks  Total number of blocks to read
+			 *  \param[out] BlockBuffer  Pointer to where the read data is to be stored
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum or MS_ERROR_LOGICAL_CMD_FAILED if not ready
+			 */
+			uint8_t MS_Host_Cache_ReadBlocks(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress, const uint16_t Blocks,
+			                                 void* BlockBuffer) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(4);
+
+			/** Writes blocks into the cache from the given buffer. The blocks are not written to the device until their
+			 *  slots are replaced or \ref MS_Host_Cache_Flush() is called.
+			 *
+			 *  \param[in,out] Cache  Pointer to a structure containing a block cache configuration and state
+			 *  \param[in] BlockAddress  Starting block address to write to
+			 *  \param[in] Blocks  Total number of blocks to write
+			 *  \param[in] BlockBuffer  Pointer to the data to write
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum or MS_ERROR_LOGICAL_CMD_FAILED if not ready
+			 */
+			uint8_t MS_Host_Cache_WriteBlocks(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress, const uint16_t Blocks,
+			                                  const void* BlockBuffer) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(4);
+
+			/** Writes all dirty blocks held in the cache back to the device, issuing a single SCSI command for each run of
+			 *  consecutive dirty blocks.
+			 *
+			 *  \param[in,out] Cache  Pointer to a structure containing a block cache configuration and state
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum or MS_ERROR_LOGICAL_CMD_FAILED if not ready
+			 */
+			uint8_t MS_Host_Cache_Flush(MS_Host_Cache_t* const Cache) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Discards all blocks held in the cache, including any dirty blocks not yet written to the device. This should
+			 *  be called when the cached device is removed.
+			 *
+			 *  \param[in,out] Cache  Pointer to a structure containing a block cache configuration and state
+			 */
+			void MS_Host_Cache_Invalidate(MS_Host_Cache_t* const Cache) ATTR_NON_NULL_PTR_ARG(1);
+
 		/* Inline Functions: */
 			/** General management task for a given Mass Storage host class interface, required for the correct operation of
 			 *  the interface. This should be called frequently in the main program loop, before the master USB management task
@@ -297,13 +534,12 @@
 			
 			#define COMMAND_DATA_TIMEOUT_MS        10000
 
-			#define MS_FOUND_DATAPIPE_IN           (1 << 0)
-			#define MS_FOUND_DATAPIPE_OUT          (1 << 1)
+			#define MS_STREAM_CHUNK_SIZE           0x8000
+
+			#define MS_CACHE_NO_SLOT               0xFF
 			
 		/* Function Prototypes: */
 			#if defined(__INCLUDE_FROM_MS_CLASS_HOST_C)		
-				static uint8_t DComp_NextMSInterface(void* const CurrentDescriptor);
-				static uint8_t DComp_NextMSInterfaceEndpoint(void* const CurrentDescriptor);
 				
 				static uint8_t MS_Host_SendCommand(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
 				                                   MS_CommandBlockWrapper_t* const SCSICommandBlock,
@@ -313,6 +549,24 @@
                                                        MS_CommandBlockWrapper_t* const SCSICommandBlock, void* BufferPtr);
 				static uint8_t MS_Host_GetReturnedStatus(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
 				                                         MS_CommandStatusWrapper_t* const SCSICommandStatus);
+				static uint8_t MS_Host_SendReceiveBlocks(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
+				                                         MS_CommandBlockWrapper_t* const SCSICommandBlock,
+				                                         const uint32_t BlockAddress, const uint16_t Blocks,
+				                                         const uint16_t BlockSize, MS_Host_BlockCallbackPtr_t Callback);
+
+				static uint8_t MS_Host_Cache_FindSlot(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress,
+				                                      const uint8_t FlagMask);
+				static void    MS_Host_Cache_TouchSlot(MS_Host_Cache_t* const Cache, const uint8_t SlotIndex);
+				static uint8_t MS_Host_Cache_AllocateSlot(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress,
+				                                          uint8_t* const SlotIndex);
+				static uint8_t MS_Host_Cache_Fetch(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress,
+				                                   const uint16_t RequestedBlocks);
+				static uint8_t MS_Host_Cache_GetSlot(MS_Host_Cache_t* const Cache, const uint32_t BlockAddress,
+				                                     const uint16_t RequestedBlocks, uint8_t* const SlotIndex);
+				static uint8_t MS_Host_Cache_FillSlot(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
+				                                      const uint32_t BlockAddress, const uint16_t BlockSize);
+				static uint8_t MS_Host_Cache_WriteBackSlot(USB_ClassInfo_MS_Host_t* const MSInterfaceInfo,
+				                                           const uint32_t BlockAddress, const uint16_t BlockSize);
 			#endif
 	#endif
 	
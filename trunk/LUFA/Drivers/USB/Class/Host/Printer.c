@@ -37,91 +37,69 @@
 #include "Printer.h"
 
 uint8_t PRNT_Host_ConfigurePipes(USB_ClassInfo_PRNT_Host_t* const PRNTInterfaceInfo, uint16_t ConfigDescriptorSize,
-							     void* DeviceConfigDescriptor)
+                                 void* DeviceConfigDescriptor)
 {
-	uint8_t FoundEndpoints = 0;
-	
-	memset(&PRNTInterfaceInfo->State, 0x00, sizeof(PRNTInterfaceInfo->State));
+	USB_ConfigIndex_t ConfigIndex;
+	uint8_t           ErrorCode;
 
-	if (DESCRIPTOR_TYPE(DeviceConfigDescriptor) != DTYPE_Configuration)
-	  return PRNT_ENUMERROR_InvalidConfigDescriptor;
-	
-	if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &DeviceConfigDescriptor,
-	                              DComp_NextPRNTInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+	if (USB_IndexConfigDescriptor(&ConfigIndex, ConfigDescriptorSize, DeviceConfigDescriptor) == INDEX_CONFIG_InvalidConfigDescriptor)
 	{
-		return PRNT_ENUMERROR_NoPrinterInterfaceFound;
+		memset(&PRNTInterfaceInfo->State, 0x00, sizeof(PRNTInterfaceInfo->State));
+		return PRNT_ENUMERROR_InvalidConfigDescriptor;
 	}
 
-	USB_Descriptor_Interface_t* PrinterInterface = DESCRIPTOR_PCAST(DeviceConfigDescriptor, USB_Descriptor_Interface_t);
+	/* Descriptors with more interfaces or endpoints than the index holds are searched a window at a time */
+	while (((ErrorCode = PRNT_Host_ConfigurePipesIndexed(PRNTInterfaceInfo, &ConfigIndex)) != PRNT_ENUMERROR_NoError) &&
+	       USB_IndexNextConfigWindow(&ConfigIndex, ConfigDescriptorSize, DeviceConfigDescriptor));
 
-	PRNTInterfaceInfo->State.InterfaceNumber  = PrinterInterface->InterfaceNumber;
-	PRNTInterfaceInfo->State.AlternateSetting = PrinterInterface->AlternateSetting;
-	
-	while (FoundEndpoints != (PRNT_FOUND_DATAPIPE_IN | PRNT_FOUND_DATAPIPE_OUT))
+	return ErrorCode;
+}
+
+uint8_t PRNT_Host_ConfigurePipesIndexed(USB_ClassInfo_PRNT_Host_t* const PRNTInterfaceInfo,
+                                        const USB_ConfigIndex_t* const ConfigIndex)
+{
+	USB_Descriptor_Endpoint_t* DataINEndpoint;
+	USB_Descriptor_Endpoint_t* DataOUTEndpoint;
+	uint8_t                    PrinterInterface = 0;
+	uint8_t                    ErrorCode = PRNT_ENUMERROR_NoPrinterInterfaceFound;
+
+	memset(&PRNTInterfaceInfo->State, 0x00, sizeof(PRNTInterfaceInfo->State));
+
+	for (;;)
 	{
-		if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &DeviceConfigDescriptor,
-		                              DComp_NextPRNTInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
-		{
-			return PRNT_ENUMERROR_EndpointsNotFound;
-		}
-		
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(DeviceConfigDescriptor, USB_Descriptor_Endpoint_t);
+		PrinterInterface = USB_GetIndexedInterface(ConfigIndex, PrinterInterface, PRINTER_CLASS, PRINTER_SUBCLASS,
+		                                           PRINTER_PROTOCOL, INDEX_MATCH_ALL);
 
-		if (EndpointData->EndpointAddress & ENDPOINT_DESCRIPTOR_DIR_IN)
-		{
-			Pipe_ConfigurePipe(PRNTInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
-			                   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-			                   PRNTInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-			PRNTInterfaceInfo->State.DataINPipeSize = EndpointData->EndpointSize;
+		if (PrinterInterface == INDEX_NO_INTERFACE)
+		  return ErrorCode;
 
-			FoundEndpoints |= PRNT_FOUND_DATAPIPE_IN;
-		}
-		else
-		{
-			Pipe_ConfigurePipe(PRNTInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
-			                   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-			                   PRNTInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-			PRNTInterfaceInfo->State.DataOUTPipeSize = EndpointData->EndpointSize;
+		DataINEndpoint  = USB_GetIndexedEndpoint(ConfigIndex, PrinterInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_IN);
+		DataOUTEndpoint = USB_GetIndexedEndpoint(ConfigIndex, PrinterInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_OUT);
+
+		if ((DataINEndpoint != NULL) && (DataOUTEndpoint != NULL))
+		  break;
 
-			FoundEndpoints |= PRNT_FOUND_DATAPIPE_OUT;
-		}		
+		ErrorCode = PRNT_ENUMERROR_EndpointsNotFound;
+		PrinterInterface++;
 	}
 
-	PRNTInterfaceInfo->State.IsActive = true;
-	return PRNT_ENUMERROR_NoError;
-}
+	USB_Descriptor_Interface_t* PrinterInterfaceData = ConfigIndex->Interfaces[PrinterInterface].InterfaceDescriptor;
 
-static uint8_t DComp_NextPRNTInterface(void* CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		if ((DESCRIPTOR_CAST(CurrentDescriptor, USB_Descriptor_Interface_t).Class    == PRINTER_CLASS)    &&
-		    (DESCRIPTOR_CAST(CurrentDescriptor, USB_Descriptor_Interface_t).SubClass == PRINTER_SUBCLASS) &&
-			(DESCRIPTOR_CAST(CurrentDescriptor, USB_Descriptor_Interface_t).Protocol == PRINTER_PROTOCOL))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
-	}
-	
-	return DESCRIPTOR_SEARCH_NotFound;
-}
+	PRNTInterfaceInfo->State.InterfaceNumber  = PrinterInterfaceData->InterfaceNumber;
+	PRNTInterfaceInfo->State.AlternateSetting = PrinterInterfaceData->AlternateSetting;
 
-static uint8_t DComp_NextPRNTInterfaceEndpoint(void* CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Endpoint)
-	{
-		uint8_t EndpointType = (DESCRIPTOR_CAST(CurrentDescriptor,
-		                                        USB_Descriptor_Endpoint_t).Attributes & EP_TYPE_MASK);
+	Pipe_ConfigurePipe(PRNTInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
+	                   DataINEndpoint->EndpointAddress, DataINEndpoint->EndpointSize,
+	                   PRNTInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	PRNTInterfaceInfo->State.DataINPipeSize = DataINEndpoint->EndpointSize;
 
-		if (EndpointType == EP_TYPE_BULK)
-		  return DESCRIPTOR_SEARCH_Found;
-	}
-	else if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		return DESCRIPTOR_SEARCH_Fail;
-	}
+	Pipe_ConfigurePipe(PRNTInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
+	                   DataOUTEndpoint->EndpointAddress, DataOUTEndpoint->EndpointSize,
+	                   PRNTInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	PRNTInterfaceInfo->State.DataOUTPipeSize = DataOUTEndpoint->EndpointSize;
 
-	return DESCRIPTOR_SEARCH_NotFound;
+	PRNTInterfaceInfo->State.IsActive = true;
+	return PRNT_ENUMERROR_NoError;
 }
 
 uint8_t PRNT_Host_SetBidirectionalMode(USB_ClassInfo_PRNT_Host_t* const PRNTInterfaceInfo)
@@ -247,4 +225,170 @@ uint8_t PRNT_Host_GetDeviceID(USB_ClassInfo_PRNT_Host_t* const PRNTInterfaceInfo
 	return HOST_SENDCONTROL_Successful;
 }
 
+void PRNT_Host_Spooler_Init(PRNT_Host_Spooler_t* const Spooler)
+{
+	memset(&Spooler->State, 0x00, sizeof(Spooler->State));
+
+	Spooler->State.PortStatus    = PRNT_PORTSTATUS_NOTERROR;
+	Spooler->State.StatusPollDue = true;
+}
+
+bool PRNT_Host_Spooler_QueueJob(PRNT_Host_Spooler_t* const Spooler, const uint8_t Source,
+                                const void* const Data, const uint32_t Length)
+{
+	if (Spooler->State.QueuedJobs == Spooler->Config.TotalJobs)
+	  return false;
+
+	uint8_t JobIndex = (Spooler->State.JobStart + Spooler->State.QueuedJobs);
+
+	if (JobIndex >= Spooler->Config.TotalJobs)
+	  JobIndex -= Spooler->Config.TotalJobs;
+
+	Spooler->Config.Jobs[JobIndex] = (PRNT_Host_SpoolJob_t)
+		{
+			.Data   = Data,
+			.Length = Length,
+			.Source = Source,
+		};
+
+	if (!(Spooler->State.QueuedJobs++))
+	  Spooler->State.StatusPollDue = true;
+
+	return true;
+}
+
+uint8_t PRNT_Host_Spooler_CancelJobs(PRNT_Host_Spooler_t* const Spooler)
+{
+	USB_ClassInfo_PRNT_Host_t* PRNTInterfaceInfo = Spooler->Config.PRNTInterfaceInfo;
+
+	Spooler->State.JobStart   = 0;
+	Spooler->State.QueuedJobs = 0;
+	Spooler->State.JobOffset  = 0;
+
+	Pipe_SelectPipe(PRNTInterfaceInfo->Config.DataOUTPipeNumber);
+	Pipe_Freeze();
+	Pipe_ResetPipe(PRNTInterfaceInfo->Config.DataOUTPipeNumber);
+
+	return PRNT_Host_SoftReset(PRNTInterfaceInfo);
+}
+
+uint8_t PRNT_Host_Spooler_USBTask(PRNT_Host_Spooler_t* const Spooler)
+{
+	USB_ClassInfo_PRNT_Host_t* PRNTInterfaceInfo = Spooler->Config.PRNTInterfaceInfo;
+
+	if ((USB_HostState != HOST_STATE_Configured) || !(PRNTInterfaceInfo->State.IsActive))
+	  return PRNT_SPOOLER_DeviceDisconnected;
+
+	if (!(Spooler->State.QueuedJobs))
+	  return PRNT_SPOOLER_Idle;
+
+	if (Spooler->Config.StatusPollFrames)
+	{
+		uint16_t ElapsedFrames = ((USB_Host_GetFrameNumber() - Spooler->State.LastPollFrame) & USB_HOST_FRAME_NUMBER_MASK);
+
+		if (Spooler->State.StatusPollDue || (ElapsedFrames >= Spooler->Config.StatusPollFrames))
+		  PRNT_Host_Spooler_PollStatus(Spooler);
+	}
+
+	Pipe_SelectPipe(PRNTInterfaceInfo->Config.DataOUTPipeNumber);
+
+	if (Spooler->State.IsPaused)
+	{
+		Pipe_Freeze();
+		return PRNT_SPOOLER_Paused;
+	}
+
+	Pipe_Unfreeze();
+
+	if (Pipe_IsStalled())
+	{
+		Pipe_ClearStall();
+		USB_Host_ClearPipeStall(Pipe_BoundEndpointNumber());
+
+		return PRNT_SPOOLER_PipeStalled;
+	}
+
+	while (Spooler->State.QueuedJobs && Pipe_IsOUTReady())
+	{
+		PRNT_Host_SpoolJob_t* Job = &Spooler->Config.Jobs[Spooler->State.JobStart];
+		uint32_t JobRemaining     = (Job->Length - Spooler->State.JobOffset);
+		uint16_t ChunkSize        = (PRNTInterfaceInfo->State.DataOUTPipeSize - Pipe_BytesInPipe());
+
+		if (ChunkSize > JobRemaining)
+		  ChunkSize = JobRemaining;
+
+		if (ChunkSize)
+		{
+			if (!(ChunkSize = PRNT_Host_Spooler_WriteChunk(Spooler, Job, ChunkSize)))
+			  break;
+
+			Spooler->State.JobOffset += ChunkSize;
+		}
+
+		if (Spooler->State.JobOffset == Job->Length)
+		{
+			if (++Spooler->State.JobStart == Spooler->Config.TotalJobs)
+			  Spooler->State.JobStart = 0;
+
+			Spooler->State.QueuedJobs--;
+			Spooler->State.JobOffset = 0;
+			Spooler->State.CompletedJobs++;
+		}
+
+		if (Pipe_BytesInPipe() == PRNTInterfaceInfo->State.DataOUTPipeSize)
+		  Pipe_ClearOUT();
+	}
+
+	if (Pipe_IsOUTReady() && Pipe_BytesInPipe())
+	  Pipe_ClearOUT();
+
+	return (Spooler->State.QueuedJobs ? PRNT_SPOOLER_Sending : PRNT_SPOOLER_Idle);
+}
+
+static void PRNT_Host_Spooler_PollStatus(PRNT_Host_Spooler_t* const Spooler)
+{
+	uint8_t PortStatus;
+
+	Spooler->State.LastPollFrame = USB_Host_GetFrameNumber();
+	Spooler->State.StatusPollDue = false;
+
+	if (PRNT_Host_GetPortStatus(Spooler->Config.PRNTInterfaceInfo, &PortStatus) != HOST_SENDCONTROL_Successful)
+	  return;
+
+	Spooler->State.PortStatus = PortStatus;
+	Spooler->State.IsPaused   = ((PortStatus & PRNT_PORTSTATUS_PAPEREMPTY) || !(PortStatus & PRNT_PORTSTATUS_NOTERROR));
+}
+
+static uint16_t PRNT_Host_Spooler_WriteChunk(PRNT_Host_Spooler_t* const Spooler, const PRNT_Host_SpoolJob_t* const Job,
+                                             uint16_t ChunkSize)
+{
+	switch (Job->Source)
+	{
+		case PRNT_SPOOL_SOURCE_FLASH:
+			Pipe_Write_PStream_LE(((const uint8_t*)Job->Data + Spooler->State.JobOffset), ChunkSize, NO_STREAM_CALLBACK);
+			break;
+		case PRNT_SPOOL_SOURCE_EEPROM:
+			Pipe_Write_EStream_LE(((const uint8_t*)Job->Data + Spooler->State.JobOffset), ChunkSize, NO_STREAM_CALLBACK);
+			break;
+		case PRNT_SPOOL_SOURCE_CALLBACK:
+		{
+			uint8_t ChunkBuffer[PRNT_SPOOL_CHUNK_SIZE];
+
+			if (ChunkSize > sizeof(ChunkBuffer))
+			  ChunkSize = sizeof(ChunkBuffer);
+
+			ChunkSize = Spooler->Config.ReadCallback(Spooler, Job, ChunkBuffer, ChunkSize, Spooler->State.JobOffset);
+
+			Pipe_SelectPipe(Spooler->Config.PRNTInterfaceInfo->Config.DataOUTPipeNumber);
+			Pipe_Write_Stream_LE(ChunkBuffer, ChunkSize, NO_STREAM_CALLBACK);
+			break;
+		}
+		default:
+			Pipe_Write_Stream_LE(((const uint8_t*)Job->Data + Spooler->State.JobOffset), ChunkSize, NO_STREAM_CALLBACK);
+			break;
+	}
+
+	return ChunkSize;
+}
+
 #endif
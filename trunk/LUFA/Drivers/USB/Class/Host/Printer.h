@@ -38,6 +38,19 @@
  *  \section Module Description
  *  Host Mode USB Class driver framework interface, for the Printer USB Class driver.
  *
+ *  \section Sec_PRNTHostSpooler Print Job Spooler
+ *  \ref PRNT_Host_SendData() blocks until the given buffer has been accepted by the printer, which may take many seconds
+ *  for a large job or indefinitely while the printer is out of paper. The optional print job spooler instead streams
+ *  queued jobs to the printer from \ref PRNT_Host_Spooler_USBTask() one pipe bank at a time, returning as soon as no
+ *  pipe bank is free so that the application's other tasks continue to run. The spooler is created by the user
+ *  application as a \ref PRNT_Host_Spooler_t instance along with an array of \ref PRNT_Host_SpoolJob_t queue slots,
+ *  and jobs are queued via \ref PRNT_Host_Spooler_QueueJob() from RAM, FLASH or EEPROM, or from a user callback
+ *  which reads each chunk of the job on demand (for example, from a file on an SD card).
+ *
+ *  While jobs are queued, the spooler periodically reads the printer's port status and pauses when the printer reports
+ *  that it is out of paper or in an error state, resuming automatically once the condition clears. Printers which are
+ *  merely busy hold off the spooler by not accepting further data on the OUT data pipe.
+ *
  *  @{
  */
 
@@ -59,6 +72,21 @@
 		#endif
 
 	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Job source for \ref PRNT_Host_Spooler_QueueJob(), indicating that the job data is located in RAM. */
+			#define PRNT_SPOOL_SOURCE_RAM          0
+
+			/** Job source for \ref PRNT_Host_Spooler_QueueJob(), indicating that the job data is located in FLASH memory. */
+			#define PRNT_SPOOL_SOURCE_FLASH        1
+
+			/** Job source for \ref PRNT_Host_Spooler_QueueJob(), indicating that the job data is located in EEPROM memory. */
+			#define PRNT_SPOOL_SOURCE_EEPROM       2
+
+			/** Job source for \ref PRNT_Host_Spooler_QueueJob(), indicating that the job data is read on demand via the
+			 *  spooler's read callback.
+			 */
+			#define PRNT_SPOOL_SOURCE_CALLBACK     3
+
 		/* Type Defines: */
 			/** Class state structure. An instance of this structure should be made within the user application,
 			 *  and passed to each of the Printer class driver functions as the PRNTInterfaceInfo parameter. This
@@ -93,6 +121,77 @@
 						  */
 			} USB_ClassInfo_PRNT_Host_t;
 
+			/** Type define for a single job queue slot of a print job spooler. An array of these structures should be made
+			 *  within the user application and referenced from the Jobs configuration element of a \ref PRNT_Host_Spooler_t
+			 *  instance. Slots are filled by \ref PRNT_Host_Spooler_QueueJob() and should not be altered by the application.
+			 */
+			typedef struct
+			{
+				const void* Data; /**< Pointer to the job data, or a user context pointer for callback jobs */
+				uint32_t    Length; /**< Total length of the job in bytes */
+				uint8_t     Source; /**< Location of the job data, a PRNT_SPOOL_SOURCE_* value */
+			} PRNT_Host_SpoolJob_t;
+
+			struct PRNT_Host_Spooler;
+
+			/** Type define for a job data read callback routine, used by the print job spooler to read each chunk of a job
+			 *  queued with the \ref PRNT_SPOOL_SOURCE_CALLBACK source. The callback should copy up to the given number of
+			 *  bytes of the job from the given offset into the buffer, and return the number of bytes copied. Returning zero
+			 *  indicates that no data is available yet, and the read will be retried on the next call to
+			 *  \ref PRNT_Host_Spooler_USBTask().
+			 *
+			 *  \param[in,out] Spooler  Pointer to the print job spooler reading the job
+			 *  \param[in] Job  Pointer to the job being read, whose Data element holds the context given when it was queued
+			 *  \param[out] Buffer  Pointer to a buffer where the job data is to be stored
+			 *  \param[in] Length  Maximum number of bytes to store into the buffer
+			 *  \param[in] Offset  Offset within the job of the first byte to read
+			 *
+			 *  \return Number of bytes stored into the buffer
+			 */
+			typedef uint16_t (*PRNT_Host_SpoolReadCallbackPtr_t)(struct PRNT_Host_Spooler* const Spooler,
+			                                                     const PRNT_Host_SpoolJob_t* const Job, void* const Buffer,
+			                                                     const uint16_t Length, const uint32_t Offset);
+
+			/** Print job spooler structure. An instance of this structure should be made within the user application, and
+			 *  passed to each of the PRNT_Host_Spooler_* functions as the Spooler parameter. This stores the spooler's
+			 *  configuration and state information, including the printer's most recently read port status.
+			 */
+			typedef struct PRNT_Host_Spooler
+			{
+				const struct
+				{
+					USB_ClassInfo_PRNT_Host_t* PRNTInterfaceInfo; /**< Printer interface which jobs are sent to */
+
+					PRNT_Host_SpoolJob_t* Jobs; /**< Pointer to the array of slots used to hold queued jobs */
+					uint8_t  TotalJobs; /**< Number of slots in the array pointed to by the Jobs element */
+
+					PRNT_Host_SpoolReadCallbackPtr_t ReadCallback; /**< Routine to read the data of callback sourced jobs,
+					                                                *   or NULL if no such jobs are queued
+					                                                */
+
+					uint16_t StatusPollFrames; /**< Number of USB frames between reads of the printer's port status while
+					                            *   jobs are queued, up to 2047, or zero to disable status based flow control
+					                            */
+				} Config; /**< Config data for the print job spooler. All elements in this section <b>must</b> be set or
+				           *   the spooler will fail to operate correctly.
+				           */
+				struct
+				{
+					uint8_t  JobStart; /**< Index of the job currently being sent within the job queue */
+					uint8_t  QueuedJobs; /**< Number of jobs in the job queue, including the job currently being sent */
+					uint32_t JobOffset; /**< Number of bytes of the current job sent to the printer */
+
+					uint8_t  PortStatus; /**< Most recently read port status of the printer, a mask of PRNT_PORTSTATUS_* masks */
+					bool     StatusPollDue; /**< Indicates if the port status is to be read before any further data is sent */
+					uint16_t LastPollFrame; /**< USB frame number of the most recent port status read */
+					bool     IsPaused; /**< Indicates if sending is paused due to the printer's reported port status */
+
+					uint16_t CompletedJobs; /**< Number of jobs sent in their entirety, wrapping at 65535 */
+				} State; /**< State data for the print job spooler. All elements in this section are reset by
+				          *   \ref PRNT_Host_Spooler_Init().
+				          */
+			} PRNT_Host_Spooler_t;
+
 		/* Enums: */
 			enum PRNTHost_EnumerationFailure_ErrorCodes_t
 			{
@@ -101,6 +200,21 @@
 				PRNT_ENUMERROR_NoPrinterInterfaceFound    = 2, /**< A compatible Printer interface was not found in the device's Configuration Descriptor */
 				PRNT_ENUMERROR_EndpointsNotFound          = 3, /**< Compatible Printer endpoints were not found in the device's interfaces */
 			};
+
+			/** Enum for the status values returned by \ref PRNT_Host_Spooler_USBTask(). */
+			enum PRNTHost_SpoolerStatus_t
+			{
+				PRNT_SPOOLER_Idle                         = 0, /**< No jobs are queued */
+				PRNT_SPOOLER_Sending                      = 1, /**< Queued jobs are being sent to the printer */
+				PRNT_SPOOLER_Paused                       = 2, /**< Sending is paused, as the printer is out of paper or has
+				                                                *   reported an error
+				                                                */
+				PRNT_SPOOLER_PipeStalled                  = 3, /**< The printer stalled the OUT data pipe, and the stall has been
+				                                                *   cleared; sending resumes on the next call unless the jobs are
+				                                                *   cancelled
+				                                                */
+				PRNT_SPOOLER_DeviceDisconnected           = 4, /**< The printer is not connected, or its interface is not active */
+			};
 	
 		/* Function Prototypes: */
 			/** Host interface configuration routine, to configure a given Printer host interface instance using the
@@ -117,6 +231,23 @@
 			 */
 			uint8_t PRNT_Host_ConfigurePipes(USB_ClassInfo_PRNT_Host_t* const PRNTInterfaceInfo, uint16_t ConfigDescriptorSize,
 			                                 void* DeviceConfigDescriptor) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Host interface configuration routine, to configure a given Printer host interface instance using a Configuration
+			 *  Descriptor index built by \ref USB_IndexConfigDescriptor(). This behaves as \ref PRNT_Host_ConfigurePipes(), but
+			 *  allows the attached device's Configuration Descriptor to be indexed once and then shared between all the class
+			 *  driver instances which are to bind to the device.
+			 *
+			 *  Only the interfaces within the index's current window are searched. If the index is truncated (see
+			 *  \ref USB_IndexNextConfigWindow()) and no matching interface is found, the caller may index the next window
+			 *  and call this function again.
+			 *
+			 *  \param[in,out] PRNTInterfaceInfo  Pointer to a structure containing a Printer Class host configuration and state
+			 *  \param[in] ConfigIndex  Pointer to an index of the attached device's Configuration Descriptor
+			 *
+			 *  \return A value from the \ref PRNTHost_EnumerationFailure_ErrorCodes_t enum
+			 */
+			uint8_t PRNT_Host_ConfigurePipesIndexed(USB_ClassInfo_PRNT_Host_t* const PRNTInterfaceInfo,
+			                                        const USB_ConfigIndex_t* const ConfigIndex) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 			
 			/** Configures the printer to enable Bidirectional mode, if it is not already in this mode. This should be called
 			 *  once the connected device's configuration has been set, to ensure the printer is ready to accept commands.
@@ -178,7 +309,63 @@
 			uint8_t PRNT_Host_GetDeviceID(USB_ClassInfo_PRNT_Host_t* const PRNTInterfaceInfo, char* DeviceIDString,
 			                              uint16_t BufferSize) ATTR_NON_NULL_PTR_ARG(1);
 
+			/** Initializes a print job spooler, emptying its job queue and resetting its state. This should be called before
+			 *  the spooler is first used, and may be called again after the printer has been re-enumerated.
+			 *
+			 *  \param[in,out] Spooler  Pointer to a structure containing a print job spooler configuration and state
+			 */
+			void PRNT_Host_Spooler_Init(PRNT_Host_Spooler_t* const Spooler) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Adds a job to the end of a print job spooler's queue. The job data must remain valid and unaltered until the
+			 *  job has been sent, which can be determined via \ref PRNT_Host_Spooler_GetQueuedJobs() or the spooler's
+			 *  CompletedJobs state element.
+			 *
+			 *  \param[in,out] Spooler  Pointer to a structure containing a print job spooler configuration and state
+			 *  \param[in] Source  Location of the job data, a PRNT_SPOOL_SOURCE_* value
+			 *  \param[in] Data  Pointer to the job data, or a user context pointer passed to the read callback for
+			 *                   \ref PRNT_SPOOL_SOURCE_CALLBACK jobs
+			 *  \param[in] Length  Total length of the job in bytes
+			 *
+			 *  \return Boolean true if the job was queued, false if the job queue is full
+			 */
+			bool PRNT_Host_Spooler_QueueJob(PRNT_Host_Spooler_t* const Spooler, const uint8_t Source,
+			                                const void* const Data, const uint32_t Length) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Discards all queued jobs of a print job spooler, including any data written to the OUT data pipe but not yet
+			 *  sent, and soft-resets the attached printer so that it discards any partially received job.
+			 *
+			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state.
+			 *
+			 *  \param[in,out] Spooler  Pointer to a structure containing a print job spooler configuration and state
+			 *
+			 *  \return A value from the \ref USB_Host_SendControlErrorCodes_t enum
+			 */
+			uint8_t PRNT_Host_Spooler_CancelJobs(PRNT_Host_Spooler_t* const Spooler) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Management task for a print job spooler. This reads the printer's port status at the configured interval,
+			 *  and fills each free bank of the printer interface's OUT data pipe from the queued jobs, returning without
+			 *  waiting once no bank is free. This should be called frequently in the main program loop while jobs are
+			 *  queued, before the master USB management task \ref USB_USBTask().
+			 *
+			 *  \param[in,out] Spooler  Pointer to a structure containing a print job spooler configuration and state
+			 *
+			 *  \return A value from the \ref PRNTHost_SpoolerStatus_t enum
+			 */
+			uint8_t PRNT_Host_Spooler_USBTask(PRNT_Host_Spooler_t* const Spooler) ATTR_NON_NULL_PTR_ARG(1);
+
 		/* Inline Functions: */
+			/** Retrieves the number of jobs in a print job spooler's queue, including the job currently being sent.
+			 *
+			 *  \param[in] Spooler  Pointer to a structure containing a print job spooler configuration and state
+			 *
+			 *  \return Number of queued jobs
+			 */
+			static inline uint8_t PRNT_Host_Spooler_GetQueuedJobs(const PRNT_Host_Spooler_t* const Spooler);
+			static inline uint8_t PRNT_Host_Spooler_GetQueuedJobs(const PRNT_Host_Spooler_t* const Spooler)
+			{
+				return Spooler->State.QueuedJobs;
+			}
+
 			/** General management task for a given Printer host class interface, required for the correct operation of
 			 *  the interface. This should be called frequently in the main program loop, before the master USB management task
 			 *  \ref USB_USBTask().
@@ -201,15 +388,16 @@
 			#define REQ_GetDeviceID                0
 			#define REQ_GetPortStatus              1
 			#define REQ_SoftReset                  2
-		
-			#define PRNT_FOUND_DATAPIPE_IN         (1 << 0)
-			#define PRNT_FOUND_DATAPIPE_OUT        (1 << 1)
-			
+
+			#define PRNT_SPOOL_CHUNK_SIZE          64
+
 		/* Function Prototypes: */
-			#if defined(__INCLUDE_FROM_PRINTER_CLASS_HOST_C)		
-				static uint8_t DComp_NextPRNTInterface(void* const CurrentDescriptor);
-				static uint8_t DComp_NextPRNTInterfaceEndpoint(void* const CurrentDescriptor);
+			#if defined(__INCLUDE_FROM_PRINTER_CLASS_HOST_C)
+				static void     PRNT_Host_Spooler_PollStatus(PRNT_Host_Spooler_t* const Spooler);
+				static uint16_t PRNT_Host_Spooler_WriteChunk(PRNT_Host_Spooler_t* const Spooler, const PRNT_Host_SpoolJob_t* const Job,
+				                                             uint16_t ChunkSize);
 			#endif
+		
 	#endif
 	
 	/* Disable C linkage for C++ Compilers: */
@@ -36,162 +36,89 @@
 #define  __INCLUDE_FROM_RNDIS_DRIVER
 #include "RNDIS.h"
 
+static const uint8_t PROGMEM RNDIS_Host_PacketPadding[1 << RNDIS_MAX_PACKET_ALIGNMENT] = {0};
+
 uint8_t RNDIS_Host_ConfigurePipes(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo, uint16_t ConfigDescriptorSize,
-                                void* ConfigDescriptorData)
+                                  void* ConfigDescriptorData)
+{
+	USB_ConfigIndex_t ConfigIndex;
+	uint8_t           ErrorCode;
+
+	if (USB_IndexConfigDescriptor(&ConfigIndex, ConfigDescriptorSize, ConfigDescriptorData) == INDEX_CONFIG_InvalidConfigDescriptor)
+	{
+		memset(&RNDISInterfaceInfo->State, 0x00, sizeof(RNDISInterfaceInfo->State));
+		return RNDIS_ENUMERROR_InvalidConfigDescriptor;
+	}
+
+	/* Descriptors with more interfaces or endpoints than the index holds are searched a window at a time */
+	while (((ErrorCode = RNDIS_Host_ConfigurePipesIndexed(RNDISInterfaceInfo, &ConfigIndex)) != RNDIS_ENUMERROR_NoError) &&
+	       USB_IndexNextConfigWindow(&ConfigIndex, ConfigDescriptorSize, ConfigDescriptorData));
+
+	return ErrorCode;
+}
+
+uint8_t RNDIS_Host_ConfigurePipesIndexed(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo,
+                                         const USB_ConfigIndex_t* const ConfigIndex)
 {
-	uint8_t FoundEndpoints = 0;
+	USB_Descriptor_Endpoint_t* NotificationEndpoint;
+	USB_Descriptor_Endpoint_t* DataINEndpoint;
+	USB_Descriptor_Endpoint_t* DataOUTEndpoint;
+	uint8_t                    ControlInterface = 0;
+	uint8_t                    DataInterface;
 
 	memset(&RNDISInterfaceInfo->State, 0x00, sizeof(RNDISInterfaceInfo->State));
 
-	if (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration)
-	  return RNDIS_ENUMERROR_InvalidConfigDescriptor;
-	
-	if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-	                              DComp_RNDIS_Host_NextRNDISControlInterface) != DESCRIPTOR_SEARCH_COMP_Found)
+	for (;;)
 	{
-		return RNDIS_ENUMERROR_NoRNDISInterfaceFound;
+		ControlInterface = USB_GetIndexedInterface(ConfigIndex, ControlInterface, RNDIS_CONTROL_CLASS,
+		                                           RNDIS_CONTROL_SUBCLASS, RNDIS_CONTROL_PROTOCOL, INDEX_MATCH_ALL);
+
+		if (ControlInterface == INDEX_NO_INTERFACE)
+		  return RNDIS_ENUMERROR_NoRNDISInterfaceFound;
+		
+		NotificationEndpoint = USB_GetIndexedEndpoint(ConfigIndex, ControlInterface, EP_TYPE_INTERRUPT, ENDPOINT_DESCRIPTOR_DIR_IN);
+		
+		if (NotificationEndpoint != NULL)
+		  break;
+		
+		ControlInterface++;
 	}
-	
-	RNDISInterfaceInfo->State.ControlInterfaceNumber = DESCRIPTOR_CAST(ConfigDescriptorData, USB_Descriptor_Interface_t).InterfaceNumber;
 
-	while (FoundEndpoints != (RNDIS_FOUND_NOTIFICATION_IN | RNDIS_FOUND_DATAPIPE_IN | RNDIS_FOUND_DATAPIPE_OUT))
+	DataInterface = ControlInterface;
+
+	do
 	{
-		if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-		                              DComp_RNDIS_Host_NextRNDISInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
-		{
-			if (FoundEndpoints & RNDIS_FOUND_NOTIFICATION_IN)
-			{
-				if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData, 
-				                              DComp_RNDIS_Host_NextRNDISDataInterface) != DESCRIPTOR_SEARCH_COMP_Found)
-				{
-					return RNDIS_ENUMERROR_NoRNDISInterfaceFound;
-				}
-			}
-			else
-			{
-				FoundEndpoints = 0;
-
-				Pipe_SelectPipe(RNDISInterfaceInfo->Config.DataINPipeNumber);
-				Pipe_DisablePipe();
-				Pipe_SelectPipe(RNDISInterfaceInfo->Config.DataOUTPipeNumber);
-				Pipe_DisablePipe();
-				Pipe_SelectPipe(RNDISInterfaceInfo->Config.NotificationPipeNumber);
-				Pipe_DisablePipe();
-			
-				if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-				                              DComp_RNDIS_Host_NextRNDISControlInterface) != DESCRIPTOR_SEARCH_COMP_Found)
-				{
-					return RNDIS_ENUMERROR_NoRNDISInterfaceFound;
-				}
-			}
+		DataInterface = USB_GetIndexedInterface(ConfigIndex, (DataInterface + 1), RNDIS_DATA_CLASS,
+		                                        RNDIS_DATA_SUBCLASS, RNDIS_DATA_PROTOCOL, INDEX_MATCH_ALL);
 
-			if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &ConfigDescriptorData,
-			                              DComp_RNDIS_Host_NextRNDISInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
-			{
-				return RNDIS_ENUMERROR_EndpointsNotFound;
-			}
-		}
-		
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(ConfigDescriptorData, USB_Descriptor_Endpoint_t);
+		if (DataInterface == INDEX_NO_INTERFACE)
+		  return RNDIS_ENUMERROR_NoRNDISInterfaceFound;
 
-		if ((EndpointData->Attributes & EP_TYPE_MASK) == EP_TYPE_INTERRUPT)
-		{
-			if (EndpointData->EndpointAddress & ENDPOINT_DESCRIPTOR_DIR_IN)
-			{
-				Pipe_ConfigurePipe(RNDISInterfaceInfo->Config.NotificationPipeNumber, EP_TYPE_INTERRUPT, PIPE_TOKEN_IN,
-								   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-								   RNDISInterfaceInfo->Config.NotificationPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-				RNDISInterfaceInfo->State.NotificationPipeSize = EndpointData->EndpointSize;
-
-				Pipe_SetInterruptPeriod(EndpointData->PollingIntervalMS);
-				
-				FoundEndpoints |= RNDIS_FOUND_NOTIFICATION_IN;
-			}
-		}
-		else
-		{
-			if (EndpointData->EndpointAddress & ENDPOINT_DESCRIPTOR_DIR_IN)
-			{
-				Pipe_ConfigurePipe(RNDISInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
-				                   EndpointData->EndpointAddress, EndpointData->EndpointSize, 
-				                   RNDISInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-				RNDISInterfaceInfo->State.DataINPipeSize = EndpointData->EndpointSize;
+		DataINEndpoint  = USB_GetIndexedEndpoint(ConfigIndex, DataInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_IN);
+		DataOUTEndpoint = USB_GetIndexedEndpoint(ConfigIndex, DataInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_OUT);
+	} while ((DataINEndpoint == NULL) || (DataOUTEndpoint == NULL));
 
-				FoundEndpoints |= RNDIS_FOUND_DATAPIPE_IN;
-			}
-			else
-			{
-				Pipe_ConfigurePipe(RNDISInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
-				                   EndpointData->EndpointAddress, EndpointData->EndpointSize, 
-				                   RNDISInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-				RNDISInterfaceInfo->State.DataOUTPipeSize = EndpointData->EndpointSize;
-				
-				FoundEndpoints |= RNDIS_FOUND_DATAPIPE_OUT;
-			}
-		}
-	}
+	RNDISInterfaceInfo->State.ControlInterfaceNumber = ConfigIndex->Interfaces[ControlInterface].InterfaceDescriptor->InterfaceNumber;
 
-	RNDISInterfaceInfo->State.IsActive = true;
-	return RNDIS_ENUMERROR_NoError;
-}
+	Pipe_ConfigurePipe(RNDISInterfaceInfo->Config.NotificationPipeNumber, EP_TYPE_INTERRUPT, PIPE_TOKEN_IN,
+	                   NotificationEndpoint->EndpointAddress, NotificationEndpoint->EndpointSize,
+	                   RNDISInterfaceInfo->Config.NotificationPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	RNDISInterfaceInfo->State.NotificationPipeSize = NotificationEndpoint->EndpointSize;
 
-static uint8_t DComp_RNDIS_Host_NextRNDISControlInterface(void* const CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		USB_Descriptor_Interface_t* CurrentInterface = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                                USB_Descriptor_Interface_t);
-	
-		if ((CurrentInterface->Class    == RNDIS_CONTROL_CLASS)    &&
-		    (CurrentInterface->SubClass == RNDIS_CONTROL_SUBCLASS) &&
-			(CurrentInterface->Protocol == RNDIS_CONTROL_PROTOCOL))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
-	}
-	
-	return DESCRIPTOR_SEARCH_NotFound;
-}
+	Pipe_SetInterruptPeriod(NotificationEndpoint->PollingIntervalMS);
 
-static uint8_t DComp_RNDIS_Host_NextRNDISDataInterface(void* const CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		USB_Descriptor_Interface_t* CurrentInterface = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                                USB_Descriptor_Interface_t);
-	
-		if ((CurrentInterface->Class    == RNDIS_DATA_CLASS)    &&
-		    (CurrentInterface->SubClass == RNDIS_DATA_SUBCLASS) &&
-			(CurrentInterface->Protocol == RNDIS_DATA_PROTOCOL))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
-	}
-	
-	return DESCRIPTOR_SEARCH_NotFound;
-}
+	Pipe_ConfigurePipe(RNDISInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
+	                   DataINEndpoint->EndpointAddress, DataINEndpoint->EndpointSize,
+	                   RNDISInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	RNDISInterfaceInfo->State.DataINPipeSize = DataINEndpoint->EndpointSize;
 
-static uint8_t DComp_RNDIS_Host_NextRNDISInterfaceEndpoint(void* const CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Endpoint)
-	{
-		USB_Descriptor_Endpoint_t* CurrentEndpoint = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                              USB_Descriptor_Endpoint_t);
-	
-		uint8_t EndpointType = (CurrentEndpoint->Attributes & EP_TYPE_MASK);
-	
-		if (((EndpointType == EP_TYPE_BULK) || (EndpointType == EP_TYPE_INTERRUPT)) &&
-		    !(Pipe_IsEndpointBound(CurrentEndpoint->EndpointAddress)))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
-	}
-	else if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		return DESCRIPTOR_SEARCH_Fail;
-	}
+	Pipe_ConfigurePipe(RNDISInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
+	                   DataOUTEndpoint->EndpointAddress, DataOUTEndpoint->EndpointSize,
+	                   RNDISInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	RNDISInterfaceInfo->State.DataOUTPipeSize = DataOUTEndpoint->EndpointSize;
 
-	return DESCRIPTOR_SEARCH_NotFound;
+	RNDISInterfaceInfo->State.IsActive = true;
+	return RNDIS_ENUMERROR_NoError;
 }
 
 static uint8_t RNDIS_SendEncapsulatedCommand(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo,
@@ -258,6 +185,10 @@ uint8_t RNDIS_Host_InitializeDevice(USB_ClassInfo_RNDIS_Host_t* const RNDISInter
 
 	RNDIS_Initialize_Message_t  InitMessage;
 	RNDIS_Initialize_Complete_t InitMessageResponse;
+	uint8_t                     PacketsPerTransfer = RNDISInterfaceInfo->Config.MaxPacketsPerTransfer;
+	
+	if (!(PacketsPerTransfer))
+	  PacketsPerTransfer = 1;
 
 	InitMessage.MessageType     = REMOTE_NDIS_INITIALIZE_MSG;
 	InitMessage.MessageLength   = sizeof(RNDIS_Initialize_Message_t);
@@ -265,7 +196,7 @@ uint8_t RNDIS_Host_InitializeDevice(USB_ClassInfo_RNDIS_Host_t* const RNDISInter
 
 	InitMessage.MajorVersion    = REMOTE_NDIS_VERSION_MAJOR;
 	InitMessage.MinorVersion    = REMOTE_NDIS_VERSION_MINOR;
-	InitMessage.MaxTransferSize = RNDISInterfaceInfo->Config.HostMaxPacketSize;
+	InitMessage.MaxTransferSize = (PacketsPerTransfer * (sizeof(RNDIS_Packet_Message_t) + RNDISInterfaceInfo->Config.HostMaxPacketSize));
 	
 	if ((ErrorCode = RNDIS_SendEncapsulatedCommand(RNDISInterfaceInfo, &InitMessage,
 	                                               sizeof(RNDIS_Initialize_Message_t))) != HOST_SENDCONTROL_Successful)
@@ -282,7 +213,11 @@ uint8_t RNDIS_Host_InitializeDevice(USB_ClassInfo_RNDIS_Host_t* const RNDISInter
 	if (InitMessageResponse.Status != REMOTE_NDIS_STATUS_SUCCESS)
 	  return RNDIS_COMMAND_FAILED;
 	  
-	RNDISInterfaceInfo->State.DeviceMaxPacketSize = InitMessageResponse.MaxTransferSize;
+	RNDISInterfaceInfo->State.DeviceMaxPacketSize         = InitMessageResponse.MaxTransferSize;
+	RNDISInterfaceInfo->State.DeviceMaxPacketsPerTransfer = InitMessageResponse.MaxPacketsPerTransfer;
+	RNDISInterfaceInfo->State.DevicePacketAlignment       = InitMessageResponse.PacketAlignmentFactor;
+	RNDISInterfaceInfo->State.PacketsInTransfer           = 0;
+	RNDISInterfaceInfo->State.BytesInTransfer             = 0;
 	
 	return HOST_SENDCONTROL_Successful;
 }
@@ -402,7 +337,10 @@ uint8_t RNDIS_Host_ReadPacket(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceIn
 	if (!(Pipe_IsReadWriteAllowed()))
 	{
 		if (Pipe_IsINReceived())
-		  Pipe_ClearIN();
+		{
+			Pipe_ClearIN();
+			RNDISInterfaceInfo->State.BytesReadFromBank = 0;
+		}
 	
 		*PacketLength = 0;
 		Pipe_Freeze();
@@ -417,15 +355,64 @@ uint8_t RNDIS_Host_ReadPacket(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceIn
 		return ErrorCode;
 	}
 
+	uint16_t PipeSize  = RNDISInterfaceInfo->State.DataINPipeSize;
+	uint32_t DataStart = (sizeof(RNDIS_Message_Header_t) + DeviceMessage.DataOffset);
+	uint32_t DataEnd   = (DataStart + DeviceMessage.DataLength);
+
+	/* Drop the remainder of the transfer if the message is not a valid data packet which will fit into the buffer, as
+	 * the start of any following message cannot be trusted */
+	if ((DeviceMessage.MessageType != REMOTE_NDIS_PACKET_MSG) || (DataStart < sizeof(RNDIS_Packet_Message_t)) ||
+	    (DeviceMessage.DataLength > RNDISInterfaceInfo->Config.HostMaxPacketSize))
+	{
+		/* Every bank of a transfer but the last is full, so the bank's length is the bytes read from it plus those left */
+		uint16_t BankOffset  = ((RNDISInterfaceInfo->State.BytesReadFromBank + sizeof(RNDIS_Packet_Message_t)) % PipeSize);
+		bool     ShortPacket = (BankOffset && ((BankOffset + Pipe_BytesInPipe()) < PipeSize));
+
+		Pipe_ClearIN();
+
+		while (!(ShortPacket))
+		{
+			if ((ErrorCode = Pipe_WaitUntilReady()) != PIPE_READYWAIT_NoError)
+			{
+				Pipe_Freeze();
+				return ErrorCode;
+			}
+
+			ShortPacket = (Pipe_BytesInPipe() < PipeSize);
+			Pipe_ClearIN();
+		}
+
+		RNDISInterfaceInfo->State.BytesReadFromBank = 0;
+
+		*PacketLength = 0;
+		Pipe_Freeze();
+		return PIPE_RWSTREAM_NoError;
+	}
+
 	*PacketLength = (uint16_t)DeviceMessage.DataLength;
 	
-	Pipe_Discard_Stream(DeviceMessage.DataOffset - (sizeof(RNDIS_Packet_Message_t) - sizeof(RNDIS_Message_Header_t)),
-	                    NO_STREAM_CALLBACK);
+	if (DataStart > sizeof(RNDIS_Packet_Message_t))
+	  Pipe_Discard_Stream((DataStart - sizeof(RNDIS_Packet_Message_t)), NO_STREAM_CALLBACK);
 						
 	Pipe_Read_Stream_LE(Buffer, *PacketLength, NO_STREAM_CALLBACK);
+
+	/* Skip any alignment padding, leaving the next packet of a multi-packet transfer at the start of the pipe data; the
+	 * padding may continue into the next pipe bank */
+	if (DeviceMessage.MessageLength > DataEnd)
+	{
+		Pipe_Discard_Stream((DeviceMessage.MessageLength - DataEnd), NO_STREAM_CALLBACK);
+		DataEnd = DeviceMessage.MessageLength;
+	}
 	
 	if (!(Pipe_BytesInPipe()))
-	  Pipe_ClearIN();
+	{
+		Pipe_ClearIN();
+		RNDISInterfaceInfo->State.BytesReadFromBank = 0;
+	}
+	else
+	{
+		RNDISInterfaceInfo->State.BytesReadFromBank = ((RNDISInterfaceInfo->State.BytesReadFromBank + DataEnd) % PipeSize);
+	}
 
 	Pipe_Freeze();
 	
@@ -439,29 +426,100 @@ uint8_t RNDIS_Host_SendPacket(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceIn
 	if ((USB_HostState != HOST_STATE_Configured) || !(RNDISInterfaceInfo->State.IsActive))
 	  return PIPE_READYWAIT_DeviceDisconnected;
 
+	uint8_t  PacketsPerTransfer = RNDISInterfaceInfo->Config.MaxPacketsPerTransfer;
+	uint16_t PaddingLength      = 0;
+
+	if (PacketsPerTransfer > RNDISInterfaceInfo->State.DeviceMaxPacketsPerTransfer)
+	  PacketsPerTransfer = RNDISInterfaceInfo->State.DeviceMaxPacketsPerTransfer;
+	
+	/* Only combine packets if the device's requested packet alignment can be honored */
+	if (RNDISInterfaceInfo->State.DevicePacketAlignment > RNDIS_MAX_PACKET_ALIGNMENT)
+	  PacketsPerTransfer = 1;
+
+	if (PacketsPerTransfer > 1)
+	{
+		uint8_t AlignmentMask = ((1 << RNDISInterfaceInfo->State.DevicePacketAlignment) - 1);
+	
+		PaddingLength = (-(sizeof(RNDIS_Packet_Message_t) + PacketLength) & AlignmentMask);
+	}
+
 	RNDIS_Packet_Message_t DeviceMessage;
 
 	memset(&DeviceMessage, 0, sizeof(RNDIS_Packet_Message_t));
 	DeviceMessage.MessageType   = REMOTE_NDIS_PACKET_MSG;
-	DeviceMessage.MessageLength = (sizeof(RNDIS_Packet_Message_t) + PacketLength);
+	DeviceMessage.MessageLength = (sizeof(RNDIS_Packet_Message_t) + PacketLength + PaddingLength);
 	DeviceMessage.DataOffset    = (sizeof(RNDIS_Packet_Message_t) - sizeof(RNDIS_Message_Header_t));
 	DeviceMessage.DataLength    = PacketLength;
 	
 	Pipe_SelectPipe(RNDISInterfaceInfo->Config.DataOUTPipeNumber);
 	Pipe_Unfreeze();
 
-	if ((ErrorCode = Pipe_Write_Stream_LE(&DeviceMessage, sizeof(RNDIS_Packet_Message_t),
-	                                      NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
+	/* End the current transfer first if the packet would exceed the maximum transfer size of the device */
+	if (RNDISInterfaceInfo->State.PacketsInTransfer &&
+	    ((RNDISInterfaceInfo->State.BytesInTransfer + DeviceMessage.MessageLength) > RNDISInterfaceInfo->State.DeviceMaxPacketSize))
+	{
+		if ((ErrorCode = RNDIS_Host_EndOUTTransfer(RNDISInterfaceInfo)) != PIPE_RWSTREAM_NoError)
+		  return ErrorCode;
+	}
+
+	USB_StreamSegment_t PacketSegments[] =
+		{
+			{.Buffer = &DeviceMessage, .Length = sizeof(RNDIS_Packet_Message_t), .MemorySpace = STREAMSEGMENT_RAM},
+			{.Buffer = Buffer, .Length = PacketLength, .MemorySpace = STREAMSEGMENT_RAM},
+			{.Buffer = RNDIS_Host_PacketPadding, .Length = PaddingLength, .MemorySpace = STREAMSEGMENT_FLASH},
+		};
+
+	if ((ErrorCode = Pipe_Write_StreamV(PacketSegments, (sizeof(PacketSegments) / sizeof(PacketSegments[0])),
+	                                    NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
 	{
 		return ErrorCode;
 	}
 
-	Pipe_Write_Stream_LE(Buffer, PacketLength, NO_STREAM_CALLBACK);
-	Pipe_ClearOUT();
+	RNDISInterfaceInfo->State.PacketsInTransfer++;
+	RNDISInterfaceInfo->State.BytesInTransfer += DeviceMessage.MessageLength;
+
+	if (RNDISInterfaceInfo->State.PacketsInTransfer >= PacketsPerTransfer)
+	  ErrorCode = RNDIS_Host_EndOUTTransfer(RNDISInterfaceInfo);
 
 	Pipe_Freeze();
 	
-	return PIPE_RWSTREAM_NoError;
+	return ErrorCode;
+}
+
+void RNDIS_Host_USBTask(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo)
+{
+	if ((USB_HostState != HOST_STATE_Configured) || !(RNDISInterfaceInfo->State.IsActive))
+	  return;
+
+	/* Send any partially filled multi-packet transfer, so that packets are not held back between calls */
+	if (RNDISInterfaceInfo->State.PacketsInTransfer)
+	{
+		Pipe_SelectPipe(RNDISInterfaceInfo->Config.DataOUTPipeNumber);
+		Pipe_Unfreeze();
+
+		RNDIS_Host_EndOUTTransfer(RNDISInterfaceInfo);
+
+		Pipe_Freeze();
+	}
+}
+
+static uint8_t RNDIS_Host_EndOUTTransfer(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo)
+{
+	uint8_t ErrorCode = PIPE_RWSTREAM_NoError;
+
+	Pipe_ClearOUT();
+
+	/* Transfers ending on a pipe bank boundary must be terminated by the host with a zero length packet */
+	if (!(RNDISInterfaceInfo->State.BytesInTransfer % RNDISInterfaceInfo->State.DataOUTPipeSize))
+	{
+		if ((ErrorCode = Pipe_WaitUntilReady()) == PIPE_READYWAIT_NoError)
+		  Pipe_ClearOUT();
+	}
+
+	RNDISInterfaceInfo->State.PacketsInTransfer = 0;
+	RNDISInterfaceInfo->State.BytesInTransfer   = 0;
+
+	return ErrorCode;
 }
 
 #endif
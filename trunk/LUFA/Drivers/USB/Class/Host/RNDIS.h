@@ -39,6 +39,15 @@
  *  Host Mode USB Class driver framework interface, for the Microsoft RNDIS Ethernet
  *  USB Class driver.
  *
+ *  \section Sec_RNDISHostMultiPacket Multi-Packet Transfers
+ *  When the \c MaxPacketsPerTransfer configuration element is set above one, the driver allows the attached device to
+ *  combine several RNDIS data packets into a single bulk IN transfer. Each call to \ref RNDIS_Host_ReadPacket() reads
+ *  the next packet of the transfer directly from the pipe into the given buffer, leaving any following packets in the
+ *  pipe for later calls, so that a burst of packets requires no buffer space beyond a single packet. Calls to
+ *  \ref RNDIS_Host_SendPacket() similarly add each outgoing packet to a single bulk OUT transfer, up to the limits
+ *  reported by the attached device; the transfer is ended once it is full, or on the next call to
+ *  \ref RNDIS_Host_USBTask().
+ *
  *  @{
  */
 
@@ -82,6 +91,9 @@
 					bool     NotificationPipeDoubleBank; /** Indicates if the RNDIS interface's notification pipe should use double banking */
 					
 					uint32_t HostMaxPacketSize; /**< Maximum size of a packet which can be buffered by the host */
+					uint8_t  MaxPacketsPerTransfer; /**< Maximum number of RNDIS data packets which may be combined into a
+					                                 *   single bulk transfer in each direction, or zero for one packet per transfer
+					                                 */
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */
@@ -98,6 +110,21 @@
 					uint16_t NotificationPipeSize;  /**< Size in bytes of the RNDIS interface's IN notification pipe, if used */					
 
 					uint32_t DeviceMaxPacketSize; /**< Maximum size of a packet which can be buffered by the attached RNDIS device */
+					uint8_t  DeviceMaxPacketsPerTransfer; /**< Maximum number of RNDIS data packets the attached device accepts in
+					                                       *   a single bulk transfer
+					                                       */
+					uint8_t  DevicePacketAlignment; /**< Alignment of RNDIS data packets within a bulk transfer requested by the
+					                                 *   attached device, as a power of two
+					                                 */
+					uint8_t  PacketsInTransfer; /**< Number of packets written to the current bulk OUT transfer, used internally by
+					                             *   the class driver
+					                             */
+					uint32_t BytesInTransfer; /**< Number of bytes written to the current bulk OUT transfer, used internally by
+					                           *   the class driver
+					                           */
+					uint16_t BytesReadFromBank; /**< Number of bytes read from the current bulk IN pipe bank, used internally by
+					                             *   the class driver to locate the end of each transfer
+					                             */
 					
 					uint32_t RequestID; /**< Request ID counter to give a unique ID for each command/response pair */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
@@ -136,6 +163,23 @@
 			uint8_t RNDIS_Host_ConfigurePipes(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo, uint16_t ConfigDescriptorSize,
 			                                void* DeviceConfigDescriptor) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
 
+			/** Host interface configuration routine, to configure a given RNDIS host interface instance using a Configuration
+			 *  Descriptor index built by \ref USB_IndexConfigDescriptor(). This behaves as \ref RNDIS_Host_ConfigurePipes(), but
+			 *  allows the attached device's Configuration Descriptor to be indexed once and then shared between all the class
+			 *  driver instances which are to bind to the device.
+			 *
+			 *  Only the interfaces within the index's current window are searched. If the index is truncated (see
+			 *  \ref USB_IndexNextConfigWindow()) and no matching interface is found, the caller may index the next window
+			 *  and call this function again.
+			 *
+			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing an RNDIS Class host configuration and state
+			 *  \param[in] ConfigIndex  Pointer to an index of the attached device's Configuration Descriptor
+			 *
+			 *  \return A value from the \ref RNDISHost_EnumerationFailure_ErrorCodes_t enum
+			 */
+			uint8_t RNDIS_Host_ConfigurePipesIndexed(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo,
+			                                         const USB_ConfigIndex_t* const ConfigIndex) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
 			/** Sends a RNDIS KEEPALIVE command to the device, to ensure that it does not enter standby mode after periods
 			 *  of long inactivity.
 			 *
@@ -195,7 +239,10 @@
 			bool RNDIS_Host_IsPacketReceived(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo);
 			
 			/** Retrieves the next pending packet from the device, discarding the remainder of the RNDIS packet header to leave
-			 *  only the packet contents for processing by the host in the nominated buffer.
+			 *  only the packet contents for processing by the host in the nominated buffer. Any further packets combined into
+			 *  the same bulk transfer by the device are left in the pipe, to be read by subsequent calls. Packets larger than
+			 *  the \c HostMaxPacketSize configuration element and malformed messages are discarded along with the remainder
+			 *  of their bulk transfer, and reported with a zero packet length.
 			 *
 			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or the
 			 *        call will fail.
@@ -209,7 +256,9 @@
 			uint8_t RNDIS_Host_ReadPacket(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo, void* Buffer, uint16_t* PacketLength)
 			                              ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2) ATTR_NON_NULL_PTR_ARG(3);
 
-			/** Sends the given packet to the attached RNDIS device, after adding a RNDIS packet message header.
+			/** Sends the given packet to the attached RNDIS device, after adding a RNDIS packet message header. When multi-packet
+			 *  transfers are enabled, the packet is added to the current bulk OUT transfer, which is ended once it holds as many
+			 *  packets as the device accepts, or on the next call to \ref RNDIS_Host_USBTask().
 			 *
 			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or the
 			 *        call will fail.
@@ -223,17 +272,12 @@
 			uint8_t RNDIS_Host_SendPacket(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo, void* Buffer, uint16_t PacketLength)
 			                              ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
-		/* Inline Functions: */
 			/** General management task for a given RNDIS host class interface, required for the correct operation of the interface. This should
 			 *  be called frequently in the main program loop, before the master USB management task \ref USB_USBTask().
 			 *
 			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing an RNDIS Class host configuration and state
 			 */
-			static inline void RNDIS_Host_USBTask(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo);
-			static inline void RNDIS_Host_USBTask(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo)
-			{
-				(void)RNDISInterfaceInfo;
-			}
+			void RNDIS_Host_USBTask(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
@@ -245,9 +289,7 @@
 			#define RNDIS_DATA_SUBCLASS               0x00
 			#define RNDIS_DATA_PROTOCOL               0x00
 			
-			#define RNDIS_FOUND_DATAPIPE_IN           (1 << 0)
-			#define RNDIS_FOUND_DATAPIPE_OUT          (1 << 1)
-			#define RNDIS_FOUND_NOTIFICATION_IN       (1 << 2)
+			#define RNDIS_MAX_PACKET_ALIGNMENT        3
 
 		/* Function Prototypes: */
 			#if defined(__INCLUDE_FROM_RNDIS_CLASS_HOST_C)
@@ -255,10 +297,8 @@
 				                                             void* Buffer, uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
 				static uint8_t RNDIS_GetEncapsulatedResponse(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo,
 				                                             void* Buffer, uint16_t Length) ATTR_NON_NULL_PTR_ARG(1);
+				static uint8_t RNDIS_Host_EndOUTTransfer(USB_ClassInfo_RNDIS_Host_t* const RNDISInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 
-				static uint8_t DComp_RNDIS_Host_NextRNDISControlInterface(void* const CurrentDescriptor) ATTR_NON_NULL_PTR_ARG(1);
-				static uint8_t DComp_RNDIS_Host_NextRNDISDataInterface(void* const CurrentDescriptor) ATTR_NON_NULL_PTR_ARG(1);
-				static uint8_t DComp_RNDIS_Host_NextRNDISInterfaceEndpoint(void* const CurrentDescriptor);
 			#endif	
 	#endif
 				
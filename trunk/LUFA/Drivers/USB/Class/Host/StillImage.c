@@ -39,109 +39,71 @@
 uint8_t SImage_Host_ConfigurePipes(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, uint16_t ConfigDescriptorSize,
                                    void* DeviceConfigDescriptor)
 {
-	uint8_t  FoundEndpoints = 0;
-	
-	memset(&SIInterfaceInfo->State, 0x00, sizeof(SIInterfaceInfo->State));
-	
-	if (DESCRIPTOR_TYPE(DeviceConfigDescriptor) != DTYPE_Configuration)
-	  return SI_ENUMERROR_InvalidConfigDescriptor;
-	
-	if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &DeviceConfigDescriptor,
-	                              DComp_SI_Host_NextSIInterface) != DESCRIPTOR_SEARCH_COMP_Found)
-	{
-		return SI_ENUMERROR_NoSIInterfaceFound;
-	}
+	USB_ConfigIndex_t ConfigIndex;
+	uint8_t           ErrorCode;
 
-	while (FoundEndpoints != (SI_FOUND_EVENTS_IN | SI_FOUND_DATAPIPE_IN | SI_FOUND_DATAPIPE_OUT))
+	if (USB_IndexConfigDescriptor(&ConfigIndex, ConfigDescriptorSize, DeviceConfigDescriptor) == INDEX_CONFIG_InvalidConfigDescriptor)
 	{
-		if (USB_GetNextDescriptorComp(&ConfigDescriptorSize, &DeviceConfigDescriptor,
-		                              DComp_SI_Host_NextSIInterfaceEndpoint) != DESCRIPTOR_SEARCH_COMP_Found)
-		{
-			return SI_ENUMERROR_EndpointsNotFound;
-		}
-		
-		USB_Descriptor_Endpoint_t* EndpointData = DESCRIPTOR_PCAST(DeviceConfigDescriptor, USB_Descriptor_Endpoint_t);
-
-		if ((EndpointData->Attributes & EP_TYPE_MASK) == EP_TYPE_INTERRUPT)
-		{
-			if (EndpointData->EndpointAddress & ENDPOINT_DESCRIPTOR_DIR_IN)
-			{
-				Pipe_ConfigurePipe(SIInterfaceInfo->Config.EventsPipeNumber, EP_TYPE_INTERRUPT, PIPE_TOKEN_IN,
-								   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-								   SIInterfaceInfo->Config.EventsPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);			
-				SIInterfaceInfo->State.EventsPipeSize = EndpointData->EndpointSize;
-
-				Pipe_SetInterruptPeriod(EndpointData->PollingIntervalMS);
-				
-				FoundEndpoints |= SI_FOUND_EVENTS_IN;
-			}
-		}
-		else
-		{
-			if (EndpointData->EndpointAddress & ENDPOINT_DESCRIPTOR_DIR_IN)
-			{
-				Pipe_ConfigurePipe(SIInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
-								   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-								   SIInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-				SIInterfaceInfo->State.DataINPipeSize = EndpointData->EndpointSize;
-
-				FoundEndpoints |= SI_FOUND_DATAPIPE_IN;
-			}
-			else
-			{
-				Pipe_ConfigurePipe(SIInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
-								   EndpointData->EndpointAddress, EndpointData->EndpointSize,
-								   SIInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
-				SIInterfaceInfo->State.DataOUTPipeSize = EndpointData->EndpointSize;
-
-				FoundEndpoints |= SI_FOUND_DATAPIPE_OUT;
-			}
-		}
+		memset(&SIInterfaceInfo->State, 0x00, sizeof(SIInterfaceInfo->State));
+		return SI_ENUMERROR_InvalidConfigDescriptor;
 	}
 
-	SIInterfaceInfo->State.IsActive = true;
-	return SI_ENUMERROR_NoError;
+	/* Descriptors with more interfaces or endpoints than the index holds are searched a window at a time */
+	while (((ErrorCode = SImage_Host_ConfigurePipesIndexed(SIInterfaceInfo, &ConfigIndex)) != SI_ENUMERROR_NoError) &&
+	       USB_IndexNextConfigWindow(&ConfigIndex, ConfigDescriptorSize, DeviceConfigDescriptor));
+
+	return ErrorCode;
 }
 
-uint8_t DComp_SI_Host_NextSIInterface(void* const CurrentDescriptor)
+uint8_t SImage_Host_ConfigurePipesIndexed(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo,
+                                          const USB_ConfigIndex_t* const ConfigIndex)
 {
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		USB_Descriptor_Interface_t* CurrentInterface = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                                USB_Descriptor_Interface_t);
+	USB_Descriptor_Endpoint_t* EventsEndpoint;
+	USB_Descriptor_Endpoint_t* DataINEndpoint;
+	USB_Descriptor_Endpoint_t* DataOUTEndpoint;
+	uint8_t                    SIInterface = 0;
+	uint8_t                    ErrorCode = SI_ENUMERROR_NoSIInterfaceFound;
 
-		if ((CurrentInterface->Class    == STILL_IMAGE_CLASS)    &&
-		    (CurrentInterface->SubClass == STILL_IMAGE_SUBCLASS) &&
-		    (CurrentInterface->Protocol == STILL_IMAGE_PROTOCOL))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
-	}
-	
-	return DESCRIPTOR_SEARCH_NotFound;
-}
+	memset(&SIInterfaceInfo->State, 0x00, sizeof(SIInterfaceInfo->State));
 
-uint8_t DComp_SI_Host_NextSIInterfaceEndpoint(void* const CurrentDescriptor)
-{
-	if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Endpoint)
+	for (;;)
 	{
-		USB_Descriptor_Endpoint_t* CurrentEndpoint = DESCRIPTOR_PCAST(CurrentDescriptor,
-		                                                              USB_Descriptor_Endpoint_t);
-	
-		uint8_t EndpointType = (CurrentEndpoint->Attributes & EP_TYPE_MASK);
+		SIInterface = USB_GetIndexedInterface(ConfigIndex, SIInterface, STILL_IMAGE_CLASS, STILL_IMAGE_SUBCLASS,
+		                                      STILL_IMAGE_PROTOCOL, INDEX_MATCH_ALL);
 
-		if (((EndpointType == EP_TYPE_BULK) || (EndpointType == EP_TYPE_INTERRUPT)) &&
-		    (!(Pipe_IsEndpointBound(CurrentEndpoint->EndpointAddress))))
-		{
-			return DESCRIPTOR_SEARCH_Found;
-		}
-	}
-	else if (DESCRIPTOR_TYPE(CurrentDescriptor) == DTYPE_Interface)
-	{
-		return DESCRIPTOR_SEARCH_Fail;
+		if (SIInterface == INDEX_NO_INTERFACE)
+		  return ErrorCode;
+
+		EventsEndpoint  = USB_GetIndexedEndpoint(ConfigIndex, SIInterface, EP_TYPE_INTERRUPT, ENDPOINT_DESCRIPTOR_DIR_IN);
+		DataINEndpoint  = USB_GetIndexedEndpoint(ConfigIndex, SIInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_IN);
+		DataOUTEndpoint = USB_GetIndexedEndpoint(ConfigIndex, SIInterface, EP_TYPE_BULK, ENDPOINT_DESCRIPTOR_DIR_OUT);
+
+		if ((EventsEndpoint != NULL) && (DataINEndpoint != NULL) && (DataOUTEndpoint != NULL))
+		  break;
+
+		ErrorCode = SI_ENUMERROR_EndpointsNotFound;
+		SIInterface++;
 	}
 
-	return DESCRIPTOR_SEARCH_NotFound;
+	Pipe_ConfigurePipe(SIInterfaceInfo->Config.EventsPipeNumber, EP_TYPE_INTERRUPT, PIPE_TOKEN_IN,
+	                   EventsEndpoint->EndpointAddress, EventsEndpoint->EndpointSize,
+	                   SIInterfaceInfo->Config.EventsPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	SIInterfaceInfo->State.EventsPipeSize = EventsEndpoint->EndpointSize;
+
+	Pipe_SetInterruptPeriod(EventsEndpoint->PollingIntervalMS);
+
+	Pipe_ConfigurePipe(SIInterfaceInfo->Config.DataINPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_IN,
+	                   DataINEndpoint->EndpointAddress, DataINEndpoint->EndpointSize,
+	                   SIInterfaceInfo->Config.DataINPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	SIInterfaceInfo->State.DataINPipeSize = DataINEndpoint->EndpointSize;
+
+	Pipe_ConfigurePipe(SIInterfaceInfo->Config.DataOUTPipeNumber, EP_TYPE_BULK, PIPE_TOKEN_OUT,
+	                   DataOUTEndpoint->EndpointAddress, DataOUTEndpoint->EndpointSize,
+	                   SIInterfaceInfo->Config.DataOUTPipeDoubleBank ? PIPE_BANK_DOUBLE : PIPE_BANK_SINGLE);
+	SIInterfaceInfo->State.DataOUTPipeSize = DataOUTEndpoint->EndpointSize;
+
+	SIInterfaceInfo->State.IsActive = true;
+	return SI_ENUMERROR_NoError;
 }
 
 uint8_t SImage_Host_SendBlockHeader(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, SI_PIMA_Container_t* const PIMAHeader)
@@ -156,16 +118,16 @@ uint8_t SImage_Host_SendBlockHeader(USB_ClassInfo_SI_Host_t* const SIInterfaceIn
 	Pipe_SelectPipe(SIInterfaceInfo->Config.DataOUTPipeNumber);
 	Pipe_Unfreeze();
 
-	if ((ErrorCode = Pipe_Write_Stream_LE(PIMAHeader, PIMA_COMMAND_SIZE(0), NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
-	  return ErrorCode;
-	
-	uint8_t ParamBytes = (PIMAHeader->DataLength - PIMA_COMMAND_SIZE(0));
+	USB_StreamSegment_t HeaderSegments[] =
+		{
+			{.Buffer = PIMAHeader,          .Length = PIMA_COMMAND_SIZE(0), .MemorySpace = STREAMSEGMENT_RAM},
+			{.Buffer = &PIMAHeader->Params, .Length = (PIMAHeader->DataLength - PIMA_COMMAND_SIZE(0)), .MemorySpace = STREAMSEGMENT_RAM},
+		};
 
-	if (ParamBytes)
-	{
-		if ((ErrorCode = Pipe_Write_Stream_LE(&PIMAHeader->Params, ParamBytes, NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
-		  return ErrorCode;
-	}
+	ErrorCode = Pipe_Write_StreamV(HeaderSegments, (sizeof(HeaderSegments) / sizeof(HeaderSegments[0])), NO_STREAM_CALLBACK);
+
+	if (ErrorCode != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
 	
 	Pipe_ClearOUT();	
 	Pipe_Freeze();
@@ -272,6 +234,249 @@ uint8_t SImage_Host_ReadData(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, voi
 	return ErrorCode;
 }
 
+uint8_t SImage_Host_ReceiveDataStreamed(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, void* const ChunkBuffer,
+                                        const uint16_t ChunkSize, SI_Host_DataCallbackPtr_t Callback)
+{
+	return SImage_Host_ReceiveDataPhase(SIInterfaceInfo, 0, ChunkBuffer, ChunkSize, Callback);
+}
+
+static uint8_t SImage_Host_ReceiveDataPhase(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, uint32_t Offset,
+                                            uint8_t* const ChunkBuffer, const uint16_t ChunkSize,
+                                            SI_Host_DataCallbackPtr_t Callback)
+{
+	SI_PIMA_Container_t PIMABlock;
+	uint8_t             ErrorCode;
+
+	if ((ErrorCode = SImage_Host_ReceiveBlockHeader(SIInterfaceInfo, &PIMABlock)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	if (PIMABlock.Type != CType_DataBlock)
+	{
+		/* A device which rejects the command sends its response block in place of the data, which has now been consumed */
+		if (PIMABlock.Type == CType_ResponseBlock)
+		  SIInterfaceInfo->State.ResponseCode = PIMABlock.Code;
+
+		return SI_ERROR_LOGICAL_CMD_FAILED;
+	}
+
+	uint32_t BytesRemaining = 0;
+	
+	if (PIMABlock.DataLength > PIMA_DATA_SIZE(0))
+	  BytesRemaining = (PIMABlock.DataLength - PIMA_DATA_SIZE(0));
+
+	SIInterfaceInfo->State.DataPhaseLength = BytesRemaining;
+
+	Pipe_SelectPipe(SIInterfaceInfo->Config.DataINPipeNumber);
+	Pipe_Unfreeze();
+
+	uint16_t BankBytes   = Pipe_BytesInPipe();
+	uint16_t ChunkLength = 0;
+
+	while (BytesRemaining)
+	{
+		if (!(BankBytes))
+		{
+			Pipe_ClearIN();
+
+			if ((ErrorCode = Pipe_WaitUntilReady()) != PIPE_READYWAIT_NoError)
+			{
+				Pipe_Freeze();
+				return ErrorCode;
+			}
+
+			/* A Zero Length Packet before the end of the data indicates that the device has aborted the data phase */
+			if (!(BankBytes = Pipe_BytesInPipe()))
+			{
+				Pipe_ClearIN();
+				Pipe_Freeze();
+				return SI_ERROR_LOGICAL_CMD_FAILED;
+			}
+		}
+
+		uint16_t BytesToCopy = (ChunkSize - ChunkLength);
+
+		if (BytesToCopy > BankBytes)
+		  BytesToCopy = BankBytes;
+
+		if (BytesToCopy > BytesRemaining)
+		  BytesToCopy = BytesRemaining;
+
+		uint8_t* ChunkPos = &ChunkBuffer[ChunkLength];
+
+		BankBytes      -= BytesToCopy;
+		BytesRemaining -= BytesToCopy;
+		ChunkLength    += BytesToCopy;
+
+		while (BytesToCopy--)
+		  *(ChunkPos++) = Pipe_Read_Byte();
+
+		if ((ChunkLength == ChunkSize) || !(BytesRemaining))
+		{
+			/* The pipe is left unfrozen while the callback runs, so that the next packet can be received in the meantime */
+			if ((ErrorCode = Callback(SIInterfaceInfo, ChunkBuffer, ChunkLength, Offset)) != PIPE_RWSTREAM_NoError)
+			{
+				Pipe_SelectPipe(SIInterfaceInfo->Config.DataINPipeNumber);
+				Pipe_Freeze();
+				return ErrorCode;
+			}
+
+			Offset     += ChunkLength;
+			ChunkLength = 0;
+
+			Pipe_SelectPipe(SIInterfaceInfo->Config.DataINPipeNumber);
+		}
+	}
+
+	Pipe_ClearIN();
+
+	/* Containers which are an exact multiple of the pipe size are terminated by a Zero Length Packet */
+	if (!(PIMABlock.DataLength % SIInterfaceInfo->State.DataINPipeSize))
+	{
+		if ((ErrorCode = Pipe_WaitUntilReady()) != PIPE_READYWAIT_NoError)
+		{
+			Pipe_Freeze();
+			return ErrorCode;
+		}
+
+		Pipe_ClearIN();
+	}
+
+	Pipe_Freeze();
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint8_t SImage_Host_SendDataStreamed(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, const uint16_t Operation,
+                                     const uint32_t TotalBytes, void* const ChunkBuffer, const uint16_t ChunkSize,
+                                     SI_Host_DataCallbackPtr_t Callback)
+{
+	uint8_t ErrorCode;
+
+	if ((USB_HostState != HOST_STATE_Configured) || !(SIInterfaceInfo->State.IsActive))
+	  return PIPE_RWSTREAM_DeviceDisconnected;
+
+	SI_PIMA_Container_t PIMABlock = (SI_PIMA_Container_t)
+							{
+								.DataLength    = PIMA_DATA_SIZE(TotalBytes),
+								.Type          = CType_DataBlock,
+								.Code          = Operation,
+								.TransactionID = (SIInterfaceInfo->State.TransactionID - 1),
+							};
+
+	SIInterfaceInfo->State.DataPhaseLength = TotalBytes;
+
+	Pipe_SelectPipe(SIInterfaceInfo->Config.DataOUTPipeNumber);
+	Pipe_Unfreeze();
+
+	if ((ErrorCode = Pipe_Write_Stream_LE(&PIMABlock, PIMA_DATA_SIZE(0), NO_STREAM_CALLBACK)) != PIPE_RWSTREAM_NoError)
+	{
+		Pipe_Freeze();
+		return ErrorCode;
+	}
+
+	uint32_t BytesRemaining = TotalBytes;
+	uint32_t Offset         = 0;
+	uint16_t BankSpace      = (SIInterfaceInfo->State.DataOUTPipeSize - Pipe_BytesInPipe());
+
+	while (BytesRemaining)
+	{
+		uint16_t ChunkLength = ChunkSize;
+
+		if (ChunkLength > BytesRemaining)
+		  ChunkLength = BytesRemaining;
+
+		if ((ErrorCode = Callback(SIInterfaceInfo, ChunkBuffer, ChunkLength, Offset)) != PIPE_RWSTREAM_NoError)
+		{
+			Pipe_SelectPipe(SIInterfaceInfo->Config.DataOUTPipeNumber);
+			Pipe_Freeze();
+			return ErrorCode;
+		}
+
+		Pipe_SelectPipe(SIInterfaceInfo->Config.DataOUTPipeNumber);
+
+		uint8_t* ChunkPos = ChunkBuffer;
+
+		Offset         += ChunkLength;
+		BytesRemaining -= ChunkLength;
+
+		while (ChunkLength)
+		{
+			if (!(BankSpace))
+			{
+				Pipe_ClearOUT();
+
+				if ((ErrorCode = Pipe_WaitUntilReady()) != PIPE_READYWAIT_NoError)
+				{
+					Pipe_Freeze();
+					return ErrorCode;
+				}
+
+				BankSpace = SIInterfaceInfo->State.DataOUTPipeSize;
+			}
+
+			uint16_t BytesToCopy = BankSpace;
+
+			if (BytesToCopy > ChunkLength)
+			  BytesToCopy = ChunkLength;
+
+			BankSpace   -= BytesToCopy;
+			ChunkLength -= BytesToCopy;
+
+			while (BytesToCopy--)
+			  Pipe_Write_Byte(*(ChunkPos++));
+		}
+	}
+
+	Pipe_ClearOUT();
+
+	/* Containers which are an exact multiple of the pipe size must be terminated by a Zero Length Packet */
+	if (!(PIMABlock.DataLength % SIInterfaceInfo->State.DataOUTPipeSize))
+	{
+		if ((ErrorCode = Pipe_WaitUntilReady()) != PIPE_READYWAIT_NoError)
+		{
+			Pipe_Freeze();
+			return ErrorCode;
+		}
+
+		Pipe_ClearOUT();
+	}
+
+	Pipe_Freeze();
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint8_t SImage_Host_GetObjectStreamed(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, const uint32_t ObjectHandle,
+                                      void* const ChunkBuffer, const uint16_t ChunkSize, SI_Host_DataCallbackPtr_t Callback)
+{
+	uint8_t  ErrorCode;
+	uint32_t Params[1] = {ObjectHandle};
+
+	if ((ErrorCode = SImage_Host_SendCommand(SIInterfaceInfo, PIMA_OPERATION_GetObject, 1, Params)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	if ((ErrorCode = SImage_Host_ReceiveDataPhase(SIInterfaceInfo, 0, ChunkBuffer, ChunkSize, Callback)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	return SImage_Host_ReceiveResponse(SIInterfaceInfo);
+}
+
+uint8_t SImage_Host_GetPartialObjectStreamed(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, const uint32_t ObjectHandle,
+                                             const uint32_t Offset, const uint32_t MaxBytes, void* const ChunkBuffer,
+                                             const uint16_t ChunkSize, SI_Host_DataCallbackPtr_t Callback)
+{
+	uint8_t  ErrorCode;
+	uint32_t Params[3] = {ObjectHandle, Offset, MaxBytes};
+
+	if ((ErrorCode = SImage_Host_SendCommand(SIInterfaceInfo, PIMA_OPERATION_GetPartialObject, 3, Params)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	if ((ErrorCode = SImage_Host_ReceiveDataPhase(SIInterfaceInfo, Offset, ChunkBuffer, ChunkSize, Callback)) != PIPE_RWSTREAM_NoError)
+	  return ErrorCode;
+
+	return SImage_Host_ReceiveResponse(SIInterfaceInfo);
+}
+
 bool SImage_Host_IsEventReceived(USB_ClassInfo_SI_Host_t* SIInterfaceInfo)
 {
 	bool IsEventReceived = false;
@@ -401,6 +606,9 @@ uint8_t SImage_Host_ReceiveResponse(USB_ClassInfo_SI_Host_t* const SIInterfaceIn
 	if ((ErrorCode = SImage_Host_ReceiveBlockHeader(SIInterfaceInfo, &PIMABlock)) != PIPE_RWSTREAM_NoError)
 	  return ErrorCode;
 
+	if (PIMABlock.Type == CType_ResponseBlock)
+	  SIInterfaceInfo->State.ResponseCode = PIMABlock.Code;
+
 	if ((PIMABlock.Type != CType_ResponseBlock) || (PIMABlock.Code != 0x2001))
 	  return SI_ERROR_LOGICAL_CMD_FAILED;
 	  
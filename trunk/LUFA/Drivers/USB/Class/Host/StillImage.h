@@ -38,6 +38,17 @@
  *  \section Module Description
  *  Host Mode USB Class driver framework interface, for the Still Image USB Class driver.
  *
+ *  \section Sec_SIHostStreaming Streamed Data Phases
+ *  PIMA data phases such as the contents of a GetObject command may be many megabytes in length, far larger than the
+ *  available RAM. The \ref SImage_Host_ReceiveDataStreamed() and \ref SImage_Host_SendDataStreamed() functions transfer
+ *  a data phase of up to 4GB in fixed size chunks through a small application supplied chunk buffer, calling a
+ *  \ref SI_Host_DataCallbackPtr_t routine to sink or source each chunk in turn (for example, to write it to a file or
+ *  Dataflash page). While the callback processes a chunk the data pipe remains active, so that with double banking
+ *  enabled the next packet is transferred over the bus concurrently. \ref SImage_Host_GetObjectStreamed() and
+ *  \ref SImage_Host_GetPartialObjectStreamed() wrap the complete command, data and response phases of the PIMA
+ *  GetObject and GetPartialObject operations; the latter allows a large object to be retrieved in several segments,
+ *  for example to resume an interrupted transfer.
+ *
  *  @{
  */
 
@@ -63,6 +74,17 @@
 			/** Error code for some Still Image Host functions, indicating a logical (and not hardware) error */
 			#define SI_ERROR_LOGICAL_CMD_FAILED              0x80
 
+			/** PIMA operation code to retrieve the contents of an object from the device. */
+			#define PIMA_OPERATION_GetObject                 0x1009
+
+			/** PIMA operation code to send the contents of an object to the device, after its information dataset has been
+			 *  sent via a SendObjectInfo operation.
+			 */
+			#define PIMA_OPERATION_SendObject                0x100D
+
+			/** PIMA operation code to retrieve a portion of the contents of an object from the device. */
+			#define PIMA_OPERATION_GetPartialObject          0x101B
+
 		/* Type Defines: */
 			typedef struct
 			{
@@ -92,11 +114,32 @@
 					
 					bool IsSessionOpen; /**< Indicates if a PIMA session is currently open with the attached device */
 					uint32_t TransactionID; /**< Transaction ID for the next transaction to send to the device */
+
+					uint32_t DataPhaseLength; /**< Total length in bytes of the data in the current or last streamed data phase,
+					                           *   valid from the first call of the data phase's callback routine
+					                           */
+					uint16_t ResponseCode; /**< PIMA response code of the last response block received from the device */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 						  *   <b>may</b> be set to initial values, but may also be ignored to default to sane values when
 						  *   the interface is enumerated.
 						  */
 			} USB_ClassInfo_SI_Host_t;
+
+			/** Type define for a data phase chunk callback routine, used by the streamed data phase functions such as
+			 *  \ref SImage_Host_ReceiveDataStreamed() and \ref SImage_Host_SendDataStreamed() to sink or source each chunk of
+			 *  the data phase. When receiving, the chunk buffer holds the received data to process; when sending, the callback
+			 *  must fill the chunk buffer with the data to send. The callback may freely use other pipes.
+			 *
+			 *  \param[in,out] SIInterfaceInfo  Pointer to a structure containing a Still Image Class host configuration and state
+			 *  \param[in,out] Buffer  Pointer to the chunk buffer
+			 *  \param[in] Length  Number of bytes of the chunk, which is the full chunk buffer size for all but the last chunk
+			 *  \param[in] Offset  Offset in bytes of the chunk within the object or data phase
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum, where any value other than
+			 *          \ref PIPE_RWSTREAM_NoError aborts the transfer
+			 */
+			typedef uint8_t (*SI_Host_DataCallbackPtr_t)(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, void* const Buffer,
+			                                             const uint16_t Length, const uint32_t Offset);
 	
 		/* Enums: */
 			/** Enum for the possible error codes returned by the \ref SImage_Host_ConfigurePipes() function. */
@@ -128,6 +171,23 @@
 			uint8_t SImage_Host_ConfigurePipes(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, uint16_t ConfigDescriptorSize,
                                                void* DeviceConfigDescriptor) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
 
+			/** Host interface configuration routine, to configure a given Still Image host interface instance using a Configuration
+			 *  Descriptor index built by \ref USB_IndexConfigDescriptor(). This behaves as \ref SImage_Host_ConfigurePipes(), but
+			 *  allows the attached device's Configuration Descriptor to be indexed once and then shared between all the class
+			 *  driver instances which are to bind to the device.
+			 *
+			 *  Only the interfaces within the index's current window are searched. If the index is truncated (see
+			 *  \ref USB_IndexNextConfigWindow()) and no matching interface is found, the caller may index the next window
+			 *  and call this function again.
+			 *
+			 *  \param[in,out] SIInterfaceInfo  Pointer to a structure containing a Still Image Class host configuration and state
+			 *  \param[in] ConfigIndex  Pointer to an index of the attached device's Configuration Descriptor
+			 *
+			 *  \return A value from the \ref SIHost_EnumerationFailure_ErrorCodes_t enum
+			 */
+			uint8_t SImage_Host_ConfigurePipesIndexed(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo,
+			                                          const USB_ConfigIndex_t* const ConfigIndex) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
 			/** Opens a new PIMA session with the attached device. This should be used before any session-orientated PIMA commands
 			 *  are issued to the device. Only one session can be open at the one time.
 			 *	
@@ -197,7 +257,8 @@
 			                                const uint8_t TotalParams, uint32_t* Params) ATTR_NON_NULL_PTR_ARG(1);
 
 			/** Receives and checks a response block from the attached PIMA device, once a command has been issued and all data
-			 *  associated with the command has been transferred.
+			 *  associated with the command has been transferred. The block's response code is stored into the interface's
+			 *  ResponseCode state element.
 			 *	
 			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or the
 			 *        call will fail.
@@ -264,6 +325,103 @@
 			 */
 			uint8_t SImage_Host_ReadData(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, void* Buffer,
 			                             const uint16_t Bytes) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Receives the data phase of a previously issued PIMA command from the attached device, passing the data to the
+			 *  given callback routine in chunks rather than storing it into a single RAM buffer (see \ref Sec_SIHostStreaming).
+			 *  The total data length is read from the 32-bit length of the data container, and stored into the interface's
+			 *  DataPhaseLength state element. The response phase must then be received via \ref SImage_Host_ReceiveResponse().
+			 *
+			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or the
+			 *        call will fail.
+			 *
+			 *  \note If the transfer is aborted part way through by the callback or a pipe error, the PIMA session should be
+			 *        closed and the device reset before it is used again.
+			 *
+			 *  \param[in,out] SIInterfaceInfo  Pointer to a structure containing a Still Image Class host configuration and state
+			 *  \param[out] ChunkBuffer  Pointer to a buffer where each chunk of received data is stored before it is passed to the callback
+			 *  \param[in] ChunkSize  Size in bytes of the chunk buffer
+			 *  \param[in] Callback  Routine to process each chunk of received data
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum, or \ref SI_ERROR_LOGICAL_CMD_FAILED if the device
+			 *          returned a response block instead of a data block (in which case the response has been consumed, and
+			 *          its code stored into the interface's ResponseCode state element), or ended the data phase early
+			 */
+			uint8_t SImage_Host_ReceiveDataStreamed(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, void* const ChunkBuffer,
+			                                        const uint16_t ChunkSize, SI_Host_DataCallbackPtr_t Callback)
+			                                        ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2) ATTR_NON_NULL_PTR_ARG(4);
+
+			/** Sends the data phase of a previously issued PIMA command to the attached device, requesting the data from the given
+			 *  callback routine in chunks rather than sourcing it from a single RAM buffer (see \ref Sec_SIHostStreaming). The
+			 *  data container header is generated automatically. The response phase must then be received via
+			 *  \ref SImage_Host_ReceiveResponse().
+			 *
+			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or the
+			 *        call will fail.
+			 *
+			 *  \note If the transfer is aborted part way through by the callback or a pipe error, the PIMA session should be
+			 *        closed and the device reset before it is used again.
+			 *
+			 *  \param[in,out] SIInterfaceInfo  Pointer to a structure containing a Still Image Class host configuration and state
+			 *  \param[in] Operation  PIMA operation code of the command the data phase belongs to
+			 *  \param[in] TotalBytes  Total length in bytes of the data to send
+			 *  \param[out] ChunkBuffer  Pointer to a buffer which the callback fills with each chunk of data to send
+			 *  \param[in] ChunkSize  Size in bytes of the chunk buffer
+			 *  \param[in] Callback  Routine to fill the chunk buffer with each chunk of data to send
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum
+			 */
+			uint8_t SImage_Host_SendDataStreamed(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, const uint16_t Operation,
+			                                     const uint32_t TotalBytes, void* const ChunkBuffer, const uint16_t ChunkSize,
+			                                     SI_Host_DataCallbackPtr_t Callback)
+			                                     ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(4) ATTR_NON_NULL_PTR_ARG(6);
+
+			/** Retrieves the contents of an object from the attached device via the PIMA GetObject operation, passing the object
+			 *  data to the given callback routine in chunks as it is received (see \ref Sec_SIHostStreaming). The object's total
+			 *  size is stored into the interface's DataPhaseLength state element.
+			 *
+			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or the
+			 *        call will fail.
+			 *
+			 *  \param[in,out] SIInterfaceInfo  Pointer to a structure containing a Still Image Class host configuration and state
+			 *  \param[in] ObjectHandle  Handle of the object to retrieve
+			 *  \param[out] ChunkBuffer  Pointer to a buffer where each chunk of received data is stored before it is passed to the callback
+			 *  \param[in] ChunkSize  Size in bytes of the chunk buffer
+			 *  \param[in] Callback  Routine to process each chunk of the object
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum, or \ref SI_ERROR_LOGICAL_CMD_FAILED if the device
+			 *          returned a logical command failure, whose PIMA response code is stored into the interface's
+			 *          ResponseCode state element
+			 */
+			uint8_t SImage_Host_GetObjectStreamed(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, const uint32_t ObjectHandle,
+			                                      void* const ChunkBuffer, const uint16_t ChunkSize, SI_Host_DataCallbackPtr_t Callback)
+			                                      ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3) ATTR_NON_NULL_PTR_ARG(5);
+
+			/** Retrieves a portion of the contents of an object from the attached device via the PIMA GetPartialObject operation,
+			 *  passing the data to the given callback routine in chunks as it is received (see \ref Sec_SIHostStreaming). The
+			 *  offsets passed to the callback are relative to the start of the object rather than the start of the portion, so
+			 *  that a large object may be retrieved through the one callback in several segments. The number of bytes returned
+			 *  by the device, which may be less than requested at the end of the object, is stored into the interface's
+			 *  DataPhaseLength state element.
+			 *
+			 *  \note This function must only be called when the Host state machine is in the HOST_STATE_Configured state or the
+			 *        call will fail.
+			 *
+			 *  \param[in,out] SIInterfaceInfo  Pointer to a structure containing a Still Image Class host configuration and state
+			 *  \param[in] ObjectHandle  Handle of the object to retrieve
+			 *  \param[in] Offset  Offset in bytes within the object of the first byte to retrieve
+			 *  \param[in] MaxBytes  Maximum number of bytes to retrieve
+			 *  \param[out] ChunkBuffer  Pointer to a buffer where each chunk of received data is stored before it is passed to the callback
+			 *  \param[in] ChunkSize  Size in bytes of the chunk buffer
+			 *  \param[in] Callback  Routine to process each chunk of the object
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum, or \ref SI_ERROR_LOGICAL_CMD_FAILED if the device
+			 *          returned a logical command failure, whose PIMA response code is stored into the interface's
+			 *          ResponseCode state element
+			 */
+			uint8_t SImage_Host_GetPartialObjectStreamed(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, const uint32_t ObjectHandle,
+			                                             const uint32_t Offset, const uint32_t MaxBytes, void* const ChunkBuffer,
+			                                             const uint16_t ChunkSize, SI_Host_DataCallbackPtr_t Callback)
+			                                             ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(5) ATTR_NON_NULL_PTR_ARG(7);
 		
 		/* Inline Functions: */
 			/** General management task for a given Still Image host class interface, required for the correct operation of the
@@ -285,17 +443,15 @@
 			#define STILL_IMAGE_SUBCLASS           0x01
 			#define STILL_IMAGE_PROTOCOL           0x01
 
-			#define SI_FOUND_EVENTS_IN             (1 << 0)
-			#define SI_FOUND_DATAPIPE_IN           (1 << 1)
-			#define SI_FOUND_DATAPIPE_OUT          (1 << 2)
-
 			#define COMMAND_DATA_TIMEOUT_MS        10000
-		
+
 		/* Function Prototypes: */
-			#if defined(__INCLUDE_FROM_SI_CLASS_HOST_C)
-				static uint8_t DComp_SI_Host_NextSIInterface(void* const CurrentDescriptor) ATTR_NON_NULL_PTR_ARG(1);
-				static uint8_t DComp_SI_Host_NextSIInterfaceEndpoint(void* const CurrentDescriptor) ATTR_NON_NULL_PTR_ARG(1);
-			#endif
+		#if defined(__INCLUDE_FROM_SI_CLASS_HOST_C)
+			static uint8_t SImage_Host_ReceiveDataPhase(USB_ClassInfo_SI_Host_t* const SIInterfaceInfo, uint32_t Offset,
+			                                            uint8_t* const ChunkBuffer, const uint16_t ChunkSize,
+			                                            SI_Host_DataCallbackPtr_t Callback) ATTR_NON_NULL_PTR_ARG(1)
+			                                            ATTR_NON_NULL_PTR_ARG(3) ATTR_NON_NULL_PTR_ARG(5);
+		#endif
 	#endif
 	
 	/* Disable C linkage for C++ Compilers: */
@@ -35,6 +35,7 @@
  *  The following files must be built with any user project that uses this module:
  *    - LUFA/Drivers/USB/Class/Device/MIDI.c
  *    - LUFA/Drivers/USB/Class/Host/MIDI.c
+ *    - LUFA/Drivers/USB/Class/Common/MIDI.c
  *
  *  \section Module Description
  *  MIDI Class Driver module. This module contains an internal implementation of the USB MIDI Class, for both Device
@@ -44,6 +45,9 @@
  *  This module is designed to simplify the user code by exposing only the required interface needed to interface with
  *  Hosts or Devices using the USB MIDI Class.
  *
+ *  System Exclusive messages, such as patch and firmware dumps, may be split into event packets for sending via the
+ *  \ref MIDI_SegmentSysEx() function, and received event packets joined back into messages via \ref MIDI_AssembleSysEx().
+ *
  *  \note The USB MIDI class is actually a special case of the regular Audio class, thus this module depends on
  *        structure definitions from the \ref Group_USBClassAudioDevice class driver module.
  *
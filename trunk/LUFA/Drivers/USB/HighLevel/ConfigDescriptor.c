@@ -29,6 +29,7 @@
 */
 
 #define  __INCLUDE_FROM_USB_DRIVER
+#define  __INCLUDE_FROM_CONFIGDESCRIPTOR_C
 #include "ConfigDescriptor.h"
 
 #if defined(USB_CAN_BE_HOST)
@@ -67,6 +68,196 @@ uint8_t USB_Host_GetDeviceConfigDescriptor(uint8_t ConfigNumber, uint16_t* const
 	
 	return HOST_GETCONFIG_Successful;
 }
+
+uint8_t USB_IndexConfigDescriptor(USB_ConfigIndex_t* const Index,
+                                  uint16_t ConfigDescriptorSize,
+                                  void* ConfigDescriptorData)
+{
+	if ((ConfigDescriptorSize < sizeof(USB_Descriptor_Configuration_Header_t)) ||
+	    (DESCRIPTOR_TYPE(ConfigDescriptorData) != DTYPE_Configuration))
+	{
+		Index->TotalInterfaces = 0;
+		Index->TotalEndpoints  = 0;
+		Index->NextWindow      = NULL;
+
+		return INDEX_CONFIG_InvalidConfigDescriptor;
+	}
+
+	return USB_IndexDescriptors(Index, ConfigDescriptorSize, ConfigDescriptorData);
+}
+
+bool USB_IndexNextConfigWindow(USB_ConfigIndex_t* const Index,
+                               uint16_t ConfigDescriptorSize,
+                               void* ConfigDescriptorData)
+{
+	void* WindowStart = Index->NextWindow;
+
+	if (WindowStart == NULL)
+	  return false;
+
+	ConfigDescriptorSize -= (WindowStart - ConfigDescriptorData);
+
+	return (USB_IndexDescriptors(Index, ConfigDescriptorSize, WindowStart) != INDEX_CONFIG_InvalidConfigDescriptor);
+}
+
+static uint8_t USB_IndexDescriptors(USB_ConfigIndex_t* const Index,
+                                    uint16_t BytesRem,
+                                    void* CurrConfigLoc)
+{
+	USB_IndexedInterface_t* CurrInterface = NULL;
+	uint8_t                 ErrorCode     = INDEX_CONFIG_Successful;
+
+	Index->TotalInterfaces = 0;
+	Index->TotalEndpoints  = 0;
+	Index->NextWindow      = NULL;
+
+	while (BytesRem)
+	{
+		uint8_t DescriptorSize = DESCRIPTOR_SIZE(CurrConfigLoc);
+		uint8_t DescriptorType = DESCRIPTOR_TYPE(CurrConfigLoc);
+
+		if ((DescriptorSize < sizeof(USB_Descriptor_Header_t)) || (DescriptorSize > BytesRem))
+		  return INDEX_CONFIG_InvalidConfigDescriptor;
+
+		if (DescriptorType == DTYPE_Interface)
+		{
+			if (DescriptorSize < sizeof(USB_Descriptor_Interface_t))
+			  return INDEX_CONFIG_InvalidConfigDescriptor;
+
+			/* The next window overlaps the last indexed interface, unless that interface is the only one in the window
+			 * and had more endpoints than could be indexed */
+			if (ErrorCode == INDEX_CONFIG_IndexFull)
+			{
+				Index->NextWindow = CurrConfigLoc;
+				return INDEX_CONFIG_IndexFull;
+			}
+			else if (Index->TotalInterfaces == USB_MAX_INDEXED_INTERFACES)
+			{
+				Index->NextWindow = Index->Interfaces[Index->TotalInterfaces - 1].InterfaceDescriptor;
+				return INDEX_CONFIG_IndexFull;
+			}
+
+			CurrInterface = &Index->Interfaces[Index->TotalInterfaces++];
+
+			CurrInterface->InterfaceDescriptor = CurrConfigLoc;
+			CurrInterface->SubDescriptors      = (CurrConfigLoc + DescriptorSize);
+			CurrInterface->SubDescriptorsSize  = 0;
+			CurrInterface->FirstEndpoint       = Index->TotalEndpoints;
+			CurrInterface->TotalEndpoints      = 0;
+		}
+		else if ((DescriptorType == DTYPE_InterfaceAssociation) || (DescriptorType == DTYPE_Configuration))
+		{
+			CurrInterface = NULL;
+		}
+		else if (CurrInterface != NULL)
+		{
+			if (DescriptorType == DTYPE_Endpoint)
+			{
+				if (DescriptorSize < sizeof(USB_Descriptor_Endpoint_t))
+				  return INDEX_CONFIG_InvalidConfigDescriptor;
+
+				if (Index->TotalEndpoints == USB_MAX_INDEXED_ENDPOINTS)
+				{
+					/* Drop a partially indexed interface so that it is indexed in full by the next window, unless it is
+					 * the only interface in the window and so will never fit, in which case its remaining endpoints are
+					 * skipped and the next window begins at the following interface */
+					if (Index->TotalInterfaces > 1)
+					{
+						Index->TotalEndpoints = CurrInterface->FirstEndpoint;
+						Index->TotalInterfaces--;
+						Index->NextWindow     = (Index->TotalInterfaces > 1) ?
+						                        Index->Interfaces[Index->TotalInterfaces - 1].InterfaceDescriptor :
+						                        CurrInterface->InterfaceDescriptor;
+
+						return INDEX_CONFIG_IndexFull;
+					}
+
+					ErrorCode = INDEX_CONFIG_IndexFull;
+				}
+				else
+				{
+					Index->Endpoints[Index->TotalEndpoints++] = CurrConfigLoc;
+					CurrInterface->TotalEndpoints++;
+				}
+			}
+
+			CurrInterface->SubDescriptorsSize += DescriptorSize;
+		}
+
+		CurrConfigLoc += DescriptorSize;
+		BytesRem      -= DescriptorSize;
+	}
+
+	return ErrorCode;
+}
+
+uint8_t USB_GetIndexedInterface(const USB_ConfigIndex_t* const Index,
+                                uint8_t StartInterface,
+                                const uint8_t Class,
+                                const uint8_t SubClass,
+                                const uint8_t Protocol,
+                                const uint8_t MatchMask)
+{
+	for (; StartInterface < Index->TotalInterfaces; StartInterface++)
+	{
+		USB_Descriptor_Interface_t* CurrInterface = Index->Interfaces[StartInterface].InterfaceDescriptor;
+
+		if ((MatchMask & INDEX_MATCH_CLASS) && (CurrInterface->Class != Class))
+		  continue;
+
+		if ((MatchMask & INDEX_MATCH_SUBCLASS) && (CurrInterface->SubClass != SubClass))
+		  continue;
+
+		if ((MatchMask & INDEX_MATCH_PROTOCOL) && (CurrInterface->Protocol != Protocol))
+		  continue;
+
+		return StartInterface;
+	}
+
+	return INDEX_NO_INTERFACE;
+}
+
+USB_Descriptor_Endpoint_t* USB_GetIndexedEndpoint(const USB_ConfigIndex_t* const Index,
+                                                  const uint8_t InterfaceIndex,
+                                                  const uint8_t Type,
+                                                  const uint8_t Direction)
+{
+	const USB_IndexedInterface_t* CurrInterface = &Index->Interfaces[InterfaceIndex];
+	uint8_t                       LastEndpoint  = (CurrInterface->FirstEndpoint + CurrInterface->TotalEndpoints);
+
+	for (uint8_t EndpointIndex = CurrInterface->FirstEndpoint; EndpointIndex < LastEndpoint; EndpointIndex++)
+	{
+		USB_Descriptor_Endpoint_t* CurrEndpoint = Index->Endpoints[EndpointIndex];
+
+		if (((CurrEndpoint->Attributes & EP_TYPE_MASK) == Type) &&
+		    ((CurrEndpoint->EndpointAddress & ENDPOINT_DESCRIPTOR_DIR_IN) == Direction) &&
+		    !(Pipe_IsEndpointBound(CurrEndpoint->EndpointAddress)))
+		{
+			return CurrEndpoint;
+		}
+	}
+
+	return NULL;
+}
+
+void* USB_GetIndexedDescriptor(const USB_ConfigIndex_t* const Index,
+                               const uint8_t InterfaceIndex,
+                               const uint8_t Type)
+{
+	const USB_IndexedInterface_t* CurrInterface = &Index->Interfaces[InterfaceIndex];
+	void*                         CurrConfigLoc = CurrInterface->SubDescriptors;
+	uint16_t                      BytesRem      = CurrInterface->SubDescriptorsSize;
+
+	while (BytesRem)
+	{
+		if (DESCRIPTOR_TYPE(CurrConfigLoc) == Type)
+		  return CurrConfigLoc;
+
+		USB_GetNextDescriptor(&BytesRem, &CurrConfigLoc);
+	}
+
+	return NULL;
+}
 #endif
 
 void USB_GetNextDescriptorOfType(uint16_t* const BytesRem,
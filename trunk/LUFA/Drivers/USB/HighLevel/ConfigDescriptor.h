@@ -59,10 +59,31 @@
 			extern "C" {
 		#endif
 
-	/* Preprocessor Checks: */
+	/* Preprocessor Checks and Defines: */
 		#if !defined(__INCLUDE_FROM_USB_DRIVER)
 			#error Do not include this file directly. Include LUFA/Drivers/USB/USB.h instead.
 		#endif
+
+		#if !defined(USB_MAX_INDEXED_INTERFACES) || defined(__DOXYGEN__)
+			/** Maximum number of interfaces (including each alternate setting of an interface) which may be stored in a
+			 *  \ref USB_ConfigIndex_t configuration descriptor index at once. Larger configuration descriptors are indexed
+			 *  a window at a time via \ref USB_IndexNextConfigWindow(). This value may be overridden in the user project
+			 *  makefile by defining the USB_MAX_INDEXED_INTERFACES token to a value between 2 and 254.
+			 */
+			#define USB_MAX_INDEXED_INTERFACES         8
+		#endif
+
+		#if !defined(USB_MAX_INDEXED_ENDPOINTS) || defined(__DOXYGEN__)
+			/** Maximum number of endpoints which may be stored in a \ref USB_ConfigIndex_t configuration descriptor index,
+			 *  across all indexed interfaces. This value may be overridden in the user project makefile by defining the
+			 *  USB_MAX_INDEXED_ENDPOINTS token to a value no larger than 255.
+			 */
+			#define USB_MAX_INDEXED_ENDPOINTS          16
+		#endif
+
+		#if (USB_MAX_INDEXED_INTERFACES < 2) || (USB_MAX_INDEXED_INTERFACES > 254) || (USB_MAX_INDEXED_ENDPOINTS > 255)
+			#error USB_MAX_INDEXED_INTERFACES must be between 2 and 254, and USB_MAX_INDEXED_ENDPOINTS no larger than 255.
+		#endif
 		
 	/* Public Interface - May be used in end-application: */	
 		/* Macros: */
@@ -108,6 +129,23 @@
 			/** Returns the descriptor's size, expressed as the 8-bit value indicating the number of bytes. */
 			#define DESCRIPTOR_SIZE(DescriptorPtr)    DESCRIPTOR_CAST(DescriptorPtr, USB_Descriptor_Header_t).Size
 
+			/** Mask for \ref USB_GetIndexedInterface(), indicating that an interface's class must match. */
+			#define INDEX_MATCH_CLASS                  (1 << 0)
+
+			/** Mask for \ref USB_GetIndexedInterface(), indicating that an interface's subclass must match. */
+			#define INDEX_MATCH_SUBCLASS               (1 << 1)
+
+			/** Mask for \ref USB_GetIndexedInterface(), indicating that an interface's protocol must match. */
+			#define INDEX_MATCH_PROTOCOL               (1 << 2)
+
+			/** Mask for \ref USB_GetIndexedInterface(), indicating that an interface's class, subclass and protocol
+			 *  must all match.
+			 */
+			#define INDEX_MATCH_ALL                    (INDEX_MATCH_CLASS | INDEX_MATCH_SUBCLASS | INDEX_MATCH_PROTOCOL)
+
+			/** Value returned by \ref USB_GetIndexedInterface() when no matching interface could be found. */
+			#define INDEX_NO_INTERFACE                 0xFF
+
 		/* Type Defines: */
 			/** Type define for a Configuration Descriptor comparator function (function taking a pointer to an array
 			 *  of type void, returning a uint8_t value).
@@ -116,6 +154,51 @@
 			 */
 			typedef uint8_t (* const ConfigComparatorPtr_t)(void*);
 
+			/** Type define for a single interface entry of a \ref USB_ConfigIndex_t configuration descriptor index. Each
+			 *  alternate setting of an interface is stored as a separate entry.
+			 */
+			typedef struct
+			{
+				USB_Descriptor_Interface_t* InterfaceDescriptor; /**< Pointer to the interface's descriptor inside the
+				                                                  *   configuration descriptor.
+				                                                  */
+				void*    SubDescriptors; /**< Pointer to the first descriptor following the interface descriptor, such as a
+				                          *   class-specific descriptor or the interface's first endpoint descriptor.
+				                          */
+				uint16_t SubDescriptorsSize; /**< Total size in bytes of all the descriptors belonging to the interface,
+				                              *   up to the next interface or interface association descriptor.
+				                              */
+				uint8_t  FirstEndpoint; /**< Index of the interface's first endpoint within the Endpoints table of the
+				                         *   \ref USB_ConfigIndex_t structure.
+				                         */
+				uint8_t  TotalEndpoints; /**< Number of the interface's endpoints stored in the Endpoints table. */
+			} USB_IndexedInterface_t;
+
+			/** Type define for a configuration descriptor index, built by \ref USB_IndexConfigDescriptor() in a single
+			 *  pass over an attached device's configuration descriptor. Once built, the index allows the host class
+			 *  drivers to locate their interfaces, class-specific descriptors and endpoints by table lookup, and may
+			 *  be shared between several class driver instances binding to the one device.
+			 *
+			 *  \note The index holds pointers into the indexed configuration descriptor, which must therefore remain
+			 *        valid for as long as the index is in use.
+			 */
+			typedef struct
+			{
+				uint8_t                    TotalInterfaces; /**< Number of interfaces stored in the index. */
+				uint8_t                    TotalEndpoints; /**< Number of endpoints stored in the index. */
+				void*                      NextWindow; /**< Pointer to the interface descriptor at which the next window of
+				                                        *   the configuration descriptor begins if the index filled before
+				                                        *   the end of the descriptor, for \ref USB_IndexNextConfigWindow(),
+				                                        *   or NULL if the end of the descriptor was reached.
+				                                        */
+				USB_IndexedInterface_t     Interfaces[USB_MAX_INDEXED_INTERFACES]; /**< Indexed interfaces, in the order they
+				                                                                     *   appear in the configuration descriptor.
+				                                                                     */
+				USB_Descriptor_Endpoint_t* Endpoints[USB_MAX_INDEXED_ENDPOINTS]; /**< Indexed endpoint descriptors, grouped by
+				                                                                   *   interface.
+				                                                                   */
+			} USB_ConfigIndex_t;
+
 		/* Function Prototypes: */
 			/** Searches for the next descriptor in the given configuration descriptor using a premade comparator
 			 *  function. The routine updates the position and remaining configuration descriptor bytes values
@@ -194,6 +277,18 @@
 				DESCRIPTOR_SEARCH_COMP_Fail            = 1, /**< Comparator function returned Descriptor_Search_Fail. */
 				DESCRIPTOR_SEARCH_COMP_EndOfDescriptor = 2, /**< End of configuration descriptor reached before match found. */
 			};
+
+			/** Enum for return values of \ref USB_IndexConfigDescriptor(). */
+			enum USB_IndexConfigDescriptor_ErrorCodes_t
+			{
+				INDEX_CONFIG_Successful                = 0, /**< Configuration descriptor indexed successfully. */
+				INDEX_CONFIG_InvalidConfigDescriptor   = 1, /**< The given data is not a valid configuration descriptor. */
+				INDEX_CONFIG_IndexFull                 = 2, /**< The configuration descriptor contains more interfaces or
+				                                             *   endpoints than the index can hold; the interfaces which
+				                                             *   could be stored in full remain valid, and the remainder
+				                                             *   may be indexed via \ref USB_IndexNextConfigWindow().
+				                                             */
+			};
 	
 		/* Function Prototypes: */
 			/** Retrieves the configuration descriptor data from an attached device via a standard request into a buffer,
@@ -253,6 +348,122 @@
 			                                      const uint8_t AfterType)
 			                                      ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
+			/** Builds an index of the interfaces, alternate settings, class-specific descriptors and endpoints of the given
+			 *  configuration descriptor, in a single pass. The resulting index may then be passed to the *_Host_ConfigurePipesIndexed()
+			 *  functions of each host class driver which is to bind to the attached device, so that the configuration descriptor
+			 *  need only be walked once regardless of the number of interfaces and class drivers in use.
+			 *
+			 *  If the configuration descriptor holds more interfaces or endpoints than the index can store, indexing stops
+			 *  at the last interface which could be stored in full and \ref INDEX_CONFIG_IndexFull is returned. Should a
+			 *  class driver then fail to find its interface, the remaining interfaces may be indexed in turn via
+			 *  \ref USB_IndexNextConfigWindow(), as the *_Host_ConfigurePipes() functions of each class driver do.
+			 *
+			 *  \note This function is available in USB Host mode only.
+			 *
+			 *  \param[out] Index  Pointer to the index structure to build
+			 *  \param[in] ConfigDescriptorSize  Length of the configuration descriptor
+			 *  \param[in] ConfigDescriptorData  Pointer to a buffer containing the configuration descriptor
+			 *
+			 *  \return A value from the \ref USB_IndexConfigDescriptor_ErrorCodes_t enum
+			 *
+			 *  Usage Example:
+			 *  \code
+			 *  USB_ConfigIndex_t ConfigIndex;
+			 *
+			 *  // After retrieving configuration descriptor:
+			 *  if (USB_IndexConfigDescriptor(&ConfigIndex, ConfigDescriptorSize, ConfigDescriptorData) != INDEX_CONFIG_InvalidConfigDescriptor)
+			 *  {
+			 *      CDC_Host_ConfigurePipesIndexed(&VirtualSerial_CDC_Interface, &ConfigIndex);
+			 *      MS_Host_ConfigurePipesIndexed(&FlashDisk_MS_Interface, &ConfigIndex);
+			 *  }
+			 *  \endcode
+			 */
+			uint8_t USB_IndexConfigDescriptor(USB_ConfigIndex_t* const Index,
+			                                  uint16_t ConfigDescriptorSize,
+			                                  void* ConfigDescriptorData)
+			                                  ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Rebuilds a truncated configuration descriptor index (see \ref USB_ConfigIndex_t) over the next window of
+			 *  interfaces in the configuration descriptor. Where possible the new window begins with the last interface of
+			 *  the current window, so that class drivers using a pair of adjacent interfaces may still bind when the pair
+			 *  straddles the two windows.
+			 *
+			 *  \note This function is available in USB Host mode only.
+			 *
+			 *  \param[in,out] Index  Pointer to an index built by \ref USB_IndexConfigDescriptor() or a previous call to
+			 *                        this function
+			 *  \param[in] ConfigDescriptorSize  Length of the configuration descriptor the index was built from
+			 *  \param[in] ConfigDescriptorData  Pointer to the configuration descriptor the index was built from
+			 *
+			 *  \return Boolean true if the next window was indexed, false if the index already reached the end of the
+			 *          configuration descriptor
+			 *
+			 *  Usage Example:
+			 *  \code
+			 *  // After indexing the configuration descriptor:
+			 *  while ((MS_Host_ConfigurePipesIndexed(&FlashDisk_MS_Interface, &ConfigIndex) != MS_ENUMERROR_NoError) &&
+			 *         USB_IndexNextConfigWindow(&ConfigIndex, ConfigDescriptorSize, ConfigDescriptorData));
+			 *  \endcode
+			 */
+			bool USB_IndexNextConfigWindow(USB_ConfigIndex_t* const Index,
+			                               uint16_t ConfigDescriptorSize,
+			                               void* ConfigDescriptorData)
+			                               ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Searches a configuration descriptor index for the next interface with the given class, subclass and protocol
+			 *  values, starting from the given interface entry.
+			 *
+			 *  \note This function is available in USB Host mode only.
+			 *
+			 *  \param[in] Index  Pointer to an index built by \ref USB_IndexConfigDescriptor()
+			 *  \param[in] StartInterface  Index of the first interface entry to consider
+			 *  \param[in] Class  Interface class value to match
+			 *  \param[in] SubClass  Interface subclass value to match
+			 *  \param[in] Protocol  Interface protocol value to match
+			 *  \param[in] MatchMask  Mask of INDEX_MATCH_* masks, indicating which of the given values must match
+			 *
+			 *  \return Index of the matching interface entry, or \ref INDEX_NO_INTERFACE if no match was found
+			 */
+			uint8_t USB_GetIndexedInterface(const USB_ConfigIndex_t* const Index,
+			                                uint8_t StartInterface,
+			                                const uint8_t Class,
+			                                const uint8_t SubClass,
+			                                const uint8_t Protocol,
+			                                const uint8_t MatchMask) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Retrieves the first endpoint of the given indexed interface with the given type and direction which is not
+			 *  already bound to a configured pipe.
+			 *
+			 *  \note This function is available in USB Host mode only.
+			 *
+			 *  \param[in] Index  Pointer to an index built by \ref USB_IndexConfigDescriptor()
+			 *  \param[in] InterfaceIndex  Index of the interface entry whose endpoints are to be searched
+			 *  \param[in] Type  Type of the endpoint to find, an EP_TYPE_* mask
+			 *  \param[in] Direction  Direction of the endpoint to find, either \ref ENDPOINT_DESCRIPTOR_DIR_IN or
+			 *                        \ref ENDPOINT_DESCRIPTOR_DIR_OUT
+			 *
+			 *  \return Pointer to the endpoint's descriptor if found, NULL otherwise
+			 */
+			USB_Descriptor_Endpoint_t* USB_GetIndexedEndpoint(const USB_ConfigIndex_t* const Index,
+			                                                  const uint8_t InterfaceIndex,
+			                                                  const uint8_t Type,
+			                                                  const uint8_t Direction) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Retrieves the first descriptor of the given type belonging to the given indexed interface, such as a
+			 *  class-specific descriptor following the interface descriptor.
+			 *
+			 *  \note This function is available in USB Host mode only.
+			 *
+			 *  \param[in] Index  Pointer to an index built by \ref USB_IndexConfigDescriptor()
+			 *  \param[in] InterfaceIndex  Index of the interface entry whose descriptors are to be searched
+			 *  \param[in] Type  Descriptor type value to search for
+			 *
+			 *  \return Pointer to the descriptor if found, NULL otherwise
+			 */
+			void* USB_GetIndexedDescriptor(const USB_ConfigIndex_t* const Index,
+			                               const uint8_t InterfaceIndex,
+			                               const uint8_t Type) ATTR_NON_NULL_PTR_ARG(1);
+
 		/* Inline Functions: */
 			/** Skips over the current sub-descriptor inside the configuration descriptor, so that the pointer then
 			    points to the next sub-descriptor. The bytes remaining value is automatically decremented.
@@ -271,6 +482,16 @@
 				*CurrConfigLoc += CurrDescriptorSize;
 				*BytesRem      -= CurrDescriptorSize;
 			}
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Function Prototypes: */
+			#if defined(USB_CAN_BE_HOST) && defined(__INCLUDE_FROM_CONFIGDESCRIPTOR_C)
+				static uint8_t USB_IndexDescriptors(USB_ConfigIndex_t* const Index,
+				                                    uint16_t BytesRem,
+				                                    void* CurrConfigLoc) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+			#endif
+	#endif
 			
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
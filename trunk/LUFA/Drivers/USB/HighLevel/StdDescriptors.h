@@ -93,6 +93,20 @@
 			 *  Should be used in string descriptor's headers for giving the string descriptor's byte length.
 			 */
 			#define USB_STRING_LEN(str)               (sizeof(USB_Descriptor_Header_t) + ((str) << 1))
+
+			/** Macro to create a complete string descriptor initializer from a given Unicode string literal, with the
+			 *  descriptor's header length computed at compile time from the length of the string. This removes the need
+			 *  to manually count the string's characters for the \ref USB_STRING_LEN() macro, for example:
+			 *
+			 *  \code
+			 *  USB_Descriptor_String_t PROGMEM ProductString = USB_STRING_DESCRIPTOR(L"LUFA Demo");
+			 *  \endcode
+			 *
+			 *  \param[in] String  Unicode string literal (prefixed with the "L" character) to place in the descriptor.
+			 */
+			#define USB_STRING_DESCRIPTOR(String)     { .Header = {.Size = USB_STRING_LEN((sizeof(String) / sizeof(String[0])) - 1), \
+			                                                       .Type = DTYPE_String},                                          \
+			                                            .UnicodeString = String }
 			
 			/** Macro to encode a given four digit floating point version number (e.g. 01.23) into Binary Coded
 			 *  Decimal format for descriptor fields requiring BCD encoding, such as the USB version number in the
@@ -0,0 +1,77 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+ 
+ 
+/** \ingroup Group_USB
+ *  @defgroup Group_StreamSegments Endpoint and Pipe Stream Segments
+ *
+ *  Types and enums for the scatter-gather stream write routines \ref Endpoint_Write_StreamV() and
+ *  \ref Pipe_Write_StreamV(). Each stream segment describes a contiguous block of data located in RAM,
+ *  FLASH or EEPROM; an array of segments is written to the endpoint or pipe as a single contiguous stream,
+ *  so that headers and payloads stored in separate buffers are packed into the minimum number of packets.
+ *
+ *  @{
+ */
+ 
+#ifndef __STREAMSEGMENTS_H__
+#define __STREAMSEGMENTS_H__
+
+	/* Includes: */
+		#include <stdint.h>
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_USB_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/USB/USB.h instead.
+		#endif
+		
+	/* Public Interface - May be used in end-application: */
+		/* Enums: */
+			/** Enum for the possible memory spaces a stream segment's data may be located in. */
+			enum StreamSegment_MemorySpaces_t
+			{
+				STREAMSEGMENT_RAM    = 0, /**< Segment data is located in SRAM. */
+				STREAMSEGMENT_FLASH  = 1, /**< Segment data is located in FLASH memory, within the first 64KB. */
+				STREAMSEGMENT_EEPROM = 2, /**< Segment data is located in EEPROM memory. */
+			};
+
+		/* Type Defines: */
+			/** Type define for a single stream segment, for use with the scatter-gather stream write routines. */
+			typedef struct
+			{
+				const void* Buffer; /**< Pointer to the start of the segment data. */
+				uint16_t    Length; /**< Length of the segment data, in bytes. */
+				uint8_t     MemorySpace; /**< Memory space the segment data is located in, a value from the
+				                          *   \ref StreamSegment_MemorySpaces_t enum.
+				                          */
+			} USB_StreamSegment_t;
+		
+#endif
+
+/** @} */
@@ -75,11 +75,15 @@ ISR(USB_GEN_vect, ISR_BLOCK)
 
 		if (USB_VBUS_GetStatus())
 		{
+			USB_TRACE_EVENT(USB_TRACE_EVENT_Connect, 0);
+
 			USB_DeviceState = DEVICE_STATE_Powered;
 			EVENT_USB_Device_Connect();
 		}
 		else
 		{
+			USB_TRACE_EVENT(USB_TRACE_EVENT_Disconnect, 0);
+
 			USB_DeviceState = DEVICE_STATE_Unattached;		
 			EVENT_USB_Device_Disconnect();
 		}
@@ -90,6 +94,8 @@ ISR(USB_GEN_vect, ISR_BLOCK)
 	{
 		USB_INT_Clear(USB_INT_SUSPEND);
 
+		USB_TRACE_EVENT(USB_TRACE_EVENT_Suspend, 0);
+
 		USB_INT_Disable(USB_INT_SUSPEND);
 		USB_INT_Enable(USB_INT_WAKEUP);
 		
@@ -119,6 +125,8 @@ ISR(USB_GEN_vect, ISR_BLOCK)
 
 		USB_INT_Clear(USB_INT_WAKEUP);
 
+		USB_TRACE_EVENT(USB_TRACE_EVENT_WakeUp, 0);
+
 		USB_INT_Disable(USB_INT_WAKEUP);
 		USB_INT_Enable(USB_INT_SUSPEND);
 		
@@ -135,6 +143,8 @@ ISR(USB_GEN_vect, ISR_BLOCK)
 	{
 		USB_INT_Clear(USB_INT_EORSTI);
 
+		USB_TRACE_EVENT(USB_TRACE_EVENT_Reset, 0);
+
 		USB_DeviceState         = DEVICE_STATE_Default;
 		USB_ConfigurationNumber = 0;
 
@@ -158,6 +168,8 @@ ISR(USB_GEN_vect, ISR_BLOCK)
 	if (USB_INT_HasOccurred(USB_INT_SOFI) && USB_INT_IsEnabled(USB_INT_SOFI))
 	{
 		USB_INT_Clear(USB_INT_SOFI);
+
+		USB_TRACE_EVENT(USB_TRACE_EVENT_StartOfFrame, UDFNUML);
 		
 		EVENT_USB_Device_StartOfFrame();
 	}
@@ -230,15 +242,33 @@ ISR(USB_GEN_vect, ISR_BLOCK)
 	#endif
 }
 
-#if defined(INTERRUPT_CONTROL_ENDPOINT) && defined(USB_CAN_BE_DEVICE)
+#if ((defined(INTERRUPT_CONTROL_ENDPOINT) || defined(ASYNC_STREAM_TRANSFERS)) && defined(USB_CAN_BE_DEVICE)) || \
+    defined(IDLE_STREAM_WAITS)
 ISR(USB_COM_vect, ISR_BLOCK)
 {
+	#if defined(IDLE_STREAM_WAITS) && defined(USB_CAN_BE_HOST)
+	Pipe_DisarmReadyWake();
+	#endif
+
+	#if defined(USB_CAN_BE_DEVICE)
+	#if defined(IDLE_STREAM_WAITS) && !defined(CONTROL_ONLY_DEVICE)
+	Endpoint_DisarmReadyWake();
+	#endif
+
 	uint8_t PrevSelectedEndpoint = Endpoint_GetCurrentEndpoint();
 
+	#if defined(ASYNC_STREAM_TRANSFERS) && !defined(CONTROL_ONLY_DEVICE)
+	Endpoint_ProcessAsyncStreams();
+	Endpoint_SelectEndpoint(PrevSelectedEndpoint);
+	#endif
+
+	#if defined(INTERRUPT_CONTROL_ENDPOINT)
 	USB_USBTask();
 
 	USB_INT_Clear(USB_INT_RXSTPI);
+	#endif
 	
 	Endpoint_SelectEndpoint(PrevSelectedEndpoint);
+	#endif
 }
 #endif
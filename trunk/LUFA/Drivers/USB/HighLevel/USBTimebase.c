@@ -0,0 +1,66 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#define  __INCLUDE_FROM_USBTIMEBASE_C
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "USBTimebase.h"
+
+#if defined(TIMER_STREAM_TIMEOUTS)
+
+volatile uint16_t USB_Timebase_Milliseconds;
+
+void USB_Timebase_Init(void)
+{
+	uint8_t CurrentGlobalInt = SREG;
+	cli();
+
+	TCCR1A  = 0;
+	TCCR1B  = ((1 << CS11) | (1 << CS10));
+	OCR1A   = (TCNT1 + USB_TIMEBASE_TICKS_PER_MS);
+	TIMSK1 |= (1 << OCIE1A);
+
+	SREG = CurrentGlobalInt;
+}
+
+ISR(TIMER1_COMPA_vect, ISR_BLOCK)
+{
+	uint16_t NextCompare = (OCR1A + USB_TIMEBASE_TICKS_PER_MS);
+
+	/* If interrupts were disabled for longer than a millisecond the next compare value may already have been
+	 * passed, in which case the timer would not match it again until it has wrapped - resynchronise instead */
+	if ((int16_t)(TCNT1 - NextCompare) >= 0)
+	  NextCompare = (TCNT1 + USB_TIMEBASE_TICKS_PER_MS);
+
+	OCR1A = NextCompare;
+
+	USB_Timebase_Milliseconds++;
+}
+
+#endif
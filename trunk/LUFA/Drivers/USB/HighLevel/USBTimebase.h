@@ -0,0 +1,148 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \ingroup Group_USB
+ *  @defgroup Group_USBTimebase Millisecond Timebase
+ *
+ *  Optional shared millisecond timebase service. When the TIMER_STREAM_TIMEOUTS token is defined in the project makefile (and
+ *  the LUFA/Drivers/USB/HighLevel/USBTimebase.c source file is added to the project), the library starts the 16-bit Timer 1
+ *  free-running with a prescaler of 64 when the USB interface is initialized, and uses its OCR1A compare interrupt to advance
+ *  a millisecond counter. The endpoint and pipe stream functions then measure their USB_STREAM_TIMEOUT_MS timeouts against
+ *  this counter, rather than by counting Start of Frame flags in a busy loop - the latter never time out when the SOF flag is
+ *  consumed elsewhere, such as by an \ref EVENT_USB_Device_StartOfFrame() handler, and do not advance at all in host mode
+ *  while the bus is suspended. The application may use the same counter for its own timing via
+ *  \ref USB_Timebase_GetMilliseconds() and \ref USB_Timebase_HasElapsed().
+ *
+ *  When the IDLE_STREAM_WAITS token is also defined, the stream functions place the AVR into idle sleep while they wait for
+ *  an endpoint or pipe to become ready, woken by the endpoint or pipe's interrupt, the millisecond compare interrupt or any
+ *  other enabled interrupt. This frees the CPU of the busy wait, reducing power consumption and allowing interrupt driven
+ *  tasks to run with less latency jitter.
+ *
+ *  \note Timer 1 and its OCR1A compare channel must not be reconfigured by the application while the timebase is in use. The
+ *        timer is left free-running, so its TCNT1 counter may also be read as a timestamp; the \ref Group_USBTrace module
+ *        uses the same timer configuration for its event timestamps, and may be used alongside the timebase.
+ *
+ *  \note Global interrupts must be enabled for the millisecond counter to advance.
+ *
+ *  @{
+ */
+
+#ifndef __USBTIMEBASE_H__
+#define __USBTIMEBASE_H__
+
+	/* Includes: */
+		#include <avr/io.h>
+		#include <avr/interrupt.h>
+		#include <stdint.h>
+		#include <stdbool.h>
+
+		#include "../../../Common/Common.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks and Defines: */
+		#if !defined(__INCLUDE_FROM_USB_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/USB/USB.h instead.
+		#endif
+
+		#if defined(IDLE_STREAM_WAITS) && !defined(TIMER_STREAM_TIMEOUTS)
+			#error IDLE_STREAM_WAITS requires the TIMER_STREAM_TIMEOUTS token to also be defined.
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Number of Timer 1 ticks in each millisecond of the timebase, with the timer running from the system
+			 *  clock divided by 64.
+			 */
+			#define USB_TIMEBASE_TICKS_PER_MS        (F_CPU / 64000UL)
+
+		#if defined(TIMER_STREAM_TIMEOUTS) || defined(__DOXYGEN__)
+		/* Global Variables: */
+			/** Number of milliseconds elapsed since the timebase was started, wrapping at 65535. This should be read
+			 *  via \ref USB_Timebase_GetMilliseconds() so that the read is atomic.
+			 *
+			 *  \note This variable should be treated as read-only in the user application, and never manually
+			 *        changed in value.
+			 */
+			extern volatile uint16_t USB_Timebase_Milliseconds;
+
+		/* Inline Functions: */
+			/** Retrieves the current value of the millisecond counter.
+			 *
+			 *  \return Number of milliseconds elapsed since the timebase was started, wrapping at 65535
+			 */
+			static inline uint16_t USB_Timebase_GetMilliseconds(void) ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline uint16_t USB_Timebase_GetMilliseconds(void)
+			{
+				uint8_t  CurrentGlobalInt = SREG;
+				cli();
+
+				uint16_t Milliseconds = USB_Timebase_Milliseconds;
+
+				SREG = CurrentGlobalInt;
+
+				return Milliseconds;
+			}
+
+			/** Determines if the given period has elapsed since the given starting millisecond counter value. Periods
+			 *  of up to 65534 milliseconds are correctly measured across a wrap of the counter.
+			 *
+			 *  \param[in] StartTime  Millisecond counter value at the start of the period, from \ref USB_Timebase_GetMilliseconds()
+			 *  \param[in] PeriodMS   Length of the period, in milliseconds
+			 *
+			 *  \return Boolean true if the period has elapsed, false otherwise
+			 */
+			static inline bool USB_Timebase_HasElapsed(const uint16_t StartTime, const uint16_t PeriodMS)
+			                                           ATTR_WARN_UNUSED_RESULT ATTR_ALWAYS_INLINE;
+			static inline bool USB_Timebase_HasElapsed(const uint16_t StartTime, const uint16_t PeriodMS)
+			{
+				return ((uint16_t)(USB_Timebase_GetMilliseconds() - StartTime) > PeriodMS);
+			}
+		#endif
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Function Prototypes: */
+			#if defined(TIMER_STREAM_TIMEOUTS)
+				void USB_Timebase_Init(void);
+			#endif
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
@@ -0,0 +1,159 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#define  __INCLUDE_FROM_USBTRACE_C
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "USBTrace.h"
+
+#if defined(ENABLE_USB_TRACE)
+
+#include "../LowLevel/LowLevel.h"
+
+static USB_TraceEvent_t USB_Trace_Buffer[USB_TRACE_BUFFER_SIZE];
+static uint8_t          USB_Trace_Head;
+static uint8_t          USB_Trace_Count;
+static uint16_t         USB_Trace_LostEvents;
+
+void USB_Trace_Init(void)
+{
+	uint8_t CurrentGlobalInt = SREG;
+	cli();
+
+	USB_Trace_Head       = 0;
+	USB_Trace_Count      = 0;
+	USB_Trace_LostEvents = 0;
+
+	SREG = CurrentGlobalInt;
+
+	#if defined(USB_TRACE_USE_TIMER1)
+	TCCR1B = ((1 << CS11) | (1 << CS10));
+	#endif
+}
+
+void USB_Trace_Record(const uint8_t Event, const uint8_t Data)
+{
+	uint8_t CurrentGlobalInt = SREG;
+	cli();
+
+	USB_TraceEvent_t* NewEvent = &USB_Trace_Buffer[USB_Trace_Head];
+
+	NewEvent->Timestamp = USB_TRACE_TIMESTAMP();
+	NewEvent->Event     = Event;
+	NewEvent->Data      = Data;
+
+	USB_Trace_Head = ((USB_Trace_Head + 1) & (USB_TRACE_BUFFER_SIZE - 1));
+
+	if (USB_Trace_Count == USB_TRACE_BUFFER_SIZE)
+	{
+		if (USB_Trace_LostEvents != 0xFFFF)
+		  USB_Trace_LostEvents++;
+	}
+	else
+	{
+		USB_Trace_Count++;
+	}
+
+	SREG = CurrentGlobalInt;
+}
+
+uint8_t USB_Trace_ReadEvents(USB_TraceEvent_t* Buffer, const uint8_t MaxEvents)
+{
+	uint8_t EventsRead = 0;
+
+	while (EventsRead < MaxEvents)
+	{
+		uint8_t CurrentGlobalInt = SREG;
+		cli();
+
+		if (!(USB_Trace_Count))
+		{
+			SREG = CurrentGlobalInt;
+			break;
+		}
+
+		*(Buffer++) = USB_Trace_Buffer[(USB_Trace_Head - USB_Trace_Count) & (USB_TRACE_BUFFER_SIZE - 1)];
+		USB_Trace_Count--;
+
+		SREG = CurrentGlobalInt;
+
+		EventsRead++;
+	}
+
+	return EventsRead;
+}
+
+uint16_t USB_Trace_GetAndClearLostEvents(void)
+{
+	uint8_t CurrentGlobalInt = SREG;
+	cli();
+
+	uint16_t LostEvents = USB_Trace_LostEvents;
+	USB_Trace_LostEvents = 0;
+
+	SREG = CurrentGlobalInt;
+
+	return LostEvents;
+}
+
+#if defined(USB_CAN_BE_DEVICE)
+void USB_Trace_ProcessControlRequest(void)
+{
+	struct
+	{
+		USB_TraceReport_Header_t Header;
+		USB_TraceEvent_t         Events[USB_TRACE_MAX_EVENTS_PER_REQUEST];
+	} TraceReport;
+
+	uint16_t MaxEvents = 0;
+
+	if (USB_ControlRequest.wLength > sizeof(TraceReport.Header))
+	  MaxEvents = ((USB_ControlRequest.wLength - sizeof(TraceReport.Header)) / sizeof(USB_TraceEvent_t));
+
+	if (MaxEvents > USB_TRACE_MAX_EVENTS_PER_REQUEST)
+	  MaxEvents = USB_TRACE_MAX_EVENTS_PER_REQUEST;
+
+	Endpoint_ClearSETUP();
+
+	TraceReport.Header.EventCount = USB_Trace_ReadEvents(TraceReport.Events, MaxEvents);
+	TraceReport.Header.Reserved   = 0;
+	TraceReport.Header.LostEvents = USB_Trace_GetAndClearLostEvents();
+	TraceReport.Header.TicksPerMs = USB_TRACE_TICKS_PER_MS;
+
+	uint16_t ReportLength = (sizeof(TraceReport.Header) + (TraceReport.Header.EventCount * sizeof(USB_TraceEvent_t)));
+
+	if (ReportLength > USB_ControlRequest.wLength)
+	  ReportLength = USB_ControlRequest.wLength;
+
+	Endpoint_Write_Control_Stream_LE(&TraceReport, ReportLength);
+	Endpoint_ClearOUT();
+}
+#endif
+
+#endif
@@ -0,0 +1,203 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \ingroup Group_USB
+ *  @defgroup Group_USBTrace USB Event Tracing
+ *
+ *  Optional USB device event trace facility. When the ENABLE_USB_TRACE token is defined in the project makefile (and
+ *  the LUFA/Drivers/USB/HighLevel/USBTrace.c source file is added to the project), the library records a small
+ *  timestamped event into a RAM ring buffer each time a bus event such as a reset, suspension or wake up occurs,
+ *  each Start of Frame while Start of Frame events are enabled via \ref USB_Device_EnableSOFEvents(), each time a
+ *  control request is received, completed or stalled, and each time an endpoint stream transfer completes or times
+ *  out. When the token is not defined the trace points compile away to nothing.
+ *
+ *  Recorded events may be retrieved by the host via a vendor specific control request (see the
+ *  USB_TRACE_VENDOR_REQUEST compile time token), or by the application via \ref USB_Trace_ReadEvents() for
+ *  transmission over a spare endpoint or other interface. A Linux host application which retrieves the trace
+ *  and produces latency histograms from it is located in the Projects/USBTraceHostApp/ folder of the LUFA distribution.
+ *
+ *  By default, event timestamps are taken from the 16-bit Timer 1 counter, which the library starts with a
+ *  prescaler of 64 when the USB interface is initialized; the timer must not be reconfigured by the application
+ *  while tracing is in use. An alternative timestamp source may be supplied by defining the USB_TRACE_TIMESTAMP()
+ *  and USB_TRACE_TICKS_PER_MS tokens, in which case Timer 1 is left untouched.
+ *
+ *  \note Events are recorded from interrupt context; the ring buffer is updated with the global interrupt
+ *        enable flag cleared for a handful of cycles so that recording and draining may be performed from
+ *        any context without further locking.
+ *
+ *  @{
+ */
+
+#ifndef __USBTRACE_H__
+#define __USBTRACE_H__
+
+	/* Includes: */
+		#include <avr/io.h>
+		#include <avr/interrupt.h>
+		#include <stdint.h>
+
+		#include "../../../Common/Common.h"
+		#include "USBMode.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks and Defines: */
+		#if !defined(__INCLUDE_FROM_USB_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/USB/USB.h instead.
+		#endif
+
+		#if !defined(USB_TRACE_BUFFER_SIZE)
+			#define USB_TRACE_BUFFER_SIZE        32
+		#endif
+
+		#if ((USB_TRACE_BUFFER_SIZE & (USB_TRACE_BUFFER_SIZE - 1)) || (USB_TRACE_BUFFER_SIZE > 128))
+			#error USB_TRACE_BUFFER_SIZE must be a power of two no larger than 128.
+		#endif
+
+		#if !defined(USB_TRACE_VENDOR_REQUEST)
+			#define USB_TRACE_VENDOR_REQUEST     0x7E
+		#endif
+
+		#if !defined(USB_TRACE_TIMESTAMP)
+			#define USB_TRACE_TIMESTAMP()        TCNT1
+			#define USB_TRACE_TICKS_PER_MS       (F_CPU / 64000UL)
+			#define USB_TRACE_USE_TIMER1
+		#elif !defined(USB_TRACE_TICKS_PER_MS)
+			#error USB_TRACE_TICKS_PER_MS must be defined when a custom USB_TRACE_TIMESTAMP() source is used.
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Maximum number of events returned to the host in response to a single trace readout vendor
+			 *  control request.
+			 */
+			#define USB_TRACE_MAX_EVENTS_PER_REQUEST 15
+
+			/** Records a new event into the trace buffer if tracing is enabled via the ENABLE_USB_TRACE token,
+			 *  otherwise expands to nothing.
+			 *
+			 *  \param[in] Event  Event type, a value from the \ref USB_TraceEvents_t enum.
+			 *  \param[in] Data   Event specific data byte.
+			 */
+			#if defined(ENABLE_USB_TRACE) || defined(__DOXYGEN__)
+				#define USB_TRACE_EVENT(Event, Data)     USB_Trace_Record(Event, Data)
+			#else
+				#define USB_TRACE_EVENT(Event, Data)     MACROS{ }MACROE
+			#endif
+
+		/* Enums: */
+			/** Enum for the possible event types which may be recorded into the trace buffer. */
+			enum USB_TraceEvents_t
+			{
+				USB_TRACE_EVENT_Connect          = 0, /**< VBUS applied to the device. */
+				USB_TRACE_EVENT_Disconnect       = 1, /**< VBUS removed from the device. */
+				USB_TRACE_EVENT_Suspend          = 2, /**< Bus suspended by the host. */
+				USB_TRACE_EVENT_WakeUp           = 3, /**< Bus activity resumed after a suspension. */
+				USB_TRACE_EVENT_Reset            = 4, /**< End of a bus reset issued by the host. */
+				USB_TRACE_EVENT_StartOfFrame     = 5, /**< Start of Frame; event data is the low byte of the frame number. */
+				USB_TRACE_EVENT_Setup            = 6, /**< Control request received; event data is the request's bRequest. */
+				USB_TRACE_EVENT_ControlComplete  = 7, /**< Control request processing completed; event data is the bRequest. */
+				USB_TRACE_EVENT_Stall            = 8, /**< Unhandled control request stalled; event data is the bRequest. */
+				USB_TRACE_EVENT_StreamTimeout    = 9, /**< Endpoint ready wait timed out; event data is the endpoint number. */
+				USB_TRACE_EVENT_StreamComplete   = 10, /**< Endpoint stream transfer completed; event data is the endpoint number. */
+			};
+
+		/* Type Defines: */
+			/** Type define for a single recorded trace event. */
+			typedef struct
+			{
+				uint16_t Timestamp; /**< Timestamp of the event, in \c USB_TRACE_TICKS_PER_MS units per millisecond. */
+				uint8_t  Event; /**< Event type, a value from the \ref USB_TraceEvents_t enum. */
+				uint8_t  Data; /**< Event specific data byte. */
+			} USB_TraceEvent_t;
+
+			/** Type define for the header returned before the event records in response to the trace readout
+			 *  vendor control request.
+			 */
+			typedef struct
+			{
+				uint8_t  EventCount; /**< Number of \ref USB_TraceEvent_t records following the header. */
+				uint8_t  Reserved; /**< Reserved for future use, always zero. */
+				uint16_t LostEvents; /**< Number of events overwritten before they could be read, saturating at 0xFFFF. */
+				uint16_t TicksPerMs; /**< Number of timestamp ticks per millisecond. */
+			} USB_TraceReport_Header_t;
+
+		/* Function Prototypes: */
+		#if defined(ENABLE_USB_TRACE) || defined(__DOXYGEN__)
+			/** Records an event into the trace buffer. If the buffer is full, the oldest event is discarded and the
+			 *  lost event counter incremented. This is normally called via the \ref USB_TRACE_EVENT() macro so that
+			 *  it compiles away when tracing is disabled.
+			 *
+			 *  \param[in] Event  Event type, a value from the \ref USB_TraceEvents_t enum.
+			 *  \param[in] Data   Event specific data byte.
+			 */
+			void USB_Trace_Record(const uint8_t Event, const uint8_t Data);
+
+			/** Removes up to the given number of the oldest events from the trace buffer, copying them into the
+			 *  given buffer.
+			 *
+			 *  \param[out] Buffer     Buffer to store the read events into.
+			 *  \param[in]  MaxEvents  Maximum number of events to read.
+			 *
+			 *  \return Number of events copied into the buffer.
+			 */
+			uint8_t USB_Trace_ReadEvents(USB_TraceEvent_t* Buffer, const uint8_t MaxEvents);
+
+			/** Retrieves and clears the count of events which were discarded from the trace buffer due to it
+			 *  overflowing before they could be read.
+			 *
+			 *  \return Number of events lost since the last call, saturating at 0xFFFF.
+			 */
+			uint16_t USB_Trace_GetAndClearLostEvents(void);
+		#endif
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Function Prototypes: */
+			#if defined(ENABLE_USB_TRACE)
+				void USB_Trace_Init(void);
+
+				#if defined(USB_CAN_BE_DEVICE)
+				void USB_Trace_ProcessControlRequest(void);
+				#endif
+			#endif
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
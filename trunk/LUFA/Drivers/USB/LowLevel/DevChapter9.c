@@ -46,6 +46,14 @@ bool    USB_CurrentlySelfPowered;
 bool    USB_RemoteWakeupEnabled;
 #endif
 
+#if !defined(NO_INTERNAL_SERIAL) && (defined(USB_SERIES_6_AVR) || defined(USB_SERIES_7_AVR))
+static struct
+{
+	USB_Descriptor_Header_t Header;
+	int16_t                 UnicodeString[20];
+} USB_Device_InternalSerialDescriptor;
+#endif
+
 void USB_Device_ProcessControlRequest(void)
 {
 	bool     RequestHandled = false;
@@ -53,6 +61,8 @@ void USB_Device_ProcessControlRequest(void)
 	
 	for (uint8_t RequestHeaderByte = 0; RequestHeaderByte < sizeof(USB_Request_Header_t); RequestHeaderByte++)
 	  *(RequestHeader++) = Endpoint_Read_Byte();
+
+	USB_TRACE_EVENT(USB_TRACE_EVENT_Setup, USB_ControlRequest.bRequest);
 	  
 	uint8_t bmRequestType = USB_ControlRequest.bmRequestType;
 	
@@ -110,6 +120,16 @@ void USB_Device_ProcessControlRequest(void)
 			}
 
 			break;
+		#if defined(ENABLE_USB_TRACE)
+		case USB_TRACE_VENDOR_REQUEST:
+			if (bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_VENDOR | REQREC_DEVICE))
+			{
+				USB_Trace_ProcessControlRequest();
+				RequestHandled = true;
+			}
+
+			break;
+		#endif
 	}
 
 	if (!(RequestHandled))
@@ -117,9 +137,15 @@ void USB_Device_ProcessControlRequest(void)
 	  
 	if (Endpoint_IsSETUPReceived())
 	{
+		USB_TRACE_EVENT(USB_TRACE_EVENT_Stall, USB_ControlRequest.bRequest);
+
 		Endpoint_StallTransaction();
 		Endpoint_ClearSETUP();		
 	}
+	else
+	{
+		USB_TRACE_EVENT(USB_TRACE_EVENT_ControlComplete, USB_ControlRequest.bRequest);
+	}
 }
 
 static void USB_Device_SetAddress(void)
@@ -215,23 +241,14 @@ void USB_Device_GetConfiguration(void)
 }
 
 #if !defined(NO_INTERNAL_SERIAL) && (defined(USB_SERIES_6_AVR) || defined(USB_SERIES_7_AVR))
-static char USB_Device_NibbleToASCII(uint8_t Nibble)
+static inline char USB_Device_NibbleToASCII(uint8_t Nibble)
 {
 	Nibble = ((Nibble & 0x0F) + '0');
 	return (Nibble > '9') ? (Nibble + ('A' - '9' - 1)) : Nibble;
 }
 
-static void USB_Device_GetInternalSerialDescriptor(void)
+void USB_Device_BuildInternalSerialDescriptor(void)
 {
-	struct
-	{
-		USB_Descriptor_Header_t Header;
-		int16_t                 UnicodeString[20];
-	} SignatureDescriptor;
-
-	SignatureDescriptor.Header.Type = DTYPE_String;
-	SignatureDescriptor.Header.Size = sizeof(SignatureDescriptor);
-	
 	uint8_t SigReadAddress = 0x0E;
 
 	for (uint8_t SerialCharNum = 0; SerialCharNum < 20; SerialCharNum++)
@@ -244,12 +261,24 @@ static void USB_Device_GetInternalSerialDescriptor(void)
 			SigReadAddress++;
 		}
 		
-		SignatureDescriptor.UnicodeString[SerialCharNum] = USB_Device_NibbleToASCII(SerialByte);
+		USB_Device_InternalSerialDescriptor.UnicodeString[SerialCharNum] = USB_Device_NibbleToASCII(SerialByte);
 	}
-	
+
+	/* Header is filled in last, as a non-zero size indicates that the cached descriptor is complete */
+	USB_Device_InternalSerialDescriptor.Header.Type = DTYPE_String;
+	USB_Device_InternalSerialDescriptor.Header.Size = sizeof(USB_Device_InternalSerialDescriptor);
+}
+
+static void USB_Device_GetInternalSerialDescriptor(void)
+{
+	#if !defined(BUILD_INTERNAL_SERIAL_AT_INIT)
+	if (!(USB_Device_InternalSerialDescriptor.Header.Size))
+	  USB_Device_BuildInternalSerialDescriptor();
+	#endif
+
 	Endpoint_ClearSETUP();
 
-	Endpoint_Write_Control_Stream_LE(&SignatureDescriptor, sizeof(SignatureDescriptor));
+	Endpoint_Write_Control_Stream_LE(&USB_Device_InternalSerialDescriptor, sizeof(USB_Device_InternalSerialDescriptor));
 
 	Endpoint_ClearOUT();
 }
@@ -302,6 +331,51 @@ static void USB_Device_GetDescriptor(void)
 	Endpoint_ClearOUT();
 }
 
+#if defined(USE_DESCRIPTOR_TABLE)
+uint16_t CALLBACK_USB_GetDescriptor(const uint16_t wValue, const uint8_t wIndex, void** const DescriptorAddress
+#if !defined(USE_FLASH_DESCRIPTORS) && !defined(USE_EEPROM_DESCRIPTORS) && !defined(USE_RAM_DESCRIPTORS)
+                                    , uint8_t* MemoryAddressSpace
+#endif
+                                    )
+{
+	const USB_Descriptor_TableEntry_t* Entry = USB_DescriptorTable;
+	uint16_t EntryValue;
+	
+	#if !defined(USE_FLASH_DESCRIPTORS) && !defined(USE_EEPROM_DESCRIPTORS) && !defined(USE_RAM_DESCRIPTORS)
+	*MemoryAddressSpace = MEMSPACE_FLASH;
+	#endif
+
+	while ((EntryValue = pgm_read_word(&Entry->wValue)))
+	{
+		uint8_t EntryIndex = pgm_read_byte(&Entry->wIndex);
+		
+		if ((EntryValue == wValue) && ((EntryIndex == DESCRIPTOR_TABLE_ANY_INDEX) || (EntryIndex == wIndex)))
+		{
+			USB_Descriptor_TableEntry_t MatchedEntry;
+			
+			memcpy_P(&MatchedEntry, Entry, sizeof(USB_Descriptor_TableEntry_t));
+			*DescriptorAddress = (void*)MatchedEntry.Address;
+
+			if (MatchedEntry.Size)
+			  return MatchedEntry.Size;
+
+			/* Variable length descriptors such as strings carry their size in the descriptor header */
+			#if defined(USE_RAM_DESCRIPTORS)
+			return ((const USB_Descriptor_Header_t*)MatchedEntry.Address)->Size;
+			#elif defined(USE_EEPROM_DESCRIPTORS)
+			return eeprom_read_byte(&((const USB_Descriptor_Header_t*)MatchedEntry.Address)->Size);
+			#else
+			return pgm_read_byte(&((const USB_Descriptor_Header_t*)MatchedEntry.Address)->Size);
+			#endif
+		}
+		
+		Entry++;
+	}
+
+	return NO_DESCRIPTOR;
+}
+#endif
+
 static void USB_Device_GetStatus(void)
 {
 	uint8_t CurrentStatus = 0;
@@ -58,6 +58,61 @@
 			#if defined(USE_SINGLE_DEVICE_CONFIGURATION)
 				#define FIXED_NUM_CONFIGURATIONS           1
 			#endif
+
+			#if defined(USE_DESCRIPTOR_TABLE) || defined(__DOXYGEN__)
+				/** Wildcard interface index for the entries of a \ref USB_DescriptorTable, indicating that the entry
+				 *  matches the descriptor request regardless of the request's wIndex value.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				#define DESCRIPTOR_TABLE_ANY_INDEX                    0xFF
+
+				/** Creates a \ref USB_DescriptorTable entry for a fixed length descriptor, such as a device or
+				 *  configuration descriptor. The descriptor's size is computed at compile time from its type.
+				 *
+				 *  \ingroup Group_Device
+				 *
+				 *  \param[in] Type        Descriptor type, a value from the \ref USB_DescriptorTypes_t enum or a class-specific type.
+				 *  \param[in] Index       Index of the descriptor within the given type.
+				 *  \param[in] Descriptor  Descriptor variable (not a pointer) to return for this entry.
+				 */
+				#define DESCRIPTOR_TABLE_ENTRY(Type, Index, Descriptor)                                          \
+				          { .wValue = (((Type) << 8) | (Index)), .wIndex = DESCRIPTOR_TABLE_ANY_INDEX,           \
+				            .Address = &(Descriptor), .Size = sizeof(Descriptor) }
+
+				/** Creates a \ref USB_DescriptorTable entry for a fixed length descriptor that is requested via an
+				 *  interface, such as a HID class or HID report descriptor. The entry only matches requests made to
+				 *  the given interface number.
+				 *
+				 *  \ingroup Group_Device
+				 *
+				 *  \param[in] Type        Descriptor type, a value from the \ref USB_DescriptorTypes_t enum or a class-specific type.
+				 *  \param[in] Interface   Interface number the descriptor belongs to.
+				 *  \param[in] Descriptor  Descriptor variable (not a pointer) to return for this entry.
+				 */
+				#define DESCRIPTOR_TABLE_INTERFACE_ENTRY(Type, Interface, Descriptor)                            \
+				          { .wValue = ((Type) << 8), .wIndex = (Interface),                                      \
+				            .Address = &(Descriptor), .Size = sizeof(Descriptor) }
+
+				/** Creates a \ref USB_DescriptorTable entry for a string descriptor. As string descriptors are of
+				 *  variable length, the size sent to the host is taken from the descriptor's header, which should
+				 *  be computed at compile time via the \ref USB_STRING_DESCRIPTOR() macro.
+				 *
+				 *  \ingroup Group_Device
+				 *
+				 *  \param[in] Index       Index of the string descriptor.
+				 *  \param[in] Descriptor  String descriptor variable (not a pointer) to return for this entry.
+				 */
+				#define DESCRIPTOR_TABLE_STRING(Index, Descriptor)                                               \
+				          { .wValue = ((DTYPE_String << 8) | (Index)), .wIndex = DESCRIPTOR_TABLE_ANY_INDEX,     \
+				            .Address = &(Descriptor), .Size = 0 }
+
+				/** Terminating entry of a \ref USB_DescriptorTable, which must be the last entry in the table.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				#define DESCRIPTOR_TABLE_END                          { .wValue = 0 }
+			#endif
 	
 		/* Enums: */
 			#if !defined(USE_FLASH_DESCRIPTORS) && !defined(USE_EEPROM_DESCRIPTORS) && !defined(USE_RAM_DESCRIPTORS)
@@ -74,6 +129,22 @@
 					MEMSPACE_RAM      = 2, /**< Indicates the requested descriptor is located in RAM memory */
 				};
 			#endif
+
+		/* Type Defines: */
+			#if defined(USE_DESCRIPTOR_TABLE) || defined(__DOXYGEN__)
+				/** Type define for a single entry of the \ref USB_DescriptorTable. Entries should be created via the
+				 *  DESCRIPTOR_TABLE_* macros rather than filled out manually.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				typedef struct
+				{
+					uint16_t    wValue; /**< Descriptor type in the upper byte and index in the lower byte, as requested by the host. */
+					uint8_t     wIndex; /**< Interface number the entry applies to, or \ref DESCRIPTOR_TABLE_ANY_INDEX. */
+					const void* Address; /**< Address of the descriptor in memory. */
+					uint16_t    Size; /**< Size of the descriptor in bytes, or zero to read the size from the descriptor header. */
+				} USB_Descriptor_TableEntry_t;
+			#endif
 	
 		/* Global Variables: */
 			/** Indicates the currently set configuration number of the device. USB devices may have several
@@ -113,6 +184,32 @@
 				 */
 				extern bool USB_CurrentlySelfPowered;
 			#endif
+
+			#if defined(USE_DESCRIPTOR_TABLE) || defined(__DOXYGEN__)
+				/** Table of the device's descriptors, which MUST be defined in FLASH memory via the PROGMEM attribute
+				 *  by the user application when the USE_DESCRIPTOR_TABLE token is defined in the project makefile and
+				 *  passed to the compiler via the -D switch. The library then provides its own implementation of the
+				 *  \ref CALLBACK_USB_GetDescriptor() function, which locates requested descriptors with a single search
+				 *  of this table, for example:
+				 *
+				 *  \code
+				 *  const USB_Descriptor_TableEntry_t PROGMEM USB_DescriptorTable[] =
+				 *  {
+				 *  	DESCRIPTOR_TABLE_ENTRY(DTYPE_Device, 0, DeviceDescriptor),
+				 *  	DESCRIPTOR_TABLE_ENTRY(DTYPE_Configuration, 0, ConfigurationDescriptor),
+				 *  	DESCRIPTOR_TABLE_STRING(0, LanguageString),
+				 *  	DESCRIPTOR_TABLE_STRING(1, ManufacturerString),
+				 *  	DESCRIPTOR_TABLE_END
+				 *  };
+				 *  \endcode
+				 *
+				 *  The descriptors the table points to are located in the memory space given by the USE_*_DESCRIPTORS
+				 *  compile time option, or in FLASH memory if none of these options are used.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				extern const USB_Descriptor_TableEntry_t USB_DescriptorTable[];
+			#endif
 	
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
@@ -128,6 +225,10 @@
 	
 		/* Function Prototypes: */
 			void USB_Device_ProcessControlRequest(void);
+
+			#if !defined(NO_INTERNAL_SERIAL) && (defined(USB_SERIES_6_AVR) || defined(USB_SERIES_7_AVR))
+				void USB_Device_BuildInternalSerialDescriptor(void);
+			#endif
 			
 			#if defined(__INCLUDE_FROM_DEVCHAPTER9_C)
 				static void USB_Device_SetAddress(void);
@@ -138,7 +239,7 @@
 				static void USB_Device_ClearSetFeature(void);
 				
 				#if !defined(NO_INTERNAL_SERIAL) && (defined(USB_SERIES_6_AVR) || defined(USB_SERIES_7_AVR))
-					static char USB_Device_NibbleToASCII(uint8_t Nibble) ATTR_ALWAYS_INLINE;
+					static inline char USB_Device_NibbleToASCII(uint8_t Nibble) ATTR_ALWAYS_INLINE;
 					static void USB_Device_GetInternalSerialDescriptor(void);
 				#endif				
 			#endif
@@ -75,6 +75,12 @@
 			 *  USB interface should be initialized in full speed (12Mb/s) mode.
 			 */
 			#define USB_DEVICE_OPT_FULLSPEED               (0 << 0)
+
+			/** Mask for the frame number returned by \ref USB_Device_GetFrameNumber(). USB frame numbers are 11 bits
+			 *  wide, thus the difference between two frame numbers should be masked with this value to account for
+			 *  the frame number wrapping.
+			 */
+			#define USB_DEVICE_FRAME_NUMBER_MASK           0x07FF
 			
 		/* Pseudo-Function Macros: */
 			#if defined(__DOXYGEN__)
@@ -128,6 +134,13 @@
 				 *  \ref EVENT_USB_Device_StartOfFrame() event when enumerated in device mode.
 				 */
 				static inline bool USB_Device_DisableSOFEvents(void);
+
+				/** Retrieves the number of the last Start of Frame packet received from the host. The frame number
+				 *  is incremented once per millisecond by the host, and wraps at \ref USB_DEVICE_FRAME_NUMBER_MASK.
+				 *
+				 *  \return Current 11-bit USB frame number.
+				 */
+				static inline uint16_t USB_Device_GetFrameNumber(void);
 			#else
 				#if !defined(NO_DEVICE_REMOTE_WAKEUP)
 					#define USB_Device_SendRemoteWakeup()   MACROS{ UDCON |= (1 << RMWKUP); }MACROE
@@ -140,6 +153,8 @@
 				#define USB_Device_EnableSOFEvents()    MACROS{ USB_INT_Enable(USB_INT_SOFI); }MACROE
 
 				#define USB_Device_DisableSOFEvents()   MACROS{ USB_INT_Disable(USB_INT_SOFI); }MACROE
+
+				#define USB_Device_GetFrameNumber()           (UDFNUM & USB_DEVICE_FRAME_NUMBER_MASK)
 			#endif
 			
 		/* Type Defines: */
@@ -195,6 +210,9 @@
 			 *        USE_EEPROM_DESCRIPTORS tokens may be defined in the project makefile and passed to the compiler by the -D
 			 *        switch.
 			 *
+			 *  \note When the USE_DESCRIPTOR_TABLE token is defined, this function is supplied by the library instead, and
+			 *        returns descriptors from the user application's \ref USB_DescriptorTable.
+			 *
 			 *  \return Size in bytes of the descriptor if it exists, zero or \ref NO_DESCRIPTOR otherwise
 			 */
 			uint16_t CALLBACK_USB_GetDescriptor(const uint16_t wValue, const uint8_t wIndex, void** const DescriptorAddress
@@ -36,10 +36,23 @@
 #define  __INCLUDE_FROM_ENDPOINT_C
 #include "Endpoint.h"
 
+#if defined(IDLE_STREAM_WAITS) && !defined(CONTROL_ONLY_DEVICE)
+#include <avr/sleep.h>
+#endif
+
 #if !defined(FIXED_CONTROL_ENDPOINT_SIZE)
 uint8_t USB_ControlEndpointSize = ENDPOINT_CONTROLEP_DEFAULT_SIZE;
 #endif
 
+#if defined(ASYNC_STREAM_TRANSFERS) && !defined(CONTROL_ONLY_DEVICE)
+static Endpoint_AsyncStream_t Endpoint_AsyncStreams[ENDPOINT_TOTAL_ENDPOINTS];
+static volatile uint8_t       Endpoint_AsyncStreamsPending;
+#endif
+
+#if defined(IDLE_STREAM_WAITS) && !defined(CONTROL_ONLY_DEVICE)
+static volatile bool          Endpoint_ReadyWakeArmed;
+#endif
+
 uint8_t Endpoint_BytesToEPSizeMaskDynamic(const uint16_t Size)
 {
 	return Endpoint_BytesToEPSizeMask(Size);
@@ -60,6 +73,17 @@ bool Endpoint_ConfigureEndpoint_Prv(const uint8_t Number, const uint8_t UECFG0XD
 
 void Endpoint_ClearEndpoints(void)
 {
+	#if defined(ASYNC_STREAM_TRANSFERS) && !defined(CONTROL_ONLY_DEVICE)
+	for (uint8_t EPNum = 0; EPNum < ENDPOINT_TOTAL_ENDPOINTS; EPNum++)
+	{
+		if (Endpoint_AsyncStreamsPending & (1 << EPNum))
+		{
+			Endpoint_SelectEndpoint(EPNum);
+			Endpoint_CompleteAsyncStream(EPNum, ENDPOINT_RWSTREAM_DeviceDisconnected);
+		}
+	}
+	#endif
+
 	UEINT = 0;
 
 	for (uint8_t EPNum = 0; EPNum < ENDPOINT_TOTAL_ENDPOINTS; EPNum++)
@@ -99,7 +123,9 @@ void Endpoint_ClearStatusStage(void)
 #if !defined(CONTROL_ONLY_DEVICE)
 uint8_t Endpoint_WaitUntilReady(void)
 {
-	#if (USB_STREAM_TIMEOUT_MS < 0xFF)
+	#if defined(TIMER_STREAM_TIMEOUTS)
+	uint16_t StartTime = USB_Timebase_GetMilliseconds();
+	#elif (USB_STREAM_TIMEOUT_MS < 0xFF)
 	uint8_t  TimeoutMSRem = USB_STREAM_TIMEOUT_MS;	
 	#else
 	uint16_t TimeoutMSRem = USB_STREAM_TIMEOUT_MS;
@@ -123,16 +149,113 @@ uint8_t Endpoint_WaitUntilReady(void)
 		else if (Endpoint_IsStalled())
 		  return ENDPOINT_READYWAIT_EndpointStalled;
 			  
+		#if defined(TIMER_STREAM_TIMEOUTS)
+		if (USB_Timebase_HasElapsed(StartTime, USB_STREAM_TIMEOUT_MS))
+		{
+			USB_TRACE_EVENT(USB_TRACE_EVENT_StreamTimeout, Endpoint_GetCurrentEndpoint());
+			return ENDPOINT_READYWAIT_Timeout;
+		}
+
+		#if defined(IDLE_STREAM_WAITS)
+		Endpoint_SleepUntilReady();
+		#endif
+		#else
 		if (USB_INT_HasOccurred(USB_INT_SOFI))
 		{
 			USB_INT_Clear(USB_INT_SOFI);
 
 			if (!(TimeoutMSRem--))
-			  return ENDPOINT_READYWAIT_Timeout;
+			{
+				USB_TRACE_EVENT(USB_TRACE_EVENT_StreamTimeout, Endpoint_GetCurrentEndpoint());
+				return ENDPOINT_READYWAIT_Timeout;
+			}
 		}
+		#endif
+	}
+}
+
+void Endpoint_FlushCoalesced(Endpoint_CoalesceState_t* const State, const uint8_t MaxFrames)
+{
+	uint16_t BytesInBank = Endpoint_BytesInEndpoint();
+
+	/* Each bank sent restarts the hold period, so that data written afterwards is held for the full period */
+	if (BytesInBank == Endpoint_GetBankSize())
+	{
+		Endpoint_ClearIN();
+
+		State->StartFrame = 0;
+		State->Waiting    = false;
+		State->ZLPPending = true;
+		BytesInBank       = 0;
+	}
+
+	if (!(BytesInBank) && !(State->ZLPPending))
+	{
+		State->StartFrame = 0;
+		State->Waiting    = false;
+		return;
 	}
+
+	if (!(Endpoint_IsReadWriteAllowed()))
+	  return;
+
+	uint16_t CurrentFrame = USB_Device_GetFrameNumber();
+
+	if (!(State->Waiting))
+	{
+		State->StartFrame = CurrentFrame;
+		State->Waiting    = true;
+	}
+
+	if (((CurrentFrame - State->StartFrame) & USB_DEVICE_FRAME_NUMBER_MASK) < MaxFrames)
+	  return;
+
+	Endpoint_ClearIN();
+
+	State->StartFrame = 0;
+	State->Waiting    = false;
+	State->ZLPPending = false;
 }
 
+#if defined(IDLE_STREAM_WAITS)
+static void Endpoint_SleepUntilReady(void)
+{
+	/* The CPU would never be woken if it were put to sleep with global interrupts disabled */
+	if (!(SREG & (1 << SREG_I)))
+	  return;
+
+	cli();
+
+	if (Endpoint_GetEndpointDirection() == ENDPOINT_DIR_IN)
+	  UEIENX |= ((1 << TXINE)  | (1 << STALLEDE));
+	else
+	  UEIENX |= ((1 << RXOUTE) | (1 << STALLEDE));
+
+	Endpoint_ReadyWakeArmed = true;
+
+	/* The instruction following SEI is always executed before any pending interrupt, so an endpoint interrupt
+	 * which became pending after the ready check still wakes the CPU immediately once it has entered sleep */
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	sleep_enable();
+	sei();
+	sleep_cpu();
+	sleep_disable();
+
+	cli();
+	Endpoint_DisarmReadyWake();
+	sei();
+}
+
+void Endpoint_DisarmReadyWake(void)
+{
+	if (!(Endpoint_ReadyWakeArmed))
+	  return;
+
+	UEIENX &= ~((1 << TXINE) | (1 << RXOUTE) | (1 << STALLEDE));
+	Endpoint_ReadyWakeArmed = false;
+}
+#endif
+
 uint8_t Endpoint_Discard_Stream(uint16_t Length
 #if !defined(NO_STREAM_CALLBACKS)
                                 , StreamCallbackPtr_t Callback
@@ -145,45 +268,50 @@ uint8_t Endpoint_Discard_Stream(uint16_t Length
 	  return ErrorCode;
 
 	#if defined(FAST_STREAM_TRANSFERS)
-	uint8_t BytesRemToAlignment = (Endpoint_BytesInEndpoint() & 0x07);
-
-	if (Length >= 8)
+	while (Length)
 	{
-		Length -= BytesRemToAlignment;
+		uint16_t BytesInBank = Endpoint_BytesInEndpoint();
+
+		if (BytesInBank > Length)
+		  BytesInBank = Length;
 
-		switch (BytesRemToAlignment)
+		Length -= BytesInBank;
+
+		if (BytesInBank)
 		{
-			default:
-				do
-				{
-					if (!(Endpoint_IsReadWriteAllowed()))
+			uint8_t BlocksRemaining = ((BytesInBank + 7) >> 3);
+
+			switch ((uint8_t)BytesInBank & 0x07)
+			{
+				default:
+					do
 					{
-						Endpoint_ClearOUT();
-
-						#if !defined(NO_STREAM_CALLBACKS)
-						if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
-						  return ENDPOINT_RWSTREAM_CallbackAborted;
-						#endif
-
-						if ((ErrorCode = Endpoint_WaitUntilReady()))
-						  return ErrorCode;
-					}
-
-					Length -= 8;
-					
-					Endpoint_Discard_Byte();
-			case 7: Endpoint_Discard_Byte();
-			case 6: Endpoint_Discard_Byte();
-			case 5: Endpoint_Discard_Byte();
-			case 4: Endpoint_Discard_Byte();
-			case 3: Endpoint_Discard_Byte();
-			case 2: Endpoint_Discard_Byte();
-			case 1:	Endpoint_Discard_Byte();
-				} while (Length >= 8);	
+						Endpoint_Discard_Byte();
+				case 7: Endpoint_Discard_Byte();
+				case 6: Endpoint_Discard_Byte();
+				case 5: Endpoint_Discard_Byte();
+				case 4: Endpoint_Discard_Byte();
+				case 3: Endpoint_Discard_Byte();
+				case 2: Endpoint_Discard_Byte();
+				case 1:	Endpoint_Discard_Byte();
+					} while (--BlocksRemaining);
+			}
 		}
-	}
-	#endif
 
+		if (Length)
+		{
+			Endpoint_ClearOUT();
+
+			#if !defined(NO_STREAM_CALLBACKS)
+			if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
+			  return ENDPOINT_RWSTREAM_CallbackAborted;
+			#endif
+
+			if ((ErrorCode = Endpoint_WaitUntilReady()))
+			  return ErrorCode;
+		}
+	}
+	#else
 	while (Length)
 	{
 		if (!(Endpoint_IsReadWriteAllowed()))
@@ -204,16 +332,280 @@ uint8_t Endpoint_Discard_Stream(uint16_t Length
 			Length--;
 		}
 	}
+	#endif
 	
 	return ENDPOINT_RWSTREAM_NoError;
 }
 
+uint8_t Endpoint_Write_StreamV(const USB_StreamSegment_t* Segments, uint8_t TotalSegments
+#if !defined(NO_STREAM_CALLBACKS)
+                               , StreamCallbackPtr_t Callback
+#endif
+                               )
+{
+	uint8_t ErrorCode;
+
+	if ((ErrorCode = Endpoint_WaitUntilReady()))
+	  return ErrorCode;
+
+	while (TotalSegments--)
+	{
+		const uint8_t* DataStream  = (const uint8_t*)Segments->Buffer;
+		uint16_t       Length      = Segments->Length;
+		uint8_t        MemorySpace = Segments->MemorySpace;
+
+		Segments++;
+
+		while (Length)
+		{
+			uint16_t BytesInBank = (Endpoint_GetBankSize() - Endpoint_BytesInEndpoint());
+
+			if (!(BytesInBank))
+			{
+				Endpoint_ClearIN();
+
+				#if !defined(NO_STREAM_CALLBACKS)
+				if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
+				  return ENDPOINT_RWSTREAM_CallbackAborted;
+				#endif
+
+				if ((ErrorCode = Endpoint_WaitUntilReady()))
+				  return ErrorCode;
+			}
+			else
+			{
+				if (BytesInBank > Length)
+				  BytesInBank = Length;
+
+				Length -= BytesInBank;
+
+				switch (MemorySpace)
+				{
+					case STREAMSEGMENT_FLASH:
+						while (BytesInBank--)
+						  Endpoint_Write_Byte(pgm_read_byte(DataStream++));
+						break;
+					case STREAMSEGMENT_EEPROM:
+						while (BytesInBank--)
+						  Endpoint_Write_Byte(eeprom_read_byte(DataStream++));
+						break;
+					default:
+						while (BytesInBank--)
+						  Endpoint_Write_Byte(*(DataStream++));
+						break;
+				}
+			}
+		}
+	}
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
+uint8_t Endpoint_Forward_Stream_To_SPI(uint16_t Length
+#if !defined(NO_STREAM_CALLBACKS)
+                                       , StreamCallbackPtr_t Callback
+#endif
+                                       )
+{
+	uint8_t ErrorCode;
+
+	if ((ErrorCode = Endpoint_WaitUntilReady()))
+	  return ErrorCode;
+
+	while (Length)
+	{
+		uint16_t BytesInBank = Endpoint_BytesInEndpoint();
+
+		if (!(BytesInBank))
+		{
+			Endpoint_ClearOUT();
+
+			#if !defined(NO_STREAM_CALLBACKS)
+			if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
+			  return ENDPOINT_RWSTREAM_CallbackAborted;
+			#endif
+
+			if ((ErrorCode = Endpoint_WaitUntilReady()))
+			  return ErrorCode;
+		}
+		else
+		{
+			if (BytesInBank > Length)
+			  BytesInBank = Length;
+
+			Length -= BytesInBank;
+
+			SPDR = Endpoint_Read_Byte();
+
+			/* Fetch each following byte from the endpoint FIFO while the previous one is shifted out */
+			while (--BytesInBank)
+			{
+				uint8_t NextByte = Endpoint_Read_Byte();
+
+				while (!(SPSR & (1 << SPIF)));
+				SPDR = NextByte;
+			}
+
+			while (!(SPSR & (1 << SPIF)));
+		}
+	}
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
+uint8_t Endpoint_Forward_Stream_From_SPI(uint16_t Length
+#if !defined(NO_STREAM_CALLBACKS)
+                                         , StreamCallbackPtr_t Callback
+#endif
+                                         )
+{
+	uint8_t ErrorCode;
+
+	if ((ErrorCode = Endpoint_WaitUntilReady()))
+	  return ErrorCode;
+
+	while (Length)
+	{
+		uint16_t BytesInBank = (Endpoint_GetBankSize() - Endpoint_BytesInEndpoint());
+
+		if (!(BytesInBank))
+		{
+			Endpoint_ClearIN();
+
+			#if !defined(NO_STREAM_CALLBACKS)
+			if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
+			  return ENDPOINT_RWSTREAM_CallbackAborted;
+			#endif
+
+			if ((ErrorCode = Endpoint_WaitUntilReady()))
+			  return ErrorCode;
+		}
+		else
+		{
+			if (BytesInBank > Length)
+			  BytesInBank = Length;
+
+			Length -= BytesInBank;
+
+			SPDR = 0x00;
+
+			/* Clock in each following byte from the SPI bus while the previous one is written to the endpoint FIFO */
+			while (--BytesInBank)
+			{
+				while (!(SPSR & (1 << SPIF)));
+				uint8_t ReceivedByte = SPDR;
+
+				SPDR = 0x00;
+				Endpoint_Write_Byte(ReceivedByte);
+			}
+
+			while (!(SPSR & (1 << SPIF)));
+			Endpoint_Write_Byte(SPDR);
+		}
+	}
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
+uint8_t Endpoint_Forward_Stream_To_USART(uint16_t Length
+#if !defined(NO_STREAM_CALLBACKS)
+                                         , StreamCallbackPtr_t Callback
+#endif
+                                         )
+{
+	uint8_t ErrorCode;
+
+	if ((ErrorCode = Endpoint_WaitUntilReady()))
+	  return ErrorCode;
+
+	while (Length)
+	{
+		uint16_t BytesInBank = Endpoint_BytesInEndpoint();
+
+		if (!(BytesInBank))
+		{
+			Endpoint_ClearOUT();
+
+			#if !defined(NO_STREAM_CALLBACKS)
+			if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
+			  return ENDPOINT_RWSTREAM_CallbackAborted;
+			#endif
+
+			if ((ErrorCode = Endpoint_WaitUntilReady()))
+			  return ErrorCode;
+		}
+		else
+		{
+			if (BytesInBank > Length)
+			  BytesInBank = Length;
+
+			Length -= BytesInBank;
+
+			while (BytesInBank--)
+			{
+				uint8_t NextByte = Endpoint_Read_Byte();
+
+				while (!(UCSR1A & (1 << UDRE1)));
+				UDR1 = NextByte;
+			}
+		}
+	}
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
+uint8_t Endpoint_Forward_Stream_From_USART(uint16_t Length
+#if !defined(NO_STREAM_CALLBACKS)
+                                           , StreamCallbackPtr_t Callback
+#endif
+                                           )
+{
+	uint8_t ErrorCode;
+
+	if ((ErrorCode = Endpoint_WaitUntilReady()))
+	  return ErrorCode;
+
+	while (Length)
+	{
+		uint16_t BytesInBank = (Endpoint_GetBankSize() - Endpoint_BytesInEndpoint());
+
+		if (!(BytesInBank))
+		{
+			Endpoint_ClearIN();
+
+			#if !defined(NO_STREAM_CALLBACKS)
+			if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
+			  return ENDPOINT_RWSTREAM_CallbackAborted;
+			#endif
+
+			if ((ErrorCode = Endpoint_WaitUntilReady()))
+			  return ErrorCode;
+		}
+		else
+		{
+			if (BytesInBank > Length)
+			  BytesInBank = Length;
+
+			Length -= BytesInBank;
+
+			while (BytesInBank--)
+			{
+				while (!(UCSR1A & (1 << RXC1)));
+				Endpoint_Write_Byte(UDR1);
+			}
+		}
+	}
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
 /* The following abuses the C preprocessor in order to copy-past common code with slight alterations,
  * so that the code needs to be written once. It is a crude form of templating to reduce code maintenance. */
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Stream_LE
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_CLEAR_ENDPOINT()                 Endpoint_ClearIN()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Endpoint_GetBankSize() - Endpoint_BytesInEndpoint())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_Byte(*((uint8_t*)BufferPtr++))
 #include "Template/Template_Endpoint_RW.c"
@@ -221,6 +613,7 @@ uint8_t Endpoint_Discard_Stream(uint16_t Length
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_PStream_LE
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_CLEAR_ENDPOINT()                 Endpoint_ClearIN()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Endpoint_GetBankSize() - Endpoint_BytesInEndpoint())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_Byte(pgm_read_byte((uint8_t*)BufferPtr++))
 #include "Template/Template_Endpoint_RW.c"
@@ -228,6 +621,7 @@ uint8_t Endpoint_Discard_Stream(uint16_t Length
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_EStream_LE
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_CLEAR_ENDPOINT()                 Endpoint_ClearIN()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Endpoint_GetBankSize() - Endpoint_BytesInEndpoint())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_Byte(eeprom_read_byte((uint8_t*)BufferPtr++))
 #include "Template/Template_Endpoint_RW.c"
@@ -235,6 +629,7 @@ uint8_t Endpoint_Discard_Stream(uint16_t Length
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Stream_BE
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_CLEAR_ENDPOINT()                 Endpoint_ClearIN()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Endpoint_GetBankSize() - Endpoint_BytesInEndpoint())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_Byte(*((uint8_t*)BufferPtr--))
 #include "Template/Template_Endpoint_RW.c"
@@ -242,6 +637,7 @@ uint8_t Endpoint_Discard_Stream(uint16_t Length
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_EStream_BE
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_CLEAR_ENDPOINT()                 Endpoint_ClearIN()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Endpoint_GetBankSize() - Endpoint_BytesInEndpoint())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_Byte(eeprom_read_byte((uint8_t*)BufferPtr--))
 #include "Template/Template_Endpoint_RW.c"
@@ -249,6 +645,7 @@ uint8_t Endpoint_Discard_Stream(uint16_t Length
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_PStream_BE
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_CLEAR_ENDPOINT()                 Endpoint_ClearIN()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Endpoint_GetBankSize() - Endpoint_BytesInEndpoint())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_Byte(pgm_read_byte((uint8_t*)BufferPtr--))
 #include "Template/Template_Endpoint_RW.c"
@@ -256,6 +653,7 @@ uint8_t Endpoint_Discard_Stream(uint16_t Length
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Read_Stream_LE
 #define  TEMPLATE_BUFFER_TYPE                      void*
 #define  TEMPLATE_CLEAR_ENDPOINT()                 Endpoint_ClearOUT()
+#define  TEMPLATE_BYTES_IN_BANK()                  Endpoint_BytesInEndpoint()
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         *((uint8_t*)BufferPtr++) = Endpoint_Read_Byte()
 #include "Template/Template_Endpoint_RW.c"
@@ -263,6 +661,7 @@ uint8_t Endpoint_Discard_Stream(uint16_t Length
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Read_EStream_LE
 #define  TEMPLATE_BUFFER_TYPE                      void*
 #define  TEMPLATE_CLEAR_ENDPOINT()                 Endpoint_ClearOUT()
+#define  TEMPLATE_BYTES_IN_BANK()                  Endpoint_BytesInEndpoint()
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         eeprom_write_byte((uint8_t*)BufferPtr++, Endpoint_Read_Byte())
 #include "Template/Template_Endpoint_RW.c"
@@ -270,6 +669,7 @@ uint8_t Endpoint_Discard_Stream(uint16_t Length
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Read_Stream_BE
 #define  TEMPLATE_BUFFER_TYPE                      void*
 #define  TEMPLATE_CLEAR_ENDPOINT()                 Endpoint_ClearOUT()
+#define  TEMPLATE_BYTES_IN_BANK()                  Endpoint_BytesInEndpoint()
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         *((uint8_t*)BufferPtr--) = Endpoint_Read_Byte()
 #include "Template/Template_Endpoint_RW.c"
@@ -277,10 +677,140 @@ uint8_t Endpoint_Discard_Stream(uint16_t Length
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Read_EStream_BE
 #define  TEMPLATE_BUFFER_TYPE                      void*
 #define  TEMPLATE_CLEAR_ENDPOINT()                 Endpoint_ClearOUT()
+#define  TEMPLATE_BYTES_IN_BANK()                  Endpoint_BytesInEndpoint()
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         eeprom_write_byte((uint8_t*)BufferPtr--, Endpoint_Read_Byte())
 #include "Template/Template_Endpoint_RW.c"
 
+#if defined(ASYNC_STREAM_TRANSFERS)
+uint8_t Endpoint_Write_Stream_Async(const void* Buffer, uint16_t Length, EndpointAsyncCallbackPtr_t Callback)
+{
+	return Endpoint_StartAsyncStream((uint8_t*)Buffer, Length, Callback);
+}
+
+uint8_t Endpoint_Read_Stream_Async(void* Buffer, uint16_t Length, EndpointAsyncCallbackPtr_t Callback)
+{
+	return Endpoint_StartAsyncStream((uint8_t*)Buffer, Length, Callback);
+}
+
+bool Endpoint_IsAsyncStreamPending(void)
+{
+	return ((Endpoint_AsyncStreamsPending & (1 << Endpoint_GetCurrentEndpoint())) ? true : false);
+}
+
+uint16_t Endpoint_AbortAsyncStream(void)
+{
+	uint8_t  EPNum            = Endpoint_GetCurrentEndpoint();
+	uint8_t  CurrentGlobalInt = SREG;
+	uint16_t BytesRemaining   = 0;
+
+	cli();
+
+	if (Endpoint_AsyncStreamsPending & (1 << EPNum))
+	{
+		UEIENX &= ~((1 << TXINE) | (1 << RXOUTE));
+		Endpoint_AsyncStreamsPending &= ~(1 << EPNum);
+
+		BytesRemaining = Endpoint_AsyncStreams[EPNum].Length;
+	}
+
+	SREG = CurrentGlobalInt;
+	
+	return BytesRemaining;
+}
+
+void Endpoint_ProcessAsyncStreams(void)
+{
+	for (uint8_t EPNum = 0; EPNum < ENDPOINT_TOTAL_ENDPOINTS; EPNum++)
+	{
+		if (!(Endpoint_AsyncStreamsPending & (1 << EPNum)))
+		  continue;
+
+		Endpoint_AsyncStream_t* AsyncStream = &Endpoint_AsyncStreams[EPNum];
+		uint16_t                BytesInBank;
+
+		Endpoint_SelectEndpoint(EPNum);
+
+		if (Endpoint_GetEndpointDirection() == ENDPOINT_DIR_IN)
+		{
+			if (!(Endpoint_IsINReady()))
+			  continue;
+
+			BytesInBank = (Endpoint_GetBankSize() - Endpoint_BytesInEndpoint());
+
+			if (BytesInBank > AsyncStream->Length)
+			  BytesInBank = AsyncStream->Length;
+			
+			AsyncStream->Length -= BytesInBank;
+			
+			while (BytesInBank--)
+			  Endpoint_Write_Byte(*(AsyncStream->Buffer++));
+
+			Endpoint_ClearIN();
+		}
+		else
+		{
+			if (!(Endpoint_IsOUTReceived()))
+			  continue;
+
+			BytesInBank = Endpoint_BytesInEndpoint();
+
+			if (BytesInBank > AsyncStream->Length)
+			  BytesInBank = AsyncStream->Length;
+			
+			AsyncStream->Length -= BytesInBank;
+
+			while (BytesInBank--)
+			  *(AsyncStream->Buffer++) = Endpoint_Read_Byte();
+
+			if (!(Endpoint_BytesInEndpoint()))
+			  Endpoint_ClearOUT();
+		}
+
+		if (!(AsyncStream->Length))
+		  Endpoint_CompleteAsyncStream(EPNum, ENDPOINT_RWSTREAM_NoError);
+	}
+}
+
+static uint8_t Endpoint_StartAsyncStream(uint8_t* Buffer, uint16_t Length, EndpointAsyncCallbackPtr_t Callback)
+{
+	uint8_t EPNum = Endpoint_GetCurrentEndpoint();
+
+	if (USB_DeviceState == DEVICE_STATE_Unattached)
+	  return ENDPOINT_ASYNCSTREAM_DeviceDisconnected;
+
+	if (Endpoint_AsyncStreamsPending & (1 << EPNum))
+	  return ENDPOINT_ASYNCSTREAM_TransferPending;
+
+	Endpoint_AsyncStreams[EPNum].Buffer   = Buffer;
+	Endpoint_AsyncStreams[EPNum].Length   = Length;
+	Endpoint_AsyncStreams[EPNum].Callback = Callback;
+
+	uint8_t CurrentGlobalInt = SREG;
+	cli();
+
+	Endpoint_AsyncStreamsPending |= (1 << EPNum);
+
+	if (Endpoint_GetEndpointDirection() == ENDPOINT_DIR_IN)
+	  UEIENX |= (1 << TXINE);
+	else
+	  UEIENX |= (1 << RXOUTE);
+
+	SREG = CurrentGlobalInt;
+
+	return ENDPOINT_ASYNCSTREAM_NoError;
+}
+
+static void Endpoint_CompleteAsyncStream(const uint8_t EPNum, const uint8_t ErrorCode)
+{
+	UEIENX &= ~((1 << TXINE) | (1 << RXOUTE));
+	Endpoint_AsyncStreamsPending &= ~(1 << EPNum);
+
+	if (Endpoint_AsyncStreams[EPNum].Callback != NULL)
+	  Endpoint_AsyncStreams[EPNum].Callback(EPNum, ErrorCode);
+}
+#endif
+
 #endif
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Control_Stream_LE
@@ -74,6 +74,8 @@
 		#include "../../../Common/Common.h"
 		#include "../HighLevel/USBTask.h"
 
+		#include "../HighLevel/StreamSegments.h"
+
 		#if !defined(NO_STREAM_CALLBACKS) || defined(__DOXYGEN__)
 			#include "../HighLevel/StreamCallbacks.h"
 		#endif
@@ -476,6 +478,50 @@
 				                                            */
 			};
 
+			#if defined(ASYNC_STREAM_TRANSFERS) || defined(__DOXYGEN__)
+				/** Enum for the possible error return codes of the Endpoint_*_Stream_Async functions.
+				 *
+				 *  \ingroup Group_EndpointStreamRW
+				 */
+				enum Endpoint_AsyncStream_ErrorCodes_t
+				{
+					ENDPOINT_ASYNCSTREAM_NoError            = 0, /**< Transfer was queued successfully, no error. */
+					ENDPOINT_ASYNCSTREAM_TransferPending    = 1, /**< A previously queued transfer on the currently selected
+					                                              *   endpoint has not yet completed.
+					                                              */
+					ENDPOINT_ASYNCSTREAM_DeviceDisconnected = 2, /**< Device is not currently connected to a host. */
+				};
+			#endif
+
+		/* Type Defines: */
+			#if defined(ASYNC_STREAM_TRANSFERS) || defined(__DOXYGEN__)
+				/** Type define for an asynchronous stream completion callback function. The callback is executed from
+				 *  within the USB controller's endpoint interrupt with the completed endpoint selected, and is passed
+				 *  the completed endpoint's number and a value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum
+				 *  indicating the outcome of the transfer.
+				 *
+				 *  \ingroup Group_EndpointStreamRW
+				 */
+				typedef void (* EndpointAsyncCallbackPtr_t)(const uint8_t EndpointNumber, const uint8_t ErrorCode);
+			#endif
+
+			#if !defined(CONTROL_ONLY_DEVICE) || defined(__DOXYGEN__)
+				/** Type define for the transmit coalescing state of an IN endpoint, used by \ref Endpoint_FlushCoalesced()
+				 *  to track how long a partially filled bank has been held. An instance of this structure should be kept
+				 *  for each coalesced endpoint, and zeroed when the endpoint is configured.
+				 *
+				 *  \ingroup Group_EndpointRW
+				 */
+				typedef struct
+				{
+					uint16_t StartFrame; /**< Frame number at which the held bank was first seen by \ref Endpoint_FlushCoalesced(). */
+					bool     Waiting; /**< Indicates if a partially filled bank (or pending ZLP) is currently being held. */
+					bool     ZLPPending; /**< Indicates if the last packet sent was a full bank, requiring a Zero Length Packet to
+					                      *   terminate the transfer if no further data is written.
+					                      */
+				} Endpoint_CoalesceState_t;
+			#endif
+
 		/* Inline Functions: */
 			/** Reads one byte from the currently selected endpoint's bank, for OUT direction endpoints.
 			 *
@@ -511,6 +557,7 @@
 				uint8_t Dummy;
 				
 				Dummy = UEDATX;
+				(void)Dummy;
 			}
 			
 			/** Reads two bytes from the currently selected endpoint's bank in little endian format, for OUT
@@ -596,6 +643,7 @@
 				
 				Dummy = UEDATX;
 				Dummy = UEDATX;
+				(void)Dummy;
 			}
 
 			/** Reads four bytes from the currently selected endpoint's bank in little endian format, for OUT
@@ -691,6 +739,7 @@
 				Dummy = UEDATX;
 				Dummy = UEDATX;
 				Dummy = UEDATX;
+				(void)Dummy;
 			}
 
 		/* External Variables: */
@@ -757,6 +806,26 @@
 			 *  \return A value from the \ref Endpoint_WaitUntilReady_ErrorCodes_t enum.
 			 */
 			uint8_t Endpoint_WaitUntilReady(void);
+
+			/** Sends the currently selected IN endpoint's partially filled bank to the host once it has been held for the
+			 *  given number of USB frames, so that several small writes may be coalesced into a single packet. A full
+			 *  bank is sent immediately. When the last packet sent was a full bank and no further data has been written
+			 *  within the given number of frames, a Zero Length Packet is sent to terminate the host's transfer. This
+			 *  function does not block, and should be called periodically (e.g. from a class driver's USB task) after
+			 *  data has been written to the endpoint.
+			 *
+			 *  \note A MaxFrames value of zero sends partially filled banks as soon as possible, giving the lowest latency
+			 *        at the expense of throughput; larger values increase throughput for applications which write
+			 *        small amounts of data often, at the expense of up to MaxFrames milliseconds of additional latency.
+			 *
+			 *  \note This routine should not be called on CONTROL type endpoints.
+			 *
+			 *  \ingroup Group_EndpointRW
+			 *
+			 *  \param[in,out] State      Pointer to the endpoint's coalescing state
+			 *  \param[in]     MaxFrames  Maximum number of frames a partially filled bank may be held before it is sent
+			 */
+			void Endpoint_FlushCoalesced(Endpoint_CoalesceState_t* const State, const uint8_t MaxFrames) ATTR_NON_NULL_PTR_ARG(1);
 			
 			/** Completes the status stage of a control transfer on a CONTROL type endpoint automatically,
 			 *  with respect to the data direction. This is a convenience function which can be used to
@@ -884,6 +953,140 @@
 			 */
 			uint8_t Endpoint_Write_PStream_BE(const void* Buffer, uint16_t Length __CALLBACK_PARAM) ATTR_NON_NULL_PTR_ARG(1);
 
+			/** Writes the given array of stream segments to the endpoint in little endian as a single contiguous stream,
+			 *  sending full packets to the host as needed. Each segment's data may be located in RAM, FLASH or
+			 *  EEPROM, as indicated by the segment's memory space. Segments are packed into the endpoint's banks back
+			 *  to back, so that a packet may contain data from several consecutive segments. As with the other stream
+			 *  write functions, the last packet filled is not automatically sent; the user is responsible for manually
+			 *  sending the last written packet to the host via the \ref Endpoint_ClearIN() macro. Between each USB packet,
+			 *  the given stream callback function is executed repeatedly until the next packet is ready, allowing for
+			 *  early aborts of stream transfers.
+			 *
+			 *	The callback routine should be created according to the information in \ref Group_StreamCallbacks.
+			 *  If the token NO_STREAM_CALLBACKS is passed via the -D option to the compiler, stream callbacks are
+			 *  disabled and this function has the Callback parameter omitted.
+			 *
+			 *  \note This routine should not be used on CONTROL type endpoints.
+			 *
+			 *  \ingroup Group_EndpointStreamRW
+			 *
+			 *  \param[in] Segments       Pointer to an array of \ref USB_StreamSegment_t segments to write.
+			 *  \param[in] TotalSegments  Number of segments in the Segments array.
+			 *  \param[in] Callback       Name of a callback routine to call between successive USB packet transfers, NULL if no callback
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t Endpoint_Write_StreamV(const USB_StreamSegment_t* Segments, uint8_t TotalSegments __CALLBACK_PARAM) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Forwards the given number of bytes from the currently selected OUT endpoint directly to the AVR's
+			 *  hardware SPI interface, without first staging the data in a RAM buffer. Each byte read from the
+			 *  endpoint is fetched from the endpoint FIFO while the previous byte is still being shifted out over
+			 *  the SPI bus, so that the USB and SPI transfers overlap. Fully read packets are discarded as needed;
+			 *  as with the other stream read functions, the last packet is not automatically discarded once the
+			 *  remaining bytes have been forwarded, and must be manually discarded via the \ref Endpoint_ClearOUT()
+			 *  macro. Between each USB packet, the given stream callback function is executed repeatedly until the
+			 *  next packet is ready, allowing for early aborts of stream transfers.
+			 *
+			 *  The SPI interface must be initialized in master mode (see \ref Group_SPI) and the destination SPI
+			 *  device selected before this function is called; bytes clocked back from the SPI device are discarded.
+			 *  The SPI bus is always idle when this function returns.
+			 *
+			 *	The callback routine should be created according to the information in \ref Group_StreamCallbacks.
+			 *  If the token NO_STREAM_CALLBACKS is passed via the -D option to the compiler, stream callbacks are
+			 *  disabled and this function has the Callback parameter omitted.
+			 *
+			 *  \note This routine should not be used on CONTROL type endpoints.
+			 *
+			 *  \ingroup Group_EndpointStreamRW
+			 *
+			 *  \param[in] Length    Number of bytes to forward from the currently selected endpoint to the SPI interface.
+			 *  \param[in] Callback  Name of a callback routine to call between successive USB packet transfers, NULL if no callback
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t Endpoint_Forward_Stream_To_SPI(uint16_t Length __CALLBACK_PARAM);
+
+			/** Forwards the given number of bytes from the AVR's hardware SPI interface directly into the currently
+			 *  selected IN endpoint, without first staging the data in a RAM buffer. The next byte is clocked in
+			 *  from the SPI bus while the previous byte is being written into the endpoint FIFO, so that the USB
+			 *  and SPI transfers overlap. Full packets are sent to the host as needed; as with the other stream
+			 *  write functions, the last packet filled is not automatically sent, and must be manually sent via the
+			 *  \ref Endpoint_ClearIN() macro. Between each USB packet, the given stream callback function is executed
+			 *  repeatedly until the next packet is ready, allowing for early aborts of stream transfers.
+			 *
+			 *  The SPI interface must be initialized in master mode (see \ref Group_SPI) and the source SPI device
+			 *  selected before this function is called; dummy 0x00 bytes are sent to the SPI device to clock in each
+			 *  byte of data. No more than Length bytes are ever clocked in, and the SPI bus is always idle when this
+			 *  function returns.
+			 *
+			 *	The callback routine should be created according to the information in \ref Group_StreamCallbacks.
+			 *  If the token NO_STREAM_CALLBACKS is passed via the -D option to the compiler, stream callbacks are
+			 *  disabled and this function has the Callback parameter omitted.
+			 *
+			 *  \note This routine should not be used on CONTROL type endpoints.
+			 *
+			 *  \ingroup Group_EndpointStreamRW
+			 *
+			 *  \param[in] Length    Number of bytes to forward from the SPI interface to the currently selected endpoint.
+			 *  \param[in] Callback  Name of a callback routine to call between successive USB packet transfers, NULL if no callback
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t Endpoint_Forward_Stream_From_SPI(uint16_t Length __CALLBACK_PARAM);
+
+			/** Forwards the given number of bytes from the currently selected OUT endpoint directly to the AVR's
+			 *  hardware USART (USART1), without first staging the data in a RAM buffer. Each byte is read from the
+			 *  endpoint FIFO while the previous byte is still being transmitted out of the USART's double-buffered
+			 *  data register. Fully read packets are discarded as needed; the last packet is not automatically
+			 *  discarded once the remaining bytes have been forwarded, and must be manually discarded via the
+			 *  \ref Endpoint_ClearOUT() macro. Between each USB packet, the given stream callback function is executed
+			 *  repeatedly until the next packet is ready, allowing for early aborts of stream transfers.
+			 *
+			 *  The USART must be initialized with its transmitter enabled (see \ref Group_Serial) before this function
+			 *  is called. This function blocks until all the bytes have been loaded into the USART, and so may take
+			 *  a significant amount of time to complete at low baud rates.
+			 *
+			 *	The callback routine should be created according to the information in \ref Group_StreamCallbacks.
+			 *  If the token NO_STREAM_CALLBACKS is passed via the -D option to the compiler, stream callbacks are
+			 *  disabled and this function has the Callback parameter omitted.
+			 *
+			 *  \note This routine should not be used on CONTROL type endpoints.
+			 *
+			 *  \ingroup Group_EndpointStreamRW
+			 *
+			 *  \param[in] Length    Number of bytes to forward from the currently selected endpoint to the USART.
+			 *  \param[in] Callback  Name of a callback routine to call between successive USB packet transfers, NULL if no callback
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t Endpoint_Forward_Stream_To_USART(uint16_t Length __CALLBACK_PARAM);
+
+			/** Forwards the given number of bytes received by the AVR's hardware USART (USART1) directly into the
+			 *  currently selected IN endpoint, without first staging the data in a RAM buffer. Full packets are sent
+			 *  to the host as needed; the last packet filled is not automatically sent, and must be manually sent via
+			 *  the \ref Endpoint_ClearIN() macro. Between each USB packet, the given stream callback function is executed
+			 *  repeatedly until the next packet is ready, allowing for early aborts of stream transfers.
+			 *
+			 *  The USART must be initialized with its receiver enabled and the USART receive complete interrupt
+			 *  disabled (see \ref Group_Serial) before this function is called. This function blocks until all the
+			 *  requested bytes have been received by the USART, and so should only be used when the number of bytes
+			 *  the attached device will send is known in advance.
+			 *
+			 *	The callback routine should be created according to the information in \ref Group_StreamCallbacks.
+			 *  If the token NO_STREAM_CALLBACKS is passed via the -D option to the compiler, stream callbacks are
+			 *  disabled and this function has the Callback parameter omitted.
+			 *
+			 *  \note This routine should not be used on CONTROL type endpoints.
+			 *
+			 *  \ingroup Group_EndpointStreamRW
+			 *
+			 *  \param[in] Length    Number of bytes to forward from the USART to the currently selected endpoint.
+			 *  \param[in] Callback  Name of a callback routine to call between successive USB packet transfers, NULL if no callback
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t Endpoint_Forward_Stream_From_USART(uint16_t Length __CALLBACK_PARAM);
+
 			/** Reads the given number of bytes from the endpoint from the given buffer in little endian,
 			 *  discarding fully read packets from the host as needed. The last packet is not automatically
 			 *  discarded once the remaining bytes has been read; the user is responsible for manually
@@ -954,6 +1157,81 @@
 			 */
 			uint8_t Endpoint_Read_EStream_BE(void* Buffer, uint16_t Length __CALLBACK_PARAM) ATTR_NON_NULL_PTR_ARG(1);
 
+			#if defined(ASYNC_STREAM_TRANSFERS) || defined(__DOXYGEN__)
+				/** Queues the given number of bytes to be written to the currently selected endpoint from the given
+				 *  buffer in little endian, and returns immediately. The transfer is then advanced one bank at a time
+				 *  from within the USB controller's endpoint interrupt each time the host reads a packet, allowing the
+				 *  application to continue running while the transfer is in progress. Unlike the blocking stream
+				 *  functions, the last packet is automatically sent once the final byte has been written. Once all
+				 *  bytes have been written the given callback function (if not NULL) is executed.
+				 *
+				 *  The source buffer must remain valid and unmodified until the transfer has completed. Only one
+				 *  asynchronous transfer may be queued per endpoint at any one time, however transfers may be queued
+				 *  on several endpoints simultaneously.
+				 *
+				 *  This function is only available when the ASYNC_STREAM_TRANSFERS token is defined, and requires
+				 *  global interrupts to be enabled.
+				 *
+				 *  \note This routine should not be used on CONTROL type endpoints.
+				 *
+				 *  \ingroup Group_EndpointStreamRW
+				 *
+				 *  \param[in] Buffer    Pointer to the source data buffer to read from.
+				 *  \param[in] Length    Number of bytes to send via the currently selected endpoint.
+				 *  \param[in] Callback  Name of a callback routine to call once the transfer completes, NULL if no callback
+				 *
+				 *  \return A value from the \ref Endpoint_AsyncStream_ErrorCodes_t enum.
+				 */
+				uint8_t Endpoint_Write_Stream_Async(const void* Buffer, uint16_t Length,
+				                                    EndpointAsyncCallbackPtr_t Callback) ATTR_NON_NULL_PTR_ARG(1);
+
+				/** Queues the given number of bytes to be read from the currently selected endpoint into the given
+				 *  buffer in little endian, and returns immediately. The transfer is then advanced one bank at a time
+				 *  from within the USB controller's endpoint interrupt each time the host sends a packet, allowing the
+				 *  application to continue running while the transfer is in progress. Fully read packets are discarded
+				 *  automatically; as with the blocking stream functions, the last packet is not discarded if it still
+				 *  contains unread data once the requested number of bytes have been read. Once all bytes have been read
+				 *  the given callback function (if not NULL) is executed.
+				 *
+				 *  The destination buffer must remain valid until the transfer has completed. Only one asynchronous
+				 *  transfer may be queued per endpoint at any one time, however transfers may be queued on several
+				 *  endpoints simultaneously.
+				 *
+				 *  This function is only available when the ASYNC_STREAM_TRANSFERS token is defined, and requires
+				 *  global interrupts to be enabled.
+				 *
+				 *  \note This routine should not be used on CONTROL type endpoints.
+				 *
+				 *  \ingroup Group_EndpointStreamRW
+				 *
+				 *  \param[out] Buffer   Pointer to the destination data buffer to write to.
+				 *  \param[in] Length    Number of bytes to receive via the currently selected endpoint.
+				 *  \param[in] Callback  Name of a callback routine to call once the transfer completes, NULL if no callback
+				 *
+				 *  \return A value from the \ref Endpoint_AsyncStream_ErrorCodes_t enum.
+				 */
+				uint8_t Endpoint_Read_Stream_Async(void* Buffer, uint16_t Length,
+				                                   EndpointAsyncCallbackPtr_t Callback) ATTR_NON_NULL_PTR_ARG(1);
+
+				/** Determines if an asynchronous stream transfer is currently queued on the currently selected endpoint.
+				 *
+				 *  \ingroup Group_EndpointStreamRW
+				 *
+				 *  \return Boolean true if a transfer queued via \ref Endpoint_Write_Stream_Async() or
+				 *          \ref Endpoint_Read_Stream_Async() has not yet completed, false otherwise.
+				 */
+				bool Endpoint_IsAsyncStreamPending(void) ATTR_WARN_UNUSED_RESULT;
+
+				/** Aborts the asynchronous stream transfer queued on the currently selected endpoint, if any. The
+				 *  transfer's completion callback is not executed.
+				 *
+				 *  \ingroup Group_EndpointStreamRW
+				 *
+				 *  \return Number of bytes of the aborted transfer which were not transferred.
+				 */
+				uint16_t Endpoint_AbortAsyncStream(void);
+			#endif
+
 			/** Writes the given number of bytes to the CONTROL type endpoint from the given buffer in little endian,
 			 *  sending full packets to the host as needed. The host OUT acknowledgement is not automatically cleared
 			 *  in both failure and success states; the user is responsible for manually clearing the setup OUT to
@@ -1165,6 +1443,8 @@
 		/* Macros: */
 			#define Endpoint_AllocateMemory()              MACROS{ UECFG1X |=  (1 << ALLOC); }MACROE
 			#define Endpoint_DeallocateMemory()            MACROS{ UECFG1X &= ~(1 << ALLOC); }MACROE
+
+			#define Endpoint_GetBankSize()                 ((uint16_t)8 << ((UECFG1X & (0x07 << EPSIZE0)) >> EPSIZE0))
 			
 			#define _ENDPOINT_GET_MAXSIZE(n)               _ENDPOINT_GET_MAXSIZE2(ENDPOINT_DETAILS_EP ## n)
 			#define _ENDPOINT_GET_MAXSIZE2(details)        _ENDPOINT_GET_MAXSIZE3(details)
@@ -1198,10 +1478,37 @@
 			                                                 Endpoint_BytesToEPSizeMask(Size) : \
 			                                                 Endpoint_BytesToEPSizeMaskDynamic(Size))))
 													
+		/* Type Defines: */
+			#if defined(ASYNC_STREAM_TRANSFERS)
+				typedef struct
+				{
+					uint8_t*                   Buffer;
+					uint16_t                   Length;
+					EndpointAsyncCallbackPtr_t Callback;
+				} Endpoint_AsyncStream_t;
+			#endif
+
 		/* Function Prototypes: */
 			void    Endpoint_ClearEndpoints(void);
 			uint8_t Endpoint_BytesToEPSizeMaskDynamic(const uint16_t Size);
 			bool    Endpoint_ConfigureEndpoint_Prv(const uint8_t Number, const uint8_t UECFG0XData, const uint8_t UECFG1XData);
+
+			#if defined(ASYNC_STREAM_TRANSFERS)
+				void    Endpoint_ProcessAsyncStreams(void);
+			#endif
+
+			#if defined(IDLE_STREAM_WAITS) && !defined(CONTROL_ONLY_DEVICE)
+				void    Endpoint_DisarmReadyWake(void);
+			#endif
+
+			#if defined(IDLE_STREAM_WAITS) && !defined(CONTROL_ONLY_DEVICE) && defined(__INCLUDE_FROM_ENDPOINT_C)
+				static void Endpoint_SleepUntilReady(void);
+			#endif
+
+			#if defined(ASYNC_STREAM_TRANSFERS) && defined(__INCLUDE_FROM_ENDPOINT_C)
+				static uint8_t Endpoint_StartAsyncStream(uint8_t* Buffer, uint16_t Length, EndpointAsyncCallbackPtr_t Callback);
+				static void    Endpoint_CompleteAsyncStream(const uint8_t EPNum, const uint8_t ErrorCode);
+			#endif
 			
 		/* Inline Functions: */
 			static inline uint8_t Endpoint_BytesToEPSizeMask(const uint16_t Bytes) ATTR_WARN_UNUSED_RESULT ATTR_CONST ATTR_ALWAYS_INLINE;
@@ -91,6 +91,12 @@
 				 */
 				#define HOST_DEVICE_SETTLE_DELAY_MS        1500
 			#endif
+
+			/** Mask for the frame number returned by \ref USB_Host_GetFrameNumber(). USB frame numbers are 11 bits
+			 *  wide, thus the difference between two frame numbers should be masked with this value to account for
+			 *  the frame number wrapping.
+			 */
+			#define USB_HOST_FRAME_NUMBER_MASK             0x07FF
 		
 		/* Pseudo-Function Macros: */
 			#if defined(__DOXYGEN__)
@@ -158,6 +164,22 @@
 				 *  \return Boolean true if no resume request is currently being sent, false otherwise
 				 */
 				static inline bool USB_Host_IsResumeFromWakeupRequestSent(void);
+
+				/** Retrieves the number of the last Start of Frame packet sent to the attached device. The frame number
+				 *  is incremented once per millisecond while the bus is not suspended, and wraps at
+				 *  \ref USB_HOST_FRAME_NUMBER_MASK.
+				 *
+				 *  \return Current 11-bit USB frame number.
+				 */
+				static inline uint16_t USB_Host_GetFrameNumber(void);
+
+				/** Retrieves the USB address of the device which the pipes currently communicate with. This is
+				 *  \ref USB_HOST_DEVICEADDRESS once the attached device has been enumerated, unless another device
+				 *  attached via a hub has since been selected (see \ref Group_USBClassHubHost).
+				 *
+				 *  \return Current device address.
+				 */
+				static inline uint8_t USB_Host_GetDeviceAddress(void);
 			#else
 				#define USB_Host_ResetBus()                MACROS{ UHCON |=  (1 << RESET);          }MACROE
 
@@ -178,6 +200,10 @@
 				#define USB_Host_ResumeFromWakeupRequest() MACROS{ UHCON |=  (1 << RESUME);         }MACROE
 				
 				#define USB_Host_IsResumeFromWakeupRequestSent() ((UHCON &   (1 << RESUME)) ? false : true)
+
+				#define USB_Host_GetFrameNumber()                (UHFNUM & USB_HOST_FRAME_NUMBER_MASK)
+
+				#define USB_Host_GetDeviceAddress()              (UHADDR & 0x7F)
 			#endif
 
 		/* Function Prototypes: */
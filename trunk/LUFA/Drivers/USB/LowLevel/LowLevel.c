@@ -95,6 +95,19 @@ void USB_Init(
 		return;
 	}
 	#endif
+
+	#if defined(USB_CAN_BE_DEVICE) && defined(BUILD_INTERNAL_SERIAL_AT_INIT) && \
+	    !defined(NO_INTERNAL_SERIAL) && (defined(USB_SERIES_6_AVR) || defined(USB_SERIES_7_AVR))
+	USB_Device_BuildInternalSerialDescriptor();
+	#endif
+
+	#if defined(ENABLE_USB_TRACE)
+	USB_Trace_Init();
+	#endif
+
+	#if defined(TIMER_STREAM_TIMEOUTS)
+	USB_Timebase_Init();
+	#endif
 	
 	USB_ResetInterface();
 
@@ -51,6 +51,8 @@
 		#include "../HighLevel/Events.h"
 		#include "../HighLevel/USBTask.h"
 		#include "../HighLevel/USBInterrupt.h"
+		#include "../HighLevel/USBTrace.h"
+		#include "../HighLevel/USBTimebase.h"
 		
 		#if defined(USB_CAN_BE_HOST) || defined(__DOXYGEN__)
 			#include "Host.h"
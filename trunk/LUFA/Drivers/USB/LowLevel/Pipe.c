@@ -36,8 +36,16 @@
 #define  __INCLUDE_FROM_PIPE_C
 #include "Pipe.h"
 
+#if defined(IDLE_STREAM_WAITS)
+#include <avr/sleep.h>
+#endif
+
 uint8_t USB_ControlPipeSize = PIPE_CONTROLPIPE_DEFAULT_SIZE;
 
+#if defined(IDLE_STREAM_WAITS)
+static volatile bool Pipe_ReadyWakeArmed;
+#endif
+
 bool Pipe_ConfigurePipe(const uint8_t Number, const uint8_t Type, const uint8_t Token, const uint8_t EndpointNumber,
 						const uint16_t Size, const uint8_t Banks)
 {
@@ -54,6 +62,52 @@ bool Pipe_ConfigurePipe(const uint8_t Number, const uint8_t Type, const uint8_t
 	return Pipe_IsConfigured();
 }
 
+bool Pipe_SetControlPipeSize(const uint8_t Size)
+{
+	uint8_t PipeConfig1[PIPE_TOTAL_PIPES];
+	bool    IsConfigured;
+
+	/* Reallocating the pipes empties their banks, so refuse while any pipe holds data which has not yet been read by
+	 * the application or sent to the device */
+	for (uint8_t PNum = (PIPE_CONTROLPIPE + 1); PNum < PIPE_TOTAL_PIPES; PNum++)
+	{
+		Pipe_SelectPipe(PNum);
+
+		if ((UPCFG1X & (1 << ALLOC)) && Pipe_HoldsData())
+		{
+			Pipe_SelectPipe(PIPE_CONTROLPIPE);
+			return false;
+		}
+	}
+
+	for (uint8_t PNum = (PIPE_TOTAL_PIPES - 1); PNum != PIPE_CONTROLPIPE; PNum--)
+	{
+		Pipe_SelectPipe(PNum);
+		PipeConfig1[PNum] = UPCFG1X;
+		Pipe_DeallocateMemory();
+	}
+
+	IsConfigured = Pipe_ConfigurePipe(PIPE_CONTROLPIPE, EP_TYPE_CONTROL, PIPE_TOKEN_SETUP, ENDPOINT_CONTROLEP,
+	                                  Size, PIPE_BANK_SINGLE);
+
+	for (uint8_t PNum = (PIPE_CONTROLPIPE + 1); PNum < PIPE_TOTAL_PIPES; PNum++)
+	{
+		if (!(PipeConfig1[PNum] & (1 << ALLOC)))
+		  continue;
+
+		Pipe_SelectPipe(PNum);
+		UPCFG1X = PipeConfig1[PNum];
+
+		if (!(Pipe_IsConfigured()))
+		  IsConfigured = false;
+	}
+
+	Pipe_SelectPipe(PIPE_CONTROLPIPE);
+	USB_ControlPipeSize = Size;
+
+	return IsConfigured;
+}
+
 void Pipe_ClearPipes(void)
 {
 	UPINT = 0;
@@ -74,10 +128,14 @@ void Pipe_ClearPipes(void)
 bool Pipe_IsEndpointBound(const uint8_t EndpointAddress)
 {
 	uint8_t PrevPipeNumber = Pipe_GetCurrentPipe();
+	bool    IsBound        = false;
 
 	for (uint8_t PNum = 0; PNum < PIPE_TOTAL_PIPES; PNum++)
 	{
 		Pipe_SelectPipe(PNum);
+
+		if (!(Pipe_IsConfigured()))
+		  continue;
 		
 		uint8_t PipeToken = Pipe_GetPipeToken();
 		bool    PipeTokenCorrect = true;
@@ -85,17 +143,22 @@ bool Pipe_IsEndpointBound(const uint8_t EndpointAddress)
 		if (PipeToken != PIPE_TOKEN_SETUP)
 		  PipeTokenCorrect = (PipeToken == ((EndpointAddress & PIPE_EPDIR_MASK) ? PIPE_TOKEN_IN : PIPE_TOKEN_OUT));
 		
-		if (Pipe_IsConfigured() && PipeTokenCorrect && (Pipe_BoundEndpointNumber() == (EndpointAddress & PIPE_EPNUM_MASK)))
-		  return true;
+		if (PipeTokenCorrect && (Pipe_BoundEndpointNumber() == (EndpointAddress & PIPE_EPNUM_MASK)))
+		{
+			IsBound = true;
+			break;
+		}
 	}
 	
 	Pipe_SelectPipe(PrevPipeNumber);
-	return false;
+	return IsBound;
 }
 
 uint8_t Pipe_WaitUntilReady(void)
 {
-	#if (USB_STREAM_TIMEOUT_MS < 0xFF)
+	#if defined(TIMER_STREAM_TIMEOUTS)
+	uint16_t StartTime = USB_Timebase_GetMilliseconds();
+	#elif (USB_STREAM_TIMEOUT_MS < 0xFF)
 	uint8_t  TimeoutMSRem = USB_STREAM_TIMEOUT_MS;	
 	#else
 	uint16_t TimeoutMSRem = USB_STREAM_TIMEOUT_MS;
@@ -119,6 +182,14 @@ uint8_t Pipe_WaitUntilReady(void)
 		else if (USB_HostState == HOST_STATE_Unattached)
 		  return PIPE_READYWAIT_DeviceDisconnected;
 			  
+		#if defined(TIMER_STREAM_TIMEOUTS)
+		if (USB_Timebase_HasElapsed(StartTime, USB_STREAM_TIMEOUT_MS))
+		  return PIPE_READYWAIT_Timeout;
+
+		#if defined(IDLE_STREAM_WAITS)
+		Pipe_SleepUntilReady();
+		#endif
+		#else
 		if (USB_INT_HasOccurred(USB_INT_HSOFI))
 		{
 			USB_INT_Clear(USB_INT_HSOFI);
@@ -126,9 +197,49 @@ uint8_t Pipe_WaitUntilReady(void)
 			if (!(TimeoutMSRem--))
 			  return PIPE_READYWAIT_Timeout;
 		}
+		#endif
 	}
 }
 
+#if defined(IDLE_STREAM_WAITS)
+static void Pipe_SleepUntilReady(void)
+{
+	/* The CPU would never be woken if it were put to sleep with global interrupts disabled */
+	if (!(SREG & (1 << SREG_I)))
+	  return;
+
+	cli();
+
+	if (Pipe_GetPipeToken() == PIPE_TOKEN_IN)
+	  UPIENX |= ((1 << RXINE)  | (1 << RXSTALLE));
+	else
+	  UPIENX |= ((1 << TXOUTE) | (1 << RXSTALLE));
+
+	Pipe_ReadyWakeArmed = true;
+
+	/* The instruction following SEI is always executed before any pending interrupt, so a pipe interrupt
+	 * which became pending after the ready check still wakes the CPU immediately once it has entered sleep */
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	sleep_enable();
+	sei();
+	sleep_cpu();
+	sleep_disable();
+
+	cli();
+	Pipe_DisarmReadyWake();
+	sei();
+}
+
+void Pipe_DisarmReadyWake(void)
+{
+	if (!(Pipe_ReadyWakeArmed))
+	  return;
+
+	UPIENX &= ~((1 << RXINE) | (1 << TXOUTE) | (1 << RXSTALLE));
+	Pipe_ReadyWakeArmed = false;
+}
+#endif
+
 uint8_t Pipe_Discard_Stream(uint16_t Length
 #if !defined(NO_STREAM_CALLBACKS)
                                  , StreamCallbackPtr_t Callback
@@ -143,51 +254,56 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 	  return ErrorCode;
 
 	#if defined(FAST_STREAM_TRANSFERS)
-	uint8_t BytesRemToAlignment = (Pipe_BytesInPipe() & 0x07);
-
-	if (Length >= 8)
+	while (Length)
 	{
-		Length -= BytesRemToAlignment;
+		uint16_t BytesInBank = Pipe_BytesInPipe();
+
+		if (BytesInBank > Length)
+		  BytesInBank = Length;
+
+		Length -= BytesInBank;
 
-		switch (BytesRemToAlignment)
+		if (BytesInBank)
 		{
-			default:
-				do
-				{
-					if (!(Pipe_IsReadWriteAllowed()))
+			uint8_t BlocksRemaining = ((BytesInBank + 7) >> 3);
+
+			switch ((uint8_t)BytesInBank & 0x07)
+			{
+				default:
+					do
 					{
-						Pipe_ClearIN();
-							
-						#if !defined(NO_STREAM_CALLBACKS)
-						if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
-						  return PIPE_RWSTREAM_CallbackAborted;
-						#endif
-
-						if ((ErrorCode = Pipe_WaitUntilReady()))
-						  return ErrorCode;
-					}
-
-					Length -= 8;
-					
-					Pipe_Discard_Byte();
-			case 7: Pipe_Discard_Byte();
-			case 6: Pipe_Discard_Byte();
-			case 5: Pipe_Discard_Byte();
-			case 4: Pipe_Discard_Byte();
-			case 3: Pipe_Discard_Byte();
-			case 2: Pipe_Discard_Byte();
-			case 1:	Pipe_Discard_Byte();
-				} while (Length >= 8);	
+						Pipe_Discard_Byte();
+				case 7: Pipe_Discard_Byte();
+				case 6: Pipe_Discard_Byte();
+				case 5: Pipe_Discard_Byte();
+				case 4: Pipe_Discard_Byte();
+				case 3: Pipe_Discard_Byte();
+				case 2: Pipe_Discard_Byte();
+				case 1:	Pipe_Discard_Byte();
+					} while (--BlocksRemaining);
+			}
 		}
-	}
-	#endif
 
+		if (Length)
+		{
+			Pipe_ClearIN();
+
+			#if !defined(NO_STREAM_CALLBACKS)
+			if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
+			  return PIPE_RWSTREAM_CallbackAborted;
+			#endif
+
+			if ((ErrorCode = Pipe_WaitUntilReady()))
+			  return ErrorCode;
+		}
+	}
+	#else
 	while (Length)
 	{
 		if (!(Pipe_IsReadWriteAllowed()))
 		{
 			Pipe_ClearIN();
-				
+
 			#if !defined(NO_STREAM_CALLBACKS)
 			if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
 			  return PIPE_RWSTREAM_CallbackAborted;
@@ -202,6 +318,73 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 			Length--;
 		}
 	}
+	#endif
+
+	return PIPE_RWSTREAM_NoError;
+}
+
+uint8_t Pipe_Write_StreamV(const USB_StreamSegment_t* Segments, uint8_t TotalSegments
+#if !defined(NO_STREAM_CALLBACKS)
+                           , StreamCallbackPtr_t Callback
+#endif
+                           )
+{
+	uint8_t ErrorCode;
+
+	Pipe_SetPipeToken(PIPE_TOKEN_OUT);
+
+	if ((ErrorCode = Pipe_WaitUntilReady()))
+	  return ErrorCode;
+
+	while (TotalSegments--)
+	{
+		const uint8_t* DataStream  = (const uint8_t*)Segments->Buffer;
+		uint16_t       Length      = Segments->Length;
+		uint8_t        MemorySpace = Segments->MemorySpace;
+
+		Segments++;
+
+		while (Length)
+		{
+			uint16_t BytesInBank = (Pipe_GetBankSize() - Pipe_BytesInPipe());
+
+			if (!(BytesInBank))
+			{
+				Pipe_ClearOUT();
+
+				#if !defined(NO_STREAM_CALLBACKS)
+				if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
+				  return PIPE_RWSTREAM_CallbackAborted;
+				#endif
+
+				if ((ErrorCode = Pipe_WaitUntilReady()))
+				  return ErrorCode;
+			}
+			else
+			{
+				if (BytesInBank > Length)
+				  BytesInBank = Length;
+
+				Length -= BytesInBank;
+
+				switch (MemorySpace)
+				{
+					case STREAMSEGMENT_FLASH:
+						while (BytesInBank--)
+						  Pipe_Write_Byte(pgm_read_byte(DataStream++));
+						break;
+					case STREAMSEGMENT_EEPROM:
+						while (BytesInBank--)
+						  Pipe_Write_Byte(eeprom_read_byte(DataStream++));
+						break;
+					default:
+						while (BytesInBank--)
+						  Pipe_Write_Byte(*(DataStream++));
+						break;
+				}
+			}
+		}
+	}
 
 	return PIPE_RWSTREAM_NoError;
 }
@@ -213,6 +396,7 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_TOKEN                            PIPE_TOKEN_OUT
 #define  TEMPLATE_CLEAR_PIPE()                     Pipe_ClearOUT()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Pipe_GetBankSize() - Pipe_BytesInPipe())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Pipe_Write_Byte(*((uint8_t*)BufferPtr++))
 #include "Template/Template_Pipe_RW.c"
@@ -221,6 +405,7 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_TOKEN                            PIPE_TOKEN_OUT
 #define  TEMPLATE_CLEAR_PIPE()                     Pipe_ClearOUT()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Pipe_GetBankSize() - Pipe_BytesInPipe())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Pipe_Write_Byte(pgm_read_byte((uint8_t*)BufferPtr++))
 #include "Template/Template_Pipe_RW.c"
@@ -229,6 +414,7 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_TOKEN                            PIPE_TOKEN_OUT
 #define  TEMPLATE_CLEAR_PIPE()                     Pipe_ClearOUT()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Pipe_GetBankSize() - Pipe_BytesInPipe())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Pipe_Write_Byte(eeprom_read_byte((uint8_t*)BufferPtr++))
 #include "Template/Template_Pipe_RW.c"
@@ -237,6 +423,7 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_TOKEN                            PIPE_TOKEN_OUT
 #define  TEMPLATE_CLEAR_PIPE()                     Pipe_ClearOUT()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Pipe_GetBankSize() - Pipe_BytesInPipe())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Pipe_Write_Byte(*((uint8_t*)BufferPtr--))
 #include "Template/Template_Pipe_RW.c"
@@ -245,6 +432,7 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_TOKEN                            PIPE_TOKEN_OUT
 #define  TEMPLATE_CLEAR_PIPE()                     Pipe_ClearOUT()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Pipe_GetBankSize() - Pipe_BytesInPipe())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Pipe_Write_Byte(pgm_read_byte((uint8_t*)BufferPtr--))
 #include "Template/Template_Pipe_RW.c"
@@ -253,6 +441,7 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 #define  TEMPLATE_BUFFER_TYPE                      const void*
 #define  TEMPLATE_TOKEN                            PIPE_TOKEN_OUT
 #define  TEMPLATE_CLEAR_PIPE()                     Pipe_ClearOUT()
+#define  TEMPLATE_BYTES_IN_BANK()                  (Pipe_GetBankSize() - Pipe_BytesInPipe())
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Pipe_Write_Byte(eeprom_read_byte((uint8_t*)BufferPtr--))
 #include "Template/Template_Pipe_RW.c"
@@ -261,6 +450,7 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 #define  TEMPLATE_BUFFER_TYPE                      void*
 #define  TEMPLATE_TOKEN                            PIPE_TOKEN_IN
 #define  TEMPLATE_CLEAR_PIPE()                     Pipe_ClearIN()
+#define  TEMPLATE_BYTES_IN_BANK()                  Pipe_BytesInPipe()
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         *((uint8_t*)BufferPtr++) = Pipe_Read_Byte()
 #include "Template/Template_Pipe_RW.c"
@@ -269,6 +459,7 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 #define  TEMPLATE_BUFFER_TYPE                      void*
 #define  TEMPLATE_TOKEN                            PIPE_TOKEN_IN
 #define  TEMPLATE_CLEAR_PIPE()                     Pipe_ClearIN()
+#define  TEMPLATE_BYTES_IN_BANK()                  Pipe_BytesInPipe()
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         eeprom_write_byte((uint8_t*)BufferPtr++, Pipe_Read_Byte())
 #include "Template/Template_Pipe_RW.c"
@@ -277,6 +468,7 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 #define  TEMPLATE_BUFFER_TYPE                      void*
 #define  TEMPLATE_TOKEN                            PIPE_TOKEN_IN
 #define  TEMPLATE_CLEAR_PIPE()                     Pipe_ClearIN()
+#define  TEMPLATE_BYTES_IN_BANK()                  Pipe_BytesInPipe()
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         *((uint8_t*)BufferPtr--) = Pipe_Read_Byte()
 #include "Template/Template_Pipe_RW.c"
@@ -285,6 +477,7 @@ uint8_t Pipe_Discard_Stream(uint16_t Length
 #define  TEMPLATE_BUFFER_TYPE                      void*
 #define  TEMPLATE_TOKEN                            PIPE_TOKEN_IN
 #define  TEMPLATE_CLEAR_PIPE()                     Pipe_ClearIN()
+#define  TEMPLATE_BYTES_IN_BANK()                  Pipe_BytesInPipe()
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         eeprom_write_byte((uint8_t*)BufferPtr--, Pipe_Read_Byte())
 #include "Template/Template_Pipe_RW.c"
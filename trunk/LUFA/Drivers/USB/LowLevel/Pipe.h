@@ -82,6 +82,8 @@
 		#include "../../../Common/Common.h"
 		#include "../HighLevel/USBTask.h"
 
+		#include "../HighLevel/StreamSegments.h"
+
 		#if !defined(NO_STREAM_CALLBACKS) || defined(__DOXYGEN__)
 			#include "../HighLevel/StreamCallbacks.h"
 		#endif
@@ -274,6 +276,32 @@
 				 */
 				static inline uint8_t Pipe_BoundEndpointNumber(void);
 
+				/** Retrieves the binding of the currently selected pipe, comprising the pipe's type, token and the endpoint
+				 *  number within the attached device that the pipe is bound to, as a single byte for later restoration via
+				 *  \ref Pipe_SetBinding().
+				 *
+				 *  \return Binding of the currently selected pipe
+				 */
+				static inline uint8_t Pipe_GetBinding(void);
+
+				/** Rebinds the currently selected pipe to the type, token and device endpoint of a binding previously
+				 *  retrieved via \ref Pipe_GetBinding(), without altering the pipe's bank size, banking mode or position in
+				 *  the USB FIFO memory. This allows a single pipe to be shared between several endpoints in turn. The pipe's
+				 *  banks are emptied and its data toggle reset to DATA0; the data toggle of the newly bound device endpoint
+				 *  should also be reset, via a ClearFeature request (see \ref USB_Host_ClearPipeStall()).
+				 *
+				 *  \param[in] Binding  Binding to apply to the currently selected pipe
+				 */
+				static inline void Pipe_SetBinding(uint8_t Binding);
+
+				/** Determines if the currently selected pipe holds data, either received from the attached device but not
+				 *  yet read by the application, or written by the application but not yet sent to the device. Such data is
+				 *  discarded if the pipe is rebound via \ref Pipe_SetBinding() or reallocated.
+				 *
+				 *  \return Boolean true if the currently selected pipe holds data, false otherwise
+				 */
+				static inline bool Pipe_HoldsData(void);
+
 				/** Sets the period between interrupts for an INTERRUPT type pipe to a specified number of milliseconds.
 				 *
 				 *  \param[in] Milliseconds  Number of milliseconds between each pipe poll
@@ -452,6 +480,12 @@
 
 				#define Pipe_BoundEndpointNumber()     ((UPCFG0X >> PEPNUM0) & PIPE_EPNUM_MASK)
 				
+				#define Pipe_GetBinding()              UPCFG0X
+
+				#define Pipe_SetBinding(binding)       MACROS{ UPCFG0X = (binding); Pipe_ResetPipe(Pipe_GetCurrentPipe()); }MACROE
+
+				#define Pipe_HoldsData()               (((UPSTAX & ((1 << NBUSYBK1) | (1 << NBUSYBK0))) || Pipe_BytesInPipe()) ? true : false)
+
 				#define Pipe_SetInterruptPeriod(ms)    MACROS{ UPCFG2X = (ms); }MACROE
 
 				#define Pipe_GetPipeInterrupts()       UPINT
@@ -572,6 +606,7 @@
 				uint8_t Dummy;
 				
 				Dummy = UPDATX;
+				(void)Dummy;
 			}
 			
 			/** Reads two bytes from the currently selected pipe's bank in little endian format, for OUT
@@ -657,6 +692,7 @@
 				
 				Dummy = UPDATX;
 				Dummy = UPDATX;
+				(void)Dummy;
 			}
 
 			/** Reads four bytes from the currently selected pipe's bank in little endian format, for OUT
@@ -752,6 +788,7 @@
 				Dummy = UPDATX;
 				Dummy = UPDATX;
 				Dummy = UPDATX;
+				(void)Dummy;
 			}
 
 		/* External Variables: */
@@ -803,6 +840,22 @@
 			bool Pipe_ConfigurePipe(const uint8_t  Number, const uint8_t Type, const uint8_t Token, const uint8_t EndpointNumber,
 			                        const uint16_t Size, const uint8_t Banks);
 
+			/** Reconfigures the default control pipe to the given bank size, and updates \ref USB_ControlPipeSize to match.
+			 *  As the pipes are allocated in ascending order within the USB FIFO memory, the memory of all other allocated
+			 *  pipes is released and reallocated around the resized control pipe, leaving their configuration unaltered. This
+			 *  is used when communicating with several devices in turn (such as the devices attached to a hub) whose default
+			 *  control endpoints differ in size. As reallocation empties the pipes' banks, no change is made while any other
+			 *  pipe holds data which has not yet been read by the application or sent to the device.
+			 *
+			 *  \note This routine will select the default control pipe.
+			 *
+			 *  \param[in] Size  New bank size of the default control pipe, in bytes
+			 *
+			 *  \return Boolean true if the control pipe and all previously allocated pipes are configured, false if another
+			 *          pipe holds data or the pipes could not be reallocated
+			 */
+			bool Pipe_SetControlPipeSize(const uint8_t Size);
+
 			/** Spin-loops until the currently selected non-control pipe is ready for the next packed of data to be read 
 			 *  or written to it, aborting in the case of an error condition (such as a timeout or device disconnect).
 			 *
@@ -942,6 +995,29 @@
 			 */
 			uint8_t Pipe_Write_PStream_BE(const void* Buffer, uint16_t Length __CALLBACK_PARAM) ATTR_NON_NULL_PTR_ARG(1);
 
+			/** Writes the given array of stream segments to the pipe in little endian as a single contiguous stream,
+			 *  sending full packets to the device as needed. Each segment's data may be located in RAM, FLASH or
+			 *  EEPROM, as indicated by the segment's memory space. Segments are packed into the pipe's banks back
+			 *  to back, so that a packet may contain data from several consecutive segments. As with the other stream
+			 *  write functions, the last packet filled is not automatically sent; the user is responsible for manually
+			 *  sending the last written packet to the device via the \ref Pipe_ClearOUT() macro. Between each USB packet,
+			 *  the given stream callback function is executed repeatedly until the next packet is ready, allowing for
+			 *  early aborts of stream transfers.
+			 *
+			 *	The callback routine should be created according to the information in \ref Group_StreamCallbacks.
+			 *  If the token NO_STREAM_CALLBACKS is passed via the -D option to the compiler, stream callbacks are
+			 *  disabled and this function has the Callback parameter omitted.
+			 *
+			 *  \ingroup Group_PipeStreamRW
+			 *
+			 *  \param[in] Segments       Pointer to an array of \ref USB_StreamSegment_t segments to write.
+			 *  \param[in] TotalSegments  Number of segments in the Segments array.
+			 *  \param[in] Callback       Name of a callback routine to call between successive USB packet transfers, NULL if no callback
+			 *
+			 *  \return A value from the \ref Pipe_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t Pipe_Write_StreamV(const USB_StreamSegment_t* Segments, uint8_t TotalSegments __CALLBACK_PARAM) ATTR_NON_NULL_PTR_ARG(1);
+
 			/** Reads the given number of bytes from the pipe into the given buffer in little endian,
 			 *  sending full packets to the device as needed. The last packet filled is not automatically sent;
 			 *  the user is responsible for manually sending the last written packet to the host via the
@@ -1024,9 +1100,19 @@
 			#define Pipe_AllocateMemory()          MACROS{ UPCFG1X |=  (1 << ALLOC); }MACROE
 			#define Pipe_DeallocateMemory()        MACROS{ UPCFG1X &= ~(1 << ALLOC); }MACROE
 
+			#define Pipe_GetBankSize()             ((uint16_t)8 << ((UPCFG1X & (0x07 << EPSIZE0)) >> EPSIZE0))
+
 		/* Function Prototypes: */
 			void Pipe_ClearPipes(void);
 
+			#if defined(IDLE_STREAM_WAITS)
+				void Pipe_DisarmReadyWake(void);
+			#endif
+
+			#if defined(IDLE_STREAM_WAITS) && defined(__INCLUDE_FROM_PIPE_C)
+				static void Pipe_SleepUntilReady(void);
+			#endif
+
 		/* Inline Functions: */
 			static inline uint8_t Pipe_BytesToEPSizeMask(uint16_t Bytes) ATTR_WARN_UNUSED_RESULT ATTR_CONST ATTR_ALWAYS_INLINE;
 			static inline uint8_t Pipe_BytesToEPSizeMask(uint16_t Bytes)
@@ -0,0 +1,1628 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#define  __INCLUDE_FROM_USBSIMULATOR_C
+#include "avr/io.h"
+#include "../../HighLevel/USBMode.h"
+
+#include <string.h>
+
+USB_Sim_Config_t USB_Sim_Config =
+	{
+		#if defined(USB_SERIES_4_AVR) || defined(USB_SERIES_6_AVR) || defined(USB_SERIES_7_AVR)
+		.EndpointMaxBankSize  = {64, 256, 64, 64, 64, 64, 64},
+		.EndpointDoubleBank   = {true, true, true, true, true, true, true},
+		#else
+		.EndpointMaxBankSize  = {64, 64, 64, 64, 64, 0, 0},
+		.EndpointDoubleBank   = {true, false, false, true, true, false, false},
+		#endif
+
+		#if defined(USB_SERIES_7_AVR)
+		.PipeMaxBankSize      = {64, 256, 64, 64, 64, 64, 64},
+		.PipeDoubleBank       = {true, true, true, true, true, true, true},
+		#endif
+
+		.AccessesPerFrame     = 2000,
+		.ControlTimeoutFrames = 500,
+		.SignatureRow         = {0x1E, 0x00, 0x97, 0x00, 0x82, 0x00, 0x00, 0x00,
+		                         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4C, 0x55,
+		                         0x46, 0x41, 0x53, 0x49, 0x4D, 0x30, 0x31, 0x32,
+		                         0x33, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+	};
+
+USB_Sim_Statistics_t USB_Sim_Statistics;
+
+/** User data pointer shared by all FILE streams, read and written via fdev_get_udata() and fdev_set_udata(). */
+void* USB_Sim_StreamUData;
+
+void USB_GEN_vect(void) __attribute__ ((weak));
+void USB_COM_vect(void) __attribute__ ((weak));
+void TIMER1_COMPA_vect(void) __attribute__ ((weak));
+
+static uint8_t        USB_Sim_Registers[USB_SIM_TOTAL_REGISTERS];
+static uint8_t        USB_Sim_Cells[USB_SIM_TOTAL_REGISTERS];
+static uint16_t       USB_Sim_Cells16[USB_SIM_TOTAL_REGISTERS - USB_SIM_REG_UEBCX];
+static uint8_t        USB_Sim_DummyData;
+
+static struct
+{
+	uint8_t Register;
+	uint8_t Index;
+	uint8_t Baseline;
+	uint8_t Age;
+} USB_Sim_Outstanding[4];
+
+static USB_Sim_FIFO_t USB_Sim_Endpoints[USB_SIM_TOTAL_ENDPOINTS];
+static USB_Sim_FIFO_t USB_Sim_Pipes[USB_SIM_TOTAL_ENDPOINTS];
+
+static USB_Sim_Ring_t USB_Sim_INRings[USB_SIM_TOTAL_ENDPOINTS];
+static USB_Sim_Ring_t USB_Sim_OUTRings[USB_SIM_TOTAL_ENDPOINTS];
+
+static bool           USB_Sim_InterruptsEnabled;
+static bool           USB_Sim_InISR;
+static bool           USB_Sim_WakePending;
+static uint16_t       USB_Sim_Timer1LastCount;
+static uint16_t       USB_Sim_FrameAccesses;
+static uint32_t       USB_Sim_FrameCount;
+static uint16_t       USB_Sim_DeviceFrameNumber;
+static uint16_t       USB_Sim_HostFrameNumber;
+
+static bool           USB_Sim_HostAttached;
+static bool           USB_Sim_BusSuspended;
+static uint8_t        USB_Sim_EndpointModes[USB_SIM_TOTAL_ENDPOINTS];
+static USB_Sim_ControlTransfer_t USB_Sim_ControlQueue[USB_SIM_MAX_QUEUED_REQUESTS];
+static uint8_t        USB_Sim_ControlQueueHead;
+static uint8_t        USB_Sim_ControlQueueCount;
+
+static bool           USB_Sim_DeviceAttached;
+static uint8_t        USB_Sim_DeviceStalls;
+static USB_Sim_ControlHandler_t  USB_Sim_ControlHandler;
+static USB_Sim_ControlTransfer_t USB_Sim_DeviceControl;
+static uint8_t        USB_Sim_DeviceScratch[USB_SIM_PEER_BUFFER_SIZE];
+
+#define USB_SIM_REG(Name)              USB_Sim_Registers[USB_SIM_REG_ ## Name]
+#define USB_SIM_IS_HOST_MODE()         ((USB_SIM_REG(USBCON) & (1 << HOST)) ? true : false)
+#define USB_SIM_IS_CONTROL(FIFO)       (((FIFO)->Config0 & ((1 << EPTYPE1) | (1 << EPTYPE0))) == 0)
+#define USB_SIM_PIPE_TOKEN(FIFO)       (((FIFO)->Config0 >> PTOKEN0) & 0x03)
+#define USB_SIM_TOKEN_SETUP            0
+#define USB_SIM_TOKEN_IN               1
+#define USB_SIM_TOKEN_OUT              2
+#define USB_SIM_INTERRUPT_FLAGS_MASK   0x5F
+
+void USB_Sim_Reset(void)
+{
+	memset(USB_Sim_Registers, 0, sizeof(USB_Sim_Registers));
+	memset(USB_Sim_Outstanding, 0, sizeof(USB_Sim_Outstanding));
+	memset(USB_Sim_INRings, 0, sizeof(USB_Sim_INRings));
+	memset(USB_Sim_OUTRings, 0, sizeof(USB_Sim_OUTRings));
+	memset(USB_Sim_EndpointModes, 0, sizeof(USB_Sim_EndpointModes));
+
+	USB_SIM_REG(UDCON)         = (1 << DETACH);
+
+	USB_Sim_InterruptsEnabled  = false;
+	USB_Sim_InISR              = false;
+	USB_Sim_WakePending        = false;
+	USB_Sim_Timer1LastCount    = 0;
+	USB_Sim_FrameAccesses      = 0;
+	USB_Sim_FrameCount         = 0;
+	USB_Sim_HostAttached       = false;
+	USB_Sim_BusSuspended       = false;
+	USB_Sim_ControlQueueHead   = 0;
+	USB_Sim_ControlQueueCount  = 0;
+	USB_Sim_DeviceAttached     = false;
+	USB_Sim_DeviceStalls       = 0;
+	USB_Sim_ControlHandler     = NULL;
+	USB_Sim_DeviceControl.Stage = USB_SIM_STAGE_Idle;
+
+	USB_Sim_Cells16[USB_SIM_REG_OCR1A - USB_SIM_REG_UEBCX] = 0;
+
+	USB_Sim_ResetController();
+	USB_Sim_Device_UpdateID();
+	USB_Sim_ClearStatistics();
+}
+
+void USB_Sim_ClearStatistics(void)
+{
+	memset(&USB_Sim_Statistics, 0, sizeof(USB_Sim_Statistics));
+}
+
+void USB_Sim_Sync(void)
+{
+	USB_Sim_Step();
+}
+
+void USB_Sim_AdvanceFrames(uint16_t Frames)
+{
+	while (Frames--)
+	{
+		USB_Sim_CommitWrites();
+		USB_Sim_FrameAccesses = 0;
+		USB_Sim_StartFrame();
+		USB_Sim_Host_Service();
+		USB_Sim_Device_Service();
+		USB_Sim_Timer1_Update();
+		USB_Sim_DispatchInterrupts();
+	}
+}
+
+void USB_Sim_DelayMicroseconds(uint32_t Microseconds)
+{
+	uint16_t AccessesPerFrame = (USB_Sim_Config.AccessesPerFrame) ? USB_Sim_Config.AccessesPerFrame : 1;
+
+	USB_Sim_AdvanceFrames(Microseconds / 1000);
+
+	uint32_t Accesses = (((Microseconds % 1000) * AccessesPerFrame) / 1000);
+
+	while (Accesses--)
+	  USB_Sim_Step();
+}
+
+void USB_Sim_Sleep(void)
+{
+	USB_Sim_CommitWrites();
+
+	if (!(USB_SIM_REG(SMCR) & (1 << SE)))
+	  return;
+
+	/* An interrupt serviced on the enabling of global interrupts immediately before the sleep would be executed
+	 * on the AVR after the SLEEP instruction, waking the CPU straight away */
+	if (USB_Sim_WakePending)
+	{
+		USB_Sim_WakePending = false;
+		return;
+	}
+
+	uint32_t PrevInterrupts = USB_Sim_Statistics.Interrupts;
+	uint32_t AccessesRem    = ((uint32_t)USB_SIM_MAX_SLEEP_FRAMES * USB_Sim_Config.AccessesPerFrame);
+
+	while ((USB_Sim_Statistics.Interrupts == PrevInterrupts) && AccessesRem--)
+	{
+		USB_Sim_Statistics.SleepAccesses++;
+		USB_Sim_Step();
+	}
+}
+
+void USB_Sim_SetInterruptsEnabled(const bool Enabled)
+{
+	USB_Sim_InterruptsEnabled = Enabled;
+
+	if (Enabled)
+	{
+		uint32_t PrevInterrupts = USB_Sim_Statistics.Interrupts;
+
+		USB_Sim_DispatchInterrupts();
+		USB_Sim_WakePending = (USB_Sim_Statistics.Interrupts != PrevInterrupts);
+	}
+}
+
+volatile uint8_t* USB_Sim_Register(const uint8_t Register)
+{
+	USB_Sim_Statistics.RegisterAccesses++;
+	USB_Sim_WakePending = false;
+	USB_Sim_Step();
+
+	if ((Register == USB_SIM_REG_UEDATX) || (Register == USB_SIM_REG_UPDATX))
+	{
+		USB_Sim_FIFO_t* FIFO = (Register == USB_SIM_REG_UEDATX) ?
+		                       &USB_Sim_Endpoints[USB_SIM_REG(UENUM)] : &USB_Sim_Pipes[USB_SIM_REG(UPNUM)];
+		USB_Sim_Bank_t* Bank;
+
+		USB_Sim_Statistics.DataAccesses++;
+
+		switch (USB_Sim_FIFO_CPUAccess(FIFO, &Bank))
+		{
+			case USB_SIM_ACCESS_Read:
+				if (FIFO->Position < Bank->Length)
+				  return &Bank->Data[FIFO->Position++];
+
+				break;
+			case USB_SIM_ACCESS_Write:
+				if (FIFO->Position < FIFO->Size)
+				  return &Bank->Data[FIFO->Position++];
+
+				break;
+		}
+
+		return &USB_Sim_DummyData;
+	}
+
+	uint8_t Index = 0;
+
+	if ((Register >= USB_SIM_REG_UEINTX) && (Register <= USB_SIM_REG_UEBCHX))
+	  Index = USB_SIM_REG(UENUM);
+	else if ((Register >= USB_SIM_REG_UPINRQX) && (Register <= USB_SIM_REG_UPBCHX))
+	  Index = USB_SIM_REG(UPNUM);
+
+	uint8_t Value = USB_Sim_ReadRegister(Register, Index);
+	uint8_t Slot  = 0;
+
+	for (uint8_t i = 0; i < (sizeof(USB_Sim_Outstanding) / sizeof(USB_Sim_Outstanding[0])); i++)
+	{
+		if (USB_Sim_Outstanding[i].Age && (USB_Sim_Outstanding[i].Register == Register))
+		{
+			Slot = i;
+			break;
+		}
+		else if (USB_Sim_Outstanding[i].Age < USB_Sim_Outstanding[Slot].Age)
+		{
+			Slot = i;
+		}
+	}
+
+	USB_Sim_Outstanding[Slot].Register = Register;
+	USB_Sim_Outstanding[Slot].Index    = Index;
+	USB_Sim_Outstanding[Slot].Baseline = Value;
+	USB_Sim_Outstanding[Slot].Age      = (sizeof(USB_Sim_Outstanding) / sizeof(USB_Sim_Outstanding[0]));
+
+	USB_Sim_Cells[Register] = Value;
+	return &USB_Sim_Cells[Register];
+}
+
+volatile uint16_t* USB_Sim_Register16(const uint8_t Register)
+{
+	USB_Sim_Statistics.RegisterAccesses++;
+	USB_Sim_WakePending = false;
+	USB_Sim_Step();
+
+	uint16_t* Cell = &USB_Sim_Cells16[Register - USB_SIM_REG_UEBCX];
+
+	switch (Register)
+	{
+		case USB_SIM_REG_UEBCX:
+			*Cell = (((uint16_t)USB_Sim_ReadRegister(USB_SIM_REG_UEBCHX, USB_SIM_REG(UENUM)) << 8) |
+			         USB_Sim_ReadRegister(USB_SIM_REG_UEBCLX, USB_SIM_REG(UENUM)));
+			break;
+		case USB_SIM_REG_UPBCX:
+			*Cell = (((uint16_t)USB_Sim_ReadRegister(USB_SIM_REG_UPBCHX, USB_SIM_REG(UPNUM)) << 8) |
+			         USB_Sim_ReadRegister(USB_SIM_REG_UPBCLX, USB_SIM_REG(UPNUM)));
+			break;
+		case USB_SIM_REG_UDFNUM:
+			*Cell = USB_Sim_DeviceFrameNumber;
+			break;
+		case USB_SIM_REG_UHFNUM:
+			*Cell = USB_Sim_HostFrameNumber;
+			break;
+		case USB_SIM_REG_TCNT1:
+			*Cell = USB_Sim_Timer1_GetCount();
+			break;
+		case USB_SIM_REG_OCR1A:
+			/* Compare register value is held directly in the register's cell, as it is never altered by the hardware */
+			break;
+	}
+
+	return Cell;
+}
+
+static uint16_t USB_Sim_Timer1_GetCount(void)
+{
+	if (!(USB_SIM_REG(TCCR1B) & ((1 << CS12) | (1 << CS11) | (1 << CS10))))
+	  return USB_Sim_Timer1LastCount;
+
+	return ((USB_Sim_FrameCount * (F_CPU / 64000)) +
+	        (((uint32_t)USB_Sim_FrameAccesses * (F_CPU / 64000)) / USB_Sim_Config.AccessesPerFrame));
+}
+
+static void USB_Sim_Timer1_Update(void)
+{
+	uint16_t Count        = USB_Sim_Timer1_GetCount();
+	uint16_t CompareValue = USB_Sim_Cells16[USB_SIM_REG_OCR1A - USB_SIM_REG_UEBCX];
+
+	if ((uint16_t)(CompareValue - USB_Sim_Timer1LastCount - 1) < (uint16_t)(Count - USB_Sim_Timer1LastCount))
+	  USB_SIM_REG(TIFR1) |= (1 << OCF1A);
+
+	USB_Sim_Timer1LastCount = Count;
+}
+
+static void USB_Sim_Step(void)
+{
+	USB_Sim_CommitWrites();
+
+	if (++USB_Sim_FrameAccesses >= USB_Sim_Config.AccessesPerFrame)
+	{
+		USB_Sim_FrameAccesses = 0;
+		USB_Sim_StartFrame();
+	}
+
+	USB_Sim_Host_Service();
+	USB_Sim_Device_Service();
+	USB_Sim_Timer1_Update();
+	USB_Sim_DispatchInterrupts();
+}
+
+static void USB_Sim_CommitWrites(void)
+{
+	for (uint8_t i = 0; i < (sizeof(USB_Sim_Outstanding) / sizeof(USB_Sim_Outstanding[0])); i++)
+	{
+		if (!(USB_Sim_Outstanding[i].Age))
+		  continue;
+
+		uint8_t Register = USB_Sim_Outstanding[i].Register;
+		uint8_t OldValue = USB_Sim_Outstanding[i].Baseline;
+		uint8_t NewValue = USB_Sim_Cells[Register];
+
+		if (NewValue != OldValue)
+		{
+			USB_Sim_Outstanding[i].Baseline = NewValue;
+			USB_Sim_WriteRegister(Register, USB_Sim_Outstanding[i].Index, OldValue, NewValue);
+
+			USB_Sim_Cells[Register]         = USB_Sim_ReadRegister(Register, USB_Sim_Outstanding[i].Index);
+			USB_Sim_Outstanding[i].Baseline = USB_Sim_Cells[Register];
+		}
+
+		USB_Sim_Outstanding[i].Age--;
+	}
+}
+
+static void USB_Sim_StartFrame(void)
+{
+	USB_Sim_Statistics.Frames++;
+	USB_Sim_FrameCount++;
+
+	if (!(USB_SIM_REG(USBCON) & (1 << USBE)) || (USB_SIM_REG(USBCON) & (1 << FRZCLK)))
+	  return;
+
+	if (USB_SIM_IS_HOST_MODE())
+	{
+		if (USB_SIM_REG(UHCON) & (1 << SOFEN))
+		{
+			USB_Sim_HostFrameNumber = ((USB_Sim_HostFrameNumber + 1) & 0x07FF);
+			USB_SIM_REG(UHINT) |= (1 << HSOFI);
+		}
+	}
+	else if (USB_Sim_HostAttached && !(USB_Sim_BusSuspended) && !(USB_SIM_REG(UDCON) & (1 << DETACH)))
+	{
+		USB_Sim_DeviceFrameNumber = ((USB_Sim_DeviceFrameNumber + 1) & 0x07FF);
+		USB_SIM_REG(UDINT) |= (1 << SOFI);
+	}
+}
+
+static void USB_Sim_DispatchInterrupts(void)
+{
+	if (!(USB_Sim_InterruptsEnabled) || USB_Sim_InISR)
+	  return;
+
+	bool GENPending = ((USB_SIM_REG(UDINT)  & USB_SIM_REG(UDIEN)  & 0x7D) ||
+	                   (USB_SIM_REG(UHINT)  & USB_SIM_REG(UHIEN)  & 0x7F) ||
+	                   (USB_SIM_REG(OTGINT) & USB_SIM_REG(OTGIEN) & 0x3F) ||
+	                   (USB_SIM_REG(USBINT) & USB_SIM_REG(USBCON) & ((1 << IDTI) | (1 << VBUSTI))));
+	bool COMPending = false;
+
+	for (uint8_t Number = 0; Number < USB_SIM_TOTAL_ENDPOINTS; Number++)
+	{
+		USB_Sim_FIFO_t* FIFO = (USB_SIM_IS_HOST_MODE()) ? &USB_Sim_Pipes[Number] : &USB_Sim_Endpoints[Number];
+
+		if (FIFO->IntFlags & FIFO->IntEnable & USB_SIM_INTERRUPT_FLAGS_MASK)
+		  COMPending = true;
+	}
+
+	bool TimerPending = ((USB_SIM_REG(TIFR1) & USB_SIM_REG(TIMSK1) & (1 << OCF1A)) ? true : false);
+
+	void (*Vector)(void) = NULL;
+
+	if (GENPending && USB_GEN_vect)
+	{
+		Vector = USB_GEN_vect;
+	}
+	else if (COMPending && USB_COM_vect)
+	{
+		Vector = USB_COM_vect;
+	}
+	else if (TimerPending && TIMER1_COMPA_vect)
+	{
+		USB_SIM_REG(TIFR1) &= ~(1 << OCF1A);
+		Vector = TIMER1_COMPA_vect;
+	}
+
+	if (Vector == NULL)
+	  return;
+
+	USB_Sim_Statistics.Interrupts++;
+
+	USB_Sim_InISR             = true;
+	USB_Sim_InterruptsEnabled = false;
+
+	Vector();
+	USB_Sim_CommitWrites();
+
+	USB_Sim_InterruptsEnabled = true;
+	USB_Sim_InISR             = false;
+}
+
+static uint8_t USB_Sim_ReadRegister(const uint8_t Register, const uint8_t Index)
+{
+	USB_Sim_FIFO_t* Endpoint = &USB_Sim_Endpoints[Index % USB_SIM_TOTAL_ENDPOINTS];
+	USB_Sim_FIFO_t* Pipe     = &USB_Sim_Pipes[Index % USB_SIM_TOTAL_ENDPOINTS];
+	USB_Sim_FIFO_t* FIFO     = (Register >= USB_SIM_REG_UPINRQX) ? Pipe : Endpoint;
+	USB_Sim_Bank_t* Bank;
+	uint8_t         Value    = 0;
+
+	switch (Register)
+	{
+		case USB_SIM_REG_USBSTA:
+			if (USB_Sim_HostAttached || (USB_SIM_IS_HOST_MODE() && (USB_SIM_REG(OTGCON) & (1 << VBUSREQ))))
+			  Value |= (1 << VBUS);
+
+			if (!(USB_Sim_DeviceAttached))
+			  Value |= (1 << ID);
+
+			if (USB_SIM_IS_HOST_MODE() && USB_Sim_DeviceAttached)
+			  Value |= (1 << SPEED);
+
+			return Value;
+		case USB_SIM_REG_PLLCSR:
+			Value = USB_SIM_REG(PLLCSR);
+
+			if (Value & (1 << PLLE))
+			  Value |= (1 << PLOCK);
+
+			return Value;
+		case USB_SIM_REG_SREG:
+			return ((USB_SIM_REG(SREG) & 0x7F) | ((USB_Sim_InterruptsEnabled) ? 0x80 : 0));
+		case USB_SIM_REG_SPSR:
+			return (USB_SIM_REG(SPSR) | (1 << SPIF));
+		case USB_SIM_REG_UCSR1A:
+			return (USB_SIM_REG(UCSR1A) | (1 << RXC1) | (1 << UDRE1));
+		case USB_SIM_REG_UDFNUML:
+			return (USB_Sim_DeviceFrameNumber & 0xFF);
+		case USB_SIM_REG_UDFNUMH:
+			return (USB_Sim_DeviceFrameNumber >> 8);
+		case USB_SIM_REG_UHFNUML:
+			return (USB_Sim_HostFrameNumber & 0xFF);
+		case USB_SIM_REG_UHFNUMH:
+			return (USB_Sim_HostFrameNumber >> 8);
+		case USB_SIM_REG_UEINT:
+		case USB_SIM_REG_UPINT:
+			for (uint8_t Number = 0; Number < USB_SIM_TOTAL_ENDPOINTS; Number++)
+			{
+				FIFO = (Register == USB_SIM_REG_UPINT) ? &USB_Sim_Pipes[Number] : &USB_Sim_Endpoints[Number];
+
+				if (FIFO->IntFlags & FIFO->IntEnable & USB_SIM_INTERRUPT_FLAGS_MASK)
+				  Value |= (1 << Number);
+			}
+
+			return Value;
+		case USB_SIM_REG_UEINTX:
+		case USB_SIM_REG_UPINTX:
+			Value = FIFO->IntFlags;
+
+			switch (USB_Sim_FIFO_CPUAccess(FIFO, &Bank))
+			{
+				case USB_SIM_ACCESS_Read:
+					Value |= (1 << FIFOCON);
+
+					if (FIFO->Position < Bank->Length)
+					  Value |= (1 << RWAL);
+
+					break;
+				case USB_SIM_ACCESS_Write:
+					Value |= (1 << FIFOCON);
+
+					if (FIFO->Position < FIFO->Size)
+					  Value |= (1 << RWAL);
+
+					break;
+			}
+
+			return Value;
+		case USB_SIM_REG_UECONX:
+		case USB_SIM_REG_UPCONX:
+			return FIFO->Control;
+		case USB_SIM_REG_UECFG0X:
+		case USB_SIM_REG_UPCFG0X:
+			return FIFO->Config0;
+		case USB_SIM_REG_UECFG1X:
+		case USB_SIM_REG_UPCFG1X:
+			return FIFO->Config1;
+		case USB_SIM_REG_UPCFG2X:
+			return FIFO->Config2;
+		case USB_SIM_REG_UESTA0X:
+		case USB_SIM_REG_UPSTAX:
+			return (((FIFO->Configured) ? (1 << CFGOK) : 0) | (FIFO->Filled & 0x03));
+		case USB_SIM_REG_UESTA1X:
+			return 0;
+		case USB_SIM_REG_UEIENX:
+		case USB_SIM_REG_UPIENX:
+			return FIFO->IntEnable;
+		case USB_SIM_REG_UPINRQX:
+			return FIFO->INRequests;
+		case USB_SIM_REG_UPERRX:
+			return FIFO->Errors;
+		case USB_SIM_REG_UEBCLX:
+		case USB_SIM_REG_UEBCHX:
+		case USB_SIM_REG_UPBCLX:
+		case USB_SIM_REG_UPBCHX:
+		{
+			uint16_t BytesInBank = 0;
+
+			switch (USB_Sim_FIFO_CPUAccess(FIFO, &Bank))
+			{
+				case USB_SIM_ACCESS_Read:
+					BytesInBank = (Bank->Length - FIFO->Position);
+					break;
+				case USB_SIM_ACCESS_Write:
+					BytesInBank = FIFO->Position;
+					break;
+			}
+
+			if ((Register == USB_SIM_REG_UEBCHX) || (Register == USB_SIM_REG_UPBCHX))
+			  return (BytesInBank >> 8);
+			else
+			  return (BytesInBank & 0xFF);
+		}
+		default:
+			return USB_Sim_Registers[Register];
+	}
+}
+
+static void USB_Sim_WriteRegister(const uint8_t Register, const uint8_t Index,
+                                  const uint8_t OldValue, const uint8_t NewValue)
+{
+	USB_Sim_FIFO_t* Endpoint = &USB_Sim_Endpoints[Index % USB_SIM_TOTAL_ENDPOINTS];
+	USB_Sim_FIFO_t* Pipe     = &USB_Sim_Pipes[Index % USB_SIM_TOTAL_ENDPOINTS];
+	USB_Sim_FIFO_t* FIFO     = (Register >= USB_SIM_REG_UPINRQX) ? Pipe : Endpoint;
+	uint8_t         Cleared  = (OldValue & ~NewValue);
+	uint8_t         Set      = (~OldValue & NewValue);
+	USB_Sim_Bank_t* Bank;
+
+	switch (Register)
+	{
+		case USB_SIM_REG_USBCON:
+			USB_SIM_REG(USBCON) = NewValue;
+
+			if (Cleared & (1 << USBE))
+			  USB_Sim_ResetController();
+
+			if ((Set | Cleared) & (1 << HOST))
+			  USB_Sim_Host_AbortTransfers();
+
+			break;
+		case USB_SIM_REG_USBINT:
+		case USB_SIM_REG_UDINT:
+		case USB_SIM_REG_UHINT:
+		case USB_SIM_REG_OTGINT:
+			USB_Sim_Registers[Register] &= ~Cleared;
+			break;
+		case USB_SIM_REG_TIFR1:
+			USB_SIM_REG(TIFR1) &= ~Set;
+			break;
+		case USB_SIM_REG_OTGCON:
+			USB_SIM_REG(OTGCON) = (NewValue & ~(1 << VBUSRQC));
+
+			if (NewValue & (1 << VBUSRQC))
+			  USB_SIM_REG(OTGCON) &= ~((1 << VBUSREQ) | (1 << VBUSRQC));
+
+			if ((Set & (1 << VBUSREQ)) && USB_Sim_DeviceAttached && USB_SIM_IS_HOST_MODE())
+			  USB_SIM_REG(UHINT) |= (1 << DCONNI);
+
+			break;
+		case USB_SIM_REG_UDCON:
+			USB_SIM_REG(UDCON) = (NewValue & ~(1 << RMWKUP));
+
+			if (Set & (1 << RMWKUP))
+			{
+				USB_SIM_REG(UDINT) |= (1 << UPRSMI);
+
+				if (USB_Sim_HostAttached && USB_Sim_BusSuspended)
+				{
+					USB_Sim_BusSuspended = false;
+					USB_SIM_REG(UDINT) |= ((1 << WAKEUPI) | (1 << EORSMI));
+				}
+			}
+
+			break;
+		case USB_SIM_REG_UHCON:
+			USB_SIM_REG(UHCON) = (NewValue & (1 << SOFEN));
+
+			if (Set & (1 << RESET))
+			{
+				USB_Sim_DeviceControl.Stage = USB_SIM_STAGE_Idle;
+				USB_SIM_REG(UHINT) |= (1 << RSTI);
+			}
+
+			if (Set & (1 << RESUME))
+			  USB_SIM_REG(UHINT) |= (1 << RSMEDI);
+
+			break;
+		case USB_SIM_REG_PLLCSR:
+			USB_SIM_REG(PLLCSR) = (NewValue & ~(1 << PLOCK));
+			break;
+		case USB_SIM_REG_SREG:
+			USB_SIM_REG(SREG) = (NewValue & 0x7F);
+			USB_Sim_InterruptsEnabled = ((NewValue & 0x80) ? true : false);
+			break;
+		case USB_SIM_REG_UENUM:
+		case USB_SIM_REG_UPNUM:
+			USB_Sim_Registers[Register] = ((NewValue & 0x07) % USB_SIM_TOTAL_ENDPOINTS);
+			break;
+		case USB_SIM_REG_UERST:
+		case USB_SIM_REG_UPRST:
+			USB_Sim_Registers[Register] = NewValue;
+
+			for (uint8_t Number = 0; Number < USB_SIM_TOTAL_ENDPOINTS; Number++)
+			{
+				if (Set & (1 << Number))
+				  USB_Sim_FIFO_Reset((Register == USB_SIM_REG_UPRST) ? &USB_Sim_Pipes[Number] : &USB_Sim_Endpoints[Number]);
+			}
+
+			break;
+		case USB_SIM_REG_UEINTX:
+		case USB_SIM_REG_UPINTX:
+			FIFO->IntFlags &= ~(Cleared & USB_SIM_INTERRUPT_FLAGS_MASK);
+
+			if (!(FIFO->IsPipe) && USB_SIM_IS_CONTROL(FIFO))
+			{
+				uint8_t Access = USB_Sim_FIFO_CPUAccess(FIFO, &Bank);
+
+				if (((Access == USB_SIM_ACCESS_Read)  && (Cleared & ((1 << RXSTPI) | (1 << RXOUTI)))) ||
+				    ((Access == USB_SIM_ACCESS_Write) && (Cleared & (1 << TXINI))))
+				{
+					USB_Sim_FIFO_CPURelease(FIFO);
+				}
+			}
+			else if (Cleared & (1 << FIFOCON))
+			{
+				USB_Sim_FIFO_CPURelease(FIFO);
+			}
+
+			break;
+		case USB_SIM_REG_UECONX:
+			if (Set & (1 << STALLRQ))
+			  FIFO->Control |= (1 << STALLRQ);
+
+			if (NewValue & (1 << STALLRQC))
+			  FIFO->Control &= ~(1 << STALLRQ);
+
+			FIFO->Control = ((FIFO->Control & (1 << STALLRQ)) | (NewValue & (1 << EPEN)));
+			break;
+		case USB_SIM_REG_UPCONX:
+			FIFO->Control = (NewValue & ((1 << PFREEZE) | (1 << INMODE) | (1 << PEN)));
+			break;
+		case USB_SIM_REG_UECFG0X:
+			FIFO->Config0 = NewValue;
+			break;
+		case USB_SIM_REG_UPCFG0X:
+			FIFO->Config0 = NewValue;
+
+			if ((OldValue ^ NewValue) & ((1 << PTOKEN1) | (1 << PTOKEN0)))
+			  USB_Sim_FIFO_Reset(FIFO);
+
+			break;
+		case USB_SIM_REG_UECFG1X:
+		case USB_SIM_REG_UPCFG1X:
+			FIFO->Config1 = NewValue;
+			USB_Sim_FIFO_Configure(FIFO);
+			break;
+		case USB_SIM_REG_UPCFG2X:
+			FIFO->Config2 = NewValue;
+			break;
+		case USB_SIM_REG_UEIENX:
+		case USB_SIM_REG_UPIENX:
+			FIFO->IntEnable = NewValue;
+			break;
+		case USB_SIM_REG_UPINRQX:
+			FIFO->INRequests = NewValue;
+			break;
+		case USB_SIM_REG_UPERRX:
+			FIFO->Errors = NewValue;
+			break;
+		case USB_SIM_REG_USBSTA:
+		case USB_SIM_REG_UDFNUML:
+		case USB_SIM_REG_UDFNUMH:
+		case USB_SIM_REG_UHFNUML:
+		case USB_SIM_REG_UHFNUMH:
+		case USB_SIM_REG_UEINT:
+		case USB_SIM_REG_UPINT:
+		case USB_SIM_REG_UESTA0X:
+		case USB_SIM_REG_UESTA1X:
+		case USB_SIM_REG_UPSTAX:
+		case USB_SIM_REG_UEBCLX:
+		case USB_SIM_REG_UEBCHX:
+		case USB_SIM_REG_UPBCLX:
+		case USB_SIM_REG_UPBCHX:
+			break;
+		default:
+			USB_Sim_Registers[Register] = NewValue;
+			break;
+	}
+}
+
+static void USB_Sim_ResetController(void)
+{
+	for (uint8_t Number = 0; Number < USB_SIM_TOTAL_ENDPOINTS; Number++)
+	{
+		memset(&USB_Sim_Endpoints[Number], 0, sizeof(USB_Sim_FIFO_t));
+		memset(&USB_Sim_Pipes[Number], 0, sizeof(USB_Sim_FIFO_t));
+
+		USB_Sim_Endpoints[Number].MaxBankSize = USB_Sim_Config.EndpointMaxBankSize[Number];
+		USB_Sim_Endpoints[Number].DoubleBank  = USB_Sim_Config.EndpointDoubleBank[Number];
+		USB_Sim_Pipes[Number].MaxBankSize     = USB_Sim_Config.PipeMaxBankSize[Number];
+		USB_Sim_Pipes[Number].DoubleBank      = USB_Sim_Config.PipeDoubleBank[Number];
+		USB_Sim_Pipes[Number].IsPipe          = true;
+		USB_Sim_Pipes[Number].Control         = (1 << PFREEZE);
+	}
+
+	USB_SIM_REG(UDINT)        = 0;
+	USB_SIM_REG(UHINT)        = 0;
+	USB_SIM_REG(UDADDR)       = 0;
+	USB_SIM_REG(UHADDR)       = 0;
+	USB_SIM_REG(UHCON)        = 0;
+	USB_SIM_REG(UENUM)        = 0;
+	USB_SIM_REG(UPNUM)        = 0;
+	USB_Sim_DeviceFrameNumber = 0;
+	USB_Sim_HostFrameNumber   = 0;
+}
+
+static uint8_t USB_Sim_FIFO_CPUAccess(USB_Sim_FIFO_t* const FIFO, USB_Sim_Bank_t** const Bank)
+{
+	if (!(FIFO->Configured))
+	  return USB_SIM_ACCESS_None;
+
+	if (!(FIFO->IsPipe) && USB_SIM_IS_CONTROL(FIFO))
+	{
+		*Bank = &FIFO->Banks[0];
+
+		if (!(FIFO->Filled))
+		  return USB_SIM_ACCESS_Write;
+
+		return (FIFO->Banks[0].Received) ? USB_SIM_ACCESS_Read : USB_SIM_ACCESS_None;
+	}
+
+	bool Transmit = (FIFO->IsPipe) ? (USB_SIM_PIPE_TOKEN(FIFO) != USB_SIM_TOKEN_IN) : (FIFO->Config0 & (1 << EPDIR));
+
+	if (Transmit)
+	{
+		if (FIFO->Filled == FIFO->TotalBanks)
+		  return USB_SIM_ACCESS_None;
+
+		*Bank = &FIFO->Banks[(FIFO->Head + FIFO->Filled) % FIFO->TotalBanks];
+		return USB_SIM_ACCESS_Write;
+	}
+	else
+	{
+		if (!(FIFO->Filled))
+		  return USB_SIM_ACCESS_None;
+
+		*Bank = &FIFO->Banks[FIFO->Head];
+		return USB_SIM_ACCESS_Read;
+	}
+}
+
+static void USB_Sim_FIFO_SignalCPUBank(USB_Sim_FIFO_t* const FIFO)
+{
+	USB_Sim_Bank_t* Bank;
+
+	switch (USB_Sim_FIFO_CPUAccess(FIFO, &Bank))
+	{
+		case USB_SIM_ACCESS_Read:
+			FIFO->IntFlags |= (FIFO->IsPipe) ? (1 << RXINI) : (1 << RXOUTI);
+			break;
+		case USB_SIM_ACCESS_Write:
+			if (!(FIFO->IsPipe))
+			  FIFO->IntFlags |= (1 << TXINI);
+			else if (USB_SIM_PIPE_TOKEN(FIFO) == USB_SIM_TOKEN_SETUP)
+			  FIFO->IntFlags |= (1 << TXSTPI);
+			else
+			  FIFO->IntFlags |= (1 << TXOUTI);
+
+			break;
+	}
+}
+
+static void USB_Sim_FIFO_CPURelease(USB_Sim_FIFO_t* const FIFO)
+{
+	USB_Sim_Bank_t* Bank;
+
+	switch (USB_Sim_FIFO_CPUAccess(FIFO, &Bank))
+	{
+		case USB_SIM_ACCESS_Read:
+			FIFO->Head = ((FIFO->Head + 1) % FIFO->TotalBanks);
+			FIFO->Filled--;
+			break;
+		case USB_SIM_ACCESS_Write:
+			Bank->Length   = FIFO->Position;
+			Bank->Received = false;
+			FIFO->Filled++;
+			break;
+		default:
+			return;
+	}
+
+	FIFO->Position = 0;
+	USB_Sim_FIFO_SignalCPUBank(FIFO);
+}
+
+static void USB_Sim_FIFO_Configure(USB_Sim_FIFO_t* const FIFO)
+{
+	uint16_t MaxBankSize = FIFO->MaxBankSize;
+
+	if (MaxBankSize > USB_SIM_MAX_BANK_SIZE)
+	  MaxBankSize = USB_SIM_MAX_BANK_SIZE;
+
+	FIFO->Configured = false;
+	FIFO->IntFlags   = 0;
+
+	if (!(FIFO->Config1 & (1 << ALLOC)))
+	  return;
+
+	FIFO->Size       = (8 << ((FIFO->Config1 >> EPSIZE0) & 0x07));
+	FIFO->TotalBanks = ((FIFO->Config1 & (1 << EPBK0)) ? 2 : 1);
+
+	if ((FIFO->Size > MaxBankSize) || ((FIFO->TotalBanks == 2) && !(FIFO->DoubleBank)))
+	  return;
+
+	FIFO->Configured = true;
+	USB_Sim_FIFO_Reset(FIFO);
+}
+
+static void USB_Sim_FIFO_Reset(USB_Sim_FIFO_t* const FIFO)
+{
+	FIFO->Head      = 0;
+	FIFO->Filled    = 0;
+	FIFO->Position  = 0;
+	FIFO->IntFlags &= ~((1 << RXINI) | (1 << TXOUTI) | (1 << TXSTPI) | (1 << RXOUTI) | (1 << TXINI));
+
+	USB_Sim_FIFO_SignalCPUBank(FIFO);
+}
+
+static USB_Sim_Bank_t* USB_Sim_FIFO_BusPeek(USB_Sim_FIFO_t* const FIFO)
+{
+	if (!(FIFO->Configured) || !(FIFO->Filled) || FIFO->Banks[FIFO->Head].Received)
+	  return NULL;
+
+	return &FIFO->Banks[FIFO->Head];
+}
+
+static void USB_Sim_FIFO_BusPop(USB_Sim_FIFO_t* const FIFO)
+{
+	USB_Sim_Bank_t* Bank;
+	bool            HadBank = (USB_Sim_FIFO_CPUAccess(FIFO, &Bank) != USB_SIM_ACCESS_None);
+
+	FIFO->Head = ((FIFO->Head + 1) % FIFO->TotalBanks);
+	FIFO->Filled--;
+
+	if (!(HadBank))
+	{
+		FIFO->Position = 0;
+		USB_Sim_FIFO_SignalCPUBank(FIFO);
+	}
+}
+
+static bool USB_Sim_FIFO_BusDeliver(USB_Sim_FIFO_t* const FIFO, const uint8_t* Data, const uint16_t Length)
+{
+	if (!(FIFO->Configured) || (FIFO->Filled == FIFO->TotalBanks))
+	  return false;
+
+	USB_Sim_Bank_t* Bank    = &FIFO->Banks[(FIFO->Head + FIFO->Filled) % FIFO->TotalBanks];
+	bool            HadBank = (USB_Sim_FIFO_CPUAccess(FIFO, &Bank) != USB_SIM_ACCESS_None);
+
+	Bank = &FIFO->Banks[(FIFO->Head + FIFO->Filled) % FIFO->TotalBanks];
+
+	memcpy(Bank->Data, Data, Length);
+	Bank->Length   = Length;
+	Bank->Received = true;
+	FIFO->Filled++;
+
+	if (!(HadBank))
+	{
+		FIFO->Position = 0;
+		USB_Sim_FIFO_SignalCPUBank(FIFO);
+	}
+
+	return true;
+}
+
+static uint16_t USB_Sim_Ring_Write(USB_Sim_Ring_t* const Ring, const uint8_t* Data, const uint16_t Length)
+{
+	uint16_t BytesWritten = 0;
+
+	while ((BytesWritten < Length) && (Ring->Count < USB_SIM_PEER_BUFFER_SIZE))
+	{
+		Ring->Data[(Ring->Head + Ring->Count) % USB_SIM_PEER_BUFFER_SIZE] = Data[BytesWritten++];
+		Ring->Count++;
+	}
+
+	return BytesWritten;
+}
+
+static uint16_t USB_Sim_Ring_Read(USB_Sim_Ring_t* const Ring, uint8_t* Data, const uint16_t MaxLength)
+{
+	uint16_t BytesRead = 0;
+
+	while ((BytesRead < MaxLength) && Ring->Count)
+	{
+		if (Data != NULL)
+		  Data[BytesRead] = Ring->Data[Ring->Head];
+
+		BytesRead++;
+		Ring->Head = ((Ring->Head + 1) % USB_SIM_PEER_BUFFER_SIZE);
+		Ring->Count--;
+	}
+
+	return BytesRead;
+}
+
+void USB_Sim_Host_Attach(void)
+{
+	USB_Sim_HostAttached  = true;
+	USB_Sim_BusSuspended  = false;
+	USB_SIM_REG(USBINT)  |= (1 << VBUSTI);
+}
+
+void USB_Sim_Host_Detach(void)
+{
+	USB_Sim_HostAttached  = false;
+	USB_Sim_BusSuspended  = false;
+	USB_SIM_REG(USBINT)  |= (1 << VBUSTI);
+
+	USB_Sim_Host_AbortTransfers();
+}
+
+void USB_Sim_Host_ResetBus(void)
+{
+	USB_Sim_BusSuspended  = false;
+	USB_SIM_REG(UDADDR)   = 0;
+	USB_SIM_REG(UDINT)   |= (1 << EORSTI);
+
+	USB_Sim_Host_AbortTransfers();
+}
+
+void USB_Sim_Host_SuspendBus(void)
+{
+	USB_Sim_BusSuspended  = true;
+	USB_SIM_REG(UDINT)   |= (1 << SUSPI);
+}
+
+void USB_Sim_Host_ResumeBus(void)
+{
+	USB_Sim_BusSuspended  = false;
+	USB_SIM_REG(UDINT)   |= ((1 << WAKEUPI) | (1 << EORSMI));
+}
+
+bool USB_Sim_Host_QueueControlRequest(const void* Request, const void* OutData)
+{
+	if (USB_Sim_ControlQueueCount == USB_SIM_MAX_QUEUED_REQUESTS)
+	  return false;
+
+	USB_Sim_ControlTransfer_t* Transfer = &USB_Sim_ControlQueue[(USB_Sim_ControlQueueHead + USB_Sim_ControlQueueCount++) %
+	                                                             USB_SIM_MAX_QUEUED_REQUESTS];
+
+	memcpy(Transfer->Request, Request, sizeof(Transfer->Request));
+
+	Transfer->RequestLength = (Transfer->Request[6] | ((uint16_t)Transfer->Request[7] << 8));
+	Transfer->Position      = 0;
+	Transfer->InLength      = 0;
+	Transfer->Stage         = USB_SIM_STAGE_Setup;
+	Transfer->Status        = USB_SIM_CONTROL_Pending;
+	Transfer->StartFrame    = USB_Sim_FrameCount;
+
+	if (Transfer->RequestLength > USB_SIM_PEER_BUFFER_SIZE)
+	  Transfer->RequestLength = USB_SIM_PEER_BUFFER_SIZE;
+
+	if (!(Transfer->Request[0] & 0x80) && (OutData != NULL))
+	  memcpy(Transfer->Data, OutData, Transfer->RequestLength);
+	else if (!(Transfer->Request[0] & 0x80))
+	  memset(Transfer->Data, 0, Transfer->RequestLength);
+
+	return true;
+}
+
+uint8_t USB_Sim_Host_GetControlResult(void* InData, uint16_t* InLength)
+{
+	if (!(USB_Sim_ControlQueueCount))
+	  return USB_SIM_CONTROL_Aborted;
+
+	USB_Sim_ControlTransfer_t* Transfer = &USB_Sim_ControlQueue[USB_Sim_ControlQueueHead];
+
+	if (Transfer->Status == USB_SIM_CONTROL_Pending)
+	  return USB_SIM_CONTROL_Pending;
+
+	if (InLength != NULL)
+	{
+		if (*InLength > Transfer->InLength)
+		  *InLength = Transfer->InLength;
+
+		if (InData != NULL)
+		  memcpy(InData, Transfer->Data, *InLength);
+	}
+
+	USB_Sim_ControlQueueHead = ((USB_Sim_ControlQueueHead + 1) % USB_SIM_MAX_QUEUED_REQUESTS);
+	USB_Sim_ControlQueueCount--;
+
+	return Transfer->Status;
+}
+
+uint8_t USB_Sim_Host_ControlTransfer(const void* Request, void* Data, uint16_t* Length, void (*Task)(void))
+{
+	uint8_t ErrorCode;
+
+	if (!(USB_Sim_Host_QueueControlRequest(Request, Data)))
+	  return USB_SIM_CONTROL_Aborted;
+
+	while ((ErrorCode = USB_Sim_Host_GetControlResult(Data, Length)) == USB_SIM_CONTROL_Pending)
+	{
+		if (Task != NULL)
+		  Task();
+		else
+		  USB_Sim_Sync();
+	}
+
+	return ErrorCode;
+}
+
+void USB_Sim_Host_SetEndpointMode(const uint8_t EndpointNumber, const uint8_t Mode)
+{
+	if (EndpointNumber < USB_SIM_TOTAL_ENDPOINTS)
+	  USB_Sim_EndpointModes[EndpointNumber] = Mode;
+}
+
+uint16_t USB_Sim_Host_Write(const uint8_t EndpointNumber, const void* Data, const uint16_t Length)
+{
+	if (EndpointNumber >= USB_SIM_TOTAL_ENDPOINTS)
+	  return 0;
+
+	return USB_Sim_Ring_Write(&USB_Sim_OUTRings[EndpointNumber], Data, Length);
+}
+
+uint16_t USB_Sim_Host_Read(const uint8_t EndpointNumber, void* Data, const uint16_t MaxLength)
+{
+	if (EndpointNumber >= USB_SIM_TOTAL_ENDPOINTS)
+	  return 0;
+
+	return USB_Sim_Ring_Read(&USB_Sim_INRings[EndpointNumber], Data, MaxLength);
+}
+
+uint16_t USB_Sim_Host_BytesBuffered(const uint8_t EndpointNumber)
+{
+	if (EndpointNumber >= USB_SIM_TOTAL_ENDPOINTS)
+	  return 0;
+
+	return USB_Sim_INRings[EndpointNumber].Count;
+}
+
+static void USB_Sim_Host_AbortTransfers(void)
+{
+	for (uint8_t i = 0; i < USB_Sim_ControlQueueCount; i++)
+	{
+		USB_Sim_ControlTransfer_t* Transfer = &USB_Sim_ControlQueue[(USB_Sim_ControlQueueHead + i) % USB_SIM_MAX_QUEUED_REQUESTS];
+
+		if (Transfer->Status == USB_SIM_CONTROL_Pending)
+		  Transfer->Status = USB_SIM_CONTROL_Aborted;
+	}
+}
+
+static void USB_Sim_Host_Service(void)
+{
+	uint8_t USBCONValue = USB_SIM_REG(USBCON);
+
+	if (!(USB_Sim_HostAttached) || USB_Sim_BusSuspended || (USB_SIM_REG(UDCON) & (1 << DETACH)) ||
+	    !(USBCONValue & (1 << USBE)) || (USBCONValue & ((1 << FRZCLK) | (1 << HOST))))
+	{
+		return;
+	}
+
+	USB_Sim_Host_ServiceControl();
+
+	for (uint8_t EndpointNumber = 1; EndpointNumber < USB_SIM_TOTAL_ENDPOINTS; EndpointNumber++)
+	  USB_Sim_Host_ServiceEndpoint(EndpointNumber);
+}
+
+static void USB_Sim_Host_ServiceControl(void)
+{
+	USB_Sim_FIFO_t*            Endpoint = &USB_Sim_Endpoints[0];
+	USB_Sim_ControlTransfer_t* Transfer = NULL;
+	USB_Sim_Bank_t*            Bank;
+
+	for (uint8_t i = 0; i < USB_Sim_ControlQueueCount; i++)
+	{
+		Transfer = &USB_Sim_ControlQueue[(USB_Sim_ControlQueueHead + i) % USB_SIM_MAX_QUEUED_REQUESTS];
+
+		if (Transfer->Status == USB_SIM_CONTROL_Pending)
+		  break;
+
+		Transfer = NULL;
+	}
+
+	if ((Transfer == NULL) || !(Endpoint->Configured) || !(USB_SIM_IS_CONTROL(Endpoint)))
+	  return;
+
+	if ((USB_Sim_FrameCount - Transfer->StartFrame) > USB_Sim_Config.ControlTimeoutFrames)
+	{
+		Transfer->Status = USB_SIM_CONTROL_Timeout;
+		return;
+	}
+
+	if ((Transfer->Stage != USB_SIM_STAGE_Setup) && (Transfer->Stage != USB_SIM_STAGE_StatusOUTWait) &&
+	    (Endpoint->Control & (1 << STALLRQ)))
+	{
+		Endpoint->IntFlags |= (1 << STALLEDI);
+		Transfer->Status    = USB_SIM_CONTROL_Stalled;
+		return;
+	}
+
+	switch (Transfer->Stage)
+	{
+		case USB_SIM_STAGE_Setup:
+			Bank = &Endpoint->Banks[0];
+
+			memcpy(Bank->Data, Transfer->Request, sizeof(Transfer->Request));
+			Bank->Length       = sizeof(Transfer->Request);
+			Bank->Received     = true;
+			Endpoint->Head     = 0;
+			Endpoint->Filled   = 1;
+			Endpoint->Position = 0;
+			Endpoint->Control  &= ~(1 << STALLRQ);
+			Endpoint->IntFlags &= ~((1 << TXINI) | (1 << RXOUTI));
+			Endpoint->IntFlags |= (1 << RXSTPI);
+
+			USB_Sim_Statistics.SetupPackets++;
+
+			if (Transfer->Request[0] & 0x80)
+			  Transfer->Stage = (Transfer->RequestLength) ? USB_SIM_STAGE_DataIN : USB_SIM_STAGE_StatusOUT;
+			else
+			  Transfer->Stage = (Transfer->RequestLength) ? USB_SIM_STAGE_DataOUT : USB_SIM_STAGE_StatusIN;
+
+			break;
+		case USB_SIM_STAGE_DataOUT:
+			if (Endpoint->Filled)
+			  break;
+
+			uint16_t PacketLength = (Transfer->RequestLength - Transfer->Position);
+
+			if (PacketLength > Endpoint->Size)
+			  PacketLength = Endpoint->Size;
+
+			USB_Sim_FIFO_BusDeliver(Endpoint, &Transfer->Data[Transfer->Position], PacketLength);
+			Endpoint->Position  = 0;
+			Endpoint->IntFlags &= ~(1 << TXINI);
+			Endpoint->IntFlags |= (1 << RXOUTI);
+
+			USB_Sim_Statistics.PacketsOUT++;
+			USB_Sim_Statistics.BytesOUT += PacketLength;
+
+			Transfer->Position += PacketLength;
+
+			if (Transfer->Position == Transfer->RequestLength)
+			  Transfer->Stage = USB_SIM_STAGE_StatusIN;
+
+			break;
+		case USB_SIM_STAGE_DataIN:
+			if ((Bank = USB_Sim_FIFO_BusPeek(Endpoint)) == NULL)
+			  break;
+
+			uint16_t BytesToCopy = (Transfer->RequestLength - Transfer->InLength);
+
+			if (BytesToCopy > Bank->Length)
+			  BytesToCopy = Bank->Length;
+
+			memcpy(&Transfer->Data[Transfer->InLength], Bank->Data, BytesToCopy);
+			Transfer->InLength += BytesToCopy;
+
+			USB_Sim_Statistics.PacketsIN++;
+			USB_Sim_Statistics.BytesIN += Bank->Length;
+
+			if (Bank->Length < Endpoint->Size)
+			  USB_Sim_Statistics.ShortPacketsIN++;
+
+			if ((Bank->Length < Endpoint->Size) || (Transfer->InLength == Transfer->RequestLength))
+			  Transfer->Stage = USB_SIM_STAGE_StatusOUT;
+
+			USB_Sim_FIFO_BusPop(Endpoint);
+			break;
+		case USB_SIM_STAGE_StatusOUT:
+			if (USB_Sim_FIFO_BusPeek(Endpoint) != NULL)
+			  USB_Sim_FIFO_BusPop(Endpoint);
+
+			if (Endpoint->Filled)
+			  break;
+
+			USB_Sim_FIFO_BusDeliver(Endpoint, NULL, 0);
+			Endpoint->Position  = 0;
+			Endpoint->IntFlags &= ~(1 << TXINI);
+			Endpoint->IntFlags |= (1 << RXOUTI);
+
+			USB_Sim_Statistics.PacketsOUT++;
+
+			Transfer->Stage = USB_SIM_STAGE_StatusOUTWait;
+			break;
+		case USB_SIM_STAGE_StatusOUTWait:
+			if (!(Endpoint->Filled) || !(Endpoint->Banks[0].Received))
+			  Transfer->Status = USB_SIM_CONTROL_Complete;
+
+			break;
+		case USB_SIM_STAGE_StatusIN:
+			if ((Bank = USB_Sim_FIFO_BusPeek(Endpoint)) == NULL)
+			  break;
+
+			USB_Sim_Statistics.PacketsIN++;
+			USB_Sim_Statistics.BytesIN += Bank->Length;
+
+			USB_Sim_FIFO_BusPop(Endpoint);
+			Transfer->Status = USB_SIM_CONTROL_Complete;
+			break;
+	}
+}
+
+static void USB_Sim_Host_ServiceEndpoint(const uint8_t EndpointNumber)
+{
+	USB_Sim_FIFO_t* Endpoint = &USB_Sim_Endpoints[EndpointNumber];
+	USB_Sim_Bank_t* Bank;
+
+	if (!(Endpoint->Configured) || !(Endpoint->Control & (1 << EPEN)) || USB_SIM_IS_CONTROL(Endpoint))
+	  return;
+
+	if (Endpoint->Config0 & (1 << EPDIR))
+	{
+		uint8_t Mode = USB_Sim_EndpointModes[EndpointNumber];
+
+		if (Mode == USB_SIM_ENDPOINT_NAK)
+		  return;
+
+		if (Endpoint->Control & (1 << STALLRQ))
+		{
+			Endpoint->IntFlags |= (1 << STALLEDI);
+			return;
+		}
+
+		if ((Bank = USB_Sim_FIFO_BusPeek(Endpoint)) == NULL)
+		{
+			Endpoint->IntFlags |= (1 << NAKINI);
+			return;
+		}
+
+		if (Mode == USB_SIM_ENDPOINT_Buffer)
+		{
+			USB_Sim_Ring_t* Ring = &USB_Sim_INRings[EndpointNumber];
+
+			if ((USB_SIM_PEER_BUFFER_SIZE - Ring->Count) < Bank->Length)
+			  return;
+
+			USB_Sim_Ring_Write(Ring, Bank->Data, Bank->Length);
+		}
+
+		USB_Sim_Statistics.PacketsIN++;
+		USB_Sim_Statistics.BytesIN += Bank->Length;
+
+		if (Bank->Length < Endpoint->Size)
+		  USB_Sim_Statistics.ShortPacketsIN++;
+
+		USB_Sim_FIFO_BusPop(Endpoint);
+	}
+	else
+	{
+		USB_Sim_Ring_t* Ring = &USB_Sim_OUTRings[EndpointNumber];
+		uint8_t         Packet[USB_SIM_MAX_BANK_SIZE];
+
+		if (!(Ring->Count))
+		  return;
+
+		if (Endpoint->Control & (1 << STALLRQ))
+		{
+			Endpoint->IntFlags |= (1 << STALLEDI);
+			return;
+		}
+
+		if (Endpoint->Filled == Endpoint->TotalBanks)
+		{
+			Endpoint->IntFlags |= (1 << NAKOUTI);
+			return;
+		}
+
+		uint16_t PacketLength = USB_Sim_Ring_Read(Ring, Packet, Endpoint->Size);
+
+		USB_Sim_FIFO_BusDeliver(Endpoint, Packet, PacketLength);
+
+		USB_Sim_Statistics.PacketsOUT++;
+		USB_Sim_Statistics.BytesOUT += PacketLength;
+	}
+}
+
+void USB_Sim_Device_Attach(void)
+{
+	USB_Sim_DeviceAttached      = true;
+	USB_Sim_DeviceControl.Stage = USB_SIM_STAGE_Idle;
+
+	if (USB_SIM_IS_HOST_MODE())
+	{
+		USB_SIM_REG(OTGINT) |= (1 << SRPI);
+
+		if (USB_SIM_REG(OTGCON) & (1 << VBUSREQ))
+		  USB_SIM_REG(UHINT) |= (1 << DCONNI);
+	}
+
+	USB_Sim_Device_UpdateID();
+}
+
+void USB_Sim_Device_Detach(void)
+{
+	USB_Sim_DeviceAttached = false;
+
+	if (USB_SIM_IS_HOST_MODE())
+	  USB_SIM_REG(UHINT) |= (1 << DDISCI);
+
+	USB_Sim_Device_UpdateID();
+}
+
+void USB_Sim_Device_SetControlHandler(USB_Sim_ControlHandler_t Handler)
+{
+	USB_Sim_ControlHandler = Handler;
+}
+
+void USB_Sim_Device_SetStall(const uint8_t EndpointNumber, const bool Stalled)
+{
+	if (EndpointNumber >= USB_SIM_TOTAL_ENDPOINTS)
+	  return;
+
+	if (Stalled)
+	  USB_Sim_DeviceStalls |=  (1 << EndpointNumber);
+	else
+	  USB_Sim_DeviceStalls &= ~(1 << EndpointNumber);
+}
+
+uint16_t USB_Sim_Device_Write(const uint8_t EndpointNumber, const void* Data, const uint16_t Length)
+{
+	if (EndpointNumber >= USB_SIM_TOTAL_ENDPOINTS)
+	  return 0;
+
+	return USB_Sim_Ring_Write(&USB_Sim_INRings[EndpointNumber], Data, Length);
+}
+
+uint16_t USB_Sim_Device_Read(const uint8_t EndpointNumber, void* Data, const uint16_t MaxLength)
+{
+	if (EndpointNumber >= USB_SIM_TOTAL_ENDPOINTS)
+	  return 0;
+
+	return USB_Sim_Ring_Read(&USB_Sim_OUTRings[EndpointNumber], Data, MaxLength);
+}
+
+static void USB_Sim_Device_UpdateID(void)
+{
+	static bool PreviousID = true;
+	bool        CurrentID  = !(USB_Sim_DeviceAttached);
+
+	if (CurrentID != PreviousID)
+	  USB_SIM_REG(USBINT) |= (1 << IDTI);
+
+	PreviousID = CurrentID;
+}
+
+static void USB_Sim_Device_Service(void)
+{
+	uint8_t USBCONValue = USB_SIM_REG(USBCON);
+
+	if (!(USB_Sim_DeviceAttached) || !(USB_SIM_REG(UHCON) & (1 << SOFEN)) ||
+	    !(USBCONValue & (1 << USBE)) || (USBCONValue & (1 << FRZCLK)) || !(USBCONValue & (1 << HOST)))
+	{
+		return;
+	}
+
+	for (uint8_t PipeNumber = 0; PipeNumber < USB_SIM_TOTAL_ENDPOINTS; PipeNumber++)
+	  USB_Sim_Device_ServicePipe(PipeNumber);
+}
+
+static void USB_Sim_Device_ServicePipe(const uint8_t PipeNumber)
+{
+	USB_Sim_FIFO_t* Pipe           = &USB_Sim_Pipes[PipeNumber];
+	uint8_t         EndpointNumber = (Pipe->Config0 & 0x0F);
+	bool            IsControl      = USB_SIM_IS_CONTROL(Pipe);
+	uint8_t         Handshake      = USB_SIM_HANDSHAKE_NAK;
+	USB_Sim_Bank_t* Bank;
+
+	if (!(Pipe->Configured) || !(Pipe->Control & (1 << PEN)) || (Pipe->Control & (1 << PFREEZE)) ||
+	    (EndpointNumber >= USB_SIM_TOTAL_ENDPOINTS))
+	{
+		return;
+	}
+
+	bool Stalled = ((USB_Sim_DeviceStalls & (1 << EndpointNumber)) ? true : false);
+
+	switch (USB_SIM_PIPE_TOKEN(Pipe))
+	{
+		case USB_SIM_TOKEN_SETUP:
+			if ((Bank = USB_Sim_FIFO_BusPeek(Pipe)) == NULL)
+			  return;
+
+			USB_Sim_Device_ControlSetup(Bank->Data);
+			USB_Sim_Statistics.SetupPackets++;
+
+			Handshake = USB_SIM_HANDSHAKE_ACK;
+			USB_Sim_FIFO_BusPop(Pipe);
+			break;
+		case USB_SIM_TOKEN_OUT:
+			if ((Bank = USB_Sim_FIFO_BusPeek(Pipe)) == NULL)
+			  return;
+
+			if (IsControl)
+			{
+				Handshake = USB_Sim_Device_ControlOUT(Bank->Data, Bank->Length);
+			}
+			else if (Stalled)
+			{
+				Handshake = USB_SIM_HANDSHAKE_STALL;
+			}
+			else if ((USB_SIM_PEER_BUFFER_SIZE - USB_Sim_OUTRings[EndpointNumber].Count) >= Bank->Length)
+			{
+				USB_Sim_Ring_Write(&USB_Sim_OUTRings[EndpointNumber], Bank->Data, Bank->Length);
+				Handshake = USB_SIM_HANDSHAKE_ACK;
+			}
+
+			if (Handshake == USB_SIM_HANDSHAKE_ACK)
+			{
+				USB_Sim_Statistics.PacketsOUT++;
+				USB_Sim_Statistics.BytesOUT += Bank->Length;
+
+				USB_Sim_FIFO_BusPop(Pipe);
+			}
+
+			break;
+		case USB_SIM_TOKEN_IN:
+			if ((Pipe->Filled == Pipe->TotalBanks) || (!(Pipe->Control & (1 << INMODE)) && !(Pipe->INRequests)))
+			  return;
+
+			uint8_t  Packet[USB_SIM_MAX_BANK_SIZE];
+			uint16_t PacketLength = 0;
+
+			if (IsControl)
+			{
+				Handshake = USB_Sim_Device_ControlIN(Packet, Pipe->Size, &PacketLength);
+			}
+			else if (Stalled)
+			{
+				Handshake = USB_SIM_HANDSHAKE_STALL;
+			}
+			else if (USB_Sim_INRings[EndpointNumber].Count)
+			{
+				PacketLength = USB_Sim_Ring_Read(&USB_Sim_INRings[EndpointNumber], Packet, Pipe->Size);
+				Handshake    = USB_SIM_HANDSHAKE_ACK;
+			}
+
+			if (Handshake == USB_SIM_HANDSHAKE_ACK)
+			{
+				USB_Sim_FIFO_BusDeliver(Pipe, Packet, PacketLength);
+
+				if (!(Pipe->Control & (1 << INMODE)))
+				  Pipe->INRequests--;
+
+				USB_Sim_Statistics.PacketsIN++;
+				USB_Sim_Statistics.BytesIN += PacketLength;
+
+				if (PacketLength < Pipe->Size)
+				  USB_Sim_Statistics.ShortPacketsIN++;
+			}
+
+			break;
+		default:
+			return;
+	}
+
+	if (Handshake == USB_SIM_HANDSHAKE_NAK)
+	  Pipe->IntFlags |= (1 << NAKEDI);
+	else if (Handshake == USB_SIM_HANDSHAKE_STALL)
+	  Pipe->IntFlags |= (1 << RXSTALLI);
+}
+
+static void USB_Sim_Device_ControlSetup(const uint8_t* Data)
+{
+	USB_Sim_ControlTransfer_t* Transfer = &USB_Sim_DeviceControl;
+
+	memcpy(Transfer->Request, Data, sizeof(Transfer->Request));
+
+	Transfer->RequestLength = (Transfer->Request[6] | ((uint16_t)Transfer->Request[7] << 8));
+	Transfer->Position      = 0;
+	Transfer->InLength      = 0;
+
+	if (Transfer->RequestLength > USB_SIM_PEER_BUFFER_SIZE)
+	  Transfer->RequestLength = USB_SIM_PEER_BUFFER_SIZE;
+
+	if (Transfer->Request[0] & 0x80)
+	{
+		int16_t InLength = (USB_Sim_ControlHandler != NULL) ?
+		                   USB_Sim_ControlHandler(Transfer->Request, NULL, 0, Transfer->Data) : -1;
+
+		if (InLength < 0)
+		{
+			Transfer->Stage = USB_SIM_STAGE_Stalled;
+			return;
+		}
+
+		Transfer->InLength = ((uint16_t)InLength < Transfer->RequestLength) ? InLength : Transfer->RequestLength;
+		Transfer->Stage    = USB_SIM_STAGE_DataIN;
+	}
+	else
+	{
+		Transfer->Stage = (Transfer->RequestLength) ? USB_SIM_STAGE_DataOUT : USB_SIM_STAGE_StatusIN;
+	}
+}
+
+static uint8_t USB_Sim_Device_ControlIN(uint8_t* Data, const uint16_t MaxLength, uint16_t* const Length)
+{
+	USB_Sim_ControlTransfer_t* Transfer = &USB_Sim_DeviceControl;
+
+	switch (Transfer->Stage)
+	{
+		case USB_SIM_STAGE_DataIN:
+			*Length = (Transfer->InLength - Transfer->Position);
+
+			if (*Length > MaxLength)
+			  *Length = MaxLength;
+
+			memcpy(Data, &Transfer->Data[Transfer->Position], *Length);
+			Transfer->Position += *Length;
+
+			return USB_SIM_HANDSHAKE_ACK;
+		case USB_SIM_STAGE_DataOUT:
+		case USB_SIM_STAGE_StatusIN:
+			if ((USB_Sim_ControlHandler == NULL) ||
+			    (USB_Sim_ControlHandler(Transfer->Request, Transfer->Data, Transfer->Position, USB_Sim_DeviceScratch) < 0))
+			{
+				Transfer->Stage = USB_SIM_STAGE_Stalled;
+				return USB_SIM_HANDSHAKE_STALL;
+			}
+
+			*Length         = 0;
+			Transfer->Stage = USB_SIM_STAGE_Idle;
+			return USB_SIM_HANDSHAKE_ACK;
+		case USB_SIM_STAGE_Stalled:
+			return USB_SIM_HANDSHAKE_STALL;
+		default:
+			return USB_SIM_HANDSHAKE_NAK;
+	}
+}
+
+static uint8_t USB_Sim_Device_ControlOUT(const uint8_t* Data, const uint16_t Length)
+{
+	USB_Sim_ControlTransfer_t* Transfer = &USB_Sim_DeviceControl;
+
+	switch (Transfer->Stage)
+	{
+		case USB_SIM_STAGE_DataOUT:
+		{
+			uint16_t BytesToCopy = (Transfer->RequestLength - Transfer->Position);
+
+			if (BytesToCopy > Length)
+			  BytesToCopy = Length;
+
+			memcpy(&Transfer->Data[Transfer->Position], Data, BytesToCopy);
+			Transfer->Position += BytesToCopy;
+
+			if (Transfer->Position == Transfer->RequestLength)
+			  Transfer->Stage = USB_SIM_STAGE_StatusIN;
+
+			return USB_SIM_HANDSHAKE_ACK;
+		}
+		case USB_SIM_STAGE_DataIN:
+			Transfer->Stage = USB_SIM_STAGE_Idle;
+			return USB_SIM_HANDSHAKE_ACK;
+		case USB_SIM_STAGE_Stalled:
+			return USB_SIM_HANDSHAKE_STALL;
+		default:
+			return USB_SIM_HANDSHAKE_ACK;
+	}
+}
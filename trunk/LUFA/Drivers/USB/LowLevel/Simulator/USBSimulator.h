@@ -0,0 +1,554 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \ingroup Group_USB
+ *  @defgroup Group_USBSimulator Simulated USB Controller
+ *
+ *  Host-native simulation of the USB AVR USB controller register set, allowing the unmodified LowLevel, HighLevel
+ *  and Class driver sources to be compiled and run on a PC for throughput and enumeration benchmarking. The simulator
+ *  is selected by adding this folder to the front of the compiler's include search path, so that the AVR system
+ *  headers (avr/io.h, avr/pgmspace.h, avr/eeprom.h, avr/interrupt.h, avr/sleep.h, avr/boot.h and util/delay.h) are
+ *  replaced with host compatible versions which route each USB controller register access through the simulated
+ *  controller:
+ *
+ *  \code
+ *  gcc -std=gnu99 -fpack-struct -I LUFA/Drivers/USB/LowLevel/Simulator -D__AVR_AT90USB1287__ -DF_CLOCK=16000000UL \
+ *      -DUSB_DEVICE_ONLY LUFA/Drivers/USB/LowLevel/Simulator/USBSimulator.c {LUFA and application sources}
+ *  \endcode
+ *
+ *  The -fpack-struct option is required so that the layout of the USB descriptor and class structures matches that of
+ *  the AVR target, which has no alignment padding. The avr-libc FILE stream functions of the class drivers compile
+ *  against the simulator, but are not functional.
+ *
+ *  The simulated controller implements the endpoint and pipe bank FIFOs (with configurable maximum bank sizes and
+ *  double banking support for each endpoint or pipe), the interrupt flag registers and the USB_GEN_vect and
+ *  USB_COM_vect interrupts. A scriptable peer is attached to the other end of the simulated bus - a host peer when
+ *  the library is in device mode, or a device peer when the library is in host mode. Bus time is measured in
+ *  register accesses, with a new USB frame started every \ref USB_Sim_Config_t::AccessesPerFrame register accesses
+ *  or when a delay function is called.
+ *
+ *  The SPI and USART1 control, status and data registers are also provided, so that code which forwards data between
+ *  the USB controller and these peripherals can be compiled against the simulator. These peripherals always report
+ *  themselves as ready to transmit and receive, and the data passing through them is not modelled. The 16-bit Timer 1
+ *  counter is modelled as running at F_CPU/64 against simulated bus time whenever a clock source is selected in TCCR1B,
+ *  so that timestamps taken from TCNT1 advance consistently with the simulated USB frames, along with its OCR1A compare
+ *  match flag and TIMER1_COMPA_vect interrupt. Entering a sleep mode via the host avr/sleep.h replacement header advances
+ *  the bus time until an interrupt is serviced.
+ *
+ *  \note This module is for PC based testing and benchmarking only, and cannot be used on an AVR target.
+ *
+ *  @{
+ */
+
+#ifndef __USBSIMULATOR_H__
+#define __USBSIMULATOR_H__
+
+	/* Includes: */
+		#include <stdint.h>
+		#include <stdbool.h>
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Total number of endpoints and pipes implemented by the simulated USB controller. */
+			#define USB_SIM_TOTAL_ENDPOINTS         7
+
+			/** Largest bank size in bytes which may be configured for a simulated endpoint or pipe. */
+			#define USB_SIM_MAX_BANK_SIZE           256
+
+			/** Size in bytes of each of the peer's per-endpoint data buffers. */
+			#define USB_SIM_PEER_BUFFER_SIZE        4096
+
+			/** Maximum number of control requests which may be queued in the host peer at the one time. */
+			#define USB_SIM_MAX_QUEUED_REQUESTS     8
+
+			/** Maximum number of USB frames the simulated CPU may sleep for without being woken by an interrupt. */
+			#define USB_SIM_MAX_SLEEP_FRAMES        1000
+
+		/* Enums: */
+			/** Enum for the possible handling modes of a non-control endpoint by the simulated host peer,
+			 *  set via \ref USB_Sim_Host_SetEndpointMode().
+			 */
+			enum USB_Sim_EndpointModes_t
+			{
+				USB_SIM_ENDPOINT_Buffer         = 0, /**< IN packets are stored in the peer's endpoint buffer, and
+				                                      *   NAKed once the buffer is full.
+				                                      */
+				USB_SIM_ENDPOINT_Discard        = 1, /**< IN packets are accepted and counted, but their contents
+				                                      *   discarded. Used for throughput measurements.
+				                                      */
+				USB_SIM_ENDPOINT_NAK            = 2, /**< All IN tokens to the endpoint are NAKed, simulating a host
+				                                      *   which is not currently reading from the endpoint.
+				                                      */
+			};
+
+			/** Enum for the possible states of a control transfer issued by the simulated host peer. */
+			enum USB_Sim_ControlStatus_t
+			{
+				USB_SIM_CONTROL_Complete        = 0, /**< Control transfer completed successfully. */
+				USB_SIM_CONTROL_Stalled         = 1, /**< Device stalled the control transfer. */
+				USB_SIM_CONTROL_Pending         = 2, /**< Control transfer is queued or still in progress. */
+				USB_SIM_CONTROL_Aborted         = 3, /**< Control transfer was aborted by a bus reset or detach. */
+				USB_SIM_CONTROL_Timeout         = 4, /**< Control transfer did not complete within the allowed number
+				                                      *   of frames.
+				                                      */
+			};
+
+		/* Type Defines: */
+			/** Type define for a control request handler in the simulated device peer, used when the library is
+			 *  running in host mode. The handler is called once the complete request (including any OUT data stage)
+			 *  has been received, and should fill out the IN data buffer for device-to-host requests.
+			 *
+			 *  \param[in]  Request    Pointer to the 8 byte SETUP packet issued by the host
+			 *  \param[in]  OutData    Pointer to the received OUT data stage, if any
+			 *  \param[in]  OutLength  Length of the received OUT data stage
+			 *  \param[out] InData     Buffer of \ref USB_SIM_PEER_BUFFER_SIZE bytes where IN data stage data is to be stored
+			 *
+			 *  \return Length of the IN data stage, or a negative value to STALL the request
+			 */
+			typedef int16_t (*USB_Sim_ControlHandler_t)(const uint8_t* Request, const uint8_t* OutData,
+			                                             const uint16_t OutLength, uint8_t* InData);
+
+			/** Type define for the simulated USB controller configuration. The configuration is applied on each call
+			 *  to \ref USB_Sim_Reset(), and defaults to the limits of the real USB AVR model selected at compile time.
+			 */
+			typedef struct
+			{
+				uint16_t EndpointMaxBankSize[USB_SIM_TOTAL_ENDPOINTS]; /**< Maximum bank size of each endpoint, in bytes. */
+				bool     EndpointDoubleBank[USB_SIM_TOTAL_ENDPOINTS]; /**< Indicates if each endpoint supports double banking. */
+				uint16_t PipeMaxBankSize[USB_SIM_TOTAL_ENDPOINTS]; /**< Maximum bank size of each pipe, in bytes. */
+				bool     PipeDoubleBank[USB_SIM_TOTAL_ENDPOINTS]; /**< Indicates if each pipe supports double banking. */
+				uint16_t AccessesPerFrame; /**< Number of USB controller register accesses per simulated 1ms USB frame. */
+				uint16_t ControlTimeoutFrames; /**< Number of frames after which a host peer control transfer times out. */
+				uint8_t  SignatureRow[32]; /**< Contents of the AVR signature row, read via boot_signature_byte_get(). */
+			} USB_Sim_Config_t;
+
+			/** Type define for the statistics gathered by the simulated USB controller, for benchmarking. All counters
+			 *  are cleared by \ref USB_Sim_Reset() and \ref USB_Sim_ClearStatistics().
+			 */
+			typedef struct
+			{
+				uint32_t RegisterAccesses; /**< Total number of USB controller register accesses. */
+				uint32_t DataAccesses; /**< Number of endpoint or pipe FIFO data register accesses. */
+				uint32_t Frames; /**< Number of elapsed USB frames. */
+				uint32_t Interrupts; /**< Number of USB_GEN_vect, USB_COM_vect and TIMER1_COMPA_vect interrupts serviced. */
+				uint32_t SetupPackets; /**< Number of SETUP packets transferred. */
+				uint32_t PacketsIN; /**< Number of IN direction packets transferred, including control packets. */
+				uint32_t PacketsOUT; /**< Number of OUT direction packets transferred, including control packets. */
+				uint32_t BytesIN; /**< Number of bytes transferred in IN direction packets. */
+				uint32_t BytesOUT; /**< Number of bytes transferred in OUT direction packets. */
+				uint32_t ShortPacketsIN; /**< Number of IN direction packets smaller than the endpoint or pipe bank. */
+				uint32_t SignatureReads; /**< Number of AVR signature row bytes read via boot_signature_byte_get(). */
+				uint32_t SleepAccesses; /**< Bus time spent in a sleep mode, in register access periods. */
+			} USB_Sim_Statistics_t;
+
+		/* Global Variables: */
+			/** Configuration of the simulated USB controller, applied on the next call to \ref USB_Sim_Reset(). */
+			extern USB_Sim_Config_t     USB_Sim_Config;
+
+			/** Statistics gathered by the simulated USB controller since the last reset. */
+			extern USB_Sim_Statistics_t USB_Sim_Statistics;
+
+		/* Function Prototypes: */
+			/** Resets the simulated USB controller and both bus peers to their power-on state, applying the current
+			 *  \ref USB_Sim_Config settings. This should be called before the simulated controller is first used.
+			 */
+			void USB_Sim_Reset(void);
+
+			/** Clears the simulated controller's statistics counters, without altering the controller state. */
+			void USB_Sim_ClearStatistics(void);
+
+			/** Commits any pending register writes and services the attached bus peer. This should be called
+			 *  by test code before inspecting the peer state, if the library may have written to a register as
+			 *  its last action.
+			 */
+			void USB_Sim_Sync(void);
+
+			/** Advances the simulated bus time by the given number of USB frames.
+			 *
+			 *  \param[in] Frames  Number of 1ms USB frames to advance by
+			 */
+			void USB_Sim_AdvanceFrames(uint16_t Frames);
+
+			/** Advances the simulated bus time by the given number of microseconds. This is used to implement
+			 *  the _delay_us() and _delay_ms() functions of the host util/delay.h replacement header.
+			 *
+			 *  \param[in] Microseconds  Number of microseconds to advance by
+			 */
+			void USB_Sim_DelayMicroseconds(uint32_t Microseconds);
+
+			/** Advances the simulated bus time until an enabled interrupt has been serviced, if the sleep enable bit
+			 *  is set in SMCR. This is used to implement the sleep_cpu() function of the host avr/sleep.h replacement
+			 *  header. As on the AVR, the CPU will not wake if global interrupts are disabled; to prevent an endless
+			 *  loop the simulator instead returns after \ref USB_SIM_MAX_SLEEP_FRAMES frames.
+			 */
+			void USB_Sim_Sleep(void);
+
+			/** Attaches the simulated host peer to the bus, raising a VBUS transition to the device. */
+			void USB_Sim_Host_Attach(void);
+
+			/** Detaches the simulated host peer from the bus, aborting any in-progress control transfer. */
+			void USB_Sim_Host_Detach(void);
+
+			/** Issues a USB bus reset to the device from the simulated host peer. */
+			void USB_Sim_Host_ResetBus(void);
+
+			/** Suspends the bus from the simulated host peer, halting USB frames. */
+			void USB_Sim_Host_SuspendBus(void);
+
+			/** Resumes a previously suspended bus from the simulated host peer. */
+			void USB_Sim_Host_ResumeBus(void);
+
+			/** Queues a control request to be issued by the simulated host peer to the device's control endpoint.
+			 *
+			 *  \param[in] Request    Pointer to the 8 byte SETUP packet to send
+			 *  \param[in] OutData    Pointer to the OUT data stage contents for host-to-device requests, or NULL
+			 *
+			 *  \return Boolean true if the request was queued, false if the request queue is full
+			 */
+			bool USB_Sim_Host_QueueControlRequest(const void* Request, const void* OutData);
+
+			/** Retrieves the result of the oldest queued control request, once it has completed. If the request has
+			 *  completed, it is removed from the queue.
+			 *
+			 *  \param[out]    InData    Buffer where the received IN data stage contents are to be stored, or NULL
+			 *  \param[in,out] InLength  Size of the InData buffer on entry, number of bytes received on exit, or NULL
+			 *
+			 *  \return A value from the \ref USB_Sim_ControlStatus_t enum, or \ref USB_SIM_CONTROL_Aborted if no request is queued
+			 */
+			uint8_t USB_Sim_Host_GetControlResult(void* InData, uint16_t* InLength);
+
+			/** Issues a control request from the simulated host peer and waits for it to complete, repeatedly calling
+			 *  the given task function (typically \ref USB_USBTask()) while the request is in progress. The results of
+			 *  any previously queued requests must have been retrieved before this function is called.
+			 *
+			 *  \param[in]     Request   Pointer to the 8 byte SETUP packet to send
+			 *  \param[in,out] Data      Pointer to the OUT data stage contents or IN data stage buffer, or NULL
+			 *  \param[in,out] Length    Size of the IN data buffer on entry, bytes received on exit, or NULL
+			 *  \param[in]     Task      Task function to run while waiting, or NULL if the control endpoint is interrupt driven
+			 *
+			 *  \return A value from the \ref USB_Sim_ControlStatus_t enum
+			 */
+			uint8_t USB_Sim_Host_ControlTransfer(const void* Request, void* Data, uint16_t* Length, void (*Task)(void));
+
+			/** Sets the simulated host peer's handling mode for the given non-control device endpoint.
+			 *
+			 *  \param[in] EndpointNumber  Device endpoint number to alter
+			 *  \param[in] Mode            New endpoint mode, a value from the \ref USB_Sim_EndpointModes_t enum
+			 */
+			void USB_Sim_Host_SetEndpointMode(const uint8_t EndpointNumber, const uint8_t Mode);
+
+			/** Queues data in the simulated host peer to be sent to the given OUT endpoint of the device. The data is
+			 *  split into packets of the endpoint's bank size as the device frees its endpoint banks.
+			 *
+			 *  \param[in] EndpointNumber  Device endpoint number to send to
+			 *  \param[in] Data            Pointer to the data to send
+			 *  \param[in] Length          Number of bytes to send
+			 *
+			 *  \return Number of bytes queued, which may be less than Length if the peer's buffer is full
+			 */
+			uint16_t USB_Sim_Host_Write(const uint8_t EndpointNumber, const void* Data, const uint16_t Length);
+
+			/** Retrieves data received by the simulated host peer from the given IN endpoint of the device.
+			 *
+			 *  \param[in]  EndpointNumber  Device endpoint number to read from
+			 *  \param[out] Data            Buffer where the received data is to be stored
+			 *  \param[in]  MaxLength       Size of the buffer in bytes
+			 *
+			 *  \return Number of bytes read from the peer's buffer
+			 */
+			uint16_t USB_Sim_Host_Read(const uint8_t EndpointNumber, void* Data, const uint16_t MaxLength);
+
+			/** Retrieves the number of bytes waiting in the simulated host peer's buffer for the given endpoint.
+			 *
+			 *  \param[in] EndpointNumber  Device endpoint number to check
+			 *
+			 *  \return Number of bytes buffered for the endpoint
+			 */
+			uint16_t USB_Sim_Host_BytesBuffered(const uint8_t EndpointNumber);
+
+			/** Attaches the simulated device peer to the bus, when the library is running in USB host mode. */
+			void USB_Sim_Device_Attach(void);
+
+			/** Detaches the simulated device peer from the bus, when the library is running in USB host mode. */
+			void USB_Sim_Device_Detach(void);
+
+			/** Sets the control request handler of the simulated device peer.
+			 *
+			 *  \param[in] Handler  Control request handler routine, or NULL to STALL all control requests
+			 */
+			void USB_Sim_Device_SetControlHandler(USB_Sim_ControlHandler_t Handler);
+
+			/** Sets or clears the STALL condition of the given endpoint of the simulated device peer.
+			 *
+			 *  \param[in] EndpointNumber  Endpoint number of the device peer to alter
+			 *  \param[in] Stalled         Boolean true to stall the endpoint, false to clear the stall
+			 */
+			void USB_Sim_Device_SetStall(const uint8_t EndpointNumber, const bool Stalled);
+
+			/** Queues data in the simulated device peer to be returned to IN pipes bound to the given endpoint.
+			 *
+			 *  \param[in] EndpointNumber  Endpoint number of the device peer
+			 *  \param[in] Data            Pointer to the data to send
+			 *  \param[in] Length          Number of bytes to send
+			 *
+			 *  \return Number of bytes queued, which may be less than Length if the peer's buffer is full
+			 */
+			uint16_t USB_Sim_Device_Write(const uint8_t EndpointNumber, const void* Data, const uint16_t Length);
+
+			/** Retrieves data received by the simulated device peer from OUT pipes bound to the given endpoint.
+			 *
+			 *  \param[in]  EndpointNumber  Endpoint number of the device peer
+			 *  \param[out] Data            Buffer where the received data is to be stored
+			 *  \param[in]  MaxLength       Size of the buffer in bytes
+			 *
+			 *  \return Number of bytes read from the peer's buffer
+			 */
+			uint16_t USB_Sim_Device_Read(const uint8_t EndpointNumber, void* Data, const uint16_t MaxLength);
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Enums: */
+			enum USB_Sim_Registers_t
+			{
+				USB_SIM_REG_USBCON,
+				USB_SIM_REG_USBSTA,
+				USB_SIM_REG_USBINT,
+				USB_SIM_REG_UHWCON,
+				USB_SIM_REG_OTGCON,
+				USB_SIM_REG_OTGIEN,
+				USB_SIM_REG_OTGINT,
+				USB_SIM_REG_PLLCSR,
+				USB_SIM_REG_PLLFRQ,
+				USB_SIM_REG_REGCR,
+				USB_SIM_REG_UDCON,
+				USB_SIM_REG_UDINT,
+				USB_SIM_REG_UDIEN,
+				USB_SIM_REG_UDADDR,
+				USB_SIM_REG_UDFNUML,
+				USB_SIM_REG_UDFNUMH,
+				USB_SIM_REG_UDMFN,
+				USB_SIM_REG_UENUM,
+				USB_SIM_REG_UERST,
+				USB_SIM_REG_UEINT,
+				USB_SIM_REG_UHCON,
+				USB_SIM_REG_UHINT,
+				USB_SIM_REG_UHIEN,
+				USB_SIM_REG_UHADDR,
+				USB_SIM_REG_UHFNUML,
+				USB_SIM_REG_UHFNUMH,
+				USB_SIM_REG_UHFLEN,
+				USB_SIM_REG_UPNUM,
+				USB_SIM_REG_UPRST,
+				USB_SIM_REG_UPINT,
+				USB_SIM_REG_DDRE,
+				USB_SIM_REG_PORTE,
+				USB_SIM_REG_SREG,
+				USB_SIM_REG_SPCR,
+				USB_SIM_REG_SPSR,
+				USB_SIM_REG_SPDR,
+				USB_SIM_REG_UCSR1A,
+				USB_SIM_REG_UCSR1B,
+				USB_SIM_REG_UCSR1C,
+				USB_SIM_REG_UDR1,
+				USB_SIM_REG_TCCR1A,
+				USB_SIM_REG_TCCR1B,
+				USB_SIM_REG_TIMSK1,
+				USB_SIM_REG_TIFR1,
+				USB_SIM_REG_SMCR,
+
+				USB_SIM_REG_UEINTX,
+				USB_SIM_REG_UECONX,
+				USB_SIM_REG_UECFG0X,
+				USB_SIM_REG_UECFG1X,
+				USB_SIM_REG_UESTA0X,
+				USB_SIM_REG_UESTA1X,
+				USB_SIM_REG_UEIENX,
+				USB_SIM_REG_UEDATX,
+				USB_SIM_REG_UEBCLX,
+				USB_SIM_REG_UEBCHX,
+
+				USB_SIM_REG_UPINRQX,
+				USB_SIM_REG_UPINTX,
+				USB_SIM_REG_UPCONX,
+				USB_SIM_REG_UPCFG0X,
+				USB_SIM_REG_UPCFG1X,
+				USB_SIM_REG_UPCFG2X,
+				USB_SIM_REG_UPSTAX,
+				USB_SIM_REG_UPIENX,
+				USB_SIM_REG_UPERRX,
+				USB_SIM_REG_UPDATX,
+				USB_SIM_REG_UPBCLX,
+				USB_SIM_REG_UPBCHX,
+
+				USB_SIM_REG_UEBCX,
+				USB_SIM_REG_UPBCX,
+				USB_SIM_REG_UDFNUM,
+				USB_SIM_REG_UHFNUM,
+				USB_SIM_REG_TCNT1,
+				USB_SIM_REG_OCR1A,
+
+				USB_SIM_TOTAL_REGISTERS
+			};
+
+			#if defined(__INCLUDE_FROM_USBSIMULATOR_C)
+			enum USB_Sim_ControlStages_t
+			{
+				USB_SIM_STAGE_Setup,
+				USB_SIM_STAGE_DataIN,
+				USB_SIM_STAGE_DataOUT,
+				USB_SIM_STAGE_StatusIN,
+				USB_SIM_STAGE_StatusOUT,
+				USB_SIM_STAGE_StatusOUTWait,
+				USB_SIM_STAGE_Idle,
+				USB_SIM_STAGE_Stalled,
+			};
+
+			enum USB_Sim_Handshakes_t
+			{
+				USB_SIM_HANDSHAKE_ACK,
+				USB_SIM_HANDSHAKE_NAK,
+				USB_SIM_HANDSHAKE_STALL,
+			};
+
+			enum USB_Sim_CPUAccess_t
+			{
+				USB_SIM_ACCESS_None,
+				USB_SIM_ACCESS_Read,
+				USB_SIM_ACCESS_Write,
+			};
+			#endif
+
+		/* Type Defines: */
+			#if defined(__INCLUDE_FROM_USBSIMULATOR_C)
+			typedef struct
+			{
+				uint8_t  Data[USB_SIM_MAX_BANK_SIZE];
+				uint16_t Length;
+				bool     Received;
+			} USB_Sim_Bank_t;
+
+			typedef struct
+			{
+				USB_Sim_Bank_t Banks[2];
+				bool           IsPipe;
+				uint16_t       MaxBankSize;
+				bool           DoubleBank;
+				bool           Configured;
+				uint16_t       Size;
+				uint8_t        TotalBanks;
+				uint8_t        Head;
+				uint8_t        Filled;
+				uint16_t       Position;
+				uint8_t        IntFlags;
+				uint8_t        IntEnable;
+				uint8_t        Control;
+				uint8_t        Config0;
+				uint8_t        Config1;
+				uint8_t        Config2;
+				uint8_t        INRequests;
+				uint8_t        Errors;
+			} USB_Sim_FIFO_t;
+
+			typedef struct
+			{
+				uint8_t  Data[USB_SIM_PEER_BUFFER_SIZE];
+				uint16_t Head;
+				uint16_t Count;
+			} USB_Sim_Ring_t;
+
+			typedef struct
+			{
+				uint8_t  Request[8];
+				uint8_t  Data[USB_SIM_PEER_BUFFER_SIZE];
+				uint16_t RequestLength;
+				uint16_t Position;
+				uint16_t InLength;
+				uint8_t  Stage;
+				uint8_t  Status;
+				uint32_t StartFrame;
+			} USB_Sim_ControlTransfer_t;
+			#endif
+
+		/* Function Prototypes: */
+			volatile uint8_t*  USB_Sim_Register(const uint8_t Register);
+			volatile uint16_t* USB_Sim_Register16(const uint8_t Register);
+			void               USB_Sim_SetInterruptsEnabled(const bool Enabled);
+
+			#if defined(__INCLUDE_FROM_USBSIMULATOR_C)
+				static void     USB_Sim_Step(void);
+				static void     USB_Sim_CommitWrites(void);
+				static void     USB_Sim_StartFrame(void);
+				static void     USB_Sim_DispatchInterrupts(void);
+				static uint16_t USB_Sim_Timer1_GetCount(void);
+				static void     USB_Sim_Timer1_Update(void);
+				static uint8_t  USB_Sim_ReadRegister(const uint8_t Register, const uint8_t Index);
+				static void     USB_Sim_WriteRegister(const uint8_t Register, const uint8_t Index,
+				                                      const uint8_t OldValue, const uint8_t NewValue);
+				static void     USB_Sim_ResetController(void);
+
+				static uint8_t  USB_Sim_FIFO_CPUAccess(USB_Sim_FIFO_t* const FIFO, USB_Sim_Bank_t** const Bank);
+				static void     USB_Sim_FIFO_SignalCPUBank(USB_Sim_FIFO_t* const FIFO);
+				static void     USB_Sim_FIFO_CPURelease(USB_Sim_FIFO_t* const FIFO);
+				static void     USB_Sim_FIFO_Configure(USB_Sim_FIFO_t* const FIFO);
+				static void     USB_Sim_FIFO_Reset(USB_Sim_FIFO_t* const FIFO);
+				static USB_Sim_Bank_t* USB_Sim_FIFO_BusPeek(USB_Sim_FIFO_t* const FIFO);
+				static void     USB_Sim_FIFO_BusPop(USB_Sim_FIFO_t* const FIFO);
+				static bool     USB_Sim_FIFO_BusDeliver(USB_Sim_FIFO_t* const FIFO, const uint8_t* Data, const uint16_t Length);
+
+				static uint16_t USB_Sim_Ring_Write(USB_Sim_Ring_t* const Ring, const uint8_t* Data, const uint16_t Length);
+				static uint16_t USB_Sim_Ring_Read(USB_Sim_Ring_t* const Ring, uint8_t* Data, const uint16_t MaxLength);
+
+				static void     USB_Sim_Host_Service(void);
+				static void     USB_Sim_Host_ServiceControl(void);
+				static void     USB_Sim_Host_ServiceEndpoint(const uint8_t EndpointNumber);
+				static void     USB_Sim_Host_AbortTransfers(void);
+
+				static void     USB_Sim_Device_Service(void);
+				static void     USB_Sim_Device_ServicePipe(const uint8_t PipeNumber);
+				static void     USB_Sim_Device_ControlSetup(const uint8_t* Data);
+				static uint8_t  USB_Sim_Device_ControlIN(uint8_t* Data, const uint16_t MaxLength, uint16_t* const Length);
+				static uint8_t  USB_Sim_Device_ControlOUT(const uint8_t* Data, const uint16_t Length);
+				static void     USB_Sim_Device_UpdateID(void);
+			#endif
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
@@ -0,0 +1,63 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Host replacement for the avr-libc avr/eeprom.h header, used when compiling against the simulated USB controller.
+ *  As the host has a single address space, EEPROM data is stored and accessed as regular RAM data.
+ *
+ *  \see \ref Group_USBSimulator for more details.
+ */
+
+#ifndef __USBSIM_AVR_EEPROM_H__
+#define __USBSIM_AVR_EEPROM_H__
+
+	/* Includes: */
+		#include <stdint.h>
+		#include <stddef.h>
+		#include <string.h>
+
+	/* Macros: */
+		#define EEMEM
+
+		#define eeprom_read_byte(addr)               (*(const uint8_t*)(addr))
+		#define eeprom_read_word(addr)               (*(const uint16_t*)(addr))
+		#define eeprom_read_dword(addr)              (*(const uint32_t*)(addr))
+		#define eeprom_read_block(dst, src, len)     memcpy((dst), (src), (len))
+
+		#define eeprom_write_byte(addr, val)         (void)(*(uint8_t*)(addr) = (val))
+		#define eeprom_write_word(addr, val)         (void)(*(uint16_t*)(addr) = (val))
+		#define eeprom_write_dword(addr, val)        (void)(*(uint32_t*)(addr) = (val))
+		#define eeprom_write_block(src, dst, len)    memcpy((dst), (src), (len))
+
+		#define eeprom_busy_wait()                   do { } while (0)
+		#define eeprom_is_ready()                    1
+
+#endif
@@ -0,0 +1,56 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Host replacement for the avr-libc avr/interrupt.h header, used when compiling against the simulated USB controller.
+ *  Interrupt service routines become regular functions, which are called by the simulated USB controller when an
+ *  enabled USB interrupt is pending while global interrupts are enabled.
+ *
+ *  \see \ref Group_USBSimulator for more details.
+ */
+
+#ifndef __USBSIM_AVR_INTERRUPT_H__
+#define __USBSIM_AVR_INTERRUPT_H__
+
+	/* Includes: */
+		#include "io.h"
+
+	/* Macros: */
+		#define ISR_BLOCK
+		#define ISR_NOBLOCK
+		#define ISR_NAKED
+
+		#define ISR(vector, ...)            void vector (void); void vector (void)
+
+		#define sei()                       USB_Sim_SetInterruptsEnabled(true)
+		#define cli()                       USB_Sim_SetInterruptsEnabled(false)
+
+#endif
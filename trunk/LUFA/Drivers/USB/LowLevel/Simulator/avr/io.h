@@ -0,0 +1,392 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Host replacement for the avr-libc avr/io.h header, used when compiling against the simulated USB controller.
+ *  Each USB controller register is mapped onto an accessor of the simulated controller, so that register reads
+ *  and writes made by the unmodified library code are executed against the simulated hardware.
+ *
+ *  \see \ref Group_USBSimulator for more details.
+ */
+
+#ifndef __USBSIM_AVR_IO_H__
+#define __USBSIM_AVR_IO_H__
+
+	/* Includes: */
+		#include <stdint.h>
+
+	/* Preprocessor Checks: */
+		#if (!defined(__AVR_AT90USB162__) && !defined(__AVR_AT90USB82__)  && \
+		     !defined(__AVR_ATmega32U2__) && !defined(__AVR_ATmega16U2__) && !defined(__AVR_ATmega8U2__)  && \
+		     !defined(__AVR_ATmega32U4__) && !defined(__AVR_ATmega16U4__) && \
+		     !defined(__AVR_ATmega32U6__) && !defined(__AVR_AT90USB646__) && !defined(__AVR_AT90USB1286__) && \
+		     !defined(__AVR_AT90USB647__) && !defined(__AVR_AT90USB1287__))
+			#define __AVR_AT90USB1287__
+		#endif
+
+		#include "../USBSimulator.h"
+
+	/* Macros: */
+		#define _BV(bit)                    (1 << (bit))
+		#define bit_is_set(sfr, bit)        ((sfr) & _BV(bit))
+		#define bit_is_clear(sfr, bit)      (!((sfr) & _BV(bit)))
+
+		#define _USB_SIM_REG8(reg)          (*USB_Sim_Register(USB_SIM_REG_ ## reg))
+		#define _USB_SIM_REG16(reg)         (*USB_Sim_Register16(USB_SIM_REG_ ## reg))
+
+		/* General USB Controller Registers: */
+		#define USBCON                      _USB_SIM_REG8(USBCON)
+		#define USBSTA                      _USB_SIM_REG8(USBSTA)
+		#define USBINT                      _USB_SIM_REG8(USBINT)
+		#define UHWCON                      _USB_SIM_REG8(UHWCON)
+		#define OTGCON                      _USB_SIM_REG8(OTGCON)
+		#define OTGIEN                      _USB_SIM_REG8(OTGIEN)
+		#define OTGINT                      _USB_SIM_REG8(OTGINT)
+		#define PLLCSR                      _USB_SIM_REG8(PLLCSR)
+		#define PLLFRQ                      _USB_SIM_REG8(PLLFRQ)
+		#define REGCR                       _USB_SIM_REG8(REGCR)
+		#define DDRE                        _USB_SIM_REG8(DDRE)
+		#define PORTE                       _USB_SIM_REG8(PORTE)
+		#define SREG                        _USB_SIM_REG8(SREG)
+
+		/* Peripheral Registers: */
+		#define SPCR                        _USB_SIM_REG8(SPCR)
+		#define SPSR                        _USB_SIM_REG8(SPSR)
+		#define SPDR                        _USB_SIM_REG8(SPDR)
+		#define UCSR1A                      _USB_SIM_REG8(UCSR1A)
+		#define UCSR1B                      _USB_SIM_REG8(UCSR1B)
+		#define UCSR1C                      _USB_SIM_REG8(UCSR1C)
+		#define UDR1                        _USB_SIM_REG8(UDR1)
+		#define TCCR1A                      _USB_SIM_REG8(TCCR1A)
+		#define TCCR1B                      _USB_SIM_REG8(TCCR1B)
+		#define TIMSK1                      _USB_SIM_REG8(TIMSK1)
+		#define TIFR1                       _USB_SIM_REG8(TIFR1)
+		#define TCNT1                       _USB_SIM_REG16(TCNT1)
+		#define OCR1A                       _USB_SIM_REG16(OCR1A)
+		#define SMCR                        _USB_SIM_REG8(SMCR)
+
+		/* Device Mode Registers: */
+		#define UDCON                       _USB_SIM_REG8(UDCON)
+		#define UDINT                       _USB_SIM_REG8(UDINT)
+		#define UDIEN                       _USB_SIM_REG8(UDIEN)
+		#define UDADDR                      _USB_SIM_REG8(UDADDR)
+		#define UDFNUML                     _USB_SIM_REG8(UDFNUML)
+		#define UDFNUMH                     _USB_SIM_REG8(UDFNUMH)
+		#define UDFNUM                      _USB_SIM_REG16(UDFNUM)
+		#define UDMFN                       _USB_SIM_REG8(UDMFN)
+		#define UENUM                       _USB_SIM_REG8(UENUM)
+		#define UERST                       _USB_SIM_REG8(UERST)
+		#define UEINT                       _USB_SIM_REG8(UEINT)
+		#define UEINTX                      _USB_SIM_REG8(UEINTX)
+		#define UECONX                      _USB_SIM_REG8(UECONX)
+		#define UECFG0X                     _USB_SIM_REG8(UECFG0X)
+		#define UECFG1X                     _USB_SIM_REG8(UECFG1X)
+		#define UESTA0X                     _USB_SIM_REG8(UESTA0X)
+		#define UESTA1X                     _USB_SIM_REG8(UESTA1X)
+		#define UEIENX                      _USB_SIM_REG8(UEIENX)
+		#define UEDATX                      _USB_SIM_REG8(UEDATX)
+		#define UEBCLX                      _USB_SIM_REG8(UEBCLX)
+		#define UEBCHX                      _USB_SIM_REG8(UEBCHX)
+		#define UEBCX                       _USB_SIM_REG16(UEBCX)
+
+		/* Host Mode Registers: */
+		#define UHCON                       _USB_SIM_REG8(UHCON)
+		#define UHINT                       _USB_SIM_REG8(UHINT)
+		#define UHIEN                       _USB_SIM_REG8(UHIEN)
+		#define UHADDR                      _USB_SIM_REG8(UHADDR)
+		#define UHFNUML                     _USB_SIM_REG8(UHFNUML)
+		#define UHFNUMH                     _USB_SIM_REG8(UHFNUMH)
+		#define UHFNUM                      _USB_SIM_REG16(UHFNUM)
+		#define UHFLEN                      _USB_SIM_REG8(UHFLEN)
+		#define UPNUM                       _USB_SIM_REG8(UPNUM)
+		#define UPRST                       _USB_SIM_REG8(UPRST)
+		#define UPINT                       _USB_SIM_REG8(UPINT)
+		#define UPINRQX                     _USB_SIM_REG8(UPINRQX)
+		#define UPINTX                      _USB_SIM_REG8(UPINTX)
+		#define UPCONX                      _USB_SIM_REG8(UPCONX)
+		#define UPCFG0X                     _USB_SIM_REG8(UPCFG0X)
+		#define UPCFG1X                     _USB_SIM_REG8(UPCFG1X)
+		#define UPCFG2X                     _USB_SIM_REG8(UPCFG2X)
+		#define UPSTAX                      _USB_SIM_REG8(UPSTAX)
+		#define UPIENX                      _USB_SIM_REG8(UPIENX)
+		#define UPERRX                      _USB_SIM_REG8(UPERRX)
+		#define UPDATX                      _USB_SIM_REG8(UPDATX)
+		#define UPBCLX                      _USB_SIM_REG8(UPBCLX)
+		#define UPBCHX                      _USB_SIM_REG8(UPBCHX)
+		#define UPBCX                       _USB_SIM_REG16(UPBCX)
+
+		/* SPSR Bits: */
+		#define SPIF                        7
+		#define WCOL                        6
+		#define SPI2X                       0
+
+		/* UCSR1A Bits: */
+		#define RXC1                        7
+		#define TXC1                        6
+		#define UDRE1                       5
+		#define U2X1                        1
+
+		/* SREG Bits: */
+		#define SREG_I                      7
+
+		/* TCCR1B Bits: */
+		#define CS12                        2
+		#define CS11                        1
+		#define CS10                        0
+
+		/* TIMSK1 Bits: */
+		#define OCIE1A                      1
+
+		/* TIFR1 Bits: */
+		#define OCF1A                       1
+
+		/* SMCR Bits: */
+		#define SM2                         3
+		#define SM1                         2
+		#define SM0                         1
+		#define SE                          0
+
+		/* PLLCSR Bits: */
+		#define PINDIV                      4
+		#define PLLP2                       4
+		#define PLLP1                       3
+		#define PLLP0                       2
+		#define PLLE                        1
+		#define PLOCK                       0
+
+		/* PLLFRQ Bits: */
+		#define PINMUX                      7
+		#define PLLUSB                      6
+		#define PLLTM1                      5
+		#define PLLTM0                      4
+		#define PDIV3                       3
+		#define PDIV2                       2
+		#define PDIV1                       1
+		#define PDIV0                       0
+
+		/* REGCR Bits: */
+		#define REGDIS                      0
+
+		/* USBCON Bits: */
+		#define USBE                        7
+		#define HOST                        6
+		#define FRZCLK                      5
+		#define OTGPADE                     4
+		#define IDTE                        1
+		#define VBUSTE                      0
+
+		/* USBSTA Bits: */
+		#define SPEED                       3
+		#define ID                          1
+		#define VBUS                        0
+
+		/* USBINT Bits: */
+		#define IDTI                        1
+		#define VBUSTI                      0
+
+		/* UHWCON Bits: */
+		#define UIMOD                       7
+		#define UIDE                        6
+		#define UVCONE                      4
+		#define UVREGE                      0
+
+		/* OTGCON Bits: */
+		#define HNPREQ                      5
+		#define SRPREQ                      4
+		#define SRPSEL                      3
+		#define VBUSHWC                     2
+		#define VBUSREQ                     1
+		#define VBUSRQC                     0
+
+		/* OTGIEN Bits: */
+		#define STOE                        5
+		#define HNPERRE                     4
+		#define ROLEEXE                     3
+		#define BCERRE                      2
+		#define VBERRE                      1
+		#define SRPE                        0
+
+		/* OTGINT Bits: */
+		#define STOI                        5
+		#define HNPERRI                     4
+		#define ROLEEXI                     3
+		#define BCERRI                      2
+		#define VBERRI                      1
+		#define SRPI                        0
+
+		/* UDCON Bits: */
+		#define RSTCPU                      3
+		#define LSM                         2
+		#define RMWKUP                      1
+		#define DETACH                      0
+
+		/* UDINT Bits: */
+		#define UPRSMI                      6
+		#define EORSMI                      5
+		#define WAKEUPI                     4
+		#define EORSTI                      3
+		#define SOFI                        2
+		#define SUSPI                       0
+
+		/* UDIEN Bits: */
+		#define UPRSME                      6
+		#define EORSME                      5
+		#define WAKEUPE                     4
+		#define EORSTE                      3
+		#define SOFE                        2
+		#define SUSPE                       0
+
+		/* UDADDR Bits: */
+		#define ADDEN                       7
+
+		/* UEINTX Bits: */
+		#define FIFOCON                     7
+		#define NAKINI                      6
+		#define RWAL                        5
+		#define NAKOUTI                     4
+		#define RXSTPI                      3
+		#define RXOUTI                      2
+		#define STALLEDI                    1
+		#define TXINI                       0
+
+		/* UECONX Bits: */
+		#define STALLRQ                     5
+		#define STALLRQC                    4
+		#define RSTDT                       3
+		#define EPEN                        0
+
+		/* UECFG0X Bits: */
+		#define EPTYPE1                     7
+		#define EPTYPE0                     6
+		#define EPDIR                       0
+
+		/* UECFG1X Bits: */
+		#define EPSIZE2                     6
+		#define EPSIZE1                     5
+		#define EPSIZE0                     4
+		#define EPBK1                       3
+		#define EPBK0                       2
+		#define ALLOC                       1
+
+		/* UESTA0X Bits: */
+		#define CFGOK                       7
+		#define OVERFI                      6
+		#define UNDERFI                     5
+		#define DTSEQ1                      3
+		#define DTSEQ0                      2
+		#define NBUSYBK1                    1
+		#define NBUSYBK0                    0
+
+		/* UESTA1X Bits: */
+		#define CTRLDIR                     2
+		#define CURRBK1                     1
+		#define CURRBK0                     0
+
+		/* UEIENX Bits: */
+		#define FLERRE                      7
+		#define NAKINE                      6
+		#define NAKOUTE                     4
+		#define RXSTPE                      3
+		#define RXOUTE                      2
+		#define STALLEDE                    1
+		#define TXINE                       0
+
+		/* UHCON Bits: */
+		#define RESUME                      2
+		#define RESET                       1
+		#define SOFEN                       0
+
+		/* UHINT Bits: */
+		#define HWUPI                       6
+		#define HSOFI                       5
+		#define RXRSMI                      4
+		#define RSMEDI                      3
+		#define RSTI                        2
+		#define DDISCI                      1
+		#define DCONNI                      0
+
+		/* UHIEN Bits: */
+		#define HWUPE                       6
+		#define HSOFE                       5
+		#define RXRSME                      4
+		#define RSMEDE                      3
+		#define RSTE                        2
+		#define DDISCE                      1
+		#define DCONNE                      0
+
+		/* UPINTX Bits: */
+		#define NAKEDI                      6
+		#define PERRI                       4
+		#define TXSTPI                      3
+		#define TXOUTI                      2
+		#define RXSTALLI                    1
+		#define RXINI                       0
+
+		/* UPCONX Bits: */
+		#define PFREEZE                     6
+		#define INMODE                      5
+		#define PEN                         0
+
+		/* UPCFG0X Bits: */
+		#define PTYPE1                      7
+		#define PTYPE0                      6
+		#define PTOKEN1                     5
+		#define PTOKEN0                     4
+		#define PEPNUM3                     3
+		#define PEPNUM2                     2
+		#define PEPNUM1                     1
+		#define PEPNUM0                     0
+
+		/* UPCFG1X Bits: */
+		#define PSIZE2                      6
+		#define PSIZE1                      5
+		#define PSIZE0                      4
+		#define PBK1                        3
+		#define PBK0                        2
+
+		/* UPIENX Bits: */
+		#define NAKEDE                      6
+		#define PERRE                       4
+		#define TXSTPE                      3
+		#define TXOUTE                      2
+		#define RXSTALLE                    1
+		#define RXINE                       0
+
+		/* UPERRX Bits: */
+		#define COUNTER1                    6
+		#define COUNTER0                    5
+		#define CRC16                       4
+		#define TIMEOUT                     3
+		#define PID                         2
+		#define DATAPID                     1
+		#define DATATGL                     0
+
+#endif
@@ -0,0 +1,75 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Host replacement for the avr-libc avr/pgmspace.h header, used when compiling against the simulated USB controller.
+ *  As the host has a single address space, FLASH data is stored and accessed as regular constant data.
+ *
+ *  \see \ref Group_USBSimulator for more details.
+ */
+
+#ifndef __USBSIM_AVR_PGMSPACE_H__
+#define __USBSIM_AVR_PGMSPACE_H__
+
+	/* Includes: */
+		#include <stdint.h>
+		#include <stddef.h>
+		#include <string.h>
+		#include <stdio.h>
+
+	/* Macros: */
+		#define PROGMEM
+		#define PGM_P                       const char*
+		#define PSTR(s)                     (s)
+
+		#define pgm_read_byte(addr)         (*(const uint8_t*)(addr))
+		#define pgm_read_word(addr)         (*(const uint16_t*)(addr))
+		#define pgm_read_dword(addr)        (*(const uint32_t*)(addr))
+		#define pgm_read_ptr(addr)          (*(void* const*)(addr))
+
+		#define memcpy_P(dst, src, len)     memcpy((dst), (src), (len))
+		#define memcmp_P(s1, s2, len)       memcmp((s1), (s2), (len))
+		#define strcpy_P(dst, src)          strcpy((dst), (src))
+		#define strncpy_P(dst, src, len)    strncpy((dst), (src), (len))
+		#define strcmp_P(s1, s2)            strcmp((s1), (s2))
+		#define strncmp_P(s1, s2, len)      strncmp((s1), (s2), (len))
+		#define strlen_P(s)                 strlen((s))
+		#define printf_P                    printf
+		#define sprintf_P                   sprintf
+		#define fputs_P(s, stream)          fputs((s), (stream))
+
+	/* Type Defines: */
+		typedef uint8_t  prog_uint8_t;
+		typedef uint16_t prog_uint16_t;
+		typedef uint32_t prog_uint32_t;
+		typedef char     prog_char;
+
+#endif
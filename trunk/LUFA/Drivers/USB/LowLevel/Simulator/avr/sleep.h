@@ -0,0 +1,59 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Host replacement for the avr-libc avr/sleep.h header, used when compiling against the simulated USB controller.
+ *  Entering a sleep mode advances the simulated bus time until an enabled interrupt is serviced.
+ *
+ *  \see \ref Group_USBSimulator for more details.
+ */
+
+#ifndef __USBSIM_AVR_SLEEP_H__
+#define __USBSIM_AVR_SLEEP_H__
+
+	/* Includes: */
+		#include "io.h"
+
+	/* Macros: */
+		#define SLEEP_MODE_IDLE             0
+		#define SLEEP_MODE_ADC              (1 << SM0)
+		#define SLEEP_MODE_PWR_DOWN         (1 << SM1)
+		#define SLEEP_MODE_PWR_SAVE         ((1 << SM1) | (1 << SM0))
+		#define SLEEP_MODE_STANDBY          ((1 << SM2) | (1 << SM1))
+		#define SLEEP_MODE_EXT_STANDBY      ((1 << SM2) | (1 << SM1) | (1 << SM0))
+
+		#define set_sleep_mode(mode)        do { SMCR = ((SMCR & ~((1 << SM2) | (1 << SM1) | (1 << SM0))) | (mode)); } while (0)
+		#define sleep_enable()              do { SMCR |=  (1 << SE); } while (0)
+		#define sleep_disable()             do { SMCR &= ~(1 << SE); } while (0)
+		#define sleep_cpu()                 USB_Sim_Sleep()
+		#define sleep_mode()                do { sleep_enable(); sleep_cpu(); sleep_disable(); } while (0)
+
+#endif
@@ -0,0 +1,62 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+              
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this 
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in 
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting 
+  documentation, and that the name of the author not be used in 
+  advertising or publicity pertaining to distribution of the 
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Host wrapper for the standard stdio.h header, used when compiling against the simulated USB controller. The avr-libc
+ *  FILE stream extensions used by the class drivers are defined so that the drivers compile unmodified, however
+ *  streams created through them are not functional on the host, and all share the single user data pointer defined
+ *  in USBSimulator.c.
+ *
+ *  \see \ref Group_USBSimulator for more details.
+ */
+
+#ifndef __USBSIM_STDIO_H__
+#define __USBSIM_STDIO_H__
+
+	/* Includes: */
+		#include_next <stdio.h>
+
+	/* Macros: */
+		#define _FDEV_SETUP_READ                       0x01
+		#define _FDEV_SETUP_WRITE                      0x02
+		#define _FDEV_SETUP_RW                         (_FDEV_SETUP_READ | _FDEV_SETUP_WRITE)
+
+		#define _FDEV_ERR                              -1
+		#define _FDEV_EOF                              -2
+
+		#define FDEV_SETUP_STREAM(put, get, rwflag)    {((void)(put), (void)(get), 0)}
+		#define fdev_set_udata(stream, u)              (USB_Sim_StreamUData = (u))
+		#define fdev_get_udata(stream)                 (USB_Sim_StreamUData)
+
+	/* External Variables: */
+		extern void* USB_Sim_StreamUData;
+
+#endif
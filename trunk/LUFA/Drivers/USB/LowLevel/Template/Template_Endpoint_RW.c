@@ -7,45 +7,50 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE Buffer, uint16_t Length __CALLB
 	  return ErrorCode;
 
 	#if defined(FAST_STREAM_TRANSFERS)
-	uint8_t BytesRemToAlignment = (Endpoint_BytesInEndpoint() & 0x07);
-
-	if (Length >= 8)
+	while (Length)
 	{
-		Length -= BytesRemToAlignment;
+		uint16_t BytesInBank = TEMPLATE_BYTES_IN_BANK();
+
+		if (BytesInBank > Length)
+		  BytesInBank = Length;
 
-		switch (BytesRemToAlignment)
+		Length -= BytesInBank;
+
+		if (BytesInBank)
 		{
-			default:
-				do
-				{
-					if (!(Endpoint_IsReadWriteAllowed()))
+			uint8_t BlocksRemaining = ((BytesInBank + 7) >> 3);
+
+			switch ((uint8_t)BytesInBank & 0x07)
+			{
+				default:
+					do
 					{
-						TEMPLATE_CLEAR_ENDPOINT();
+						TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 7: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 6: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 5: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 4: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 3: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 2: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 1:	TEMPLATE_TRANSFER_BYTE(DataStream);
+					} while (--BlocksRemaining);
+			}
+		}
 
-						#if !defined(NO_STREAM_CALLBACKS)
-						if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
-						  return ENDPOINT_RWSTREAM_CallbackAborted;
-						#endif
+		if (Length)
+		{
+			TEMPLATE_CLEAR_ENDPOINT();
 
-						if ((ErrorCode = Endpoint_WaitUntilReady()))
-						  return ErrorCode;
-					}
+			#if !defined(NO_STREAM_CALLBACKS)
+			if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
+			  return ENDPOINT_RWSTREAM_CallbackAborted;
+			#endif
 
-					Length -= 8;
-					
-					TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 7: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 6: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 5: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 4: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 3: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 2: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 1:	TEMPLATE_TRANSFER_BYTE(DataStream);
-				} while (Length >= 8);	
+			if ((ErrorCode = Endpoint_WaitUntilReady()))
+			  return ErrorCode;
 		}
 	}
-	#endif
-
+	#else
 	while (Length)
 	{
 		if (!(Endpoint_IsReadWriteAllowed()))
@@ -66,6 +71,9 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE Buffer, uint16_t Length __CALLB
 			Length--;
 		}
 	}
+	#endif
+
+	USB_TRACE_EVENT(USB_TRACE_EVENT_StreamComplete, Endpoint_GetCurrentEndpoint());
 
 	return ENDPOINT_RWSTREAM_NoError;
 }
@@ -74,4 +82,5 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE Buffer, uint16_t Length __CALLB
 #undef TEMPLATE_BUFFER_TYPE
 #undef TEMPLATE_TRANSFER_BYTE
 #undef TEMPLATE_CLEAR_ENDPOINT
-#undef TEMPLATE_BUFFER_OFFSET
\ No newline at end of file
+#undef TEMPLATE_BUFFER_OFFSET
+#undef TEMPLATE_BYTES_IN_BANK
\ No newline at end of file
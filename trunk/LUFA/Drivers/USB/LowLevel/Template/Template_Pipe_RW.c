@@ -9,45 +9,50 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE Buffer, uint16_t Length __CALLB
 	  return ErrorCode;
 
 	#if defined(FAST_STREAM_TRANSFERS)
-	uint8_t BytesRemToAlignment = (Pipe_BytesInPipe() & 0x07);
-
-	if (Length >= 8)
+	while (Length)
 	{
-		Length -= BytesRemToAlignment;
+		uint16_t BytesInBank = TEMPLATE_BYTES_IN_BANK();
+
+		if (BytesInBank > Length)
+		  BytesInBank = Length;
 
-		switch (BytesRemToAlignment)
+		Length -= BytesInBank;
+
+		if (BytesInBank)
 		{
-			default:
-				do
-				{
-					if (!(Pipe_IsReadWriteAllowed()))
+			uint8_t BlocksRemaining = ((BytesInBank + 7) >> 3);
+
+			switch ((uint8_t)BytesInBank & 0x07)
+			{
+				default:
+					do
 					{
-						TEMPLATE_CLEAR_PIPE();
+						TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 7: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 6: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 5: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 4: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 3: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 2: TEMPLATE_TRANSFER_BYTE(DataStream);
+				case 1:	TEMPLATE_TRANSFER_BYTE(DataStream);
+					} while (--BlocksRemaining);
+			}
+		}
 
-						#if !defined(NO_STREAM_CALLBACKS)
-						if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
-						  return PIPE_RWSTREAM_CallbackAborted;
-						#endif
+		if (Length)
+		{
+			TEMPLATE_CLEAR_PIPE();
 
-						if ((ErrorCode = Pipe_WaitUntilReady()))
-						  return ErrorCode;
-					}
+			#if !defined(NO_STREAM_CALLBACKS)
+			if ((Callback != NULL) && (Callback() == STREAMCALLBACK_Abort))
+			  return PIPE_RWSTREAM_CallbackAborted;
+			#endif
 
-					Length -= 8;
-					
-					TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 7: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 6: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 5: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 4: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 3: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 2: TEMPLATE_TRANSFER_BYTE(DataStream);
-			case 1:	TEMPLATE_TRANSFER_BYTE(DataStream);
-				} while (Length >= 8);	
+			if ((ErrorCode = Pipe_WaitUntilReady()))
+			  return ErrorCode;
 		}
 	}
-	#endif
-
+	#else
 	while (Length)
 	{
 		if (!(Pipe_IsReadWriteAllowed()))
@@ -68,6 +73,7 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE Buffer, uint16_t Length __CALLB
 			Length--;
 		}
 	}
+	#endif
 	
 	return PIPE_RWSTREAM_NoError;
 }
@@ -78,3 +84,4 @@ uint8_t TEMPLATE_FUNC_NAME (TEMPLATE_BUFFER_TYPE Buffer, uint16_t Length __CALLB
 #undef TEMPLATE_TRANSFER_BYTE
 #undef TEMPLATE_CLEAR_PIPE
 #undef TEMPLATE_BUFFER_OFFSET
+#undef TEMPLATE_BYTES_IN_BANK
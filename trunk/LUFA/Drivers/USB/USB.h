@@ -49,6 +49,8 @@
  *    - LUFA/Drivers/USB/HighLevel/USBInterrupt.c
  *    - LUFA/Drivers/USB/HighLevel/USBTask.c
  *    - LUFA/Drivers/USB/HighLevel/ConfigDescriptor.c
+ *    - LUFA/Drivers/USB/HighLevel/USBTrace.c <i>(Only required if the ENABLE_USB_TRACE token is defined)</i>
+ *    - LUFA/Drivers/USB/HighLevel/USBTimebase.c <i>(Only required if the TIMER_STREAM_TIMEOUTS token is defined)</i>
  *
  *  \section Module Description
  *  Driver and framework for the USB controller hardware on the USB series of AVR microcontrollers. This module
@@ -57,7 +59,9 @@
  *
  *  The USB stack requires the sole control over the USB controller in the microcontroller only; i.e. it does not
  *  require any additional AVR timers, etc. to operate. This ensures that the USB stack requires as few resources
- *  as possible.
+ *  as possible. The only exceptions are the optional \ref Group_USBTrace module, which by default takes its event
+ *  timestamps from Timer 1, and the optional \ref Group_USBTimebase module, which uses Timer 1 to measure stream
+ *  timeouts.
  *
  *  The USB stack can be used in Device Mode for connections to USB Hosts (see \ref Group_Device), in Host mode for
  *  hosting of other USB devices (see \ref Group_Host), or as a dual role device which can either act as a USB host
@@ -369,6 +373,8 @@
 		#include "HighLevel/USBInterrupt.h"
 		#include "HighLevel/Events.h"
 		#include "HighLevel/StdDescriptors.h"
+		#include "HighLevel/USBTrace.h"
+		#include "HighLevel/USBTimebase.h"
 
 		#include "LowLevel/LowLevel.h"
 	
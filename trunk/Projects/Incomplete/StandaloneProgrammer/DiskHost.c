@@ -47,6 +47,27 @@ USB_ClassInfo_MS_Host_t DiskHost_MS_Interface =
 			},
 	};
 
+/** Block slots used by the Mass Storage host block cache to hold recently accessed sectors of the attached disk. */
+static MS_Host_CacheSlot_t DiskHost_MS_CacheSlots[DISK_HOST_CACHE_SLOTS];
+
+/** LUFA Mass Storage host block cache configuration and state information, used to cache the attached disk's FAT
+ *  and directory sectors so that the partial sector reads made by the filesystem driver do not each require a
+ *  full SCSI command.
+ */
+MS_Host_Cache_t DiskHost_MS_Cache =
+	{
+		.Config =
+			{
+				.MSInterfaceInfo        = &DiskHost_MS_Interface,
+				.LUNIndex               = 0,
+
+				.Slots                  = DiskHost_MS_CacheSlots,
+				.TotalSlots             = DISK_HOST_CACHE_SLOTS,
+
+				.ReadAheadBlocks        = 1,
+			},
+	};
+
 void DiskHost_USBTask(void)
 {
 	if (USB_HostState == HOST_STATE_Addressed)
@@ -106,7 +127,18 @@ void DiskHost_USBTask(void)
 			return;
 		}
 		
+		if (MS_Host_Cache_Init(&DiskHost_MS_Cache) != 0)
+		{
+			LEDs_SetAllLEDs(LEDMASK_USB_ERROR);
+			USB_HostState = HOST_STATE_WaitForDeviceRemoval;
+			return;
+		}
+
 		pf_mount(&DiskFATState);
+
+		/* Keep the FAT and root directory sectors cached in preference to file data */
+		MS_Host_Cache_SetPinnedRegion(&DiskHost_MS_Cache, DiskFATState.fatbase,
+		                              (DiskFATState.database - DiskFATState.fatbase));
 		
 		LEDs_SetAllLEDs(LEDMASK_USB_READY);
 	}
@@ -121,6 +153,7 @@ void EVENT_USB_Host_DeviceAttached(void)
 
 void EVENT_USB_Host_DeviceUnattached(void)
 {
+	MS_Host_Cache_Invalidate(&DiskHost_MS_Cache);
 	LEDs_SetAllLEDs(LEDMASK_USB_NOTREADY);
 }
 
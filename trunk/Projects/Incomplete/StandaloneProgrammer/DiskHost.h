@@ -46,9 +46,14 @@
 		#include <LUFA/Drivers/Board/LEDs.h>
 		#include <LUFA/Drivers/USB/Class/MassStorage.h>
 
+	/* Macros: */
+		/** Number of sectors of the attached disk which are held in the Mass Storage host block cache. */
+		#define DISK_HOST_CACHE_SLOTS    2
+
 	/* External Variables: */
 		#if defined(USB_CAN_BE_HOST)
 		extern USB_ClassInfo_MS_Host_t DiskHost_MS_Interface;
+		extern MS_Host_Cache_t         DiskHost_MS_Cache;
 		#endif
 
 	/* Function Prototypes: */
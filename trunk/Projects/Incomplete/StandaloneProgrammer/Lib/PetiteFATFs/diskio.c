@@ -32,26 +32,30 @@ DRESULT disk_readp (
 )
 {
 	DRESULT ErrorCode = RES_OK;
-	uint8_t BlockTemp[512];
 
 	if (USB_CurrentMode == USB_MODE_HOST)
 	{
 		#if defined(USB_CAN_BE_HOST)
+		uint8_t* BlockData;
+
 		if (USB_HostState != HOST_STATE_Configured)
 		  ErrorCode = RES_NOTRDY;
-		else if (MS_Host_ReadDeviceBlocks(&DiskHost_MS_Interface, 0, sector, 1, 512, BlockTemp))
+		else if (MS_Host_Cache_GetBlock(&DiskHost_MS_Cache, sector, &BlockData))
 		  ErrorCode = RES_ERROR;
+		else
+		  memcpy(dest, &BlockData[sofs], count);
 		#endif
 	}
 	else
 	{
 		#if defined(USB_CAN_BE_DEVICE)
+		uint8_t BlockTemp[512];
+
 		DataflashManager_ReadBlocks_RAM(sector, 1, BlockTemp);
+		memcpy(dest, &BlockTemp[sofs], count);
 		#endif
 	}
 
-	memcpy(dest, &BlockTemp[sofs], count);
-
 	return ErrorCode;
 }
 
@@ -172,76 +172,26 @@ USB_Descriptor_String_t PROGMEM LanguageString =
  *  form, and is read out upon request by the host when the appropriate string ID is requested, listed in the Device
  *  Descriptor.
  */
-USB_Descriptor_String_t PROGMEM ManufacturerString =
-{
-	.Header                 = {.Size = USB_STRING_LEN(32), .Type = DTYPE_String},
-		
-	.UnicodeString          = L"Dean Camera and Denver Gingerich"
-};
+USB_Descriptor_String_t PROGMEM ManufacturerString = USB_STRING_DESCRIPTOR(L"Dean Camera and Denver Gingerich");
 
 /** Product descriptor string. This is a Unicode string containing the product's details in human readable form,
  *  and is read out upon request by the host when the appropriate string ID is requested, listed in the Device
  *  Descriptor.
  */
-USB_Descriptor_String_t PROGMEM ProductString =
-{
-	.Header                 = {.Size = USB_STRING_LEN(20), .Type = DTYPE_String},
-		
-	.UnicodeString          = L"Magnetic Card Reader"
-};
+USB_Descriptor_String_t PROGMEM ProductString = USB_STRING_DESCRIPTOR(L"Magnetic Card Reader");
 
-/** This function is called by the library when in device mode, and must be overridden (see library "USB Descriptors"
- *  documentation) by the application code so that the address and size of a requested descriptor can be given
- *  to the USB library. When the device receives a Get Descriptor request on the control endpoint, this function
- *  is called so that the descriptor details can be passed back and the appropriate descriptor sent back to the
- *  USB host.
+/** Table of the device's descriptors, searched by the library when the host requests a descriptor. Each entry
+ *  gives the descriptor's type and index along with its address in memory; the descriptor sizes are computed at
+ *  compile time.
  */
-uint16_t CALLBACK_USB_GetDescriptor(const uint16_t wValue, const uint8_t wIndex, void** const DescriptorAddress)
+const USB_Descriptor_TableEntry_t PROGMEM USB_DescriptorTable[] =
 {
-	const uint8_t  DescriptorType   = (wValue >> 8);
-	const uint8_t  DescriptorNumber = (wValue & 0xFF);
-
-	void*    Address = NULL;
-	uint16_t Size    = NO_DESCRIPTOR;
-
-	switch (DescriptorType)
-	{
-		case DTYPE_Device:
-			Address = (void*)&DeviceDescriptor;
-			Size    = sizeof(USB_Descriptor_Device_t);
-			break;
-		case DTYPE_Configuration:
-			Address = (void*)&ConfigurationDescriptor;
-			Size    = sizeof(USB_Descriptor_Configuration_t);
-			break;
-		case DTYPE_String:
-			switch (DescriptorNumber)
-			{
-				case 0x00:
-					Address = (void*)&LanguageString;
-					Size    = pgm_read_byte(&LanguageString.Header.Size);
-					break;
-				case 0x01:
-					Address = (void*)&ManufacturerString;
-					Size    = pgm_read_byte(&ManufacturerString.Header.Size);
-					break;
-				case 0x02:
-					Address = (void*)&ProductString;
-					Size    = pgm_read_byte(&ProductString.Header.Size);
-					break;
-			}
-			
-			break;
-		case DTYPE_HID:
-			Address = (void*)&ConfigurationDescriptor.HID_KeyboardHID;
-			Size    = sizeof(USB_HID_Descriptor_t);
-			break;
-		case DTYPE_Report:
-			Address = (void*)&KeyboardReport;
-			Size    = sizeof(KeyboardReport);
-			break;
-	}
-	
-	*DescriptorAddress = Address;
-	return Size;
-}
+	DESCRIPTOR_TABLE_ENTRY(DTYPE_Device, 0, DeviceDescriptor),
+	DESCRIPTOR_TABLE_ENTRY(DTYPE_Configuration, 0, ConfigurationDescriptor),
+	DESCRIPTOR_TABLE_ENTRY(DTYPE_HID, 0, ConfigurationDescriptor.HID_KeyboardHID),
+	DESCRIPTOR_TABLE_ENTRY(DTYPE_Report, 0, KeyboardReport),
+	DESCRIPTOR_TABLE_STRING(0x00, LanguageString),
+	DESCRIPTOR_TABLE_STRING(0x01, ManufacturerString),
+	DESCRIPTOR_TABLE_STRING(0x02, ProductString),
+	DESCRIPTOR_TABLE_END
+};
@@ -0,0 +1,471 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2010.
+
+  dean [at] fourwalledcubicle [dot] com
+      www.fourwalledcubicle.com
+*/
+
+/*
+  Copyright 2010  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Linux host application for the LUFA USB event trace facility (see \ref Group_USBTrace). The trace buffer of a
+ *  device compiled with the ENABLE_USB_TRACE token is periodically retrieved via the trace readout vendor control
+ *  request, or a previously captured raw dump of trace reports is read from a file, and the recorded events are
+ *  decoded into latency histograms with power of two microsecond buckets:
+ *
+ *    - Time from each SETUP packet to the completion or stall of the request, per bRequest value
+ *    - Interval between successive Start of Frame events
+ *    - Time from each bus reset to the first following SETUP packet
+ *
+ *  along with totals of each event type, including stream timeouts and lost events.
+ *
+ *  Build with "make", or with "make nolibusb" for a decoder which can only process raw dump files and which has no
+ *  libusb dependency.
+ *
+ *  Usage:
+ *    USBTraceDecoder -d VID:PID [-r Request] [-t Seconds] [-w DumpFile]
+ *    USBTraceDecoder -f DumpFile
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+#if !defined(NO_LIBUSB)
+	#include <libusb.h>
+#endif
+
+/* Macros: */
+	/** Default vendor request used to read out the trace buffer, matching the device's USB_TRACE_VENDOR_REQUEST. */
+	#define TRACE_DEFAULT_REQUEST      0x7E
+
+	/** Size of a trace report header, in bytes. */
+	#define TRACE_HEADER_SIZE          6
+
+	/** Size of a single trace event record, in bytes. */
+	#define TRACE_EVENT_SIZE           4
+
+	/** Maximum size of a trace report requested from the device, in bytes. */
+	#define TRACE_MAX_REPORT_SIZE      (TRACE_HEADER_SIZE + (15 * TRACE_EVENT_SIZE))
+
+	/** Number of power of two microsecond buckets in each latency histogram. */
+	#define HISTOGRAM_BUCKETS          20
+
+	/** Interval between trace buffer polls when reading from a live device, in microseconds. */
+	#define POLL_INTERVAL_US           5000
+
+/* Enums: */
+	/** Event types recorded by the device, matching the USB_TraceEvents_t enum of the library. */
+	enum TraceEvents_t
+	{
+		TRACE_EVENT_Connect          = 0,
+		TRACE_EVENT_Disconnect       = 1,
+		TRACE_EVENT_Suspend          = 2,
+		TRACE_EVENT_WakeUp           = 3,
+		TRACE_EVENT_Reset            = 4,
+		TRACE_EVENT_StartOfFrame     = 5,
+		TRACE_EVENT_Setup            = 6,
+		TRACE_EVENT_ControlComplete  = 7,
+		TRACE_EVENT_Stall            = 8,
+		TRACE_EVENT_StreamTimeout    = 9,
+		TRACE_EVENT_StreamComplete   = 10,
+		TRACE_EVENT_TOTAL_EVENTS
+	};
+
+/* Type Defines: */
+	/** Type define for a latency histogram. */
+	typedef struct
+	{
+		uint32_t Buckets[HISTOGRAM_BUCKETS]; /**< Sample counts, bucket n holding samples of [2^(n-1), 2^n) microseconds. */
+		uint32_t Samples; /**< Total number of samples in the histogram. */
+		uint64_t TotalUS; /**< Sum of all samples, in microseconds. */
+		uint32_t MaxUS; /**< Largest sample seen, in microseconds. */
+	} Histogram_t;
+
+	/** Type define for the decoder state. */
+	typedef struct
+	{
+		bool        TimeValid; /**< Indicates if the previous timestamp is valid for unwrapping the next event. */
+		uint16_t    LastTimestamp; /**< Raw timestamp of the previous event. */
+		uint64_t    Now; /**< Unwrapped time of the current event, in device ticks. */
+		uint16_t    TicksPerMs; /**< Device timestamp ticks per millisecond, from the last report header. */
+
+		bool        SetupPending; /**< Indicates if a SETUP event is awaiting its completion or stall. */
+		uint8_t     SetupRequest; /**< bRequest of the pending SETUP event. */
+		uint64_t    SetupTime; /**< Unwrapped time of the pending SETUP event. */
+
+		bool        ResetPending; /**< Indicates if a bus reset is awaiting the first following SETUP. */
+		uint64_t    ResetTime; /**< Unwrapped time of the pending bus reset. */
+
+		bool        SOFValid; /**< Indicates if the time of the previous Start of Frame is valid. */
+		uint64_t    SOFTime; /**< Unwrapped time of the previous Start of Frame. */
+
+		uint32_t    EventCounts[TRACE_EVENT_TOTAL_EVENTS]; /**< Number of events of each type decoded. */
+		uint32_t    LostEvents; /**< Total number of events lost on the device. */
+
+		Histogram_t RequestLatency[256]; /**< SETUP to completion or stall latency, per bRequest. */
+		Histogram_t SOFInterval; /**< Start of Frame interval. */
+		Histogram_t ResetToSetup; /**< Bus reset to first SETUP latency. */
+	} Decoder_t;
+
+static const char* EventNames[TRACE_EVENT_TOTAL_EVENTS] =
+	{
+		"Connect", "Disconnect", "Suspend", "WakeUp", "Reset", "StartOfFrame",
+		"Setup", "ControlComplete", "Stall", "StreamTimeout", "StreamComplete",
+	};
+
+static Decoder_t Decoder;
+
+static uint32_t TicksToUS(const uint64_t Ticks)
+{
+	if (!(Decoder.TicksPerMs))
+	  return 0;
+
+	return (uint32_t)((Ticks * 1000) / Decoder.TicksPerMs);
+}
+
+static void Histogram_Add(Histogram_t* const Histogram, const uint32_t SampleUS)
+{
+	uint8_t Bucket = 0;
+
+	while ((Bucket < (HISTOGRAM_BUCKETS - 1)) && (SampleUS >> Bucket))
+	  Bucket++;
+
+	Histogram->Buckets[Bucket]++;
+	Histogram->Samples++;
+	Histogram->TotalUS += SampleUS;
+
+	if (SampleUS > Histogram->MaxUS)
+	  Histogram->MaxUS = SampleUS;
+}
+
+static void Histogram_Print(const char* const Title, const Histogram_t* const Histogram)
+{
+	if (!(Histogram->Samples))
+	  return;
+
+	uint32_t LargestBucket = 0;
+
+	for (uint8_t Bucket = 0; Bucket < HISTOGRAM_BUCKETS; Bucket++)
+	{
+		if (Histogram->Buckets[Bucket] > LargestBucket)
+		  LargestBucket = Histogram->Buckets[Bucket];
+	}
+
+	printf("%s: %u samples, mean %llu us, max %u us\n", Title, Histogram->Samples,
+	       (unsigned long long)(Histogram->TotalUS / Histogram->Samples), Histogram->MaxUS);
+
+	for (uint8_t Bucket = 0; Bucket < HISTOGRAM_BUCKETS; Bucket++)
+	{
+		if (!(Histogram->Buckets[Bucket]))
+		  continue;
+
+		uint32_t BarLength = ((Histogram->Buckets[Bucket] * 40) + LargestBucket - 1) / LargestBucket;
+
+		if (Bucket == (HISTOGRAM_BUCKETS - 1))
+		  printf("  >= %8u us : %8u ", (1U << (Bucket - 1)), Histogram->Buckets[Bucket]);
+		else
+		  printf("  < %9u us : %8u ", (1U << Bucket), Histogram->Buckets[Bucket]);
+
+		while (BarLength--)
+		  putchar('#');
+
+		putchar('\n');
+	}
+
+	putchar('\n');
+}
+
+static void Decoder_ProcessEvent(const uint16_t Timestamp, const uint8_t Event, const uint8_t Data)
+{
+	if (Decoder.TimeValid)
+	  Decoder.Now += (uint16_t)(Timestamp - Decoder.LastTimestamp);
+
+	Decoder.LastTimestamp = Timestamp;
+	Decoder.TimeValid     = true;
+
+	if (Event >= TRACE_EVENT_TOTAL_EVENTS)
+	  return;
+
+	Decoder.EventCounts[Event]++;
+
+	switch (Event)
+	{
+		case TRACE_EVENT_Reset:
+			Decoder.ResetPending = true;
+			Decoder.ResetTime    = Decoder.Now;
+			Decoder.SetupPending = false;
+			Decoder.SOFValid     = false;
+			break;
+		case TRACE_EVENT_Disconnect:
+		case TRACE_EVENT_Suspend:
+			Decoder.ResetPending = false;
+			Decoder.SetupPending = false;
+			Decoder.SOFValid     = false;
+			break;
+		case TRACE_EVENT_StartOfFrame:
+			if (Decoder.SOFValid)
+			  Histogram_Add(&Decoder.SOFInterval, TicksToUS(Decoder.Now - Decoder.SOFTime));
+
+			Decoder.SOFValid = true;
+			Decoder.SOFTime  = Decoder.Now;
+			break;
+		case TRACE_EVENT_Setup:
+			if (Decoder.ResetPending)
+			{
+				Histogram_Add(&Decoder.ResetToSetup, TicksToUS(Decoder.Now - Decoder.ResetTime));
+				Decoder.ResetPending = false;
+			}
+
+			Decoder.SetupPending = true;
+			Decoder.SetupRequest = Data;
+			Decoder.SetupTime    = Decoder.Now;
+			break;
+		case TRACE_EVENT_ControlComplete:
+		case TRACE_EVENT_Stall:
+			if (Decoder.SetupPending && (Decoder.SetupRequest == Data))
+			  Histogram_Add(&Decoder.RequestLatency[Data], TicksToUS(Decoder.Now - Decoder.SetupTime));
+
+			Decoder.SetupPending = false;
+			break;
+	}
+}
+
+static bool Decoder_ProcessReport(const uint8_t* const Report, const int Length)
+{
+	if (Length < TRACE_HEADER_SIZE)
+	  return false;
+
+	uint8_t  EventCount = Report[0];
+	uint16_t LostEvents = (Report[2] | (Report[3] << 8));
+	uint16_t TicksPerMs = (Report[4] | (Report[5] << 8));
+
+	if (Length < (TRACE_HEADER_SIZE + (EventCount * TRACE_EVENT_SIZE)))
+	  return false;
+
+	Decoder.TicksPerMs = TicksPerMs;
+
+	/* Events lost on the device break the timestamp chain and any in-progress latency measurements */
+	if (LostEvents)
+	{
+		Decoder.LostEvents  += LostEvents;
+		Decoder.TimeValid    = false;
+		Decoder.SetupPending = false;
+		Decoder.ResetPending = false;
+		Decoder.SOFValid     = false;
+	}
+
+	const uint8_t* EventData = &Report[TRACE_HEADER_SIZE];
+
+	for (uint8_t EventIndex = 0; EventIndex < EventCount; EventIndex++)
+	{
+		Decoder_ProcessEvent((EventData[0] | (EventData[1] << 8)), EventData[2], EventData[3]);
+		EventData += TRACE_EVENT_SIZE;
+	}
+
+	return true;
+}
+
+static void Decoder_PrintResults(void)
+{
+	printf("Event totals (%u ticks/ms):\n", Decoder.TicksPerMs);
+
+	for (uint8_t Event = 0; Event < TRACE_EVENT_TOTAL_EVENTS; Event++)
+	  printf("  %-16s %u\n", EventNames[Event], Decoder.EventCounts[Event]);
+
+	printf("  %-16s %u\n\n", "Lost", Decoder.LostEvents);
+
+	for (uint16_t Request = 0; Request < 256; Request++)
+	{
+		char Title[48];
+
+		snprintf(Title, sizeof(Title), "SETUP to completion, bRequest 0x%02X", Request);
+		Histogram_Print(Title, &Decoder.RequestLatency[Request]);
+	}
+
+	Histogram_Print("Start of Frame interval", &Decoder.SOFInterval);
+	Histogram_Print("Bus reset to first SETUP", &Decoder.ResetToSetup);
+}
+
+static int DecodeFromFile(const char* const FileName)
+{
+	FILE* DumpFile = (strcmp(FileName, "-") == 0) ? stdin : fopen(FileName, "rb");
+
+	if (DumpFile == NULL)
+	{
+		perror(FileName);
+		return EXIT_FAILURE;
+	}
+
+	uint8_t Report[TRACE_HEADER_SIZE + (255 * TRACE_EVENT_SIZE)];
+
+	while (fread(Report, 1, TRACE_HEADER_SIZE, DumpFile) == TRACE_HEADER_SIZE)
+	{
+		size_t EventBytes = (Report[0] * TRACE_EVENT_SIZE);
+
+		if (fread(&Report[TRACE_HEADER_SIZE], 1, EventBytes, DumpFile) != EventBytes)
+		{
+			fprintf(stderr, "Truncated trace report in dump file.\n");
+			break;
+		}
+
+		Decoder_ProcessReport(Report, (TRACE_HEADER_SIZE + EventBytes));
+	}
+
+	if (DumpFile != stdin)
+	  fclose(DumpFile);
+
+	Decoder_PrintResults();
+	return EXIT_SUCCESS;
+}
+
+#if !defined(NO_LIBUSB)
+static int DecodeFromDevice(const uint16_t VendorID, const uint16_t ProductID, const uint8_t Request,
+                            const unsigned int Seconds, const char* const DumpFileName)
+{
+	libusb_device_handle* Device;
+	FILE*                 DumpFile = NULL;
+
+	if (libusb_init(NULL) != 0)
+	{
+		fprintf(stderr, "Could not initialize libusb.\n");
+		return EXIT_FAILURE;
+	}
+
+	if ((Device = libusb_open_device_with_vid_pid(NULL, VendorID, ProductID)) == NULL)
+	{
+		fprintf(stderr, "Could not open device %04X:%04X.\n", VendorID, ProductID);
+		libusb_exit(NULL);
+		return EXIT_FAILURE;
+	}
+
+	if ((DumpFileName != NULL) && ((DumpFile = fopen(DumpFileName, "wb")) == NULL))
+	  perror(DumpFileName);
+
+	unsigned long PollsRemaining = (((unsigned long)Seconds * 1000000UL) / POLL_INTERVAL_US);
+
+	while (PollsRemaining--)
+	{
+		uint8_t Report[TRACE_MAX_REPORT_SIZE];
+		int     ReportLength;
+
+		do
+		{
+			ReportLength = libusb_control_transfer(Device, (LIBUSB_ENDPOINT_IN | LIBUSB_REQUEST_TYPE_VENDOR |
+			                                                LIBUSB_RECIPIENT_DEVICE), Request, 0, 0,
+			                                       Report, sizeof(Report), 1000);
+
+			if (ReportLength < 0)
+			{
+				fprintf(stderr, "Trace readout failed: %s\n", libusb_error_name(ReportLength));
+				PollsRemaining = 0;
+				break;
+			}
+
+			if (!(Decoder_ProcessReport(Report, ReportLength)))
+			  break;
+
+			if (DumpFile != NULL)
+			  fwrite(Report, 1, ReportLength, DumpFile);
+		}
+		while (ReportLength == sizeof(Report));
+
+		usleep(POLL_INTERVAL_US);
+	}
+
+	if (DumpFile != NULL)
+	  fclose(DumpFile);
+
+	libusb_close(Device);
+	libusb_exit(NULL);
+
+	Decoder_PrintResults();
+	return EXIT_SUCCESS;
+}
+#endif
+
+static void PrintUsage(const char* const ProgramName)
+{
+	#if !defined(NO_LIBUSB)
+	fprintf(stderr, "Usage: %s -d VID:PID [-r Request] [-t Seconds] [-w DumpFile]\n", ProgramName);
+	#endif
+	fprintf(stderr, "       %s -f DumpFile\n", ProgramName);
+}
+
+int main(int argc, char* argv[])
+{
+	const char*  ReadFileName = NULL;
+	int          Option;
+
+	#if !defined(NO_LIBUSB)
+	const char*  DumpFileName = NULL;
+	unsigned int VendorID     = 0;
+	unsigned int ProductID    = 0;
+	bool         DeviceGiven  = false;
+	unsigned int Request      = TRACE_DEFAULT_REQUEST;
+	unsigned int Seconds      = 10;
+	#endif
+
+	while ((Option = getopt(argc, argv, "d:r:t:w:f:")) != -1)
+	{
+		switch (Option)
+		{
+			#if !defined(NO_LIBUSB)
+			case 'd':
+				DeviceGiven = (sscanf(optarg, "%x:%x", &VendorID, &ProductID) == 2);
+				break;
+			case 'r':
+				Request = strtoul(optarg, NULL, 0);
+				break;
+			case 't':
+				Seconds = strtoul(optarg, NULL, 0);
+				break;
+			case 'w':
+				DumpFileName = optarg;
+				break;
+			#endif
+			case 'f':
+				ReadFileName = optarg;
+				break;
+			default:
+				PrintUsage(argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	if (ReadFileName != NULL)
+	  return DecodeFromFile(ReadFileName);
+
+	#if !defined(NO_LIBUSB)
+	if (DeviceGiven)
+	  return DecodeFromDevice(VendorID, ProductID, Request, Seconds, DumpFileName);
+	#endif
+
+	PrintUsage(argv[0]);
+	return EXIT_FAILURE;
+}
@@ -36,9 +36,6 @@
 
 #include "USBtoSerial.h"
 
-/** Circular buffer to hold data from the host before it is sent to the device via the serial port. */
-RingBuff_t USBtoUSART_Buffer;
-
 /** Circular buffer to hold data from the serial port before it is sent to the host. */
 RingBuff_t USARTtoUSB_Buffer;
 
@@ -73,30 +70,27 @@ int main(void)
 {
 	SetupHardware();
 	
-	Buffer_Initialize(&USBtoUSART_Buffer);
 	Buffer_Initialize(&USARTtoUSB_Buffer);
 
 	LEDs_SetAllLEDs(LEDMASK_USB_NOTREADY);
 
 	for (;;)
 	{
-		/* Read bytes from the USB OUT endpoint into the USART transmit buffer */
-		for (uint8_t DataBytesRem = CDC_Device_BytesReceived(&VirtualSerial_CDC_Interface); DataBytesRem != 0; DataBytesRem--)
+		uint16_t DataBytesRem = CDC_Device_BytesReceived(&VirtualSerial_CDC_Interface);
+
+		/* Forward bytes from the USB OUT endpoint (left selected by the class driver) straight into the USART */
+		if (DataBytesRem)
 		{
-			if (!(BUFF_STATICSIZE - USBtoUSART_Buffer.Elements))
-			  break;
-			  
-			Buffer_StoreElement(&USBtoUSART_Buffer, CDC_Device_ReceiveByte(&VirtualSerial_CDC_Interface));
+			Endpoint_Forward_Stream_To_USART(DataBytesRem, NO_STREAM_CALLBACK);
+			
+			/* Discard the now empty OUT packet, ready for the next packet from the host */
+			Endpoint_ClearOUT();
 		}
 		
 		/* Read bytes from the USART receive buffer into the USB IN endpoint */
 		while (USARTtoUSB_Buffer.Elements)
 		  CDC_Device_SendByte(&VirtualSerial_CDC_Interface, Buffer_GetElement(&USARTtoUSB_Buffer));
 		
-		/* Load bytes from the USART transmit buffer into the USART */
-		while (USBtoUSART_Buffer.Elements)
-		  Serial_TxByte(Buffer_GetElement(&USBtoUSART_Buffer));
-		
 		CDC_Device_USBTask(&VirtualSerial_CDC_Interface);
 		USB_USBTask();
 	}
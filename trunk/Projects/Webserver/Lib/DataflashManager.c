@@ -79,16 +79,7 @@ void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* MSInterfaceInfo, co
 		/* Write an endpoint packet sized data block to the dataflash */
 		while (BytesInBlockDiv16 < (VIRTUAL_MEMORY_BLOCK_SIZE >> 4))
 		{
-			/* Check if the endpoint is currently empty */
-			if (!(Endpoint_IsReadWriteAllowed()))
-			{
-				/* Clear the current endpoint bank */
-				Endpoint_ClearOUT();
-				
-				/* Wait until the host has sent another packet */
-				if (Endpoint_WaitUntilReady())
-				  return;
-			}
+			uint8_t ChunksToForward;
 
 			/* Check if end of dataflash page reached */
 			if (CurrDFPageByteDiv16 == (DATAFLASH_PAGE_SIZE >> 4))
@@ -126,29 +117,21 @@ void DataflashManager_WriteBlocks(USB_ClassInfo_MS_Device_t* MSInterfaceInfo, co
 				Dataflash_SendAddressBytes(0, 0);				
 			}
 
-			/* Write one 16-byte chunk of data to the dataflash */
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
-			Dataflash_SendByte(Endpoint_Read_Byte());
+			/* Forward data up to the end of the current dataflash page or block, whichever comes first */
+			ChunksToForward = ((DATAFLASH_PAGE_SIZE >> 4) - CurrDFPageByteDiv16);
+			
+			if (ChunksToForward > ((VIRTUAL_MEMORY_BLOCK_SIZE >> 4) - BytesInBlockDiv16))
+			  ChunksToForward = ((VIRTUAL_MEMORY_BLOCK_SIZE >> 4) - BytesInBlockDiv16);
+
+			/* Write the 16-byte chunks of data straight from the endpoint to the dataflash */
+			if (Endpoint_Forward_Stream_To_SPI(((uint16_t)ChunksToForward << 4), NO_STREAM_CALLBACK))
+			  return;
 			
 			/* Increment the dataflash page 16 byte block counter */
-			CurrDFPageByteDiv16++;
+			CurrDFPageByteDiv16 += ChunksToForward;
 
 			/* Increment the block 16 byte block counter */
-			BytesInBlockDiv16++;
+			BytesInBlockDiv16 += ChunksToForward;
 
 			/* Check if the current command is being aborted by the host */
 			if (MSInterfaceInfo->State.IsMassStoreReset)
@@ -209,17 +192,8 @@ void DataflashManager_ReadBlocks(USB_ClassInfo_MS_Device_t* MSInterfaceInfo, con
 		/* Write an endpoint packet sized data block to the dataflash */
 		while (BytesInBlockDiv16 < (VIRTUAL_MEMORY_BLOCK_SIZE >> 4))
 		{
-			/* Check if the endpoint is currently full */
-			if (!(Endpoint_IsReadWriteAllowed()))
-			{
-				/* Clear the endpoint bank to send its contents to the host */
-				Endpoint_ClearIN();
-				
-				/* Wait until the endpoint is ready for more data */
-				if (Endpoint_WaitUntilReady())
-				  return;
-			}
-			
+			uint8_t ChunksToForward;
+
 			/* Check if end of dataflash page reached */
 			if (CurrDFPageByteDiv16 == (DATAFLASH_PAGE_SIZE >> 4))
 			{
@@ -239,29 +213,21 @@ void DataflashManager_ReadBlocks(USB_ClassInfo_MS_Device_t* MSInterfaceInfo, con
 				Dataflash_SendByte(0x00);
 			}	
 
-			/* Read one 16-byte chunk of data from the dataflash */
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
-			Endpoint_Write_Byte(Dataflash_ReceiveByte());
+			/* Forward data up to the end of the current dataflash page or block, whichever comes first */
+			ChunksToForward = ((DATAFLASH_PAGE_SIZE >> 4) - CurrDFPageByteDiv16);
+			
+			if (ChunksToForward > ((VIRTUAL_MEMORY_BLOCK_SIZE >> 4) - BytesInBlockDiv16))
+			  ChunksToForward = ((VIRTUAL_MEMORY_BLOCK_SIZE >> 4) - BytesInBlockDiv16);
+
+			/* Read the 16-byte chunks of data straight from the dataflash into the endpoint */
+			if (Endpoint_Forward_Stream_From_SPI(((uint16_t)ChunksToForward << 4), NO_STREAM_CALLBACK))
+			  return;
 			
 			/* Increment the dataflash page 16 byte block counter */
-			CurrDFPageByteDiv16++;
+			CurrDFPageByteDiv16 += ChunksToForward;
 			
 			/* Increment the block 16 byte block counter */
-			BytesInBlockDiv16++;
+			BytesInBlockDiv16 += ChunksToForward;
 
 			/* Check if the current command is being aborted by the host */
 			if (MSInterfaceInfo->State.IsMassStoreReset)
@@ -139,40 +139,47 @@ static void uIPManagement_ProcessIncomingPacket(void)
 	  
 	LEDs_SetAllLEDs(LEDMASK_USB_BUSY);
 
-	/* Read the Incoming packet straight into the UIP packet buffer */
-	RNDIS_Host_ReadPacket(&Ethernet_RNDIS_Interface, uip_buf, &uip_len);
-
-	/* If the packet contains an Ethernet frame, process it */
-	if (uip_len > 0)
+	/* Process each waiting packet in turn, as the device may send a burst of several packets in a single transfer */
+	for (uint8_t PacketsProcessed = 0; PacketsProcessed < MAX_INCOMING_PACKETS; PacketsProcessed++)
 	{
-		switch (((struct uip_eth_hdr*)uip_buf)->type)
+		if (!(RNDIS_Host_IsPacketReceived(&Ethernet_RNDIS_Interface)))
+		  break;
+
+		/* Read the Incoming packet straight into the UIP packet buffer */
+		RNDIS_Host_ReadPacket(&Ethernet_RNDIS_Interface, uip_buf, &uip_len);
+
+		/* If the packet contains an Ethernet frame, process it */
+		if (uip_len > 0)
 		{
-			case HTONS(UIP_ETHTYPE_IP):
-				/* Filter packet by MAC destination */
-				uip_arp_ipin();
-
-				/* Process Incoming packet */
-				uip_input();
-
-				/* If a response was generated, send it */
-				if (uip_len > 0)
-				{
-					/* Add destination MAC to outgoing packet */
-					uip_arp_out();
-
-					uip_split_output();
-				}
-				
-				break;
-			case HTONS(UIP_ETHTYPE_ARP):
-				/* Process ARP packet */
-				uip_arp_arpin();
-				
-				/* If a response was generated, send it */
-				if (uip_len > 0)
-				  uip_split_output();
-				
-				break;
+			switch (((struct uip_eth_hdr*)uip_buf)->type)
+			{
+				case HTONS(UIP_ETHTYPE_IP):
+					/* Filter packet by MAC destination */
+					uip_arp_ipin();
+
+					/* Process Incoming packet */
+					uip_input();
+
+					/* If a response was generated, send it */
+					if (uip_len > 0)
+					{
+						/* Add destination MAC to outgoing packet */
+						uip_arp_out();
+
+						uip_split_output();
+					}
+					
+					break;
+				case HTONS(UIP_ETHTYPE_ARP):
+					/* Process ARP packet */
+					uip_arp_arpin();
+					
+					/* If a response was generated, send it */
+					if (uip_len > 0)
+					  uip_split_output();
+					
+					break;
+			}
 		}
 	}
 
@@ -60,6 +60,11 @@
 		 */
 		#define DEVICE_GATEWAY            (uint8_t[]){192, 168, 1, 1}
 
+		/** Maximum number of packets from the attached RNDIS device which are processed in each pass of the network management
+		 *  task, so that bursts of packets sent in a single transfer are handled without starving the open connections.
+		 */
+		#define MAX_INCOMING_PACKETS      4
+
 	/* External Variables: */
 		extern struct uip_eth_addr MACAddress;
 		
@@ -54,6 +54,7 @@ USB_ClassInfo_RNDIS_Host_t Ethernet_RNDIS_Interface =
 				.NotificationPipeDoubleBank = false,
 				
 				.HostMaxPacketSize          = UIP_CONF_BUFFER_SIZE,
+				.MaxPacketsPerTransfer      = MAX_INCOMING_PACKETS,
 			},
 	};
 